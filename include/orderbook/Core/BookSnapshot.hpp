@@ -0,0 +1,106 @@
+#pragma once
+#include "Types.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Counters a snapshot restores besides the resting orders
+ */
+struct BookSnapshotInfo {
+    // Last journal sequence applied when the image was taken (0 without a journal)
+    uint64_t journal_sequence = 0;
+    uint64_t trade_count = 0;
+    // MatchingEngine trade ID counter, so restored books never reuse trade IDs
+    uint64_t next_trade_id = 1;
+    uint64_t level_count = 0;
+    uint64_t order_count = 0;
+};
+
+/**
+ * @brief One resting order as stored in a snapshot (symbol/account are file-local IDs)
+ */
+struct SnapshotOrder {
+    uint64_t id;
+    int64_t price;
+    uint64_t quantity;
+    uint64_t filled_quantity;
+    uint32_t symbol_id;
+    uint32_t account_id;
+    uint8_t side;
+    uint8_t type;
+    uint8_t tif;
+    uint8_t status;
+    uint32_t reserved;
+};
+static_assert(sizeof(SnapshotOrder) == 48, "snapshot order layout");
+
+/**
+ * @brief One price level; its orders are the next `orders` entries, in FIFO order
+ */
+struct SnapshotLevel {
+    int64_t price;
+    uint64_t total_quantity;
+    uint64_t order_count;
+    uint32_t first_order;
+    uint32_t orders;
+    uint8_t side;
+    uint8_t reserved[7];
+};
+static_assert(sizeof(SnapshotLevel) == 40, "snapshot level layout");
+
+/**
+ * @brief In-memory image captured by the consumer, written out by the caller
+ * Levels are best-first per side (bids, then asks).
+ */
+struct BookImage {
+    BookSnapshotInfo info;
+    std::vector<SnapshotLevel> levels;
+    std::vector<SnapshotOrder> orders;
+};
+
+/**
+ * @brief Write an image as a versioned snapshot file
+ * The file is written beside path, fsynced and renamed over it, so a crash never
+ * leaves a half-written snapshot under the final name.
+ * @return Bytes written
+ */
+Result<size_t> writeBookSnapshot(const std::string& path, const BookImage& image);
+
+/**
+ * @brief Read-only mapping of a snapshot file
+ *
+ * The level and order arrays are used in place from the mapping; only the small
+ * name table is parsed, interning symbols and accounts into this process's tables.
+ */
+class MappedBookSnapshot {
+public:
+    static Result<std::unique_ptr<MappedBookSnapshot>> open(const std::string& path);
+    ~MappedBookSnapshot();
+
+    MappedBookSnapshot(const MappedBookSnapshot&) = delete;
+    MappedBookSnapshot& operator=(const MappedBookSnapshot&) = delete;
+
+    const BookSnapshotInfo& info() const { return info_; }
+    const SnapshotLevel* levels() const { return levels_; }
+    const SnapshotOrder* orders() const { return orders_; }
+
+    // File-local IDs to this process's interned IDs
+    SymbolId symbol(uint32_t file_id) const { return file_id < symbols_.size() ? symbols_[file_id] : 0; }
+    AccountId account(uint32_t file_id) const { return file_id < accounts_.size() ? accounts_[file_id] : 0; }
+
+private:
+    MappedBookSnapshot() = default;
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    BookSnapshotInfo info_;
+    const SnapshotLevel* levels_ = nullptr;
+    const SnapshotOrder* orders_ = nullptr;
+    std::vector<SymbolId> symbols_;
+    std::vector<AccountId> accounts_;
+};
+
+}
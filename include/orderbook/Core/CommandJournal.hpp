@@ -0,0 +1,203 @@
+#pragma once
+#include "Types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Where and how an OrderBook journals accepted commands
+ */
+struct CommandJournalOptions {
+    // Directory holding journal-NNNNNNNN.seg files (empty = journaling off)
+    std::string directory;
+    // Preallocated size of each mmap'd segment
+    size_t segment_bytes = size_t(64) << 20;
+    // Group-commit window: the flusher msyncs everything appended in this interval at once
+    uint32_t sync_interval_us = 1000;
+    // Replay existing segments into the book before appending
+    bool recover = true;
+};
+
+/**
+ * @brief One command as accepted by the consumer, in this process's interned IDs
+ */
+struct JournalCommand {
+    // CancelAccount/CancelSymbol carry their key in account_id/symbol_id; Auction marks
+    // a live batch auction boundary and carries nothing
+    enum class Type : uint8_t { Add = 1, Cancel, Modify, CancelAccount, CancelSymbol, Auction };
+
+    uint64_t sequence = 0;
+    Type type = Type::Add;
+    Side side = Side::Buy;
+    OrderType order_type = OrderType::Limit;
+    TimeInForce tif = TimeInForce::GTC;
+    SymbolId symbol_id = 0;
+    AccountId account_id = 0;
+    OrderId id{0};
+    Price price = 0;
+    Quantity quantity = 0;
+};
+
+/**
+ * @brief Sequential reader over a journal directory
+ *
+ * Maps each segment read-only and yields commands in sequence order. Symbol and
+ * account name records are resolved into symbolTable()/accountTable(), so the IDs in
+ * a JournalCommand are valid in the reading process. Reading stops at the first torn
+ * record, checksum failure or sequence gap; everything before it is intact.
+ */
+class CommandJournalReader {
+public:
+    explicit CommandJournalReader(std::string directory);
+    ~CommandJournalReader();
+
+    CommandJournalReader(const CommandJournalReader&) = delete;
+    CommandJournalReader& operator=(const CommandJournalReader&) = delete;
+
+    /**
+     * @brief Next command, or false at the end of the intact journal
+     */
+    bool next(JournalCommand& command);
+
+    uint64_t lastSequence() const { return last_sequence_; }
+    // True if reading stopped on damage rather than the clean end of the last segment
+    bool damaged() const { return damaged_; }
+    const std::string& error() const { return error_; }
+
+    // Resume point for an appender: segment being read when next() returned false,
+    // the byte offset after its last good record, and the segments that follow it
+    uint64_t endSegment() const { return segment_index_; }
+    size_t endOffset() const { return offset_; }
+    const std::vector<uint64_t>& segmentIndexes() const { return segments_; }
+
+private:
+    bool openSegment(size_t position);
+    void closeSegment();
+    void resolveName(uint8_t kind, uint32_t id, const char* name, size_t length);
+
+    std::string directory_;
+    std::vector<uint64_t> segments_;
+    size_t position_ = 0;
+    uint64_t segment_index_ = 0;
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+    uint64_t last_sequence_ = 0;
+    bool damaged_ = false;
+    bool finished_ = false;
+    std::string error_;
+    // Journal ID -> interned ID in this process (0 = not yet named)
+    std::vector<SymbolId> symbol_map_;
+    std::vector<AccountId> account_map_;
+};
+
+/**
+ * @brief Append-only, memory-mapped command journal with group-commit durability
+ *
+ * append() is called only by the book's consumer thread: it copies a fixed-size
+ * record into the active segment's mapping and publishes the new end offset, with no
+ * system call on the hot path. A flusher thread msyncs the appended range once per
+ * sync_interval_us, so every command in that window shares one sync. Segments are
+ * preallocated; a full one is sealed and handed to the flusher to sync and unmap.
+ */
+class CommandJournal {
+public:
+    using RecoverFn = std::function<void(const JournalCommand&)>;
+
+    /**
+     * @brief Open (or create) the journal in options.directory and position it for appending
+     *
+     * Existing segments are read once; each intact command goes to on_recovered when
+     * given. A damaged tail is zeroed and any segments after it are renamed to
+     * *.seg.corrupt, so appending continues right after the last good record.
+     * @param min_sequence Sequence already covered elsewhere (a loaded snapshot): an
+     *        empty journal starts after it, and one that ends before it is refused
+     */
+    static Result<std::unique_ptr<CommandJournal>> open(const CommandJournalOptions& options,
+                                                         const RecoverFn& on_recovered = RecoverFn(),
+                                                         uint64_t min_sequence = 0);
+
+    ~CommandJournal();
+
+    CommandJournal(const CommandJournal&) = delete;
+    CommandJournal& operator=(const CommandJournal&) = delete;
+
+    /**
+     * @brief Append one command (consumer thread only); assigns and returns its sequence
+     * Returns 0 if a new segment could not be created; the command is then not journaled.
+     */
+    uint64_t append(JournalCommand command);
+
+    /**
+     * @brief Block until everything appended so far is on stable storage
+     */
+    void sync();
+
+    /**
+     * @brief Delete segments whose commands are all at or below sequence
+     * Safe from any thread; the newest segment is always kept.
+     * @return Number of segment files removed
+     */
+    size_t truncate(uint64_t sequence);
+
+    // First sequence still held in the journal (lastSequence() + 1 when empty)
+    uint64_t firstSequence() const { return first_sequence_.load(std::memory_order_acquire); }
+
+    uint64_t lastSequence() const { return sequence_.load(std::memory_order_acquire); }
+    uint64_t durableSequence() const { return durable_sequence_.load(std::memory_order_acquire); }
+    uint64_t appendFailures() const { return append_failures_.load(std::memory_order_relaxed); }
+    // msync calls that failed; the range is retried on the next flush
+    uint64_t syncFailures() const { return sync_failures_.load(std::memory_order_relaxed); }
+    size_t recoveredCount() const { return recovered_count_; }
+    bool recoveredDamaged() const { return recovered_damaged_; }
+    const std::string& directory() const { return options_.directory; }
+
+private:
+    struct Segment;
+
+    explicit CommandJournal(const CommandJournalOptions& options);
+
+    Result<bool> recover(const RecoverFn& on_recovered, uint64_t min_sequence);
+    std::unique_ptr<Segment> createSegment(uint64_t index, uint64_t first_sequence, std::string* error);
+    std::unique_ptr<Segment> mapSegment(uint64_t index, std::string* error);
+    bool rollover();
+    bool writeName(uint8_t kind, uint32_t id);
+    void writeRecord(const void* record, size_t length);
+    void flushLoop();
+    void flushOnce();
+
+    CommandJournalOptions options_;
+    // Active segment: written by the consumer, synced (not freed) by the flusher
+    std::unique_ptr<Segment> active_;
+    // Full segments waiting for their final sync; the flusher frees them once synced
+    std::vector<std::unique_ptr<Segment>> sealed_;
+    std::mutex segments_mutex_;
+    // Names already written to the active segment, so each segment is self-describing
+    std::vector<bool> symbols_named_;
+    std::vector<bool> accounts_named_;
+
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> durable_sequence_{0};
+    std::atomic<uint64_t> append_failures_{0};
+    std::atomic<uint64_t> sync_failures_{0};
+    std::atomic<uint64_t> first_sequence_{1};
+    size_t recovered_count_ = 0;
+    bool recovered_damaged_ = false;
+
+    std::mutex flush_mutex_;
+    std::condition_variable flush_cv_;
+    bool stopping_ = false;
+    uint64_t sync_requests_ = 0;
+    uint64_t sync_completions_ = 0;
+    std::thread flusher_;
+};
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include "Interfaces.hpp"
+#include <array>
+#include <cstdint>
+
+namespace orderbook {
+
+/**
+ * @brief Consumer-maintained top-N levels per side, updated as levels change
+ *
+ * The book reports every level it touches; only a level at or inside the cached
+ * window moves anything, so reading depth is an array copy rather than a level
+ * walk. A cached level that empties leaves a gap only a walk can refill, so the
+ * side is marked stale and the book refills it (top N only) before publishing.
+ * Each side keeps a mask of slots changed since the last consumeDirty() so
+ * publishers can emit just those levels. Consumer thread only.
+ */
+class DepthCache {
+public:
+    static constexpr size_t Capacity = 10;
+    using DirtyMask = uint32_t;
+    static_assert(Capacity <= 32, "one dirty bit per slot");
+
+    struct SideDepth {
+        std::array<MarketDepth::Level, Capacity> levels{};
+        uint32_t count = 0;
+        // The book may hold non-empty levels past the window
+        bool beyond = false;
+        // A cached level emptied while levels may exist beyond: refill before reading
+        bool stale = false;
+        DirtyMask dirty = 0;
+    };
+
+    /**
+     * @brief Record the new state of a level; empty levels drop out of the window
+     */
+    void update(Side side, const PriceLevel& level) {
+        SideDepth& s = sides_[index(side)];
+        bool bid = side == Side::Buy;
+        uint32_t i = 0;
+        while (i < s.count && (bid ? s.levels[i].price > level.price : s.levels[i].price < level.price)) ++i;
+        bool present = i < s.count && s.levels[i].price == level.price;
+
+        if (level.isEmpty()) {
+            if (!present) return;
+            for (uint32_t j = i; j + 1 < s.count; ++j) s.levels[j] = s.levels[j + 1];
+            s.dirty |= slotsFrom(i, s.count);
+            --s.count;
+            if (s.beyond) s.stale = true;
+            return;
+        }
+        MarketDepth::Level entry{level.price, level.total_quantity, level.order_count};
+        if (present) {
+            s.levels[i] = entry;
+            s.dirty |= DirtyMask(1) << i;
+            return;
+        }
+        if (i == Capacity) {
+            s.beyond = true;
+            return;
+        }
+        if (s.count == Capacity) {
+            s.beyond = true;  // the worst cached level is pushed out
+        } else {
+            ++s.count;
+        }
+        for (uint32_t j = s.count - 1; j > i; --j) s.levels[j] = s.levels[j - 1];
+        s.levels[i] = entry;
+        s.dirty |= slotsFrom(i, s.count);
+    }
+
+    bool stale(Side side) const { return sides_[index(side)].stale; }
+
+    /**
+     * @brief Refill a side from a best-first walk: reset, then append() each level
+     */
+    void beginRefill(Side side) {
+        SideDepth& s = sides_[index(side)];
+        s.dirty |= slotsFrom(0, s.count);
+        s.count = 0;
+        s.beyond = false;
+        s.stale = false;
+    }
+
+    // Returns false once the window is full and one more level has been seen
+    bool append(Side side, const PriceLevel& level) {
+        SideDepth& s = sides_[index(side)];
+        if (s.count == Capacity) {
+            s.beyond = true;
+            return false;
+        }
+        s.levels[s.count] = MarketDepth::Level{level.price, level.total_quantity, level.order_count};
+        s.dirty |= DirtyMask(1) << s.count;
+        ++s.count;
+        return true;
+    }
+
+    /**
+     * @brief Forget everything; both sides refill on the next read
+     */
+    void invalidate() {
+        for (SideDepth& s : sides_) {
+            s.dirty |= slotsFrom(0, s.count);
+            s.count = 0;
+            s.beyond = true;
+            s.stale = true;
+        }
+    }
+
+    void clear() {
+        for (SideDepth& s : sides_) {
+            s.dirty |= slotsFrom(0, s.count);
+            s.count = 0;
+            s.beyond = false;
+            s.stale = false;
+        }
+    }
+
+    const SideDepth& side(Side side) const { return sides_[index(side)]; }
+
+    /**
+     * @brief Slots changed since the previous call (bit n = nth best level)
+     */
+    DirtyMask consumeDirty(Side side) {
+        DirtyMask mask = sides_[index(side)].dirty;
+        sides_[index(side)].dirty = 0;
+        return mask;
+    }
+
+private:
+    static size_t index(Side side) { return side == Side::Buy ? 0 : 1; }
+    // Bits [from, to) (to <= Capacity)
+    static DirtyMask slotsFrom(uint32_t from, uint32_t to) {
+        if (from >= to) return 0;
+        DirtyMask upto = to >= 32 ? ~DirtyMask(0) : (DirtyMask(1) << to) - 1;
+        return upto & ~((DirtyMask(1) << from) - 1);
+    }
+
+    std::array<SideDepth, 2> sides_{};
+};
+
+}
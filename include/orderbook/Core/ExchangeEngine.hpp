@@ -0,0 +1,126 @@
+#pragma once
+#include "Types.hpp"
+#include "Interfaces.hpp"
+#include "OrderBook.hpp"
+#include "SymbolMaster.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+namespace orderbook {
+
+/**
+ * @brief Construction-time settings for ExchangeEngine
+ */
+struct ExchangeEngineOptions {
+    // Number of matching threads; symbols are pinned to threads by SymbolId
+    size_t matching_threads = 1;
+    // Wait strategy for the matching threads; with cpu_affinity >= 0, thread i is
+    // pinned to cpu_affinity + i
+    WaitOptions wait;
+    // Settings applied to every book (own_consumer_thread is forced off)
+    OrderBookOptions book_options;
+};
+
+/**
+ * @brief Book registry that owns one OrderBook per symbol and shards matching
+ * Symbols are keyed by their process-wide interned SymbolId, so an Order routes by
+ * its symbol_id without any string lookup. Each matching thread
+ * drains the order queues of the books pinned to it, so books on different threads
+ * match in parallel while each book keeps a single consumer. Register symbols
+ * before start(); per-thread producers from registerProducer() route lock-free.
+ */
+class ExchangeEngine {
+public:
+    ExchangeEngine(RiskManagerPtr risk_manager = nullptr,
+                   MarketDataPublisherPtr market_data = nullptr,
+                   LoggerPtr logger = nullptr,
+                   ExchangeEngineOptions options = ExchangeEngineOptions());
+    ~ExchangeEngine();
+
+    ExchangeEngine(const ExchangeEngine&) = delete;
+    ExchangeEngine& operator=(const ExchangeEngine&) = delete;
+
+    /**
+     * @brief Register a symbol and create its book
+     * @return SymbolId (existing ID if already registered) or error once running
+     */
+    Result<SymbolId> addSymbol(const std::string& symbol);
+
+    /**
+     * @brief Register a symbol whose book quotes in its own tick size
+     */
+    Result<SymbolId> addSymbol(const std::string& symbol, PriceScale price_scale);
+
+    /**
+     * @brief Register every symbol in the master, each book with the entry's tick size
+     * @return Number of symbols registered or the first error
+     */
+    Result<size_t> addSymbols(const SymbolMaster& master);
+
+    /**
+     * @brief Start the matching threads
+     */
+    void start();
+
+    /**
+     * @brief Stop and join the matching threads after draining queued work
+     * The engine cannot be restarted once stopped.
+     */
+    void stop();
+
+    // Symbol lookup (only symbols registered with this engine resolve)
+    std::optional<SymbolId> findSymbol(std::string_view symbol) const;
+    const char* getSymbolName(SymbolId id) const;
+    OrderBook* getBook(SymbolId id);
+    OrderBook* getBook(std::string_view symbol);
+
+    // Order routing (producer side)
+    OrderResult addOrder(const Order& order);
+    OrderResult addOrder(SymbolId id, const Order& order);
+    CancelResult cancelOrder(SymbolId id, OrderId order_id);
+    ModifyResult modifyOrder(SymbolId id, OrderId order_id, Price new_price, Quantity new_quantity);
+
+    // Dedicated lock-free ingestion ring into one symbol's book (one per gateway thread)
+    Result<OrderBook::Producer> registerProducer(SymbolId id);
+
+    // Wait until every book's queues are drained (for testing)
+    void waitForCompletion();
+
+    // Statistics
+    size_t getSymbolCount() const { return books_.size(); }
+    size_t getMatchingThreadCount() const { return shards_.size(); }
+    // Registered symbols are spread round-robin over the threads in registration order
+    size_t getShardForSymbol(SymbolId id) const { return id < shard_by_symbol_.size() ? shard_by_symbol_[id] : 0; }
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+private:
+    // One matching thread and the books pinned to it
+    struct MatchingShard {
+        std::vector<OrderBook*> books;
+        std::thread thread;
+        ConsumerWaiter waiter;
+        int cpu = -1;
+    };
+
+    void runShard(MatchingShard& shard);
+
+    ExchangeEngineOptions options_;
+    std::vector<std::unique_ptr<OrderBook>> books_;
+    // Indexed by SymbolId; null / 0 for symbols not registered here
+    std::vector<OrderBook*> book_by_symbol_;
+    std::vector<uint32_t> shard_by_symbol_;
+    std::vector<std::unique_ptr<MatchingShard>> shards_;
+    std::atomic<bool> running_{false};
+
+    // Dependencies shared by all books
+    RiskManagerPtr risk_manager_;
+    MarketDataPublisherPtr market_data_;
+    LoggerPtr logger_;
+};
+
+}
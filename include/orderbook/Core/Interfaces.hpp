@@ -3,6 +3,11 @@
 #include <memory>
 #include <vector>
 #include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include <type_traits>
 
 namespace orderbook {
 
@@ -35,7 +40,7 @@ struct MarketDepth {
     
     std::vector<Level> bids;
     std::vector<Level> asks;
-    Timestamp timestamp;
+    Timestamp timestamp = 0;
 };
 
 struct BestPrices {
@@ -43,7 +48,7 @@ struct BestPrices {
     std::optional<Price> ask;
     std::optional<Quantity> bid_size;
     std::optional<Quantity> ask_size;
-    Timestamp timestamp;
+    Timestamp timestamp = 0;
 };
 
 // Abstract interfaces
@@ -62,27 +67,52 @@ public:
      * @return RiskCheck result with approval/rejection and reason
      */
     virtual RiskCheck validateOrder(const Order& order, const Portfolio& portfolio) = 0;
+
+    /**
+     * @brief Check an order against the live position state on the submitting thread
+     * Thread-safe and lock-free. On approval the order's quantity is reserved as open
+     * exposure until it fills, is cancelled or is released with adjustExposure().
+     * Does not consult the bypass flag; callers skip the call when isBypassed().
+     */
+    virtual RiskCheck preTradeCheck(const Order& order) = 0;
+
+    /**
+     * @brief Post-trade delta from the matching thread for one side of a fill
+     * @param reserved Whether the order holds a preTradeCheck reservation to draw down
+     */
+    virtual void onFill(AccountId account, SymbolId symbol, Side side, Quantity quantity, Price price,
+                        bool reserved) = 0;
+
+    /**
+     * @brief Change a reserved order's open exposure (negative to release it)
+     */
+    virtual void adjustExposure(AccountId account, SymbolId symbol, Side side, int64_t delta) = 0;
     
     /**
      * @brief Update position after trade execution
-     * @param trade The executed trade
+     * @param trade The executed trade; accounts come from associateOrderWithAccount()
      */
     virtual void updatePosition(const Trade& trade) = 0;
+
+    /**
+     * @brief Current filled position of an account in one symbol
+     */
+    virtual int64_t getPosition(AccountId account, SymbolId symbol) const = 0;
     
     /**
      * @brief Get current portfolio for an account
-     * @param account Account identifier
-     * @return Portfolio reference
+     * @param account Interned account identifier
+     * @return Snapshot of the account's positions
      */
-    virtual const Portfolio& getPortfolio(const std::string& account) const = 0;
+    virtual Portfolio getPortfolio(AccountId account) const = 0;
     /**
      * @brief Associate an order with an account for later position tracking
      */
-    virtual void associateOrderWithAccount(OrderId order_id, const std::string& account) = 0;
+    virtual void associateOrderWithAccount(OrderId order_id, AccountId account) = 0;
     /**
      * @brief Get the account associated with an order
      */
-    virtual std::string getAccountForOrder(OrderId order_id) const = 0;
+    virtual AccountId getAccountForOrder(OrderId order_id) const = 0;
 
     /**
      * @brief Bypass risk checks (useful for performance harnesses)
@@ -129,6 +159,65 @@ public:
     virtual void subscribe(std::function<void(const std::string&)> callback) = 0;
 };
 
+/**
+ * @brief Raw log argument, captured without formatting
+ * Strings are borrowed; a logger that defers formatting must copy them.
+ */
+struct LogArg {
+    enum class Type : uint8_t { Int, UInt, Double, Bool, Str };
+    Type type;
+    uint32_t length = 0;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char* s;
+    };
+
+    LogArg() : type(Type::Int), i(0) {}
+    template<typename T, typename std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    LogArg(T value) {
+        if constexpr (std::is_same_v<T, bool>) { type = Type::Bool; u = value; }
+        else if constexpr (std::is_signed_v<T>) { type = Type::Int; i = value; }
+        else { type = Type::UInt; u = value; }
+    }
+    template<typename T, typename std::enable_if_t<std::is_enum_v<T>, int> = 0>
+    LogArg(T value) : type(Type::Int), i(static_cast<int64_t>(value)) {}
+    LogArg(double value) : type(Type::Double), d(value) {}
+    LogArg(std::string_view value) : type(Type::Str), length(static_cast<uint32_t>(value.size())), s(value.data()) {}
+    LogArg(const char* value) : LogArg(std::string_view(value ? value : "")) {}
+    LogArg(const std::string& value) : LogArg(std::string_view(value)) {}
+    LogArg(OrderId value) : type(Type::UInt), u(value.value) {}
+    LogArg(TradeId value) : type(Type::UInt), u(value.value) {}
+};
+
+/**
+ * @brief Expand "{}" placeholders in format with args, in order
+ */
+inline void appendLogFormat(std::string& out, const char* format, const LogArg* args, size_t count) {
+    size_t next = 0;
+    for (const char* p = format; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && next < count) {
+            const LogArg& arg = args[next++];
+            switch (arg.type) {
+                case LogArg::Type::Int: out += std::to_string(arg.i); break;
+                case LogArg::Type::UInt: out += std::to_string(arg.u); break;
+                case LogArg::Type::Bool: out += arg.u ? "true" : "false"; break;
+                case LogArg::Type::Str: out.append(arg.s, arg.length); break;
+                case LogArg::Type::Double: {
+                    char buf[32];
+                    int n = std::snprintf(buf, sizeof(buf), "%g", arg.d);
+                    out.append(buf, n > 0 ? static_cast<size_t>(n) : 0);
+                    break;
+                }
+            }
+            ++p;
+        } else {
+            out += *p;
+        }
+    }
+}
+
 /**
  * @brief Interface for structured logging
  */
@@ -194,8 +283,49 @@ public:
      * to avoid expensive formatting when the message would be dropped.
      */
     virtual bool isLogLevelEnabled(LogLevel level) = 0;
+
+    /**
+     * @brief Log a "{}"-placeholder format with raw arguments
+     * format must have static storage duration; loggers may keep the pointer as a
+     * format ID and expand it later. The default expands immediately and calls log().
+     */
+    virtual void logFormat(LogLevel level, const char* context, const char* format,
+                           const LogArg* args, size_t count) {
+        std::string message;
+        appendLogFormat(message, format, args, count);
+        log(level, message, context ? context : "");
+    }
+
+    template<typename... Args>
+    void logf(LogLevel level, const char* context, const char* format, const Args&... args) {
+        const LogArg packed[sizeof...(Args) + 1] = {LogArg(args)..., LogArg()};
+        logFormat(level, context, format, packed, sizeof...(Args));
+    }
 };
 
+/**
+ * @brief Lazy logging: nothing after the context is evaluated unless the level is enabled
+ * Usage: LOG_DEBUG(logger_, "OrderBook::addOrder", "order {} qty {}", id, qty);
+ * The format must be a string literal; the logger may format it later.
+ */
+#define LOG_AT(logger, level, context, ...)                                   \
+    do {                                                                      \
+        auto* ob_log_target_ = ::orderbook::detail::loggerPtr(logger);        \
+        if (ob_log_target_ && ob_log_target_->isLogLevelEnabled(level)) {     \
+            ob_log_target_->logf(level, context, __VA_ARGS__);                \
+        }                                                                     \
+    } while (0)
+#define LOG_DEBUG(logger, context, ...) LOG_AT(logger, ::orderbook::LogLevel::DEBUG, context, __VA_ARGS__)
+#define LOG_INFO(logger, context, ...) LOG_AT(logger, ::orderbook::LogLevel::INFO, context, __VA_ARGS__)
+#define LOG_WARN(logger, context, ...) LOG_AT(logger, ::orderbook::LogLevel::WARN, context, __VA_ARGS__)
+#define LOG_ERROR(logger, context, ...) LOG_AT(logger, ::orderbook::LogLevel::ERROR, context, __VA_ARGS__)
+
+namespace detail {
+inline ILogger* loggerPtr(ILogger* logger) { return logger; }
+template<typename T>
+ILogger* loggerPtr(const std::shared_ptr<T>& logger) { return logger.get(); }
+}
+
 // Convenience type aliases for shared pointers
 using RiskManagerPtr = std::shared_ptr<IRiskManager>;
 using MarketDataPublisherPtr = std::shared_ptr<IMarketDataPublisher>;
@@ -0,0 +1,54 @@
+#pragma once
+#include "Types.hpp"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <optional>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace orderbook {
+
+/**
+ * @brief Process-wide string interner handing out dense uint32_t IDs
+ * ID 0 is always the empty string. Names live in fixed chunks that never move, so
+ * name() is lock-free and its pointer stays valid for the table's lifetime.
+ * intern() and find() take a mutex: resolve IDs once at the protocol edges.
+ */
+class InternTable {
+public:
+    static constexpr uint32_t EmptyId = 0;
+
+    InternTable();
+    ~InternTable();
+
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+
+    /**
+     * @brief Return the ID for name, assigning the next one if it is new
+     * Returns EmptyId once MaxEntries names are stored.
+     */
+    uint32_t intern(std::string_view name);
+    std::optional<uint32_t> find(std::string_view name) const;
+    const char* name(uint32_t id) const;
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t ChunkSize = 1024;
+    static constexpr size_t MaxChunks = 1024;
+    static constexpr size_t MaxEntries = ChunkSize * MaxChunks;
+
+    mutable std::mutex mutex_;
+    // Keys view into chunk storage, which never moves
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    std::array<std::atomic<std::string*>, MaxChunks> chunks_{};
+    std::atomic<uint32_t> size_{0};
+};
+
+// Shared tables, so books, risk and portfolios agree on IDs
+InternTable& symbolTable();
+InternTable& accountTable();
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Types.hpp"
+#include "../Utilities/TscClock.hpp"
 #include <vector>
 #include <optional>
 
@@ -14,14 +15,14 @@ struct BookUpdate {
     Type type;
     Side side;
     Price price;
-    Quantity quantity;
-    size_t order_count;
+    Quantity quantity;         // Level total after the change; 0 = level gone
+    size_t order_count;        // Orders left on the level
     SequenceNumber sequence;
     Timestamp timestamp;
     
     BookUpdate(Type t, Side s, Price p, Quantity q, size_t count, SequenceNumber seq)
         : type(t), side(s), price(p), quantity(q), order_count(count), sequence(seq),
-          timestamp(std::chrono::system_clock::now()) {}
+          timestamp(TscClock::now()) {}
 };
 
 /**
@@ -49,7 +50,7 @@ struct ExecutionReport {
         : order_id(id), exec_type(exec), order_status(status), side(s), price(p), 
           quantity(q), filled_quantity(filled), leaves_quantity(q - filled),
           symbol(std::move(sym)), account(std::move(acc)),
-          timestamp(std::chrono::system_clock::now()) {}
+          timestamp(TscClock::now()) {}
 };
 
 }
\ No newline at end of file
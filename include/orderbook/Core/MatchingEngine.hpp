@@ -3,109 +3,180 @@
 #include "Order.hpp"
 #include "Interfaces.hpp"
 #include "MarketData.hpp"
-#include <vector>
-#include <memory>
+#include <array>
+#include <algorithm>
 #include <atomic>
 
 namespace orderbook {
 
-// Forward declarations
-class OrderBook;
-class PriceLevel;
+/**
+ * @brief One fill produced by the matcher
+ * Both orders are already filled; a fully filled passive order is already unlinked
+ * from its level. quantity == 0 reports a stale, already-filled resting order that
+ * the matcher unlinked without trading.
+ */
+struct Fill {
+    Order* passive = nullptr;
+    PriceLevel* level = nullptr;
+    Price price = 0;
+    Quantity quantity = 0;
+};
+
+/**
+ * @brief Fixed-capacity fill sink for callers that want the fills back
+ * Matching stops once it is full, leaving the rest of the incoming order unmatched.
+ */
+template<size_t Capacity>
+class FillBuffer {
+public:
+    bool operator()(const Fill& fill) {
+        fills_[size_++] = fill;
+        return size_ < Capacity;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == Capacity; }
+    void clear() { size_ = 0; }
+    const Fill& operator[](size_t i) const { return fills_[i]; }
+    const Fill* begin() const { return fills_.data(); }
+    const Fill* end() const { return fills_.data() + size_; }
+
+private:
+    std::array<Fill, Capacity> fills_{};
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Compile-time facts about an aggressor side, for side-specialized matching
+ */
+template<Side S> struct SideTraits;
+
+template<> struct SideTraits<Side::Buy> {
+    static constexpr Side opposite = Side::Sell;
+    static constexpr bool crosses(Price limit, Price level_price) { return limit >= level_price; }
+};
+
+template<> struct SideTraits<Side::Sell> {
+    static constexpr Side opposite = Side::Buy;
+    static constexpr bool crosses(Price limit, Price level_price) { return limit <= level_price; }
+};
 
 /**
- * @brief Result of order matching operation
+ * @brief Summary of one matchOrder call (no heap storage)
  */
 struct MatchResult {
-    std::vector<Trade> trades;                    // All trades generated from matching
-    std::vector<ExecutionReport> execution_reports; // FIX execution reports for all affected orders
-    std::optional<Order> remaining_order;         // Remaining unfilled portion (if any)
-    bool fully_filled;                           // True if incoming order was completely filled
-    Quantity total_filled_quantity;              // Total quantity filled
-    
-    MatchResult() : fully_filled(false), total_filled_quantity(0) {}
-    
-    bool hasRemainingOrder() const { return remaining_order.has_value(); }
-    bool hasTrades() const { return !trades.empty(); }
-    bool hasExecutionReports() const { return !execution_reports.empty(); }
-    size_t getTradeCount() const { return trades.size(); }
-    size_t getExecutionReportCount() const { return execution_reports.size(); }
+    Quantity total_filled_quantity = 0;
+    size_t fill_count = 0;       // trades, excluding stale-order reports
+    bool fully_filled = false;   // True if incoming order was completely filled
+
+    bool hasTrades() const { return fill_count > 0; }
+    size_t getTradeCount() const { return fill_count; }
 };
 
 /**
- * @brief High-performance order matching engine
- * 
- * Implements price-time priority matching algorithm with sub-microsecond latency.
- * Handles aggressive orders that cross the spread and generates trade executions.
+ * @brief Price-time priority matcher shared by OrderBook and its tests
+ *
+ * The walk over the opposite side is supplied by the caller, so the same loop runs
+ * over the sorted vectors, the ladder, or a plain best-first container. Fills go to
+ * a caller-provided sink (FillBuffer or any callable) instead of result vectors.
  */
 class MatchingEngine {
 public:
     /**
      * @brief Constructor with dependency injection
-     * @param logger Logger for trade execution logging
+     * @param logger Logger for diagnostics
      */
     explicit MatchingEngine(LoggerPtr logger = nullptr);
-    
+
+    /**
+     * @brief Match an incoming order against the opposite side, best price first
+     * @param for_each_level Callable taking a visitor; calls visitor(PriceLevel&) for each
+     *        non-empty level best-first and stops when it returns false
+     * @param on_fill Callable taking const Fill&; returns false to stop matching
+     */
+    template<typename ForEachLevel, typename OnFill>
+    MatchResult matchOrder(Order& incoming_order, ForEachLevel&& for_each_level, OnFill&& on_fill) const {
+        return matchWith(incoming_order, std::forward<ForEachLevel>(for_each_level),
+                         std::forward<OnFill>(on_fill),
+                         [&incoming_order](Price level_price) { return crosses(incoming_order, level_price); });
+    }
+
     /**
-     * @brief Match an incoming order against the order book
-     * @param incoming_order The order to match
-     * @param opposite_side_levels Price levels on the opposite side for matching
-     * @return MatchResult containing trades and remaining order
+     * @brief matchOrder for an incoming order known to be on side S (no side test per level)
      */
-    MatchResult matchOrder(Order& incoming_order, 
-                          std::vector<PriceLevel>& opposite_side_levels);
-    
+    template<Side S, typename ForEachLevel, typename OnFill>
+    MatchResult matchSide(Order& incoming_order, ForEachLevel&& for_each_level, OnFill&& on_fill) const {
+        return matchWith(incoming_order, std::forward<ForEachLevel>(for_each_level),
+                         std::forward<OnFill>(on_fill),
+                         [&incoming_order](Price level_price) { return crosses<S>(incoming_order, level_price); });
+    }
+
     /**
-     * @brief Match a buy order against ask levels
-     * @param buy_order The incoming buy order
-     * @param ask_levels Ask price levels sorted by price (ascending)
-     * @return MatchResult with trades and remaining order
+     * @brief matchOrder over a container of PriceLevel already ordered best-first
      */
-    MatchResult matchBuyOrder(Order& buy_order, 
-                             std::vector<PriceLevel>& ask_levels);
-    
+    template<typename Levels, typename OnFill>
+    MatchResult matchLevels(Order& incoming_order, Levels& best_first_levels, OnFill&& on_fill) const {
+        return matchOrder(incoming_order, [&best_first_levels](auto&& visitor) {
+            for (auto& level : best_first_levels) {
+                if (level.isEmpty()) continue;
+                if (!visitor(level)) break;
+            }
+        }, std::forward<OnFill>(on_fill));
+    }
+
     /**
-     * @brief Match a sell order against bid levels
-     * @param sell_order The incoming sell order
-     * @param bid_levels Bid price levels sorted by price (descending)
-     * @return MatchResult with trades and remaining order
+     * @brief Trade record for a fill of aggressive_order
      */
-    MatchResult matchSellOrder(Order& sell_order, 
-                              std::vector<PriceLevel>& bid_levels);
-    
+    static Trade makeTrade(TradeId trade_id, const Order& aggressive_order, const Fill& fill) {
+        const Order& passive = *fill.passive;
+        return Trade(trade_id.value,
+                     aggressive_order.isBuy() ? aggressive_order.id : passive.id,
+                     aggressive_order.isSell() ? aggressive_order.id : passive.id,
+                     fill.price, fill.quantity, aggressive_order.symbol_id);
+    }
+
     /**
-     * @brief Get next trade ID (thread-safe)
+     * @brief Get next trade ID (thread-safe, unique across engines)
      * @return Unique trade ID
      */
-    TradeId getNextTradeId();
-    
+    static TradeId getNextTradeId();
+
     /**
-     * @brief Get total number of trades executed
+     * @brief Get total number of trade IDs handed out
      * @return Trade count
      */
-    uint64_t getTotalTradeCount() const { return trade_counter_.load(); }
-    
+    static uint64_t getTotalTradeCount() { return trade_counter_.load() - 1; }
+
     /**
      * @brief Reset trade counter (for testing)
      */
-    void resetTradeCounter() { trade_counter_.store(1); }
-    
+    static void resetTradeCounter() { trade_counter_.store(1); }
+
+    /**
+     * @brief Move the counter forward to at least next_trade_id (after a snapshot load)
+     */
+    static void restoreTradeCounter(uint64_t next_trade_id) {
+        uint64_t current = trade_counter_.load();
+        while (current < next_trade_id && !trade_counter_.compare_exchange_weak(current, next_trade_id)) {}
+    }
+
     /**
      * @brief Generate execution report for order fill
      * @param order The order that was filled
      * @param trade_id Optional trade ID if this is from a trade
      * @return ExecutionReport for FIX protocol
      */
-    static ExecutionReport generateExecutionReport(const Order& order, 
+    static ExecutionReport generateExecutionReport(const Order& order,
                                                   std::optional<TradeId> trade_id = std::nullopt);
-    
+
     /**
      * @brief Generate execution report for new order
      * @param order The new order
      * @return ExecutionReport for order acknowledgment
      */
     static ExecutionReport generateNewOrderReport(const Order& order);
-    
+
     /**
      * @brief Generate execution report for order rejection
      * @param order The rejected order
@@ -113,7 +184,7 @@ public:
      * @return ExecutionReport for order rejection
      */
     static ExecutionReport generateRejectionReport(const Order& order, const std::string& reason);
-    
+
     /**
      * @brief Handle partial fill processing
      * @param order Order that was partially filled
@@ -121,7 +192,7 @@ public:
      * @return ExecutionReport for the partial fill
      */
     static ExecutionReport handlePartialFill(Order& order, Quantity filled_quantity);
-    
+
     /**
      * @brief Calculate remaining quantity after fills
      * @param original_quantity Original order quantity
@@ -132,76 +203,100 @@ public:
         return (filled_quantity >= original_quantity) ? 0 : (original_quantity - filled_quantity);
     }
 
-private:
-    // Dependencies
-    LoggerPtr logger_;
-    
-    // Trade ID generation (thread-safe)
-    std::atomic<uint64_t> trade_counter_{1};
-    
-    /**
-     * @brief Execute a trade between two orders
-     * @param aggressive_order The incoming order (taker)
-     * @param passive_order The resting order (maker)
-     * @param trade_price Price at which trade executes
-     * @param trade_quantity Quantity to trade
-     * @return Generated Trade object
-     */
-    Trade executeTrade(Order& aggressive_order, 
-                      Order& passive_order,
-                      Price trade_price, 
-                      Quantity trade_quantity);
-    
-    /**
-     * @brief Match against a single price level
-     * @param incoming_order The order to match
-     * @param price_level The price level to match against
-     * @param trades Vector to append trades to
-     * @return Quantity filled from this price level
-     */
-    Quantity matchAgainstPriceLevel(Order& incoming_order,
-                                   PriceLevel& price_level,
-                                   std::vector<Trade>& trades);
-    
-    /**
-     * @brief Check if orders can match based on price
-     * @param buy_price Buy order price
-     * @param sell_price Sell order price
-     * @return true if prices cross (can match)
-     */
-    static bool canMatch(Price buy_price, Price sell_price) {
-        return buy_price >= sell_price;
-    }
-    
     /**
-     * @brief Determine trade price based on price-time priority
-     * @param aggressive_order Incoming order
-     * @param passive_order Resting order
-     * @return Price at which trade should execute
+     * @brief Check if an incoming order crosses a resting level (market orders cross any price)
      */
-    static Price determineTradePrice(const Order& aggressive_order, 
-                                   const Order& passive_order) {
-        // Price-time priority: passive order (maker) gets their price
-        return passive_order.price;
+    static bool crosses(const Order& incoming_order, Price level_price) {
+        if (incoming_order.type == OrderType::Market) return true;
+        return incoming_order.isBuy() ? incoming_order.price >= level_price
+                                      : incoming_order.price <= level_price;
     }
-    
+
     /**
-     * @brief Log trade execution for monitoring
-     * @param trade The executed trade
-     * @param latency_ns Execution latency in nanoseconds
+     * @brief crosses() for an incoming order known to be on side S
      */
-    void logTradeExecution(const Trade& trade, uint64_t latency_ns);
-    
+    template<Side S>
+    static bool crosses(const Order& incoming_order, Price level_price) {
+        return incoming_order.type == OrderType::Market || SideTraits<S>::crosses(incoming_order.price, level_price);
+    }
+
     /**
-     * @brief Validate trade parameters
-     * @param aggressive_order Incoming order
-     * @param passive_order Resting order
-     * @param quantity Trade quantity
-     * @return true if trade is valid
+     * @brief Fill-or-kill pre-check: can the crossing levels fill the remaining quantity?
+     * Walks levels best-first like matchOrder and stops as soon as enough is found.
      */
-    static bool validateTrade(const Order& aggressive_order,
-                            const Order& passive_order,
-                            Quantity quantity);
+    template<typename ForEachLevel>
+    static bool hasLiquidity(const Order& incoming_order, ForEachLevel&& for_each_level) {
+        Quantity needed = incoming_order.remainingQuantity();
+        Quantity available = 0;
+        for_each_level([&](PriceLevel& level) {
+            if (!crosses(incoming_order, level.price)) return false;
+            available += level.getTotalQuantity();
+            return available < needed;
+        });
+        return available >= needed;
+    }
+
+private:
+    // The matching loop; reaches(level_price) decides whether a level is reachable
+    template<typename ForEachLevel, typename OnFill, typename Crosses>
+    MatchResult matchWith(Order& incoming_order, ForEachLevel&& for_each_level, OnFill&& on_fill,
+                          Crosses&& reaches) const;
+
+    // Dependencies
+    LoggerPtr logger_;
+
+    // Trade ID generation, shared by every book so IDs stay unique process-wide
+    static std::atomic<uint64_t> trade_counter_;
 };
 
-}
\ No newline at end of file
+template<typename ForEachLevel, typename OnFill, typename Crosses>
+MatchResult MatchingEngine::matchWith(Order& incoming_order, ForEachLevel&& for_each_level,
+                                      OnFill&& on_fill, Crosses&& reaches) const {
+    MatchResult result;
+    bool stopped = false;
+
+    for_each_level([&](PriceLevel& level) {
+        if (stopped || incoming_order.isFullyFilled() || !reaches(level.price)) {
+            return false;
+        }
+
+        // FIFO within the level; the passive (maker) price is the trade price
+        Order* passive = level.getFirstOrder();
+        while (passive && !incoming_order.isFullyFilled()) {
+            Order* next = passive->next;
+            Quantity quantity = std::min(incoming_order.remainingQuantity(), passive->remainingQuantity());
+
+            if (quantity == 0) {
+                // Filled order that was never unlinked
+                level.removeOrder(passive);
+                if (!on_fill(Fill{passive, &level, level.price, 0})) {
+                    stopped = true;
+                    return false;
+                }
+                passive = next;
+                continue;
+            }
+
+            incoming_order.fill(quantity);
+            passive->fill(quantity);
+            level.updateQuantity(passive, quantity);
+            result.total_filled_quantity += quantity;
+            ++result.fill_count;
+
+            if (!on_fill(Fill{passive, &level, level.price, quantity})) {
+                stopped = true;
+                return false;
+            }
+            if (!passive->isFullyFilled()) {
+                break;
+            }
+            passive = next;
+        }
+        return !incoming_order.isFullyFilled();
+    });
+
+    result.fully_filled = incoming_order.isFullyFilled();
+    return result;
+}
+
+}
@@ -1,54 +1,70 @@
 #pragma once
 #include "Types.hpp"
+#include "InternTable.hpp"
+#include "../Utilities/TscClock.hpp"
+#include "../Utilities/TraceStamps.hpp"
+#include <cstddef>
+#include <cstring>
 #include <string>
 
 namespace orderbook {
 
 /**
  * @brief Represents a trading order with all necessary fields
- * Optimized for high-performance order book operations with cache-friendly layout
- * SIMD-ready with proper alignment for vectorized operations
+ * The first cache line is the hot record the matching and queue walks touch (ID,
+ * price, quantities, side/type/status, intrusive links); instrument, account,
+ * timestamp, trace stamps and the per-account links sit in the second, so walking
+ * a level costs one line per order.
  */
 struct alignas(64) Order {  // 64-byte alignment for cache line optimization and SIMD
-    // Core order identification and pricing (hot data)
+    // ---- Hot record: first cache line ----
     OrderId id;
     Price price;
     Quantity quantity;
     Quantity filled_quantity = 0;
     
-    // Order characteristics
+    // Linked list pointers for price level management
+    Order* next = nullptr;
+    Order* prev = nullptr;
+    
     Side side;
     OrderType type;
     TimeInForce tif = TimeInForce::GTC;
     OrderStatus status = OrderStatus::New;
+    // Unfilled quantity is reserved as open exposure by the pre-trade risk check
+    bool risk_reserved = false;
+    // Position in the store's per-symbol order list (maintained by OrderStore)
+    uint32_t symbol_slot = 0;
     
-    // Linked list pointers for price level management (hot data for matching)
-    Order* next = nullptr;
-    Order* prev = nullptr;
-    
-    // Timestamps and metadata (less frequently accessed)
-    Timestamp timestamp;
-    char symbol[32];
-    char account[32];
+    // ---- Cold metadata: second cache line ----
+    // Interned instrument and account (resolve names with symbol() / account())
+    alignas(64) SymbolId symbol_id = 0;
+    AccountId account_id = 0;
+    Timestamp timestamp = 0;
+    // Pipeline stage stamps when this order is latency-sampled
+    TraceStamps trace;
+    // Intrusive list of the owning account's stored orders (maintained by OrderStore)
+    Order* account_next = nullptr;
+    Order* account_prev = nullptr;
     
-    // Constructors
+    // Constructors. The name overloads intern on every call; hot producers should
+    // resolve IDs once and use the ID overload.
     Order(uint64_t id, Side side, OrderType type, Price price, Quantity quantity, const char* sym)
         : id(OrderId(id)), price(price), quantity(quantity), side(side), type(type),
-          timestamp(std::chrono::system_clock::now()) {
-              std::strncpy(symbol, sym, sizeof(symbol) - 1);
-              symbol[sizeof(symbol) - 1] = '\0';
-              account[0] = '\0';
-          }
+          symbol_id(symbolTable().intern(sym)),
+          timestamp(TscClock::now()) {}
     
     Order(uint64_t id, Side side, OrderType type, TimeInForce tif, Price price, Quantity quantity, 
           const char* sym, const char* acc = "")
         : id(OrderId(id)), price(price), quantity(quantity), side(side), type(type), tif(tif),
-          timestamp(std::chrono::system_clock::now()) {
-              std::strncpy(symbol, sym, sizeof(symbol) - 1);
-              symbol[sizeof(symbol) - 1] = '\0';
-              std::strncpy(account, acc, sizeof(account) - 1);
-              account[sizeof(account) - 1] = '\0';
-          }
+          symbol_id(symbolTable().intern(sym)), account_id(accountTable().intern(acc)),
+          timestamp(TscClock::now()) {}
+    
+    Order(uint64_t id, Side side, OrderType type, TimeInForce tif, Price price, Quantity quantity,
+          SymbolId sym, AccountId acc)
+        : id(OrderId(id)), price(price), quantity(quantity), side(side), type(type), tif(tif),
+          symbol_id(sym), account_id(acc),
+          timestamp(TscClock::now()) {}
     
     // Default constructor for object pooling
     Order() = default;
@@ -66,6 +82,8 @@ struct alignas(64) Order {  // 64-byte alignment for cache line optimization and
     static void operator delete(void* ptr);
 
     // Utility methods
+    const char* symbol() const { return symbolTable().name(symbol_id); }
+    const char* account() const { return accountTable().name(account_id); }
     bool isFullyFilled() const { return filled_quantity >= quantity; }
     Quantity remainingQuantity() const { return quantity - filled_quantity; }
     bool isBuy() const { return side == Side::Buy; }
@@ -126,7 +144,7 @@ struct alignas(64) Order {  // 64-byte alignment for cache line optimization and
      */
     void reset() {
         id = OrderId(0);
-        price = 0.0;
+        price = 0;
         quantity = 0;
         filled_quantity = 0;
         side = Side::Buy;
@@ -135,12 +153,21 @@ struct alignas(64) Order {  // 64-byte alignment for cache line optimization and
         status = OrderStatus::New;
         next = nullptr;
         prev = nullptr;
-        symbol[0] = '\0';
-        account[0] = '\0';
-        timestamp = std::chrono::system_clock::now();
+        symbol_id = 0;
+        account_id = 0;
+        risk_reserved = false;
+        symbol_slot = 0;
+        timestamp = TscClock::now();
+        trace.clear();
+        account_next = nullptr;
+        account_prev = nullptr;
     }
 };
 
+static_assert(offsetof(Order, symbol_slot) + sizeof(uint32_t) <= 64, "Order hot record must fit the first cache line");
+static_assert(offsetof(Order, symbol_id) == 64, "Order cold metadata starts on the second cache line");
+static_assert(sizeof(Order) == 128, "Order is two cache lines");
+
 /**
  * @brief Represents a trade execution
  * SIMD-aligned for vectorized processing
@@ -151,16 +178,16 @@ struct alignas(32) Trade {  // 32-byte alignment for SIMD operations
     OrderId sell_order_id;
     Price price;
     Quantity quantity;
-    Timestamp timestamp;
-    char symbol[32];
+    Timestamp timestamp = 0;
+    SymbolId symbol_id = 0;
     
-    Trade(uint64_t trade_id, OrderId buy_id, OrderId sell_id, Price p, Quantity q, const char* sym)
+    Trade(uint64_t trade_id, OrderId buy_id, OrderId sell_id, Price p, Quantity q, SymbolId sym)
         : id(TradeId(trade_id)), buy_order_id(buy_id), sell_order_id(sell_id), 
           price(p), quantity(q), 
-          timestamp(std::chrono::system_clock::now()) {
-              std::strncpy(symbol, sym, sizeof(symbol) - 1);
-              symbol[sizeof(symbol) - 1] = '\0';
-          }
+          timestamp(TscClock::now()), symbol_id(sym) {}
+    
+    Trade(uint64_t trade_id, OrderId buy_id, OrderId sell_id, Price p, Quantity q, const char* sym)
+        : Trade(trade_id, buy_id, sell_id, p, q, symbolTable().intern(sym)) {}
 
     // Default constructor for object pool
     Trade() = default;
@@ -170,25 +197,30 @@ struct alignas(32) Trade {  // 32-byte alignment for SIMD operations
         id = TradeId(0);
         buy_order_id = OrderId(0);
         sell_order_id = OrderId(0);
-        price = 0.0;
+        price = 0;
         quantity = 0;
-        symbol[0] = '\0';
-        timestamp = std::chrono::system_clock::now();
+        symbol_id = 0;
+        timestamp = TscClock::now();
     }
+
+    const char* symbol() const { return symbolTable().name(symbol_id); }
 };
 
 /**
  * @brief Portfolio tracking for risk management
  */
 struct Portfolio {
-    std::string account;
-    std::unordered_map<std::string, int64_t> positions; // symbol -> position (signed)
-    std::unordered_map<std::string, Price> avg_prices;   // symbol -> average price
+    AccountId account_id = 0;
+    std::unordered_map<SymbolId, int64_t> positions; // symbol -> position (signed)
+    std::unordered_map<SymbolId, Price> avg_prices;   // symbol -> average price (ticks)
+    
+    Portfolio() = default;
+    explicit Portfolio(AccountId acc) : account_id(acc) {}
+    explicit Portfolio(const std::string& acc) : account_id(accountTable().intern(acc)) {}
     
-    Portfolio() : account("") {}
-    explicit Portfolio(std::string acc) : account(std::move(acc)) {}
+    const char* account() const { return accountTable().name(account_id); }
     
-    void updatePosition(const std::string& symbol, int64_t quantity_change, Price price) {
+    void updatePosition(SymbolId symbol, int64_t quantity_change, Price price) {
         positions[symbol] += quantity_change;
         // Simple average price calculation (could be enhanced)
         if (positions[symbol] != 0) {
@@ -196,7 +228,7 @@ struct Portfolio {
         }
     }
     
-    int64_t getPosition(const std::string& symbol) const {
+    int64_t getPosition(SymbolId symbol) const {
         auto it = positions.find(symbol);
         return it != positions.end() ? it->second : 0;
     }
@@ -212,7 +244,10 @@ struct PriceLevel {
     size_t order_count = 0;
     Order* head = nullptr;
     Order* tail = nullptr;
+    // Emptied level left in the sorted book for reuse until compaction
+    bool tombstone = false;
     
+    PriceLevel() : price(0) {}
     explicit PriceLevel(Price p) : price(p) {}
     
     /**
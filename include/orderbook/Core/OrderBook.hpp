@@ -2,19 +2,34 @@
 #include "Types.hpp"
 #include "Order.hpp"
 #include "../Utilities/ObjectPool.hpp"
+#include "../Utilities/FlatHashMap.hpp"
+#include "../Utilities/WaitStrategy.hpp"
+#include "../Utilities/Arena.hpp"
+#include "../Utilities/SeqLock.hpp"
+#include "../Utilities/LockFreeQueue.hpp"
+#include "../Utilities/MpscQueue.hpp"
 #include "Interfaces.hpp"
 #include "MarketData.hpp"
-#include <boost/lockfree/spsc_queue.hpp>
+#include "PriceLadder.hpp"
+#include "DepthCache.hpp"
+#include "MatchingEngine.hpp"
+#include "CommandJournal.hpp"
+#include "BookSnapshot.hpp"
+#include "OrderStore.hpp"
 #include <vector>
+#include <array>
 #include <unordered_map>
 #include <unordered_set>
 #include <optional>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <deque>
+#include <string>
 #include <thread>
 #include <condition_variable>
 #include <atomic>
+#include <chrono>
 // Note: Do not include the top-level OrderBook.hpp from within the core header to avoid circular includes
 
 namespace orderbook {
@@ -36,46 +51,290 @@ struct MarketUpdate {
     size_t order_count;
 };
 
+/**
+ * @brief Consumer-published view of the book for reader threads
+ * Written once per processed batch through a SeqLock, so readers get a consistent
+ * copy without locking and without touching the consumer's live structures.
+ */
+struct BookTop {
+    static constexpr size_t MaxLevels = DepthCache::Capacity;
+
+    std::array<MarketDepth::Level, MaxLevels> bids{};
+    std::array<MarketDepth::Level, MaxLevels> asks{};
+    uint16_t bid_count = 0;
+    uint16_t ask_count = 0;
+    uint32_t bid_level_count = 0;
+    uint32_t ask_level_count = 0;
+    // Slots (bit n = nth best level) changed since the previous version
+    DepthCache::DirtyMask bid_dirty = 0;
+    DepthCache::DirtyMask ask_dirty = 0;
+    uint64_t order_count = 0;
+    // Batches published so far; changes whenever the snapshot does
+    uint64_t version = 0;
+    Timestamp timestamp = 0;
+};
+
+/**
+ * @brief What a producer does when its ingestion shard is full
+ */
+enum class BackpressurePolicy : uint8_t {
+    Reject,    // Fail immediately with ErrorCode::QueueFull
+    SpinWait,  // Retry for backpressure_spin_budget pauses, then reject
+    Overflow   // Spill to a bounded per-shard overflow queue, then reject
+};
+
+/**
+ * @brief Parse a policy name from configuration (reject, spin_wait, overflow)
+ */
+std::optional<BackpressurePolicy> parseBackpressurePolicy(const std::string& name);
+
+/**
+ * @brief Which resting orders one cancelAll() command removes
+ */
+struct MassCancel {
+    enum class Scope : uint8_t { Account, Symbol };
+    Scope scope = Scope::Account;
+    // AccountId or SymbolId, by scope
+    uint32_t key = 0;
+
+    static MassCancel account(AccountId account) { return MassCancel{Scope::Account, account}; }
+    static MassCancel symbol(SymbolId symbol) { return MassCancel{Scope::Symbol, symbol}; }
+};
+
+/**
+ * @brief How incoming orders are matched
+ */
+enum class MatchingMode : uint8_t {
+    Continuous,   // Every aggressive order walks the opposite side on arrival
+    BatchAuction  // Orders collect per batch and uncross at one clearing price
+};
+
+/**
+ * @brief Parse a matching mode name from configuration (continuous, batch_auction)
+ */
+std::optional<MatchingMode> parseMatchingMode(const std::string& name);
+
+/**
+ * @brief Per-ring ingestion statistics
+ */
+struct OrderQueueStats {
+    size_t capacity = 0;
+    size_t high_water_mark = 0;   // Deepest observed occupancy (ring + overflow)
+    uint64_t full_events = 0;     // Pushes that found the ring full
+    uint64_t overflowed = 0;      // Requests spilled to the overflow queue
+    uint64_t rejected = 0;        // Requests refused with ErrorCode::QueueFull
+};
+
+/**
+ * @brief Construction-time settings for OrderBook
+ */
+struct OrderBookOptions {
+    // Instrument tick size used to convert decimal prices at the edges
+    PriceScale price_scale;
+    // Store levels in a direct-indexed PriceLadder instead of sorted vectors
+    bool ladder_mode = false;
+    // Initial ladder window in ticks (grows on recenter if the book spans more)
+    size_t ladder_levels = PriceLadder::DefaultLevels;
+    // Live-order capacity: sizes the order arena and presizes the index so neither
+    // allocates in steady state
+    size_t max_orders = DefaultMaxOrders;
+    // Back the order arena with 2MB huge pages (prefaulted; THP fallback if none reserved)
+    bool huge_pages = false;
+    // Bind the order arena to the NUMA node of wait.cpu_affinity when the consumer is pinned
+    bool numa_bind = true;
+    // Run a dedicated consumer thread; false when an ExchangeEngine shard calls processPending()
+    bool own_consumer_thread = true;
+    // How the consumer thread waits for work, and optional CPU pinning
+    WaitOptions wait;
+    // Behaviour when an ingestion ring is full
+    BackpressurePolicy backpressure = BackpressurePolicy::SpinWait;
+    uint32_t backpressure_spin_budget = 100000;
+    // Per-ring overflow bound for BackpressurePolicy::Overflow
+    size_t overflow_capacity = 1 << 20;
+    // Continuous price-time matching, or frequent batch auctions
+    MatchingMode matching_mode = MatchingMode::Continuous;
+    // Auction cadence in microseconds; 0 runs one auction per drained batch
+    uint32_t auction_interval_us = 0;
+};
+
 /**
  * @brief High-performance order book implementation
  */
 class OrderBook {
 public:
+    /**
+     * @brief Producer handle owning a dedicated SPSC ring into the book
+     * Give each producing thread its own handle; a handle must not be used from two
+     * threads at once or outlive its book. Destroying it returns the ring for reuse.
+     */
+    class Producer {
+    public:
+        Producer() = default;
+        Producer(Producer&& other) noexcept;
+        Producer& operator=(Producer&& other) noexcept;
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+        ~Producer();
+
+        OrderResult addOrder(const Order& order);
+        CancelResult cancelOrder(OrderId id);
+        ModifyResult modifyOrder(OrderId id, Price new_price, Quantity new_quantity);
+        ModifyResult modifyOrder(const Order& resting, Price new_price, Quantity new_quantity);
+        // Batch submission; returns how many leading entries were accepted
+        size_t addOrders(const Order* orders, size_t count);
+        size_t cancelOrders(const OrderId* ids, size_t count);
+
+        bool isValid() const { return book_ != nullptr; }
+        size_t ringIndex() const { return ring_; }
+
+        /**
+         * @brief Requests from this ring the consumer has fully applied, in FIFO order
+         * Monotonic over the ring's lifetime (it is not reset when a ring is reused), so
+         * callers diff against a value read at registration.
+         */
+        uint64_t appliedCount() const;
+
+    private:
+        friend class OrderBook;
+        Producer(OrderBook* book, size_t ring) : book_(book), ring_(ring) {}
+        void release();
+
+        OrderBook* book_ = nullptr;
+        size_t ring_ = 0;
+    };
+
     // Constructor with dependency injection
     OrderBook(RiskManagerPtr risk_manager = nullptr,
               MarketDataPublisherPtr market_data = nullptr,
-              LoggerPtr logger = nullptr);
+              LoggerPtr logger = nullptr,
+              OrderBookOptions options = OrderBookOptions());
     
-    // Core operations
+    // Core operations. These go through a shared ring guarded by a mutex; hot
+    // producers should use registerProducer() instead.
     OrderResult addOrder(const Order& order);
     CancelResult cancelOrder(OrderId id);
     ModifyResult modifyOrder(OrderId id, Price new_price, Quantity new_quantity);
 
+    /**
+     * @brief Modify an order the caller holds a current view of (as OrderManager does)
+     * A size-up is risk-checked on the calling thread and refused with RiskRejected;
+     * the id-only overload leaves that check to the consumer, which drops the modify.
+     */
+    ModifyResult modifyOrder(const Order& resting, Price new_price, Quantity new_quantity);
+
+    /**
+     * @brief Enqueue a burst with one ring publish per chunk and a single consumer wake
+     * @return Number of leading entries accepted; the rest were refused by backpressure
+     */
+    size_t addOrders(const Order* orders, size_t count);
+    size_t cancelOrders(const OrderId* ids, size_t count);
+
+    /**
+     * @brief Cancel every resting order of an account or symbol as one queued command
+     * The store lists each account's and symbol's orders, so the cost is the number
+     * cancelled; each touched level gets one coalesced BookUpdate, in (side, price) order.
+     */
+    CancelResult cancelAll(const MassCancel& filter);
+
+    /**
+     * @brief Allocate (or reuse) a dedicated ingestion ring for one producer thread
+     * @return Handle, or error once MaxProducerRings rings are in use
+     */
+    Result<Producer> registerProducer();
+    size_t getProducerCount() const;
+
+    // Consumer wakeup target when own_consumer_thread is false (e.g. an ExchangeEngine
+    // shard). Set before producers start.
+    void setConsumerWaiter(ConsumerWaiter* waiter) { consumer_waiter_ = waiter; }
+
     // Read trade count without relying on market data. Used by performance tests.
     uint64_t getTradeCount() const;
     
-    // Market data queries
+    // Market data queries. These read the snapshot the consumer publishes after each
+    // batch, so they are safe from any thread; depth is capped at BookTop::MaxLevels.
     std::optional<Price> bestBid() const;
     std::optional<Price> bestAsk() const;
     BestPrices getBestPrices() const;
     MarketDepth getDepth(size_t levels) const;
+    BookTop getTopOfBook() const { return top_.load(); }
     
-    // Statistics
+    // Instrument tick size used to convert decimal prices at the edges
+    const PriceScale& getPriceScale() const { return options_.price_scale; }
+    bool isLadderMode() const { return options_.ladder_mode; }
+    // Resting orders by ID; consumer thread only (an OrderManager driving the book)
+    const OrderStore& getOrderStore() const { return orders_; }
+    bool ownsConsumerThread() const { return options_.own_consumer_thread; }
+
+    // Statistics (from the published snapshot, like the queries above)
     size_t getOrderCount() const;
     size_t getBidLevelCount() const;
     size_t getAskLevelCount() const;
+    // Empty levels awaiting compaction (sorted mode only; ladder mode reclaims immediately)
+    size_t getTombstoneLevelCount() const;
+    // Ingestion queue depth and saturation counters, one entry per ring (0 is the shared ring)
+    std::vector<OrderQueueStats> getOrderQueueStats() const;
 
-    // Optional: apply external market data snapshot or incremental update to internal book state
+    // Optional: apply external market data snapshot or incremental update to internal book state.
+    // Updates are queued from any thread; the consumer applies them on its next drain.
     void applyExternalMarketData(const MarketDepth& depth);
     void applyExternalBookUpdate(const BookUpdate& update);
+    // One feed message's entries as a single contiguous delta; returns how many were queued
+    size_t applyExternalBookUpdates(const BookUpdate* updates, size_t count);
     void clearBook();
 
-    // Process updates from the lock-free queue
+    // Apply queued external updates now (consumer thread only; processPending() does this too)
     void poll();
 
+    // Drain queued order requests on the calling thread (the single consumer).
+    // Returns the number of requests processed.
+    size_t processPending();
+
+    // When a timed batch auction is scheduled, the time processPending() should next run
+    // even without new requests (consumer thread only)
+    std::optional<std::chrono::steady_clock::time_point> nextAuctionDeadline() const;
+
     // Wait for all commands to be processed (for testing)
     void waitForCompletion();
 
+    /**
+     * @brief Recover from, then write ahead to, a command journal
+     * With options.recover, existing segments are replayed into the book first (see
+     * replay()). From then on every request the consumer accepts is appended before it
+     * is applied. Call before submitting orders or handing the book to an ExchangeEngine.
+     * @return Number of commands recovered
+     */
+    Result<size_t> openJournal(const CommandJournalOptions& options);
+
+    /**
+     * @brief Rebuild the book from a journal directory at full speed
+     * Commands are applied on the calling thread with risk checks, logging and market
+     * data publication suppressed; only the final top of book is published. Same
+     * preconditions as openJournal(). Stops at the first damaged record.
+     * @return Number of commands applied
+     */
+    Result<size_t> replay(const std::string& directory);
+
+    /**
+     * @brief Write a point-in-time image of the resting book to path
+     * The consumer copies its levels and orders at its next idle point, so matching
+     * only pauses for the copy; the file is written on the calling thread. With a
+     * journal open, segments the snapshot fully covers are deleted afterwards.
+     * Without a running consumer (no thread, or an engine not started or already
+     * stopped) the copy is taken here.
+     */
+    Result<BookSnapshotInfo> snapshot(const std::string& path);
+
+    /**
+     * @brief Restore resting orders and counters from a snapshot into an empty book
+     * A following openJournal() or replay() applies only commands after the snapshot's
+     * journal sequence. Same preconditions as openJournal().
+     */
+    Result<BookSnapshotInfo> loadSnapshot(const std::string& path);
+
+    // Last journaled sequence (0 when not journaling), and how much of it is synced
+    uint64_t getJournalSequence() const { return journal_ ? journal_->lastSequence() : 0; }
+    uint64_t getDurableJournalSequence() const { return journal_ ? journal_->durableSequence() : 0; }
+
     // Destructor
     ~OrderBook();
 
@@ -91,52 +350,119 @@ private:
     };
 
     // OrderRequest used for lock-free per-thread SPSC ingestion
+    // Minimal POD fields plus the producer-side trace stamps: 64 bytes, one cache line
     struct OrderRequest {
-        enum class Type { Add, Cancel, Modify } type;
-        // Minimal POD fields to avoid allocations on producer hot-path
-        OrderId id{0};
+        // CancelAccount/CancelSymbol carry their key in account_id/symbol_id
+        enum class Type : uint8_t { Add, Cancel, Modify, CancelAccount, CancelSymbol } type;
         Side side{Side::Buy};
         OrderType order_type{OrderType::Limit};
+        TimeInForce tif{TimeInForce::GTC};
+        // Interned names instead of string buffers
+        SymbolId symbol_id{0};
+        OrderId id{0};
         Price price{0};
         Quantity quantity{0};
-        // Fixed-size symbol/account buffers to avoid std::string allocations
-        char symbol[32];
-        char account[32];
-        int tif{0};
+        AccountId account_id{0};
+        bool risk_reserved{false};
+        RequestTraceStamps trace;
     };
+    static_assert(sizeof(OrderRequest) <= 64, "OrderRequest should fit one cache line");
 
-    // Sharded SPSC queues for orders to avoid global producer mutex contention
-    static constexpr size_t OrderQueueCount = 4;
-    static constexpr size_t OrderQueueCapacity = 100000;
-    std::vector<std::unique_ptr<boost::lockfree::spsc_queue<OrderRequest, boost::lockfree::capacity<OrderQueueCapacity>>>> order_queues_;
-    std::atomic<size_t> order_producer_rr_index_{0};
-    std::atomic<bool> order_data_available_{false};
-    mutable std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
+    // One SPSC ring per registered producer, plus the shared ring used by the
+    // handle-less entry points, with its overflow spill and saturation counters.
+    // While a ring's overflow is non-empty its producer appends there too, so FIFO holds.
+    static constexpr size_t OrderQueueCapacity = 1 << 17;
+    struct alignas(64) ProducerRing {
+        LockFreeQueue<OrderRequest, OrderQueueCapacity> queue;
+        std::mutex overflow_mutex;
+        std::deque<OrderRequest> overflow;
+        std::atomic<size_t> overflow_size{0};
+        std::atomic<bool> in_use{false};
+        std::atomic<size_t> high_water_mark{0};
+        std::atomic<uint64_t> full_events{0};
+        std::atomic<uint64_t> overflowed{0};
+        std::atomic<uint64_t> rejected{0};
+        // Requests the consumer has finished dispatching (trades and reports published)
+        std::atomic<uint64_t> applied{0};
+    };
+    static constexpr size_t SharedRingIndex = 0;
+    static constexpr size_t MaxProducerRings = 64;
+    // Requests taken from one ring before moving to the next
+    static constexpr size_t DrainBatchSize = 256;
+    // Requests staged on the producer stack per bulk push
+    static constexpr size_t BatchChunkSize = 64;
+    // Consumer-only bulk pop buffer
+    std::array<OrderRequest, DrainBatchSize> drain_buffer_;
+    // Rings are never freed before the book, so the consumer walks [0, ring_count_) without locking
+    std::array<std::unique_ptr<ProducerRing>, MaxProducerRings> producer_rings_;
+    std::atomic<size_t> ring_count_{0};
+    std::mutex registry_mutex_;
+    std::mutex shared_ring_mutex_;
+    size_t drain_cursor_ = 0;
+    // Consumer wakeup; producers only touch the condition variable when it is parked
+    ConsumerWaiter waiter_;
+    ConsumerWaiter* consumer_waiter_ = nullptr;
     std::thread processing_thread_;
-    std::atomic<bool> running_;
+    size_t processed_count_ = 0;
 
     void processLoop();
+    size_t drainRing(ProducerRing& ring);
+    // Apply queued external market data; returns the number of entries applied
+    size_t drainMarketQueue();
+    bool enqueueRequest(ProducerRing& ring, const OrderRequest& req);
+    size_t enqueueBatch(ProducerRing& ring, const OrderRequest* reqs, size_t count);
+    static void fillAddRequest(OrderRequest& req, const Order& order);
+    // Producer-side pre-trade check; marks req as holding a reservation when one was taken
+    bool reserveRisk(const Order& order, OrderRequest& req, std::string* reason = nullptr);
+    void releaseRisk(const OrderRequest& req);
+    // Pre-trade check of a modify's size-up; reserves the added quantity when it passes
+    bool reserveResize(const Order& order, Price target_price, Quantity target_quantity,
+                       std::string* reason = nullptr);
+    size_t submitAddBatch(ProducerRing& ring, const Order* orders, size_t count);
+    size_t submitCancelBatch(ProducerRing& ring, const OrderId* ids, size_t count);
+    OrderResult submitAdd(ProducerRing& ring, const Order& order);
+    CancelResult submitCancel(ProducerRing& ring, OrderId id);
+    ModifyResult submitModify(ProducerRing& ring, OrderId id, Price new_price, Quantity new_quantity,
+                              const Order* resting = nullptr);
+    void dispatchRequest(const OrderRequest& req);
+    void applyRequest(const OrderRequest& req);
+    // applyRequest for a latency-sampled request: stamps the consumer stages and records the trace
+    void applySampledRequest(const OrderRequest& req);
+    void flushRetiredOrders();
+    // Consumer side of snapshot(): copy the book at an idle point
+    void captureImage(BookImage& image) const;
+    void serviceSnapshotRequest();
+    static JournalCommand toJournalCommand(const OrderRequest& req);
+    static OrderRequest fromJournalCommand(const JournalCommand& command);
+    // Apply recovered commands with risk, logging and publication detached
+    template<typename Source>
+    size_t replayCommands(Source&& next_command);
     void processAddOrder(Order* order);
     void processCancelOrder(OrderId id);
+    void processMassCancel(const MassCancel& filter);
     void processModifyOrder(OrderId id, Price new_price, Quantity new_quantity);
 
-    // Lock-free queue for market data updates (SPSC)
-    // Increased capacity to absorb bursts during performance tests (tuned for memory)
-    // Sharded SPSC queues for market updates to avoid multi-producer contention.
-    static constexpr size_t MarketDataQueueCount = 4; // tuned for typical thread count
-    static constexpr size_t MarketDataQueueCapacity = 100000;
-    std::vector<std::unique_ptr<boost::lockfree::spsc_queue<MarketUpdate, boost::lockfree::capacity<MarketDataQueueCapacity>>>> market_queues_;
-    // Simple round-robin index allocator for threads. Each producing thread gets a queue index
-    // stored thread-locally to avoid hashing or heavy atomics on hot path.
-    std::atomic<size_t> producer_rr_index_{0};
+    // External market data from any number of feed threads into the consumer
+    static constexpr size_t MarketDataQueueCapacity = 1 << 18;
+    using MarketUpdateQueue = MpscQueue<MarketUpdate, MarketDataQueueCapacity>;
+    std::unique_ptr<MarketUpdateQueue> market_queue_;
+    SeqLock<BookTop> top_;
+    // Write-ahead journal of accepted requests (consumer appends; null when off)
+    std::unique_ptr<CommandJournal> journal_;
+    // Journal sequence already contained in a loaded snapshot
+    uint64_t snapshot_sequence_ = 0;
+    // snapshot() hand-off: the caller parks here while the consumer fills the image
+    std::mutex snapshot_call_mutex_;
+    std::mutex snapshot_mutex_;
+    std::condition_variable snapshot_cv_;
+    std::atomic<bool> snapshot_requested_{false};
+    BookImage* snapshot_image_ = nullptr;
+    bool snapshot_captured_ = false;
     // Per-OrderBook trade counter for benchmarking without a publisher
     std::atomic<uint64_t> trade_count_{0};
-    // Simple single-threaded LIFO free-list for Orders (consumer-only)
-    static constexpr size_t DefaultOrderPoolSize = 20000;
-    std::vector<Order*> order_free_list_;
-    // Track in-use pointers to detect double-release / misuse during development
-    std::unordered_set<Order*> order_in_use_set_;
+    // Resting orders and their one ID index: an arena of max_orders slots with heap
+    // overflow (consumer-only)
+    OrderStore orders_;
     // Deferred retirement list to avoid immediate reuse within same processing batch
     std::vector<Order*> order_retire_list_;
     // Debug counters for diagnostics
@@ -148,41 +474,109 @@ private:
     // Optimized storage: use heap-allocated PriceLevel for pointer stability
     std::vector<std::unique_ptr<PriceLevel>> bids_;
     std::vector<std::unique_ptr<PriceLevel>> asks_;
-    std::unordered_map<Price, PriceLevel*> price_index_;
-    std::unordered_map<OrderId, OrderLocation, OrderIdHash> order_index_;
-    // Note: orders in the book are owned by price levels and managed manually
+    // Per-side price indexes (a bid and an ask level may share a price)
+    std::unordered_map<Price, PriceLevel*> bid_index_;
+    std::unordered_map<Price, PriceLevel*> ask_index_;
+    // Emptied levels below the best price, reclaimed by compactPriceLevels()
+    size_t bid_tombstones_ = 0;
+    size_t ask_tombstones_ = 0;
+    // Ladder mode storage (used instead of bids_/asks_ and the price indexes)
+    PriceLadder bid_ladder_;
+    PriceLadder ask_ladder_;
+    // Top levels per side, kept current as levels change (consumer-only)
+    DepthCache depth_;
+    // Depth slots the market-data publisher consumed since the last BookTop
+    DepthCache::DirtyMask pending_top_dirty_[2] = {0, 0};
+    MarketDepth published_depth_;
     
+    // Construction-time settings (price scale, level storage mode)
+    OrderBookOptions options_;
+
     // Dependencies
     RiskManagerPtr risk_manager_;
     MarketDataPublisherPtr market_data_;
     LoggerPtr logger_;
+
+    // The one price-time matcher; OrderBook supplies the level walk and the fill handling
+    MatchingEngine matching_engine_;
     
     // Helper methods
+    PriceLevel* findPriceLevel(Price price, Side side);
     PriceLevel* findOrCreatePriceLevel(Price price, Side side);
+    void relinkOrderLocations(PriceLadder& ladder);
     void removePriceLevel(PriceLevel* level, Side side);
+    void popEmptyBestLevels(PriceLevel* level, Side side);
+    void compactPriceLevels();
     void maintainSortedOrder();
     void rebuildPriceIndex();
     void publishMarketDataUpdate();
-    void publishBookUpdate(BookUpdate::Type type, Side side, Price price, 
-                          Quantity quantity, size_t order_count);
+    // Consumer thread only: refill stale depth sides, then publish them for readers
+    void refreshDepthCache();
+    void publishTopOfBook();
+    // Carries the level's aggregate after the change, so receivers can keep L2 state
+    void publishBookUpdate(BookUpdate::Type type, Side side, const PriceLevel& level);
     
-    // Matching and trade execution
+    // Matching and trade execution. processMatching branches on the aggressor side and
+    // storage mode once; the matching loop below is instantiated per side and storage.
     void processMatching(Order& incoming_order);
-    void executeMatching(Order& incoming_order, std::vector<std::unique_ptr<PriceLevel>>& opposite_levels);
-    void matchAgainstPriceLevel(Order& incoming_order, PriceLevel& price_level);
-    void executeTrade(Order& aggressive_order, Order& passive_order, 
-                     Price trade_price, Quantity trade_quantity);
+    template<Side S> void matchAgainst(Order& incoming_order);
+    template<Side S, typename Walk> void executeMatching(Order& incoming_order, Walk&& walk);
+    bool canFillCompletely(const Order& incoming_order);
+    template<Side S> std::vector<std::unique_ptr<PriceLevel>>& sideLevels() {
+        if constexpr (S == Side::Buy) return bids_; else return asks_;
+    }
+    template<Side S> PriceLadder& sideLadder() {
+        if constexpr (S == Side::Buy) return bid_ladder_; else return ask_ladder_;
+    }
+    void handleFill(Order& incoming_order, const Fill& fill);
+    void executeTrade(const Order& aggressive_order, const Fill& fill);
+
+    // Batch auction mode: resting limit orders do not match on arrival and immediate
+    // orders (market, IOC) wait in auction_held_ for the next runAuction()
+    bool batchAuction() const { return options_.matching_mode == MatchingMode::BatchAuction; }
+    bool auctionDue(std::chrono::steady_clock::time_point now) const;
+    // Something that may cross arrived; starts the interval when none is running
+    void markAuctionPending();
+    void holdForAuction(Order* order);
+    // Uncross at the price that maximizes executed volume, filling in price-time priority
+    void runAuction();
+    // Book side of one auction fill of a resting order
+    void settleAuctionFill(Order* order, PriceLevel* level);
+    // Something arrived that may cross since the last auction
+    bool auction_pending_ = false;
+    std::chrono::steady_clock::time_point next_auction_{};
+    // Held immediate orders per side (0 = buy), in arrival order
+    std::vector<Order*> auction_held_[2];
+    // Scratch for runAuction(), kept for its capacity
+    std::vector<PriceLevel*> auction_levels_[2];
+    // Quantity offered at each crossing price, before accumulation into the curves
+    struct AuctionPoint {
+        Price price;
+        Quantity buy;
+        Quantity sell;
+    };
+    std::vector<AuctionPoint> auction_curve_;
+    // processMassCancel() scratch: one entry per cancelled order, merged per level
+    struct MassCancelLevel {
+        PriceLevel* level;
+        Side side;
+        Price price;
+    };
+    std::vector<Order*> mass_cancel_orders_;
+    std::vector<MassCancelLevel> mass_cancel_levels_;
+    // Top-of-book publication deferred to the end of the drain
+    bool market_data_due_ = false;
+    void emitMarketDataUpdate();
 
     // Accessor for performance harness to read trade count without relying on market_data
     // Implemented in header above as public method
-
-    // Get a deterministic, thread-affine queue index for producers
-    size_t getProducerQueueIndex();
-    size_t getOrderQueueIndex();
     
     // Constants
     static constexpr size_t InitialCapacity = 1024;
-    static constexpr Price MinPriceIncrement = 0.01;
+    // Compact once this many tombstones accumulate and the consumer is idle
+    static constexpr size_t TombstoneCompactionThreshold = 256;
+    // How often a waiting snapshot() checks that its consumer is still running
+    static constexpr std::chrono::milliseconds SnapshotPollInterval{10};
 };
 
 }
\ No newline at end of file
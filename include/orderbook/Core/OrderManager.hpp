@@ -2,23 +2,34 @@
 #include "Types.hpp"
 #include "Order.hpp"
 #include "Interfaces.hpp"
-#include <unordered_map>
+#include "OrderStore.hpp"
 #include <memory>
 #include <atomic>
 
 namespace orderbook {
 
+class OrderBook;
+
 /**
  * @brief Manages order lifecycle with O(1) lookup and validation
- * Provides centralized order management with state tracking and validation
+ * A view over one OrderStore: its own when standalone, or a book's, so an order is
+ * never stored or indexed twice.
  */
 class OrderManager {
 public:
     /**
      * @brief Constructor
      * @param logger Logger instance for order lifecycle events
+     * @param max_orders Live orders the lookup tables are presized for
+     */
+    explicit OrderManager(LoggerPtr logger = nullptr, size_t max_orders = DefaultMaxOrders);
+
+    /**
+     * @brief View over a book's orders instead of keeping a copy
+     * The book must be built with own_consumer_thread = false: each call submits to it
+     * and drains it on the calling thread, which becomes the book's consumer.
      */
-    explicit OrderManager(LoggerPtr logger = nullptr);
+    explicit OrderManager(OrderBook& book, LoggerPtr logger = nullptr);
     
     /**
      * @brief Destructor
@@ -39,6 +50,21 @@ public:
      */
     CancelResult cancelOrder(OrderId order_id);
     
+    /**
+     * @brief Cancel every active order of an account in one pass over its order list
+     * A book-backed manager submits one mass-cancel command to the book.
+     * @param account Account whose orders are cancelled
+     * @return Number of orders cancelled
+     */
+    size_t cancelAll(AccountId account);
+
+    /**
+     * @brief Cancel the active orders among ids
+     * A book-backed manager submits them as one batch and drains the book once.
+     * @return Number of orders cancelled
+     */
+    size_t cancelOrders(const OrderId* ids, size_t count);
+    
     /**
      * @brief Modify an existing order
      * @param order_id ID of order to modify
@@ -63,7 +89,8 @@ public:
     OrderLocation getOrderLocation(OrderId order_id) const;
     
     /**
-     * @brief Set order location after adding to price level
+     * @brief Set order location after adding to price level (standalone only; a book
+     * tracks its own)
      * @param order_id Order ID
      * @param location Order location in book
      */
@@ -71,20 +98,21 @@ public:
     
     /**
      * @brief Remove order from management (after full fill or cancel)
+     * A book-backed manager cancels it in the book instead.
      * @param order_id Order ID to remove
-     * @return Unique pointer to removed order for cleanup
+     * @return true if the order was found
      */
-    std::unique_ptr<Order> removeOrder(OrderId order_id);
+    bool removeOrder(OrderId order_id);
     
     /**
-     * @brief Update order status
+     * @brief Update order status (standalone only; a book owns its orders' state)
      * @param order_id Order ID
      * @param status New status
      */
     void updateOrderStatus(OrderId order_id, OrderStatus status);
     
     /**
-     * @brief Fill order with specified quantity
+     * @brief Fill order with specified quantity (standalone only)
      * @param order_id Order ID
      * @param fill_quantity Quantity filled
      * @return true if order is now fully filled
@@ -115,13 +143,18 @@ public:
      */
     void clear();
 
+    /**
+     * @brief True when this manager is a view over an OrderBook
+     */
+    bool isBookBacked() const { return book_ != nullptr; }
+
 private:
-    // Order storage with O(1) lookup
-    std::unordered_map<OrderId, std::unique_ptr<Order>, OrderIdHash> orders_;
-    
-    // Order location tracking for fast book operations
-    std::unordered_map<OrderId, OrderLocation, OrderIdHash> order_locations_;
+    // Standalone storage (null when viewing a book)
+    std::unique_ptr<OrderStore> own_orders_;
+    OrderBook* book_ = nullptr;
+    const OrderStore& orders() const;
     
+
     // Atomic counter for order ID generation
     std::atomic<uint64_t> next_order_id_;
     
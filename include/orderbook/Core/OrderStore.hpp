@@ -0,0 +1,121 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include "../Utilities/Arena.hpp"
+#include "../Utilities/FlatHashMap.hpp"
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Owner of live Order objects and their single OrderId index
+ *
+ * Orders live in a contiguous arena of max_orders slots, overflowing to the heap;
+ * each is indexed once by ID together with its book location. OrderBook keeps its
+ * resting orders here and OrderManager is a view over one, so an order is stored
+ * and hashed exactly once. Indexed orders are also threaded onto an intrusive list
+ * per account and kept in a dense list per symbol, so one account's or symbol's
+ * orders are enumerable without a scan. Single-threaded: only the owning thread may
+ * touch it.
+ */
+class OrderStore {
+public:
+    using Index = FlatHashMap<OrderId, OrderLocation, OrderIdHash>;
+    using iterator = Index::iterator;
+    using const_iterator = Index::const_iterator;
+
+    explicit OrderStore(size_t max_orders = DefaultMaxOrders, ArenaOptions options = ArenaOptions());
+    ~OrderStore();
+
+    OrderStore(const OrderStore&) = delete;
+    OrderStore& operator=(const OrderStore&) = delete;
+
+    /**
+     * @brief Storage for a new, default-constructed order (not yet indexed)
+     */
+    Order* acquire();
+
+    /**
+     * @brief Destroy an order from acquire(); the caller unindexes it first
+     */
+    void release(Order* order);
+
+    // Index of stored orders by ID
+    iterator find(OrderId id) { return index_.find(id); }
+    const_iterator find(OrderId id) const { return index_.find(id); }
+    iterator begin() { return index_.begin(); }
+    iterator end() { return index_.end(); }
+    const_iterator begin() const { return index_.begin(); }
+    const_iterator end() const { return index_.end(); }
+    /**
+     * @brief Index an order (not already indexed) and link it onto its account's and
+     * symbol's lists
+     */
+    OrderLocation& insert(const OrderLocation& location);
+    void erase(iterator it) {
+        unlinkAccount(it->second.order);
+        unlinkSymbol(it->second.order);
+        index_.erase(it);
+    }
+    void erase(OrderId id) {
+        auto it = index_.find(id);
+        if (it != index_.end()) erase(it);
+    }
+    size_t size() const { return index_.size(); }
+    bool empty() const { return index_.empty(); }
+
+    Order* order(OrderId id) const {
+        auto it = index_.find(id);
+        return it != index_.end() ? it->second.order : nullptr;
+    }
+
+    /**
+     * @brief First indexed order of an account; follow Order::account_next for the rest
+     * Stable while walking only if the caller saves account_next before erasing.
+     */
+    Order* accountOrders(AccountId account) const {
+        return account < account_heads_.size() ? account_heads_[account] : nullptr;
+    }
+
+    /**
+     * @brief Indexed orders of a symbol, in no particular order
+     * Erasing reorders the list: copy it before erasing while walking.
+     */
+    const std::vector<Order*>& symbolOrders(SymbolId symbol) const {
+        static const std::vector<Order*> none;
+        return symbol < symbol_orders_.size() ? symbol_orders_[symbol] : none;
+    }
+
+    /**
+     * @brief Release every indexed order and empty the index
+     */
+    void clear();
+
+    /**
+     * @brief Empty the index without releasing; the caller retires the orders itself
+     */
+    void clearIndex() {
+        index_.clear();
+        account_heads_.clear();
+        symbol_orders_.clear();
+    }
+
+    bool owns(const Order* order) const { return pool_.owns(order); }
+    const ArenaPool<Order>& pool() const { return pool_; }
+    // Orders currently stored beyond the arena
+    size_t heapCount() const { return heap_count_; }
+
+private:
+    void unlinkAccount(Order* order);
+    void unlinkSymbol(Order* order);
+
+    ArenaPool<Order> pool_;
+    Index index_;
+    // List head per AccountId (interned IDs are dense)
+    std::vector<Order*> account_heads_;
+    // Orders per SymbolId; Order::symbol_slot is each one's position, removal swaps in the last
+    std::vector<std::vector<Order*>> symbol_orders_;
+    size_t heap_count_ = 0;
+};
+
+}
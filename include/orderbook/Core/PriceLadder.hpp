@@ -0,0 +1,164 @@
+#pragma once
+#include "Types.hpp"
+#include "Order.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace orderbook {
+
+/**
+ * @brief Direct-indexed price ladder for one side of the book
+ * Levels live in a contiguous array indexed by tick offset from a moving base
+ * price. A bitmap of active levels finds the best price with find-first-set.
+ * The window recenters (and grows) when a price falls outside it; that relocates
+ * levels, so callers holding PriceLevel pointers must watch generation().
+ */
+class PriceLadder {
+public:
+    static constexpr size_t DefaultLevels = 4096;
+    static constexpr size_t MaxLevels = size_t(1) << 22;
+
+    explicit PriceLadder(Side side = Side::Buy, size_t levels = DefaultLevels);
+
+    /**
+     * @brief Find the active level at a price
+     * @return Level pointer or nullptr if the price has no active level
+     */
+    PriceLevel* find(Price price) {
+        int64_t idx = price - base_;
+        if (idx < 0 || idx >= static_cast<int64_t>(levels_.size()) || !testBit(idx)) {
+            return nullptr;
+        }
+        return &levels_[idx];
+    }
+
+    /**
+     * @brief Find or activate the level at a price, recentering if needed
+     * @return Level pointer or nullptr if the price cannot fit in MaxLevels
+     */
+    PriceLevel* findOrCreate(Price price) {
+        int64_t idx = price - base_;
+        if (idx < 0 || idx >= static_cast<int64_t>(levels_.size())) {
+            if (!recenter(price)) {
+                return nullptr;
+            }
+            idx = price - base_;
+        }
+        if (!testBit(idx)) {
+            levels_[idx] = PriceLevel(price);
+            setBit(idx);
+            ++active_levels_;
+            if (best_ < 0 || isBetter(idx, best_)) {
+                best_ = idx;
+            }
+        }
+        return &levels_[idx];
+    }
+
+    /**
+     * @brief Deactivate a level owned by this ladder
+     */
+    void remove(PriceLevel* level) {
+        int64_t idx = level - levels_.data();
+        if (idx < 0 || idx >= static_cast<int64_t>(levels_.size()) || !testBit(idx)) {
+            return;
+        }
+        clearBit(idx);
+        --active_levels_;
+        levels_[idx] = PriceLevel(level->price);
+        if (idx == best_) {
+            best_ = nextIndex(idx);
+        }
+    }
+
+    /**
+     * @brief Best active level (highest bid / lowest ask)
+     */
+    PriceLevel* best() { return best_ >= 0 ? &levels_[best_] : nullptr; }
+    const PriceLevel* best() const { return best_ >= 0 ? &levels_[best_] : nullptr; }
+
+    /**
+     * @brief Visit active levels from best to worst until the visitor returns false
+     */
+    template<typename Visitor>
+    void forEachLevel(Visitor&& visitor) {
+        for (int64_t idx = best_; idx >= 0; idx = nextIndex(idx)) {
+            if (!visitor(levels_[idx])) break;
+        }
+    }
+
+    template<typename Visitor>
+    void forEachLevel(Visitor&& visitor) const {
+        for (int64_t idx = best_; idx >= 0; idx = nextIndex(idx)) {
+            if (!visitor(static_cast<const PriceLevel&>(levels_[idx]))) break;
+        }
+    }
+
+    size_t activeLevelCount() const { return active_levels_; }
+    size_t capacity() const { return levels_.size(); }
+    Price basePrice() const { return base_; }
+
+    /**
+     * @brief Incremented every time recentering relocates levels
+     */
+    uint64_t generation() const { return generation_; }
+
+    /**
+     * @brief Drop all levels and keep the current window
+     */
+    void clear();
+
+private:
+    bool testBit(int64_t idx) const { return (bits_[idx >> 6] >> (idx & 63)) & 1u; }
+    void setBit(int64_t idx) { bits_[idx >> 6] |= (uint64_t(1) << (idx & 63)); }
+    void clearBit(int64_t idx) { bits_[idx >> 6] &= ~(uint64_t(1) << (idx & 63)); }
+
+    bool isBetter(int64_t a, int64_t b) const { return side_ == Side::Buy ? a > b : a < b; }
+
+    // Next worse active index after idx, or -1
+    int64_t nextIndex(int64_t idx) const {
+        return side_ == Side::Buy ? scanDown(idx - 1) : scanUp(idx + 1);
+    }
+
+    // Highest active index <= from, or -1
+    int64_t scanDown(int64_t from) const {
+        if (from < 0) return -1;
+        int64_t word = from >> 6;
+        uint64_t mask = bits_[word] & (~uint64_t(0) >> (63 - (from & 63)));
+        while (true) {
+            if (mask) return (word << 6) + 63 - __builtin_clzll(mask);
+            if (--word < 0) return -1;
+            mask = bits_[word];
+        }
+    }
+
+    // Lowest active index >= from, or -1
+    int64_t scanUp(int64_t from) const {
+        int64_t words = static_cast<int64_t>(bits_.size());
+        if (from >= static_cast<int64_t>(levels_.size())) return -1;
+        int64_t word = from >> 6;
+        uint64_t mask = bits_[word] & (~uint64_t(0) << (from & 63));
+        while (true) {
+            if (mask) return (word << 6) + __builtin_ctzll(mask);
+            if (++word >= words) return -1;
+            mask = bits_[word];
+        }
+    }
+
+    /**
+     * @brief Move the window so that price and all active levels fit
+     * @return false if the required span exceeds MaxLevels
+     */
+    bool recenter(Price price);
+
+    Side side_;
+    Price base_ = 0;
+    std::vector<PriceLevel> levels_;
+    std::vector<uint64_t> bits_;
+    size_t active_levels_ = 0;
+    int64_t best_ = -1;
+    uint64_t generation_ = 0;
+};
+
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "Types.hpp"
+#include "InternTable.hpp"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Instrument definition fed to buildSymbolMaster()
+ */
+struct SymbolDefinition {
+    std::string symbol;        // Wire symbol and lookup key (at most 31 bytes)
+    std::string name;          // Display name, truncated to fit
+    uint32_t security_id = 0;  // Venue's numeric instrument ID
+    double tick_size = 0.01;
+    Quantity lot_size = 1;
+    Price min_price = 0;       // Ticks; 0 = no band
+    Price max_price = 0;
+};
+
+/**
+ * @brief One instrument as stored in the symbol master (fixed layout, 128 bytes)
+ */
+struct SymbolMasterEntry {
+    char symbol[32];           // NUL-padded
+    char name[56];             // NUL-padded
+    uint32_t security_id;
+    uint32_t reserved;
+    uint64_t lot_size;
+    double tick_size;
+    int64_t min_price;
+    int64_t max_price;
+
+    std::string_view symbolView() const { return std::string_view(symbol, strnlen(symbol, sizeof(symbol))); }
+    PriceScale priceScale() const { return PriceScale(tick_size); }
+    bool hasPriceBand() const { return max_price > 0; }
+};
+static_assert(sizeof(SymbolMasterEntry) == 128, "symbol master entry layout");
+
+/**
+ * @brief Symbol master file header, followed by the bucket displacements, the slot
+ * table and the entries
+ *
+ * Names resolve through a hash-and-displace perfect hash built offline: the name's
+ * hash picks a bucket, the bucket's displacement picks a slot, and the slot holds
+ * the entry index. Every stored name lands in its own slot, so a lookup is two
+ * array reads and one name compare.
+ */
+struct SymbolMasterHeader {
+    static constexpr char Magic[8] = {'O', 'B', 'S', 'Y', 'M', 'M', 'S', 'T'};
+    static constexpr uint32_t FormatVersion = 1;
+    static constexpr uint32_t EmptySlot = UINT32_MAX;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t entry_bytes;
+    uint32_t count;
+    uint32_t bucket_count;     // Power of two
+    uint32_t slot_count;       // Power of two
+    uint32_t reserved;
+    uint64_t buckets_offset;   // uint32_t displacement per bucket
+    uint64_t slots_offset;     // uint32_t entry index per slot
+    uint64_t entries_offset;   // SymbolMasterEntry[count]
+};
+static_assert(sizeof(SymbolMasterHeader) == 56, "symbol master header layout");
+
+/**
+ * @brief Encode definitions into a symbol master image
+ * Fails on an empty, over-long or duplicate symbol.
+ */
+Result<std::vector<unsigned char>> buildSymbolMaster(const std::vector<SymbolDefinition>& symbols);
+
+/**
+ * @brief Build a symbol master and write it to path
+ * @return Number of symbols written
+ */
+Result<size_t> writeSymbolMaster(const std::string& path, const std::vector<SymbolDefinition>& symbols);
+
+/**
+ * @brief Read-only view of a symbol master file mapped at startup
+ *
+ * open() maps the file and interns every symbol, so there is no parsing and
+ * both lookups are O(1): byId() indexes by interned ID and find(name) goes
+ * through the file's perfect hash. Entries stay valid for the master's lifetime.
+ */
+class SymbolMaster {
+public:
+    static Result<std::unique_ptr<SymbolMaster>> open(const std::string& path,
+                                                      InternTable& symbols = symbolTable());
+    ~SymbolMaster();
+
+    SymbolMaster(const SymbolMaster&) = delete;
+    SymbolMaster& operator=(const SymbolMaster&) = delete;
+
+    size_t size() const { return header_->count; }
+    const SymbolMasterEntry& entry(size_t index) const { return entries_[index]; }
+    const SymbolMasterEntry* begin() const { return entries_; }
+    const SymbolMasterEntry* end() const { return entries_ + header_->count; }
+
+    // Entry for a symbol name, or nullptr
+    const SymbolMasterEntry* find(std::string_view symbol) const;
+
+    // Entry for an interned SymbolId, or nullptr
+    const SymbolMasterEntry* byId(SymbolId id) const {
+        return id < by_symbol_.size() ? by_symbol_[id] : nullptr;
+    }
+
+    // Interned ID of entry(index)
+    SymbolId symbolId(size_t index) const { return symbol_ids_[index]; }
+
+private:
+    SymbolMaster() = default;
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    const SymbolMasterHeader* header_ = nullptr;
+    const uint32_t* buckets_ = nullptr;
+    const uint32_t* slots_ = nullptr;
+    const SymbolMasterEntry* entries_ = nullptr;
+    // Indexed by SymbolId; nullptr for symbols not in the master
+    std::vector<const SymbolMasterEntry*> by_symbol_;
+    std::vector<SymbolId> symbol_ids_;
+};
+
+using SymbolMasterPtr = std::shared_ptr<const SymbolMaster>;
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
+#include <cmath>
 #include <chrono>
 #include <string>
 #include <variant>
@@ -18,13 +20,26 @@ namespace orderbook {
         constexpr bool operator<(const OrderId& other) const { return value < other.value; }
     };
 
-    // Custom hash function for OrderId to use in unordered_map
+    // 64-bit finalizer (MurmurHash3 fmix64) so sequential IDs spread over all bits
+    constexpr uint64_t mixHash64(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // Custom hash function for OrderId (unordered_map and FlatHashMap)
     struct OrderIdHash {
         std::size_t operator()(const OrderId& id) const {
-            return std::hash<uint64_t>{}(id.value);
+            return static_cast<std::size_t>(mixHash64(id.value));
         }
     };
 
+    // Default live-order capacity, matching [orderbook] max_orders
+    constexpr size_t DefaultMaxOrders = 1000000;
+
     // Strong type for Trade IDs
     struct TradeId {
         uint64_t value;
@@ -37,10 +52,38 @@ namespace orderbook {
     };
 
     // Template-friendly type aliases
-    using Price = double;
+    // Prices are fixed-point integer ticks; convert with PriceScale at the protocol edges
+    using Price = int64_t;
     using Quantity = uint64_t;
-    using Timestamp = std::chrono::system_clock::time_point;
+    // TscClock ticks; convert with TscClock::toWallClock only when exporting
+    using Timestamp = uint64_t;
     using SequenceNumber = uint64_t;
+    // Interned instrument and account identifiers (see InternTable); 0 is the empty name
+    using SymbolId = uint32_t;
+    using AccountId = uint32_t;
+
+    /**
+     * @brief Per-instrument fixed-point price scale
+     * Maps decimal wire prices to integer ticks used by the book and matching path
+     */
+    struct PriceScale {
+        double tick_size;
+
+        constexpr PriceScale() : tick_size(0.01) {}
+        constexpr explicit PriceScale(double tick) : tick_size(tick > 0.0 ? tick : 0.01) {}
+
+        Price toTicks(double price) const {
+            return static_cast<Price>(std::llround(price / tick_size));
+        }
+
+        double toDouble(Price ticks) const {
+            return static_cast<double>(ticks) * tick_size;
+        }
+
+        bool isOnTick(double price) const {
+            return std::abs(price - toDouble(toTicks(price))) < tick_size * 1e-6;
+        }
+    };
 
     // Core enums
     enum class Side : uint8_t { Buy, Sell };
@@ -67,6 +110,14 @@ namespace orderbook {
         ERROR 
     };
 
+    // Error categories callers may need to act on (retry vs. give up)
+    enum class ErrorCode : uint8_t {
+        None,
+        Generic,
+        QueueFull,  // Ingestion queue saturated; the request was not accepted
+        RiskRejected  // Refused by the pre-trade risk check
+    };
+
     // Result template for error handling
     template<typename T>
     class Result {
@@ -75,8 +126,10 @@ namespace orderbook {
             return Result(std::move(value));
         }
         
-        static Result error(const std::string& message) {
-            return Result(message);
+        static Result error(const std::string& message, ErrorCode code = ErrorCode::Generic) {
+            Result result(message);
+            result.code_ = code;
+            return result;
         }
         
         bool isSuccess() const {
@@ -99,6 +152,10 @@ namespace orderbook {
             return std::get<std::string>(data_);
         }
         
+        ErrorCode errorCode() const {
+            return code_;
+        }
+        
         // Move semantics
         T&& moveValue() {
             return std::move(std::get<T>(data_));
@@ -109,6 +166,7 @@ namespace orderbook {
         explicit Result(const std::string& error) : data_(error) {}
         
         std::variant<T, std::string> data_;
+        ErrorCode code_ = ErrorCode::None;
     };
 
     // Specific result types for common operations
@@ -0,0 +1,107 @@
+#pragma once
+#include "orderbook/Core/Types.hpp"
+#include "orderbook/Core/Interfaces.hpp"
+#include "orderbook/Core/MarketData.hpp"
+#include "orderbook/Utilities/SeqLock.hpp"
+#include <array>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief One aggregated external price level
+ */
+struct L2Level {
+    Price price = 0;
+    Quantity quantity = 0;
+    uint32_t order_count = 0;
+};
+
+/**
+ * @brief Fixed-size L2 view handed to reader threads
+ */
+struct L2Snapshot {
+    static constexpr size_t MaxLevels = 20;
+
+    std::array<L2Level, MaxLevels> bids{};
+    std::array<L2Level, MaxLevels> asks{};
+    uint16_t bid_count = 0;
+    uint16_t ask_count = 0;
+    // Waiting for a snapshot after a gap; levels are the last good state
+    bool stale = true;
+    SequenceNumber sequence = 0;
+    Timestamp timestamp = 0;
+};
+
+/**
+ * @brief Aggregated-level mirror of an external feed, separate from the matching book
+ *
+ * Holds price -> quantity/count per side (no Order objects) in sorted vectors owned by
+ * one feed thread. Every apply republishes the top levels through a SeqLock, so
+ * strategy threads read a consistent L2Snapshot without locking or touching the feed
+ * thread's state. A new book is stale until its first snapshot; sequenced updates that
+ * skip a number mark it stale again, and incrementals are ignored until a snapshot.
+ */
+class L2Book {
+public:
+    enum class ApplyResult : uint8_t {
+        Applied,
+        Duplicate,  // Sequence at or behind the last applied one
+        Gap,        // Sequence skipped; the book is now stale
+        Stale       // Ignored while waiting for a snapshot
+    };
+
+    explicit L2Book(size_t published_levels = L2Snapshot::MaxLevels);
+
+    /**
+     * @brief Replace both sides with a full snapshot and clear the stale flag
+     * @param sequence Feed sequence of the snapshot (0 = unsequenced)
+     */
+    ApplyResult applySnapshot(const MarketDepth& depth, SequenceNumber sequence = 0);
+
+    /**
+     * @brief Apply one feed message's level changes as a single delta
+     * @param sequence Feed sequence of the message (0 = unsequenced, no gap check)
+     */
+    ApplyResult applyUpdates(const BookUpdate* updates, size_t count, SequenceNumber sequence = 0);
+    ApplyResult applyUpdate(const BookUpdate& update, SequenceNumber sequence = 0) {
+        return applyUpdates(&update, 1, sequence);
+    }
+
+    /**
+     * @brief Mark the book stale after a gap detected outside the book (e.g. session level)
+     */
+    void markStale();
+
+    /**
+     * @brief Drop every level (levels stay stale until the next snapshot)
+     */
+    void clear();
+
+    // Reader side: any thread, lock-free
+    L2Snapshot snapshot() const { return published_.load(); }
+    bool trySnapshot(L2Snapshot& out) const { return published_.tryLoad(out); }
+    uint64_t version() const { return published_.version(); }
+
+    // Writer side: feed thread only
+    const std::vector<L2Level>& bids() const { return bids_; }
+    const std::vector<L2Level>& asks() const { return asks_; }
+    bool isStale() const { return stale_; }
+    SequenceNumber lastSequence() const { return last_sequence_; }
+    uint64_t gapCount() const { return gaps_; }
+
+private:
+    void applyLevel(const BookUpdate& update);
+    void publish();
+
+    // Best first: bids descending, asks ascending
+    std::vector<L2Level> bids_;
+    std::vector<L2Level> asks_;
+    size_t published_levels_;
+    SequenceNumber last_sequence_ = 0;
+    bool stale_ = true;
+    uint64_t gaps_ = 0;
+    SeqLock<L2Snapshot> published_;
+};
+
+}
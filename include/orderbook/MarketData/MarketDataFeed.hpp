@@ -9,6 +9,9 @@
 #include <memory>
 #include <mutex>
 #include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <boost/lockfree/spsc_queue.hpp>
 
 namespace orderbook {
 
@@ -47,13 +50,49 @@ public:
     virtual void onDepth(const MarketDepth& depth, SequenceNumber sequence) = 0;
 };
 
+/**
+ * @brief Subscriber that republishes every event into another publisher
+ * Subscribed to an async MarketDataPublisher, the target's work (a multicast feed's
+ * lock and sendto, say) runs on the publisher thread instead of the matching thread.
+ */
+class ForwardingSubscriber : public IMarketDataSubscriber {
+public:
+    explicit ForwardingSubscriber(MarketDataPublisherPtr target) : target_(std::move(target)) {}
+
+    void onTrade(const Trade& trade, SequenceNumber) override { target_->publishTrade(trade); }
+    void onBookUpdate(const BookUpdate& update) override { target_->publishBookUpdate(update); }
+    void onBestPrices(const BestPrices& prices, SequenceNumber) override { target_->publishBestPrices(prices); }
+    void onDepth(const MarketDepth& depth, SequenceNumber) override { target_->publishDepth(depth); }
+
+private:
+    MarketDataPublisherPtr target_;
+};
+
+/**
+ * @brief Construction-time settings for MarketDataPublisher
+ */
+struct MarketDataPublisherOptions {
+    // Journal events into per-thread SPSC rings and publish them from a background
+    // thread, so callers never format or wait on subscribers; false publishes inline
+    bool async = false;
+    size_t journal_capacity = 16384;  // events per producer thread
+    uint32_t idle_sleep_us = 50;      // publisher sleep when every journal is empty
+};
+
 /**
  * @brief Concrete implementation of market data publishing with subscriber management
+ * In async mode each publishing thread (one per matching thread) gets its own journal;
+ * a full journal drops the event and the publisher skips its sequence number so
+ * subscribers see the gap.
  */
 class MarketDataPublisher : public IMarketDataPublisher {
 public:
-    explicit MarketDataPublisher(LoggerPtr logger = nullptr);
-    ~MarketDataPublisher() = default;
+    explicit MarketDataPublisher(LoggerPtr logger = nullptr,
+                                 MarketDataPublisherOptions options = MarketDataPublisherOptions());
+    ~MarketDataPublisher();
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
     
     // IMarketDataPublisher interface implementation
     void publishTrade(const Trade& trade) override;
@@ -80,6 +119,9 @@ public:
         uint64_t total_latency_ns = 0;
         uint64_t max_latency_ns = 0;
         uint64_t min_latency_ns = UINT64_MAX;
+        // Async mode: events dropped on a full journal and gaps seen by the publisher
+        uint64_t journal_drops = 0;
+        uint64_t sequence_gaps = 0;
     };
     
     PublishingStats getStats() const;
@@ -89,7 +131,49 @@ public:
     void setDisabled(bool disabled);
     bool isDisabled() const;
 
+    /**
+     * @brief Wait until everything journaled before the call has been published
+     * Returns immediately in synchronous mode.
+     */
+    void flush();
+    bool isAsync() const { return async_.load(std::memory_order_acquire); }
+
 private:
+    static constexpr size_t MaxDepthLevels = 5;
+
+    // Fixed-size journal entry; the payload is selected by type
+    struct MarketEvent {
+        enum class Type : uint8_t { Trade, BookUpdate, BestPrices, Depth };
+        struct DepthLevels {
+            MarketDepth::Level bids[MaxDepthLevels];
+            MarketDepth::Level asks[MaxDepthLevels];
+            uint8_t bid_count;
+            uint8_t ask_count;
+            Timestamp timestamp;
+        };
+
+        Type type;
+        uint64_t journal_sequence;
+        union {
+            Trade trade;
+            BookUpdate update;
+            BestPrices prices;
+            DepthLevels depth;
+        };
+
+        MarketEvent() : type(Type::Trade), journal_sequence(0), trade() {}
+    };
+
+    // One producer thread's ring; next_sequence is producer-owned, expected_sequence publisher-owned
+    struct Journal {
+        explicit Journal(size_t capacity) : ring(capacity) {}
+        boost::lockfree::spsc_queue<MarketEvent> ring;
+        uint64_t next_sequence = 0;
+        uint64_t expected_sequence = 0;
+    };
+
+    MarketDataPublisherOptions options_;
+
     // Subscriber management
     std::vector<std::function<void(const std::string&)>> string_subscribers_;
     std::vector<std::weak_ptr<IMarketDataSubscriber>> typed_subscribers_;
@@ -102,10 +186,39 @@ private:
     mutable std::mutex stats_mutex_;
     PublishingStats stats_;
     std::atomic<bool> disabled_{false};
+
+    // Async state
+    std::atomic<bool> async_{false};
+    const uint64_t instance_id_;
+    std::mutex journals_mutex_;
+    std::vector<std::unique_ptr<Journal>> journals_;
+    std::unordered_map<std::thread::id, Journal*> journal_by_thread_;
+    std::vector<Journal*> publisher_journals_;
+    std::thread publisher_;
+    std::atomic<bool> stop_publisher_{false};
+    std::atomic<uint64_t> idle_passes_{0};
+    std::atomic<uint64_t> journal_drops_{0};
     
     // Logging
     LoggerPtr logger_;
     
+    // Journal side (calling thread)
+    Journal* threadJournal();
+    void journal(MarketEvent& event);
+
+    // Publisher thread
+    void startPublisher();
+    void stopPublisher();
+    void publisherLoop();
+    size_t drainJournals();
+    void deliver(const MarketEvent& event);
+
+    // Formatting and subscriber fan-out, run inline or on the publisher thread
+    void deliverTrade(const Trade& trade);
+    void deliverBookUpdate(const BookUpdate& update);
+    void deliverBestPrices(const BestPrices& prices);
+    void deliverDepth(const MarketDepth& depth);
+
     // Helper methods for message formatting
     std::string formatTradeMessage(const Trade& trade, SequenceNumber seq) const;
     std::string formatBookUpdateMessage(const BookUpdate& update) const;
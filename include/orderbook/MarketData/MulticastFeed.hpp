@@ -0,0 +1,183 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Core/Interfaces.hpp"
+#include "ShmMarketData.hpp"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Where and how MulticastFeedPublisher sends its feed
+ */
+struct MulticastFeedOptions {
+    std::string group = "239.192.0.1";
+    uint16_t port = 30001;
+    // Local interface address for outbound multicast (0.0.0.0 = routing table default)
+    std::string interface_address = "0.0.0.0";
+    int ttl = 1;
+    bool loopback = true;
+    // UDP payload budget per packet; messages are batched up to it
+    size_t packet_bytes = 1400;
+    // A partly filled packet goes out at most this long after its first message
+    uint32_t flush_interval_us = 100;
+    // TCP port of the snapshot channel (0 = off)
+    uint16_t snapshot_port = 0;
+    // Symbol stamped on book-update and best-price messages
+    SymbolId symbol_id = 0;
+};
+
+/**
+ * @brief Feed packet header (MoldUDP64-style, little-endian)
+ * count messages of message_bytes each follow; they carry sequences sequence,
+ * sequence + 1, ... A receiver that sees a sequence past the one it expected has
+ * lost packets and recovers through the snapshot channel.
+ */
+struct FeedPacketHeader {
+    uint64_t session;          // Publisher start time; changes when the feed restarts
+    uint64_t sequence;         // Sequence of the first message
+    uint16_t count;
+    uint16_t message_bytes;
+    uint32_t reserved;
+};
+static_assert(sizeof(FeedPacketHeader) == 24, "feed packet header layout");
+
+// Feed messages are the shared-memory ring's fixed records
+using FeedMessage = ShmMarketDataRecord;
+
+/**
+ * @brief Snapshot channel reply header; bid_count then ask_count FeedSnapshotLevels follow
+ * Incremental messages with a sequence above `sequence` apply on top of it.
+ */
+struct FeedSnapshotHeader {
+    uint64_t session;
+    uint64_t sequence;         // Last feed message reflected in the levels
+    uint64_t timestamp;
+    uint32_t symbol_id;
+    uint16_t bid_count;
+    uint16_t ask_count;
+};
+static_assert(sizeof(FeedSnapshotHeader) == 32, "feed snapshot header layout");
+
+struct FeedSnapshotLevel {
+    int64_t price;
+    uint64_t quantity;
+    uint64_t order_count;
+};
+static_assert(sizeof(FeedSnapshotLevel) == 24, "feed snapshot level layout");
+
+/**
+ * @brief A decoded snapshot channel reply
+ */
+struct FeedSnapshot {
+    FeedSnapshotHeader header{};
+    MarketDepth depth;
+};
+
+/**
+ * @brief Publisher that sends trades, book updates and best prices as a binary
+ * incremental feed over UDP multicast
+ *
+ * Messages are sequenced and packed into packets of up to packet_bytes; a packet
+ * goes out when the next message would not fit, or flush_interval_us after its first
+ * message (a background flusher, like the journal's group commit). Cost per event
+ * is one memcpy and does not grow with the number of listeners. The feed keeps
+ * every level its book updates describe, updated under the same lock that assigns
+ * their sequences, so the snapshot channel answers each TCP connection with the
+ * whole book as of exactly the last sequence sent, then closes. Every event is also
+ * forwarded to `next`.
+ */
+class MulticastFeedPublisher : public IMarketDataPublisher {
+public:
+    static Result<std::unique_ptr<MulticastFeedPublisher>> create(const MulticastFeedOptions& options,
+                                                                  MarketDataPublisherPtr next = nullptr);
+    ~MulticastFeedPublisher();
+
+    MulticastFeedPublisher(const MulticastFeedPublisher&) = delete;
+    MulticastFeedPublisher& operator=(const MulticastFeedPublisher&) = delete;
+
+    // IMarketDataPublisher interface implementation
+    void publishTrade(const Trade& trade) override;
+    void publishBookUpdate(const BookUpdate& update) override;
+    void publishBestPrices(const BestPrices& prices) override;
+    void publishDepth(const MarketDepth& depth) override;
+    void subscribe(std::function<void(const std::string&)> callback) override;
+
+    /**
+     * @brief Send the partly filled packet now
+     */
+    void flush();
+
+    uint64_t session() const { return session_; }
+    // Last message sequence assigned
+    uint64_t lastSequence() const;
+    uint64_t packetsSent() const { return packets_sent_.load(std::memory_order_relaxed); }
+    uint64_t sendErrors() const { return send_errors_.load(std::memory_order_relaxed); }
+    // Snapshot channel port, 0 if off
+    uint16_t snapshotPort() const { return snapshot_port_; }
+
+    /**
+     * @brief Every level of the book and the feed sequence it reflects (what the
+     * snapshot channel sends)
+     */
+    FeedSnapshot snapshot() const;
+
+private:
+    MulticastFeedPublisher(MulticastFeedOptions options, MarketDataPublisherPtr next);
+
+    // Caller holds mutex_
+    void appendLocked(const FeedMessage& message);
+    void applyLevelLocked(const BookUpdate& update);
+    void sendPacketLocked();
+    void flushLoop();
+    void acceptSnapshot();
+    std::vector<unsigned char> encodeSnapshot();
+
+    MulticastFeedOptions options_;
+    MarketDataPublisherPtr next_;
+    uint64_t session_;
+    size_t max_messages_;
+
+    boost::asio::io_context io_;
+    boost::asio::ip::udp::socket socket_;
+    boost::asio::ip::udp::endpoint group_endpoint_;
+    boost::asio::ip::tcp::acceptor snapshot_acceptor_;
+    uint16_t snapshot_port_ = 0;
+    std::thread io_thread_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable flush_cv_;
+    bool stopping_ = false;
+    std::vector<unsigned char> packet_;
+    size_t packet_messages_ = 0;
+    uint64_t sequence_ = 0;
+    // Full book as of sequence_, best first, for the snapshot channel
+    std::vector<MarketDepth::Level> bid_levels_;
+    std::vector<MarketDepth::Level> ask_levels_;
+    Timestamp levels_timestamp_ = 0;
+    std::thread flusher_;
+
+    std::atomic<uint64_t> packets_sent_{0};
+    std::atomic<uint64_t> send_errors_{0};
+};
+
+/**
+ * @brief Decode one feed datagram into its header and messages
+ * @return false if the datagram is not a well-formed feed packet
+ */
+bool parseFeedPacket(const void* data, size_t length, FeedPacketHeader& header,
+                     std::vector<FeedMessage>& messages);
+
+/**
+ * @brief Fetch a snapshot from a MulticastFeedPublisher's snapshot channel (blocking)
+ */
+Result<FeedSnapshot> fetchFeedSnapshot(const std::string& host, uint16_t port);
+
+}
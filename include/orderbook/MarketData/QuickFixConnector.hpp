@@ -1,6 +1,9 @@
 #pragma once
 #include "orderbook/MarketData/IMarketDataConnector.hpp"
 #include "orderbook/Core/Interfaces.hpp"
+#include "orderbook/Core/MarketData.hpp"
+#include "orderbook/Core/SymbolMaster.hpp"
+#include "orderbook/MarketData/L2Book.hpp"
 #include "orderbook/Utilities/Logger.hpp"
 #include "orderbook/Utilities/Config.hpp"
 
@@ -18,6 +21,9 @@
 #include <quickfix/fix44/SecurityListRequest.h>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace orderbook {
 
@@ -28,7 +34,8 @@ public:
     QuickFixConnector(MarketDataPublisherPtr publisher,
                      std::shared_ptr<Config> cfg,
                      LoggerPtr logger,
-                     class OrderBook* book = nullptr);
+                     class OrderBook* book = nullptr,
+                     SymbolMasterPtr symbol_master = nullptr);
     ~QuickFixConnector();
 
     bool start() override;
@@ -38,6 +45,16 @@ public:
     struct Stats { uint64_t messagesProcessed; uint64_t gapsDetected; };
     Stats getStats() const { return { messages_processed_.load(), gaps_detected_.load() }; }
 
+    /**
+     * @brief L2 mirror of an allow-listed symbol, or nullptr
+     * Mirrors are created up front, so readers may call this from any thread and use
+     * L2Book::snapshot() without locking.
+     */
+    const L2Book* mirror(SymbolId symbol) const {
+        auto it = mirrors_.find(symbol);
+        return it != mirrors_.end() ? it->second.get() : nullptr;
+    }
+
     // FIX::Application callbacks
     void onCreate(const FIX::SessionID& sessionID) override;
     void onLogon(const FIX::SessionID& sessionID) override;
@@ -59,6 +76,7 @@ private:
     std::shared_ptr<Config> config_;
     LoggerPtr logger_;
     class OrderBook* order_book_ = nullptr;
+    PriceScale price_scale_;
     std::unique_ptr<FIX::SocketInitiator> initiator_;
     bool running_ = false;
     std::string session_file_;
@@ -69,6 +87,28 @@ private:
     std::atomic<uint64_t> messages_processed_{0};
     std::atomic<uint64_t> gaps_detected_{0};
     FIX::SessionSettings settings_;
+
+    // Parsed once from [marketdata] symbols / apply_to_book; an empty filter accepts everything
+    std::vector<std::string> symbols_;
+    std::unordered_set<SymbolId> symbol_filter_;
+    bool apply_to_book_ = false;
+    // Feed symbols seen so far, so entries resolve without touching the intern table's lock
+    std::unordered_map<std::string, SymbolId> symbol_ids_;
+    // Reused per incremental message
+    std::vector<BookUpdate> book_batch_;
+    // One aggregated mirror per allow-listed symbol; the map itself never changes after construction
+    std::unordered_map<SymbolId, std::unique_ptr<L2Book>> mirrors_;
+    std::vector<std::pair<L2Book*, BookUpdate>> mirror_batch_;
+
+    L2Book* mirrorFor(SymbolId symbol) {
+        auto it = mirrors_.find(symbol);
+        return it != mirrors_.end() ? it->second.get() : nullptr;
+    }
+    void applyMirrorBatch();
+    void markMirrorsStale();
+
+    SymbolId resolveSymbol(const std::string& symbol);
+    void requestSnapshots(const FIX::SessionID& sessionID);
     void requestSnapshot(const FIX::SessionID& sessionID, const std::string& symbol);
 };
 
@@ -0,0 +1,238 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Core/Interfaces.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace orderbook {
+
+/**
+ * @brief Where and how ShmMarketDataPublisher lays out its ring
+ */
+struct ShmMarketDataOptions {
+    // POSIX shared memory name (shm_open); on Linux the object lives in /dev/shm
+    std::string name = "/orderbook-md";
+    // Ring slots, rounded up to a power of two; a reader this far behind is overrun
+    size_t capacity = 65536;
+    // Symbol stamped on book-update and best-price records (those events carry none)
+    SymbolId symbol_id = 0;
+};
+
+struct ShmTradeBody {
+    uint64_t trade_id;
+    uint64_t buy_order_id;
+    uint64_t sell_order_id;
+    int64_t price;
+    uint64_t quantity;
+};
+
+struct ShmLevelBody {
+    int64_t price;
+    uint64_t quantity;
+    uint64_t order_count;
+    uint64_t book_sequence;   // BookUpdate::sequence
+};
+
+struct ShmBestBody {
+    int64_t bid;
+    uint64_t bid_size;
+    int64_t ask;
+    uint64_t ask_size;
+};
+
+/**
+ * @brief One market-data event as stored in the ring (fixed layout, 56 bytes)
+ * Prices are ticks. symbol_id is the publishing process's SymbolId; readers name it
+ * with ShmMarketDataReader::symbol(). timestamp is a raw TscClock tick, comparable
+ * with TscClock::now() in any process on the same machine.
+ */
+struct ShmMarketDataRecord {
+    enum class Type : uint8_t { Trade = 1, BookUpdate, BestPrices };
+    static constexpr uint8_t HasBid = 1;
+    static constexpr uint8_t HasAsk = 2;
+
+    Type type;
+    uint8_t side;          // BookUpdate: Side of the level
+    uint8_t update_type;   // BookUpdate: BookUpdate::Type
+    uint8_t flags;         // BestPrices: HasBid | HasAsk
+    uint32_t symbol_id;
+    uint64_t timestamp;
+    union {
+        ShmTradeBody trade;
+        ShmLevelBody level;
+        ShmBestBody best;
+    };
+};
+static_assert(sizeof(ShmMarketDataRecord) == 56, "shm record layout");
+
+// Records for each published event; book events carry no symbol, so the caller names it
+ShmMarketDataRecord makeMarketDataRecord(const Trade& trade);
+ShmMarketDataRecord makeMarketDataRecord(const BookUpdate& update, SymbolId symbol_id);
+ShmMarketDataRecord makeMarketDataRecord(const BestPrices& prices, SymbolId symbol_id);
+
+/**
+ * @brief One ring slot: the record's sequence (0 while being written) and its words
+ * Words are atomics so a reader racing a writer reads torn values, never UB, and
+ * then sees the sequence change.
+ */
+struct alignas(64) ShmRingSlot {
+    static constexpr size_t Words = sizeof(ShmMarketDataRecord) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> words[Words];
+};
+static_assert(sizeof(ShmRingSlot) == 64, "one record per cache line");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared atomics must be address-free");
+
+/**
+ * @brief Symbol name for records carrying a SymbolId below ShmRingHeader::SymbolCapacity
+ */
+struct ShmSymbolEntry {
+    std::atomic<uint32_t> state;   // 0 unnamed, 1 being written, 2 named
+    char name[28];
+};
+
+/**
+ * @brief Start of the shared memory object; the slots follow it
+ */
+struct ShmRingHeader {
+    static constexpr char Magic[8] = {'O', 'B', 'S', 'H', 'M', 'M', 'D', '\1'};
+    static constexpr uint32_t FormatVersion = 1;
+    static constexpr size_t SymbolCapacity = 1024;
+
+    char magic[8];
+    // Stored last by the publisher; readers refuse the ring until it matches
+    std::atomic<uint32_t> version;
+    uint32_t slot_bytes;
+    uint64_t capacity;
+    // Last sequence handed to a writer (sequences start at 1)
+    alignas(64) std::atomic<uint64_t> claimed;
+    alignas(64) ShmSymbolEntry symbols[SymbolCapacity];
+};
+
+/**
+ * @brief Publisher that broadcasts trades, book updates and best prices through a
+ * shared memory ring for readers in other processes on the same machine
+ *
+ * Each event is one 64-byte slot written with a per-slot sequence lock: writers
+ * claim a sequence with one fetch_add, so every book's consumer thread may publish
+ * concurrently, and never wait for readers. Depth snapshots are not ringed (readers
+ * rebuild depth from BookUpdate records). Every event is also forwarded to `next`,
+ * so the in-process publisher and its subscribers keep working alongside the ring.
+ * The ring is created fresh (any old object of the same name is unlinked) and
+ * unlinked again on destruction; readers reopen after a publisher restart.
+ */
+class ShmMarketDataPublisher : public IMarketDataPublisher {
+public:
+    static Result<std::unique_ptr<ShmMarketDataPublisher>> create(const ShmMarketDataOptions& options,
+                                                                  MarketDataPublisherPtr next = nullptr);
+    ~ShmMarketDataPublisher();
+
+    ShmMarketDataPublisher(const ShmMarketDataPublisher&) = delete;
+    ShmMarketDataPublisher& operator=(const ShmMarketDataPublisher&) = delete;
+
+    // IMarketDataPublisher interface implementation
+    void publishTrade(const Trade& trade) override;
+    void publishBookUpdate(const BookUpdate& update) override;
+    void publishBestPrices(const BestPrices& prices) override;
+    void publishDepth(const MarketDepth& depth) override;
+    void subscribe(std::function<void(const std::string&)> callback) override;
+
+    const std::string& name() const { return options_.name; }
+    size_t capacity() const { return mask_ + 1; }
+    // Records written so far
+    uint64_t published() const { return header_->claimed.load(std::memory_order_relaxed); }
+
+private:
+    ShmMarketDataPublisher(ShmMarketDataOptions options, MarketDataPublisherPtr next)
+        : options_(std::move(options)), next_(std::move(next)) {}
+
+    void write(const ShmMarketDataRecord& record);
+    // Publish a symbol's name the first time a record carries it
+    void nameSymbol(SymbolId symbol_id);
+
+    ShmMarketDataOptions options_;
+    MarketDataPublisherPtr next_;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    ShmRingHeader* header_ = nullptr;
+    ShmRingSlot* slots_ = nullptr;
+    size_t mask_ = 0;
+};
+
+/**
+ * @brief Read side of a ShmMarketDataPublisher ring, for any process on the machine
+ *
+ * A reader maps the ring read-only and keeps its own cursor, so any number of them
+ * consume the same records with no syscalls, locks or writes to shared memory. It
+ * starts at the live edge. When the publisher laps it, poll() reports Overrun once,
+ * counts the lost records and resumes at the live edge again; the caller resyncs
+ * any state it built from the stream.
+ */
+class ShmMarketDataReader {
+public:
+    enum class Status { Record, Empty, Overrun };
+
+    static Result<std::unique_ptr<ShmMarketDataReader>> open(const std::string& name);
+    ~ShmMarketDataReader();
+
+    ShmMarketDataReader(const ShmMarketDataReader&) = delete;
+    ShmMarketDataReader& operator=(const ShmMarketDataReader&) = delete;
+
+    /**
+     * @brief Copy out the next record, if the publisher has finished writing it
+     */
+    Status poll(ShmMarketDataRecord& record) {
+        const ShmRingSlot& slot = slots_[next_ & mask_];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != next_) {
+            // Behind a slot still holding an older record (or being rewritten), the
+            // record is either not written yet or already lost
+            if (sequence > next_ || header_->claimed.load(std::memory_order_acquire) >= next_ + capacity()) {
+                return overrun();
+            }
+            return Status::Empty;
+        }
+
+        uint64_t words[ShmRingSlot::Words];
+        for (size_t i = 0; i < ShmRingSlot::Words; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != next_) {
+            return overrun();
+        }
+        std::memcpy(&record, words, sizeof(record));
+        ++next_;
+        return Status::Record;
+    }
+
+    /**
+     * @brief Name of a symbol_id carried by a record (empty if not published)
+     */
+    std::string symbol(uint32_t symbol_id) const;
+
+    // Sequence of the next record poll() returns
+    uint64_t nextSequence() const { return next_; }
+    // Records skipped by overruns
+    uint64_t lost() const { return lost_; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    ShmMarketDataReader() = default;
+
+    Status overrun();
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    const ShmRingHeader* header_ = nullptr;
+    const ShmRingSlot* slots_ = nullptr;
+    size_t mask_ = 0;
+    uint64_t next_ = 1;
+    uint64_t lost_ = 0;
+};
+
+}
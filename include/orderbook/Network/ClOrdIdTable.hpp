@@ -0,0 +1,143 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "../Utilities/FlatHashMap.hpp"
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief ClOrdID(11) stored inline in a fixed 32-byte key (up to 31 characters)
+ */
+struct ClOrdIdKey {
+    static constexpr size_t MaxLength = 31;
+
+    uint8_t length = 0;
+    char data[MaxLength] = {};
+
+    static std::optional<ClOrdIdKey> from(std::string_view id) {
+        if (id.empty() || id.size() > MaxLength) return std::nullopt;
+        ClOrdIdKey key;
+        key.length = static_cast<uint8_t>(id.size());
+        std::memcpy(key.data, id.data(), id.size());
+        return key;
+    }
+
+    bool empty() const { return length == 0; }
+    std::string_view view() const { return std::string_view(data, length); }
+    bool operator==(const ClOrdIdKey& other) const {
+        return length == other.length && std::memcmp(data, other.data, length) == 0;
+    }
+};
+static_assert(sizeof(ClOrdIdKey) == 32, "ClOrdIdKey is half a cache line");
+
+struct ClOrdIdKeyHash {
+    size_t operator()(const ClOrdIdKey& key) const {
+        // FNV-1a over the characters, finished with the shared 64-bit mixer
+        uint64_t h = 14695981039346656037ULL;
+        for (uint8_t i = 0; i < key.length; ++i) {
+            h = (h ^ static_cast<unsigned char>(key.data[i])) * 1099511628211ULL;
+        }
+        return static_cast<size_t>(mixHash64(h));
+    }
+};
+
+/**
+ * @brief One FIX session's ClOrdID <-> OrderId tables
+ *
+ * Internal OrderIds are the session index in the top bits and a per-session sequence
+ * below, so IDs are unique across sessions without a shared counter and the reverse
+ * lookup (every execution report) is an index into a window of live sequences rather
+ * than a string hash. The forward map keys on inline ClOrdIdKeys in a flat hash map.
+ * The window is capped at MaxWindow sequences: orders still live when it moves past
+ * them are kept in a small straggler map, so one resting order cannot pin every later
+ * slot. Not thread-safe: owned by one session's handler, whose order entry is serialized.
+ */
+class ClOrdIdTable {
+public:
+    static constexpr unsigned SequenceBits = 40;
+    static constexpr uint64_t SequenceMask = (uint64_t(1) << SequenceBits) - 1;
+    // Sequences the reverse-lookup window spans at most
+    static constexpr size_t MaxWindow = size_t(1) << 16;
+
+    explicit ClOrdIdTable(uint32_t session, size_t expected_orders = 1024)
+        : session_(session), forward_(expected_orders) {}
+
+    uint32_t session() const { return session_; }
+
+    /**
+     * @brief Internal ID for the session's next order (not yet bound to a ClOrdID)
+     */
+    OrderId allocate() { return OrderId((uint64_t(session_) << SequenceBits) | ++sequence_); }
+
+    /**
+     * @brief Map a ClOrdID to an allocated OrderId
+     * @return false if the ClOrdID is empty, too long, or already live on this session
+     */
+    bool bind(std::string_view clOrdId, OrderId id);
+
+    /**
+     * @brief Move an order to a new ClOrdID (cancel/replace, cancel confirmation)
+     */
+    bool rebind(OrderId id, std::string_view clOrdId);
+
+    /**
+     * @brief Forget an order's ClOrdID
+     */
+    void unbind(OrderId id);
+
+    std::optional<OrderId> find(std::string_view clOrdId) const;
+
+    /**
+     * @brief ClOrdID of one of this session's orders, or nullptr if unbound or foreign
+     */
+    const ClOrdIdKey* clOrdIdFor(OrderId id) const {
+        size_t i = indexOf(id);
+        if (i != NoIndex) return !by_sequence_[i].empty() ? &by_sequence_[i] : nullptr;
+        if (stragglers_.empty()) return nullptr;
+        auto it = stragglers_.find(id);
+        return it != stragglers_.end() ? &it->second : nullptr;
+    }
+
+    /**
+     * @brief Every order still bound on this session, oldest first
+     */
+    std::vector<OrderId> liveOrders() const;
+
+    size_t size() const { return forward_.size(); }
+    // Sequences held in the window, and live orders moved out of it
+    size_t windowSize() const { return by_sequence_.size(); }
+    size_t stragglerCount() const { return stragglers_.size(); }
+    void clear();
+
+private:
+    static constexpr size_t NoIndex = static_cast<size_t>(-1);
+    // Position of an order's sequence in the window, or NoIndex
+    size_t indexOf(OrderId id) const {
+        if ((id.value >> SequenceBits) != session_) return NoIndex;
+        uint64_t sequence = id.value & SequenceMask;
+        if (sequence < base_ || sequence - base_ >= by_sequence_.size()) return NoIndex;
+        return static_cast<size_t>(sequence - base_);
+    }
+    // Drop unbound sequences from the front of the window
+    void trim();
+    // Slide the window so sequence fits, moving live orders it passes to stragglers_
+    void makeRoom(uint64_t sequence);
+    // ClOrdID slot of a bound order in the window or the stragglers, or nullptr
+    ClOrdIdKey* entryFor(OrderId id);
+
+    uint32_t session_;
+    uint64_t sequence_ = 0;
+    FlatHashMap<ClOrdIdKey, OrderId, ClOrdIdKeyHash> forward_;
+    // ClOrdID per sequence from base_ on; the window starts at the oldest bound order
+    std::deque<ClOrdIdKey> by_sequence_;
+    uint64_t base_ = 1;
+    // Live orders older than base_
+    FlatHashMap<OrderId, ClOrdIdKey, OrderIdHash> stragglers_;
+};
+
+}
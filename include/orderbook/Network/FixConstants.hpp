@@ -38,6 +38,7 @@ namespace orderbook::fix {
     constexpr int TAG_EXEC_TYPE = 150;
     constexpr int TAG_LEAVES_QTY = 151;
     constexpr int TAG_CUM_QTY = 14;
+    constexpr int TAG_ACCOUNT = 1;
     constexpr int TAG_AVG_PX = 6;
     constexpr int TAG_LAST_QTY = 32;
     constexpr int TAG_LAST_PX = 31;
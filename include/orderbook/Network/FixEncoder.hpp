@@ -0,0 +1,52 @@
+#pragma once
+#include "../Core/Types.hpp"
+#include "FixParser.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace orderbook {
+
+/**
+ * @brief Allocation-free encoder for outbound session messages
+ *
+ * The session part of the header (SenderCompID, TargetCompID) is rendered once with
+ * its checksum contribution; each message writes only its variable fields with
+ * to_chars straight into the caller's reusable buffer. SendingTime/TransactTime text
+ * is cached per thread and re-rendered only when the millisecond changes. BodyLength
+ * is patched in front of the body once its size is known.
+ */
+class FixEncoder {
+public:
+    FixEncoder() = default;
+    FixEncoder(std::string_view senderCompId, std::string_view targetCompId);
+
+    void setSessionIds(std::string_view senderCompId, std::string_view targetCompId);
+
+    /**
+     * @brief Encode an Execution Report (35=8) into out, replacing its contents
+     * out keeps its capacity, so a per-session buffer stops allocating after warm-up.
+     * @return false (out untouched) if the fields do not fit in MaxBodySize
+     */
+    bool encodeExecutionReport(std::string& out, const FixMessageParser::ExecutionReport& report,
+                               SequenceNumber msgSeqNum) const;
+
+    /**
+     * @brief FIX UTCTimestamp (YYYYMMDD-HH:MM:SS.sss) of a time point
+     * @return View of a thread-local cache, valid until the next call on this thread
+     */
+    static std::string_view timestamp(std::chrono::system_clock::time_point time);
+
+private:
+    // Room for "8=FIX.4.4<SOH>9=" plus the longest BodyLength we ever write
+    static constexpr size_t PrefixReserve = 32;
+    static constexpr size_t MaxBodySize = 2048;
+
+    size_t beginMessage(char* buffer, char msgType, SequenceNumber msgSeqNum) const;
+    void finishMessage(char* buffer, size_t body_end, std::string& out) const;
+
+    std::string session_header_;  // 49=...<SOH>56=...<SOH>
+};
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Splits a FIX byte stream into whole messages
+ *
+ * Socket reads land directly in one flat receive buffer (prepare()/commit()); next()
+ * frames complete messages from BeginString(8), BodyLength(9) and the CheckSum(10)
+ * trailer and returns views into that buffer. Consumed bytes are reclaimed lazily by
+ * moving only the trailing partial message to the front, so a read that delivers
+ * many messages costs one completion and no per-message copies.
+ */
+class FixFramer {
+public:
+    enum class Status { Message, Incomplete, Malformed };
+
+    static constexpr size_t DefaultCapacity = 64 * 1024;
+    static constexpr size_t MaxMessageSize = 1024 * 1024;
+
+    explicit FixFramer(size_t capacity = DefaultCapacity);
+
+    /**
+     * @brief Writable space of at least min_bytes at the tail of the buffer
+     */
+    std::pair<char*, size_t> prepare(size_t min_bytes);
+
+    /**
+     * @brief Mark bytes written into prepare()'s space as received
+     */
+    void commit(size_t bytes) { end_ += bytes; }
+
+    /**
+     * @brief Frame the next message
+     * The view stays valid until the next prepare(). On Malformed, error describes the
+     * problem and the bytes up to the next BeginString have been discarded.
+     */
+    Status next(std::string_view& message, std::string& error);
+
+    size_t buffered() const { return end_ - begin_; }
+    size_t capacity() const { return buffer_.size(); }
+    void clear() { begin_ = end_ = 0; }
+
+private:
+    // Drop bytes up to the next "8=FIX", keeping a tail that could still become one
+    void resync();
+
+    std::vector<char> buffer_;
+    size_t begin_ = 0;  // first unconsumed byte
+    size_t end_ = 0;    // one past the last received byte
+};
+
+}
@@ -5,19 +5,21 @@
 #include "../Risk/RiskManager.hpp"
 #include "FixParser.hpp"
 #include "FixSession.hpp"
+#include "ClOrdIdTable.hpp"
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <functional>
-#include <mutex>
 #include <optional>
+#include <vector>
 
 namespace orderbook {
 
 /**
  * @brief FIX Message Handler
  * Bridges FIX protocol messages with the order management system
- * Handles order lifecycle management and execution reporting
+ * Handles order lifecycle management and execution reporting. One handler per
+ * session; its calls must be serialized (FixServer runs order entry on one strand),
+ * so its ClOrdID tables need no lock.
  */
 class FixMessageHandler {
 public:
@@ -25,9 +27,21 @@ public:
      * @brief Constructor
      * @param orderManager Order management system
      * @param riskManager Risk management system
+     * @param priceScale Instrument tick size for wire price conversion
      */
     FixMessageHandler(std::shared_ptr<OrderManager> orderManager,
-                     std::shared_ptr<RiskManager> riskManager);
+                     std::shared_ptr<RiskManager> riskManager,
+                     PriceScale priceScale = PriceScale());
+
+    /**
+     * @brief Process-unique session index carried in the top bits of this session's OrderIds
+     */
+    uint32_t sessionIndex() const { return clOrdIds_.session(); }
+
+    /**
+     * @brief ClOrdIDs still bound to live orders on this session
+     */
+    size_t liveClOrdIdCount() const { return clOrdIds_.size(); }
     
     /**
      * @brief Set the FIX session for sending responses
@@ -65,6 +79,14 @@ public:
      */
     void handleOrderStatusChange(const Order& order);
 
+    /**
+     * @brief Cancel-on-disconnect: one batched cancel of the orders this session entered
+     * Orders keep the client's Account(1) for risk and positions; ownership is the
+     * session's ClOrdID table, so a reconnect never resets an account's exposure.
+     * @return Number of orders cancelled
+     */
+    size_t cancelSessionOrders();
+
 private:
     /**
      * @brief Generate unique execution ID
@@ -85,12 +107,13 @@ private:
      * @param execType Execution type
      * @param lastQty Last quantity filled (0 for non-fill reports)
      * @param lastPx Last price filled (0 for non-fill reports)
+     * @param transactTime Event stamp for TransactTime (0 = now)
      */
     void sendExecutionReport(const Order& order, char execType, 
-                           Quantity lastQty = 0, Price lastPx = 0.0);
+                           Quantity lastQty = 0, Price lastPx = 0, Timestamp transactTime = 0);
     // Overload: use explicit client ClOrdID (for acks before mapping)
     void sendExecutionReport(const Order& order, const std::string& clOrdId, char execType, 
-                           Quantity lastQty = 0, Price lastPx = 0.0);
+                           Quantity lastQty = 0, Price lastPx = 0);
     
     /**
      * @brief Send execution report for trade
@@ -98,6 +121,11 @@ private:
      * @param order Order that was filled
      */
     void sendTradeExecutionReport(const Trade& trade, const Order& order);
+
+    /**
+     * @brief Unbind the ClOrdID of an order whose report was its last
+     */
+    void retireIfTerminal(const Order& order);
     
     /**
      * @brief Send rejection execution report
@@ -128,18 +156,10 @@ private:
     std::shared_ptr<OrderManager> orderManager_;
     std::shared_ptr<RiskManager> riskManager_;
     std::shared_ptr<FixSession> fixSession_;
+    PriceScale priceScale_;
     
-    // Order tracking
-    std::unordered_map<std::string, OrderId> clOrdIdToOrderId_;  // Client Order ID -> Internal Order ID
-    std::unordered_map<OrderId, std::string, OrderIdHash> orderIdToClOrdId_;  // Internal Order ID -> Client Order ID
-    std::mutex mapping_mutex_;
-
-    // Map helpers
-    void addClOrdIdMapping(const std::string& clOrdId, OrderId orderId);
-    void removeClOrdIdMapping(const std::string& clOrdId);
-    void removeOrderIdMapping(OrderId orderId);
-    std::optional<OrderId> getOrderIdForClOrdId(const std::string& clOrdId);
-    std::optional<std::string> getClOrdIdForOrderId(OrderId orderId);
+    // Order tracking: ClOrdID <-> internal OrderId (session index + sequence)
+    ClOrdIdTable clOrdIds_;
     
     // Execution ID generation
     std::atomic<uint64_t> executionIdCounter_{1};
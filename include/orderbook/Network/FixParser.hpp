@@ -2,9 +2,12 @@
 #include "../Core/Order.hpp"
 #include "../Core/Types.hpp"
 #include "FixConstants.hpp"
+#include <array>
+#include <charconv>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 #include <optional>
 #include <chrono>
 
@@ -16,26 +19,93 @@ namespace orderbook {
  */
 class FixMessageParser {
 public:
+    /**
+     * @brief One tag=value pair, located by offset into the raw message
+     */
+    struct FixField {
+        int tag = 0;
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
     /**
      * @brief Represents a parsed FIX message
+     *
+     * A view over the buffer given to parseMessage(), which must outlive it: fields are
+     * (tag, offset, length) entries in a fixed table, and tags up to MaxIndexedTag
+     * (every tag in FixConstants.hpp) resolve through a direct lookup table. Parsing
+     * allocates only when it has to report an error.
      */
     struct FixMessage {
-        char msgType;
-        std::unordered_map<int, std::string> fields;
-        std::string rawMessage;
+        static constexpr size_t MaxFields = 64;
+        static constexpr int MaxIndexedTag = 255;
+
+        char msgType = 0;
+        std::string_view rawMessage;
+        std::array<FixField, MaxFields> fieldTable;
+        size_t fieldCount = 0;
         bool isValid = false;
         std::string errorMessage;
         
-        FixMessage() = default;
-        explicit FixMessage(const std::string& raw) : rawMessage(raw) {}
+        FixMessage() { tagIndex.fill(0); }
+        explicit FixMessage(std::string_view raw) : rawMessage(raw) { tagIndex.fill(0); }
         
+        /**
+         * @brief Value of a tag as a view into the raw message (empty if absent)
+         */
+        std::string_view field(int tag) const {
+            const FixField* f = find(tag);
+            return f ? rawMessage.substr(f->offset, f->length) : std::string_view();
+        }
+
         std::string getField(int tag) const {
-            auto it = fields.find(tag);
-            return it != fields.end() ? it->second : "";
+            return std::string(field(tag));
         }
         
         bool hasField(int tag) const {
-            return fields.find(tag) != fields.end();
+            return find(tag) != nullptr;
+        }
+
+        /**
+         * @brief Parse a numeric tag in place with from_chars
+         * @return false if the tag is absent or not entirely a number
+         */
+        template<typename T>
+        bool getNumber(int tag, T& value) const {
+            std::string_view text = field(tag);
+            if (text.empty()) return false;
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            return ec == std::errc() && end == text.data() + text.size();
+        }
+
+        /**
+         * @brief Record a field; a repeated tag replaces the earlier value
+         * @return false when the field table is full
+         */
+        bool addField(int tag, uint32_t offset, uint32_t length) {
+            if (tag >= 0 && tag <= MaxIndexedTag && tagIndex[tag] != 0) {
+                fieldTable[tagIndex[tag] - 1] = FixField{tag, offset, length};
+                return true;
+            }
+            if (fieldCount == MaxFields) return false;
+            fieldTable[fieldCount++] = FixField{tag, offset, length};
+            if (tag >= 0 && tag <= MaxIndexedTag) tagIndex[tag] = static_cast<uint8_t>(fieldCount);
+            return true;
+        }
+
+    private:
+        // 1-based slot in fieldTable per low tag, 0 when absent
+        std::array<uint8_t, MaxIndexedTag + 1> tagIndex;
+
+        const FixField* find(int tag) const {
+            if (tag >= 0 && tag <= MaxIndexedTag) {
+                return tagIndex[tag] ? &fieldTable[tagIndex[tag] - 1] : nullptr;
+            }
+            // Rare high tags: scan backwards so the last occurrence wins
+            for (size_t i = fieldCount; i-- > 0;) {
+                if (fieldTable[i].tag == tag) return &fieldTable[i];
+            }
+            return nullptr;
         }
     };
     
@@ -48,10 +118,12 @@ public:
         Side side;
         OrderType orderType;
         TimeInForce timeInForce;
-        Price price;
+        double price = 0.0;  // decimal wire price; converted to ticks by the handler
         Quantity quantity;
         std::string account;
         std::chrono::system_clock::time_point transactTime;
+        // Set by the session when this order is latency-sampled
+        TraceStamps trace;
         
         bool isValid = false;
         std::string errorMessage;
@@ -67,7 +139,7 @@ public:
         Side side;
         OrderType orderType;
         TimeInForce timeInForce;
-        Price price;
+        double price = 0.0;  // decimal wire price; converted to ticks by the handler
         Quantity quantity;
         std::string account;
         std::chrono::system_clock::time_point transactTime;
@@ -102,12 +174,12 @@ public:
         std::string symbol;
         Side side;
         Quantity orderQty;
-        Price price;
+        double price;
         Quantity lastQty = 0;
-        Price lastPx = 0.0;
+        double lastPx = 0.0;
         Quantity leavesQty;
         Quantity cumQty;
-        Price avgPx;
+        double avgPx;
         std::chrono::system_clock::time_point transactTime;
         
         ExecutionReport() = default;
@@ -117,11 +189,11 @@ public:
     FixMessageParser() = default;
     
     /**
-     * @brief Parse a raw FIX message
-     * @param rawMessage Raw FIX message string
+     * @brief Parse a raw FIX message in one pass, without copying it
+     * @param rawMessage Raw FIX message; the result refers into it
      * @return Parsed FixMessage
      */
-    FixMessage parseMessage(const std::string& rawMessage);
+    FixMessage parseMessage(std::string_view rawMessage);
     
     /**
      * @brief Parse New Order Single message
@@ -231,7 +303,7 @@ private:
      * @param timestampStr Timestamp string from FIX message
      * @return Parsed timestamp
      */
-    std::chrono::system_clock::time_point parseTimestamp(const std::string& timestampStr);
+    std::chrono::system_clock::time_point parseTimestamp(std::string_view timestampStr);
     
     /**
      * @brief Convert Side enum to FIX side character
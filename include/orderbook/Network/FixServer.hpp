@@ -3,6 +3,7 @@
 #include "../Risk/RiskManager.hpp"
 #include "FixSession.hpp"
 #include "FixMessageHandler.hpp"
+#include "IoContextPool.hpp"
 #include <boost/asio.hpp>
 #include <memory>
 #include <vector>
@@ -22,10 +23,12 @@ public:
      * @param io_context IO context for async operations
      * @param orderManager Order management system
      * @param riskManager Risk management system
+     * @param priceScale Instrument tick size for wire price conversion
      */
     FixServer(boost::asio::io_context& io_context,
              std::shared_ptr<OrderManager> orderManager,
-             std::shared_ptr<RiskManager> riskManager);
+             std::shared_ptr<RiskManager> riskManager,
+             PriceScale priceScale = PriceScale());
     
     /**
      * @brief Start the server on specified port
@@ -51,6 +54,30 @@ public:
     };
     
     ServerStats getStats() const;
+    
+    /**
+     * @brief Socket write policy applied to every accepted session
+     */
+    void setSessionWriteOptions(const FixSession::WriteOptions& options) { sessionWriteOptions_ = options; }
+
+    /**
+     * @brief Mass-cancel a session's accounts when it disconnects (off by default)
+     */
+    void setCancelOnDisconnect(bool enabled) { cancelOnDisconnect_ = enabled; }
+
+    /**
+     * @brief Run session I/O on a pool of threads instead of the server's io_context
+     * Sessions are assigned round-robin at accept; order entry stays serialized on a
+     * strand of the server's io_context because OrderManager is single-threaded.
+     * Call before start(). 1 keeps everything on the server's io_context, 0 = one per core.
+     */
+    void setIoThreads(size_t threads);
+
+    /**
+     * @brief Wrap each accepted socket in a custom transport (default AsioTcpTransport)
+     * Call before start().
+     */
+    void setTransportFactory(FixTransportFactory factory) { transportFactory_ = std::move(factory); }
 
 private:
     /**
@@ -68,10 +95,11 @@ private:
     /**
      * @brief Handle session events
      * @param session Session that generated the event
+     * @param handler The session's message handler (cancel-on-disconnect)
      * @param state New session state
      * @param reason Reason for state change
      */
-    void handleSessionEvent(std::shared_ptr<FixSession> session, 
+    void handleSessionEvent(std::shared_ptr<FixSession> session, std::shared_ptr<FixMessageHandler> handler,
                           FixSession::SessionState state, const std::string& reason);
     
     /**
@@ -83,10 +111,13 @@ private:
     // Network components
     boost::asio::io_context& ioContext_;
     boost::asio::ip::tcp::acceptor acceptor_;
+    std::unique_ptr<IoContextPool> sessionPool_;
+    boost::asio::strand<boost::asio::io_context::executor_type> orderStrand_;
     
     // Core components
     std::shared_ptr<OrderManager> orderManager_;
     std::shared_ptr<RiskManager> riskManager_;
+    PriceScale priceScale_;
     
     // Session management
     std::vector<std::shared_ptr<FixSession>> sessions_;
@@ -94,6 +125,9 @@ private:
     
     // Server configuration
     std::string senderCompId_;
+    FixSession::WriteOptions sessionWriteOptions_;
+    bool cancelOnDisconnect_ = false;
+    FixTransportFactory transportFactory_;
     
     // Statistics
     std::atomic<size_t> totalConnections_{0};
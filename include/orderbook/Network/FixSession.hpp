@@ -3,12 +3,15 @@
 #include "../Core/Types.hpp"
 #include "../Core/Interfaces.hpp"
 #include "FixParser.hpp"
+#include "FixFramer.hpp"
+#include "FixEncoder.hpp"
+#include "FixTransport.hpp"
 #include <boost/asio.hpp>
 #include <functional>
 #include <memory>
 #include <string>
 #include <chrono>
-#include <queue>
+#include <vector>
 #include <mutex>
 #include <atomic>
 
@@ -18,7 +21,8 @@ class Config;
 
 /**
  * @brief FIX 4.4 Session Management
- * Handles async TCP connection, message parsing, sequence numbers, and heartbeats
+ * Handles message parsing, sequence numbers, and heartbeats over a FixTransport
+ * (a plain Asio TCP socket unless the server supplies another transport)
  */
 class FixSession : public std::enable_shared_from_this<FixSession> {
 public:
@@ -34,6 +38,16 @@ public:
         Disconnecting
     };
     
+    /**
+     * @brief Socket policy for outbound traffic
+     */
+    struct WriteOptions {
+        // Disable Nagle so a lone report is not held back waiting for an ACK
+        bool tcp_no_delay = true;
+        // Linux only: cork while a gathered burst is written so it leaves in full segments
+        bool tcp_cork = false;
+    };
+    
     /**
      * @brief Message handlers
      */
@@ -50,6 +64,12 @@ public:
      */
     FixSession(boost::asio::ip::tcp::socket socket, boost::asio::io_context& io_context, LoggerPtr logger = nullptr);
     
+    /**
+     * @brief Constructor for server-side session over a connected transport
+     * @param transport Connected transport whose completions run on io_context
+     */
+    FixSession(std::unique_ptr<FixTransport> transport, boost::asio::io_context& io_context, LoggerPtr logger = nullptr);
+    
     /**
      * @brief Constructor for client-side session (initiating connection)
      * @param io_context IO context for async operations
@@ -131,6 +151,11 @@ public:
      */
     void setSessionIds(const std::string& senderCompId, const std::string& targetCompId);
     
+    /**
+     * @brief Set the outbound socket policy (applied when the session starts or connects)
+     */
+    void setWriteOptions(const WriteOptions& options) { writeOptions_ = options; }
+    
     /**
      * @brief Get current session state
      * @return Current session state
@@ -143,6 +168,11 @@ public:
      */
     bool isLoggedIn() const { return state_ == SessionState::LoggedIn; }
     
+    /**
+     * @brief io_context that runs this session's transport and timers
+     */
+    boost::asio::io_context& getIoContext() { return ioContext_; }
+    
     /**
      * @brief Get session statistics
      */
@@ -181,11 +211,16 @@ private:
      */
     void readMessage();
     
+    /**
+     * @brief Frame and process every complete message in the receive buffer
+     */
+    void processReceived();
+    
     /**
      * @brief Process received message
-     * @param message Raw message string
+     * @param message One complete raw message (a view into the receive buffer)
      */
-    void processMessage(const std::string& message);
+    void processMessage(std::string_view message);
     
     /**
      * @brief Handle different message types
@@ -194,7 +229,7 @@ private:
     void handleLogout(const FixMessageParser::FixMessage& msg);
     void handleHeartbeat(const FixMessageParser::FixMessage& msg);
     void handleTestRequest(const FixMessageParser::FixMessage& msg);
-    void handleNewOrderSingle(const FixMessageParser::FixMessage& msg);
+    void handleNewOrderSingle(const FixMessageParser::FixMessage& msg, TscClock::Ticks received);
     void handleOrderCancelReplaceRequest(const FixMessageParser::FixMessage& msg);
     void handleOrderCancelRequest(const FixMessageParser::FixMessage& msg);
     void handleReject(const FixMessageParser::FixMessage& msg);
@@ -212,10 +247,15 @@ private:
     void writeMessage(const std::string& message);
     
     /**
-     * @brief Perform actual write operation
+     * @brief Write every pending message with one gathered async_write (writeMutex_ held)
      */
     void doWrite();
     
+    /**
+     * @brief Apply WriteOptions to the connected socket
+     */
+    void applySocketOptions();
+    
     /**
      * @brief Start heartbeat timer
      */
@@ -273,12 +313,13 @@ private:
 private:
     // Network components
     boost::asio::io_context& ioContext_;
-    boost::asio::ip::tcp::socket socket_;
+    std::unique_ptr<FixTransport> transport_;
     boost::asio::steady_timer heartbeatTimer_;
     boost::asio::steady_timer testRequestTimer_;
     
     // FIX protocol components
     FixMessageParser parser_;
+    FixEncoder encoder_;
     std::string senderCompId_;
     std::string targetCompId_;
     
@@ -307,14 +348,21 @@ private:
     size_t heartbeatsReceived_{0};
     std::chrono::system_clock::time_point sessionStartTime_;
     
-    // Message buffer
-    std::array<char, 8192> readBuffer_;
-    std::string messageBuffer_;
+    // Receive buffer; each read asks for at least ReadChunkSize bytes of space
+    static constexpr size_t ReadChunkSize = 16 * 1024;
+    FixFramer framer_;
     
     // Write queue for thread safety
-    std::queue<std::string> writeQueue_;
+    // Messages queue in pooled strings while a gathered write is in flight; the
+    // next write takes the whole backlog as one buffer sequence
+    static constexpr size_t MaxPooledWriteBuffers = 256;
+    std::vector<std::string> pendingWrites_;
+    std::vector<std::string> inflightWrites_;
+    std::vector<std::string> writeBufferPool_;
+    std::vector<boost::asio::const_buffer> writeGather_;
+    bool writeInProgress_{false};
     std::mutex writeMutex_;
-    bool writing_{false};
+    WriteOptions writeOptions_;
     
     // Configuration
     std::shared_ptr<Config> config_;
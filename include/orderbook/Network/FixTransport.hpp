@@ -0,0 +1,82 @@
+#pragma once
+#include <boost/asio.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Byte stream under a FixSession
+ *
+ * FixSession frames, parses and queues on top of this; a transport only moves bytes.
+ * Completions run on the session's io_context. The session keeps at most one read
+ * and one write outstanding, and buffers stay valid until their handler runs.
+ * AsioTcpTransport is the default; other stacks (a native ring backend or a
+ * kernel-bypass library) plug in through FixServer::setTransportFactory.
+ */
+class FixTransport {
+public:
+    using IoHandler = std::function<void(const boost::system::error_code&, std::size_t)>;
+    using ConnectHandler = std::function<void(const boost::system::error_code&)>;
+
+    virtual ~FixTransport() = default;
+
+    /**
+     * @brief Resolve host and connect (client sessions)
+     */
+    virtual void asyncConnect(const std::string& host, uint16_t port, ConnectHandler handler) = 0;
+
+    /**
+     * @brief Read whatever is ready, up to buffer's size
+     */
+    virtual void asyncReadSome(boost::asio::mutable_buffer buffer, IoHandler handler) = 0;
+
+    /**
+     * @brief Write every byte of the gathered buffers
+     */
+    virtual void asyncWrite(const std::vector<boost::asio::const_buffer>& buffers, IoHandler handler) = 0;
+
+    virtual void setNoDelay(bool enabled, boost::system::error_code& ec) = 0;
+
+    /**
+     * @brief Hold partial segments while a burst is written (no-op where unsupported)
+     */
+    virtual void setCork(bool enabled) = 0;
+
+    virtual bool isOpen() const = 0;
+    virtual void close() = 0;
+};
+
+/**
+ * @brief FixTransport over a Boost.Asio TCP socket
+ * With ORDERBOOK_IO_URING (Boost 1.78+), Asio itself runs these operations on
+ * io_uring instead of epoll.
+ */
+class AsioTcpTransport : public FixTransport {
+public:
+    explicit AsioTcpTransport(boost::asio::ip::tcp::socket socket) : socket_(std::move(socket)) {}
+    explicit AsioTcpTransport(boost::asio::io_context& io_context) : socket_(io_context) {}
+
+    void asyncConnect(const std::string& host, uint16_t port, ConnectHandler handler) override;
+    void asyncReadSome(boost::asio::mutable_buffer buffer, IoHandler handler) override;
+    void asyncWrite(const std::vector<boost::asio::const_buffer>& buffers, IoHandler handler) override;
+    void setNoDelay(bool enabled, boost::system::error_code& ec) override;
+    void setCork(bool enabled) override;
+    bool isOpen() const override { return socket_.is_open(); }
+    void close() override;
+
+    boost::asio::ip::tcp::socket& socket() { return socket_; }
+
+private:
+    boost::asio::ip::tcp::socket socket_;
+};
+
+/**
+ * @brief Wraps an accepted connection in the transport its session will use
+ */
+using FixTransportFactory = std::function<std::unique_ptr<FixTransport>(boost::asio::ip::tcp::socket)>;
+
+}
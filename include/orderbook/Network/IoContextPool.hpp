@@ -0,0 +1,56 @@
+#pragma once
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Fixed set of single-threaded io_contexts, one reactor thread each
+ *
+ * Servers accept on one context and hand each new connection to next(), so sessions
+ * are spread round-robin and every session's handlers stay on one thread.
+ */
+class IoContextPool {
+public:
+    /**
+     * @param size Number of contexts/threads; 0 means one per hardware thread
+     */
+    explicit IoContextPool(size_t size = 1);
+    ~IoContextPool();
+
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+
+    /**
+     * @brief Start one thread per context (no-op if already running)
+     */
+    void run();
+
+    /**
+     * @brief Stop every context and join the threads
+     */
+    void stop();
+
+    /**
+     * @brief Context for the next session, round-robin
+     */
+    boost::asio::io_context& next();
+
+    boost::asio::io_context& at(size_t index) { return *contexts_[index]; }
+    size_t size() const { return contexts_.size(); }
+    bool running() const { return !threads_.empty(); }
+
+private:
+    using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+
+    std::vector<std::unique_ptr<boost::asio::io_context>> contexts_;
+    std::vector<WorkGuard> guards_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_{0};
+};
+
+}
@@ -1,19 +1,24 @@
 #pragma once
 
 #include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/strand.hpp>
+#include "IoContextPool.hpp"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
-#include <set>
 
 namespace orderbook {
 
@@ -26,9 +31,106 @@ using tcp = boost::asio::ip::tcp;       // from <boost/asio/ip/tcp.hpp>
 // Forward declaration
 class WsSession;
 
+/**
+ * @brief WebSocket server settings, including the per-client slow-consumer policy
+ */
+struct WsServerOptions {
+    // Reactor threads for client sessions, assigned round-robin at accept (0 = one per core)
+    size_t io_threads = 1;
+    // Unsent messages a session may hold; beyond this they are replaced by one full snapshot
+    size_t max_queued_messages = 8;
+    // Conflated broadcasts without a completed write before a stalled client is disconnected (0 = never)
+    size_t max_lagged_updates = 600;
+    // Offer permessage-deflate; each client negotiates it in its own handshake
+    bool permessage_deflate = false;
+    // Minimum spacing between broadcasts; updates inside the window conflate into one
+    uint32_t min_interval_ms = 16;
+    // Depth levels per side carried in snapshots and diffs (0 = top of book only)
+    size_t depth_levels = 5;
+    // Depth diffs between full depth snapshots (joins also force a full snapshot)
+    size_t full_snapshot_interval = 100;
+    // Send the packed binary layout documented on WsServer instead of JSON text
+    bool binary_frames = false;
+};
+
+/**
+ * @brief One aggregated price level as shown to WebSocket clients
+ */
+struct WsDepthLevel {
+    double price = 0.0;
+    double quantity = 0.0;
+
+    bool operator==(const WsDepthLevel& other) const {
+        return price == other.price && quantity == other.quantity;
+    }
+};
+
+/**
+ * @brief One session's outbound frames and its slow-consumer policy
+ *
+ * front() is in flight between startWrite() and finishWrite(). Every push carries the
+ * broadcast's frame and a full snapshot of the same state (the same pointer when the
+ * frame is itself a snapshot). Once max_queued unsent frames are waiting, they are
+ * dropped and the snapshot is queued instead: deltas diff against the previous
+ * broadcast, so dropping any of them would leave the client's depth wrong.
+ */
+class WsFrameQueue {
+public:
+    using Frame = std::shared_ptr<std::string const>;
+
+    explicit WsFrameQueue(size_t max_queued) : max_queued_(std::max<size_t>(max_queued, 1)) {}
+
+    /**
+     * @brief Queue a broadcast
+     * @return true if unsent frames were conflated into the snapshot
+     */
+    bool push(const Frame& frame, const Frame& snapshot) {
+        size_t in_flight = writing_ ? 1 : 0;
+        if (frames_.size() - in_flight >= max_queued_) {
+            frames_.erase(frames_.begin() + in_flight, frames_.end());
+            frames_.push_back(snapshot);
+            return true;
+        }
+        frames_.push_back(frame);
+        return false;
+    }
+
+    bool empty() const { return frames_.empty(); }
+    size_t size() const { return frames_.size(); }
+    bool writing() const { return writing_; }
+    const Frame& front() const { return frames_.front(); }
+
+    void startWrite() { writing_ = true; }
+    // The front frame was written (or failed); it leaves the queue
+    void finishWrite() {
+        writing_ = false;
+        if (!frames_.empty()) frames_.pop_front();
+    }
+    // Drop everything not yet handed to the socket
+    void clear() { frames_.erase(frames_.begin() + (writing_ && !frames_.empty() ? 1 : 0), frames_.end()); }
+
+private:
+    std::deque<Frame> frames_;
+    size_t max_queued_;
+    bool writing_ = false;
+};
+
+/**
+ * @brief Conflating market data fan-out to browser clients
+ *
+ * update*() mark the book dirty and wake the broadcast thread, which publishes at most
+ * once per min_interval_ms and only when something changed. Each message carries top of
+ * book and last trade plus depth: a full "SNAPSHOT" or a "DELTA" listing only levels
+ * whose quantity changed (quantity 0 = level removed).
+ *
+ * Binary frames (little-endian, packed):
+ *   u8 type (1 = snapshot, 2 = delta), u8 version (1), u16 bid count, u16 ask count,
+ *   u16 reserved, i64 timestamp ms, f64 bid, bid_qty, ask, ask_qty, last_price, last_qty,
+ *   then bid count and ask count (f64 price, f64 quantity) pairs.
+ */
 class WsServer : public std::enable_shared_from_this<WsServer> {
 public:
-    WsServer();
+    explicit WsServer(WsServerOptions options = WsServerOptions());
     ~WsServer();
 
     void start(uint16_t port);
@@ -38,24 +140,40 @@ public:
     // New API for Conflation
     void updateTopOfBook(double bid, double bidQty, double ask, double askQty);
     void updateLastTrade(double price, double qty);
+    void updateDepth(const std::vector<WsDepthLevel>& bids, const std::vector<WsDepthLevel>& asks);
+
+    using HttpHandler = std::function<std::string()>;
+
+    /**
+     * @brief Answer plain HTTP GETs for target (e.g. "/stats") on the WebSocket port
+     * The handler runs on an I/O thread and returns the JSON body.
+     */
+    void setHttpHandler(const std::string& target, HttpHandler handler);
 
     // Internal use
     void join(std::shared_ptr<WsSession> session);
     void leave(std::shared_ptr<WsSession> session);
+    bool handleHttp(const std::string& target, std::string& body);
 
 private:
-    void run();
     void do_accept();
     void on_accept(beast::error_code ec, tcp::socket socket);
     void broadcastLoop(); // New broadcast loop
-    void broadcast(const std::string& msg); // Made private
+    // snapshot is a full frame of the same state, for sessions that must resync
+    void broadcast(const std::string& msg, const std::string* snapshot); // Made private
+    void markDirty();
 
-    net::io_context ioc_;
+    using SessionList = std::vector<std::shared_ptr<WsSession>>;
+
+    WsServerOptions options_;
+    IoContextPool pool_;
     std::unique_ptr<tcp::acceptor> acceptor_;
-    std::unique_ptr<std::thread> thread_;
+    // Copy-on-write: join/leave swap in a new list under mutex_, broadcast reads it lock-free
     std::mutex mutex_;
-    std::set<std::shared_ptr<WsSession>> sessions_;
-    bool running_;
+    std::shared_ptr<const SessionList> sessions_;
+    std::atomic<bool> running_;
+    std::mutex http_mutex_;
+    std::unordered_map<std::string, HttpHandler> http_handlers_;
 
     // Conflation State
     struct BookState {
@@ -66,10 +184,20 @@ private:
         double lastPrice = 0.0;
         double lastQty = 0.0;
         long long timestamp = 0;
+        std::vector<WsDepthLevel> bids;
+        std::vector<WsDepthLevel> asks;
     };
 
+    static void encodeJson(std::string& out, const BookState& state, bool full,
+                           const std::vector<WsDepthLevel>& bids, const std::vector<WsDepthLevel>& asks);
+    static void encodeBinary(std::string& out, const BookState& state, bool full,
+                             const std::vector<WsDepthLevel>& bids, const std::vector<WsDepthLevel>& asks);
+
     std::mutex state_mutex_;
+    std::condition_variable state_cv_;
     BookState latest_state_;
+    bool dirty_ = false;
+    bool full_pending_ = true;
     std::unique_ptr<std::thread> broadcast_thread_;
     std::atomic<bool> stop_signal_{false};
 };
@@ -2,9 +2,13 @@
 #include "../Core/Types.hpp"
 #include "../Core/Interfaces.hpp"
 #include "../Core/Order.hpp"
+#include "../Core/SymbolMaster.hpp"
 #include <unordered_map>
+#include <array>
 #include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace orderbook {
 
@@ -12,13 +16,17 @@ class Config;
 
 /**
  * @brief Concrete implementation of risk management
+ *
+ * Position state is a flat per-account, per-symbol table of atomic counters indexed
+ * by interned IDs, so pre-trade checks run concurrently on the submitting threads and
+ * the matching threads only apply post-trade deltas. Nothing on either path locks.
  */
 class RiskManager : public IRiskManager {
 public:
     struct RiskLimits {
         Quantity max_order_size = 10000;
-        Price max_price = 1000000.0;
-        Price min_price = 0.01;
+        Price max_price = 100000000;  // ticks (1,000,000.00 at the default 0.01 tick)
+        Price min_price = 1;
         int64_t max_position = 100000;
         int64_t min_position = -100000;
     };
@@ -29,35 +37,137 @@ public:
     
     // IRiskManager interface implementation
     RiskCheck validateOrder(const Order& order, const Portfolio& portfolio) override;
+    RiskCheck preTradeCheck(const Order& order) override;
+    void onFill(AccountId account, SymbolId symbol, Side side, Quantity quantity, Price price,
+                bool reserved) override;
+    void adjustExposure(AccountId account, SymbolId symbol, Side side, int64_t delta) override;
     void updatePosition(const Trade& trade) override;
-    const Portfolio& getPortfolio(const std::string& account) const override;
+    int64_t getPosition(AccountId account, SymbolId symbol) const override;
+    Portfolio getPortfolio(AccountId account) const override;
     
-    // Configuration
+    // Configuration. setLimits publishes a new version that checks already running
+    // finish against the old one; the returned reference stays valid for the manager's lifetime.
     void setLimits(const RiskLimits& limits);
     const RiskLimits& getLimits() const;
     void loadConfiguration(std::shared_ptr<Config> config);
     void reloadConfiguration();
+
+    /**
+     * @brief Add per-instrument checks from the symbol master (call before trading)
+     * Orders for a listed symbol must be whole lots and, where the symbol has a price
+     * band, priced inside it; unlisted symbols see only the global limits.
+     */
+    void setSymbolMaster(SymbolMasterPtr master) { symbol_master_ = std::move(master); }
     
     // Account management
-    void associateOrderWithAccount(OrderId order_id, const std::string& account) override;
-    std::string getAccountForOrder(OrderId order_id) const override;
+    void associateOrderWithAccount(OrderId order_id, AccountId account) override;
+    AccountId getAccountForOrder(OrderId order_id) const override;
 
     // Bypass control for validation and updates
     void setBypass(bool bypass) override;
     bool isBypassed() const override;
 
 private:
-    RiskLimits limits_;
-    mutable std::unordered_map<std::string, Portfolio> portfolios_;
-    std::unordered_map<OrderId, std::string, OrderIdHash> order_to_account_;
+    // Filled position and resting (reserved, unfilled) quantity per side
+    struct PositionCell {
+        std::atomic<int64_t> position{0};
+        std::atomic<int64_t> open_buy{0};
+        std::atomic<int64_t> open_sell{0};
+        std::atomic<Price> last_price{0};
+    };
+
+    /**
+     * @brief Fixed directory of lazily allocated chunks, installed with a CAS
+     * Lookups are an acquire load per level; chunks live until the table does.
+     */
+    template<typename T, size_t ChunkSize, size_t MaxChunks>
+    class ChunkTable {
+    public:
+        static constexpr size_t Capacity = ChunkSize * MaxChunks;
+
+        ChunkTable() {
+            for (auto& chunk : chunks_) chunk.store(nullptr, std::memory_order_relaxed);
+        }
+        ~ChunkTable() {
+            for (auto& chunk : chunks_) delete[] chunk.load(std::memory_order_relaxed);
+        }
+        ChunkTable(const ChunkTable&) = delete;
+        ChunkTable& operator=(const ChunkTable&) = delete;
+
+        // Existing entry or nullptr
+        T* find(size_t index) const {
+            if (index >= Capacity) return nullptr;
+            T* chunk = chunks_[index / ChunkSize].load(std::memory_order_acquire);
+            return chunk ? &chunk[index % ChunkSize] : nullptr;
+        }
+
+        // Entry, allocating its chunk on first touch; nullptr past capacity
+        T* get(size_t index) {
+            if (index >= Capacity) return nullptr;
+            auto& slot = chunks_[index / ChunkSize];
+            T* chunk = slot.load(std::memory_order_acquire);
+            if (!chunk) {
+                T* fresh = new T[ChunkSize]();
+                if (slot.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                    chunk = fresh;
+                } else {
+                    delete[] fresh;  // another thread installed it first
+                }
+            }
+            return &chunk[index % ChunkSize];
+        }
+
+        template<typename Fn>
+        void forEachChunk(Fn&& fn) const {
+            for (size_t c = 0; c < MaxChunks; ++c) {
+                if (T* chunk = chunks_[c].load(std::memory_order_acquire)) fn(c * ChunkSize, chunk, ChunkSize);
+            }
+        }
+
+    private:
+        std::array<std::atomic<T*>, MaxChunks> chunks_;
+    };
+
+    // Symbols per account row: 64-cell chunks, up to 64K interned symbols
+    using AccountRow = ChunkTable<PositionCell, 64, 1024>;
+
+    struct AccountSlot {
+        std::atomic<AccountRow*> row{nullptr};
+        ~AccountSlot() { delete row.load(std::memory_order_relaxed); }
+    };
+
+    // Accounts: 256-slot chunks covering every ID the account table can intern
+    using AccountDirectory = ChunkTable<AccountSlot, 256, 4096>;
+
+    // Current limits, read with one acquire load per check. Every published version
+    // is kept until the manager is destroyed, so a reader never sees one freed.
+    std::atomic<const RiskLimits*> limits_{nullptr};
+    std::vector<std::unique_ptr<const RiskLimits>> limit_versions_;
+    std::mutex limits_mutex_;  // Serializes publishers
+    PriceScale price_scale_;
+    AccountDirectory accounts_;
+    AccountId default_account_;
+    std::unordered_map<OrderId, AccountId, OrderIdHash> order_to_account_;
     std::shared_ptr<Config> config_;
+    SymbolMasterPtr symbol_master_;
     LoggerPtr logger_;
     std::atomic<bool> bypass_{false};
+    // Guards order_to_account_ only; position state is lock-free
+    mutable std::mutex account_map_mutex_;
     
-    // Validation helpers
-    bool validateOrderSize(Quantity quantity) const;
-    bool validatePrice(Price price) const;
-    bool validatePosition(const Portfolio& portfolio, const Order& order) const;
+    // Validation helpers, each against the limits version its caller loaded
+    void publishLimits(const RiskLimits& limits);
+    const RiskLimits& currentLimits() const { return *limits_.load(std::memory_order_acquire); }
+    static bool validateOrderSize(const RiskLimits& limits, Quantity quantity);
+    static bool validatePrice(const RiskLimits& limits, Price price);
+    bool validateInstrument(const Order& order, std::string& reason) const;
+    static bool validatePosition(const RiskLimits& limits, const Portfolio& portfolio, const Order& order);
+    AccountId resolveAccount(AccountId account) const { return account == 0 ? default_account_ : account; }
+    PositionCell* cellFor(AccountId account, SymbolId symbol);
+    const PositionCell* findCell(AccountId account, SymbolId symbol) const;
+    void applyFill(PositionCell& cell, Side side, Quantity quantity, Price price, bool reserved);
+    AccountId accountForOrderLocked(OrderId order_id) const;
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,261 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+#endif
+
+namespace orderbook {
+
+/**
+ * @brief Backing-memory settings for an Arena
+ */
+struct ArenaOptions {
+    // Map with MAP_HUGETLB (2MB pages); falls back to transparent huge pages if none are reserved
+    bool huge_pages = false;
+    // Bind the pages to this NUMA node before they are touched (-1 = first-touch placement)
+    int numa_node = -1;
+    // Touch every page up front so the hot path never takes a page fault
+    bool prefault = false;
+};
+
+/**
+ * @brief NUMA node of a CPU from sysfs, or -1 if unknown
+ */
+inline int numaNodeOfCpu(int cpu) {
+#ifdef __linux__
+    if (cpu < 0) return -1;
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return -1;
+    int node = -1;
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0) {
+            node = std::atoi(name.c_str() + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+/**
+ * @brief One contiguous, page-aligned anonymous mapping
+ * Memory starts zeroed and is returned to the OS as a whole on destruction.
+ */
+class Arena {
+public:
+    static constexpr size_t HugePageSize = size_t(2) << 20;
+
+    Arena() = default;
+
+    explicit Arena(size_t bytes, ArenaOptions options = ArenaOptions()) {
+        if (bytes == 0) return;
+#ifdef __linux__
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t granule = options.huge_pages ? HugePageSize : page;
+        size_ = (bytes + granule - 1) / granule * granule;
+
+        void* p = MAP_FAILED;
+        if (options.huge_pages) {
+            p = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            huge_pages_ = p != MAP_FAILED;
+        }
+        if (p == MAP_FAILED) {
+            p = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+            if (p != MAP_FAILED && options.huge_pages) madvise(p, size_, MADV_HUGEPAGE);
+#endif
+        }
+        if (p == MAP_FAILED) {
+            size_ = 0;
+            throw std::bad_alloc();
+        }
+        data_ = p;
+        mapped_ = true;
+
+#ifdef SYS_mbind
+        if (options.numa_node >= 0 && options.numa_node < 64) {
+            constexpr int MpolBind = 2;
+            unsigned long mask = 1UL << options.numa_node;
+            numa_bound_ = syscall(SYS_mbind, data_, size_, MpolBind, &mask, sizeof(mask) * 8, 0) == 0;
+        }
+#endif
+        if (options.prefault) {
+            auto* bytes_ptr = static_cast<volatile unsigned char*>(data_);
+            for (size_t off = 0; off < size_; off += huge_pages_ ? HugePageSize : page) {
+                bytes_ptr[off] = 0;
+            }
+        }
+#else
+        (void)options;
+        size_ = (bytes + 4095) / 4096 * 4096;
+        data_ = std::aligned_alloc(4096, size_);
+        if (!data_) throw std::bad_alloc();
+        std::memset(data_, 0, size_);
+#endif
+    }
+
+    ~Arena() { unmap(); }
+
+    Arena(Arena&& other) noexcept { *this = std::move(other); }
+    Arena& operator=(Arena&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_ = other.mapped_;
+            huge_pages_ = other.huge_pages_;
+            numa_bound_ = other.numa_bound_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool hugePages() const { return huge_pages_; }
+    bool numaBound() const { return numa_bound_; }
+
+private:
+    void unmap() {
+        if (!data_) return;
+#ifdef __linux__
+        if (mapped_) munmap(data_, size_);
+#else
+        std::free(data_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    bool huge_pages_ = false;
+    bool numa_bound_ = false;
+};
+
+/**
+ * @brief Fixed-capacity object pool over one Arena
+ *
+ * Slots are carved from the arena on first use, so construction does no per-object
+ * work. Free slots form an intrusive LIFO list of 32-bit slot indices stored in the
+ * slots themselves. Not thread-safe; allocate() returns nullptr when the arena is full.
+ */
+template<typename T>
+class ArenaPool {
+public:
+    explicit ArenaPool(size_t capacity, ArenaOptions options = ArenaOptions())
+        : capacity_(static_cast<uint32_t>(std::min<size_t>(capacity, NoSlot - 1))),
+          arena_(static_cast<size_t>(capacity_) * sizeof(Slot), options) {
+#ifndef NDEBUG
+        live_.assign(capacity_, false);
+#endif
+    }
+
+    ~ArenaPool() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            // Destroy whatever is still live: every bumped slot not on the free list
+            std::vector<bool> free_slots(bumped_, false);
+            for (uint32_t i = free_head_; i != NoSlot; i = slots()[i].next_free) free_slots[i] = true;
+            for (uint32_t i = 0; i < bumped_; ++i) {
+                if (!free_slots[i]) object(i)->~T();
+            }
+        }
+    }
+
+    ArenaPool(const ArenaPool&) = delete;
+    ArenaPool& operator=(const ArenaPool&) = delete;
+
+    /**
+     * @brief Value-initialised T from the arena, or nullptr when every slot is in use
+     */
+    T* allocate() {
+        uint32_t index;
+        if (free_head_ != NoSlot) {
+            index = free_head_;
+            free_head_ = slots()[index].next_free;
+        } else if (bumped_ < capacity_) {
+            index = bumped_++;
+        } else {
+            return nullptr;
+        }
+#ifndef NDEBUG
+        live_[index] = true;
+#endif
+        ++in_use_;
+        return ::new (static_cast<void*>(slots()[index].storage)) T();
+    }
+
+    /**
+     * @brief Return an object obtained from allocate()
+     */
+    void release(T* obj) {
+        uint32_t index = indexOf(obj);
+#ifndef NDEBUG
+        assert(owns(obj) && live_[index] && "ArenaPool: release of foreign or free object");
+        live_[index] = false;
+#endif
+        obj->~T();
+        slots()[index].next_free = free_head_;
+        free_head_ = index;
+        --in_use_;
+    }
+
+    bool owns(const T* obj) const {
+        auto p = reinterpret_cast<const unsigned char*>(obj);
+        auto base = static_cast<const unsigned char*>(arena_.data());
+        return p >= base && p < base + static_cast<size_t>(capacity_) * sizeof(Slot);
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t inUse() const { return in_use_; }
+    size_t available() const { return capacity_ - in_use_; }
+    const Arena& arena() const { return arena_; }
+
+private:
+    static constexpr uint32_t NoSlot = std::numeric_limits<uint32_t>::max();
+
+    union Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint32_t next_free;
+    };
+
+    Slot* slots() const { return static_cast<Slot*>(arena_.data()); }
+    T* object(uint32_t index) const { return reinterpret_cast<T*>(slots()[index].storage); }
+    uint32_t indexOf(const T* obj) const {
+        return static_cast<uint32_t>(reinterpret_cast<const Slot*>(obj) - slots());
+    }
+
+    uint32_t capacity_;
+    Arena arena_;
+    uint32_t free_head_ = NoSlot;
+    uint32_t bumped_ = 0;
+    size_t in_use_ = 0;
+    // Live slots, tracked in debug builds only; declared in all builds so the layout
+    // does not depend on NDEBUG (tests build with asserts against release libraries)
+    std::vector<bool> live_;
+};
+
+} // namespace orderbook
@@ -0,0 +1,188 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+namespace orderbook {
+
+/**
+ * @brief Open-addressing hash map with Robin Hood probing
+ * Entries live in one contiguous array sized to a power of two, with a parallel byte
+ * array of probe distances. Presize with reserve() so steady-state inserts never
+ * allocate. Erase uses backward shifting (no tombstones), so any insert or erase
+ * invalidates iterators and references into the map.
+ */
+template<typename Key, typename Value, typename Hash>
+class FlatHashMap {
+public:
+    using value_type = std::pair<Key, Value>;
+
+    template<bool Const>
+    class IteratorBase {
+    public:
+        using MapType = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+        IteratorBase(MapType* map, size_t idx) : map_(map), idx_(idx) { skipEmpty(); }
+        // Allow iterator -> const_iterator
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        IteratorBase(const IteratorBase<false>& other) : map_(other.map_), idx_(other.idx_) {}
+
+        reference operator*() const { return map_->slots_[idx_]; }
+        pointer operator->() const { return &map_->slots_[idx_]; }
+        IteratorBase& operator++() { ++idx_; skipEmpty(); return *this; }
+        bool operator==(const IteratorBase& other) const { return idx_ == other.idx_; }
+        bool operator!=(const IteratorBase& other) const { return idx_ != other.idx_; }
+
+    private:
+        friend class FlatHashMap;
+        template<bool> friend class IteratorBase;
+
+        void skipEmpty() {
+            while (idx_ < map_->dist_.size() && map_->dist_[idx_] == 0) ++idx_;
+        }
+
+        MapType* map_;
+        size_t idx_;
+    };
+
+    using iterator = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    explicit FlatHashMap(size_t expected = 0) { reserve(expected); }
+
+    /**
+     * @brief Grow the table so that expected entries fit under the load limit
+     */
+    void reserve(size_t expected) {
+        size_t capacity = MinCapacity;
+        while (capacity - capacity / 8 < expected) capacity *= 2;
+        if (capacity > dist_.size()) rehash(capacity);
+    }
+
+    iterator find(const Key& key) { return iterator(this, findIndex(key)); }
+    const_iterator find(const Key& key) const { return const_iterator(this, findIndex(key)); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, dist_.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, dist_.size()); }
+
+    Value& operator[](const Key& key) {
+        size_t idx = findIndex(key);
+        if (idx == dist_.size()) idx = insertNew(value_type(key, Value()));
+        return slots_[idx].second;
+    }
+
+    void erase(iterator it) {
+        if (it.idx_ < dist_.size()) eraseIndex(it.idx_);
+    }
+
+    size_t erase(const Key& key) {
+        size_t idx = findIndex(key);
+        if (idx == dist_.size()) return 0;
+        eraseIndex(idx);
+        return 1;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < dist_.size(); ++i) {
+            if (dist_[i]) {
+                dist_[i] = 0;
+                slots_[i] = value_type();
+            }
+        }
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return dist_.size(); }
+
+private:
+    static constexpr size_t MinCapacity = 16;
+    // Probe distances are stored +1 in a byte; grow long before they could overflow
+    static constexpr uint8_t MaxDistance = 250;
+
+    size_t findIndex(const Key& key) const {
+        size_t idx = Hash{}(key) & mask_;
+        for (uint8_t d = 1; dist_[idx] >= d; ++d) {
+            if (slots_[idx].first == key) return idx;
+            idx = (idx + 1) & mask_;
+        }
+        return dist_.size();
+    }
+
+    // Insert a key known to be absent; returns its slot
+    size_t insertNew(value_type&& entry) {
+        if (size_ + 1 > max_size_) rehash(dist_.size() * 2);
+        Key key = entry.first;
+        ++size_;
+        return place(std::move(entry)) ? last_placed_ : findIndex(key);
+    }
+
+    // Robin Hood placement; returns false if it had to grow the table midway
+    bool place(value_type&& entry) {
+        size_t idx = Hash{}(entry.first) & mask_;
+        uint8_t d = 1;
+        bool first = true;
+        while (true) {
+            if (dist_[idx] == 0) {
+                dist_[idx] = d;
+                slots_[idx] = std::move(entry);
+                if (first) last_placed_ = idx;
+                return true;
+            }
+            if (dist_[idx] < d) {
+                // Steal the slot from the richer entry and carry it forward
+                std::swap(d, dist_[idx]);
+                std::swap(entry, slots_[idx]);
+                if (first) { last_placed_ = idx; first = false; }
+            }
+            idx = (idx + 1) & mask_;
+            if (++d == MaxDistance) {
+                rehash(dist_.size() * 2);
+                place(std::move(entry));
+                return false;
+            }
+        }
+    }
+
+    void eraseIndex(size_t idx) {
+        // Backward-shift the following run so lookups never need tombstones
+        size_t next = (idx + 1) & mask_;
+        while (dist_[next] > 1) {
+            slots_[idx] = std::move(slots_[next]);
+            dist_[idx] = dist_[next] - 1;
+            idx = next;
+            next = (next + 1) & mask_;
+        }
+        dist_[idx] = 0;
+        slots_[idx] = value_type();
+        --size_;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<value_type> old_slots(capacity);
+        std::vector<uint8_t> old_dist(capacity, 0);
+        old_slots.swap(slots_);
+        old_dist.swap(dist_);
+        mask_ = capacity - 1;
+        max_size_ = capacity - capacity / 8;
+        for (size_t i = 0; i < old_dist.size(); ++i) {
+            if (old_dist[i]) place(std::move(old_slots[i]));
+        }
+    }
+
+    std::vector<value_type> slots_;
+    std::vector<uint8_t> dist_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+    size_t max_size_ = 0;
+    size_t last_placed_ = 0;
+};
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "PerformanceMeasurement.hpp"
+#include "TraceStamps.hpp"
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+namespace orderbook {
+
+/**
+ * @brief 1-in-N order sampling and per-stage latency aggregation
+ *
+ * The first stage an order reaches asks begin() whether to trace it; a per-thread
+ * countdown makes that a decrement for the other N-1. Completed traces go to
+ * record(), which adds the time from the previous stage the order reached to each
+ * stage it reached into "Trace::<stage>" PerformanceMeasurement histograms (per
+ * thread, merged on read), plus "Trace::end_to_end". Off (interval 0) by default.
+ */
+class LatencyTracer {
+public:
+    static LatencyTracer& getInstance() {
+        static LatencyTracer instance;
+        return instance;
+    }
+
+    /**
+     * @brief Trace one order in every_n (0 = off, 1 = every order)
+     */
+    void setSampleInterval(uint32_t every_n) { interval_.store(every_n, std::memory_order_relaxed); }
+    uint32_t sampleInterval() const { return interval_.load(std::memory_order_relaxed); }
+    bool enabled() const { return sampleInterval() != 0; }
+
+    /**
+     * @brief Start tracing at stage if this order is picked and not already traced
+     * @param now Stamp for stage when it was taken earlier (0 = read the clock)
+     */
+    template <size_t Stages>
+    void begin(BasicTraceStamps<Stages>& trace, TraceStage stage, TscClock::Ticks now = 0) {
+        uint32_t every_n = sampleInterval();
+        if (every_n == 0 || trace.sampled()) return;
+        thread_local uint32_t countdown = 0;
+        if (countdown > 0) {
+            --countdown;
+            return;
+        }
+        countdown = every_n - 1;
+        trace.start(stage, now ? now : TscClock::now());
+    }
+
+    /**
+     * @brief Aggregate a finished trace (no-op for unsampled orders)
+     */
+    void record(const TraceStamps& trace) {
+        if (!trace.sampled()) return;
+        auto& perf = PerformanceMeasurement::getInstance();
+        uint32_t previous = 0;
+        uint32_t first = 0;
+        for (size_t i = 0; i < TraceStageCount; ++i) {
+            uint32_t at = trace.at[i];
+            if (at == 0) continue;
+            if (first == 0) {
+                first = at;
+            } else {
+                perf.recordLatency(metrics_[i], ticksToDuration(at > previous ? at - previous : 0));
+            }
+            previous = at;
+        }
+        perf.recordLatency(end_to_end_, ticksToDuration(previous - first));
+    }
+
+    /**
+     * @brief Per-stage statistics as JSON, for the stats endpoint
+     */
+    std::string statsJson() const {
+        auto& perf = PerformanceMeasurement::getInstance();
+        std::string out = "{\"sample_interval\":" + std::to_string(sampleInterval()) + ",\"stages\":[";
+        auto append = [&out, &perf](const char* name, bool first) {
+            auto stats = perf.getOperationStats(std::string("Trace::") + name);
+            char line[256];
+            std::snprintf(line, sizeof(line),
+                          "%s{\"stage\":\"%s\",\"count\":%zu,\"avg_ns\":%lld,\"p50_ns\":%lld,"
+                          "\"p95_ns\":%lld,\"p99_ns\":%lld,\"max_ns\":%lld}",
+                          first ? "" : ",", name, stats.sample_count,
+                          static_cast<long long>(stats.avg_latency.count()),
+                          static_cast<long long>(stats.p50_latency.count()),
+                          static_cast<long long>(stats.p95_latency.count()),
+                          static_cast<long long>(stats.p99_latency.count()),
+                          static_cast<long long>(stats.max_latency.count()));
+            out += line;
+        };
+        // The first stage has no interval of its own
+        for (size_t i = 1; i < TraceStageCount; ++i) {
+            append(stageName(static_cast<TraceStage>(i)), i == 1);
+        }
+        append("end_to_end", false);
+        out += "]}";
+        return out;
+    }
+
+    static const char* stageName(TraceStage stage) {
+        switch (stage) {
+            case TraceStage::FixReceive: return "fix_receive";
+            case TraceStage::FixHandler: return "fix_handler";
+            case TraceStage::Enqueue: return "enqueue";
+            case TraceStage::Dequeue: return "dequeue";
+            case TraceStage::Matched: return "matched";
+            case TraceStage::Published: return "published";
+        }
+        return "unknown";
+    }
+
+private:
+    LatencyTracer() {
+        auto& perf = PerformanceMeasurement::getInstance();
+        for (size_t i = 0; i < TraceStageCount; ++i) {
+            metrics_[i] = perf.registerMetric(std::string("Trace::") + stageName(static_cast<TraceStage>(i)));
+        }
+        end_to_end_ = perf.registerMetric("Trace::end_to_end");
+    }
+
+    // Stamps are offset by one; differences between two of them are plain ticks
+    static PerformanceMeasurement::Duration ticksToDuration(uint32_t ticks) {
+        return PerformanceMeasurement::Duration(static_cast<int64_t>(TscClock::toNanos(ticks)));
+    }
+
+    std::atomic<uint32_t> interval_{0};
+    std::array<PerformanceMeasurement::MetricId, TraceStageCount> metrics_{};
+    PerformanceMeasurement::MetricId end_to_end_ = PerformanceMeasurement::InvalidMetric;
+};
+
+} // namespace orderbook
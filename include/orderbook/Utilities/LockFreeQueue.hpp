@@ -1,65 +1,125 @@
 #pragma once
+#include <algorithm>
+#include <array>
 #include <atomic>
-#include <vector>
-#include <optional>
+#include <cstddef>
 
 namespace orderbook {
 
 /**
  * @brief Lock-free Single-Producer Single-Consumer (SPSC) queue
- * Optimized for high-throughput message passing between threads
+ * Optimized for high-throughput message passing between threads. Capacity is a
+ * power of two so indices are masked rather than divided; head and tail count up
+ * without wrapping, so all Capacity slots are usable. Each side keeps a private
+ * copy of the other's index and reloads it only when the ring looks full (or
+ * empty), so the shared cache line is touched once per wrap rather than per call.
  */
 template<typename T, size_t Capacity = 1024>
 class LockFreeQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
 public:
-    LockFreeQueue() : head_(0), tail_(0) {
-        buffer_.resize(Capacity);
-    }
+    LockFreeQueue() = default;
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    static constexpr size_t capacity() { return Capacity; }
 
     /**
      * @brief Push item to queue (Producer only)
      * @return true if successful, false if full
      */
     bool push(const T& item) {
-        const size_t current_tail = tail_.load(std::memory_order_relaxed);
-        const size_t next_tail = (current_tail + 1) % Capacity;
-
-        if (next_tail == head_.load(std::memory_order_acquire)) {
-            return false; // Full
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == Capacity) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == Capacity) {
+                return false; // Full
+            }
         }
-
-        buffer_[current_tail] = item;
-        tail_.store(next_tail, std::memory_order_release);
+        buffer_[tail & Mask] = item;
+        tail_.store(tail + 1, std::memory_order_release);
         return true;
     }
 
+    /**
+     * @brief Push as many of items as fit with one index publish (Producer only)
+     * @return Number pushed, from the front of items
+     */
+    size_t try_push_n(const T* items, size_t count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t space = Capacity - (tail - head_cache_);
+        if (space < count) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            space = Capacity - (tail - head_cache_);
+        }
+        const size_t n = std::min(count, space);
+        for (size_t i = 0; i < n; ++i) {
+            buffer_[(tail + i) & Mask] = items[i];
+        }
+        if (n > 0) tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
     /**
      * @brief Pop item from queue (Consumer only)
      * @return true if item retrieved, false if empty
      */
     bool pop(T& item) {
-        const size_t current_head = head_.load(std::memory_order_relaxed);
-
-        if (current_head == tail_.load(std::memory_order_acquire)) {
-            return false; // Empty
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return false; // Empty
+            }
         }
-
-        item = buffer_[current_head];
-        head_.store((current_head + 1) % Capacity, std::memory_order_release);
+        item = buffer_[head & Mask];
+        head_.store(head + 1, std::memory_order_release);
         return true;
     }
 
     /**
-     * @brief Check if queue is empty
+     * @brief Pop up to max items with one index publish (Consumer only)
+     * @return Number popped into out
+     */
+    size_t pop_n(T* out, size_t max) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (tail_cache_ - head < max) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+        }
+        const size_t n = std::min(max, tail_cache_ - head);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = buffer_[(head + i) & Mask];
+        }
+        if (n > 0) head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Check if queue is empty (any thread)
      */
     bool empty() const {
         return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
     }
 
+    /**
+     * @brief Items queued; exact on either endpoint, a snapshot elsewhere
+     */
+    size_t size() const {
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
 private:
-    std::vector<T> buffer_;
-    alignas(64) std::atomic<size_t> head_;
-    alignas(64) std::atomic<size_t> tail_;
+    static constexpr size_t Mask = Capacity - 1;
+
+    // Consumer line: its index and its copy of the producer's
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t tail_cache_ = 0;
+    // Producer line
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t head_cache_ = 0;
+    alignas(64) std::array<T, Capacity> buffer_{};
 };
 
 }
@@ -5,6 +5,11 @@
 #include <fstream>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
 
 namespace orderbook {
 
@@ -12,6 +17,10 @@ class Config;
 
 /**
  * @brief Concrete implementation of structured logging
+ * In async mode (the default) the calling thread only copies a fixed-size record
+ * (timestamp, level, format pointer, raw arguments) into its own lock-free ring; a
+ * background writer formats, writes and rotates. Records are dropped, never waited
+ * on, when a ring is full.
  */
 class Logger : public ILogger {
 public:
@@ -22,6 +31,10 @@ public:
         bool json_format = true;
         size_t max_file_size = 100 * 1024 * 1024; // 100MB
         size_t max_files = 5;
+        // Background writer with per-thread rings; false formats and writes on the caller
+        bool async = true;
+        size_t ring_capacity = 2048;  // records per producer thread
+        uint32_t flush_interval_us = 1000;  // writer sleep when every ring is empty
     };
     
     explicit Logger();
@@ -47,6 +60,13 @@ public:
     void setLogLevel(LogLevel level) override;
 
     bool isLogLevelEnabled(LogLevel level) override;
+    void logFormat(LogLevel level, const char* context, const char* format,
+                   const LogArg* args, size_t count) override;
+
+    // Block until every record queued so far has been written
+    void flush();
+    // Records lost because a producer ring was full
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
     
     // Static convenience methods for global logger
     static void setGlobalLogger(std::shared_ptr<Logger> logger);
@@ -59,21 +79,83 @@ public:
     static LogLevel parseLogLevel(const std::string& level_str);
 
 private:
+    static constexpr size_t MaxRecordArgs = 8;
+    static constexpr size_t RecordSize = 512;
+
+    // One log call, written in place into a ring slot
+    struct LogRecordHeader {
+        int64_t timestamp_ns;        // system_clock since epoch
+        const char* format;          // nullptr: text holds the preformatted message
+        LogLevel level;
+        uint8_t arg_count;
+        uint16_t message_length;     // text[0, message_length)
+        uint16_t context_length;     // text[message_length, + context_length)
+        uint16_t text_used;
+        LogArg args[MaxRecordArgs];  // Str arguments point into text
+    };
+    struct LogRecord : LogRecordHeader {
+        char text[RecordSize - sizeof(LogRecordHeader)];
+        size_t append(const char* data, size_t length);
+    };
+
+    // Single-producer ring owned by one thread, drained by the writer
+    class LogRing {
+    public:
+        explicit LogRing(size_t capacity);
+        LogRecord* claim();
+        void publish() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+        LogRecord* front();
+        void pop() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+        bool empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+    private:
+        std::vector<LogRecord> slots_;
+        size_t mask_;
+        alignas(64) std::atomic<size_t> tail_{0};
+        size_t cached_head_ = 0;
+        alignas(64) std::atomic<size_t> head_{0};
+        size_t cached_tail_ = 0;
+    };
+
     LogConfig config_;
     std::unique_ptr<std::ofstream> file_stream_;
+    // Serialises output and configuration changes
     std::mutex log_mutex_;
     size_t current_file_size_;
+    std::atomic<LogLevel> min_level_{LogLevel::INFO};
+
+    // Async state
+    std::atomic<bool> async_{false};
+    const uint64_t instance_id_;
+    std::mutex rings_mutex_;
+    std::vector<std::unique_ptr<LogRing>> rings_;
+    std::unordered_map<std::thread::id, LogRing*> ring_by_thread_;
+    std::vector<LogRing*> writer_rings_;
+    std::thread writer_;
+    std::atomic<bool> stop_writer_{false};
+    std::atomic<uint64_t> dropped_{0};
+    uint64_t dropped_reported_ = 0;
     
     static std::shared_ptr<Logger> global_logger_;
     static std::mutex global_mutex_;
     
     // Helper methods
+    void openLogFile();
+    void startWriter();
+    void stopWriter();
+    LogRing* threadRing();
+    LogRecord* beginRecord(LogLevel level);
+    void writerLoop();
+    size_t drainRings();
+    void writeRecord(const LogRecord& record);
+    void emit(LogLevel level, const std::string& message, const std::string& context,
+              std::chrono::system_clock::time_point when);
     void writeToFile(const std::string& formatted_message);
     void writeToConsole(const std::string& formatted_message);
     std::string formatMessage(LogLevel level, const std::string& message, 
-                             const std::string& context);
+                             const std::string& context, std::chrono::system_clock::time_point when);
     std::string formatJsonMessage(LogLevel level, const std::string& message, 
-                                 const std::string& context);
+                                 const std::string& context, std::chrono::system_clock::time_point when);
     std::string logLevelToString(LogLevel level);
     void rotateLogFile();
     bool shouldLog(LogLevel level) const;
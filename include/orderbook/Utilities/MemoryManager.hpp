@@ -1,6 +1,7 @@
 #pragma once
 #include "ObjectPool.hpp"
 #include "MemoryAllocators.hpp"
+#include "Arena.hpp"
 #include "../Core/Order.hpp"
 #include <memory>
 #include <atomic>
@@ -53,12 +54,8 @@ public:
      * @return RAII wrapper for pooled order
      */
     ObjectPool<Order>::PooledObject acquireOrder() {
-        auto start = std::chrono::high_resolution_clock::now();
-        auto result = ObjectPools::getOrderPool().acquire();
-        auto end = std::chrono::high_resolution_clock::now();
-        
-        updateAllocationTime(end - start);
-        return result;
+        // Untimed: the pool's fast path is thread-local and shared counters would serialise it
+        return ObjectPools::getOrderPool().acquire();
     }
     
     /**
@@ -66,12 +63,8 @@ public:
      * @return RAII wrapper for pooled trade
      */
     ObjectPool<Trade>::PooledObject acquireTrade() {
-        auto start = std::chrono::high_resolution_clock::now();
-        auto result = ObjectPools::getTradePool().acquire();
-        auto end = std::chrono::high_resolution_clock::now();
-        
-        updateAllocationTime(end - start);
-        return result;
+        // Untimed: the pool's fast path is thread-local and shared counters would serialise it
+        return ObjectPools::getTradePool().acquire();
     }
     
     /**
@@ -92,6 +85,18 @@ public:
         return std::make_unique<PoolAllocator<T, BlockSize>>();
     }
     
+    /**
+     * @brief Create a contiguous arena-backed pool (the allocator behind the Order pool)
+     * @param capacity Number of objects the arena holds
+     * @param options Huge page / NUMA placement for the arena
+     */
+    template<typename T>
+    std::unique_ptr<ArenaPool<T>> createArenaPool(size_t capacity, ArenaOptions options = ArenaOptions()) {
+        auto pool = std::make_unique<ArenaPool<T>>(capacity, options);
+        updateMemoryUsage(pool->arena().size(), true);
+        return pool;
+    }
+    
     /**
      * @brief Allocate SIMD-aligned memory
      * @param size Number of bytes to allocate
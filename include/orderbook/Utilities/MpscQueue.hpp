@@ -0,0 +1,123 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace orderbook {
+
+/**
+ * @brief Bounded lock-free Multi-Producer Single-Consumer queue (Vyukov)
+ * Each cell carries a sequence number: a producer claims a position with one CAS on
+ * the enqueue index and publishes the cell by advancing its sequence, so producers
+ * never wait on each other's writes and the consumer needs no atomic RMW. Per
+ * producer, items come out in push order. Capacity is a power of two.
+ */
+template<typename T, size_t Capacity = 1024>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    /**
+     * @brief Push item to queue (any thread)
+     * @return true if successful, false if full
+     */
+    bool push(const T& item) {
+        return try_push_n(&item, 1) == 1;
+    }
+
+    /**
+     * @brief Claim a run of cells with one CAS and fill them (any thread)
+     * The run is contiguous in the queue, so a batch is not interleaved with other
+     * producers' items.
+     * @return Number pushed, from the front of items (0 if full)
+     */
+    size_t try_push_n(const T* items, size_t count) {
+        if (count == 0) return 0;
+        count = std::min(count, Capacity);
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            intptr_t diff = static_cast<intptr_t>(cells_[pos & Mask].sequence.load(std::memory_order_acquire)) -
+                            static_cast<intptr_t>(pos);
+            if (diff < 0) {
+                return 0; // Full
+            }
+            if (diff > 0) {
+                pos = enqueue_pos_.load(std::memory_order_relaxed); // Claimed by another producer
+                continue;
+            }
+            // The consumer frees cells in order, so if the run's last cell is free all are
+            size_t n = count;
+            while (n > 1 && cells_[(pos + n - 1) & Mask].sequence.load(std::memory_order_acquire) != pos + n - 1) {
+                n /= 2;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                for (size_t i = 0; i < n; ++i) {
+                    Cell& cell = cells_[(pos + i) & Mask];
+                    cell.data = items[i];
+                    cell.sequence.store(pos + i + 1, std::memory_order_release);
+                }
+                return n;
+            }
+        }
+    }
+
+    /**
+     * @brief Pop item from queue (Consumer only)
+     * @return true if item retrieved, false if empty (or the next item is mid-write)
+     */
+    bool pop(T& item) {
+        const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & Mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        item = cell.data;
+        cell.sequence.store(pos + Capacity, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Pop up to max items (Consumer only)
+     * @return Number popped into out
+     */
+    size_t pop_n(T* out, size_t max) {
+        size_t n = 0;
+        while (n < max && pop(out[n])) ++n;
+        return n;
+    }
+
+    /**
+     * @brief Check if queue is empty (any thread; a snapshot)
+     */
+    bool empty() const {
+        const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        return cells_[pos & Mask].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+private:
+    static constexpr size_t Mask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    alignas(64) std::array<Cell, Capacity> cells_;
+};
+
+}
@@ -1,32 +1,53 @@
 #pragma once
-#include <vector>
-#include <memory>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
 #include <mutex>
-#include <atomic>
+#include <new>
 #include <type_traits>
+#include <utility>
+#include <vector>
+#include "Arena.hpp"
 #include "../Core/Order.hpp"
 
 namespace orderbook {
 
+namespace detail {
+// Pool IDs are never reused, so a thread's cache entry for a destroyed pool never matches
+inline uint64_t nextObjectPoolId() {
+    static std::atomic<uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+}
+
 /**
- * @brief Thread-safe object pool for high-performance object reuse
- * Reduces memory allocation overhead by reusing objects
+ * @brief Thread-safe object pool with per-thread magazines over slab-backed storage
+ *
+ * Objects live in Arena slabs carved on demand, so the pool is contiguous and
+ * never touches the heap per object. Each thread keeps two magazines (small
+ * stacks of free slots) and allocates and releases against them with no atomic
+ * read-modify-write. A magazine that empties or fills is swapped with the global
+ * depot, a pair of lock-free stacks of full and empty magazines, so threads only
+ * meet once per MagazineSize operations. A thread's cache is adopted by the next
+ * new thread once it exits. Only slab growth and first use on a thread take a
+ * lock. allocate() value-initialises a T; release() destroys it.
  */
 template<typename T>
 class ObjectPool {
 public:
-    template<typename U>
-    class has_reset {
-        template<typename V, typename = decltype(std::declval<V&>().reset())>
-        static std::true_type test(int);
-        template<typename>
-        static std::false_type test(...);
-    public:
-        static constexpr bool value = decltype(test<U>(0))::value;
-    };
     static_assert(std::is_default_constructible_v<T>, "T must be default constructible");
-    
+
+    // Slots a thread moves to or from the depot at once
+    static constexpr size_t MagazineSize = 32;
+    // Threads with a private cache; later ones share one cache under a mutex
+    static constexpr size_t MaxThreadCaches = 1024;
+    static constexpr size_t MaxSlabs = 4096;
+
     /**
      * @brief RAII wrapper for pooled objects
      * Automatically returns object to pool when destroyed
@@ -34,24 +55,24 @@ public:
     class PooledObject {
     public:
         PooledObject(T* obj, ObjectPool<T>* pool) : object_(obj), pool_(pool) {}
-        
+
         ~PooledObject() {
             if (object_ && pool_) {
-                pool_->returnObject(object_);
+                pool_->release(object_);
             }
         }
-        
+
         // Move semantics only
-        PooledObject(PooledObject&& other) noexcept 
+        PooledObject(PooledObject&& other) noexcept
             : object_(other.object_), pool_(other.pool_) {
             other.object_ = nullptr;
             other.pool_ = nullptr;
         }
-        
+
         PooledObject& operator=(PooledObject&& other) noexcept {
             if (this != &other) {
                 if (object_ && pool_) {
-                    pool_->returnObject(object_);
+                    pool_->release(object_);
                 }
                 object_ = other.object_;
                 pool_ = other.pool_;
@@ -60,138 +81,380 @@ public:
             }
             return *this;
         }
-        
+
         // Delete copy operations
         PooledObject(const PooledObject&) = delete;
         PooledObject& operator=(const PooledObject&) = delete;
-        
+
         T* get() const { return object_; }
         T& operator*() const { return *object_; }
         T* operator->() const { return object_; }
-        
+
         explicit operator bool() const { return object_ != nullptr; }
-        
+
     private:
         T* object_;
         ObjectPool<T>* pool_;
     };
-    
+
     /**
-     * @brief Constructor with initial pool size
-     * @param initial_size Number of objects to pre-allocate
+     * @brief Constructor
+     * @param initial_size Objects per slab; the first slab is mapped up front
+     * @param options Huge page / NUMA placement for every slab
      */
-    explicit ObjectPool(size_t initial_size = 1000) {
-        pool_.reserve(initial_size);
-        for (size_t i = 0; i < initial_size; ++i) {
-            pool_.emplace_back(std::make_unique<T>());
-        }
-        available_count_.store(initial_size);
+    explicit ObjectPool(size_t initial_size = 1000, ArenaOptions options = ArenaOptions())
+        : slab_objects_(std::max(initial_size, MagazineSize)), options_(options),
+          id_(detail::nextObjectPoolId()) {
+        slabs_[0].store(new Slab(slab_objects_, options_), std::memory_order_relaxed);
+        slab_count_.store(1, std::memory_order_release);
     }
-    
+
+    ~ObjectPool() {
+        // Threads may still hold entries for our caches; tell them to drop them
+        for (auto& cache : owned_caches_) cache->pool_dead.store(true, std::memory_order_release);
+        for (auto& block : magazine_blocks_) delete[] block.load(std::memory_order_relaxed);
+        for (auto& slab : slabs_) delete slab.load(std::memory_order_relaxed);
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
     /**
      * @brief Get an object from the pool
      * @return RAII wrapper containing the object
      */
     PooledObject acquire() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (pool_.empty()) {
-            // Pool is empty, create new object
-            auto obj = std::make_unique<T>();
-            T* raw_ptr = obj.release();
-            ++total_created_;
-            return PooledObject(raw_ptr, this);
-        }
-        
-        // Get object from pool
-        auto obj = std::move(pool_.back());
-        pool_.pop_back();
-        available_count_.fetch_sub(1);
-        
-        T* raw_ptr = obj.release();
-        
-        // Reset object if it has a reset method (C++17-compatible detection)
-        if constexpr (has_reset<T>::value) {
-            raw_ptr->reset();
-        }
-        
-        return PooledObject(raw_ptr, this);
+        return PooledObject(allocate(), this);
     }
 
     /**
-     * @brief Allocate an object from the pool and return raw pointer.
-     * Caller is responsible for returning it using release().
+     * @brief Allocate a value-initialised object; return it with release()
      */
     T* allocate() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (pool_.empty()) {
-            auto obj = std::make_unique<T>();
-            T* raw_ptr = obj.release();
-            ++total_created_;
-            if constexpr (has_reset<T>::value) raw_ptr->reset();
-            return raw_ptr;
-        }
-        auto obj = std::move(pool_.back());
-        pool_.pop_back();
-        available_count_.fetch_sub(1);
-        T* raw_ptr = obj.release();
-        if constexpr (has_reset<T>::value) raw_ptr->reset();
-        return raw_ptr;
+        return ::new (allocateRaw()) T();
     }
 
     /**
-     * @brief Release a previously allocated object back to the pool.
-     * @param obj Pointer returned from allocate()
+     * @brief Destroy an object from allocate() and return its slot, from any thread
      */
     void release(T* obj) {
-        // In debug builds, detect double-release which can indicate use-after-free
-#ifndef NDEBUG
-        for (const auto& p : pool_) {
-            if (p.get() == obj) {
-                // Double release detected - assert to help debugging
-                assert(false && "Double release to ObjectPool detected");
-            }
+        if (!obj) return;
+        // Releasing a foreign pointer would hand out memory the pool does not own
+        assert(owns(obj) && "ObjectPool::release of an object from elsewhere");
+        obj->~T();
+        releaseRaw(obj);
+    }
+
+    /**
+     * @brief Uninitialised storage for one T (for a class operator new)
+     */
+    void* allocateRaw() {
+        Cache& cache = localCache();
+        if (cache.shared) {
+            std::lock_guard<std::mutex> lock(shared_cache_mutex_);
+            return take(cache);
+        }
+        return take(cache);
+    }
+
+    void releaseRaw(void* slot) {
+        Cache& cache = localCache();
+        if (cache.shared) {
+            std::lock_guard<std::mutex> lock(shared_cache_mutex_);
+            put(cache, slot);
+            return;
+        }
+        put(cache, slot);
+    }
+
+    /**
+     * @brief True if p points into one of the pool's slabs
+     */
+    bool owns(const void* p) const {
+        size_t count = slab_count_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            if (slabs_[i].load(std::memory_order_acquire)->contains(p)) return true;
         }
-#endif
-        returnObject(obj);
+        return false;
     }
-    
+
     /**
      * @brief Get pool statistics
+     * Lock-free: sums per-thread counters, so concurrent traffic can skew it slightly.
      */
     struct Stats {
-        size_t available;
-        size_t total_created;
-        size_t pool_size;
+        size_t available = 0;        // Slots carved from slabs and not handed out
+        size_t total_created = 0;    // Slots carved from slabs so far
+        size_t pool_size = 0;        // Slab capacity in objects, carved or not
+        size_t in_use = 0;
+        size_t slabs = 0;
+        size_t depot_magazines = 0;  // Full magazines waiting in the depot
+        size_t thread_caches = 0;
     };
-    
+
     Stats getStats() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return {
-            available_count_.load(),
-            total_created_,
-            pool_.size()
-        };
+        Stats stats;
+        uint64_t allocated = 0;
+        uint64_t released = 0;
+        size_t caches = cache_count_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < caches; ++i) {
+            const Cache* cache = caches_[i].load(std::memory_order_acquire);
+            allocated += cache->allocated.load(std::memory_order_relaxed);
+            released += cache->released.load(std::memory_order_relaxed);
+        }
+        stats.total_created = created_.load(std::memory_order_relaxed);
+        stats.in_use = allocated > released ? static_cast<size_t>(allocated - released) : 0;
+        stats.available = stats.total_created > stats.in_use ? stats.total_created - stats.in_use : 0;
+        stats.slabs = slab_count_.load(std::memory_order_acquire);
+        stats.pool_size = stats.slabs * slab_objects_;
+        stats.depot_magazines = full_.size.load(std::memory_order_relaxed);
+        stats.thread_caches = caches;
+        return stats;
     }
-    
+
 private:
-    /**
-     * @brief Return object to pool (called by PooledObject destructor)
-     * @param obj Object to return
-     */
-    void returnObject(T* obj) {
-        if (!obj) return;
+    struct alignas(alignof(T)) Slot {
+        unsigned char storage[sizeof(T)];
+    };
+
+    struct Slab {
+        Slab(size_t objects, const ArenaOptions& options)
+            : arena(objects * sizeof(Slot), options), capacity(objects) {}
+        Slot* slots() const { return static_cast<Slot*>(arena.data()); }
+        bool contains(const void* p) const {
+            auto* bytes = static_cast<const unsigned char*>(p);
+            auto* base = static_cast<const unsigned char*>(arena.data());
+            return bytes >= base && bytes < base + capacity * sizeof(Slot);
+        }
+        Arena arena;
+        size_t capacity;
+        // Bump index; may run past capacity when threads race on a full slab
+        std::atomic<size_t> cursor{0};
+    };
+
+    struct Magazine {
+        std::atomic<uint32_t> next{0};  // Depot link: index + 1 of the next magazine, 0 = none
+        uint32_t index = 0;
+        uint32_t count = 0;
+        void* slots[MagazineSize];
+    };
+    static constexpr size_t MagazinesPerBlock = 64;
+    static constexpr size_t MaxMagazineBlocks = 16384;
+
+    // Treiber stack of magazine indices; the upper half of head is an ABA tag
+    struct alignas(64) Depot {
+        std::atomic<uint64_t> head{0};
+        std::atomic<size_t> size{0};
+    };
+
+    struct alignas(64) Cache {
+        Magazine* loaded = nullptr;
+        Magazine* previous = nullptr;
+        // Owner-written (plain load/store), summed by getStats()
+        std::atomic<uint64_t> allocated{0};
+        std::atomic<uint64_t> released{0};
+        // Set when the owning thread exits; the next new thread may adopt the cache
+        std::atomic<bool> orphaned{false};
+        std::atomic<bool> pool_dead{false};
+        bool shared = false;
+    };
+
+    struct ThreadEntry {
+        uint64_t pool_id;
+        std::shared_ptr<Cache> cache;
+    };
+    struct ThreadCaches {
+        std::vector<ThreadEntry> entries;
+        ~ThreadCaches() {
+            for (auto& entry : entries) entry.cache->orphaned.store(true, std::memory_order_release);
+        }
+    };
+
+    static void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void* take(Cache& cache) {
+        if (cache.loaded->count == 0) reload(cache);
+        bump(cache.allocated);
+        return cache.loaded->slots[--cache.loaded->count];
+    }
+
+    void put(Cache& cache, void* slot) {
+        if (cache.loaded->count == MagazineSize) unload(cache);
+        bump(cache.released);
+        cache.loaded->slots[cache.loaded->count++] = slot;
+    }
+
+    // loaded is empty
+    void reload(Cache& cache) {
+        if (cache.previous->count > 0) {
+            std::swap(cache.loaded, cache.previous);
+            return;
+        }
+        if (Magazine* full = pop(full_)) {
+            push(empty_, cache.loaded);
+            cache.loaded = full;
+            return;
+        }
+        carve(*cache.loaded);
+    }
+
+    // loaded is full
+    void unload(Cache& cache) {
+        if (cache.previous->count == 0) {
+            std::swap(cache.loaded, cache.previous);
+            return;
+        }
+        push(full_, cache.previous);
+        cache.previous = cache.loaded;
+        cache.loaded = pop(empty_);
+        if (!cache.loaded) cache.loaded = newMagazine();
+    }
+
+    // Fill an empty magazine with never-used slots, growing the slab list if needed
+    void carve(Magazine& magazine) {
+        while (magazine.count < MagazineSize) {
+            size_t last = slab_count_.load(std::memory_order_acquire) - 1;
+            Slab* slab = slabs_[last].load(std::memory_order_acquire);
+            size_t want = MagazineSize - magazine.count;
+            size_t start = slab->cursor.fetch_add(want, std::memory_order_relaxed);
+            if (start < slab->capacity) {
+                size_t got = std::min(want, slab->capacity - start);
+                for (size_t i = 0; i < got; ++i) {
+                    magazine.slots[magazine.count++] = &slab->slots()[start + i];
+                }
+                created_.fetch_add(got, std::memory_order_relaxed);
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(grow_mutex_);
+            if (slab_count_.load(std::memory_order_relaxed) == last + 1) {
+                if (last + 1 == MaxSlabs) {
+                    std::fprintf(stderr, "ObjectPool: slab limit (%zu) reached\n", MaxSlabs);
+                    std::abort();
+                }
+                slabs_[last + 1].store(new Slab(slab_objects_, options_), std::memory_order_release);
+                slab_count_.store(last + 2, std::memory_order_release);
+            }
+        }
+    }
 
-        std::lock_guard<std::mutex> lock(mutex_);
-        pool_.emplace_back(obj);
-        available_count_.fetch_add(1);
+    Magazine* magazine(uint32_t index) const {
+        return &magazine_blocks_[index / MagazinesPerBlock].load(std::memory_order_acquire)[index % MagazinesPerBlock];
     }
 
-    
-    mutable std::mutex mutex_;
-    std::vector<std::unique_ptr<T>> pool_;
-    std::atomic<size_t> available_count_{0};
-    size_t total_created_{0};
+    Magazine* newMagazine() {
+        size_t index = magazine_count_.fetch_add(1, std::memory_order_relaxed);
+        size_t block = index / MagazinesPerBlock;
+        if (block >= MaxMagazineBlocks) {
+            std::fprintf(stderr, "ObjectPool: magazine limit reached\n");
+            std::abort();
+        }
+        if (!magazine_blocks_[block].load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(grow_mutex_);
+            if (!magazine_blocks_[block].load(std::memory_order_relaxed)) {
+                auto* magazines = new Magazine[MagazinesPerBlock];
+                for (size_t i = 0; i < MagazinesPerBlock; ++i) {
+                    magazines[i].index = static_cast<uint32_t>(block * MagazinesPerBlock + i);
+                }
+                magazine_blocks_[block].store(magazines, std::memory_order_release);
+            }
+        }
+        return magazine(static_cast<uint32_t>(index));
+    }
+
+    void push(Depot& depot, Magazine* magazine) {
+        uint64_t head = depot.head.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            magazine->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            next = (((head >> 32) + 1) << 32) | (uint64_t(magazine->index) + 1);
+        } while (!depot.head.compare_exchange_weak(head, next, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+        depot.size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Magazine* pop(Depot& depot) {
+        uint64_t head = depot.head.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t top = static_cast<uint32_t>(head);
+            if (top == 0) return nullptr;
+            Magazine* candidate = magazine(top - 1);
+            // A stale link (candidate popped meanwhile) fails the CAS on the tag
+            uint64_t next = (((head >> 32) + 1) << 32) | candidate->next.load(std::memory_order_relaxed);
+            if (depot.head.compare_exchange_weak(head, next, std::memory_order_acquire,
+                                                 std::memory_order_acquire)) {
+                depot.size.fetch_sub(1, std::memory_order_relaxed);
+                return candidate;
+            }
+        }
+    }
+
+    Cache& localCache() {
+        // One slot per T: the last pool this thread used
+        thread_local uint64_t last_id = 0;
+        thread_local Cache* last_cache = nullptr;
+        if (last_id == id_) return *last_cache;
+        last_cache = &findCache();
+        last_id = id_;
+        return *last_cache;
+    }
+
+    Cache& findCache() {
+        thread_local ThreadCaches mine;
+        auto& entries = mine.entries;
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [](const ThreadEntry& entry) {
+            return entry.cache->pool_dead.load(std::memory_order_acquire);
+        }), entries.end());
+        for (auto& entry : entries) {
+            if (entry.pool_id == id_) return *entry.cache;
+        }
+
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        std::shared_ptr<Cache> cache;
+        for (auto& candidate : owned_caches_) {
+            bool orphaned = true;
+            if (!candidate->shared &&
+                candidate->orphaned.compare_exchange_strong(orphaned, false, std::memory_order_acquire)) {
+                cache = candidate;
+                break;
+            }
+        }
+        if (!cache && owned_caches_.size() < MaxThreadCaches) {
+            cache = std::make_shared<Cache>();
+            cache->loaded = newMagazine();
+            cache->previous = newMagazine();
+            if (owned_caches_.size() + 1 == MaxThreadCaches) cache->shared = true;
+            caches_[owned_caches_.size()].store(cache.get(), std::memory_order_release);
+            owned_caches_.push_back(cache);
+            cache_count_.store(owned_caches_.size(), std::memory_order_release);
+        }
+        if (!cache) cache = owned_caches_.back();  // the shared cache
+        entries.push_back({id_, cache});
+        return *cache;
+    }
+
+    const size_t slab_objects_;
+    const ArenaOptions options_;
+    const uint64_t id_;
+
+    std::array<std::atomic<Slab*>, MaxSlabs> slabs_{};
+    std::atomic<size_t> slab_count_{0};
+    std::atomic<size_t> created_{0};
+
+    std::array<std::atomic<Magazine*>, MaxMagazineBlocks> magazine_blocks_{};
+    std::atomic<size_t> magazine_count_{0};
+    Depot full_;
+    Depot empty_;
+
+    // Slab and magazine-block growth (cold)
+    std::mutex grow_mutex_;
+    // First use on a thread (cold)
+    std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<Cache>> owned_caches_;
+    std::array<std::atomic<Cache*>, MaxThreadCaches> caches_{};
+    std::atomic<size_t> cache_count_{0};
+    std::mutex shared_cache_mutex_;
 };
 
 /**
@@ -199,16 +462,18 @@ private:
  */
 class ObjectPools {
 public:
+    // Never destroyed: Order's operator new draws from this pool, and objects may be
+    // freed during static destruction
     static ObjectPool<Order>& getOrderPool() {
-        static ObjectPool<Order> pool(2000); // Pre-allocate 2000 orders
-        return pool;
+        static ObjectPool<Order>* pool = new ObjectPool<Order>(4096);
+        return *pool;
     }
-    
+
     static ObjectPool<Trade>& getTradePool() {
-        static ObjectPool<Trade> pool(1000); // Pre-allocate 1000 trades
-        return pool;
+        static ObjectPool<Trade>* pool = new ObjectPool<Trade>(4096);
+        return *pool;
     }
-    
+
     /**
      * @brief Get statistics for all pools
      */
@@ -216,7 +481,7 @@ public:
         ObjectPool<Order>::Stats order_pool;
         ObjectPool<Trade>::Stats trade_pool;
     };
-    
+
     static AllStats getAllStats() {
         return {
             getOrderPool().getStats(),
@@ -225,4 +490,4 @@ public:
     }
 };
 
-} // namespace orderbook
\ No newline at end of file
+} // namespace orderbook
@@ -1,5 +1,9 @@
 #pragma once
 #include <chrono>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
 #include <vector>
 #include <atomic>
 #include <mutex>
@@ -9,6 +13,7 @@
 #include <numeric>
 #include <thread>
 #include <limits>
+#include "TscClock.hpp"
 
 namespace orderbook {
 
@@ -42,18 +47,92 @@ public:
         size_t avg_memory_usage = 0;
     };
     
+    /**
+     * @brief Dense ID of a registered operation name
+     */
+    using MetricId = uint32_t;
+    static constexpr MetricId MaxMetrics = 128;
+    static constexpr MetricId InvalidMetric = MaxMetrics;
+
+    /**
+     * @brief Fixed-bucket log-linear latency histogram (HDR-style)
+     * Values below 2 * SubBuckets ns are exact; above that each power of two is split
+     * into SubBuckets buckets (~3% relative error) up to 2^MaxMagnitude ns.
+     * Single writer: only the owning thread records, readers load relaxed.
+     */
+    class alignas(64) Histogram {
+    public:
+        static constexpr int SubBucketBits = 5;
+        static constexpr uint64_t SubBuckets = uint64_t(1) << SubBucketBits;
+        static constexpr int MaxMagnitude = 40;
+        static constexpr size_t BucketCount = (MaxMagnitude - SubBucketBits + 1) * SubBuckets;
+
+        static size_t bucketFor(uint64_t value_ns) {
+            if (value_ns < 2 * SubBuckets) {
+                return static_cast<size_t>(value_ns);
+            }
+            int msb = 63 - __builtin_clzll(value_ns);
+            if (msb >= MaxMagnitude) {
+                return BucketCount - 1;
+            }
+            int shift = msb - SubBucketBits;
+            return static_cast<size_t>(shift) * SubBuckets + static_cast<size_t>(value_ns >> shift);
+        }
+
+        // Midpoint of the values that map to a bucket
+        static uint64_t valueFor(size_t bucket) {
+            if (bucket < 2 * SubBuckets) {
+                return bucket;
+            }
+            uint64_t shift = bucket / SubBuckets - 1;
+            uint64_t low = (bucket % SubBuckets + SubBuckets) << shift;
+            return low + ((uint64_t(1) << shift) >> 1);
+        }
+
+        void record(uint64_t value_ns) {
+            bump(counts_[bucketFor(value_ns)], 1);
+            bump(sum_, value_ns);
+            if (value_ns < min_.load(std::memory_order_relaxed)) min_.store(value_ns, std::memory_order_relaxed);
+            if (value_ns > max_.load(std::memory_order_relaxed)) max_.store(value_ns, std::memory_order_relaxed);
+        }
+
+        void clear() {
+            for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+            sum_.store(0, std::memory_order_relaxed);
+            min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+        uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+        uint64_t min() const { return min_.load(std::memory_order_relaxed); }
+        uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+        uint64_t bucket(size_t i) const { return counts_[i].load(std::memory_order_relaxed); }
+
+    private:
+        // Owner-only read-modify-write; plain load/store avoids a locked instruction
+        static void bump(std::atomic<uint64_t>& v, uint64_t by) {
+            v.store(v.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        std::atomic<uint64_t> sum_{0};
+        std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> max_{0};
+        std::array<std::atomic<uint64_t>, BucketCount> counts_{};
+    };
+
     /**
      * @brief RAII timer for measuring operation latency
      */
     class ScopedTimer {
     public:
+        ScopedTimer(MetricId metric, PerformanceMeasurement& perf)
+            : metric_(metric), perf_(perf), start_ticks_(TscClock::now()) {}
+
         ScopedTimer(const std::string& operation_name, PerformanceMeasurement& perf)
-            : operation_name_(operation_name), perf_(perf), start_time_(Clock::now()) {}
+            : ScopedTimer(perf.registerMetric(operation_name), perf) {}
         
         ~ScopedTimer() {
-            auto end_time = Clock::now();
-            auto duration = std::chrono::duration_cast<Duration>(end_time - start_time_);
-            perf_.recordLatency(operation_name_, duration);
+            perf_.recordLatency(metric_, TscClock::elapsed(start_ticks_, TscClock::now()));
         }
         
         // Non-copyable, non-movable
@@ -63,9 +142,9 @@ public:
         ScopedTimer& operator=(ScopedTimer&&) = delete;
         
     private:
-        std::string operation_name_;
+        MetricId metric_;
         PerformanceMeasurement& perf_;
-        TimePoint start_time_;
+        TscClock::Ticks start_ticks_;
     };
     
     /**
@@ -106,6 +185,25 @@ public:
         static PerformanceMeasurement instance;
         return instance;
     }
+
+    /**
+     * @brief Register an operation name (idempotent, takes a lock)
+     * @return Metric ID for recordLatency, or InvalidMetric once MaxMetrics are registered
+     */
+    MetricId registerMetric(std::string_view operation_name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = metric_ids_.find(std::string(operation_name));
+        if (it != metric_ids_.end()) {
+            return it->second;
+        }
+        if (metric_names_.size() >= MaxMetrics) {
+            return InvalidMetric;
+        }
+        MetricId id = static_cast<MetricId>(metric_names_.size());
+        metric_names_.emplace_back(operation_name);
+        metric_ids_.emplace(metric_names_.back(), id);
+        return id;
+    }
     
     /**
      * @brief Create a scoped timer for an operation
@@ -113,191 +211,90 @@ public:
      * @return RAII timer object
      */
     ScopedTimer createTimer(const std::string& operation_name) {
-        return ScopedTimer(operation_name, *this);
+        return ScopedTimer(registerMetric(operation_name), *this);
+    }
+
+    /**
+     * @brief Record latency for a registered metric (lock-free, no allocation after
+     * the calling thread's first sample for the metric)
+     */
+    void recordLatency(MetricId metric, Duration latency) {
+        if (metric >= MaxMetrics) {
+            return;
+        }
+        ThreadStore& store = localStore();
+        uint64_t generation = generation_.load(std::memory_order_relaxed);
+        if (store.generation.load(std::memory_order_relaxed) != generation) {
+            store.clear(generation);
+        }
+        Histogram* histogram = store.histograms[metric].load(std::memory_order_relaxed);
+        if (!histogram) {
+            histogram = store.allocate(metric);
+        }
+        int64_t ns = latency.count();
+        histogram->record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
     }
     
     /**
-     * @brief Record latency for an operation
+     * @brief Record latency for an operation by name (registers it; not for hot paths)
      * @param operation_name Name of the operation
      * @param latency Measured latency
      */
     void recordLatency(const std::string& operation_name, Duration latency) {
-        // Fast-path: store in thread-local store to avoid global locking on hot-path
-        thread_local std::shared_ptr<ThreadSampleStore> tls_store = nullptr;
-        if (!tls_store) {
-            tls_store = std::make_shared<ThreadSampleStore>();
-            std::lock_guard<std::mutex> reg_lock(registry_mutex_);
-            thread_stores_.push_back(tls_store);
-        }
-
-        {
-            std::lock_guard<std::mutex> lock(tls_store->lock);
-            auto& samples = tls_store->samples[operation_name];
-            samples.push_back(latency);
-            // Limit per-thread sample size
-            constexpr size_t MAX_SAMPLES_PER_THREAD = 2000;
-            if (samples.size() > MAX_SAMPLES_PER_THREAD) {
-                samples.erase(samples.begin(), samples.begin() + (samples.size() - MAX_SAMPLES_PER_THREAD));
-            }
-        }
-        
-        // Per-thread stores apply their own size limits above
-        
-        // Update throughput (global) - fast-path without locking if entry exists
-        auto it = throughput_measurements_.find(operation_name);
-        if (it != throughput_measurements_.end()) {
-            it->second.recordOperation();
-        } else {
-            std::lock_guard<std::mutex> lock(mutex_);
-            // double-check under lock and create if needed
-            auto jt = throughput_measurements_.find(operation_name);
-            throughput_measurements_[operation_name].recordOperation();
-        }
+        recordLatency(registerMetric(operation_name), latency);
     }
     
     /**
      * @brief Get statistics for a specific operation
      * @param operation_name Name of the operation
-     * @return Operation statistics
+     * @return Operation statistics, merged across threads
      */
     OperationStats getOperationStats(const std::string& operation_name) const {
-        // Merge samples for this operation from global and per-thread stores
-        std::vector<Duration> samples;
+        MetricId metric = InvalidMetric;
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            auto it = latency_samples_.find(operation_name);
-            if (it != latency_samples_.end()) {
-                samples = it->second;
-            }
-        }
-
-        std::lock_guard<std::mutex> reg_lock(registry_mutex_);
-        for (const auto& store_ptr : thread_stores_) {
-            if (!store_ptr) continue;
-            std::lock_guard<std::mutex> lock(store_ptr->lock);
-            auto it = store_ptr->samples.find(operation_name);
-            if (it != store_ptr->samples.end()) {
-                const auto& tsamp = it->second;
-                samples.insert(samples.end(), tsamp.begin(), tsamp.end());
+            auto it = metric_ids_.find(operation_name);
+            if (it != metric_ids_.end()) {
+                metric = it->second;
             }
         }
-
-        if (samples.empty()) {
+        if (metric == InvalidMetric) {
             return OperationStats{operation_name, 0};
         }
-        OperationStats stats;
-        stats.operation_name = operation_name;
-        stats.sample_count = samples.size();
-        
-        // Calculate basic statistics
-        stats.min_latency = *std::min_element(samples.begin(), samples.end());
-        stats.max_latency = *std::max_element(samples.begin(), samples.end());
-        stats.total_time = std::accumulate(samples.begin(), samples.end(), Duration::zero());
-        stats.avg_latency = Duration(stats.total_time.count() / samples.size());
-        
-        // Calculate percentiles
-        auto sorted_samples = samples;
-        std::sort(sorted_samples.begin(), sorted_samples.end());
-        
-        stats.p50_latency = sorted_samples[samples.size() * 50 / 100];
-        stats.p95_latency = sorted_samples[samples.size() * 95 / 100];
-        stats.p99_latency = sorted_samples[samples.size() * 99 / 100];
-        
-        // Get throughput
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                auto throughput_it = throughput_measurements_.find(operation_name);
-                if (throughput_it != throughput_measurements_.end()) {
-                    stats.throughput_ops_per_sec = throughput_it->second.getCurrentThroughput();
-                }
-            }
-        }
-        
-        return stats;
+
+        std::lock_guard<std::mutex> reg_lock(registry_mutex_);
+        return computeStats(operation_name, metric);
     }
     
     /**
      * @brief Get statistics for all measured operations
-     * @return Map of operation name to statistics
+     * @return Map of operation name to statistics (operations with samples only)
      */
     std::unordered_map<std::string, OperationStats> getAllStats() const {
-        // Merge global and per-thread samples. We avoid holding mutex_ while
-        // reading thread stores to not block recordLatency on hot-path for long.
-        std::unordered_map<std::string, std::vector<Duration>> merged;
-
+        std::vector<std::string> names;
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            for (const auto& [name, samples] : latency_samples_) {
-                merged[name] = samples;
-            }
-        }
-
-        // Merge thread-local stores
-        {
-            std::lock_guard<std::mutex> reg_lock(registry_mutex_);
-            for (const auto& store_ptr : thread_stores_) {
-                if (!store_ptr) continue;
-                std::lock_guard<std::mutex> lock(store_ptr->lock);
-                for (const auto& [name, samples] : store_ptr->samples) {
-                    auto& vec = merged[name];
-                    vec.insert(vec.end(), samples.begin(), samples.end());
-                }
-            }
+            names.assign(metric_names_.begin(), metric_names_.end());
         }
 
         std::unordered_map<std::string, OperationStats> all_stats;
-        for (const auto& [operation_name, samples] : merged) {
-            // compute stats
-            OperationStats stats;
-            stats.operation_name = operation_name;
-            stats.sample_count = samples.size();
-            stats.min_latency = samples.empty() ? Duration::zero() : *std::min_element(samples.begin(), samples.end());
-            stats.max_latency = samples.empty() ? Duration::zero() : *std::max_element(samples.begin(), samples.end());
-            stats.total_time = std::accumulate(samples.begin(), samples.end(), Duration::zero());
-            if (!samples.empty()) stats.avg_latency = Duration(stats.total_time.count() / samples.size());
-
-            auto sorted_samples = samples;
-            std::sort(sorted_samples.begin(), sorted_samples.end());
-            if (!sorted_samples.empty()) {
-                stats.p50_latency = sorted_samples[sorted_samples.size() * 50 / 100];
-                stats.p95_latency = sorted_samples[sorted_samples.size() * 95 / 100];
-                stats.p99_latency = sorted_samples[sorted_samples.size() * 99 / 100];
-            }
-
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                auto throughput_it = throughput_measurements_.find(operation_name);
-                if (throughput_it != throughput_measurements_.end()) {
-                    stats.throughput_ops_per_sec = throughput_it->second.getCurrentThroughput();
-                }
+        std::lock_guard<std::mutex> reg_lock(registry_mutex_);
+        for (MetricId metric = 0; metric < names.size(); ++metric) {
+            OperationStats stats = computeStats(names[metric], metric);
+            if (stats.sample_count > 0) {
+                all_stats.emplace(names[metric], std::move(stats));
             }
-
-            all_stats[operation_name] = stats;
         }
-
         return all_stats;
     }
     
     /**
      * @brief Reset all measurements
+     * Each thread clears its own histograms on its next sample; until then readers skip them.
      */
     void reset() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        latency_samples_.clear();
-        for (auto& [name, throughput] : throughput_measurements_) {
-            throughput.reset();
-        }
-
-        // clear thread stores
-        std::lock_guard<std::mutex> reg_lock(registry_mutex_);
-        for (auto& s : thread_stores_) {
-            if (s) {
-                std::lock_guard<std::mutex> l(s->lock);
-                s->samples.clear();
-            }
-        }
+        start_ns_.store(nowNs(), std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
     }
     
     /**
@@ -356,22 +353,114 @@ private:
         stopMonitoring();
     }
     
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::vector<Duration>> latency_samples_;
-    std::unordered_map<std::string, ThroughputMeasurement> throughput_measurements_;
-
-    // Per-thread fast-path samples. Each thread registers a shared_ptr which
-    // is kept by the measurement registry to allow reading after threads
-    // exit (useful in test harnesses). Access to the registry is protected
-    // by registry_mutex_. Recording goes to thread-local storage with a
-    // light lock in the thread-local structure.
-    struct ThreadSampleStore {
-        std::mutex lock;
-        std::unordered_map<std::string, std::vector<Duration>> samples;
+    // Per-thread histograms, one lazily allocated per metric. Stores are kept by the
+    // registry after their thread exits so its samples stay readable; a store whose
+    // generation lags generation_ holds pre-reset samples and is skipped.
+    struct alignas(64) ThreadStore {
+        std::atomic<uint64_t> generation{0};
+        std::array<std::atomic<Histogram*>, MaxMetrics> histograms{};
+
+        ~ThreadStore() {
+            for (auto& h : histograms) delete h.load(std::memory_order_relaxed);
+        }
+
+        Histogram* allocate(MetricId metric) {
+            Histogram* histogram = new Histogram();
+            histograms[metric].store(histogram, std::memory_order_release);
+            return histogram;
+        }
+
+        void clear(uint64_t new_generation) {
+            for (auto& h : histograms) {
+                if (Histogram* histogram = h.load(std::memory_order_relaxed)) histogram->clear();
+            }
+            generation.store(new_generation, std::memory_order_release);
+        }
     };
 
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<Duration>(Clock::now().time_since_epoch()).count();
+    }
+
+    ThreadStore& localStore() {
+        thread_local ThreadStore* store = nullptr;
+        if (!store) {
+            auto owned = std::make_unique<ThreadStore>();
+            owned->generation.store(generation_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            store = owned.get();
+            std::lock_guard<std::mutex> reg_lock(registry_mutex_);
+            thread_stores_.push_back(std::move(owned));
+        }
+        return *store;
+    }
+
+    // Merge every current-generation thread histogram for one metric; registry_mutex_ held
+    OperationStats computeStats(const std::string& operation_name, MetricId metric) const {
+        OperationStats stats;
+        stats.operation_name = operation_name;
+
+        uint64_t generation = generation_.load(std::memory_order_acquire);
+        std::vector<uint64_t> buckets(Histogram::BucketCount, 0);
+        uint64_t total = 0;
+        uint64_t sum = 0;
+        uint64_t min_ns = std::numeric_limits<uint64_t>::max();
+        uint64_t max_ns = 0;
+        for (const auto& store : thread_stores_) {
+            if (store->generation.load(std::memory_order_acquire) != generation) continue;
+            const Histogram* histogram = store->histograms[metric].load(std::memory_order_acquire);
+            if (!histogram) continue;
+            for (size_t i = 0; i < Histogram::BucketCount; ++i) {
+                uint64_t c = histogram->bucket(i);
+                buckets[i] += c;
+                total += c;
+            }
+            sum += histogram->sum();
+            min_ns = std::min(min_ns, histogram->min());
+            max_ns = std::max(max_ns, histogram->max());
+        }
+        if (total == 0) {
+            return stats;
+        }
+
+        stats.sample_count = total;
+        stats.min_latency = Duration(min_ns);
+        stats.max_latency = Duration(max_ns);
+        stats.total_time = Duration(sum);
+        stats.avg_latency = Duration(sum / total);
+
+        auto percentile = [&](uint64_t pct) {
+            uint64_t rank = total * pct / 100;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < Histogram::BucketCount; ++i) {
+                seen += buckets[i];
+                if (seen > rank) {
+                    return Duration(std::clamp(Histogram::valueFor(i), min_ns, max_ns));
+                }
+            }
+            return Duration(max_ns);
+        };
+        stats.p50_latency = percentile(50);
+        stats.p95_latency = percentile(95);
+        stats.p99_latency = percentile(99);
+
+        int64_t elapsed_ns = nowNs() - start_ns_.load(std::memory_order_relaxed);
+        if (elapsed_ns > 0) {
+            stats.throughput_ops_per_sec = total * 1e9 / static_cast<double>(elapsed_ns);
+        }
+        return stats;
+    }
+
+    // Metric registry (cold path); names are never removed so IDs stay valid
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, MetricId> metric_ids_;
+    std::vector<std::string> metric_names_;
+
     mutable std::mutex registry_mutex_;
-    std::vector<std::shared_ptr<ThreadSampleStore>> thread_stores_;
+    std::vector<std::unique_ptr<ThreadStore>> thread_stores_;
+
+    // Bumped by reset(); throughput is measured from start_ns_
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<int64_t> start_ns_{nowNs()};
     
     // Continuous monitoring
     std::atomic<bool> monitoring_active_{false};
@@ -498,11 +587,19 @@ public:
 #define CONCAT_INTERNAL(x, y) x ## y
 #define CONCAT(x, y) CONCAT_INTERNAL(x, y)
 
-#define PERF_MEASURE(operation_name) \
-    auto CONCAT(_perf_measure_timer_, __LINE__) = orderbook::PerformanceMeasurement::getInstance().createTimer(operation_name)
-
+// The name is registered once per call site; each pass only reads the TSC and bumps
+// the calling thread's histogram. operation_name must be constant for the call site.
+// Compiled in only with ORDERBOOK_PERF_MEASURE (the RelWithInstrumentation build).
+#ifdef ORDERBOOK_PERF_MEASURE
 #define PERF_MEASURE_SCOPE(operation_name) \
-    orderbook::PerformanceMeasurement::ScopedTimer CONCAT(_perf_measure_timer_, __LINE__)(operation_name, \
-        orderbook::PerformanceMeasurement::getInstance())
+    static const orderbook::PerformanceMeasurement::MetricId CONCAT(_perf_metric_id_, __LINE__) = \
+        orderbook::PerformanceMeasurement::getInstance().registerMetric(operation_name); \
+    orderbook::PerformanceMeasurement::ScopedTimer CONCAT(_perf_measure_timer_, __LINE__)( \
+        CONCAT(_perf_metric_id_, __LINE__), orderbook::PerformanceMeasurement::getInstance())
+#else
+#define PERF_MEASURE_SCOPE(operation_name) ((void)0)
+#endif
+
+#define PERF_MEASURE(operation_name) PERF_MEASURE_SCOPE(operation_name)
 
 } // namespace orderbook
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 #include "PerformanceMeasurement.hpp"
 #include "MemoryManager.hpp"
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <chrono>
 
 namespace orderbook {
 
+class OrderBook;
+
 /**
  * @brief Comprehensive performance testing suite
  */
@@ -19,8 +23,8 @@ public:
         size_t num_orders = 1000000;
         size_t num_threads = 1;
         double buy_sell_ratio = 0.5;
-        Price min_price = 100.0;
-        Price max_price = 200.0;
+        double min_price = 100.0;  // decimal; converted with the book's PriceScale
+        double max_price = 200.0;
         Quantity min_quantity = 100;
         Quantity max_quantity = 1000;
         bool enable_risk_management = true;
@@ -41,6 +45,46 @@ public:
         bool all_validations_passed = true;
     };
     
+    /**
+     * @brief Open-loop load: requests are scheduled on a clock, not sent on completion
+     */
+    struct OpenLoopConfig {
+        double rate = 100000.0;          // Requests per second
+        bool poisson = false;            // Exponential inter-arrival gaps instead of a fixed period
+        double duration_seconds = 10.0;
+        // Request mix; whatever cancel and modify leave over is adds
+        double cancel_ratio = 0.35;
+        double modify_ratio = 0.10;
+        double mid_price = 150.0;        // decimal; converted with the book's PriceScale
+        double price_sigma_ticks = 20.0; // Passive distance from mid, |N(0, sigma)| ticks
+        double marketable_ratio = 0.05;  // Adds priced through mid so they trade
+        double mid_drift_ratio = 0.01;   // Chance per request that mid moves one tick
+        Quantity min_quantity = 100;
+        Quantity max_quantity = 1000;
+        bool enable_risk_management = false;
+        bool enable_market_data = true;
+        std::string symbol = "AAPL";
+        uint64_t seed = 12345;
+    };
+
+    /**
+     * @brief Latency of each request from its intended send time to the consumer
+     * having applied it (trades and reports published), so stalls are not hidden
+     */
+    struct OpenLoopResults {
+        PerformanceMeasurement::Histogram latency;
+        uint64_t scheduled = 0;
+        uint64_t acknowledged = 0;
+        uint64_t refused = 0;            // Rejected at submission (risk, backpressure)
+        uint64_t late_sends = 0;         // Sent more than 1 µs after their intended time
+        uint64_t max_send_lag_ns = 0;
+        uint64_t adds = 0;
+        uint64_t cancels = 0;
+        uint64_t modifies = 0;
+        uint64_t trades = 0;
+        double elapsed_seconds = 0.0;
+    };
+
     /**
      * @brief Run comprehensive performance test
      * @param config Test configuration
@@ -61,14 +105,18 @@ public:
     static void runLatencyBenchmark();
     
     /**
-     * @brief Run throughput stress test
+     * @brief Run throughput stress test: open-loop load at target_ops_per_sec
      */
     static void runThroughputStressTest(size_t target_ops_per_sec = 500000, 
                                        int duration_seconds = 10);
 
+    /**
+     * @brief Drive a book with open-loop load and measure coordinated-omission-free latency
+     */
+    static std::unique_ptr<OpenLoopResults> runOpenLoopTest(const OpenLoopConfig& config);
+    static void printOpenLoopResults(const OpenLoopConfig& config, const OpenLoopResults& results);
+
 private:
-    class OrderBook; // Forward declaration
-    
     static TestResults runSingleThreadedTest(OrderBook& order_book, const TestConfig& config);
     static TestResults runMultiThreadedTest(OrderBook& order_book, const TestConfig& config);
 };
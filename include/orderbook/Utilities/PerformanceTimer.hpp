@@ -2,6 +2,8 @@
 #include <chrono>
 #include <string>
 #include <memory>
+#include <vector>
+#include "TscClock.hpp"
 
 namespace orderbook {
 
@@ -28,7 +30,7 @@ public:
 private:
     std::string operation_name_;
     std::shared_ptr<ILogger> logger_;
-    std::chrono::high_resolution_clock::time_point start_time_;
+    TscClock::Ticks start_ticks_;
     std::vector<std::pair<std::string, std::string>> additional_metrics_;
     bool logged_;
 };
@@ -55,12 +57,18 @@ private:
     uint64_t sample_count_ = 0;
 };
 
-// Convenience macro for timing operations
+// Convenience macros for timing operations; like PERF_MEASURE_SCOPE they compile to
+// nothing unless ORDERBOOK_PERF_MEASURE is defined
+#ifdef ORDERBOOK_PERF_MEASURE
 #define PERF_TIMER(operation_name, logger) \
     PerformanceTimer _perf_timer(operation_name, logger)
 
 #define PERF_TIMER_WITH_METRICS(operation_name, logger, ...) \
     PerformanceTimer _perf_timer(operation_name, logger); \
     do { __VA_ARGS__ } while(0)
+#else
+#define PERF_TIMER(operation_name, logger) ((void)0)
+#define PERF_TIMER_WITH_METRICS(operation_name, logger, ...) ((void)0)
+#endif
 
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include "WaitStrategy.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace orderbook {
+
+/**
+ * @brief Single-writer sequence lock over a trivially copyable value
+ *
+ * The writer never waits; readers copy the value and retry if a write overlapped.
+ * The payload is stored as relaxed atomic words between the sequence updates, so the
+ * copy is race-free under the C++ memory model (and TSan) without any lock.
+ */
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock payload must be trivially copyable");
+
+public:
+    SeqLock() { store(T{}); }
+
+    /**
+     * @brief Publish a new value (one writer thread only)
+     */
+    void store(const T& value) {
+        uint64_t buffer[Words] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < Words; ++i) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the value unless a write is in progress or overlapped the copy
+     */
+    bool tryLoad(T& out) const {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+
+        uint64_t buffer[Words];
+        for (size_t i = 0; i < Words; ++i) {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) return false;
+
+        std::memcpy(&out, buffer, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Consistent copy of the value, spinning past concurrent writes
+     */
+    T load() const {
+        T out;
+        while (!tryLoad(out)) {
+            cpuRelax();
+        }
+        return out;
+    }
+
+    /**
+     * @brief Number of completed stores (changes whenever the value is republished)
+     */
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t Words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    alignas(64) std::array<std::atomic<uint64_t>, Words> words_{};
+};
+
+}
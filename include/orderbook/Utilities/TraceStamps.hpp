@@ -0,0 +1,73 @@
+#pragma once
+#include "TscClock.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace orderbook {
+
+/**
+ * @brief Points in the order pipeline where a sampled order is stamped, in order
+ */
+enum class TraceStage : uint8_t {
+    FixReceive,   // FixSession::processMessage entry
+    FixHandler,   // FixMessageHandler picked the order up (after any strand hop)
+    Enqueue,      // OrderBook submission, before the pre-trade check and ring push
+    Dequeue,      // Consumer took the request off the ring
+    Matched,      // First fill decided by the matcher
+    Published     // First trade published, or the request fully applied when nothing traded
+};
+constexpr size_t TraceStageCount = static_cast<size_t>(TraceStage::Published) + 1;
+
+/**
+ * @brief Fixed-size stamps for stages [0, Stages) of one sampled order
+ * Stamps are 32-bit tick offsets from the first one (saturating), so the full set is
+ * 32 bytes and the producer-side prefix carried in a ring request is 24. An
+ * unsampled order has origin 0 and every stamp() is a single branch.
+ */
+template <size_t Stages>
+struct BasicTraceStamps {
+    TscClock::Ticks origin = 0;
+    // Ticks after origin plus one per stage; 0 = not reached
+    std::array<uint32_t, Stages> at{};
+
+    bool sampled() const { return origin != 0; }
+    bool reached(TraceStage stage) const {
+        size_t i = static_cast<size_t>(stage);
+        return i < Stages && at[i] != 0;
+    }
+    void clear() { origin = 0; }
+
+    void start(TraceStage stage, TscClock::Ticks now) {
+        origin = now ? now : 1;
+        at.fill(0);
+        at[static_cast<size_t>(stage)] = 1;
+    }
+
+    void stamp(TraceStage stage, TscClock::Ticks now) {
+        size_t i = static_cast<size_t>(stage);
+        if (!sampled() || i >= Stages) return;
+        uint64_t offset = now > origin ? now - origin : 0;
+        at[i] = offset >= UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(offset + 1);
+    }
+    void stamp(TraceStage stage) {
+        if (sampled()) stamp(stage, TscClock::now());
+    }
+    // Keeps the first stamp of a stage that can happen repeatedly (one per fill)
+    void stampOnce(TraceStage stage) {
+        if (sampled() && !reached(stage)) stamp(stage, TscClock::now());
+    }
+
+    template <size_t Other>
+    void copyFrom(const BasicTraceStamps<Other>& other) {
+        origin = other.origin;
+        for (size_t i = 0; i < Stages; ++i) at[i] = i < Other ? other.at[i] : 0;
+    }
+};
+
+// Everything an Order or a parsed FIX message carries
+using TraceStamps = BasicTraceStamps<TraceStageCount>;
+// The stages before the ring, carried in an OrderBook request
+using RequestTraceStamps = BasicTraceStamps<static_cast<size_t>(TraceStage::Enqueue) + 1>;
+
+} // namespace orderbook
@@ -0,0 +1,111 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace orderbook {
+
+/**
+ * @brief Cycle-counter clock for internal sequencing and latency stamps
+ *
+ * now() reads the invariant TSC on x86 and the virtual counter on AArch64 (plain
+ * steady_clock nanoseconds elsewhere), so a stamp costs a register read instead of a
+ * clock_gettime call. Ticks are only comparable within one process; convert with
+ * toNanos() for durations and toWallClock() when exporting (FIX TransactTime, market
+ * data). Calibration runs once, on first conversion or an explicit calibrate().
+ */
+class TscClock {
+public:
+    using Ticks = uint64_t;
+
+    static Ticks now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<Ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Measure the tick rate and anchor ticks to wall time (idempotent)
+     * Call at startup so the first exported timestamp does not pay for it.
+     */
+    static void calibrate() { (void)calibration(); }
+
+    static double ticksPerNs() { return calibration().ticks_per_ns; }
+
+    /**
+     * @brief Convert a tick interval to nanoseconds
+     */
+    static uint64_t toNanos(Ticks ticks) {
+        return static_cast<uint64_t>(static_cast<double>(ticks) * calibration().ns_per_tick);
+    }
+
+    static std::chrono::nanoseconds elapsed(Ticks start, Ticks end) {
+        return std::chrono::nanoseconds(end > start ? toNanos(end - start) : 0);
+    }
+
+    /**
+     * @brief Wall-clock time of a stamp (accurate to the calibration, drifts with uptime)
+     */
+    static std::chrono::system_clock::time_point toWallClock(Ticks ticks) {
+        const Calibration& cal = calibration();
+        double offset_ns = (static_cast<double>(ticks) - static_cast<double>(cal.anchor_ticks)) * cal.ns_per_tick;
+        return cal.anchor_wall + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(static_cast<int64_t>(offset_ns)));
+    }
+
+    static int64_t toWallNanos(Ticks ticks) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            toWallClock(ticks).time_since_epoch()).count();
+    }
+
+private:
+    struct Calibration {
+        double ticks_per_ns = 1.0;
+        double ns_per_tick = 1.0;
+        Ticks anchor_ticks = 0;
+        std::chrono::system_clock::time_point anchor_wall;
+    };
+
+    static const Calibration& calibration() {
+        static const Calibration cal = measure();
+        return cal;
+    }
+
+    static Calibration measure() {
+        Calibration cal;
+#if defined(__aarch64__)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        cal.ticks_per_ns = static_cast<double>(frequency) / 1e9;
+#elif defined(__x86_64__) || defined(__i386__)
+        // Count ticks over a short steady_clock window
+        constexpr auto window = std::chrono::milliseconds(10);
+        auto steady_start = std::chrono::steady_clock::now();
+        Ticks tick_start = now();
+        std::this_thread::sleep_for(window);
+        auto steady_end = std::chrono::steady_clock::now();
+        Ticks tick_end = now();
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            steady_end - steady_start).count());
+        if (ns > 0 && tick_end > tick_start) {
+            cal.ticks_per_ns = static_cast<double>(tick_end - tick_start) / ns;
+        }
+#endif
+        cal.ns_per_tick = 1.0 / cal.ticks_per_ns;
+        cal.anchor_wall = std::chrono::system_clock::now();
+        cal.anchor_ticks = now();
+        return cal;
+    }
+};
+
+}
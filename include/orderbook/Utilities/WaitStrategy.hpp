@@ -0,0 +1,201 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace orderbook {
+
+/**
+ * @brief How a consumer thread waits for work
+ */
+enum class WaitStrategy : uint8_t {
+    BusySpin,   // Spin with a CPU pause hint; never sleeps (dedicate a core)
+    SpinYield,  // Spin spin_iterations times, then yield the CPU between checks
+    SpinPark,   // Spin spin_iterations times, then park on a condition variable
+    Block       // Park immediately (lowest CPU use, highest wakeup latency)
+};
+
+/**
+ * @brief Consumer wait configuration
+ */
+struct WaitOptions {
+    WaitStrategy strategy = WaitStrategy::SpinPark;
+    // Empty polls before yielding or parking
+    uint32_t spin_iterations = 20000;
+    // Pin the consumer thread to this CPU (-1 leaves placement to the scheduler)
+    int cpu_affinity = -1;
+};
+
+/**
+ * @brief Parse a strategy name from configuration (busy_spin, spin_yield, spin_park, block)
+ */
+inline std::optional<WaitStrategy> parseWaitStrategy(const std::string& name) {
+    if (name == "busy_spin") return WaitStrategy::BusySpin;
+    if (name == "spin_yield") return WaitStrategy::SpinYield;
+    if (name == "spin_park") return WaitStrategy::SpinPark;
+    if (name == "block") return WaitStrategy::Block;
+    return std::nullopt;
+}
+
+/**
+ * @brief CPU hint for spin-wait loops
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @brief Pin the calling thread to one CPU
+ * @return false if unsupported on this platform or the call failed
+ */
+inline bool pinCurrentThreadToCpu(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/**
+ * @brief Single-consumer wakeup primitive for the configured WaitStrategy
+ * Producers call signal() after publishing work; it only touches the mutex and
+ * condition variable when the consumer is actually parked. The consumer loops on
+ * wait(), which returns true when work was signalled and false once stopped.
+ */
+class ConsumerWaiter {
+public:
+    explicit ConsumerWaiter(WaitOptions options = WaitOptions()) : options_(options) {}
+
+    void setOptions(const WaitOptions& options) { options_ = options; }
+    const WaitOptions& options() const { return options_; }
+
+    /**
+     * @brief Producer side: announce new work
+     */
+    void signal() {
+        pending_.store(true, std::memory_order_release);
+        // Pairs with the fence in park(): either we see parked_ or the consumer sees pending_
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Consumer side: wait for work according to the strategy
+     * @return true if work was signalled, false if stopped with nothing pending
+     */
+    bool wait() { return waitImpl(nullptr); }
+
+    /**
+     * @brief wait() that also returns true once deadline passes, for timed consumer work
+     */
+    bool waitUntil(std::chrono::steady_clock::time_point deadline) { return waitImpl(&deadline); }
+
+    /**
+     * @brief Release the consumer; wait() returns false once pending work is taken
+     */
+    void stop() {
+        stopped_.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+
+    bool isStopped() const { return stopped_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Owner side: whether a consumer thread is looping on this waiter
+     * Set before the thread starts and cleared after it is joined, so a requester can
+     * tell a slow consumer from none at all.
+     */
+    void setConsumerRunning(bool running) { consumer_running_.store(running, std::memory_order_release); }
+    bool isConsumerRunning() const { return consumer_running_.load(std::memory_order_acquire); }
+
+private:
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    bool waitImpl(const Deadline* deadline) {
+        uint32_t spins = 0;
+        while (true) {
+            if (pending_.exchange(false, std::memory_order_acq_rel)) return true;
+            if (stopped_.load(std::memory_order_acquire)) {
+                return pending_.exchange(false, std::memory_order_acq_rel);
+            }
+            if (deadline && std::chrono::steady_clock::now() >= *deadline) return true;
+
+            switch (options_.strategy) {
+                case WaitStrategy::BusySpin:
+                    cpuRelax();
+                    break;
+                case WaitStrategy::SpinYield:
+                    if (spins < options_.spin_iterations) {
+                        ++spins;
+                        cpuRelax();
+                    } else {
+                        std::this_thread::yield();
+                    }
+                    break;
+                case WaitStrategy::SpinPark:
+                    if (spins < options_.spin_iterations) {
+                        ++spins;
+                        cpuRelax();
+                    } else {
+                        park(deadline);
+                        spins = 0;
+                    }
+                    break;
+                case WaitStrategy::Block:
+                    park(deadline);
+                    break;
+            }
+        }
+    }
+
+    void park(const Deadline* deadline) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        parked_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto ready = [this] {
+            return pending_.load(std::memory_order_acquire) || stopped_.load(std::memory_order_acquire);
+        };
+        if (deadline) {
+            cv_.wait_until(lock, *deadline, ready);
+        } else {
+            cv_.wait(lock, ready);
+        }
+        parked_.store(false, std::memory_order_relaxed);
+    }
+
+    WaitOptions options_;
+    // Producer-written flag on its own cache line, away from the consumer-only state
+    alignas(64) std::atomic<bool> pending_{false};
+    alignas(64) std::atomic<bool> parked_{false};
+    std::atomic<bool> stopped_{false};
+    std::atomic<bool> consumer_running_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}
@@ -0,0 +1,35 @@
+#!/usr/bin/env bash
+# Profile-guided Release build trained on captured traffic.
+#
+#   scripts/pgo-train.sh --journal journal
+#   scripts/pgo-train.sh --fix logs/orders.log --md logs/marketdata.log
+#
+# Arguments are OrderBookReplayBench inputs. The instrumented and final builds share
+# build/pgo (GCC keys profiles by object path); the result is build/pgo/OrderBook.
+set -euo pipefail
+
+if [[ $# -eq 0 ]]; then
+  echo "Usage: $0 <OrderBookReplayBench inputs, e.g. --journal DIR or --fix FILE>" >&2
+  exit 1
+fi
+
+root="$(cd "$(dirname "$0")/.." && pwd)"
+profile_dir="$root/build/pgo-profile"
+cd "$root"
+
+rm -rf "$profile_dir"
+cmake --preset pgo-generate
+cmake --build --preset pgo-generate --target OrderBookReplayBench -j
+
+# Train both level stores so either ladder_mode setting gets a profile
+"$root/build/pgo/OrderBookReplayBench" "$@" --repeat 3
+"$root/build/pgo/OrderBookReplayBench" "$@" --repeat 3 --ladder
+
+# Clang writes raw profiles that must be merged; GCC reads its .gcda files directly
+if ls "$profile_dir"/*.profraw >/dev/null 2>&1; then
+  llvm-profdata merge -output="$profile_dir/merged.profdata" "$profile_dir"/*.profraw
+fi
+
+cmake --preset pgo-use
+cmake --build --preset pgo-use -j
+echo "PGO build ready in build/pgo"
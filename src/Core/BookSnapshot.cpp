@@ -0,0 +1,213 @@
+#include "orderbook/Core/BookSnapshot.hpp"
+#include "orderbook/Core/InternTable.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace orderbook {
+
+namespace {
+
+// File layout: SnapshotHeader, levels[], orders[], name table; all 8-byte aligned
+constexpr char SnapshotMagic[8] = {'O', 'B', 'S', 'N', 'A', 'P', '\0', '\1'};
+constexpr uint32_t SnapshotVersion = 1;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_bytes;
+    BookSnapshotInfo info;
+    uint64_t levels_offset;
+    uint64_t orders_offset;
+    uint64_t names_offset;
+    uint64_t names_bytes;
+    uint64_t file_bytes;
+    uint64_t checksum;  // over everything after the header
+    uint8_t reserved[24];
+};
+static_assert(sizeof(SnapshotHeader) == 128, "snapshot header layout");
+
+enum NameKind : uint8_t { SymbolName = 1, AccountName = 2 };
+
+struct NameEntry {
+    uint8_t kind;
+    uint8_t reserved;
+    uint16_t length;
+    uint32_t id;
+    // followed by length bytes, padded to 8
+};
+
+constexpr size_t align8(size_t bytes) { return (bytes + 7) & ~size_t(7); }
+
+uint64_t bodyChecksum(const unsigned char* data, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ull ^ length;
+    for (size_t off = 0; off < length; off += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + off, 8);
+        hash = (hash ^ word) * 0x100000001B3ull;
+        hash ^= hash >> 31;
+    }
+    return hash;
+}
+
+void appendName(std::vector<unsigned char>& table, uint8_t kind, uint32_t id, const char* name) {
+    size_t length = std::min<size_t>(std::strlen(name), 0xFFFF);
+    NameEntry entry{kind, 0, static_cast<uint16_t>(length), id};
+    size_t at = table.size();
+    table.resize(at + align8(sizeof(entry) + length), 0);
+    std::memcpy(table.data() + at, &entry, sizeof(entry));
+    std::memcpy(table.data() + at + sizeof(entry), name, length);
+}
+
+bool writeAll(int fd, const void* data, size_t length) {
+    auto* p = static_cast<const unsigned char*>(data);
+    while (length > 0) {
+        ssize_t n = ::write(fd, p, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+}
+
+Result<size_t> writeBookSnapshot(const std::string& path, const BookImage& image) {
+    // Name every symbol and account the orders reference, in the writer's IDs
+    std::vector<unsigned char> names;
+    std::vector<bool> symbol_seen;
+    std::vector<bool> account_seen;
+    for (const SnapshotOrder& order : image.orders) {
+        if (order.symbol_id >= symbol_seen.size()) symbol_seen.resize(order.symbol_id + 1, false);
+        if (!symbol_seen[order.symbol_id]) {
+            symbol_seen[order.symbol_id] = true;
+            appendName(names, SymbolName, order.symbol_id, symbolTable().name(order.symbol_id));
+        }
+        if (order.account_id >= account_seen.size()) account_seen.resize(order.account_id + 1, false);
+        if (!account_seen[order.account_id]) {
+            account_seen[order.account_id] = true;
+            appendName(names, AccountName, order.account_id, accountTable().name(order.account_id));
+        }
+    }
+
+    size_t levels_bytes = image.levels.size() * sizeof(SnapshotLevel);
+    size_t orders_bytes = image.orders.size() * sizeof(SnapshotOrder);
+    std::vector<unsigned char> body(levels_bytes + orders_bytes + names.size());
+    if (levels_bytes) std::memcpy(body.data(), image.levels.data(), levels_bytes);
+    if (orders_bytes) std::memcpy(body.data() + levels_bytes, image.orders.data(), orders_bytes);
+    if (!names.empty()) std::memcpy(body.data() + levels_bytes + orders_bytes, names.data(), names.size());
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header.version = SnapshotVersion;
+    header.header_bytes = sizeof(SnapshotHeader);
+    header.info = image.info;
+    header.info.level_count = image.levels.size();
+    header.info.order_count = image.orders.size();
+    header.levels_offset = sizeof(SnapshotHeader);
+    header.orders_offset = header.levels_offset + levels_bytes;
+    header.names_offset = header.orders_offset + orders_bytes;
+    header.names_bytes = names.size();
+    header.file_bytes = sizeof(SnapshotHeader) + body.size();
+    header.checksum = bodyChecksum(body.data(), body.size());
+
+    std::string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return Result<size_t>::error("Cannot create " + temp + ": " + std::strerror(errno));
+    }
+    bool ok = writeAll(fd, &header, sizeof(header)) && writeAll(fd, body.data(), body.size()) && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok || ::rename(temp.c_str(), path.c_str()) != 0) {
+        std::string reason = std::strerror(errno);
+        ::unlink(temp.c_str());
+        return Result<size_t>::error("Cannot write snapshot " + path + ": " + reason);
+    }
+    // Make the rename itself durable
+    std::string directory = path.find('/') == std::string::npos ? "." : path.substr(0, path.rfind('/'));
+    int dir_fd = ::open(directory.empty() ? "/" : directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dir_fd >= 0) {
+        ::fsync(dir_fd);
+        ::close(dir_fd);
+    }
+    return Result<size_t>::success(static_cast<size_t>(header.file_bytes));
+}
+
+Result<std::unique_ptr<MappedBookSnapshot>> MappedBookSnapshot::open(const std::string& path) {
+    using SnapshotResult = Result<std::unique_ptr<MappedBookSnapshot>>;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return SnapshotResult::error("Cannot open snapshot " + path + ": " + std::strerror(errno));
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return SnapshotResult::error("Snapshot " + path + " is truncated");
+    }
+    void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return SnapshotResult::error("Cannot map snapshot " + path + ": " + std::strerror(errno));
+    }
+
+    std::unique_ptr<MappedBookSnapshot> snapshot(new MappedBookSnapshot());
+    snapshot->data_ = p;
+    snapshot->size_ = static_cast<size_t>(st.st_size);
+    auto* base = static_cast<const unsigned char*>(p);
+
+    SnapshotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0) {
+        return SnapshotResult::error(path + " is not a book snapshot");
+    }
+    if (header.version != SnapshotVersion || header.header_bytes != sizeof(SnapshotHeader)) {
+        return SnapshotResult::error(path + ": unsupported snapshot version " + std::to_string(header.version));
+    }
+    const BookSnapshotInfo& info = header.info;
+    if (header.file_bytes != snapshot->size_ ||
+        header.levels_offset != sizeof(SnapshotHeader) ||
+        header.orders_offset != header.levels_offset + info.level_count * sizeof(SnapshotLevel) ||
+        header.names_offset != header.orders_offset + info.order_count * sizeof(SnapshotOrder) ||
+        header.names_offset + header.names_bytes != header.file_bytes) {
+        return SnapshotResult::error(path + ": inconsistent snapshot layout");
+    }
+    if (bodyChecksum(base + sizeof(SnapshotHeader), snapshot->size_ - sizeof(SnapshotHeader)) != header.checksum) {
+        return SnapshotResult::error(path + ": snapshot checksum mismatch");
+    }
+
+    snapshot->info_ = info;
+    snapshot->levels_ = reinterpret_cast<const SnapshotLevel*>(base + header.levels_offset);
+    snapshot->orders_ = reinterpret_cast<const SnapshotOrder*>(base + header.orders_offset);
+    for (size_t i = 0; i < info.level_count; ++i) {
+        const SnapshotLevel& level = snapshot->levels_[i];
+        if (static_cast<uint64_t>(level.first_order) + level.orders > info.order_count) {
+            return SnapshotResult::error(path + ": level order range out of bounds");
+        }
+    }
+
+    size_t off = header.names_offset;
+    while (off + sizeof(NameEntry) <= header.file_bytes) {
+        NameEntry entry;
+        std::memcpy(&entry, base + off, sizeof(entry));
+        if (off + sizeof(entry) + entry.length > header.file_bytes) break;
+        std::string_view name(reinterpret_cast<const char*>(base + off + sizeof(entry)), entry.length);
+        auto& map = entry.kind == SymbolName ? snapshot->symbols_ : snapshot->accounts_;
+        if (entry.id >= map.size()) map.resize(static_cast<size_t>(entry.id) + 1, 0);
+        map[entry.id] = (entry.kind == SymbolName ? symbolTable() : accountTable()).intern(name);
+        off += align8(sizeof(entry) + entry.length);
+    }
+    return SnapshotResult::success(std::move(snapshot));
+}
+
+MappedBookSnapshot::~MappedBookSnapshot() {
+    if (data_) ::munmap(data_, size_);
+}
+
+}
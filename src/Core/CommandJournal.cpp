@@ -0,0 +1,633 @@
+#include "orderbook/Core/CommandJournal.hpp"
+#include "orderbook/Core/InternTable.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace orderbook {
+
+namespace {
+
+// On-disk layout (little-endian, 8-byte aligned records):
+//   segment: SegmentHeader, then records until a zero length word or the end
+//   record:  RecordHeader + payload, length rounded up to 8, checksum over the rest
+constexpr char SegmentMagic[8] = {'O', 'B', 'J', 'R', 'N', 'L', '\0', '\1'};
+constexpr uint32_t FormatVersion = 1;
+constexpr size_t MinSegmentBytes = size_t(1) << 20;
+constexpr size_t MaxNameBytes = 255;
+
+enum RecordKind : uint8_t {
+    CommandKind = 1,
+    SymbolNameKind = 2,
+    AccountNameKind = 3
+};
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_bytes;
+    uint64_t index;
+    uint64_t first_sequence;
+    uint64_t segment_bytes;
+    uint8_t reserved[24];
+};
+static_assert(sizeof(SegmentHeader) == 64, "segment header is one cache line");
+
+struct RecordHeader {
+    uint32_t checksum;
+    uint16_t length;
+    uint8_t kind;
+    uint8_t reserved;
+    uint64_t sequence;  // 0 for name records
+};
+
+struct CommandRecord {
+    RecordHeader header;
+    uint8_t type;
+    uint8_t side;
+    uint8_t order_type;
+    uint8_t tif;
+    uint32_t symbol_id;
+    uint32_t account_id;
+    uint32_t reserved;
+    uint64_t id;
+    int64_t price;
+    uint64_t quantity;
+};
+static_assert(sizeof(CommandRecord) == 56, "command record layout");
+
+struct NameRecord {
+    RecordHeader header;
+    uint32_t id;
+    uint16_t name_length;
+    uint16_t reserved;
+    char name[MaxNameBytes + 1];
+};
+
+constexpr size_t alignRecord(size_t bytes) { return (bytes + 7) & ~size_t(7); }
+
+size_t nameRecordLength(size_t name_length) {
+    return alignRecord(offsetof(NameRecord, name) + name_length);
+}
+
+// Word-wise mix over the record with the checksum field treated as zero
+uint32_t recordChecksum(const unsigned char* record, size_t length) {
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ length;
+    for (size_t off = 0; off < length; off += 8) {
+        uint64_t word;
+        std::memcpy(&word, record + off, 8);
+        if (off == 0) word &= ~uint64_t(0xFFFFFFFFu);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 29;
+    }
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+std::string segmentPath(const std::string& directory, uint64_t index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "journal-%08llu.seg", static_cast<unsigned long long>(index));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+std::vector<uint64_t> listSegments(const std::string& directory) {
+    std::vector<uint64_t> indexes;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        std::string name = entry.path().filename().string();
+        unsigned long long index = 0;
+        char tail = 0;
+        if (std::sscanf(name.c_str(), "journal-%8llu.se%c", &index, &tail) == 2 && tail == 'g' &&
+            name.size() == 20) {
+            indexes.push_back(index);
+        }
+    }
+    std::sort(indexes.begin(), indexes.end());
+    return indexes;
+}
+
+bool syncDirectory(const std::string& directory) {
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// CommandJournalReader
+
+CommandJournalReader::CommandJournalReader(std::string directory)
+    : directory_(std::move(directory)), segments_(listSegments(directory_)) {
+    if (segments_.empty() || !openSegment(0)) {
+        finished_ = true;
+    }
+}
+
+CommandJournalReader::~CommandJournalReader() { closeSegment(); }
+
+bool CommandJournalReader::openSegment(size_t position) {
+    closeSegment();
+    position_ = position;
+    segment_index_ = segments_[position];
+    offset_ = 0;
+
+    std::string path = segmentPath(directory_, segment_index_);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = "cannot open " + path;
+        damaged_ = true;
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)) {
+        ::close(fd);
+        error_ = path + ": truncated segment header";
+        damaged_ = true;
+        return false;
+    }
+    void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        error_ = "cannot map " + path;
+        damaged_ = true;
+        return false;
+    }
+#ifdef MADV_SEQUENTIAL
+    ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+#endif
+    data_ = static_cast<const unsigned char*>(p);
+    size_ = static_cast<size_t>(st.st_size);
+
+    SegmentHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, SegmentMagic, sizeof(SegmentMagic)) != 0 ||
+        header.version != FormatVersion || header.index != segment_index_ ||
+        header.header_bytes != sizeof(SegmentHeader) || header.first_sequence != last_sequence_ + 1) {
+        // The first segment may start anywhere once older ones have been truncated away
+        bool first = position == 0 && std::memcmp(header.magic, SegmentMagic, sizeof(SegmentMagic)) == 0 &&
+                     header.version == FormatVersion && header.index == segment_index_;
+        if (!first) {
+            error_ = path + ": bad segment header";
+            damaged_ = true;
+            return false;
+        }
+        last_sequence_ = header.first_sequence - 1;
+    }
+    offset_ = sizeof(SegmentHeader);
+    return true;
+}
+
+void CommandJournalReader::closeSegment() {
+    if (data_) {
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+void CommandJournalReader::resolveName(uint8_t kind, uint32_t id, const char* name, size_t length) {
+    auto& map = kind == SymbolNameKind ? symbol_map_ : account_map_;
+    InternTable& table = kind == SymbolNameKind ? symbolTable() : accountTable();
+    if (id >= map.size()) map.resize(static_cast<size_t>(id) + 1, 0);
+    map[id] = table.intern(std::string_view(name, length));
+}
+
+bool CommandJournalReader::next(JournalCommand& command) {
+    while (!finished_) {
+        if (offset_ + sizeof(RecordHeader) > size_) {
+            // Exactly full segment: continue with the next one if there is one
+            if (position_ + 1 < segments_.size() && openSegment(position_ + 1)) continue;
+            finished_ = true;
+            break;
+        }
+        RecordHeader header;
+        std::memcpy(&header, data_ + offset_, sizeof(header));
+        if (header.length == 0) {
+            // Unwritten tail: the segment was sealed here, or this is the live end
+            if (position_ + 1 < segments_.size()) {
+                if (openSegment(position_ + 1)) continue;
+            }
+            finished_ = true;
+            break;
+        }
+        if (header.length < sizeof(RecordHeader) || header.length % 8 != 0 ||
+            offset_ + header.length > size_ ||
+            recordChecksum(data_ + offset_, header.length) != header.checksum) {
+            error_ = segmentPath(directory_, segment_index_) + ": torn record at offset " + std::to_string(offset_);
+            damaged_ = true;
+            finished_ = true;
+            break;
+        }
+
+        const unsigned char* record = data_ + offset_;
+        if (header.kind == CommandKind && header.length == sizeof(CommandRecord)) {
+            if (header.sequence != last_sequence_ + 1) {
+                error_ = "sequence gap after " + std::to_string(last_sequence_);
+                damaged_ = true;
+                finished_ = true;
+                break;
+            }
+            CommandRecord rec;
+            std::memcpy(&rec, record, sizeof(rec));
+            offset_ += header.length;
+            last_sequence_ = header.sequence;
+
+            command.sequence = header.sequence;
+            command.type = static_cast<JournalCommand::Type>(rec.type);
+            command.side = static_cast<Side>(rec.side);
+            command.order_type = static_cast<OrderType>(rec.order_type);
+            command.tif = static_cast<TimeInForce>(rec.tif);
+            command.symbol_id = rec.symbol_id < symbol_map_.size() ? symbol_map_[rec.symbol_id] : 0;
+            command.account_id = rec.account_id < account_map_.size() ? account_map_[rec.account_id] : 0;
+            command.id = OrderId(rec.id);
+            command.price = rec.price;
+            command.quantity = rec.quantity;
+            return true;
+        }
+        if ((header.kind == SymbolNameKind || header.kind == AccountNameKind) &&
+            header.length >= offsetof(NameRecord, name)) {
+            uint32_t id;
+            uint16_t name_length;
+            std::memcpy(&id, record + offsetof(NameRecord, id), sizeof(id));
+            std::memcpy(&name_length, record + offsetof(NameRecord, name_length), sizeof(name_length));
+            if (offsetof(NameRecord, name) + name_length <= header.length) {
+                resolveName(header.kind, id, reinterpret_cast<const char*>(record + offsetof(NameRecord, name)),
+                            name_length);
+            }
+        }
+        // Unknown kinds are skipped so newer writers stay readable
+        offset_ += header.length;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// CommandJournal
+
+struct CommandJournal::Segment {
+    int fd = -1;
+    unsigned char* base = nullptr;
+    size_t size = 0;
+    uint64_t index = 0;
+    // Consumer-published end of the appended records
+    std::atomic<size_t> written{0};
+    // Flusher-only: everything below this offset is on stable storage
+    size_t synced = 0;
+
+    uint64_t firstSequence() const {
+        SegmentHeader header;
+        std::memcpy(&header, base, sizeof(header));
+        return header.first_sequence;
+    }
+
+    ~Segment() {
+        if (base) ::munmap(base, size);
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+CommandJournal::CommandJournal(const CommandJournalOptions& options) : options_(options) {
+    options_.segment_bytes = std::max(options_.segment_bytes, MinSegmentBytes);
+    options_.segment_bytes = (options_.segment_bytes + 4095) / 4096 * 4096;
+}
+
+Result<std::unique_ptr<CommandJournal>> CommandJournal::open(const CommandJournalOptions& options,
+                                                              const RecoverFn& on_recovered,
+                                                              uint64_t min_sequence) {
+    if (options.directory.empty()) {
+        return Result<std::unique_ptr<CommandJournal>>::error("Journal directory not set");
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(options.directory, ec);
+    if (ec) {
+        return Result<std::unique_ptr<CommandJournal>>::error(
+            "Cannot create journal directory " + options.directory + ": " + ec.message());
+    }
+
+    std::unique_ptr<CommandJournal> journal(new CommandJournal(options));
+    auto recovered = journal->recover(on_recovered, min_sequence);
+    if (recovered.isError()) {
+        return Result<std::unique_ptr<CommandJournal>>::error(recovered.error());
+    }
+    journal->flusher_ = std::thread(&CommandJournal::flushLoop, journal.get());
+    return Result<std::unique_ptr<CommandJournal>>::success(std::move(journal));
+}
+
+Result<bool> CommandJournal::recover(const RecoverFn& on_recovered, uint64_t min_sequence) {
+    CommandJournalReader reader(options_.directory);
+    JournalCommand command;
+    bool first = true;
+    while (reader.next(command)) {
+        if (first) {
+            first_sequence_.store(command.sequence, std::memory_order_relaxed);
+            first = false;
+        }
+        if (on_recovered) on_recovered(command);
+        ++recovered_count_;
+    }
+    recovered_damaged_ = reader.damaged();
+
+    const auto& segments = reader.segmentIndexes();
+    std::string error;
+    if (segments.empty()) {
+        sequence_.store(min_sequence, std::memory_order_relaxed);
+        durable_sequence_.store(min_sequence, std::memory_order_relaxed);
+        first_sequence_.store(min_sequence + 1, std::memory_order_relaxed);
+        active_ = createSegment(1, min_sequence + 1, &error);
+        if (!active_) return Result<bool>::error(error);
+        return Result<bool>::success(true);
+    }
+    if (reader.lastSequence() < min_sequence) {
+        return Result<bool>::error("Journal ends at sequence " + std::to_string(reader.lastSequence()) +
+                                   ", before the snapshot's " + std::to_string(min_sequence));
+    }
+    if (first) first_sequence_.store(reader.lastSequence() + 1, std::memory_order_relaxed);
+    sequence_.store(reader.lastSequence(), std::memory_order_relaxed);
+    durable_sequence_.store(reader.lastSequence(), std::memory_order_relaxed);
+
+    // Anything after the segment reading stopped in is unreachable: set it aside
+    uint64_t end_segment = reader.endSegment();
+    for (uint64_t index : segments) {
+        if (index <= end_segment) continue;
+        std::string path = segmentPath(options_.directory, index);
+        std::error_code ec;
+        std::filesystem::rename(path, path + ".corrupt", ec);
+    }
+
+    if (reader.endOffset() < sizeof(SegmentHeader)) {
+        // Header itself unreadable: keep the file aside and start this segment over
+        std::string path = segmentPath(options_.directory, end_segment);
+        std::error_code ec;
+        std::filesystem::rename(path, path + ".corrupt", ec);
+        active_ = createSegment(end_segment, reader.lastSequence() + 1, &error);
+    } else {
+        active_ = mapSegment(end_segment, &error);
+        if (active_) {
+            // Zero the torn or unwritten tail so stale bytes can never pass as records
+            size_t end = reader.endOffset();
+            std::memset(active_->base + end, 0, active_->size - end);
+            active_->written.store(end, std::memory_order_relaxed);
+            active_->synced = std::min(end, active_->size) & ~size_t(4095);
+        }
+    }
+    if (!active_) return Result<bool>::error(error);
+    return Result<bool>::success(true);
+}
+
+std::unique_ptr<CommandJournal::Segment> CommandJournal::createSegment(uint64_t index, uint64_t first_sequence,
+                                                                       std::string* error) {
+    std::string path = segmentPath(options_.directory, index);
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        *error = "Cannot create " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    // Reserve the blocks now so a full disk fails here rather than as SIGBUS on a store
+    int rc = ::posix_fallocate(fd, 0, static_cast<off_t>(options_.segment_bytes));
+    if (rc != 0 && ::ftruncate(fd, static_cast<off_t>(options_.segment_bytes)) != 0) {
+        *error = "Cannot size " + path + ": " + std::strerror(rc);
+        ::close(fd);
+        return nullptr;
+    }
+    ::fsync(fd);
+    syncDirectory(options_.directory);
+    ::close(fd);
+
+    auto segment = mapSegment(index, error);
+    if (!segment) return nullptr;
+
+    SegmentHeader header{};
+    std::memcpy(header.magic, SegmentMagic, sizeof(SegmentMagic));
+    header.version = FormatVersion;
+    header.header_bytes = sizeof(SegmentHeader);
+    header.index = index;
+    header.first_sequence = first_sequence;
+    header.segment_bytes = segment->size;
+    std::memcpy(segment->base, &header, sizeof(header));
+    segment->written.store(sizeof(SegmentHeader), std::memory_order_release);
+    return segment;
+}
+
+std::unique_ptr<CommandJournal::Segment> CommandJournal::mapSegment(uint64_t index, std::string* error) {
+    std::string path = segmentPath(options_.directory, index);
+    auto segment = std::make_unique<Segment>();
+    segment->index = index;
+    segment->fd = ::open(path.c_str(), O_RDWR);
+    if (segment->fd < 0) {
+        *error = "Cannot open " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    struct stat st {};
+    if (::fstat(segment->fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)) {
+        *error = "Cannot stat " + path;
+        return nullptr;
+    }
+    segment->size = static_cast<size_t>(st.st_size);
+    void* p = ::mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+    if (p == MAP_FAILED) {
+        *error = "Cannot map " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    segment->base = static_cast<unsigned char*>(p);
+    return segment;
+}
+
+CommandJournal::~CommandJournal() {
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex_);
+        stopping_ = true;
+    }
+    flush_cv_.notify_all();
+    if (flusher_.joinable()) flusher_.join();
+    flushOnce();
+}
+
+bool CommandJournal::rollover() {
+    std::string error;
+    auto next = createSegment(active_->index + 1, sequence_.load(std::memory_order_relaxed) + 1, &error);
+    if (!next) return false;
+    {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        sealed_.push_back(std::move(active_));
+        active_ = std::move(next);
+    }
+    symbols_named_.assign(symbols_named_.size(), false);
+    accounts_named_.assign(accounts_named_.size(), false);
+    flush_cv_.notify_one();
+    return true;
+}
+
+void CommandJournal::writeRecord(const void* record, size_t length) {
+    size_t offset = active_->written.load(std::memory_order_relaxed);
+    std::memcpy(active_->base + offset, record, length);
+    active_->written.store(offset + length, std::memory_order_release);
+}
+
+bool CommandJournal::writeName(uint8_t kind, uint32_t id) {
+    const char* name = kind == SymbolNameKind ? symbolTable().name(id) : accountTable().name(id);
+    size_t name_length = std::min(std::strlen(name), MaxNameBytes);
+
+    NameRecord record{};
+    record.header.length = static_cast<uint16_t>(nameRecordLength(name_length));
+    record.header.kind = kind;
+    record.id = id;
+    record.name_length = static_cast<uint16_t>(name_length);
+    std::memcpy(record.name, name, name_length);
+    record.header.checksum = recordChecksum(reinterpret_cast<const unsigned char*>(&record), record.header.length);
+    writeRecord(&record, record.header.length);
+
+    auto& named = kind == SymbolNameKind ? symbols_named_ : accounts_named_;
+    if (id >= named.size()) named.resize(static_cast<size_t>(id) + 1, false);
+    named[id] = true;
+    return true;
+}
+
+uint64_t CommandJournal::append(JournalCommand command) {
+    auto needsName = [](const std::vector<bool>& named, uint32_t id) {
+        return id != InternTable::EmptyId && (id >= named.size() || !named[id]);
+    };
+    auto nameBytes = [](InternTable& table, uint32_t id) {
+        return nameRecordLength(std::min(std::strlen(table.name(id)), MaxNameBytes));
+    };
+
+    // Names must land in the same segment as the first command using them
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        bool symbol_name = needsName(symbols_named_, command.symbol_id);
+        bool account_name = needsName(accounts_named_, command.account_id);
+        size_t needed = sizeof(CommandRecord) + (symbol_name ? nameBytes(symbolTable(), command.symbol_id) : 0) +
+                        (account_name ? nameBytes(accountTable(), command.account_id) : 0);
+        // Keep 8 zero bytes at the end so a full segment still ends in a terminator
+        if (active_->written.load(std::memory_order_relaxed) + needed + sizeof(uint64_t) > active_->size) {
+            if (attempt == 0 && rollover()) continue;
+            append_failures_.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+        if (symbol_name) writeName(SymbolNameKind, command.symbol_id);
+        if (account_name) writeName(AccountNameKind, command.account_id);
+        break;
+    }
+
+    uint64_t sequence = sequence_.load(std::memory_order_relaxed) + 1;
+    CommandRecord record{};
+    record.header.length = sizeof(CommandRecord);
+    record.header.kind = CommandKind;
+    record.header.sequence = sequence;
+    record.type = static_cast<uint8_t>(command.type);
+    record.side = static_cast<uint8_t>(command.side);
+    record.order_type = static_cast<uint8_t>(command.order_type);
+    record.tif = static_cast<uint8_t>(command.tif);
+    record.symbol_id = command.symbol_id;
+    record.account_id = command.account_id;
+    record.id = command.id.value;
+    record.price = command.price;
+    record.quantity = command.quantity;
+    record.header.checksum = recordChecksum(reinterpret_cast<const unsigned char*>(&record), sizeof(record));
+    writeRecord(&record, sizeof(record));
+    // After the offset, so a flusher that sees this sequence also sees the record
+    sequence_.store(sequence, std::memory_order_release);
+    return sequence;
+}
+
+void CommandJournal::sync() {
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+    if (stopping_) return;
+    uint64_t ticket = ++sync_requests_;
+    flush_cv_.notify_all();
+    flush_cv_.wait(lock, [&] { return sync_completions_ >= ticket || stopping_; });
+}
+
+size_t CommandJournal::truncate(uint64_t sequence) {
+    // A segment is fully covered when the one after it starts at or before sequence + 1
+    std::vector<uint64_t> segments = listSegments(options_.directory);
+    std::vector<uint64_t> first_sequences(segments.size(), 0);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        int fd = ::open(segmentPath(options_.directory, segments[i]).c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        SegmentHeader header{};
+        if (::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+            std::memcmp(header.magic, SegmentMagic, sizeof(SegmentMagic)) == 0) {
+            first_sequences[i] = header.first_sequence;
+        }
+        ::close(fd);
+    }
+
+    size_t removed = 0;
+    for (size_t i = 0; i + 1 < segments.size(); ++i) {
+        uint64_t next_first = first_sequences[i + 1];
+        if (next_first == 0 || next_first > sequence + 1) break;
+        if (::unlink(segmentPath(options_.directory, segments[i]).c_str()) == 0) {
+            first_sequence_.store(next_first, std::memory_order_release);
+            ++removed;
+        }
+    }
+    if (removed > 0) syncDirectory(options_.directory);
+    return removed;
+}
+
+void CommandJournal::flushLoop() {
+    std::unique_lock<std::mutex> lock(flush_mutex_);
+    auto interval = std::chrono::microseconds(std::max<uint32_t>(options_.sync_interval_us, 1));
+    while (!stopping_) {
+        flush_cv_.wait_for(lock, interval, [&] { return stopping_ || sync_requests_ != sync_completions_; });
+        if (stopping_) break;
+        uint64_t requested = sync_requests_;
+        lock.unlock();
+        flushOnce();
+        lock.lock();
+        sync_completions_ = requested;
+        flush_cv_.notify_all();
+    }
+}
+
+void CommandJournal::flushOnce() {
+    uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    std::vector<std::unique_ptr<Segment>> sealed;
+    Segment* active = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        sealed.swap(sealed_);
+        active = active_.get();
+    }
+
+    // Nothing at or past the first segment that failed to sync counts as durable
+    uint64_t durable = sequence;
+    auto syncSegment = [this, &durable](Segment& segment) {
+        size_t end = segment.written.load(std::memory_order_acquire);
+        if (end <= segment.synced) return true;
+        size_t start = segment.synced & ~size_t(4095);
+        if (::msync(segment.base + start, end - start, MS_SYNC) == 0) {
+            segment.synced = end;
+            return true;
+        }
+        sync_failures_.fetch_add(1, std::memory_order_relaxed);
+        durable = std::min(durable, segment.firstSequence() - 1);
+        return false;
+    };
+    // A sealed segment is unmapped only once synced; failures go back for the next pass
+    std::vector<std::unique_ptr<Segment>> retry;
+    for (auto& segment : sealed) {
+        if (!syncSegment(*segment)) retry.push_back(std::move(segment));
+    }
+    if (active) syncSegment(*active);
+    if (!retry.empty()) {
+        std::lock_guard<std::mutex> lock(segments_mutex_);
+        sealed_.insert(sealed_.begin(), std::make_move_iterator(retry.begin()),
+                       std::make_move_iterator(retry.end()));
+    }
+    if (durable > durable_sequence_.load(std::memory_order_relaxed)) {
+        durable_sequence_.store(durable, std::memory_order_release);
+    }
+}
+
+}
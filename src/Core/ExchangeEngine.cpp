@@ -0,0 +1,213 @@
+#include "orderbook/Core/ExchangeEngine.hpp"
+#include <algorithm>
+
+namespace orderbook {
+
+ExchangeEngine::ExchangeEngine(RiskManagerPtr risk_manager,
+                               MarketDataPublisherPtr market_data,
+                               LoggerPtr logger,
+                               ExchangeEngineOptions options)
+    : options_(options), risk_manager_(risk_manager), market_data_(market_data), logger_(logger) {
+    // Books are driven by the shard threads, never by their own consumer
+    options_.book_options.own_consumer_thread = false;
+
+    size_t thread_count = std::max<size_t>(options_.matching_threads, 1);
+    shards_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto shard = std::make_unique<MatchingShard>();
+        shard->waiter.setOptions(options_.wait);
+        if (options_.wait.cpu_affinity >= 0) {
+            shard->cpu = options_.wait.cpu_affinity + static_cast<int>(i);
+        }
+        shards_.emplace_back(std::move(shard));
+    }
+
+    if (logger_) {
+        logger_->info("ExchangeEngine initialized with " + std::to_string(thread_count) +
+                     " matching threads", "ExchangeEngine::Constructor");
+    }
+}
+
+ExchangeEngine::~ExchangeEngine() {
+    stop();
+}
+
+Result<SymbolId> ExchangeEngine::addSymbol(const std::string& symbol) {
+    return addSymbol(symbol, options_.book_options.price_scale);
+}
+
+Result<SymbolId> ExchangeEngine::addSymbol(const std::string& symbol, PriceScale price_scale) {
+    if (auto existing = findSymbol(symbol)) {
+        return Result<SymbolId>::success(*existing);
+    }
+    if (running_.load(std::memory_order_acquire)) {
+        return Result<SymbolId>::error("Cannot register symbol " + symbol + " while the engine is running");
+    }
+
+    if (symbol.empty()) {
+        return Result<SymbolId>::error("Symbol name must not be empty");
+    }
+
+    SymbolId id = symbolTable().intern(symbol);
+    size_t shard_index = books_.size() % shards_.size();
+    MatchingShard& shard = *shards_[shard_index];
+    // Place the book's order arena on its matching thread's NUMA node
+    OrderBookOptions book_options = options_.book_options;
+    book_options.wait.cpu_affinity = shard.cpu;
+    book_options.price_scale = price_scale;
+    books_.emplace_back(std::make_unique<OrderBook>(risk_manager_, market_data_, logger_, book_options));
+    if (book_by_symbol_.size() <= id) {
+        book_by_symbol_.resize(id + 1, nullptr);
+        shard_by_symbol_.resize(id + 1, 0);
+    }
+    book_by_symbol_[id] = books_.back().get();
+    shard_by_symbol_[id] = static_cast<uint32_t>(shard_index);
+    shard.books.push_back(books_.back().get());
+    // Producers wake the shard thread directly, whichever entry point they use
+    books_.back()->setConsumerWaiter(&shard.waiter);
+
+    if (logger_) {
+        logger_->info("Registered symbol " + symbol + " as id " + std::to_string(id) +
+                     " on matching thread " + std::to_string(shard_index),
+                     "ExchangeEngine::addSymbol");
+    }
+    return Result<SymbolId>::success(id);
+}
+
+Result<size_t> ExchangeEngine::addSymbols(const SymbolMaster& master) {
+    for (const SymbolMasterEntry& entry : master) {
+        auto added = addSymbol(std::string(entry.symbolView()), entry.priceScale());
+        if (added.isError()) {
+            return Result<size_t>::error(added.error());
+        }
+    }
+    return Result<size_t>::success(master.size());
+}
+
+void ExchangeEngine::start() {
+    if (running_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (auto& shard : shards_) {
+        MatchingShard* raw = shard.get();
+        shard->waiter.setConsumerRunning(true);
+        shard->thread = std::thread([this, raw] { runShard(*raw); });
+    }
+}
+
+void ExchangeEngine::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (auto& shard : shards_) {
+        shard->waiter.stop();
+    }
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+        shard->waiter.setConsumerRunning(false);
+    }
+}
+
+void ExchangeEngine::runShard(MatchingShard& shard) {
+    if (shard.cpu >= 0 && !pinCurrentThreadToCpu(shard.cpu) && logger_) {
+        logger_->warn("Failed to pin matching thread to CPU " + std::to_string(shard.cpu),
+                     "ExchangeEngine::runShard");
+    }
+
+    // wait() clears the pending flag before we sweep, so work pushed mid-sweep re-arms it.
+    // The earliest scheduled auction on the shard wakes it even when no request arrives.
+    std::chrono::steady_clock::time_point deadline{};
+    bool has_deadline = false;
+    while (has_deadline ? shard.waiter.waitUntil(deadline) : shard.waiter.wait()) {
+        // Keep sweeping the pinned books until a full pass finds no work
+        bool any_processed = true;
+        while (any_processed) {
+            any_processed = false;
+            for (OrderBook* book : shard.books) {
+                if (book->processPending() > 0) {
+                    any_processed = true;
+                }
+            }
+        }
+        has_deadline = false;
+        for (OrderBook* book : shard.books) {
+            auto next = book->nextAuctionDeadline();
+            if (next && (!has_deadline || *next < deadline)) {
+                deadline = *next;
+                has_deadline = true;
+            }
+        }
+    }
+}
+
+std::optional<SymbolId> ExchangeEngine::findSymbol(std::string_view symbol) const {
+    auto id = symbolTable().find(symbol);
+    if (!id || *id >= book_by_symbol_.size() || !book_by_symbol_[*id]) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+const char* ExchangeEngine::getSymbolName(SymbolId id) const {
+    return id < book_by_symbol_.size() && book_by_symbol_[id] ? symbolTable().name(id) : "";
+}
+
+OrderBook* ExchangeEngine::getBook(SymbolId id) {
+    return id < book_by_symbol_.size() ? book_by_symbol_[id] : nullptr;
+}
+
+OrderBook* ExchangeEngine::getBook(std::string_view symbol) {
+    auto id = findSymbol(symbol);
+    return id ? book_by_symbol_[*id] : nullptr;
+}
+
+OrderResult ExchangeEngine::addOrder(const Order& order) {
+    if (!getBook(order.symbol_id)) {
+        LOG_WARN(logger_, "ExchangeEngine::addOrder", "Order for unknown symbol {} OrderID: {}",
+                 order.symbol(), order.id);
+        return OrderResult::error(std::string("Unknown symbol: ") + order.symbol());
+    }
+    return addOrder(order.symbol_id, order);
+}
+
+OrderResult ExchangeEngine::addOrder(SymbolId id, const Order& order) {
+    OrderBook* book = getBook(id);
+    if (!book) {
+        return OrderResult::error("Unknown symbol id: " + std::to_string(id));
+    }
+    return book->addOrder(order);
+}
+
+CancelResult ExchangeEngine::cancelOrder(SymbolId id, OrderId order_id) {
+    OrderBook* book = getBook(id);
+    if (!book) {
+        return CancelResult::error("Unknown symbol id: " + std::to_string(id));
+    }
+    return book->cancelOrder(order_id);
+}
+
+ModifyResult ExchangeEngine::modifyOrder(SymbolId id, OrderId order_id, Price new_price, Quantity new_quantity) {
+    OrderBook* book = getBook(id);
+    if (!book) {
+        return ModifyResult::error("Unknown symbol id: " + std::to_string(id));
+    }
+    return book->modifyOrder(order_id, new_price, new_quantity);
+}
+
+Result<OrderBook::Producer> ExchangeEngine::registerProducer(SymbolId id) {
+    OrderBook* book = getBook(id);
+    if (!book) {
+        return Result<OrderBook::Producer>::error("Unknown symbol id: " + std::to_string(id));
+    }
+    return book->registerProducer();
+}
+
+void ExchangeEngine::waitForCompletion() {
+    for (auto& book : books_) {
+        book->waitForCompletion();
+    }
+}
+
+}
@@ -0,0 +1,65 @@
+#include "orderbook/Core/InternTable.hpp"
+
+namespace orderbook {
+
+InternTable::InternTable() {
+    intern(std::string_view());
+}
+
+InternTable::~InternTable() {
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+uint32_t InternTable::intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    uint32_t id = size_.load(std::memory_order_relaxed);
+    if (id >= MaxEntries) {
+        return EmptyId;
+    }
+    std::string* chunk = chunks_[id / ChunkSize].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new std::string[ChunkSize];
+        chunks_[id / ChunkSize].store(chunk, std::memory_order_release);
+    }
+    std::string& slot = chunk[id % ChunkSize];
+    slot.assign(name.data(), name.size());
+    ids_.emplace(std::string_view(slot), id);
+    // Publish the name before readers can see the new size
+    size_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+std::optional<uint32_t> InternTable::find(std::string_view name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it == ids_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const char* InternTable::name(uint32_t id) const {
+    if (id >= size_.load(std::memory_order_acquire)) {
+        return "";
+    }
+    return chunks_[id / ChunkSize].load(std::memory_order_acquire)[id % ChunkSize].c_str();
+}
+
+InternTable& symbolTable() {
+    static InternTable table;
+    return table;
+}
+
+InternTable& accountTable() {
+    static InternTable table;
+    return table;
+}
+
+}
@@ -3,11 +3,19 @@
 
 namespace orderbook {
 
+// Orders come from the shared pool's thread-local magazines; derived sizes fall back
 void* Order::operator new(size_t size) {
+    if (size == sizeof(Order)) return ObjectPools::getOrderPool().allocateRaw();
     return MemoryManager::getInstance().allocateAligned(size, 64);
 }
 
 void Order::operator delete(void* ptr) {
+    if (!ptr) return;
+    auto& pool = ObjectPools::getOrderPool();
+    if (pool.owns(ptr)) {
+        pool.releaseRaw(ptr);
+        return;
+    }
     MemoryManager::getInstance().deallocateAligned(ptr, sizeof(Order));
 }
 
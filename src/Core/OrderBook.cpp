@@ -2,72 +2,175 @@
 #include "orderbook/Utilities/PerformanceTimer.hpp"
 #include "orderbook/Utilities/MemoryManager.hpp"
 #include "orderbook/Utilities/PerformanceMeasurement.hpp"
+#include "orderbook/Utilities/LatencyTracer.hpp"
 #include <algorithm>
+#include <cassert>
 #include <chrono>
 #include <iostream>
 #include <limits>
 
 namespace orderbook {
 
+std::optional<BackpressurePolicy> parseBackpressurePolicy(const std::string& name) {
+    if (name == "reject") return BackpressurePolicy::Reject;
+    if (name == "spin_wait") return BackpressurePolicy::SpinWait;
+    if (name == "overflow") return BackpressurePolicy::Overflow;
+    return std::nullopt;
+}
+
+std::optional<MatchingMode> parseMatchingMode(const std::string& name) {
+    if (name == "continuous") return MatchingMode::Continuous;
+    if (name == "batch_auction") return MatchingMode::BatchAuction;
+    return std::nullopt;
+}
+
+namespace {
+
+// Visit non-empty ladder levels from best to worst; the visitor returns false to stop
+template<typename Ladder, typename Visitor>
+void visitLadderLevels(Ladder& ladder, Visitor&& visitor) {
+    ladder.forEachLevel([&visitor](auto& level) {
+        return level.isEmpty() ? true : visitor(level);
+    });
+}
+
+// Sorted vectors keep the best price at the back. Index-based so the visitor may
+// pop reclaimed levels off the back without invalidating the walk.
+template<typename Levels, typename Visitor>
+void visitSortedLevels(Levels& levels, Visitor&& visitor) {
+    size_t i = levels.size();
+    while (i > 0) {
+        auto& level = *levels[--i];
+        if (level.isEmpty()) continue;
+        if (!visitor(level)) break;
+        i = std::min(i, levels.size());
+    }
+}
+
+// Visit non-empty levels of one side from best to worst, in either storage mode.
+// The visitor returns false to stop.
+template<typename Levels, typename Ladder, typename Visitor>
+void visitLevels(bool ladder_mode, Levels& levels, Ladder& ladder, Visitor&& visitor) {
+    if (ladder_mode) {
+        visitLadderLevels(ladder, std::forward<Visitor>(visitor));
+    } else {
+        visitSortedLevels(levels, std::forward<Visitor>(visitor));
+    }
+}
+
+// Held auction orders: market orders first, then by limit price; stable_sort keeps
+// arrival order within a price
+struct AuctionPriority {
+    bool buy;
+    bool operator()(const Order* a, const Order* b) const {
+        bool a_market = a->type == OrderType::Market;
+        bool b_market = b->type == OrderType::Market;
+        if (a_market || b_market) return a_market && !b_market;
+        return buy ? a->price > b->price : a->price < b->price;
+    }
+};
+
+// One side of an auction in priority order: held market orders, then resting levels
+// and held limit orders merged by price (resting first at the same price), limited
+// to participants willing to trade at the clearing price
+struct AuctionQueue {
+    const std::vector<PriceLevel*>& levels;
+    const std::vector<Order*>& held;
+    bool buy;
+    Price clearing;
+    size_t level = 0;
+    size_t next_held = 0;
+
+    bool eligible(Price price) const { return buy ? price >= clearing : price <= clearing; }
+
+    // Next participant with quantity left; at is its level, or nullptr for a held order
+    Order* front(PriceLevel*& at) {
+        while (next_held < held.size() && held[next_held]->isFullyFilled()) ++next_held;
+        while (level < levels.size() && levels[level]->isEmpty()) ++level;
+        Order* order = next_held < held.size() ? held[next_held] : nullptr;
+        PriceLevel* resting = level < levels.size() ? levels[level] : nullptr;
+        if (order && (order->type == OrderType::Market || !resting ||
+                      (buy ? order->price > resting->price : order->price < resting->price))) {
+            at = nullptr;
+            return order->type == OrderType::Market || eligible(order->price) ? order : nullptr;
+        }
+        if (!resting || !eligible(resting->price)) return nullptr;
+        at = resting;
+        return resting->getFirstOrder();
+    }
+};
+
+ArenaOptions orderArenaOptions(const OrderBookOptions& options) {
+    ArenaOptions arena;
+    arena.huge_pages = options.huge_pages;
+    // Prefaulting costs a handful of faults with huge pages; 4K pages stay first-touch
+    arena.prefault = options.huge_pages;
+    if (options.numa_bind) {
+        arena.numa_node = numaNodeOfCpu(options.wait.cpu_affinity);
+    }
+    return arena;
+}
+
+}
+
 // Constructor with dependency injection
 OrderBook::OrderBook(RiskManagerPtr risk_manager,
                      MarketDataPublisherPtr market_data,
-                     LoggerPtr logger)
-    : risk_manager_(risk_manager), market_data_(market_data), logger_(logger), running_(true) {
+                     LoggerPtr logger,
+                     OrderBookOptions options)
+    : waiter_(options.wait), orders_(options.max_orders, orderArenaOptions(options)),
+      bid_ladder_(Side::Buy, options.ladder_levels), ask_ladder_(Side::Sell, options.ladder_levels),
+      options_(options),
+      risk_manager_(risk_manager), market_data_(market_data), logger_(logger) {
     
     // Reserve capacity for typical number of price levels
     bids_.reserve(InitialCapacity);
     asks_.reserve(InitialCapacity);
     
     if (logger_) {
-        logger_->info("OrderBook initialized", "OrderBook::Constructor");
+        logger_->info(std::string("OrderBook initialized (") +
+                      (options_.ladder_mode ? "ladder" : "sorted") + " level storage)",
+                      "OrderBook::Constructor");
     }
 
-    // Start processing thread
-    processing_thread_ = std::thread(&OrderBook::processLoop, this);
+    market_queue_ = std::make_unique<MarketUpdateQueue>();
+    // Ring 0 is the shared ring; dedicated rings are allocated by registerProducer()
+    producer_rings_[SharedRingIndex] = std::make_unique<ProducerRing>();
+    producer_rings_[SharedRingIndex]->in_use.store(true, std::memory_order_relaxed);
+    ring_count_.store(1, std::memory_order_release);
+    LOG_INFO(logger_, "OrderBook::Constructor", "Order arena: {} slots, {} bytes, huge pages {}, NUMA bound {}",
+             orders_.pool().capacity(), orders_.pool().arena().size(),
+             orders_.pool().arena().hugePages() ? "on" : "off", orders_.pool().arena().numaBound() ? "yes" : "no");
 
-    // Initialize sharded market queues
-    market_queues_.reserve(MarketDataQueueCount);
-    for (size_t i = 0; i < MarketDataQueueCount; ++i) {
-        market_queues_.emplace_back(std::make_unique<boost::lockfree::spsc_queue<MarketUpdate, boost::lockfree::capacity<MarketDataQueueCapacity>>>());
-    }
-    // Initialize sharded order queues
-    order_queues_.reserve(OrderQueueCount);
-    for (size_t i = 0; i < OrderQueueCount; ++i) {
-        order_queues_.emplace_back(std::make_unique<boost::lockfree::spsc_queue<OrderRequest, boost::lockfree::capacity<OrderQueueCapacity>>>());
-    }
-    // Prepare free list capacity and pre-warm pool to avoid allocations on hot-path
-    // Pre-allocate 1,000,000 Order objects so acquireOrder is O(1) during tests
-    constexpr size_t PreWarmPoolSize = 1000000u;
-    order_free_list_.reserve(PreWarmPoolSize);
-    for (size_t i = 0; i < PreWarmPoolSize; ++i) {
-        order_free_list_.push_back(new Order());
+    // Start processing thread once the queues exist (an ExchangeEngine shard may drive us instead)
+    if (options_.own_consumer_thread) {
+        consumer_waiter_ = &waiter_;
+        waiter_.setConsumerRunning(true);
+        processing_thread_ = std::thread(&OrderBook::processLoop, this);
     }
 }
 
 OrderBook::~OrderBook() {
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        running_ = false;
-    }
-    queue_cv_.notify_one();
+    waiter_.stop();
     if (processing_thread_.joinable()) {
         processing_thread_.join();
     }
+    waiter_.setConsumerRunning(false);
 
-    // Cleanup pooled orders and any deferred retire list to avoid leaking memory
-    // Delete unique pointers only once (guard against duplicates)
-    {
-        std::unordered_set<Order*> freed;
-        for (Order* p : order_retire_list_) {
-            if (p && freed.insert(p).second) delete p;
-        }
-        order_retire_list_.clear();
-        for (Order* p : order_free_list_) {
-            if (p && freed.insert(p).second) delete p;
-        }
-        order_free_list_.clear();
+    // Orders still held for an auction that never ran
+    for (auto& held : auction_held_) {
+        order_retire_list_.insert(order_retire_list_.end(), held.begin(), held.end());
+        held.clear();
     }
+
+    // The store frees indexed orders; retired ones are already out of the index
+    std::unordered_set<Order*> freed;
+    for (Order* p : order_retire_list_) {
+        if (!p || !freed.insert(p).second) continue;
+        auto it = orders_.find(p->id);
+        if (it == orders_.end() || it->second.order != p) orders_.release(p);
+    }
+    order_retire_list_.clear();
 }
 
 void OrderBook::waitForCompletion() {
@@ -75,16 +178,24 @@ void OrderBook::waitForCompletion() {
     while (true) {
         bool any_pending = false;
         // Check order queues for any remaining work
-        for (auto& qptr : order_queues_) {
-            if (!qptr->empty()) { any_pending = true; break; }
+        size_t ring_count = ring_count_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < ring_count; ++i) {
+            ProducerRing& ring = *producer_rings_[i];
+            if (!ring.queue.empty() || ring.overflow_size.load(std::memory_order_acquire) > 0) {
+                any_pending = true;
+                break;
+            }
         }
         if (!any_pending) break;
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         wait_count++;
         if (wait_count % 10 == 0) {
-            size_t non_empty_shards = 0;
-            for (auto& qptr : order_queues_) if (!qptr->empty()) ++non_empty_shards;
-            std::cout << "Waiting for completion... Non-empty order shards: " << non_empty_shards << std::endl;
+            size_t non_empty_rings = 0;
+            size_t ring_count = ring_count_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < ring_count; ++i) {
+                if (!producer_rings_[i]->queue.empty()) ++non_empty_rings;
+            }
+            std::cout << "Waiting for completion... Non-empty order rings: " << non_empty_rings << std::endl;
         }
     }
     // Give a little time for the last item to be processed
@@ -92,190 +203,966 @@ void OrderBook::waitForCompletion() {
 }
 
 void OrderBook::processLoop() {
-    size_t processed_count = 0;
     std::cout << "Consumer thread started" << std::endl;
-    while (running_) {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        queue_cv_.wait(lock, [this] { return order_data_available_.load(std::memory_order_acquire) || !running_; });
+    int cpu = options_.wait.cpu_affinity;
+    if (cpu >= 0 && !pinCurrentThreadToCpu(cpu) && logger_) {
+        logger_->warn("Failed to pin consumer thread to CPU " + std::to_string(cpu), "OrderBook::processLoop");
+    }
 
-        if (!running_ && !order_data_available_.load(std::memory_order_acquire)) {
-            std::cout << "Consumer thread stopping" << std::endl;
-            return;
+    // wait() clears the pending flag before we drain, so work pushed mid-drain re-arms it.
+    // A scheduled auction wakes the consumer even when no new request arrives.
+    while (true) {
+        auto deadline = nextAuctionDeadline();
+        if (!(deadline ? waiter_.waitUntil(*deadline) : waiter_.wait())) break;
+        processPending();
+    }
+    std::cout << "Consumer thread stopping" << std::endl;
+}
+
+size_t OrderBook::processPending() {
+    size_t processed = 0;
+    // Round-robin over the rings, at most DrainBatchSize requests each per pass, starting
+    // one ring later every pass so no producer is always served first
+    bool any_processed = true;
+    while (any_processed) {
+        any_processed = false;
+        size_t ring_count = ring_count_.load(std::memory_order_acquire);
+        for (size_t n = 0; n < ring_count; ++n) {
+            size_t drained = drainRing(*producer_rings_[(drain_cursor_ + n) % ring_count]);
+            if (drained > 0) {
+                processed += drained;
+                any_processed = true;
+            }
         }
-        lock.unlock();
-
-        // Drain all order queues (sharded). We'll process all available requests.
-        OrderRequest req;
-        bool any_processed = true;
-        while (any_processed) {
-            any_processed = false;
-            for (auto& qptr : order_queues_) {
-                while (qptr->pop(req)) {
-                    any_processed = true;
-                    switch (req.type) {
-                        case OrderRequest::Type::Add: {
-                            // Construct Order on consumer side to avoid producer allocation
-                            // Allocate Order from recycle bin or heap (consumer-thread only)
-                            auto created = acquireOrder(req);
-                            processAddOrder(created);
-                            break;
-                        }
-                        case OrderRequest::Type::Cancel: {
-                            processCancelOrder(req.id);
-                            break;
-                        }
-                        case OrderRequest::Type::Modify: {
-                            processModifyOrder(req.id, req.price, req.quantity);
-                            break;
-                        }
-                    }
-                    processed_count++;
-                    if (processed_count % 10000 == 0) std::cout << "Consumer processed " << processed_count << " commands" << std::endl;
-                }
+        drain_cursor_ = (drain_cursor_ + 1) % ring_count;
+    }
+    // External feed levels queued by applyExternal*() and clearBook()
+    drainMarketQueue();
+    // Batch auctions uncross once per drain (or per interval) and publish once
+    bool auctioned = false;
+    if (batchAuction()) {
+        if (auctionDue(std::chrono::steady_clock::now())) {
+            // The boundary is journaled like a command, so replay uncrosses at the same points
+            if (journal_) {
+                JournalCommand boundary;
+                boundary.type = JournalCommand::Type::Auction;
+                journal_->append(boundary);
             }
+            runAuction();
+            auctioned = true;
+        }
+        if (market_data_due_) {
+            emitMarketDataUpdate();
         }
-        // Flush deferred releases back into the pool
-        if (!order_retire_list_.empty()) {
+    }
+    // Republish the reader snapshot once per drain, not per request
+    if (processed > 0 || auctioned) {
+        publishTopOfBook();
+    }
+
+    flushRetiredOrders();
+
+    // Queues are drained: reclaim tombstoned levels while idle
+    if (getTombstoneLevelCount() >= TombstoneCompactionThreshold) {
+        compactPriceLevels();
+    }
+    // Idle point: hand a pending snapshot its copy of the book
+    if (snapshot_requested_.load(std::memory_order_acquire)) {
+        serviceSnapshotRequest();
+    }
+    return processed;
+}
+
+void OrderBook::flushRetiredOrders() {
+    // Flush deferred releases back into the pool
+    if (order_retire_list_.empty()) return;
 #ifndef NDEBUG
-            std::cout << "[debug] flushing retire list size=" << order_retire_list_.size() << std::endl;
+    std::cout << "[debug] flushing retire list size=" << order_retire_list_.size() << std::endl;
 #endif
-            for (Order* p : order_retire_list_) {
+    for (Order* p : order_retire_list_) {
 #ifndef NDEBUG
-                if (p) std::cout << "[debug] releasing order id=" << p->id.value << std::endl;
+        if (p) std::cout << "[debug] releasing order id=" << p->id.value << std::endl;
 #endif
-                releaseOrder(p);
-            }
+        releaseOrder(p);
+    }
 #ifndef NDEBUG
-            std::cout << "[debug] flushed retire list" << std::endl;
+    std::cout << "[debug] flushed retire list" << std::endl;
 #endif
-            order_retire_list_.clear();
+    order_retire_list_.clear();
+}
+
+JournalCommand OrderBook::toJournalCommand(const OrderRequest& req) {
+    JournalCommand command;
+    switch (req.type) {
+        case OrderRequest::Type::Add: command.type = JournalCommand::Type::Add; break;
+        case OrderRequest::Type::Cancel: command.type = JournalCommand::Type::Cancel; break;
+        case OrderRequest::Type::Modify: command.type = JournalCommand::Type::Modify; break;
+        case OrderRequest::Type::CancelAccount: command.type = JournalCommand::Type::CancelAccount; break;
+        case OrderRequest::Type::CancelSymbol: command.type = JournalCommand::Type::CancelSymbol; break;
+    }
+    command.side = req.side;
+    command.order_type = req.order_type;
+    command.tif = req.tif;
+    command.symbol_id = req.symbol_id;
+    command.account_id = req.account_id;
+    command.id = req.id;
+    command.price = req.price;
+    command.quantity = req.quantity;
+    return command;
+}
+
+OrderBook::OrderRequest OrderBook::fromJournalCommand(const JournalCommand& command) {
+    OrderRequest req{};
+    switch (command.type) {
+        case JournalCommand::Type::Add: req.type = OrderRequest::Type::Add; break;
+        case JournalCommand::Type::Cancel: req.type = OrderRequest::Type::Cancel; break;
+        case JournalCommand::Type::Modify: req.type = OrderRequest::Type::Modify; break;
+        case JournalCommand::Type::CancelAccount: req.type = OrderRequest::Type::CancelAccount; break;
+        case JournalCommand::Type::CancelSymbol: req.type = OrderRequest::Type::CancelSymbol; break;
+        case JournalCommand::Type::Auction: break;  // Handled by replayCommands(), never a request
+    }
+    req.side = command.side;
+    req.order_type = command.order_type;
+    req.tif = command.tif;
+    req.symbol_id = command.symbol_id;
+    req.account_id = command.account_id;
+    req.id = command.id;
+    req.price = command.price;
+    req.quantity = command.quantity;
+    // Replay never holds risk reservations; exposure is not rebuilt from the journal
+    req.risk_reserved = false;
+    return req;
+}
+
+template<typename Source>
+size_t OrderBook::replayCommands(Source&& next_command) {
+    // Detach everything with side effects outside the book for the duration
+    RiskManagerPtr risk_manager = std::move(risk_manager_);
+    MarketDataPublisherPtr market_data = std::move(market_data_);
+    LoggerPtr logger = std::move(logger_);
+
+    size_t applied = 0;
+    JournalCommand command;
+    while (next_command(command)) {
+        // Already part of a loaded snapshot
+        if (command.sequence <= snapshot_sequence_) continue;
+        if (command.type == JournalCommand::Type::Auction) {
+            // Uncross where the live book did; anything held after the last boundary
+            // stays pending for the next live auction
+            if (batchAuction() && auctionDue(std::chrono::steady_clock::time_point::max())) {
+                runAuction();
+            }
+        } else {
+            applyRequest(fromJournalCommand(command));
+        }
+        if (++applied % DrainBatchSize == 0) {
+            flushRetiredOrders();
         }
+    }
+    flushRetiredOrders();
+    if (getTombstoneLevelCount() >= TombstoneCompactionThreshold) {
+        compactPriceLevels();
+    }
 
-        // Mark processed flag reset
-        order_data_available_.store(false, std::memory_order_release);
+    risk_manager_ = std::move(risk_manager);
+    market_data_ = std::move(market_data);
+    logger_ = std::move(logger);
+    publishTopOfBook();
+    return applied;
+}
+
+Result<size_t> OrderBook::replay(const std::string& directory) {
+    CommandJournalReader reader(directory);
+    size_t applied = replayCommands([&reader](JournalCommand& command) { return reader.next(command); });
+    if (reader.damaged()) {
+        LOG_WARN(logger_, "OrderBook::replay", "Journal replay stopped early: {}", reader.error());
     }
-    std::cout << "Consumer thread exited loop" << std::endl;
+    LOG_INFO(logger_, "OrderBook::replay", "Replayed {} journal commands up to sequence {}",
+             applied, reader.lastSequence());
+    return Result<size_t>::success(applied);
+}
+
+Result<size_t> OrderBook::openJournal(const CommandJournalOptions& options) {
+    if (journal_) {
+        return Result<size_t>::error("Journal already open");
+    }
+
+    // Recovered commands arrive one at a time from the journal's own scan; buffer a
+    // batch and apply it through the same path as replay()
+    std::vector<JournalCommand> pending;
+    size_t applied = 0;
+    auto applyPending = [this, &pending, &applied]() {
+        size_t i = 0;
+        applied += replayCommands([&pending, &i](JournalCommand& command) {
+            if (i == pending.size()) return false;
+            command = pending[i++];
+            return true;
+        });
+        pending.clear();
+    };
+    CommandJournal::RecoverFn on_recovered;
+    if (options.recover) {
+        pending.reserve(DrainBatchSize * 64);
+        on_recovered = [&pending, &applyPending](const JournalCommand& command) {
+            pending.push_back(command);
+            if (pending.size() == pending.capacity()) applyPending();
+        };
+    }
+
+    auto opened = CommandJournal::open(options, on_recovered, snapshot_sequence_);
+    if (opened.isError()) {
+        LOG_ERROR(logger_, "OrderBook::openJournal", "Cannot open journal: {}", opened.error());
+        return Result<size_t>::error(opened.error());
+    }
+    if (!pending.empty()) applyPending();
+    journal_ = std::move(opened.value());
+
+    if (journal_->firstSequence() > snapshot_sequence_ + 1) {
+        LOG_WARN(logger_, "OrderBook::openJournal", "Journal starts at sequence {} but the book only covers up to {}",
+                 journal_->firstSequence(), snapshot_sequence_);
+    }
+
+    if (journal_->recoveredDamaged()) {
+        LOG_WARN(logger_, "OrderBook::openJournal", "Journal in {} had a damaged tail; recovered up to sequence {}",
+                 options.directory, journal_->lastSequence());
+    }
+    LOG_INFO(logger_, "OrderBook::openJournal", "Journaling to {} ({} commands recovered, next sequence {})",
+             options.directory, applied, journal_->lastSequence() + 1);
+    return Result<size_t>::success(applied);
 }
 
 void OrderBook::applyExternalMarketData(const MarketDepth& depth) {
-    // Push clear message first
+    // Clear message first, then every level, pushed as one run so no other feed's
+    // updates land inside the snapshot
+    std::vector<MarketUpdate> snapshot;
+    snapshot.reserve(1 + depth.bids.size() + depth.asks.size());
     MarketUpdate clear_msg;
     clear_msg.type = MarketUpdate::Type::SnapshotStart;
-    // route to per-thread queue
-    market_queues_[getProducerQueueIndex()]->push(clear_msg);
+    snapshot.push_back(clear_msg);
 
-    // Push all bids
-    for (const auto& level : depth.bids) {
-        MarketUpdate update;
-        update.type = MarketUpdate::Type::Add;
-        update.side = Side::Buy;
-        update.price = level.price;
-        update.quantity = level.quantity;
-        update.order_count = level.order_count;
-        market_queues_[getProducerQueueIndex()]->push(update);
-    }
+    auto append = [&snapshot](Side side, const std::vector<MarketDepth::Level>& levels) {
+        for (const auto& level : levels) {
+            MarketUpdate update;
+            update.type = MarketUpdate::Type::Add;
+            update.side = side;
+            update.price = level.price;
+            update.quantity = level.quantity;
+            update.order_count = level.order_count;
+            snapshot.push_back(update);
+        }
+    };
+    append(Side::Buy, depth.bids);
+    append(Side::Sell, depth.asks);
 
-    // Push all asks
-    for (const auto& level : depth.asks) {
-        MarketUpdate update;
-        update.type = MarketUpdate::Type::Add;
-        update.side = Side::Sell;
-        update.price = level.price;
-        update.quantity = level.quantity;
-        update.order_count = level.order_count;
-        market_queues_[getProducerQueueIndex()]->push(update);
+    size_t queued = 0;
+    while (queued < snapshot.size()) {
+        size_t pushed = market_queue_->try_push_n(snapshot.data() + queued, snapshot.size() - queued);
+        if (pushed == 0) break;  // Queue full: the rest is dropped, as single pushes were
+        queued += pushed;
+    }
+    if (queued > 0 && consumer_waiter_) {
+        consumer_waiter_->signal();
     }
 }
 
 void OrderBook::applyExternalBookUpdate(const BookUpdate& update) {
-    MarketUpdate mu;
-    if (update.type == BookUpdate::Type::Add) mu.type = MarketUpdate::Type::Add;
-    else if (update.type == BookUpdate::Type::Modify) mu.type = MarketUpdate::Type::Modify;
-    else mu.type = MarketUpdate::Type::Remove;
-    
-    mu.side = update.side;
-    mu.price = update.price;
-    mu.quantity = update.quantity;
-    mu.order_count = update.order_count;
-    
-    market_queues_[getProducerQueueIndex()]->push(mu);
+    applyExternalBookUpdates(&update, 1);
+}
+
+size_t OrderBook::applyExternalBookUpdates(const BookUpdate* updates, size_t count) {
+    constexpr size_t ChunkSize = 64;
+    std::array<MarketUpdate, ChunkSize> chunk;
+
+    // One claim on the MPSC queue per chunk instead of per entry
+    size_t queued = 0;
+    while (queued < count) {
+        size_t n = std::min(ChunkSize, count - queued);
+        for (size_t i = 0; i < n; ++i) {
+            const BookUpdate& update = updates[queued + i];
+            MarketUpdate& mu = chunk[i];
+            if (update.type == BookUpdate::Type::Add) mu.type = MarketUpdate::Type::Add;
+            else if (update.type == BookUpdate::Type::Modify) mu.type = MarketUpdate::Type::Modify;
+            else mu.type = MarketUpdate::Type::Remove;
+            mu.side = update.side;
+            mu.price = update.price;
+            mu.quantity = update.quantity;
+            mu.order_count = update.order_count;
+        }
+        size_t pushed = 0;
+        while (pushed < n) {
+            size_t claimed = market_queue_->try_push_n(chunk.data() + pushed, n - pushed);
+            if (claimed == 0) break;
+            pushed += claimed;
+        }
+        queued += pushed;
+        if (pushed < n) {
+            break;  // Queue full: the rest of the delta is dropped, as single pushes were
+        }
+    }
+    if (queued > 0 && consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
+    return queued;
 }
 
 void OrderBook::clearBook() {
     MarketUpdate mu;
     mu.type = MarketUpdate::Type::SnapshotStart;
-    market_queues_[getProducerQueueIndex()]->push(mu);
+    market_queue_->push(mu);
+    if (consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
+}
+
+size_t OrderBook::drainRing(ProducerRing& ring) {
+    // Bulk pop publishes the read index once per batch rather than once per request
+    size_t drained = ring.queue.pop_n(drain_buffer_.data(), DrainBatchSize);
+    for (size_t i = 0; i < drained; ++i) {
+        dispatchRequest(drain_buffer_[i]);
+    }
+    if (drained == DrainBatchSize) {
+        // Release so a producer that sees the count also sees what dispatch published
+        ring.applied.store(ring.applied.load(std::memory_order_relaxed) + drained, std::memory_order_release);
+        return drained;
+    }
+    // The ring is empty; spilled requests are newer than anything it held
+    if (ring.overflow_size.load(std::memory_order_acquire) > 0) {
+        std::deque<OrderRequest> spilled;
+        {
+            std::lock_guard<std::mutex> lock(ring.overflow_mutex);
+            spilled.swap(ring.overflow);
+            ring.overflow_size.store(0, std::memory_order_release);
+        }
+        for (const OrderRequest& spilled_req : spilled) {
+            dispatchRequest(spilled_req);
+            ++drained;
+        }
+    }
+    if (drained > 0) {
+        ring.applied.store(ring.applied.load(std::memory_order_relaxed) + drained, std::memory_order_release);
+    }
+    return drained;
+}
+
+void OrderBook::captureImage(BookImage& image) const {
+    image.info.journal_sequence = journal_ ? journal_->lastSequence() : snapshot_sequence_;
+    image.info.trade_count = trade_count_.load(std::memory_order_relaxed);
+    image.info.next_trade_id = MatchingEngine::getTotalTradeCount() + 1;
+    image.levels.clear();
+    image.orders.clear();
+    image.orders.reserve(orders_.size());
+
+    auto captureSide = [this, &image](Side side, const auto& levels, const auto& ladder) {
+        visitLevels(options_.ladder_mode, levels, ladder, [&image, side](const PriceLevel& level) {
+            SnapshotLevel record{};
+            record.price = level.price;
+            record.total_quantity = level.total_quantity;
+            record.order_count = level.order_count;
+            record.first_order = static_cast<uint32_t>(image.orders.size());
+            record.side = static_cast<uint8_t>(side);
+            for (const Order* order = level.getFirstOrder(); order; order = order->next) {
+                SnapshotOrder stored{};
+                stored.id = order->id.value;
+                stored.price = order->price;
+                stored.quantity = order->quantity;
+                stored.filled_quantity = order->filled_quantity;
+                stored.symbol_id = order->symbol_id;
+                stored.account_id = order->account_id;
+                stored.side = static_cast<uint8_t>(order->side);
+                stored.type = static_cast<uint8_t>(order->type);
+                stored.tif = static_cast<uint8_t>(order->tif);
+                stored.status = static_cast<uint8_t>(order->status);
+                image.orders.push_back(stored);
+            }
+            record.orders = static_cast<uint32_t>(image.orders.size() - record.first_order);
+            image.levels.push_back(record);
+            return true;
+        });
+    };
+    captureSide(Side::Buy, bids_, bid_ladder_);
+    captureSide(Side::Sell, asks_, ask_ladder_);
+}
+
+void OrderBook::serviceSnapshotRequest() {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    if (!snapshot_image_) return;
+    captureImage(*snapshot_image_);
+    snapshot_image_ = nullptr;
+    snapshot_captured_ = true;
+    snapshot_requested_.store(false, std::memory_order_release);
+    snapshot_cv_.notify_all();
+}
+
+Result<BookSnapshotInfo> OrderBook::snapshot(const std::string& path) {
+    std::lock_guard<std::mutex> call_lock(snapshot_call_mutex_);
+    BookImage image;
+    if (consumer_waiter_ && consumer_waiter_->isConsumerRunning()) {
+        std::unique_lock<std::mutex> lock(snapshot_mutex_);
+        snapshot_image_ = &image;
+        snapshot_captured_ = false;
+        snapshot_requested_.store(true, std::memory_order_release);
+        consumer_waiter_->signal();
+        // A consumer stopped meanwhile never reaches another idle point: withdraw the
+        // request under the lock and copy here instead
+        while (!snapshot_cv_.wait_for(lock, SnapshotPollInterval, [this] { return snapshot_captured_; })) {
+            if (!consumer_waiter_->isConsumerRunning()) {
+                snapshot_image_ = nullptr;
+                snapshot_requested_.store(false, std::memory_order_release);
+                captureImage(image);
+                break;
+            }
+        }
+    } else {
+        captureImage(image);
+    }
+
+    auto written = writeBookSnapshot(path, image);
+    if (written.isError()) {
+        LOG_ERROR(logger_, "OrderBook::snapshot", "{}", written.error());
+        return Result<BookSnapshotInfo>::error(written.error());
+    }
+    image.info.level_count = image.levels.size();
+    image.info.order_count = image.orders.size();
+
+    size_t truncated = journal_ ? journal_->truncate(image.info.journal_sequence) : 0;
+    LOG_INFO(logger_, "OrderBook::snapshot", "Snapshot {}: {} orders, {} levels, sequence {}, {} bytes, {} journal segments dropped",
+             path, image.info.order_count, image.info.level_count, image.info.journal_sequence,
+             written.value(), truncated);
+    return Result<BookSnapshotInfo>::success(image.info);
+}
+
+Result<BookSnapshotInfo> OrderBook::loadSnapshot(const std::string& path) {
+    if (!orders_.empty() || journal_) {
+        return Result<BookSnapshotInfo>::error("Snapshots load only into an empty book without an open journal");
+    }
+    auto mapped = MappedBookSnapshot::open(path);
+    if (mapped.isError()) {
+        LOG_ERROR(logger_, "OrderBook::loadSnapshot", "{}", mapped.error());
+        return Result<BookSnapshotInfo>::error(mapped.error());
+    }
+    const MappedBookSnapshot& snapshot = *mapped.value();
+    const BookSnapshotInfo& info = snapshot.info();
+
+    for (size_t i = 0; i < info.level_count; ++i) {
+        const SnapshotLevel& stored_level = snapshot.levels()[i];
+        Side side = static_cast<Side>(stored_level.side);
+        PriceLevel* level = findOrCreatePriceLevel(stored_level.price, side);
+        if (!level) {
+            return Result<BookSnapshotInfo>::error("Cannot create level at price " + std::to_string(stored_level.price));
+        }
+        for (uint32_t n = 0; n < stored_level.orders; ++n) {
+            const SnapshotOrder& stored = snapshot.orders()[stored_level.first_order + n];
+            OrderRequest req{};
+            req.type = OrderRequest::Type::Add;
+            req.id = OrderId(stored.id);
+            req.side = static_cast<Side>(stored.side);
+            req.order_type = static_cast<OrderType>(stored.type);
+            req.tif = static_cast<TimeInForce>(stored.tif);
+            req.price = stored.price;
+            req.quantity = stored.quantity;
+            req.symbol_id = snapshot.symbol(stored.symbol_id);
+            req.account_id = snapshot.account(stored.account_id);
+            Order* order = acquireOrder(req);
+            order->filled_quantity = stored.filled_quantity;
+            order->status = static_cast<OrderStatus>(stored.status);
+            order->timestamp = TscClock::now();
+            level->addOrder(order);
+            orders_.insert(OrderLocation(order, level, side));
+        }
+        // Aggregates as they were, including any externally applied quantity
+        level->total_quantity = stored_level.total_quantity;
+        level->order_count = stored_level.order_count;
+    }
+
+    trade_count_.store(info.trade_count, std::memory_order_relaxed);
+    MatchingEngine::restoreTradeCounter(info.next_trade_id);
+    snapshot_sequence_ = info.journal_sequence;
+    depth_.invalidate();
+    publishTopOfBook();
+
+    LOG_INFO(logger_, "OrderBook::loadSnapshot", "Loaded {}: {} orders, {} levels, journal sequence {}",
+             path, info.order_count, info.level_count, info.journal_sequence);
+    return Result<BookSnapshotInfo>::success(info);
+}
+
+void OrderBook::dispatchRequest(const OrderRequest& req) {
+    // Write ahead: the command is in the journal before it touches the book
+    if (journal_) {
+        journal_->append(toJournalCommand(req));
+    }
+    if (req.trace.sampled()) {
+        applySampledRequest(req);
+    } else {
+        applyRequest(req);
+    }
+    processed_count_++;
+    if (processed_count_ % 10000 == 0) {
+        LOG_DEBUG(logger_, "OrderBook::dispatchRequest", "Consumer processed {} commands", processed_count_);
+    }
+}
+
+void OrderBook::applyRequest(const OrderRequest& req) {
+    switch (req.type) {
+        case OrderRequest::Type::Add: {
+            // Construct Order on consumer side to avoid producer allocation
+            // Allocate Order from recycle bin or heap (consumer-thread only)
+            auto created = acquireOrder(req);
+            processAddOrder(created);
+            break;
+        }
+        case OrderRequest::Type::Cancel: {
+            processCancelOrder(req.id);
+            break;
+        }
+        case OrderRequest::Type::Modify: {
+            processModifyOrder(req.id, req.price, req.quantity);
+            break;
+        }
+        case OrderRequest::Type::CancelAccount: {
+            processMassCancel(MassCancel::account(req.account_id));
+            break;
+        }
+        case OrderRequest::Type::CancelSymbol: {
+            processMassCancel(MassCancel::symbol(req.symbol_id));
+            break;
+        }
+    }
+}
+
+void OrderBook::applySampledRequest(const OrderRequest& req) {
+    TraceStamps trace;
+    trace.copyFrom(req.trace);
+    trace.stamp(TraceStage::Dequeue);
+    if (req.type == OrderRequest::Type::Add) {
+        // The order carries the trace through matching so handleFill can stamp it
+        Order* order = acquireOrder(req);
+        order->trace = trace;
+        processAddOrder(order);
+        trace = order->trace;
+        order->trace.clear();
+    } else {
+        applyRequest(req);
+    }
+    trace.stampOnce(TraceStage::Published);
+    LatencyTracer::getInstance().record(trace);
+}
+
+namespace {
+void raiseHighWaterMark(std::atomic<size_t>& mark, size_t depth) {
+    size_t current = mark.load(std::memory_order_relaxed);
+    while (depth > current && !mark.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {}
+}
+}
+
+bool OrderBook::enqueueRequest(ProducerRing& state, const OrderRequest& req) {
+    auto& queue = state.queue;
+
+    // Once a ring has spilled, keep appending to the overflow until the consumer takes it
+    if (state.overflow_size.load(std::memory_order_acquire) == 0) {
+        if (queue.push(req)) {
+            raiseHighWaterMark(state.high_water_mark, queue.size());
+            return true;
+        }
+        state.full_events.fetch_add(1, std::memory_order_relaxed);
+
+        if (options_.backpressure == BackpressurePolicy::SpinWait) {
+            for (uint32_t i = 0; i < options_.backpressure_spin_budget; ++i) {
+                cpuRelax();
+                if (queue.push(req)) {
+                    state.high_water_mark.store(OrderQueueCapacity, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+    }
+
+    if (options_.backpressure == BackpressurePolicy::Overflow) {
+        std::lock_guard<std::mutex> lock(state.overflow_mutex);
+        if (state.overflow.size() < options_.overflow_capacity) {
+            state.overflow.push_back(req);
+            state.overflow_size.store(state.overflow.size(), std::memory_order_release);
+            state.overflowed.fetch_add(1, std::memory_order_relaxed);
+            raiseHighWaterMark(state.high_water_mark, OrderQueueCapacity + state.overflow.size());
+            return true;
+        }
+    }
+
+    state.rejected.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+size_t OrderBook::enqueueBatch(ProducerRing& ring, const OrderRequest* reqs, size_t count) {
+    size_t accepted = 0;
+    if (ring.overflow_size.load(std::memory_order_acquire) == 0) {
+        // One write-index store for the whole run that fits
+        accepted = ring.queue.try_push_n(reqs, count);
+        if (accepted > 0) {
+            raiseHighWaterMark(ring.high_water_mark, ring.queue.size());
+        }
+    }
+    // Whatever did not fit goes through the backpressure policy one request at a time
+    while (accepted < count && enqueueRequest(ring, reqs[accepted])) {
+        ++accepted;
+    }
+    return accepted;
+}
+
+std::vector<OrderQueueStats> OrderBook::getOrderQueueStats() const {
+    std::vector<OrderQueueStats> stats;
+    size_t ring_count = ring_count_.load(std::memory_order_acquire);
+    stats.reserve(ring_count);
+    for (size_t i = 0; i < ring_count; ++i) {
+        const auto& state = producer_rings_[i];
+        OrderQueueStats s;
+        s.capacity = OrderQueueCapacity;
+        s.high_water_mark = state->high_water_mark.load(std::memory_order_relaxed);
+        s.full_events = state->full_events.load(std::memory_order_relaxed);
+        s.overflowed = state->overflowed.load(std::memory_order_relaxed);
+        s.rejected = state->rejected.load(std::memory_order_relaxed);
+        stats.push_back(s);
+    }
+    return stats;
 }
 
 // Core operations
+Result<OrderBook::Producer> OrderBook::registerProducer() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    size_t ring_count = ring_count_.load(std::memory_order_relaxed);
+    // Reuse a released ring first; anything its previous owner left is still drained in order
+    for (size_t i = SharedRingIndex + 1; i < ring_count; ++i) {
+        if (!producer_rings_[i]->in_use.load(std::memory_order_acquire)) {
+            producer_rings_[i]->in_use.store(true, std::memory_order_relaxed);
+            return Result<Producer>::success(Producer(this, i));
+        }
+    }
+    if (ring_count == MaxProducerRings) {
+        return Result<Producer>::error("Producer limit reached (" + std::to_string(MaxProducerRings) + " rings)");
+    }
+    producer_rings_[ring_count] = std::make_unique<ProducerRing>();
+    producer_rings_[ring_count]->in_use.store(true, std::memory_order_relaxed);
+    // Publish the ring to the consumer only once it is fully constructed
+    ring_count_.store(ring_count + 1, std::memory_order_release);
+    if (logger_) {
+        logger_->info("Registered producer ring " + std::to_string(ring_count), "OrderBook::registerProducer");
+    }
+    return Result<Producer>::success(Producer(this, ring_count));
+}
+
+size_t OrderBook::getProducerCount() const {
+    size_t ring_count = ring_count_.load(std::memory_order_acquire);
+    size_t in_use = 0;
+    for (size_t i = SharedRingIndex + 1; i < ring_count; ++i) {
+        if (producer_rings_[i]->in_use.load(std::memory_order_relaxed)) ++in_use;
+    }
+    return in_use;
+}
+
+OrderBook::Producer::Producer(Producer&& other) noexcept : book_(other.book_), ring_(other.ring_) {
+    other.book_ = nullptr;
+}
+
+OrderBook::Producer& OrderBook::Producer::operator=(Producer&& other) noexcept {
+    if (this != &other) {
+        release();
+        book_ = other.book_;
+        ring_ = other.ring_;
+        other.book_ = nullptr;
+    }
+    return *this;
+}
+
+OrderBook::Producer::~Producer() {
+    release();
+}
+
+void OrderBook::Producer::release() {
+    if (book_) {
+        // Release ordering hands the ring's producer side to whoever registers next
+        book_->producer_rings_[ring_]->in_use.store(false, std::memory_order_release);
+        book_ = nullptr;
+    }
+}
+
+uint64_t OrderBook::Producer::appliedCount() const {
+    return book_ ? book_->producer_rings_[ring_]->applied.load(std::memory_order_acquire) : 0;
+}
+
+OrderResult OrderBook::Producer::addOrder(const Order& order) {
+    if (!book_) return OrderResult::error("Producer is not registered");
+    return book_->submitAdd(*book_->producer_rings_[ring_], order);
+}
+
+CancelResult OrderBook::Producer::cancelOrder(OrderId id) {
+    if (!book_) return CancelResult::error("Producer is not registered");
+    return book_->submitCancel(*book_->producer_rings_[ring_], id);
+}
+
+ModifyResult OrderBook::Producer::modifyOrder(OrderId id, Price new_price, Quantity new_quantity) {
+    if (!book_) return ModifyResult::error("Producer is not registered");
+    return book_->submitModify(*book_->producer_rings_[ring_], id, new_price, new_quantity);
+}
+
+ModifyResult OrderBook::Producer::modifyOrder(const Order& resting, Price new_price, Quantity new_quantity) {
+    if (!book_) return ModifyResult::error("Producer is not registered");
+    return book_->submitModify(*book_->producer_rings_[ring_], resting.id, new_price, new_quantity, &resting);
+}
+
+size_t OrderBook::Producer::addOrders(const Order* orders, size_t count) {
+    if (!book_) return 0;
+    return book_->submitAddBatch(*book_->producer_rings_[ring_], orders, count);
+}
+
+size_t OrderBook::Producer::cancelOrders(const OrderId* ids, size_t count) {
+    if (!book_) return 0;
+    return book_->submitCancelBatch(*book_->producer_rings_[ring_], ids, count);
+}
+
 OrderResult OrderBook::addOrder(const Order& order) {
-    PERF_MEASURE_SCOPE("OrderBook::addOrder");
-    // Create a lightweight request (POD) and copy only small fields to avoid allocations on the producer
+    std::lock_guard<std::mutex> lock(shared_ring_mutex_);
+    return submitAdd(*producer_rings_[SharedRingIndex], order);
+}
+
+CancelResult OrderBook::cancelOrder(OrderId id) {
+    std::lock_guard<std::mutex> lock(shared_ring_mutex_);
+    return submitCancel(*producer_rings_[SharedRingIndex], id);
+}
+
+ModifyResult OrderBook::modifyOrder(OrderId id, Price new_price, Quantity new_quantity) {
+    std::lock_guard<std::mutex> lock(shared_ring_mutex_);
+    return submitModify(*producer_rings_[SharedRingIndex], id, new_price, new_quantity);
+}
+
+ModifyResult OrderBook::modifyOrder(const Order& resting, Price new_price, Quantity new_quantity) {
+    std::lock_guard<std::mutex> lock(shared_ring_mutex_);
+    return submitModify(*producer_rings_[SharedRingIndex], resting.id, new_price, new_quantity, &resting);
+}
+
+size_t OrderBook::addOrders(const Order* orders, size_t count) {
+    std::lock_guard<std::mutex> lock(shared_ring_mutex_);
+    return submitAddBatch(*producer_rings_[SharedRingIndex], orders, count);
+}
+
+size_t OrderBook::cancelOrders(const OrderId* ids, size_t count) {
+    std::lock_guard<std::mutex> lock(shared_ring_mutex_);
+    return submitCancelBatch(*producer_rings_[SharedRingIndex], ids, count);
+}
+
+CancelResult OrderBook::cancelAll(const MassCancel& filter) {
     OrderRequest req{};
+    if (filter.scope == MassCancel::Scope::Account) {
+        req.type = OrderRequest::Type::CancelAccount;
+        req.account_id = filter.key;
+    } else {
+        req.type = OrderRequest::Type::CancelSymbol;
+        req.symbol_id = filter.key;
+    }
+    {
+        std::lock_guard<std::mutex> lock(shared_ring_mutex_);
+        if (!enqueueRequest(*producer_rings_[SharedRingIndex], req)) {
+            return CancelResult::error("Order queue full", ErrorCode::QueueFull);
+        }
+    }
+    if (consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
+    return CancelResult::success(true);
+}
+
+size_t OrderBook::submitAddBatch(ProducerRing& ring, const Order* orders, size_t count) {
+    PERF_MEASURE_SCOPE("OrderBook::addOrders");
+    OrderRequest chunk[BatchChunkSize];
+    size_t source[BatchChunkSize];
+    size_t accepted = 0;
+    while (accepted < count) {
+        size_t n = std::min(BatchChunkSize, count - accepted);
+        // Risk-rejected entries are consumed and dropped from the burst
+        size_t staged = 0;
+        for (size_t i = 0; i < n; ++i) {
+            fillAddRequest(chunk[staged], orders[accepted + i]);
+            if (reserveRisk(orders[accepted + i], chunk[staged])) {
+                source[staged++] = accepted + i;
+            }
+        }
+        size_t pushed = enqueueBatch(ring, chunk, staged);
+        if (pushed < staged) {
+            for (size_t i = pushed; i < staged; ++i) releaseRisk(chunk[i]);
+            accepted = source[pushed];
+            LOG_WARN(logger_, "OrderBook::addOrders", "Order queue full, rejected {} of {} batched orders",
+                     count - accepted, count);
+            break;
+        }
+        accepted += n;
+    }
+    // One consumer wake for the whole batch
+    if (accepted > 0 && consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
+    return accepted;
+}
+
+size_t OrderBook::submitCancelBatch(ProducerRing& ring, const OrderId* ids, size_t count) {
+    PERF_MEASURE_SCOPE("OrderBook::cancelOrders");
+    OrderRequest chunk[BatchChunkSize];
+    size_t accepted = 0;
+    while (accepted < count) {
+        size_t n = std::min(BatchChunkSize, count - accepted);
+        for (size_t i = 0; i < n; ++i) {
+            chunk[i] = OrderRequest{};
+            chunk[i].type = OrderRequest::Type::Cancel;
+            chunk[i].id = ids[accepted + i];
+            LatencyTracer::getInstance().begin(chunk[i].trace, TraceStage::Enqueue);
+        }
+        size_t pushed = enqueueBatch(ring, chunk, n);
+        accepted += pushed;
+        if (pushed < n) break;
+    }
+    if (accepted > 0 && consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
+    return accepted;
+}
+
+void OrderBook::fillAddRequest(OrderRequest& req, const Order& order) {
+    // Create a lightweight request (POD) and copy only small fields to avoid allocations on the producer
+    req = OrderRequest{};
     req.type = OrderRequest::Type::Add;
     req.id = order.id;
     req.side = order.side;
     req.order_type = order.type;
     req.price = order.price;
     req.quantity = order.quantity;
-    std::memset(req.symbol, 0, sizeof(req.symbol));
-    std::memset(req.account, 0, sizeof(req.account));
-    std::strncpy(req.symbol, order.symbol, sizeof(req.symbol) - 1);
-    std::strncpy(req.account, order.account, sizeof(req.account) - 1);
-    req.tif = static_cast<int>(order.tif);
-    order_queues_[getOrderQueueIndex()]->push(req);
-    order_data_available_.store(true, std::memory_order_release);
-    queue_cv_.notify_one();
+    req.symbol_id = order.symbol_id;
+    req.account_id = order.account_id;
+    req.tif = order.tif;
+    // Orders traced from the FIX edge keep their earlier stamps; others may start here
+    req.trace.copyFrom(order.trace);
+    LatencyTracer::getInstance().begin(req.trace, TraceStage::Enqueue);
+    req.trace.stamp(TraceStage::Enqueue);
+}
+
+bool OrderBook::reserveRisk(const Order& order, OrderRequest& req, std::string* reason) {
+    if (!risk_manager_ || risk_manager_->isBypassed()) {
+        return true;
+    }
+    RiskCheck risk_check = risk_manager_->preTradeCheck(order);
+    if (risk_check.isRejected()) {
+        LOG_WARN(logger_, "OrderBook::addOrder", "Order rejected by risk manager: {} OrderID: {} Account: {}",
+                 risk_check.reason, order.id, order.account());
+        if (reason) *reason = std::move(risk_check.reason);
+        return false;
+    }
+    req.risk_reserved = true;
+    return true;
+}
+
+void OrderBook::releaseRisk(const OrderRequest& req) {
+    if (req.risk_reserved && risk_manager_) {
+        risk_manager_->adjustExposure(req.account_id, req.symbol_id, req.side,
+                                      -static_cast<int64_t>(req.quantity));
+    }
+}
+
+bool OrderBook::reserveResize(const Order& order, Price target_price, Quantity target_quantity,
+                              std::string* reason) {
+    // Only a size-up of an order holding a reservation adds exposure
+    if (target_quantity <= order.quantity || !order.risk_reserved || !risk_manager_) {
+        return true;
+    }
+    Quantity added_quantity = target_quantity - order.quantity;
+    if (risk_manager_->isBypassed()) {
+        // Unchecked, but the reservation still has to cover what fills will drain
+        risk_manager_->adjustExposure(order.account_id, order.symbol_id, order.side,
+                                      static_cast<int64_t>(added_quantity));
+        return true;
+    }
+    // The added quantity is checked like a new order at the target price
+    Order added(order.id.value, order.side, order.type, order.tif, target_price,
+                added_quantity, order.symbol_id, order.account_id);
+    RiskCheck risk_check = risk_manager_->preTradeCheck(added);
+    if (risk_check.isRejected()) {
+        LOG_WARN(logger_, "OrderBook::modifyOrder", "Size-up rejected by risk manager: {} OrderID: {} Account: {}",
+                 risk_check.reason, order.id, order.account());
+        if (reason) *reason = std::move(risk_check.reason);
+        return false;
+    }
+    return true;
+}
+
+OrderResult OrderBook::submitAdd(ProducerRing& ring, const Order& order) {
+    PERF_MEASURE_SCOPE("OrderBook::addOrder");
+    // Pre-trade risk runs here on the submitting thread, never behind matching
+    OrderRequest req;
+    fillAddRequest(req, order);
+    std::string risk_reason;
+    if (!reserveRisk(order, req, &risk_reason)) {
+        return OrderResult::error(risk_reason, ErrorCode::RiskRejected);
+    }
+    if (!enqueueRequest(ring, req)) {
+        releaseRisk(req);
+        LOG_WARN(logger_, "OrderBook::addOrder", "Order queue full, rejecting order ID: {}", order.id);
+        return OrderResult::error("Order queue full", ErrorCode::QueueFull);
+    }
+    if (consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
 
     return OrderResult::success(order.id);
 }
 
 void OrderBook::processAddOrder(Order* order_ptr) {
     PERF_MEASURE_SCOPE("OrderBook::processAddOrder");
-    // Assign timestamp here on consumer side to avoid syscalls on producer hot path
-    order_ptr->timestamp = std::chrono::system_clock::now();
+    // Stamp arrival on the consumer side (a TSC read, no clock syscall)
+    order_ptr->timestamp = TscClock::now();
+    
+    LOG_DEBUG(logger_, "OrderBook::processAddOrder", "Processing Add Order ID: {} Side: {} Price: {} Quantity: {}",
+              order_ptr->id, order_ptr->side == Side::Buy ? "Buy" : "Sell", order_ptr->price, order_ptr->quantity);
     
-    if (logger_ && logger_->isLogLevelEnabled(LogLevel::DEBUG)) {
-        logger_->debug("Processing Add Order ID: " + std::to_string(order_ptr->id.value) + 
-                      " Side: " + (order_ptr->side == Side::Buy ? "Buy" : "Sell") +
-                      " Price: " + std::to_string(order_ptr->price) +
-                      " Quantity: " + std::to_string(order_ptr->quantity), "OrderBook::processAddOrder");
+    // Check if order already exists
+    if (orders_.find(order_ptr->id) != orders_.end()) {
+        LOG_ERROR(logger_, "OrderBook::processAddOrder", "Duplicate order ID: {}", order_ptr->id);
+        order_ptr->reject();
+        order_retire_list_.push_back(order_ptr);
+        return;
     }
     
-    // Risk validation if risk manager is available
-    if (risk_manager_) {
-        if (!risk_manager_->isBypassed()) {
-            // Associate order with account
-            std::string account = (order_ptr->account[0] == '\0') ? "default" : order_ptr->account;
-            risk_manager_->associateOrderWithAccount(order_ptr->id, account);
-            
-            // Get the portfolio for the order's account
-            const Portfolio& portfolio = risk_manager_->getPortfolio(account);
-            auto risk_check = risk_manager_->validateOrder(*order_ptr, portfolio);
-            if (risk_check.isRejected()) {
-            if (logger_) {
-                logger_->error("Order rejected by risk manager: " + risk_check.reason, 
-                              "OrderBook::processAddOrder - OrderID: " + std::to_string(order_ptr->id.value) + 
-                              " Account: " + account);
-            }
+    // Batch auctions defer matching: a limit GTC order rests as is and immediate orders
+    // wait for the next auction. Fill-or-kill still executes on arrival, all or nothing.
+    bool deferred = batchAuction() && order_ptr->tif != TimeInForce::FOK;
+    if (deferred && (order_ptr->type != OrderType::Limit || order_ptr->tif != TimeInForce::GTC)) {
+        holdForAuction(order_ptr);
+        return;
+    }
+    
+    if (deferred) {
+        markAuctionPending();
+    } else {
+        // Fill-or-kill needs the whole quantity available at crossing prices up front
+        if (order_ptr->tif == TimeInForce::FOK && !canFillCompletely(*order_ptr)) {
+            order_ptr->status = OrderStatus::Cancelled;
+            LOG_DEBUG(logger_, "OrderBook::processAddOrder", "FOK order {} killed: insufficient liquidity", order_ptr->id);
+            order_retire_list_.push_back(order_ptr);
             return;
         }
         
-            if (logger_ && logger_->isLogLevelEnabled(LogLevel::DEBUG)) {
-                logger_->debug("Order passed risk validation: " + risk_check.reason, 
-                              "OrderBook::processAddOrder - OrderID: " + std::to_string(order_ptr->id.value) + 
-                              " Account: " + account);
-            }
-        } else {
-            // Bypassed - skip validation and association for maximum throughput
-        }
+        // Take liquidity first; the incoming order is not on the book while it matches
+        processMatching(*order_ptr);
     }
     
-    // Check if order already exists
-    if (order_index_.find(order_ptr->id) != order_index_.end()) {
-        if (logger_) {
-            logger_->error("Duplicate order ID: " + std::to_string(order_ptr->id.value), 
-                          "OrderBook::processAddOrder");
+    // Only a limit GTC remainder rests. Market, IOC and FOK orders never create a
+    // level or an index entry.
+    bool rests = !order_ptr->isFullyFilled() && order_ptr->type == OrderType::Limit &&
+                 order_ptr->tif == TimeInForce::GTC;
+    if (!rests) {
+        if (!order_ptr->isFullyFilled()) {
+            // Unfilled remainder of an immediate order is cancelled
+            order_ptr->status = OrderStatus::Cancelled;
+            LOG_DEBUG(logger_, "OrderBook::processAddOrder", "Order {} remainder {} cancelled (no resting)",
+                      order_ptr->id, order_ptr->remainingQuantity());
+        }
+        // Defer returning pointer to pool until end of batch
+        order_retire_list_.push_back(order_ptr);
+        if (order_ptr->filled_quantity > 0) {
+            publishMarketDataUpdate();
         }
         return;
     }
@@ -283,128 +1170,50 @@ void OrderBook::processAddOrder(Order* order_ptr) {
     // Find or create price level
     PriceLevel* price_level = findOrCreatePriceLevel(order_ptr->price, order_ptr->side);
     if (!price_level) {
-        if (logger_) {
-            logger_->error("Failed to create price level for price: " + std::to_string(order_ptr->price) +
-                          " side: " + (order_ptr->side == Side::Buy ? "Buy" : "Sell"), 
-                          "OrderBook::processAddOrder - OrderID: " + std::to_string(order_ptr->id.value));
-        }
+        LOG_ERROR(logger_, "OrderBook::processAddOrder", "Failed to create price level for price: {} side: {} OrderID: {}",
+                  order_ptr->price, order_ptr->side == Side::Buy ? "Buy" : "Sell", order_ptr->id);
+        order_retire_list_.push_back(order_ptr);
         return;
     }
     
-    // Add order to price level (price level uses raw pointers for speed)
-    // Use raw pointer for order now
-    Order* order_raw = order_ptr;
-    price_level->addOrder(order_raw);
+    // Rest the remainder (price level uses raw pointers for speed)
+    price_level->addOrder(order_ptr);
+    depth_.update(order_ptr->side, *price_level);
 
     // Add to order index for fast lookup - consumer owns raw pointer until removed
-    OrderLocation location(order_raw, price_level, order_raw->side);
-    order_index_[order_raw->id] = location;
-    
-    // Maintain sorted order - optimization: findOrCreatePriceLevel already maintains order
-    // maintainSortedOrder();
-    
-    // Publish book update for order addition
-    publishBookUpdate(BookUpdate::Type::Add, order_raw->side, order_raw->price, 
-                     order_raw->remainingQuantity(), price_level->order_count);
-    
-    // Check for immediate matching opportunities
-    processMatching(*order_raw);
+    orders_.insert(OrderLocation(order_ptr, price_level, order_ptr->side));
     
-    // Handle aggressive order updates after matching
-    // After matching, the price level may have been removed. Re-query the current level.
-    PriceLevel* current_level = nullptr;
-    {
-        auto p_it = price_index_.find(order_raw->price);
-        if (p_it != price_index_.end()) current_level = p_it->second;
-    }
-
-    if (order_raw->filled_quantity > 0) {
-        // Update price level total quantity to reflect the fill
-        // Note: We must be careful not to double-count if we remove the order later
-        // The safest way is to update the price level's quantity to match the order's new state
-        // But PriceLevel::updateQuantity is designed for this
-        
-        if (current_level) current_level->updateQuantity(order_raw, order_raw->filled_quantity);
-        
-        // If fully filled, updateQuantity already removed it from the list?
-        // Let's check PriceLevel::updateQuantity implementation
-        // void updateQuantity(Order* order, Quantity filled_quantity) {
-        //     if (filled_quantity <= total_quantity) total_quantity -= filled_quantity;
-        //     if (order->isFullyFilled()) removeOrder(order);
-        // }
-        
-        // So updateQuantity handles removal from the linked list!
-        // But we still need to handle OrderIndex and Memory cleanup.
-        
-            if (order_raw->isFullyFilled()) {
-            // Publish book update for removal
-            publishBookUpdate(BookUpdate::Type::Remove, order_raw->side, order_raw->price, 
-                             0, current_level ? current_level->order_count : 0); // order_count is already updated by removeOrder
-            
-            // Clean up empty price level
-            if (current_level && current_level->isEmpty()) {
-                // The level may have already been removed by matching. Check the
-                // price index to ensure the pointer is still valid before removal.
-                auto p_it = price_index_.find(order_raw->price);
-                if (p_it != price_index_.end() && p_it->second == current_level) {
-                    removePriceLevel(current_level, order_raw->side);
-                }
-            }
-            
-            // Remove from order index; defer free until batch end to avoid reuse mid-processing
-            auto it = order_index_.find(order_raw->id);
-            if (it != order_index_.end()) {
-                order_index_.erase(it);
-            }
-
-            // Defer returning pointer to pool until end of batch
-            order_retire_list_.push_back(order_raw);
-            
-            // Set order_raw to null to avoid using it
-            order_raw = nullptr;
-        } else {
-            // Partially filled
-             publishBookUpdate(BookUpdate::Type::Modify, order_raw->side, order_raw->price, 
-                              order_raw->remainingQuantity(), current_level ? current_level->order_count : 0);
-        }
-    }
+    // Publish book update for the resting quantity
+    publishBookUpdate(BookUpdate::Type::Add, order_ptr->side, *price_level);
     
     // Publish market data update (best prices and depth)
     publishMarketDataUpdate();
-    
-    /*
-    if (logger_ && order_raw) { // Check order_raw validity
-        logger_->info("Order added successfully ID: " + std::to_string(order_raw->id.value), 
-                     "OrderBook::processAddOrder");
-    }
-    */
 }
 
-CancelResult OrderBook::cancelOrder(OrderId id) {
+CancelResult OrderBook::submitCancel(ProducerRing& ring, OrderId id) {
     PERF_MEASURE_SCOPE("OrderBook::cancelOrder");
     OrderRequest req;
     req.type = OrderRequest::Type::Cancel;
     req.id = id;
-    order_queues_[getOrderQueueIndex()]->push(req);
-    order_data_available_.store(true, std::memory_order_release);
-    queue_cv_.notify_one();
+    LatencyTracer::getInstance().begin(req.trace, TraceStage::Enqueue);
+    if (!enqueueRequest(ring, req)) {
+        return CancelResult::error("Order queue full", ErrorCode::QueueFull);
+    }
+    if (consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
     return CancelResult::success(true);
 }
 
 void OrderBook::processCancelOrder(OrderId id) {
     PERF_MEASURE_SCOPE("OrderBook::processCancelOrder");
     
-    if (logger_ && logger_->isLogLevelEnabled(LogLevel::DEBUG)) {
-        logger_->debug("Processing Cancel Order ID: " + std::to_string(id.value), "OrderBook::processCancelOrder");
-    }
+    LOG_DEBUG(logger_, "OrderBook::processCancelOrder", "Processing Cancel Order ID: {}", id);
     
     // Find order in index
-    auto it = order_index_.find(id);
-    if (it == order_index_.end()) {
-        if (logger_) {
-            logger_->warn("Cancel requested for non-existent order ID: " + std::to_string(id.value), 
-                         "OrderBook::processCancelOrder");
-        }
+    auto it = orders_.find(id);
+    if (it == orders_.end()) {
+        LOG_WARN(logger_, "OrderBook::processCancelOrder", "Cancel requested for non-existent order ID: {}", id);
         return;
     }
     
@@ -413,22 +1222,16 @@ void OrderBook::processCancelOrder(OrderId id) {
         return;
     }
     
-    // Store order details before removal for book update
-    Side order_side = location.order->side;
-    Price order_price = location.order->price;
-    Quantity remaining_qty = location.order->remainingQuantity();
-    
     // Remove from price level
     location.price_level->removeOrder(location.order);
+    depth_.update(location.side, *location.price_level);
     
     // Publish book update for order removal
-    publishBookUpdate(BookUpdate::Type::Remove, order_side, order_price, 
-                     remaining_qty, location.price_level->order_count);
+    publishBookUpdate(BookUpdate::Type::Remove, location.side, *location.price_level);
     
     // Clean up empty price level (guard against double removal by another path)
     if (location.price_level->isEmpty()) {
-        auto p_it = price_index_.find(location.price_level->price);
-        if (p_it != price_index_.end() && p_it->second == location.price_level) {
+        if (findPriceLevel(location.price_level->price, location.side) == location.price_level) {
             removePriceLevel(location.price_level, location.side);
         }
     }
@@ -436,42 +1239,128 @@ void OrderBook::processCancelOrder(OrderId id) {
     // Remove from order index
     // Defer returning the pooled object until end of batch to avoid reuse mid-processing
     order_retire_list_.push_back(location.order);
-    order_index_.erase(it);
+    orders_.erase(it);
     
     // Publish market data update (best prices and depth)
     publishMarketDataUpdate();
     
-    if (logger_) {
-        logger_->info("Order canceled successfully ID: " + std::to_string(id.value), 
-                     "OrderBook::processCancelOrder");
+    LOG_INFO(logger_, "OrderBook::processCancelOrder", "Order canceled successfully ID: {}", id);
+}
+
+void OrderBook::processMassCancel(const MassCancel& filter) {
+    PERF_MEASURE_SCOPE("OrderBook::processMassCancel");
+    bool by_account = filter.scope == MassCancel::Scope::Account;
+    auto matches = [&](const Order& order) {
+        return by_account ? order.account_id == filter.key : order.symbol_id == filter.key;
+    };
+
+    // The store's account and symbol lists give the orders directly; copy them out,
+    // since erasing edits the lists
+    mass_cancel_orders_.clear();
+    if (by_account) {
+        for (Order* order = orders_.accountOrders(filter.key); order; order = order->account_next) {
+            mass_cancel_orders_.push_back(order);
+        }
+    } else {
+        const auto& symbol_orders = orders_.symbolOrders(filter.key);
+        mass_cancel_orders_.assign(symbol_orders.begin(), symbol_orders.end());
+    }
+
+    // Unlink everything first, remembering each touched level
+    mass_cancel_levels_.clear();
+    for (Order* order : mass_cancel_orders_) {
+        auto it = orders_.find(order->id);
+        if (it == orders_.end()) continue;
+        PriceLevel* level = it->second.price_level;
+        if (level) {
+            mass_cancel_levels_.push_back({level, order->side, order->price});
+            level->removeOrder(order);
+        }
+        order->cancel();
+        order_retire_list_.push_back(order);
+        orders_.erase(it);
+    }
+
+    // Held immediate orders (batch auction mode) go too
+    for (auto& held : auction_held_) {
+        auto kept = std::remove_if(held.begin(), held.end(), [&](Order* order) {
+            if (!matches(*order)) return false;
+            order->cancel();
+            order_retire_list_.push_back(order);
+            return true;
+        });
+        held.erase(kept, held.end());
+    }
+
+    // One Remove per touched level, carrying what is left on it, in (side, price) order
+    // so a live run and a journal replay publish the same sequence
+    std::sort(mass_cancel_levels_.begin(), mass_cancel_levels_.end(),
+              [](const MassCancelLevel& a, const MassCancelLevel& b) {
+                  return a.side != b.side ? a.side < b.side : a.price < b.price;
+              });
+    mass_cancel_levels_.erase(std::unique(mass_cancel_levels_.begin(), mass_cancel_levels_.end(),
+                                          [](const MassCancelLevel& a, const MassCancelLevel& b) {
+                                              return a.side == b.side && a.price == b.price;
+                                          }),
+                              mass_cancel_levels_.end());
+    for (const MassCancelLevel& entry : mass_cancel_levels_) {
+        depth_.update(entry.side, *entry.level);
+        publishBookUpdate(BookUpdate::Type::Remove, entry.side, *entry.level);
+    }
+    // Emptied levels are only reclaimed once every update has read its level
+    for (const MassCancelLevel& entry : mass_cancel_levels_) {
+        if (entry.level->isEmpty() && findPriceLevel(entry.price, entry.side) == entry.level) {
+            removePriceLevel(entry.level, entry.side);
+        }
+    }
+
+    if (!mass_cancel_orders_.empty()) {
+        publishMarketDataUpdate();
     }
+    LOG_INFO(logger_, "OrderBook::processMassCancel", "Mass cancel by {} {}: {} orders, {} levels",
+             by_account ? "account" : "symbol", filter.key, mass_cancel_orders_.size(), mass_cancel_levels_.size());
 }
 
-ModifyResult OrderBook::modifyOrder(OrderId id, Price new_price, Quantity new_quantity) {
+ModifyResult OrderBook::submitModify(ProducerRing& ring, OrderId id, Price new_price, Quantity new_quantity,
+                                     const Order* resting) {
     PERF_MEASURE_SCOPE("OrderBook::modifyOrder");
+    if (resting) {
+        // Refuse a failing size-up here; the consumer re-checks and reserves when it applies
+        Price target_price = new_price > 0 ? new_price : resting->price;
+        Quantity target_quantity = new_quantity > 0 ? new_quantity : resting->quantity;
+        std::string risk_reason;
+        if (!reserveResize(*resting, target_price, target_quantity, &risk_reason)) {
+            return ModifyResult::error(risk_reason, ErrorCode::RiskRejected);
+        }
+        if (target_quantity > resting->quantity && resting->risk_reserved && risk_manager_) {
+            risk_manager_->adjustExposure(resting->account_id, resting->symbol_id, resting->side,
+                                          -static_cast<int64_t>(target_quantity - resting->quantity));
+        }
+    }
     OrderRequest req;
     req.type = OrderRequest::Type::Modify;
     req.id = id;
     req.price = new_price;
     req.quantity = new_quantity;
-    order_queues_[getOrderQueueIndex()]->push(req);
-    order_data_available_.store(true, std::memory_order_release);
-    queue_cv_.notify_one();
+    LatencyTracer::getInstance().begin(req.trace, TraceStage::Enqueue);
+    if (!enqueueRequest(ring, req)) {
+        return ModifyResult::error("Order queue full", ErrorCode::QueueFull);
+    }
+    if (consumer_waiter_) {
+        consumer_waiter_->signal();
+    }
     return ModifyResult::success(true);
 }
 
 void OrderBook::processModifyOrder(OrderId id, Price new_price, Quantity new_quantity) {
     PERF_MEASURE_SCOPE("OrderBook::processModifyOrder");
     
-    if (logger_ && logger_->isLogLevelEnabled(LogLevel::DEBUG)) {
-        logger_->debug("Processing Modify Order ID: " + std::to_string(id.value) +
-                      " New Price: " + std::to_string(new_price) +
-                      " New Quantity: " + std::to_string(new_quantity), "OrderBook::processModifyOrder");
-    }
+    LOG_DEBUG(logger_, "OrderBook::processModifyOrder", "Processing Modify Order ID: {} New Price: {} New Quantity: {}",
+              id, new_price, new_quantity);
     
     // Find order in index
-    auto it = order_index_.find(id);
-    if (it == order_index_.end()) {
+    auto it = orders_.find(id);
+    if (it == orders_.end()) {
         return;
     }
     
@@ -481,178 +1370,255 @@ void OrderBook::processModifyOrder(OrderId id, Price new_price, Quantity new_qua
     }
     
     Order* order = location.order;
+    Price target_price = new_price > 0 ? new_price : order->price;
+    Quantity target_quantity = new_quantity > 0 ? new_quantity : order->quantity;
     
-    // If price is changing, we need to move the order to a different price level
-    if (new_price > 0 && std::abs(order->price - new_price) > MinPriceIncrement) {
-        // Store old details for book update
-        Price old_price = order->price;
-        Quantity old_remaining = order->remainingQuantity();
-        
-        // Remove from current price level
-        location.price_level->removeOrder(order);
-        
-        // Publish book update for removal from old price level
-        publishBookUpdate(BookUpdate::Type::Remove, order->side, old_price, 
-                         old_remaining, location.price_level->order_count);
-        
-        // Clean up empty price level
-        if (location.price_level->isEmpty()) {
-            auto p_it = price_index_.find(location.price_level->price);
-            if (p_it != price_index_.end() && p_it->second == location.price_level) {
-                removePriceLevel(location.price_level, location.side);
-            }
+    // Sizing down to or below the filled amount leaves nothing to rest
+    if (target_quantity <= order->filled_quantity) {
+        processCancelOrder(id);
+        return;
+    }
+    
+    bool price_change = target_price != order->price;
+    // A level the reprice reserved that ends up with nothing resting on it
+    auto releaseTargetLevel = [this](PriceLevel* target, Price price, Side side) {
+        if (target->isEmpty() && findPriceLevel(price, side) == target) {
+            removePriceLevel(target, side);
         }
-        
-        // Update order price
-        order->price = new_price;
-        
-        // Find or create new price level
-        PriceLevel* new_price_level = findOrCreatePriceLevel(new_price, order->side);
-        if (!new_price_level) {
-            // Restore order to original price level if new level creation fails
-            order->price = old_price;
-            location.price_level->addOrder(order);
+    };
+    
+    // Reserve the target level before anything changes: if it cannot be created the
+    // modify is dropped with the order untouched, and a ladder recenter here cannot
+    // leave the level pointer below stale
+    PriceLevel* new_level = nullptr;
+    if (price_change) {
+        new_level = findOrCreatePriceLevel(target_price, order->side);
+        if (!new_level) {
+            LOG_ERROR(logger_, "OrderBook::processModifyOrder", "Failed to create price level for price: {} OrderID: {}",
+                      target_price, id);
             return;
         }
-        
-        // Add to new price level
-        new_price_level->addOrder(order);
-        
-        // Publish book update for addition to new price level
-        publishBookUpdate(BookUpdate::Type::Add, order->side, new_price, 
-                         order->remainingQuantity(), new_price_level->order_count);
-        
-        // Update order index - keep owning shared_ptr and update price level pointer
-        order_index_[id] = OrderLocation(location.order, new_price_level, order->side);
+    }
+    PriceLevel* level = location.price_level;
+    
+    // A size-up reserves the added quantity or the modify is dropped; a size-down
+    // releases what it removes
+    if (target_quantity > order->quantity) {
+        if (!reserveResize(*order, target_price, target_quantity)) {
+            if (new_level) releaseTargetLevel(new_level, target_price, order->side);
+            return;
+        }
+    } else if (order->risk_reserved && risk_manager_) {
+        risk_manager_->adjustExposure(order->account_id, order->symbol_id, order->side,
+                                      static_cast<int64_t>(target_quantity) - static_cast<int64_t>(order->quantity));
     }
     
-    // Update quantity if specified
-    if (new_quantity > 0) {
-        // Store old quantity for book update
+    if (!price_change && target_quantity <= order->quantity) {
+        // Size-down fast path: update in place and keep queue priority
         Quantity old_remaining = order->remainingQuantity();
+        order->quantity = target_quantity;
+        level->total_quantity -= old_remaining - order->remainingQuantity();
+        depth_.update(order->side, *level);
+        
+        publishBookUpdate(BookUpdate::Type::Modify, order->side, *level);
+    } else if (!price_change) {
+        // Size-up loses priority: move to the back of the same level
+        level->removeOrder(order);
+        order->quantity = target_quantity;
+        level->addOrder(order);
+        depth_.update(order->side, *level);
+        
+        publishBookUpdate(BookUpdate::Type::Modify, order->side, *level);
+    } else {
+        // Price change: one unlink, one link, one index update; the Order itself is reused
+        Price old_price = order->price;
+        level->removeOrder(order);
+        depth_.update(order->side, *level);
+        publishBookUpdate(BookUpdate::Type::Remove, order->side, *level);
+        if (level->isEmpty() && findPriceLevel(old_price, location.side) == level) {
+            removePriceLevel(level, location.side);
+        }
         
-        // Update price level quantity
-        PriceLevel* current_level = order_index_[id].price_level;
-        current_level->total_quantity -= old_remaining;
+        order->price = target_price;
+        order->quantity = target_quantity;
         
-        order->quantity = new_quantity;
-        // Reset filled quantity if new quantity is smaller
-        if (order->filled_quantity > new_quantity) {
-            order->filled_quantity = new_quantity;
+        // A repriced order that crosses takes liquidity like a new one (at the next
+        // auction in batch mode)
+        if (batchAuction()) {
+            markAuctionPending();
+        } else {
+            processMatching(*order);
+        }
+        auto current = orders_.find(id);  // fills may have shifted the index
+        if (order->isFullyFilled()) {
+            orders_.erase(current);
+            order_retire_list_.push_back(order);
+            releaseTargetLevel(new_level, target_price, order->side);
+            publishMarketDataUpdate();
+            return;
         }
         
-        current_level->total_quantity += order->remainingQuantity();
+        // Matching only consumed the other side, so the reserved level is still in place
+        new_level->addOrder(order);
+        depth_.update(order->side, *new_level);
+        current->second.price_level = new_level;
         
-        // Publish book update for quantity modification
-        publishBookUpdate(BookUpdate::Type::Modify, order->side, order->price, 
-                         order->remainingQuantity(), current_level->order_count);
+        publishBookUpdate(BookUpdate::Type::Add, order->side, *new_level);
     }
     
     // Publish market data update
     publishMarketDataUpdate();
     
-    if (logger_) {
-        logger_->info("Order modified successfully ID: " + std::to_string(id.value), 
-                     "OrderBook::processModifyOrder");
-    }
+    LOG_INFO(logger_, "OrderBook::processModifyOrder", "Order modified successfully ID: {}", id);
 }
 
-// Market data queries with O(1) performance
+// Market data queries: lock-free reads of the consumer's published snapshot
 std::optional<Price> OrderBook::bestBid() const {
     PERF_MEASURE("OrderBook::bestBid");
-    for (auto it = bids_.rbegin(); it != bids_.rend(); ++it) {
-        if (!(*it)->isEmpty()) return (*it)->price;
-    }
-    return std::nullopt;
+    BookTop top = top_.load();
+    if (top.bid_count == 0) return std::nullopt;
+    return top.bids[0].price;
 }
 
 std::optional<Price> OrderBook::bestAsk() const {
     PERF_MEASURE("OrderBook::bestAsk");
-    for (auto it = asks_.rbegin(); it != asks_.rend(); ++it) {
-        if (!(*it)->isEmpty()) return (*it)->price;
-    }
-    return std::nullopt;
+    BookTop top = top_.load();
+    if (top.ask_count == 0) return std::nullopt;
+    return top.asks[0].price;
 }
 
 BestPrices OrderBook::getBestPrices() const {
+    BookTop top = top_.load();
     BestPrices prices;
-    prices.timestamp = std::chrono::system_clock::now();
-    
-    for (auto it = bids_.rbegin(); it != bids_.rend(); ++it) {
-        if (!(*it)->isEmpty()) {
-            prices.bid = (*it)->price;
-            prices.bid_size = (*it)->total_quantity;
-            break;
-        }
+    prices.timestamp = top.timestamp;
+    if (top.bid_count > 0) {
+        prices.bid = top.bids[0].price;
+        prices.bid_size = top.bids[0].quantity;
     }
-    
-    for (auto it = asks_.rbegin(); it != asks_.rend(); ++it) {
-        if (!(*it)->isEmpty()) {
-            prices.ask = (*it)->price;
-            prices.ask_size = (*it)->total_quantity;
-            break;
-        }
+    if (top.ask_count > 0) {
+        prices.ask = top.asks[0].price;
+        prices.ask_size = top.asks[0].quantity;
     }
-    
     return prices;
 }
 
 MarketDepth OrderBook::getDepth(size_t levels) const {
+    BookTop top = top_.load();
     MarketDepth depth;
-    depth.timestamp = std::chrono::system_clock::now();
-    
-    // Get bid levels (highest to lowest)
-    size_t count = 0;
-    for (auto it = bids_.rbegin(); it != bids_.rend() && count < levels; ++it) {
-        if ((*it)->isEmpty()) continue;
-        depth.bids.emplace_back(MarketDepth::Level{
-            (*it)->price, 
-            (*it)->total_quantity, 
-            (*it)->order_count
-        });
-        count++;
-    }
-    
-    // Get ask levels (lowest to highest)
-    count = 0;
-    for (auto it = asks_.rbegin(); it != asks_.rend() && count < levels; ++it) {
-        if ((*it)->isEmpty()) continue;
-        depth.asks.emplace_back(MarketDepth::Level{
-            (*it)->price, 
-            (*it)->total_quantity, 
-            (*it)->order_count
-        });
-        count++;
-    }
-    
+    depth.timestamp = top.timestamp;
+    depth.bids.assign(top.bids.begin(), top.bids.begin() + std::min<size_t>(levels, top.bid_count));
+    depth.asks.assign(top.asks.begin(), top.asks.begin() + std::min<size_t>(levels, top.ask_count));
     return depth;
 }
 
+void OrderBook::refreshDepthCache() {
+    auto refill = [this](Side side, const auto& levels, const auto& ladder) {
+        if (!depth_.stale(side)) return;
+        depth_.beginRefill(side);
+        visitLevels(options_.ladder_mode, levels, ladder, [this, side](const PriceLevel& level) {
+            return depth_.append(side, level);
+        });
+    };
+    refill(Side::Buy, bids_, bid_ladder_);
+    refill(Side::Sell, asks_, ask_ladder_);
+}
+
+void OrderBook::publishTopOfBook() {
+    refreshDepthCache();
+    const DepthCache::SideDepth& bids = depth_.side(Side::Buy);
+    const DepthCache::SideDepth& asks = depth_.side(Side::Sell);
+#ifndef NDEBUG
+    // The cache must match a full walk of the live levels
+    size_t checked = 0;
+    visitLevels(options_.ladder_mode, bids_, bid_ladder_, [&](const PriceLevel& level) {
+        assert(checked < bids.count && bids.levels[checked].price == level.price &&
+               bids.levels[checked].quantity == level.total_quantity && "bid depth cache out of date");
+        return ++checked < DepthCache::Capacity;
+    });
+    assert(checked == bids.count && "bid depth cache out of date");
+    checked = 0;
+    visitLevels(options_.ladder_mode, asks_, ask_ladder_, [&](const PriceLevel& level) {
+        assert(checked < asks.count && asks.levels[checked].price == level.price &&
+               asks.levels[checked].quantity == level.total_quantity && "ask depth cache out of date");
+        return ++checked < DepthCache::Capacity;
+    });
+    assert(checked == asks.count && "ask depth cache out of date");
+#endif
+
+    BookTop top;
+    std::copy_n(bids.levels.begin(), bids.count, top.bids.begin());
+    std::copy_n(asks.levels.begin(), asks.count, top.asks.begin());
+    top.bid_count = static_cast<uint16_t>(bids.count);
+    top.ask_count = static_cast<uint16_t>(asks.count);
+    top.bid_dirty = pending_top_dirty_[0] | depth_.consumeDirty(Side::Buy);
+    top.ask_dirty = pending_top_dirty_[1] | depth_.consumeDirty(Side::Sell);
+    pending_top_dirty_[0] = pending_top_dirty_[1] = 0;
+    top.bid_level_count = static_cast<uint32_t>(options_.ladder_mode ? bid_ladder_.activeLevelCount() : bids_.size());
+    top.ask_level_count = static_cast<uint32_t>(options_.ladder_mode ? ask_ladder_.activeLevelCount() : asks_.size());
+    top.order_count = orders_.size();
+    // top_ counts its default-constructed value as one store, so this is the batch number
+    top.version = top_.version();
+    top.timestamp = TscClock::now();
+    top_.store(top);
+}
+
 // Statistics
 size_t OrderBook::getOrderCount() const {
-    return order_index_.size();
+    return top_.load().order_count;
 }
 
 size_t OrderBook::getBidLevelCount() const {
-    return bids_.size();
+    return top_.load().bid_level_count;
 }
 
 size_t OrderBook::getAskLevelCount() const {
-    return asks_.size();
+    return top_.load().ask_level_count;
+}
+
+size_t OrderBook::getTombstoneLevelCount() const {
+    return bid_tombstones_ + ask_tombstones_;
 }
 
 // Helper methods for price level management
+PriceLevel* OrderBook::findPriceLevel(Price price, Side side) {
+    if (options_.ladder_mode) {
+        return (side == Side::Buy) ? bid_ladder_.find(price) : ask_ladder_.find(price);
+    }
+    auto& index = (side == Side::Buy) ? bid_index_ : ask_index_;
+    auto it = index.find(price);
+    return it != index.end() ? it->second : nullptr;
+}
+
 PriceLevel* OrderBook::findOrCreatePriceLevel(Price price, Side side) {
+    if (options_.ladder_mode) {
+        PriceLadder& ladder = (side == Side::Buy) ? bid_ladder_ : ask_ladder_;
+        uint64_t generation = ladder.generation();
+        PriceLevel* level = ladder.findOrCreate(price);
+        if (ladder.generation() != generation) {
+            // Recentering moved the levels; resting orders need their level pointers updated
+            relinkOrderLocations(ladder);
+            LOG_INFO(logger_, "OrderBook::findOrCreatePriceLevel", "Recentered {} ladder at base {} with {} levels",
+                     side == Side::Buy ? "bid" : "ask", ladder.basePrice(), ladder.capacity());
+        }
+        return level;
+    }
+    
     // Check if price level already exists in index
-    auto it = price_index_.find(price);
-    if (it != price_index_.end()) {
+    auto& index = (side == Side::Buy) ? bid_index_ : ask_index_;
+    auto it = index.find(price);
+    if (it != index.end()) {
         // Verify the price level is still valid
         PriceLevel* level = it->second;
-        if (level && std::abs(level->price - price) < MinPriceIncrement) {
+        if (level && level->price == price) {
+            if (level->tombstone) {
+                // Reuse the emptied level in place
+                level->tombstone = false;
+                --((side == Side::Buy) ? bid_tombstones_ : ask_tombstones_);
+            }
             return level;
         }
         // Remove invalid entry
-        price_index_.erase(it);
+        index.erase(it);
     }
     
     // Create new price level
@@ -679,47 +1645,91 @@ PriceLevel* OrderBook::findOrCreatePriceLevel(Price price, Side side) {
     PriceLevel* new_level = inserted_it->get();
     
     // Add to price index for O(1) lookup
-    price_index_[price] = new_level;
+    index[price] = new_level;
     
-    if (logger_) {
-        logger_->debug("Created new price level at " + std::to_string(price) + 
-                      " for " + (side == Side::Buy ? "bids" : "asks"), 
-                      "OrderBook::findOrCreatePriceLevel");
-    }
+    LOG_DEBUG(logger_, "OrderBook::findOrCreatePriceLevel", "Created new price level at {} for {}",
+              price, side == Side::Buy ? "bids" : "asks");
     
     return new_level;
 }
 
+void OrderBook::relinkOrderLocations(PriceLadder& ladder) {
+    ladder.forEachLevel([this](PriceLevel& level) {
+        for (Order* order = level.getFirstOrder(); order; order = order->next) {
+            auto it = orders_.find(order->id);
+            if (it != orders_.end()) {
+                it->second.price_level = &level;
+            }
+        }
+        return true;
+    });
+}
+
 void OrderBook::removePriceLevel(PriceLevel* level, Side side) {
-    // Optimization: Do not remove price levels from vector to avoid O(N) shift operations.
-    // Empty levels are skipped during matching and market data generation.
-    // This makes cancellation O(1) and allows reuse of price levels (avoiding allocation).
-    
-    /*
-    if (!level) return;
-    
-    // Verify the level is actually empty before removing
-    if (!level->isEmpty()) return;
+    if (options_.ladder_mode) {
+        // Ladder slots are reused in place, so empty levels are deactivated immediately
+        if (level && level->isEmpty()) {
+            ((side == Side::Buy) ? bid_ladder_ : ask_ladder_).remove(level);
+        }
+        return;
+    }
     
-    Price price = level->price;
+    if (!level || !level->isEmpty()) return;
     
-    // Remove from price index first
-    auto index_it = price_index_.find(price);
-    if (index_it != price_index_.end()) {
-        price_index_.erase(index_it);
+    // The best level sits at the back and can be popped without shifting. Anything
+    // deeper stays as a tombstone (keeping cancel O(1)) until compactPriceLevels().
+    auto& levels = (side == Side::Buy) ? bids_ : asks_;
+    if (!levels.empty() && levels.back().get() == level) {
+        popEmptyBestLevels(level, side);
+        return;
     }
     
-    // Remove from appropriate vector
+    if (!level->tombstone) {
+        level->tombstone = true;
+        ++((side == Side::Buy) ? bid_tombstones_ : ask_tombstones_);
+    }
+}
+
+void OrderBook::popEmptyBestLevels(PriceLevel* level, Side side) {
     auto& levels = (side == Side::Buy) ? bids_ : asks_;
+    auto& index = (side == Side::Buy) ? bid_index_ : ask_index_;
+    size_t& tombstones = (side == Side::Buy) ? bid_tombstones_ : ask_tombstones_;
+    
+    // Pop the emptied best level plus any tombstones it exposes
+    while (!levels.empty()) {
+        PriceLevel* back = levels.back().get();
+        if (back != level && !(back->tombstone && back->isEmpty())) break;
+        if (back->tombstone) --tombstones;
+        auto index_it = index.find(back->price);
+        if (index_it != index.end() && index_it->second == back) {
+            index.erase(index_it);
+        }
+        levels.pop_back();
+    }
+}
+
+void OrderBook::compactPriceLevels() {
+    auto compact = [](std::vector<std::unique_ptr<PriceLevel>>& levels,
+                      std::unordered_map<Price, PriceLevel*>& index, size_t& tombstones) {
+        if (tombstones == 0) return;
+        auto keep_end = std::remove_if(levels.begin(), levels.end(),
+            [&index](const std::unique_ptr<PriceLevel>& level) {
+                if (!level->tombstone || !level->isEmpty()) return false;
+                auto index_it = index.find(level->price);
+                if (index_it != index.end() && index_it->second == level.get()) {
+                    index.erase(index_it);
+                }
+                return true;
+            });
+        levels.erase(keep_end, levels.end());
+        tombstones = 0;
+    };
     
-    // Find and remove the level efficiently
-    auto it = std::find_if(levels.begin(), levels.end(),
-        [level](const std::unique_ptr<PriceLevel>& pl) { return pl.get() == level; });
+    size_t before = getTombstoneLevelCount();
+    compact(bids_, bid_index_, bid_tombstones_);
+    compact(asks_, ask_index_, ask_tombstones_);
     
-    if (it != levels.end()) {
-        levels.erase(it);
-    }
-    */
+    LOG_DEBUG(logger_, "OrderBook::compactPriceLevels", "Compacted {} empty price levels", before);
 }
 
 void OrderBook::maintainSortedOrder() {
@@ -762,196 +1772,190 @@ void OrderBook::maintainSortedOrder() {
 }
 
 void OrderBook::rebuildPriceIndex() {
-    price_index_.clear();
+    bid_index_.clear();
+    ask_index_.clear();
     
     // Add all bid levels to index
     for (auto& level : bids_) {
-        price_index_[level->price] = level.get();
+        bid_index_[level->price] = level.get();
     }
     
     // Add all ask levels to index
     for (auto& level : asks_) {
-        price_index_[level->price] = level.get();
+        ask_index_[level->price] = level.get();
     }
     
-    if (logger_) {
-        logger_->debug("Rebuilt price index with " + std::to_string(price_index_.size()) + 
-                      " levels", "OrderBook::rebuildPriceIndex");
-    }
+    LOG_DEBUG(logger_, "OrderBook::rebuildPriceIndex", "Rebuilt price index with {} levels",
+              bid_index_.size() + ask_index_.size());
 }
 
 void OrderBook::publishMarketDataUpdate() {
-    if (market_data_) {
-        // Publish best prices with sub-10μs latency requirement
-        BestPrices prices = getBestPrices();
+    if (!market_data_) return;
+    // Batch auctions publish once at the end of the drain
+    if (batchAuction()) {
+        market_data_due_ = true;
+        return;
+    }
+    emitMarketDataUpdate();
+}
+
+void OrderBook::emitMarketDataUpdate() {
+    market_data_due_ = false;
+    if (!market_data_) return;
+    refreshDepthCache();
+    DepthCache::DirtyMask bid_dirty = depth_.consumeDirty(Side::Buy);
+    DepthCache::DirtyMask ask_dirty = depth_.consumeDirty(Side::Sell);
+    // The per-batch reader snapshot still reports these slots
+    pending_top_dirty_[0] |= bid_dirty;
+    pending_top_dirty_[1] |= ask_dirty;
+    const DepthCache::SideDepth& bids = depth_.side(Side::Buy);
+    const DepthCache::SideDepth& asks = depth_.side(Side::Sell);
+    Timestamp now = TscClock::now();
+
+    // Best prices only when a best level changed
+    if ((bid_dirty | ask_dirty) & 1) {
+        BestPrices prices;
+        prices.timestamp = now;
+        if (bids.count > 0) {
+            prices.bid = bids.levels[0].price;
+            prices.bid_size = bids.levels[0].quantity;
+        }
+        if (asks.count > 0) {
+            prices.ask = asks.levels[0].price;
+            prices.ask_size = asks.levels[0].quantity;
+        }
         market_data_->publishBestPrices(prices);
-        
-        // Publish market depth (top 5 levels) for full book updates
-        MarketDepth depth = getDepth(5);
-        market_data_->publishDepth(depth);
+    }
+
+    // Top-5 depth only when one of those levels changed; the scratch keeps its capacity
+    constexpr size_t PublishedLevels = 5;
+    constexpr DepthCache::DirtyMask PublishedMask = (1u << PublishedLevels) - 1;
+    if ((bid_dirty | ask_dirty) & PublishedMask) {
+        published_depth_.timestamp = now;
+        published_depth_.bids.assign(bids.levels.begin(), bids.levels.begin() + std::min<size_t>(PublishedLevels, bids.count));
+        published_depth_.asks.assign(asks.levels.begin(), asks.levels.begin() + std::min<size_t>(PublishedLevels, asks.count));
+        market_data_->publishDepth(published_depth_);
     }
 }
 
-void OrderBook::publishBookUpdate(BookUpdate::Type type, Side side, Price price, 
-                                 Quantity quantity, size_t order_count) {
+void OrderBook::publishBookUpdate(BookUpdate::Type type, Side side, const PriceLevel& level) {
     if (market_data_) {
         // Create sequence number for gap detection
         static std::atomic<SequenceNumber> book_sequence{0};
         SequenceNumber seq = ++book_sequence;
         
-        BookUpdate update(type, side, price, quantity, order_count, seq);
+        BookUpdate update(type, side, level.price, level.total_quantity, level.order_count, seq);
         market_data_->publishBookUpdate(update);
     }
 }
 
-void OrderBook::processMatching(Order& incoming_order) {
-    // Simple matching logic - check if we can match against opposite side
-    auto& opposite_levels = (incoming_order.side == Side::Buy) ? asks_ : bids_;
+template<Side S, typename Walk>
+void OrderBook::executeMatching(Order& incoming_order, Walk&& walk) {
+    // Match against the best opposite price first and walk towards worse prices.
+    constexpr Side opposite_side = SideTraits<S>::opposite;
+    auto for_each_level = [&](auto&& visitor) {
+        walk([&](PriceLevel& level) {
+            bool more = visitor(level);
+            // Reclaim the level once the matcher has emptied it
+            if (level.isEmpty() && findPriceLevel(level.price, opposite_side) == &level) {
+                removePriceLevel(&level, opposite_side);
+            }
+            return more;
+        });
+    };
+    matching_engine_.matchSide<S>(incoming_order, for_each_level, [this, &incoming_order](const Fill& fill) {
+        handleFill(incoming_order, fill);
+        return true;
+    });
+}
+
+template<Side S>
+void OrderBook::matchAgainst(Order& incoming_order) {
+    constexpr Side opposite_side = SideTraits<S>::opposite;
+    
+    if (options_.ladder_mode) {
+        PriceLadder& ladder = sideLadder<opposite_side>();
+        if (!ladder.best()) {
+            return; // No opposite side orders to match against
+        }
+        executeMatching<S>(incoming_order, [&ladder](auto&& visitor) {
+            visitLadderLevels(ladder, visitor);
+        });
+        return;
+    }
     
+    auto& opposite_levels = sideLevels<opposite_side>();
     if (opposite_levels.empty()) {
         return; // No opposite side orders to match against
     }
     
-    // Find best opposite price
-    const auto& best_level = opposite_levels.back(); // unique_ptr - Best price is at the end
-    
-    bool can_match = false;
-    if (incoming_order.side == Side::Buy) {
-        // Buy order can match if buy price >= ask price
-        can_match = incoming_order.price >= best_level->price;
-    } else {
-        // Sell order can match if sell price <= bid price
-        can_match = incoming_order.price <= best_level->price;
-    }
-    
-    if (can_match && !best_level->isEmpty()) {
-        // Execute trades
-        executeMatching(incoming_order, opposite_levels);
+    // Best price is at the end; bail out early if it does not cross
+    const auto& best_level = opposite_levels.back();
+    if (!MatchingEngine::crosses<S>(incoming_order, best_level->price) || best_level->isEmpty()) {
+        return;
     }
+    executeMatching<S>(incoming_order, [&opposite_levels](auto&& visitor) {
+        visitSortedLevels(opposite_levels, visitor);
+    });
 }
 
-void OrderBook::executeMatching(Order& incoming_order, std::vector<std::unique_ptr<PriceLevel>>& opposite_levels) {
-    // Levels are sorted such that the "Best" price is always at the end (back).
-    // Bids: Ascending (Low -> High). Best Bid is back().
-    // Asks: Descending (High -> Low). Best Ask is back().
-    
-    // So for both Buy and Sell orders, we match against the "Best" price first,
-    // which means iterating from back to front (Reverse).
-    
-    for (auto it = opposite_levels.rbegin(); it != opposite_levels.rend(); ++it) {
-        auto& levelPtr = *it; // unique_ptr<PriceLevel>&
-
-        if (levelPtr->isEmpty()) continue;
-        if (incoming_order.isFullyFilled()) break;
-        
-        // Check price condition
-        bool can_match = false;
-        if (incoming_order.side == Side::Buy) {
-            // Buy matches if BidPrice >= AskPrice (level.price)
-            can_match = incoming_order.price >= levelPtr->price;
-        } else {
-            // Sell matches if SellPrice <= BidPrice (level.price)
-            can_match = incoming_order.price <= levelPtr->price;
-        }
-        
-        if (!can_match) break; // Prices no longer cross
-        
-        matchAgainstPriceLevel(incoming_order, *levelPtr);
+void OrderBook::processMatching(Order& incoming_order) {
+    // The only side branch on the matching path
+    if (incoming_order.isBuy()) {
+        matchAgainst<Side::Buy>(incoming_order);
+    } else {
+        matchAgainst<Side::Sell>(incoming_order);
     }
 }
 
-void OrderBook::matchAgainstPriceLevel(Order& incoming_order, PriceLevel& price_level) {
-    Order* current_order = price_level.getFirstOrder();
-    
-    while (current_order && !incoming_order.isFullyFilled()) {
-        // Save next pointer before potential removal
-        Order* next_order = current_order->next;
+bool OrderBook::canFillCompletely(const Order& incoming_order) {
+    Side opposite_side = (incoming_order.side == Side::Buy) ? Side::Sell : Side::Buy;
+    auto& levels = (opposite_side == Side::Buy) ? bids_ : asks_;
+    auto& ladder = (opposite_side == Side::Buy) ? bid_ladder_ : ask_ladder_;
+    return MatchingEngine::hasLiquidity(incoming_order, [&](auto&& visitor) {
+        visitLevels(options_.ladder_mode, levels, ladder, visitor);
+    });
+}
 
-        // Calculate trade quantity
-        Quantity trade_quantity = std::min(incoming_order.remainingQuantity(),
-                                          current_order->remainingQuantity());
-        
-        if (trade_quantity == 0) {
-             // Handle ghost orders (fully filled but not removed)
-                 if (current_order->remainingQuantity() == 0) {
-                 price_level.removeOrder(current_order);
-                 auto it = order_index_.find(current_order->id);
-                 if (it != order_index_.end()) {
-                     order_retire_list_.push_back(it->second.order);
-                     order_index_.erase(it);
-                 }
-                 current_order = next_order;
-                 continue;
-             }
-             break;
-        }
-        
-        // Execute the trade
-        executeTrade(incoming_order, *current_order, price_level.price, trade_quantity);
-        
-        // Update price level quantity
-        price_level.updateQuantity(current_order, trade_quantity);
+void OrderBook::handleFill(Order& incoming_order, const Fill& fill) {
+    Order* passive = fill.passive;
+    depth_.update(passive->side, *fill.level);
+    
+    if (fill.quantity > 0) {
+        incoming_order.trace.stampOnce(TraceStage::Matched);
+        executeTrade(incoming_order, fill);
+        incoming_order.trace.stampOnce(TraceStage::Published);
         
         // Publish book update for the passive order modification/removal
-        if (current_order->isFullyFilled()) {
-            // Order fully filled - publish removal
-            publishBookUpdate(BookUpdate::Type::Remove, current_order->side, 
-                             current_order->price, 0, price_level.order_count);
+        if (passive->isFullyFilled()) {
+            publishBookUpdate(BookUpdate::Type::Remove, passive->side, *fill.level);
         } else {
-            // Order partially filled - publish modification
-            publishBookUpdate(BookUpdate::Type::Modify, current_order->side, 
-                             current_order->price, current_order->remainingQuantity(), 
-                             price_level.order_count);
-        }
-        
-        // Move to next order if current is fully filled
-        if (current_order->isFullyFilled()) {
-            // Remove filled order from order index
-            auto it = order_index_.find(current_order->id);
-            if (it != order_index_.end()) {
-                // Defer returning to pool until end of batch
-                order_retire_list_.push_back(it->second.order);
-                order_index_.erase(it);
-            }
-            current_order = next_order;
+            publishBookUpdate(BookUpdate::Type::Modify, passive->side, *fill.level);
         }
     }
     
-    // Clean up empty price level
-    if (price_level.isEmpty()) {
-        Side opposite_side = (incoming_order.side == Side::Buy) ? Side::Sell : Side::Buy;
-        auto p_it = price_index_.find(price_level.price);
-        if (p_it != price_index_.end() && p_it->second == &price_level) {
-            removePriceLevel(&price_level, opposite_side);
+    // Filled (or stale) passive orders are already unlinked; drop them from the index
+    if (passive->isFullyFilled()) {
+        auto it = orders_.find(passive->id);
+        if (it != orders_.end()) {
+            // Defer returning to pool until end of batch
+            order_retire_list_.push_back(it->second.order);
+            orders_.erase(it);
         }
     }
 }
 
-void OrderBook::executeTrade(Order& aggressive_order, Order& passive_order, 
-                            Price trade_price, Quantity trade_quantity) {
-    // Fill both orders
-    aggressive_order.fill(trade_quantity);
-    passive_order.fill(trade_quantity);
-    
-    // Create trade record
-    static uint64_t trade_counter = 1;
-    TradeId trade_id(trade_counter++);
+void OrderBook::executeTrade(const Order& aggressive_order, const Fill& fill) {
+    // The matcher has already filled both orders
+    Trade trade = MatchingEngine::makeTrade(MatchingEngine::getNextTradeId(), aggressive_order, fill);
     
-    // Determine buy/sell order IDs
-    OrderId buy_order_id = aggressive_order.isBuy() ? aggressive_order.id : passive_order.id;
-    OrderId sell_order_id = aggressive_order.isSell() ? aggressive_order.id : passive_order.id;
-    
-    Trade trade(trade_id.value, buy_order_id, sell_order_id, 
-               trade_price, trade_quantity, aggressive_order.symbol);
-    
-    // Update positions through risk manager
+    // Post-trade deltas only; the accounts travel on the orders themselves
+    const Order& passive = *fill.passive;
     if (risk_manager_) {
-        risk_manager_->updatePosition(trade);
-        
-        if (logger_) {
-            logger_->debug("Updated positions for trade ID: " + std::to_string(trade.id.value), 
-                          "OrderBook::executeTrade");
-        }
+        risk_manager_->onFill(aggressive_order.account_id, trade.symbol_id, aggressive_order.side,
+                              fill.quantity, fill.price, aggressive_order.risk_reserved);
+        risk_manager_->onFill(passive.account_id, trade.symbol_id, passive.side,
+                              fill.quantity, fill.price, passive.risk_reserved);
     }
     
     // Publish trade to market data
@@ -963,123 +1967,316 @@ void OrderBook::executeTrade(Order& aggressive_order, Order& passive_order,
     trade_count_.fetch_add(1u, std::memory_order_relaxed);
     
     // Log trade execution with risk context
-    if (logger_) {
-        std::string buy_account = risk_manager_ ? risk_manager_->getAccountForOrder(trade.buy_order_id) : "unknown";
-        std::string sell_account = risk_manager_ ? risk_manager_->getAccountForOrder(trade.sell_order_id) : "unknown";
+    // Account lookups only run when trade logging is actually enabled
+    if (logger_ && logger_->isLogLevelEnabled(LogLevel::INFO)) {
+        AccountId buy_id = aggressive_order.isBuy() ? aggressive_order.account_id : passive.account_id;
+        AccountId sell_id = aggressive_order.isSell() ? aggressive_order.account_id : passive.account_id;
+        const char* buy_account = accountTable().name(buy_id);
+        const char* sell_account = accountTable().name(sell_id);
         
-        logger_->info("Trade executed: ID=" + std::to_string(trade.id.value) + 
-                     " Buy=" + std::to_string(trade.buy_order_id.value) + " (Account: " + buy_account + ")" +
-                     " Sell=" + std::to_string(trade.sell_order_id.value) + " (Account: " + sell_account + ")" +
-                     " Price=" + std::to_string(trade.price) + 
-                     " Qty=" + std::to_string(trade.quantity) + 
-                     " Symbol=" + trade.symbol,
-                     "OrderBook::executeTrade");
+        LOG_INFO(logger_, "OrderBook::executeTrade",
+                 "Trade executed: ID={} Buy={} (Account: {}) Sell={} (Account: {}) Price={} Qty={} Symbol={}",
+                 trade.id, trade.buy_order_id, buy_account, trade.sell_order_id, sell_account,
+                 trade.price, trade.quantity, trade.symbol());
         
         // Log position updates
         if (risk_manager_) {
-            const Portfolio& buy_portfolio = risk_manager_->getPortfolio(buy_account);
-            const Portfolio& sell_portfolio = risk_manager_->getPortfolio(sell_account);
-            
-            logger_->debug("Position updates - Buy account " + buy_account + 
-                          " new position: " + std::to_string(buy_portfolio.getPosition(trade.symbol)) +
-                          ", Sell account " + sell_account + 
-                          " new position: " + std::to_string(sell_portfolio.getPosition(trade.symbol)),
-                          "OrderBook::executeTrade");
+            LOG_DEBUG(logger_, "OrderBook::executeTrade",
+                      "Position updates - Buy account {} new position: {}, Sell account {} new position: {}",
+                      buy_account, risk_manager_->getPosition(buy_id, trade.symbol_id),
+                      sell_account, risk_manager_->getPosition(sell_id, trade.symbol_id));
         }
     }
 }
 
-void OrderBook::poll() {
-    MarketUpdate update;
-    // Drain all sharded market queues. Loop until no queue had updates.
-    bool any_popped = true;
-    while (any_popped) {
-        any_popped = false;
-        for (auto& qptr : market_queues_) {
-            while (qptr->pop(update)) {
-                any_popped = true;
-            if (update.type == MarketUpdate::Type::SnapshotStart) {
-            // Clear book logic - collect all orders into retire list, then clear structures
-            for (auto& level : bids_) {
-                Order* cur = level->getFirstOrder();
-                while (cur) {
-                    Order* next = cur->next;
-                    order_retire_list_.push_back(cur);
-                    cur = next;
-                }
+std::optional<std::chrono::steady_clock::time_point> OrderBook::nextAuctionDeadline() const {
+    if (!batchAuction() || options_.auction_interval_us == 0 || !auction_pending_) return std::nullopt;
+    return next_auction_;
+}
+
+bool OrderBook::auctionDue(std::chrono::steady_clock::time_point now) const {
+    if (!auction_pending_) return false;
+    return options_.auction_interval_us == 0 || now >= next_auction_;
+}
+
+void OrderBook::markAuctionPending() {
+    if (auction_pending_) return;
+    auction_pending_ = true;
+    if (options_.auction_interval_us > 0) {
+        next_auction_ = std::chrono::steady_clock::now() + std::chrono::microseconds(options_.auction_interval_us);
+    }
+}
+
+void OrderBook::holdForAuction(Order* order) {
+    auction_held_[order->side == Side::Buy ? 0 : 1].push_back(order);
+    markAuctionPending();
+}
+
+void OrderBook::runAuction() {
+    auction_pending_ = false;
+    std::stable_sort(auction_held_[0].begin(), auction_held_[0].end(), AuctionPriority{true});
+    std::stable_sort(auction_held_[1].begin(), auction_held_[1].end(), AuctionPriority{false});
+
+    // Held market quantity and the most aggressive limit price, per side (0 = buy)
+    Quantity market[2] = {0, 0};
+    std::optional<Price> limit[2];
+    refreshDepthCache();
+    for (int s = 0; s < 2; ++s) {
+        bool buy = s == 0;
+        const DepthCache::SideDepth& top = depth_.side(buy ? Side::Buy : Side::Sell);
+        if (top.count > 0) limit[s] = top.levels[0].price;
+        for (const Order* order : auction_held_[s]) {
+            if (order->type == OrderType::Market) {
+                market[s] += order->remainingQuantity();
+            } else if (!limit[s] || (buy ? order->price > *limit[s] : order->price < *limit[s])) {
+                limit[s] = order->price;
             }
-            for (auto& level : asks_) {
-                Order* cur = level->getFirstOrder();
-                while (cur) {
-                    Order* next = cur->next;
-                    order_retire_list_.push_back(cur);
-                    cur = next;
-                }
+        }
+    }
+
+    // Resting levels the other side's limits reach, plus just enough depth past them
+    // to absorb its market orders
+    for (int s = 0; s < 2; ++s) {
+        bool buy = s == 0;
+        int other = 1 - s;
+        auto& collected = auction_levels_[s];
+        collected.clear();
+        Quantity beyond = 0;
+        visitLevels(options_.ladder_mode, buy ? bids_ : asks_, buy ? bid_ladder_ : ask_ladder_, [&](PriceLevel& level) {
+            bool reached = limit[other] && (buy ? level.price >= *limit[other] : level.price <= *limit[other]);
+            if (!reached) {
+                if (beyond >= market[other]) return false;
+                beyond += level.total_quantity;
             }
-            order_index_.clear();
-            bids_.clear();
-            asks_.clear();
-            price_index_.clear();
-            if (logger_) logger_->info("OrderBook cleared via queue", "OrderBook::poll");
-            continue;
+            collected.push_back(&level);
+            return true;
+        });
+    }
+
+    // Supply and demand over every crossing price; pick the one executing the most,
+    // then the smallest imbalance, then the lowest price
+    auction_curve_.clear();
+    Quantity demand = market[0];
+    Quantity supply = market[1];
+    for (int s = 0; s < 2; ++s) {
+        for (PriceLevel* level : auction_levels_[s]) {
+            auction_curve_.push_back({level->price, s == 0 ? level->total_quantity : 0, s == 1 ? level->total_quantity : 0});
         }
+        for (const Order* order : auction_held_[s]) {
+            if (order->type == OrderType::Market) continue;
+            auction_curve_.push_back({order->price, s == 0 ? order->remainingQuantity() : 0,
+                                      s == 1 ? order->remainingQuantity() : 0});
+        }
+    }
+    std::sort(auction_curve_.begin(), auction_curve_.end(),
+              [](const AuctionPoint& a, const AuctionPoint& b) { return a.price < b.price; });
+    for (const AuctionPoint& point : auction_curve_) demand += point.buy;
 
-        // Handle Add/Modify/Remove
-        PriceLevel* level = nullptr;
-        auto it = price_index_.find(update.price);
-        if (it != price_index_.end()) {
-            level = it->second;
+    Price clearing = 0;
+    Quantity volume = 0;
+    Quantity imbalance = 0;
+    for (size_t i = 0; i < auction_curve_.size();) {
+        // Demand at this price still includes the buys priced exactly here
+        Price price = auction_curve_[i].price;
+        Quantity buys_here = 0;
+        for (; i < auction_curve_.size() && auction_curve_[i].price == price; ++i) {
+            buys_here += auction_curve_[i].buy;
+            supply += auction_curve_[i].sell;
+        }
+        Quantity executed = std::min(demand, supply);
+        Quantity gap = demand > supply ? demand - supply : supply - demand;
+        if (executed > volume || (executed == volume && executed > 0 && gap < imbalance)) {
+            clearing = price;
+            volume = executed;
+            imbalance = gap;
         }
+        demand -= buys_here;
+    }
 
-        if (update.type == MarketUpdate::Type::Add || update.type == MarketUpdate::Type::Modify) {
-             if (!level) {
-                level = findOrCreatePriceLevel(update.price, update.side);
+    // One pass down both sides at the clearing price
+    size_t trades = 0;
+    if (volume > 0) {
+        AuctionQueue buys{auction_levels_[0], auction_held_[0], true, clearing};
+        AuctionQueue sells{auction_levels_[1], auction_held_[1], false, clearing};
+        Quantity left = volume;
+        while (left > 0) {
+            PriceLevel* buy_level = nullptr;
+            PriceLevel* sell_level = nullptr;
+            Order* buy = buys.front(buy_level);
+            Order* sell = sells.front(sell_level);
+            if (!buy || !sell) break;
+
+            Quantity quantity = std::min({left, buy->remainingQuantity(), sell->remainingQuantity()});
+            if (quantity == 0) {
+                // Filled resting order that was never unlinked
+                Order* stale = buy->remainingQuantity() == 0 ? buy : sell;
+                PriceLevel* level = stale == buy ? buy_level : sell_level;
+                level->removeOrder(stale);
+                settleAuctionFill(stale, level);
+                continue;
             }
-            level->total_quantity = update.quantity;
-            level->order_count = update.order_count;
-        } else if (update.type == MarketUpdate::Type::Remove) {
-            if (level) {
-                if (level->getOrderCount() == 0) {
-                    removePriceLevel(level, update.side);
-                } else {
-                    level->total_quantity = 0;
-                    level->order_count = 0;
+            buy->fill(quantity);
+            sell->fill(quantity);
+            left -= quantity;
+            ++trades;
+
+            // No order aggresses in an auction; report the held order, or else the later
+            // arrival, as the taker
+            bool buy_takes = buy_level == nullptr && sell_level != nullptr ? true :
+                             buy_level != nullptr && sell_level == nullptr ? false :
+                             buy->timestamp >= sell->timestamp;
+            Order& taker = buy_takes ? *buy : *sell;
+            executeTrade(taker, Fill{buy_takes ? sell : buy, buy_takes ? sell_level : buy_level, clearing, quantity});
+
+            if (buy_level) {
+                buy_level->updateQuantity(buy, quantity);
+                settleAuctionFill(buy, buy_level);
+            }
+            if (sell_level) {
+                sell_level->updateQuantity(sell, quantity);
+                settleAuctionFill(sell, sell_level);
+            }
+        }
+
+        // Emptied levels form a best-first prefix; reclaim them in that order so each
+        // is the best level when removed
+        for (int s = 0; s < 2; ++s) {
+            Side side = s == 0 ? Side::Buy : Side::Sell;
+            for (PriceLevel* level : auction_levels_[s]) {
+                if (!level->isEmpty()) break;
+                if (findPriceLevel(level->price, side) == level) {
+                    removePriceLevel(level, side);
                 }
             }
         }
-        
-        // No sort required; maintainSortedOrder() can be expensive under heavy update load
-        publishMarketDataUpdate();
+    }
+
+    // Immediate orders never rest: cancel what the auction did not fill
+    for (auto& held : auction_held_) {
+        for (Order* order : held) {
+            if (!order->isFullyFilled()) {
+                order->status = OrderStatus::Cancelled;
             }
+            order_retire_list_.push_back(order);
         }
+        held.clear();
+    }
+
+    if (trades > 0) {
+        publishMarketDataUpdate();
     }
+    LOG_DEBUG(logger_, "OrderBook::runAuction", "Auction cleared {} at {} in {} trades", volume, clearing, trades);
 }
 
-size_t OrderBook::getProducerQueueIndex() {
-    static thread_local size_t local_index = std::numeric_limits<size_t>::max();
-    if (local_index == std::numeric_limits<size_t>::max()) {
-        local_index = producer_rr_index_.fetch_add(1u) % market_queues_.size();
+void OrderBook::settleAuctionFill(Order* order, PriceLevel* level) {
+    depth_.update(order->side, *level);
+    if (order->isFullyFilled()) {
+        publishBookUpdate(BookUpdate::Type::Remove, order->side, *level);
+        auto it = orders_.find(order->id);
+        if (it != orders_.end()) {
+            order_retire_list_.push_back(it->second.order);
+            orders_.erase(it);
+        }
+    } else {
+        publishBookUpdate(BookUpdate::Type::Modify, order->side, *level);
     }
-    return local_index;
 }
 
-size_t OrderBook::getOrderQueueIndex() {
-    static thread_local size_t local_index = std::numeric_limits<size_t>::max();
-    if (local_index == std::numeric_limits<size_t>::max()) {
-        local_index = order_producer_rr_index_.fetch_add(1u) % order_queues_.size();
+void OrderBook::poll() {
+    drainMarketQueue();
+}
+
+size_t OrderBook::drainMarketQueue() {
+    MarketUpdate update;
+    size_t applied = 0;
+    // Drain the market queue; feeds may keep pushing meanwhile
+    while (market_queue_->pop(update)) {
+        if (update.type == MarketUpdate::Type::SnapshotStart) {
+        // Clear book logic - collect all orders into retire list, then clear structures
+        for (auto& level : bids_) {
+            Order* cur = level->getFirstOrder();
+            while (cur) {
+                Order* next = cur->next;
+                order_retire_list_.push_back(cur);
+                cur = next;
+            }
+        }
+        for (auto& level : asks_) {
+            Order* cur = level->getFirstOrder();
+            while (cur) {
+                Order* next = cur->next;
+                order_retire_list_.push_back(cur);
+                cur = next;
+            }
+        }
+        bid_ladder_.forEachLevel([this](PriceLevel& level) {
+            for (Order* cur = level.getFirstOrder(); cur; cur = cur->next) {
+                order_retire_list_.push_back(cur);
+            }
+            return true;
+        });
+        ask_ladder_.forEachLevel([this](PriceLevel& level) {
+            for (Order* cur = level.getFirstOrder(); cur; cur = cur->next) {
+                order_retire_list_.push_back(cur);
+            }
+            return true;
+        });
+        orders_.clearIndex();
+        bids_.clear();
+        asks_.clear();
+        bid_index_.clear();
+        ask_index_.clear();
+        bid_tombstones_ = 0;
+        ask_tombstones_ = 0;
+        bid_ladder_.clear();
+        ask_ladder_.clear();
+        if (logger_) logger_->info("OrderBook cleared via queue", "OrderBook::drainMarketQueue");
+        ++applied;
+        continue;
+        }
+
+        // Handle Add/Modify/Remove
+        PriceLevel* level = findPriceLevel(update.price, update.side);
+
+        if (update.type == MarketUpdate::Type::Add || update.type == MarketUpdate::Type::Modify) {
+         if (!level) {
+            level = findOrCreatePriceLevel(update.price, update.side);
+        }
+        level->total_quantity = update.quantity;
+        level->order_count = update.order_count;
+        } else if (update.type == MarketUpdate::Type::Remove) {
+        if (level) {
+            // The feed's order_count is not ours: drop the level unless our orders rest there
+            if (!level->getFirstOrder()) {
+                level->order_count = 0;
+                level->total_quantity = 0;
+                removePriceLevel(level, update.side);
+            } else {
+                level->total_quantity = 0;
+                level->order_count = 0;
+            }
+        }
+        }
+        
+        // No sort required; maintainSortedOrder() can be expensive under heavy update load
+        ++applied;
+    }
+
+    // One top-of-book/depth publication per drained delta, not per entry
+    if (applied > 0) {
+        // Applied in bulk, so refill the depth window rather than track each entry
+        depth_.invalidate();
+        publishTopOfBook();
+        publishMarketDataUpdate();
     }
-    return local_index;
+    return applied;
 }
 
 Order* OrderBook::acquireOrder(const OrderRequest& req) {
-    Order* o = nullptr;
-    if (!order_free_list_.empty()) {
-        o = order_free_list_.back();
-        order_free_list_.pop_back();
-        // reset in-place
-        o->reset();
-    } else {
-        o = new Order();
+    Order* o = orders_.acquire();
+    if (orders_.heapCount() == 1 && !orders_.owns(o)) {
+        LOG_WARN(logger_, "OrderBook::acquireOrder", "Order arena full ({} orders); falling back to heap",
+                 orders_.pool().capacity());
     }
 
     // populate fields from request
@@ -1089,16 +2286,12 @@ Order* OrderBook::acquireOrder(const OrderRequest& req) {
     o->price = req.price;
     o->quantity = req.quantity;
     o->filled_quantity = 0;
-    std::strncpy(o->symbol, req.symbol, sizeof(o->symbol) - 1);
-    o->symbol[sizeof(o->symbol) - 1] = '\0';
-    std::strncpy(o->account, req.account, sizeof(o->account) - 1);
-    o->account[sizeof(o->account) - 1] = '\0';
-    o->tif = static_cast<TimeInForce>(req.tif);
+    o->symbol_id = req.symbol_id;
+    o->account_id = req.account_id;
+    o->tif = req.tif;
+    o->risk_reserved = req.risk_reserved;
+    o->trace.clear();
     // timestamp assigned by consumer's processAddOrder
-    // track in-use
-#ifndef NDEBUG
-    order_in_use_set_.insert(o);
-#endif
     // Debug counts
 #ifndef NDEBUG
     debug_acquire_count_.fetch_add(1, std::memory_order_relaxed);
@@ -1109,18 +2302,6 @@ Order* OrderBook::acquireOrder(const OrderRequest& req) {
 
 void OrderBook::releaseOrder(Order* order) {
     if (!order) return;
-    // Reset fields to avoid stale data and push to free list
-    order->reset();
-    // Debug check: ensure not double releasing
-#ifndef NDEBUG
-    auto it = order_in_use_set_.find(order);
-    if (it == order_in_use_set_.end()) {
-        if (logger_) logger_->error("Attempted to release Order not tracked as in-use", "OrderBook::releaseOrder");
-        // In debug builds we avoid aborting to allow post-mortem diagnostics.
-        return;
-    }
-    order_in_use_set_.erase(it);
-#endif
     // Debug counts
 #ifndef NDEBUG
     auto released = debug_release_count_.fetch_add(1, std::memory_order_relaxed) + 1;
@@ -1128,8 +2309,14 @@ void OrderBook::releaseOrder(Order* order) {
         std::cout << "[debug] releases: " << released << " acquired: " << debug_acquire_count_.load() << std::endl;
     }
 #endif
-    
-    order_free_list_.push_back(order);
+
+    // Whatever never filled gives its reserved exposure back
+    if (order->risk_reserved && risk_manager_ && !order->isFullyFilled()) {
+        risk_manager_->adjustExposure(order->account_id, order->symbol_id, order->side,
+                                      -static_cast<int64_t>(order->remainingQuantity()));
+    }
+
+    orders_.release(order);
 }
 
 uint64_t OrderBook::getTradeCount() const {
@@ -1,22 +1,40 @@
 #include "orderbook/Core/OrderManager.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include <cassert>
 #include <sstream>
 #include <limits>
 
 namespace orderbook {
 
-OrderManager::OrderManager(LoggerPtr logger)
-    : next_order_id_(1), logger_(logger) {
+OrderManager::OrderManager(LoggerPtr logger, size_t max_orders)
+    : own_orders_(std::make_unique<OrderStore>(max_orders)), next_order_id_(1), logger_(logger) {
     if (logger_) {
         logger_->info("OrderManager initialized", "OrderManager");
     }
 }
 
+OrderManager::OrderManager(OrderBook& book, LoggerPtr logger)
+    : book_(&book), next_order_id_(1), logger_(logger) {
+    // Another consumer thread would race our reads of the book's index
+    assert(!book.ownsConsumerThread() && "OrderManager needs a book without its own consumer thread");
+    if (logger_) {
+        if (book.ownsConsumerThread()) {
+            logger_->error("Book runs its own consumer thread; order lookups will race it", "OrderManager");
+        }
+        logger_->info("OrderManager initialized over an OrderBook", "OrderManager");
+    }
+}
+
 OrderManager::~OrderManager() {
     if (logger_) {
-        logger_->info("OrderManager destroyed with " + std::to_string(orders_.size()) + " orders", "OrderManager");
+        logger_->info("OrderManager destroyed with " + std::to_string(orders().size()) + " orders", "OrderManager");
     }
 }
 
+const OrderStore& OrderManager::orders() const {
+    return book_ ? book_->getOrderStore() : *own_orders_;
+}
+
 OrderResult OrderManager::addOrder(std::unique_ptr<Order> order) {
     if (!order) {
         const std::string error = "Cannot add null order";
@@ -34,7 +52,7 @@ OrderResult OrderManager::addOrder(std::unique_ptr<Order> order) {
     OrderId order_id = order->id;
     
     // Check for duplicate order ID
-    if (orders_.find(order_id) != orders_.end()) {
+    if (orders().find(order_id) != orders().end()) {
         const std::string error = "Order ID " + std::to_string(order_id.value) + " already exists";
         if (logger_) logger_->error(error, "OrderManager::addOrder");
         return OrderResult::error(error);
@@ -43,46 +61,106 @@ OrderResult OrderManager::addOrder(std::unique_ptr<Order> order) {
     // Log order addition
     logOrderEvent("ADD", *order);
     
+    if (book_) {
+        // The book copies the order into its own storage; apply it before returning
+        auto submitted = book_->addOrder(*order);
+        if (submitted.isError()) {
+            if (logger_) logger_->error(submitted.error(), "OrderManager::addOrder");
+            return submitted;
+        }
+        book_->processPending();
+        return OrderResult::success(order_id);
+    }
+    
     // Store the order
-    orders_[order_id] = std::move(order);
+    Order* stored = own_orders_->acquire();
+    *stored = std::move(*order);
+    own_orders_->insert(OrderLocation(stored, nullptr, stored->side));
     
     return OrderResult::success(order_id);
 }
 
 CancelResult OrderManager::cancelOrder(OrderId order_id) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+    Order* order = orders().order(order_id);
+    if (!order) {
         const std::string error = "Order " + std::to_string(order_id.value) + " not found";
         logOrderError(error, order_id);
         return CancelResult::error(error);
     }
     
-    Order* order = it->second.get();
     if (!order->isActive()) {
         const std::string error = "Order " + std::to_string(order_id.value) + " is not active";
         logOrderError(error, order_id);
         return CancelResult::error(error);
     }
     
-    // Cancel the order
-    order->cancel();
     logOrderEvent("CANCEL", *order);
+    if (book_) {
+        auto submitted = book_->cancelOrder(order_id);
+        if (submitted.isError()) return submitted;
+        book_->processPending();
+        return CancelResult::success(true);
+    }
     
-    // Remove from location tracking
-    order_locations_.erase(order_id);
+    // Cancel the order; it stays stored, out of any price level, until removeOrder
+    order->cancel();
+    own_orders_->find(order_id)->second.price_level = nullptr;
     
     return CancelResult::success(true);
 }
 
+size_t OrderManager::cancelAll(AccountId account) {
+    size_t cancelled = 0;
+    for (Order* order = orders().accountOrders(account); order; order = order->account_next) {
+        if (!order->isActive()) continue;
+        ++cancelled;
+        // Standalone: cancelled orders stay stored, out of any price level, until removeOrder
+        if (!book_) {
+            logOrderEvent("CANCEL", *order);
+            order->cancel();
+            own_orders_->find(order->id)->second.price_level = nullptr;
+        }
+    }
+    if (book_ && cancelled > 0) {
+        if (book_->cancelAll(MassCancel::account(account)).isError()) return 0;
+        book_->processPending();
+    }
+    if (logger_ && cancelled > 0) {
+        logger_->info("Cancelled " + std::to_string(cancelled) + " orders for account " +
+                      accountTable().name(account), "OrderManager::cancelAll");
+    }
+    return cancelled;
+}
+
+size_t OrderManager::cancelOrders(const OrderId* ids, size_t count) {
+    std::vector<OrderId> active;
+    active.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Order* order = orders().order(ids[i]);
+        if (!order || !order->isActive()) continue;
+        active.push_back(ids[i]);
+        if (!book_) {
+            logOrderEvent("CANCEL", *order);
+            order->cancel();
+            own_orders_->find(order->id)->second.price_level = nullptr;
+        }
+    }
+    if (book_ && !active.empty()) {
+        size_t accepted = book_->cancelOrders(active.data(), active.size());
+        book_->processPending();
+        return accepted;
+    }
+    return active.size();
+}
+
 ModifyResult OrderManager::modifyOrder(OrderId order_id, Price new_price, Quantity new_quantity) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+    Order* order = orders().order(order_id);
+    if (!order) {
         const std::string error = "Order " + std::to_string(order_id.value) + " not found";
         logOrderError(error, order_id);
         return ModifyResult::error(error);
     }
     
-    Order* order = it->second.get();
     if (!order->isActive()) {
         const std::string error = "Order " + std::to_string(order_id.value) + " is not active";
         logOrderError(error, order_id);
@@ -115,7 +193,15 @@ ModifyResult OrderManager::modifyOrder(OrderId order_id, Price new_price, Quanti
     Quantity old_quantity = order->quantity;
     
     // Modify the order
-    order->modify(new_price, new_quantity);
+    if (book_) {
+        auto submitted = book_->modifyOrder(*order, new_price, new_quantity);
+        if (submitted.isError()) return submitted;
+        book_->processPending();
+        // A repriced order may have traded out of the book
+        if (!(order = orders().order(order_id))) return ModifyResult::success(true);
+    } else {
+        order->modify(new_price, new_quantity);
+    }
     
     // Log modification
     std::stringstream ss;
@@ -129,13 +215,12 @@ ModifyResult OrderManager::modifyOrder(OrderId order_id, Price new_price, Quanti
 }
 
 Order* OrderManager::getOrder(OrderId order_id) const {
-    auto it = orders_.find(order_id);
-    return (it != orders_.end()) ? it->second.get() : nullptr;
+    return orders().order(order_id);
 }
 
 OrderLocation OrderManager::getOrderLocation(OrderId order_id) const {
-    auto it = order_locations_.find(order_id);
-    if (it != order_locations_.end()) {
+    auto it = orders().find(order_id);
+    if (it != orders().end()) {
         return it->second;
     }
     // Return invalid location
@@ -143,30 +228,40 @@ OrderLocation OrderManager::getOrderLocation(OrderId order_id) const {
 }
 
 void OrderManager::setOrderLocation(OrderId order_id, const OrderLocation& location) {
-    if (location.isValid()) {
-        order_locations_[order_id] = location;
+    if (book_ || !location.isValid()) return;
+    auto it = own_orders_->find(order_id);
+    if (it != own_orders_->end()) {
+        it->second.price_level = location.price_level;
+        it->second.side = location.side;
     }
 }
 
-std::unique_ptr<Order> OrderManager::removeOrder(OrderId order_id) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
-        return nullptr;
+bool OrderManager::removeOrder(OrderId order_id) {
+    if (book_) {
+        Order* order = orders().order(order_id);
+        if (!order) return false;
+        logOrderEvent("REMOVE", *order);
+        if (book_->cancelOrder(order_id).isSuccess()) book_->processPending();
+        return true;
     }
     
-    std::unique_ptr<Order> order = std::move(it->second);
-    orders_.erase(it);
-    order_locations_.erase(order_id);
+    auto it = own_orders_->find(order_id);
+    if (it == own_orders_->end()) {
+        return false;
+    }
     
+    Order* order = it->second.order;
     logOrderEvent("REMOVE", *order);
+    own_orders_->erase(it);
+    own_orders_->release(order);
     
-    return order;
+    return true;
 }
 
 void OrderManager::updateOrderStatus(OrderId order_id, OrderStatus status) {
-    auto it = orders_.find(order_id);
-    if (it != orders_.end()) {
-        it->second->status = status;
+    if (book_) return;
+    if (Order* order = own_orders_->order(order_id)) {
+        order->status = status;
         
         if (logger_) {
             std::string status_str;
@@ -184,12 +279,11 @@ void OrderManager::updateOrderStatus(OrderId order_id, OrderStatus status) {
 }
 
 bool OrderManager::fillOrder(OrderId order_id, Quantity fill_quantity) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+    Order* order = book_ ? nullptr : own_orders_->order(order_id);
+    if (!order) {
         return false;
     }
     
-    Order* order = it->second.get();
     bool fully_filled = order->fill(fill_quantity);
     
     if (logger_) {
@@ -220,8 +314,8 @@ ValidationResult OrderManager::validateOrder(const Order& order) const {
     }
     
     // Validate symbol
-    if (!isValidSymbol(order.symbol)) {
-        return ValidationResult::error(std::string("Invalid symbol: ") + order.symbol);
+    if (!isValidSymbol(order.symbol())) {
+        return ValidationResult::error(std::string("Invalid symbol: ") + order.symbol());
     }
     
     // Validate filled quantity
@@ -234,8 +328,8 @@ ValidationResult OrderManager::validateOrder(const Order& order) const {
 
 size_t OrderManager::getActiveOrderCount() const {
     size_t count = 0;
-    for (const auto& pair : orders_) {
-        if (pair.second->isActive()) {
+    for (const auto& pair : orders()) {
+        if (pair.second.order->isActive()) {
             ++count;
         }
     }
@@ -247,8 +341,15 @@ OrderId OrderManager::getNextOrderId() {
 }
 
 void OrderManager::clear() {
-    orders_.clear();
-    order_locations_.clear();
+    if (book_) {
+        std::vector<OrderId> ids;
+        ids.reserve(orders().size());
+        for (const auto& pair : orders()) ids.push_back(pair.first);
+        book_->cancelOrders(ids.data(), ids.size());
+        book_->processPending();
+    } else {
+        own_orders_->clear();
+    }
     next_order_id_.store(1);
     
     if (logger_) {
@@ -259,7 +360,7 @@ void OrderManager::clear() {
 // Private helper methods
 
 bool OrderManager::isValidPrice(Price price) const {
-    return price > 0.0 && price < std::numeric_limits<Price>::max() && std::isfinite(price);
+    return price > 0 && price < std::numeric_limits<Price>::max();
 }
 
 bool OrderManager::isValidQuantity(Quantity quantity) const {
@@ -275,11 +376,11 @@ void OrderManager::logOrderEvent(const std::string& event, const Order& order) c
     
     std::stringstream ss;
     ss << event << " OrderId=" << order.id.value 
-       << " Symbol=" << order.symbol
+       << " Symbol=" << order.symbol()
        << " Side=" << (order.isBuy() ? "BUY" : "SELL")
        << " Price=" << order.price
        << " Quantity=" << order.quantity
-       << " Account=" << order.account;
+       << " Account=" << order.account();
     
     logger_->info(ss.str(), "OrderManager");
 }
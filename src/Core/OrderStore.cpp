@@ -0,0 +1,83 @@
+#include "orderbook/Core/OrderStore.hpp"
+
+namespace orderbook {
+
+OrderStore::OrderStore(size_t max_orders, ArenaOptions options)
+    : pool_(max_orders, options), index_(max_orders) {}
+
+OrderStore::~OrderStore() {
+    // Arena orders go with the arena; only heap overflow orders need deleting
+    if (heap_count_ > 0) {
+        for (auto& entry : index_) {
+            if (entry.second.order && !pool_.owns(entry.second.order)) delete entry.second.order;
+        }
+    }
+}
+
+Order* OrderStore::acquire() {
+    if (Order* order = pool_.allocate()) return order;
+    ++heap_count_;
+    return new Order();
+}
+
+void OrderStore::release(Order* order) {
+    if (!order) return;
+    // ArenaPool asserts on double release in debug builds
+    if (pool_.owns(order)) {
+        pool_.release(order);
+    } else {
+        delete order;
+        --heap_count_;
+    }
+}
+
+OrderLocation& OrderStore::insert(const OrderLocation& location) {
+    Order* order = location.order;
+    AccountId account = order->account_id;
+    if (account >= account_heads_.size()) account_heads_.resize(account + 1, nullptr);
+    order->account_prev = nullptr;
+    order->account_next = account_heads_[account];
+    if (order->account_next) order->account_next->account_prev = order;
+    account_heads_[account] = order;
+
+    SymbolId symbol = order->symbol_id;
+    if (symbol >= symbol_orders_.size()) symbol_orders_.resize(symbol + 1);
+    order->symbol_slot = static_cast<uint32_t>(symbol_orders_[symbol].size());
+    symbol_orders_[symbol].push_back(order);
+
+    OrderLocation& slot = index_[order->id];
+    slot = location;
+    return slot;
+}
+
+void OrderStore::unlinkAccount(Order* order) {
+    if (!order) return;
+    if (order->account_prev) {
+        order->account_prev->account_next = order->account_next;
+    } else if (order->account_id < account_heads_.size() && account_heads_[order->account_id] == order) {
+        account_heads_[order->account_id] = order->account_next;
+    }
+    if (order->account_next) order->account_next->account_prev = order->account_prev;
+    order->account_next = nullptr;
+    order->account_prev = nullptr;
+}
+
+void OrderStore::unlinkSymbol(Order* order) {
+    if (!order || order->symbol_id >= symbol_orders_.size()) return;
+    auto& orders = symbol_orders_[order->symbol_id];
+    if (order->symbol_slot >= orders.size() || orders[order->symbol_slot] != order) return;
+    Order* last = orders.back();
+    orders[order->symbol_slot] = last;
+    last->symbol_slot = order->symbol_slot;
+    orders.pop_back();
+    order->symbol_slot = 0;
+}
+
+void OrderStore::clear() {
+    for (auto& entry : index_) release(entry.second.order);
+    index_.clear();
+    account_heads_.clear();
+    symbol_orders_.clear();
+}
+
+}
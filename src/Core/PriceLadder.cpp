@@ -0,0 +1,71 @@
+#include "orderbook/Core/PriceLadder.hpp"
+#include <algorithm>
+
+namespace orderbook {
+
+namespace {
+
+// Round the window up to a whole number of 64-bit bitmap words
+size_t roundLevels(size_t levels) {
+    levels = std::max<size_t>(levels, 64);
+    levels = std::min(levels, PriceLadder::MaxLevels);
+    return (levels + 63) & ~size_t(63);
+}
+
+}
+
+PriceLadder::PriceLadder(Side side, size_t levels)
+    : side_(side), levels_(roundLevels(levels)), bits_(roundLevels(levels) / 64, 0) {
+}
+
+void PriceLadder::clear() {
+    std::fill(bits_.begin(), bits_.end(), 0);
+    std::fill(levels_.begin(), levels_.end(), PriceLevel());
+    active_levels_ = 0;
+    best_ = -1;
+}
+
+bool PriceLadder::recenter(Price price) {
+    const int64_t capacity = static_cast<int64_t>(levels_.size());
+
+    // Span that must fit: the new price plus every active level
+    Price low = price;
+    Price high = price;
+    if (active_levels_ > 0) {
+        low = std::min(low, base_ + scanUp(0));
+        high = std::max(high, base_ + scanDown(capacity - 1));
+    }
+    const int64_t span = high - low + 1;
+    if (span <= 0 || static_cast<size_t>(span) > MaxLevels) {
+        return false;
+    }
+
+    // Keep at least as much headroom as the occupied span so the next move is cheap
+    size_t new_capacity = levels_.size();
+    while (new_capacity < static_cast<size_t>(span) * 2 && new_capacity < MaxLevels) {
+        new_capacity *= 2;
+    }
+    new_capacity = std::min(new_capacity, MaxLevels);
+
+    // Center the occupied span in the new window
+    const Price new_base = low - static_cast<Price>((new_capacity - span) / 2);
+
+    std::vector<PriceLevel> new_levels(new_capacity);
+    std::vector<uint64_t> new_bits(new_capacity / 64, 0);
+    for (int64_t idx = scanUp(0); idx >= 0; idx = scanUp(idx + 1)) {
+        int64_t new_idx = base_ + idx - new_base;
+        new_levels[new_idx] = levels_[idx];
+        new_bits[new_idx >> 6] |= (uint64_t(1) << (new_idx & 63));
+    }
+
+    levels_.swap(new_levels);
+    bits_.swap(new_bits);
+    base_ = new_base;
+
+    const int64_t top = static_cast<int64_t>(levels_.size()) - 1;
+    best_ = active_levels_ == 0 ? -1 : (side_ == Side::Buy ? scanDown(top) : scanUp(0));
+    ++generation_;
+    return true;
+}
+
+}
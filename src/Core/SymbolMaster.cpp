@@ -0,0 +1,260 @@
+#include "orderbook/Core/SymbolMaster.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace orderbook {
+
+namespace {
+
+// Attempts per bucket before the build gives up (never reached at the table's load)
+constexpr uint32_t MaxDisplacement = 1u << 24;
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// FNV-1a, then a finalizer so both the high (bucket) and low (slot) bits are mixed
+uint64_t hashSymbol(std::string_view symbol) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : symbol) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return mix(h);
+}
+
+uint32_t bucketOf(uint64_t hash, uint32_t bucket_count) {
+    return static_cast<uint32_t>(hash >> 32) & (bucket_count - 1);
+}
+
+uint32_t slotOf(uint64_t hash, uint32_t displacement, uint32_t slot_count) {
+    return static_cast<uint32_t>(mix(hash + (uint64_t(displacement) + 1) * 0x9e3779b97f4a7c15ULL)) & (slot_count - 1);
+}
+
+uint32_t roundUpPowerOfTwo(uint64_t n) {
+    uint64_t capacity = 1;
+    while (capacity < n) capacity <<= 1;
+    return static_cast<uint32_t>(capacity);
+}
+
+uint64_t alignUp(uint64_t offset, uint64_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+}
+
+Result<std::vector<unsigned char>> buildSymbolMaster(const std::vector<SymbolDefinition>& symbols) {
+    using BuildResult = Result<std::vector<unsigned char>>;
+    if (symbols.size() >= SymbolMasterHeader::EmptySlot / 2) {
+        return BuildResult::error("Too many symbols for a symbol master");
+    }
+    const uint32_t count = static_cast<uint32_t>(symbols.size());
+    std::unordered_set<std::string_view> seen;
+    for (const auto& definition : symbols) {
+        if (definition.symbol.empty() || definition.symbol.size() >= sizeof(SymbolMasterEntry::symbol)) {
+            return BuildResult::error("Symbol '" + definition.symbol + "' must be 1 to " +
+                                      std::to_string(sizeof(SymbolMasterEntry::symbol) - 1) + " bytes");
+        }
+        if (!seen.insert(definition.symbol).second) {
+            return BuildResult::error("Duplicate symbol " + definition.symbol);
+        }
+    }
+
+    // About four names per bucket and a slot table at most ~80% full
+    const uint32_t bucket_count = roundUpPowerOfTwo(std::max<uint64_t>(1, (uint64_t(count) + 3) / 4));
+    const uint32_t slot_count = roundUpPowerOfTwo(std::max<uint64_t>(2, uint64_t(count) + count / 4));
+
+    std::vector<uint64_t> hashes(count);
+    std::vector<std::vector<uint32_t>> buckets(bucket_count);
+    for (uint32_t i = 0; i < count; ++i) {
+        hashes[i] = hashSymbol(symbols[i].symbol);
+        buckets[bucketOf(hashes[i], bucket_count)].push_back(i);
+    }
+
+    // Place the fullest buckets first, while most slots are still free
+    std::vector<uint32_t> order(bucket_count);
+    for (uint32_t b = 0; b < bucket_count; ++b) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&buckets](uint32_t a, uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<uint32_t> displacements(bucket_count, 0);
+    std::vector<uint32_t> slots(slot_count, SymbolMasterHeader::EmptySlot);
+    std::vector<uint32_t> placed;
+    for (uint32_t b : order) {
+        const auto& members = buckets[b];
+        if (members.empty()) break;
+        uint32_t displacement = 0;
+        for (; displacement < MaxDisplacement; ++displacement) {
+            placed.clear();
+            bool fits = true;
+            for (uint32_t index : members) {
+                uint32_t slot = slotOf(hashes[index], displacement, slot_count);
+                if (slots[slot] != SymbolMasterHeader::EmptySlot ||
+                    std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                    fits = false;
+                    break;
+                }
+                placed.push_back(slot);
+            }
+            if (fits) break;
+        }
+        if (displacement == MaxDisplacement) {
+            return BuildResult::error("No perfect hash found for the symbol set");
+        }
+        displacements[b] = displacement;
+        for (size_t i = 0; i < members.size(); ++i) {
+            slots[placed[i]] = members[i];
+        }
+    }
+
+    SymbolMasterHeader header{};
+    std::memcpy(header.magic, SymbolMasterHeader::Magic, sizeof(header.magic));
+    header.version = SymbolMasterHeader::FormatVersion;
+    header.entry_bytes = sizeof(SymbolMasterEntry);
+    header.count = count;
+    header.bucket_count = bucket_count;
+    header.slot_count = slot_count;
+    header.buckets_offset = sizeof(SymbolMasterHeader);
+    header.slots_offset = header.buckets_offset + uint64_t(bucket_count) * sizeof(uint32_t);
+    // Entries start on a cache line
+    header.entries_offset = alignUp(header.slots_offset + uint64_t(slot_count) * sizeof(uint32_t), 64);
+
+    std::vector<unsigned char> image(header.entries_offset + uint64_t(count) * sizeof(SymbolMasterEntry), 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + header.buckets_offset, displacements.data(), displacements.size() * sizeof(uint32_t));
+    std::memcpy(image.data() + header.slots_offset, slots.data(), slots.size() * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; ++i) {
+        const SymbolDefinition& definition = symbols[i];
+        SymbolMasterEntry entry{};
+        std::memcpy(entry.symbol, definition.symbol.data(), definition.symbol.size());
+        std::memcpy(entry.name, definition.name.data(), std::min(definition.name.size(), sizeof(entry.name) - 1));
+        entry.security_id = definition.security_id;
+        entry.lot_size = std::max<Quantity>(definition.lot_size, 1);
+        entry.tick_size = PriceScale(definition.tick_size).tick_size;
+        entry.min_price = definition.min_price;
+        entry.max_price = definition.max_price;
+        std::memcpy(image.data() + header.entries_offset + uint64_t(i) * sizeof(SymbolMasterEntry), &entry, sizeof(entry));
+    }
+    return BuildResult::success(std::move(image));
+}
+
+Result<size_t> writeSymbolMaster(const std::string& path, const std::vector<SymbolDefinition>& symbols) {
+    auto image = buildSymbolMaster(symbols);
+    if (image.isError()) {
+        return Result<size_t>::error(image.error());
+    }
+    // Write beside the target and rename, so a running process never maps half a file
+    std::string temp = path + ".tmp";
+    std::FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file) {
+        return Result<size_t>::error("Cannot create " + temp + ": " + std::strerror(errno));
+    }
+    const auto& bytes = image.value();
+    bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    written = std::fclose(file) == 0 && written;
+    if (!written || std::rename(temp.c_str(), path.c_str()) != 0) {
+        int err = errno;
+        std::remove(temp.c_str());
+        return Result<size_t>::error("Cannot write " + path + ": " + std::strerror(err));
+    }
+    return Result<size_t>::success(symbols.size());
+}
+
+Result<std::unique_ptr<SymbolMaster>> SymbolMaster::open(const std::string& path, InternTable& symbols) {
+    using MasterResult = Result<std::unique_ptr<SymbolMaster>>;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return MasterResult::error("Cannot open symbol master " + path + ": " + std::strerror(errno));
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SymbolMasterHeader)) {
+        ::close(fd);
+        return MasterResult::error(path + " is not a symbol master");
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // Fault the whole file in now rather than on the first lookups
+    flags |= MAP_POPULATE;
+#endif
+    void* p = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return MasterResult::error("Cannot map symbol master " + path + ": " + std::strerror(errno));
+    }
+
+    std::unique_ptr<SymbolMaster> master(new SymbolMaster());
+    master->data_ = p;
+    master->size_ = size;
+    const auto* header = static_cast<const SymbolMasterHeader*>(p);
+    auto fits = [size](uint64_t offset, uint64_t bytes) { return offset <= size && bytes <= size - offset; };
+    auto isPowerOfTwo = [](uint32_t n) { return n != 0 && (n & (n - 1)) == 0; };
+    if (std::memcmp(header->magic, SymbolMasterHeader::Magic, sizeof(header->magic)) != 0 ||
+        header->version != SymbolMasterHeader::FormatVersion ||
+        header->entry_bytes != sizeof(SymbolMasterEntry) ||
+        !isPowerOfTwo(header->bucket_count) || !isPowerOfTwo(header->slot_count) ||
+        header->buckets_offset % alignof(uint32_t) != 0 || header->slots_offset % alignof(uint32_t) != 0 ||
+        header->entries_offset % alignof(SymbolMasterEntry) != 0 ||
+        !fits(header->buckets_offset, uint64_t(header->bucket_count) * sizeof(uint32_t)) ||
+        !fits(header->slots_offset, uint64_t(header->slot_count) * sizeof(uint32_t)) ||
+        !fits(header->entries_offset, uint64_t(header->count) * sizeof(SymbolMasterEntry))) {
+        return MasterResult::error(path + " is not a compatible symbol master");
+    }
+    const auto* base = static_cast<const unsigned char*>(p);
+    master->header_ = header;
+    master->buckets_ = reinterpret_cast<const uint32_t*>(base + header->buckets_offset);
+    master->slots_ = reinterpret_cast<const uint32_t*>(base + header->slots_offset);
+    master->entries_ = reinterpret_cast<const SymbolMasterEntry*>(base + header->entries_offset);
+    for (uint32_t slot = 0; slot < header->slot_count; ++slot) {
+        uint32_t index = master->slots_[slot];
+        if (index != SymbolMasterHeader::EmptySlot && index >= header->count) {
+            return MasterResult::error(path + " has a corrupt slot table");
+        }
+    }
+
+    master->symbol_ids_.resize(header->count);
+    for (uint32_t i = 0; i < header->count; ++i) {
+        const SymbolMasterEntry& entry = master->entries_[i];
+        if (entry.lot_size == 0) {
+            return MasterResult::error(path + " has a zero lot size in entry " + std::to_string(i));
+        }
+        SymbolId id = symbols.intern(entry.symbolView());
+        if (id == InternTable::EmptyId) {
+            return MasterResult::error("Cannot intern symbol master entry " + std::to_string(i));
+        }
+        if (master->by_symbol_.size() <= id) {
+            master->by_symbol_.resize(id + 1, nullptr);
+        }
+        master->by_symbol_[id] = &entry;
+        master->symbol_ids_[i] = id;
+    }
+    return MasterResult::success(std::move(master));
+}
+
+SymbolMaster::~SymbolMaster() {
+    if (data_) ::munmap(data_, size_);
+}
+
+const SymbolMasterEntry* SymbolMaster::find(std::string_view symbol) const {
+    if (header_->count == 0) return nullptr;
+    uint64_t hash = hashSymbol(symbol);
+    uint32_t displacement = buckets_[bucketOf(hash, header_->bucket_count)];
+    uint32_t index = slots_[slotOf(hash, displacement, header_->slot_count)];
+    if (index == SymbolMasterHeader::EmptySlot) return nullptr;
+    const SymbolMasterEntry& entry = entries_[index];
+    return entry.symbolView() == symbol ? &entry : nullptr;
+}
+
+}
@@ -29,10 +29,75 @@ static inline void trim(std::string &s) {
 
 namespace orderbook {
 
-QuickFixConnector::QuickFixConnector(MarketDataPublisherPtr publisher, std::shared_ptr<Config> cfg, LoggerPtr logger, OrderBook* book)
+QuickFixConnector::QuickFixConnector(MarketDataPublisherPtr publisher, std::shared_ptr<Config> cfg, LoggerPtr logger, OrderBook* book,
+                                     SymbolMasterPtr symbol_master)
     : publisher_(publisher), config_(cfg), logger_(logger) {
     quickfix_config_path_ = config_->getString("marketdata", "quickfix_config", "config/quickfix/quickfix.cfg");
+    price_scale_ = PriceScale(config_->getDouble("orderbook", "tick_size", price_scale_.tick_size));
     order_book_ = book;
+    apply_to_book_ = config_->getBool("marketdata", "apply_to_book", false);
+
+    std::istringstream ss(config_->getString("marketdata", "symbols", ""));
+    std::string symbol;
+    while (std::getline(ss, symbol, ',')) {
+        trim(symbol);
+        if (symbol.empty()) continue;
+        SymbolId id = resolveSymbol(symbol);
+        symbol_filter_.insert(id);
+        mirrors_.emplace(id, std::make_unique<L2Book>());
+        symbols_.push_back(symbol);
+    }
+    // No explicit list: subscribe to every instrument in the symbol master
+    if (symbols_.empty() && symbol_master) {
+        for (size_t i = 0; i < symbol_master->size(); ++i) {
+            SymbolId id = symbol_master->symbolId(i);
+            symbol_filter_.insert(id);
+            mirrors_.emplace(id, std::make_unique<L2Book>());
+            symbols_.emplace_back(symbol_master->entry(i).symbolView());
+            symbol_ids_.emplace(symbols_.back(), id);
+        }
+    }
+    book_batch_.reserve(64);
+    mirror_batch_.reserve(64);
+}
+
+void QuickFixConnector::applyMirrorBatch() {
+    // Entries are grouped by symbol in feed order; each run is one delta on its mirror
+    size_t begin = 0;
+    while (begin < mirror_batch_.size()) {
+        L2Book* book = mirror_batch_[begin].first;
+        book_batch_.clear();
+        size_t end = begin;
+        while (end < mirror_batch_.size() && mirror_batch_[end].first == book) {
+            book_batch_.push_back(mirror_batch_[end].second);
+            ++end;
+        }
+        book->applyUpdates(book_batch_.data(), book_batch_.size());
+        begin = end;
+    }
+    mirror_batch_.clear();
+}
+
+void QuickFixConnector::markMirrorsStale() {
+    for (auto& entry : mirrors_) {
+        entry.second->markStale();
+    }
+}
+
+SymbolId QuickFixConnector::resolveSymbol(const std::string& symbol) {
+    auto it = symbol_ids_.find(symbol);
+    if (it != symbol_ids_.end()) {
+        return it->second;
+    }
+    SymbolId id = symbolTable().intern(symbol);
+    symbol_ids_.emplace(symbol, id);
+    return id;
+}
+
+void QuickFixConnector::requestSnapshots(const FIX::SessionID& sessionID) {
+    for (const auto& symbol : symbols_) {
+        requestSnapshot(sessionID, symbol);
+    }
 }
 
 QuickFixConnector::~QuickFixConnector() {
@@ -81,37 +146,31 @@ void QuickFixConnector::onLogon(const FIX::SessionID& sessionID) {
 
 
     // On logon, subscribe for MD for all configured symbols
-    std::string symbols = config_->getString("marketdata", "symbols", "");
-    if (!symbols.empty()) {
-        std::istringstream ss(symbols);
-        std::string symbol;
-        while (std::getline(ss, symbol, ',')) {
-            trim(symbol);
-            // Build MDRequest
-            FIX44::MarketDataRequest mdReq;
-            FIX::MDReqID reqId("MD-" + symbol);
-            mdReq.set(reqId);
-            mdReq.set(FIX::SubscriptionRequestType(FIX::SubscriptionRequestType_SNAPSHOT_AND_UPDATES));
-            mdReq.set(FIX::MarketDepth(1));
-            mdReq.set(FIX::MDUpdateType(FIX::MDUpdateType_INCREMENTAL_REFRESH));
-
-            // Add MDEntryTypes (Bid and Ask)
-            FIX44::MarketDataRequest::NoMDEntryTypes marketDataEntryGroup;
-            marketDataEntryGroup.set(FIX::MDEntryType(FIX::MDEntryType_BID));
-            mdReq.addGroup(marketDataEntryGroup);
-            marketDataEntryGroup.set(FIX::MDEntryType(FIX::MDEntryType_OFFER));
-            mdReq.addGroup(marketDataEntryGroup);
-
-            // No related symbols
-            FIX44::MarketDataRequest::NoRelatedSym relSym;
-            relSym.set(FIX::Symbol(symbol));
-            mdReq.addGroup(relSym);
-            try {
-                FIX::Session::sendToTarget(mdReq, sessionID);
-                if (logger_) logger_->info("Sent MarketDataRequest for: " + symbol, "QuickFixConnector::onLogon");
-            } catch (const std::exception& e) {
-                if (logger_) logger_->error(std::string("Failed to send MarketDataRequest: ") + e.what(), "QuickFixConnector::onLogon");
-            }
+    for (const auto& symbol : symbols_) {
+        // Build MDRequest
+        FIX44::MarketDataRequest mdReq;
+        FIX::MDReqID reqId("MD-" + symbol);
+        mdReq.set(reqId);
+        mdReq.set(FIX::SubscriptionRequestType(FIX::SubscriptionRequestType_SNAPSHOT_AND_UPDATES));
+        mdReq.set(FIX::MarketDepth(1));
+        mdReq.set(FIX::MDUpdateType(FIX::MDUpdateType_INCREMENTAL_REFRESH));
+
+        // Add MDEntryTypes (Bid and Ask)
+        FIX44::MarketDataRequest::NoMDEntryTypes marketDataEntryGroup;
+        marketDataEntryGroup.set(FIX::MDEntryType(FIX::MDEntryType_BID));
+        mdReq.addGroup(marketDataEntryGroup);
+        marketDataEntryGroup.set(FIX::MDEntryType(FIX::MDEntryType_OFFER));
+        mdReq.addGroup(marketDataEntryGroup);
+
+        // No related symbols
+        FIX44::MarketDataRequest::NoRelatedSym relSym;
+        relSym.set(FIX::Symbol(symbol));
+        mdReq.addGroup(relSym);
+        try {
+            FIX::Session::sendToTarget(mdReq, sessionID);
+            if (logger_) logger_->info("Sent MarketDataRequest for: " + symbol, "QuickFixConnector::onLogon");
+        } catch (const std::exception& e) {
+            if (logger_) logger_->error(std::string("Failed to send MarketDataRequest: ") + e.what(), "QuickFixConnector::onLogon");
         }
     }
 }
@@ -175,16 +234,9 @@ void QuickFixConnector::fromApp(const FIX::Message& message, const FIX::SessionI
                 if (order_book_) {
                     order_book_->clearBook();
                 }
+                markMirrorsStale();
                 // Request snapshots for all configured symbols
-                std::string symbols = config_->getString("marketdata", "symbols", "");
-                if (!symbols.empty()) {
-                    std::istringstream ss(symbols);
-                    std::string symbol;
-                    while (std::getline(ss, symbol, ',')) {
-                        trim(symbol);
-                        requestSnapshot(sessionID, symbol);
-                    }
-                }
+                requestSnapshots(sessionID);
             }
             last_msg_seq_.store(seq);
             messages_processed_.fetch_add(1, std::memory_order_relaxed);
@@ -218,7 +270,7 @@ void QuickFixConnector::onMessage(const FIX44::MarketDataSnapshotFullRefresh& me
 
     // Build MarketDepth object
     MarketDepth depth;
-    depth.timestamp = std::chrono::system_clock::now();
+    depth.timestamp = TscClock::now();
 
     FIX::NoMDEntries noEntriesField;
     if (message.isSetField(noEntriesField)) {
@@ -241,15 +293,22 @@ void QuickFixConnector::onMessage(const FIX44::MarketDataSnapshotFullRefresh& me
             double size = mdSize.getValue();
             int orderCount = mdOrders.getValue();
 
-        MarketDepth::Level level{static_cast<Price>(px), static_cast<Quantity>(size), static_cast<size_t>(orderCount)};
+        MarketDepth::Level level{price_scale_.toTicks(px), static_cast<Quantity>(size), static_cast<size_t>(orderCount)};
         if (mdEntryType == FIX::MDEntryType_BID) depth.bids.push_back(level);
         else depth.asks.push_back(level);
     }
     }
 
     publisher_->publishDepth(depth);
+    FIX::Symbol snapshotSymbol;
+    if (message.isSetField(snapshotSymbol)) {
+        message.getField(snapshotSymbol);
+        if (L2Book* book = mirrorFor(resolveSymbol(snapshotSymbol.getValue()))) {
+            book->applySnapshot(depth);
+        }
+    }
     if (seq > 0) last_msg_seq_.store(seq);
-    if (order_book_ && config_->getBool("marketdata", "apply_to_book", false)) {
+    if (order_book_ && apply_to_book_) {
         order_book_->applyExternalMarketData(depth);
     }
 }
@@ -274,72 +333,87 @@ void QuickFixConnector::onMessage(const FIX44::MarketDataIncrementalRefresh& mes
                 if (order_book_) {
                     order_book_->clearBook();
                 }
-                std::string symbols = config_->getString("marketdata", "symbols", "");
-                if (!symbols.empty()) {
-                    std::istringstream ss(symbols);
-                    std::string symbol;
-                    while (std::getline(ss, symbol, ',')) { trim(symbol); requestSnapshot(sessionID, symbol); }
-                }
+                markMirrorsStale();
+                requestSnapshots(sessionID);
             }
         }
     } catch(...) {}
 
     FIX::NoMDEntries noEntriesInc;
+    book_batch_.clear();
     if (message.isSetField(noEntriesInc)) {
         message.get(noEntriesInc);
         int noEntries = noEntriesInc.getValue();
         FIX44::MarketDataIncrementalRefresh::NoMDEntries group;
         for (int i = 1; i <= noEntries; ++i) {
             message.getGroup(i, group);
-        FIX::MDEntryType mdType;
-        FIX::MDUpdateAction mdAction;
-        FIX::MDEntryPx mdPx;
-        FIX::MDEntrySize mdSize;
-        FIX::NumberOfOrders mdOrders;
-        if (group.isSetField(mdType)) group.get(mdType);
-        if (group.isSetField(mdAction)) group.get(mdAction);
-        if (group.isSetField(mdPx)) group.get(mdPx);
-        if (group.isSetField(mdSize)) group.get(mdSize);
-        if (group.isSetField(mdOrders)) group.get(mdOrders);
-        char mdEntryType = mdType.getValue();
-        char mdUpdateAction = mdAction.getValue();
-        double px = mdPx.getValue();
-        double size = mdSize.getValue();
-        int orderCount = mdOrders.getValue();
-
-        BookUpdate::Type type = BookUpdate::Type::Modify;
-        if (mdUpdateAction == '0') type = BookUpdate::Type::Add;
-        else if (mdUpdateAction == '1') type = BookUpdate::Type::Modify;
-        else if (mdUpdateAction == '2') type = BookUpdate::Type::Remove;
-
-        SequenceNumber seq = 0;
-        BookUpdate upd(type,
-                   (mdEntryType == FIX::MDEntryType_BID) ? Side::Buy : Side::Sell,
-                   static_cast<Price>(px), static_cast<Quantity>(size), static_cast<size_t>(orderCount), seq);
-        publisher_->publishBookUpdate(upd);
-        if (order_book_ && config_->getBool("marketdata", "apply_to_book", false)) {
-            order_book_->applyExternalBookUpdate(upd);
-        }
 
-        if (mdEntryType == FIX::MDEntryType_TRADE) {
-            Trade trade;
-            // Trivial mapping: no buy/sell order ids from MD; set zeros
-            trade.price = static_cast<Price>(px);
-            trade.quantity = static_cast<Quantity>(size);
-            trade.id = TradeId(0);
-            trade.buy_order_id = OrderId(0);
-            trade.sell_order_id = OrderId(0);
-            FIX::Symbol symbol;
-            if (message.isSetField(symbol)) {
-                message.getField(symbol);
-                std::strncpy(trade.symbol, symbol.getValue().c_str(), sizeof(trade.symbol) - 1);
-                trade.symbol[sizeof(trade.symbol) - 1] = '\0';
+            // Entries carry their own Symbol; skip the ones outside the allow-list
+            SymbolId symbol_id = InternTable::EmptyId;
+            FIX::Symbol entrySymbol;
+            if (group.isSetField(entrySymbol)) {
+                group.get(entrySymbol);
+                symbol_id = resolveSymbol(entrySymbol.getValue());
+                if (!symbol_filter_.empty() && symbol_filter_.count(symbol_id) == 0) {
+                    continue;
+                }
+            }
+
+            FIX::MDEntryType mdType;
+            FIX::MDUpdateAction mdAction;
+            FIX::MDEntryPx mdPx;
+            FIX::MDEntrySize mdSize;
+            FIX::NumberOfOrders mdOrders;
+            if (group.isSetField(mdType)) group.get(mdType);
+            if (group.isSetField(mdAction)) group.get(mdAction);
+            if (group.isSetField(mdPx)) group.get(mdPx);
+            if (group.isSetField(mdSize)) group.get(mdSize);
+            if (group.isSetField(mdOrders)) group.get(mdOrders);
+            char mdEntryType = mdType.getValue();
+            char mdUpdateAction = mdAction.getValue();
+            double px = mdPx.getValue();
+            double size = mdSize.getValue();
+            int orderCount = mdOrders.getValue();
+
+            if (mdEntryType == FIX::MDEntryType_TRADE) {
+                Trade trade;
+                // Trivial mapping: no buy/sell order ids from MD; set zeros
+                trade.price = price_scale_.toTicks(px);
+                trade.quantity = static_cast<Quantity>(size);
+                trade.id = TradeId(0);
+                trade.buy_order_id = OrderId(0);
+                trade.sell_order_id = OrderId(0);
+                trade.symbol_id = symbol_id;
+                FIX::Symbol symbol;
+                if (symbol_id == InternTable::EmptyId && message.isSetField(symbol)) {
+                    message.getField(symbol);
+                    trade.symbol_id = resolveSymbol(symbol.getValue());
+                }
+                trade.timestamp = TscClock::now();
+                publisher_->publishTrade(trade);
+                continue;
+            }
+
+            BookUpdate::Type type = BookUpdate::Type::Modify;
+            if (mdUpdateAction == '0') type = BookUpdate::Type::Add;
+            else if (mdUpdateAction == '1') type = BookUpdate::Type::Modify;
+            else if (mdUpdateAction == '2') type = BookUpdate::Type::Remove;
+
+            book_batch_.emplace_back(type,
+                       (mdEntryType == FIX::MDEntryType_BID) ? Side::Buy : Side::Sell,
+                       price_scale_.toTicks(px), static_cast<Quantity>(size), static_cast<size_t>(orderCount), 0);
+            publisher_->publishBookUpdate(book_batch_.back());
+            if (L2Book* book = mirrorFor(symbol_id)) {
+                mirror_batch_.emplace_back(book, book_batch_.back());
             }
-            trade.timestamp = std::chrono::system_clock::now();
-            publisher_->publishTrade(trade);
         }
     }
+
+    // The whole message lands in the book as one contiguous delta
+    if (order_book_ && apply_to_book_ && !book_batch_.empty()) {
+        order_book_->applyExternalBookUpdates(book_batch_.data(), book_batch_.size());
     }
+    applyMirrorBatch();
     if (seq > 0) last_msg_seq_.store(seq);
 }
 
@@ -0,0 +1,108 @@
+#include "orderbook/MarketData/L2Book.hpp"
+#include <algorithm>
+
+namespace orderbook {
+
+L2Book::L2Book(size_t published_levels)
+    : published_levels_(std::min(published_levels, L2Snapshot::MaxLevels)) {
+    bids_.reserve(64);
+    asks_.reserve(64);
+}
+
+L2Book::ApplyResult L2Book::applySnapshot(const MarketDepth& depth, SequenceNumber sequence) {
+    if (sequence != 0 && last_sequence_ != 0 && sequence <= last_sequence_ && !stale_) {
+        return ApplyResult::Duplicate;
+    }
+
+    bids_.clear();
+    asks_.clear();
+    for (const auto& level : depth.bids) {
+        if (level.quantity == 0) continue;
+        bids_.push_back(L2Level{level.price, level.quantity, static_cast<uint32_t>(level.order_count)});
+    }
+    for (const auto& level : depth.asks) {
+        if (level.quantity == 0) continue;
+        asks_.push_back(L2Level{level.price, level.quantity, static_cast<uint32_t>(level.order_count)});
+    }
+    // Feeds do not always send levels best-first
+    std::sort(bids_.begin(), bids_.end(), [](const L2Level& a, const L2Level& b) { return a.price > b.price; });
+    std::sort(asks_.begin(), asks_.end(), [](const L2Level& a, const L2Level& b) { return a.price < b.price; });
+
+    if (sequence != 0) last_sequence_ = sequence;
+    stale_ = false;
+    publish();
+    return ApplyResult::Applied;
+}
+
+L2Book::ApplyResult L2Book::applyUpdates(const BookUpdate* updates, size_t count, SequenceNumber sequence) {
+    if (sequence != 0 && last_sequence_ != 0) {
+        if (sequence <= last_sequence_) {
+            return ApplyResult::Duplicate;
+        }
+        if (sequence != last_sequence_ + 1 && !stale_) {
+            ++gaps_;
+            last_sequence_ = sequence;
+            markStale();
+            return ApplyResult::Gap;
+        }
+    }
+    if (sequence != 0) last_sequence_ = sequence;
+    if (stale_) {
+        return ApplyResult::Stale;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        applyLevel(updates[i]);
+    }
+    publish();
+    return ApplyResult::Applied;
+}
+
+void L2Book::markStale() {
+    if (stale_) return;
+    stale_ = true;
+    publish();
+}
+
+void L2Book::clear() {
+    bids_.clear();
+    asks_.clear();
+    stale_ = true;
+    publish();
+}
+
+void L2Book::applyLevel(const BookUpdate& update) {
+    bool is_bid = update.side == Side::Buy;
+    auto& levels = is_bid ? bids_ : asks_;
+    auto it = is_bid
+        ? std::lower_bound(levels.begin(), levels.end(), update.price,
+                           [](const L2Level& l, Price p) { return l.price > p; })
+        : std::lower_bound(levels.begin(), levels.end(), update.price,
+                           [](const L2Level& l, Price p) { return l.price < p; });
+    bool found = it != levels.end() && it->price == update.price;
+
+    if (update.type == BookUpdate::Type::Remove || update.quantity == 0) {
+        if (found) levels.erase(it);
+        return;
+    }
+    if (found) {
+        it->quantity = update.quantity;
+        it->order_count = static_cast<uint32_t>(update.order_count);
+    } else {
+        levels.insert(it, L2Level{update.price, update.quantity, static_cast<uint32_t>(update.order_count)});
+    }
+}
+
+void L2Book::publish() {
+    L2Snapshot snap;
+    snap.bid_count = static_cast<uint16_t>(std::min(bids_.size(), published_levels_));
+    snap.ask_count = static_cast<uint16_t>(std::min(asks_.size(), published_levels_));
+    std::copy_n(bids_.begin(), snap.bid_count, snap.bids.begin());
+    std::copy_n(asks_.begin(), snap.ask_count, snap.asks.begin());
+    snap.stale = stale_;
+    snap.sequence = last_sequence_;
+    snap.timestamp = TscClock::now();
+    published_.store(snap);
+}
+
+}
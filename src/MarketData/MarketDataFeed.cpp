@@ -7,21 +7,207 @@
 
 namespace orderbook {
 
-MarketDataPublisher::MarketDataPublisher(LoggerPtr logger) 
-    : sequence_number_(0), logger_(logger) {
+namespace {
+std::atomic<uint64_t> next_publisher_id{1};
+}
+
+MarketDataPublisher::MarketDataPublisher(LoggerPtr logger, MarketDataPublisherOptions options)
+    : options_(options), sequence_number_(0),
+      instance_id_(next_publisher_id.fetch_add(1)), logger_(logger) {
     disabled_.store(false);
+    startPublisher();
     if (logger_) {
-        logger_->info("MarketDataPublisher initialized", "MarketDataPublisher::ctor");
+        logger_->info(std::string("MarketDataPublisher initialized (") +
+                     (options_.async ? "async" : "inline") + ")", "MarketDataPublisher::ctor");
     }
 }
 
+MarketDataPublisher::~MarketDataPublisher() {
+    stopPublisher();
+}
+
 void MarketDataPublisher::publishTrade(const Trade& trade) {
     if (disabled_.load(std::memory_order_relaxed)) return;
+    if (async_.load(std::memory_order_acquire)) {
+        MarketEvent event;
+        event.type = MarketEvent::Type::Trade;
+        event.trade = trade;
+        journal(event);
+        return;
+    }
+    deliverTrade(trade);
+}
+
+void MarketDataPublisher::publishBookUpdate(const BookUpdate& update) {
+    if (disabled_.load(std::memory_order_relaxed)) return;
+    if (async_.load(std::memory_order_acquire)) {
+        MarketEvent event;
+        event.type = MarketEvent::Type::BookUpdate;
+        event.update = update;
+        journal(event);
+        return;
+    }
+    deliverBookUpdate(update);
+}
+
+void MarketDataPublisher::publishBestPrices(const BestPrices& prices) {
+    if (disabled_.load(std::memory_order_relaxed)) return;
+    if (async_.load(std::memory_order_acquire)) {
+        MarketEvent event;
+        event.type = MarketEvent::Type::BestPrices;
+        event.prices = prices;
+        journal(event);
+        return;
+    }
+    deliverBestPrices(prices);
+}
+
+void MarketDataPublisher::publishDepth(const MarketDepth& depth) {
+    if (disabled_.load(std::memory_order_relaxed)) return;
+    if (async_.load(std::memory_order_acquire)) {
+        // Levels are copied inline; deeper levels than the journal holds are cut off
+        MarketEvent event;
+        event.type = MarketEvent::Type::Depth;
+        size_t bids = std::min(depth.bids.size(), MaxDepthLevels);
+        size_t asks = std::min(depth.asks.size(), MaxDepthLevels);
+        std::copy_n(depth.bids.begin(), bids, event.depth.bids);
+        std::copy_n(depth.asks.begin(), asks, event.depth.asks);
+        event.depth.bid_count = static_cast<uint8_t>(bids);
+        event.depth.ask_count = static_cast<uint8_t>(asks);
+        event.depth.timestamp = depth.timestamp;
+        journal(event);
+        return;
+    }
+    deliverDepth(depth);
+}
+
+void MarketDataPublisher::startPublisher() {
+    if (!options_.async || publisher_.joinable()) {
+        return;
+    }
+    stop_publisher_.store(false, std::memory_order_relaxed);
+    async_.store(true, std::memory_order_release);
+    publisher_ = std::thread(&MarketDataPublisher::publisherLoop, this);
+}
+
+void MarketDataPublisher::stopPublisher() {
+    if (!publisher_.joinable()) {
+        return;
+    }
+    // Later publishes go inline; the publisher drains what is already journaled
+    async_.store(false, std::memory_order_release);
+    stop_publisher_.store(true, std::memory_order_release);
+    publisher_.join();
+}
+
+MarketDataPublisher::Journal* MarketDataPublisher::threadJournal() {
+    // One-entry cache; publisher IDs are never reused, so a stale entry cannot match
+    struct Cache { uint64_t owner = 0; Journal* journal = nullptr; };
+    static thread_local Cache cache;
+    if (cache.owner == instance_id_) {
+        return cache.journal;
+    }
+    std::lock_guard<std::mutex> lock(journals_mutex_);
+    auto& journal = journal_by_thread_[std::this_thread::get_id()];
+    if (!journal) {
+        journals_.push_back(std::make_unique<Journal>(options_.journal_capacity));
+        journal = journals_.back().get();
+    }
+    cache.owner = instance_id_;
+    cache.journal = journal;
+    return journal;
+}
+
+void MarketDataPublisher::journal(MarketEvent& event) {
+    Journal* journal = threadJournal();
+    // A dropped event still consumes its sequence number, which is how the publisher sees the gap
+    event.journal_sequence = journal->next_sequence++;
+    if (!journal->ring.push(event)) {
+        journal_drops_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MarketDataPublisher::publisherLoop() {
+    while (!stop_publisher_.load(std::memory_order_acquire)) {
+        if (drainJournals() == 0) {
+            idle_passes_.fetch_add(1, std::memory_order_release);
+            std::this_thread::sleep_for(std::chrono::microseconds(options_.idle_sleep_us));
+        }
+    }
+    // Producers switch to inline publishing before stop, so this final pass is complete
+    while (drainJournals() > 0) {}
+    idle_passes_.fetch_add(1, std::memory_order_release);
+}
+
+size_t MarketDataPublisher::drainJournals() {
+    {
+        std::lock_guard<std::mutex> lock(journals_mutex_);
+        publisher_journals_.clear();
+        for (auto& journal : journals_) publisher_journals_.push_back(journal.get());
+    }
+
+    size_t delivered = 0;
+    for (Journal* journal : publisher_journals_) {
+        journal->ring.consume_all([this, journal, &delivered](const MarketEvent& event) {
+            if (event.journal_sequence != journal->expected_sequence) {
+                uint64_t missing = event.journal_sequence - journal->expected_sequence;
+                // Burn the sequence numbers the dropped events would have used
+                sequence_number_.fetch_add(missing, std::memory_order_relaxed);
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    stats_.sequence_gaps++;
+                }
+                LOG_WARN(logger_, "MarketDataPublisher::drainJournals",
+                         "Journal gap: {} events dropped before journal sequence {}",
+                         missing, event.journal_sequence);
+            }
+            journal->expected_sequence = event.journal_sequence + 1;
+            deliver(event);
+            ++delivered;
+        });
+    }
+    return delivered;
+}
+
+void MarketDataPublisher::deliver(const MarketEvent& event) {
+    switch (event.type) {
+        case MarketEvent::Type::Trade:
+            deliverTrade(event.trade);
+            break;
+        case MarketEvent::Type::BookUpdate:
+            deliverBookUpdate(event.update);
+            break;
+        case MarketEvent::Type::BestPrices:
+            deliverBestPrices(event.prices);
+            break;
+        case MarketEvent::Type::Depth: {
+            MarketDepth depth;
+            depth.bids.assign(event.depth.bids, event.depth.bids + event.depth.bid_count);
+            depth.asks.assign(event.depth.asks, event.depth.asks + event.depth.ask_count);
+            depth.timestamp = event.depth.timestamp;
+            deliverDepth(depth);
+            break;
+        }
+    }
+}
+
+void MarketDataPublisher::flush() {
+    if (!async_.load(std::memory_order_acquire)) {
+        return;
+    }
+    // Two idle passes after the call means a full pass started after it and found nothing
+    uint64_t target = idle_passes_.load(std::memory_order_acquire) + 2;
+    while (idle_passes_.load(std::memory_order_acquire) < target && publisher_.joinable()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(options_.idle_sleep_us));
+    }
+}
+
+void MarketDataPublisher::deliverTrade(const Trade& trade) {
     PERF_MEASURE_SCOPE("MarketDataPublisher::publishTrade");
     
     if (logger_ && logger_->isLogLevelEnabled(LogLevel::DEBUG)) {
         logger_->debug("Publishing trade ID: " + std::to_string(trade.id.value) +
-                      " Symbol: " + trade.symbol + " Price: " + std::to_string(trade.price) +
+                      " Symbol: " + trade.symbol() + " Price: " + std::to_string(trade.price) +
                       " Quantity: " + std::to_string(trade.quantity), "MarketDataPublisher::publishTrade");
     }
     
@@ -52,8 +238,7 @@ void MarketDataPublisher::publishTrade(const Trade& trade) {
     }
 }
 
-void MarketDataPublisher::publishBookUpdate(const BookUpdate& update) {
-    if (disabled_.load(std::memory_order_relaxed)) return;
+void MarketDataPublisher::deliverBookUpdate(const BookUpdate& update) {
     PERF_MEASURE_SCOPE("MarketDataPublisher::publishBookUpdate");
     auto start_time = getCurrentTimeNs();
     
@@ -74,8 +259,7 @@ void MarketDataPublisher::publishBookUpdate(const BookUpdate& update) {
     }
 }
 
-void MarketDataPublisher::publishBestPrices(const BestPrices& prices) {
-    if (disabled_.load(std::memory_order_relaxed)) return;
+void MarketDataPublisher::deliverBestPrices(const BestPrices& prices) {
     PERF_MEASURE_SCOPE("MarketDataPublisher::publishBestPrices");
     auto start_time = getCurrentTimeNs();
     
@@ -99,8 +283,7 @@ void MarketDataPublisher::publishBestPrices(const BestPrices& prices) {
     }
 }
 
-void MarketDataPublisher::publishDepth(const MarketDepth& depth) {
-    if (disabled_.load(std::memory_order_relaxed)) return;
+void MarketDataPublisher::deliverDepth(const MarketDepth& depth) {
     PERF_MEASURE_SCOPE("MarketDataPublisher::publishDepth");
     auto start_time = getCurrentTimeNs();
     
@@ -177,22 +360,24 @@ uint64_t MarketDataPublisher::getTotalPublishedMessages() const {
 
 MarketDataPublisher::PublishingStats MarketDataPublisher::getStats() const {
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    return stats_;
+    PublishingStats stats = stats_;
+    stats.journal_drops = journal_drops_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void MarketDataPublisher::resetStats() {
     std::lock_guard<std::mutex> lock(stats_mutex_);
     stats_ = PublishingStats{};
+    journal_drops_.store(0, std::memory_order_relaxed);
 }
 
 std::string MarketDataPublisher::formatTradeMessage(const Trade& trade, SequenceNumber seq) const {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(2);
-    oss << "TRADE|" << seq << "|" << trade.id.value << "|" << trade.symbol 
+    oss << "TRADE|" << seq << "|" << trade.id.value << "|" << trade.symbol() 
         << "|" << trade.price << "|" << trade.quantity 
         << "|" << trade.buy_order_id.value << "|" << trade.sell_order_id.value
-        << "|" << std::chrono::duration_cast<std::chrono::microseconds>(
-               trade.timestamp.time_since_epoch()).count();
+        << "|" << TscClock::toWallNanos(trade.timestamp) / 1000;
     return oss.str();
 }
 
@@ -210,8 +395,7 @@ std::string MarketDataPublisher::formatBookUpdateMessage(const BookUpdate& updat
     oss << "|" << (update.side == Side::Buy ? "BUY" : "SELL")
         << "|" << update.price << "|" << update.quantity 
         << "|" << update.order_count
-        << "|" << std::chrono::duration_cast<std::chrono::microseconds>(
-               update.timestamp.time_since_epoch()).count();
+        << "|" << TscClock::toWallNanos(update.timestamp) / 1000;
     return oss.str();
 }
 
@@ -234,8 +418,7 @@ std::string MarketDataPublisher::formatBestPricesMessage(const BestPrices& price
         oss << "0|0";
     }
     
-    oss << "|" << std::chrono::duration_cast<std::chrono::microseconds>(
-               prices.timestamp.time_since_epoch()).count();
+    oss << "|" << TscClock::toWallNanos(prices.timestamp) / 1000;
     return oss.str();
 }
 
@@ -256,8 +439,7 @@ std::string MarketDataPublisher::formatDepthMessage(const MarketDepth& depth, Se
         oss << "|" << level.price << "|" << level.quantity << "|" << level.order_count;
     }
     
-    oss << "|" << std::chrono::duration_cast<std::chrono::microseconds>(
-               depth.timestamp.time_since_epoch()).count();
+    oss << "|" << TscClock::toWallNanos(depth.timestamp) / 1000;
     return oss.str();
 }
 
@@ -359,8 +541,7 @@ void MarketDataPublisher::recordLatency(uint64_t latency_ns) {
 }
 
 uint64_t MarketDataPublisher::getCurrentTimeNs() const {
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    return TscClock::toNanos(TscClock::now());
 }
 
 void MarketDataPublisher::cleanupExpiredSubscribers() {
@@ -0,0 +1,296 @@
+#include "orderbook/MarketData/MulticastFeed.hpp"
+#include "orderbook/Core/MarketData.hpp"
+#include "orderbook/Core/Order.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+namespace orderbook {
+
+namespace asio = boost::asio;
+using asio::ip::tcp;
+using asio::ip::udp;
+
+MulticastFeedPublisher::MulticastFeedPublisher(MulticastFeedOptions options, MarketDataPublisherPtr next)
+    : options_(std::move(options)), next_(std::move(next)),
+      session_(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count())),
+      max_messages_(std::clamp<size_t>((std::max(options_.packet_bytes, sizeof(FeedPacketHeader)) -
+                                        sizeof(FeedPacketHeader)) / sizeof(FeedMessage), 1, UINT16_MAX)),
+      socket_(io_), snapshot_acceptor_(io_),
+      packet_(sizeof(FeedPacketHeader) + max_messages_ * sizeof(FeedMessage)) {
+}
+
+Result<std::unique_ptr<MulticastFeedPublisher>> MulticastFeedPublisher::create(const MulticastFeedOptions& options,
+                                                                               MarketDataPublisherPtr next) {
+    using FeedResult = Result<std::unique_ptr<MulticastFeedPublisher>>;
+    std::unique_ptr<MulticastFeedPublisher> feed(new MulticastFeedPublisher(options, std::move(next)));
+    boost::system::error_code ec;
+
+    asio::ip::address group = asio::ip::make_address(options.group, ec);
+    if (ec || !group.is_v4() || !group.is_multicast()) {
+        return FeedResult::error("Invalid multicast group " + options.group);
+    }
+    asio::ip::address interface_address = asio::ip::make_address(options.interface_address, ec);
+    if (ec || !interface_address.is_v4()) {
+        return FeedResult::error("Invalid multicast interface " + options.interface_address);
+    }
+    feed->group_endpoint_ = udp::endpoint(group, options.port);
+    feed->socket_.open(udp::v4(), ec);
+    if (!ec) feed->socket_.set_option(asio::ip::multicast::hops(options.ttl), ec);
+    if (!ec) feed->socket_.set_option(asio::ip::multicast::enable_loopback(options.loopback), ec);
+    if (!ec && !interface_address.is_unspecified()) {
+        feed->socket_.set_option(asio::ip::multicast::outbound_interface(interface_address.to_v4()), ec);
+    }
+    if (ec) {
+        return FeedResult::error("Cannot open multicast socket: " + ec.message());
+    }
+
+    if (options.snapshot_port != 0) {
+        tcp::endpoint endpoint(tcp::v4(), options.snapshot_port);
+        feed->snapshot_acceptor_.open(endpoint.protocol(), ec);
+        if (!ec) feed->snapshot_acceptor_.set_option(asio::socket_base::reuse_address(true), ec);
+        if (!ec) feed->snapshot_acceptor_.bind(endpoint, ec);
+        if (!ec) feed->snapshot_acceptor_.listen(asio::socket_base::max_listen_connections, ec);
+        if (ec) {
+            return FeedResult::error("Cannot open snapshot channel on port " +
+                                     std::to_string(options.snapshot_port) + ": " + ec.message());
+        }
+        feed->snapshot_port_ = feed->snapshot_acceptor_.local_endpoint().port();
+        feed->acceptSnapshot();
+        feed->io_thread_ = std::thread([raw = feed.get()] { raw->io_.run(); });
+    }
+
+    feed->flusher_ = std::thread(&MulticastFeedPublisher::flushLoop, feed.get());
+    return FeedResult::success(std::move(feed));
+}
+
+MulticastFeedPublisher::~MulticastFeedPublisher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    flush_cv_.notify_all();
+    if (flusher_.joinable()) flusher_.join();
+    io_.stop();
+    if (io_thread_.joinable()) io_thread_.join();
+}
+
+void MulticastFeedPublisher::appendLocked(const FeedMessage& message) {
+    unsigned char* slot = packet_.data() + sizeof(FeedPacketHeader) + packet_messages_ * sizeof(FeedMessage);
+    std::memcpy(slot, &message, sizeof(FeedMessage));
+    ++sequence_;
+    if (++packet_messages_ == 1) {
+        // Start the flush window for this packet
+        flush_cv_.notify_one();
+    }
+    if (packet_messages_ == max_messages_) {
+        sendPacketLocked();
+    }
+}
+
+void MulticastFeedPublisher::sendPacketLocked() {
+    if (packet_messages_ == 0) return;
+    FeedPacketHeader header{};
+    header.session = session_;
+    header.sequence = sequence_ - packet_messages_ + 1;
+    header.count = static_cast<uint16_t>(packet_messages_);
+    header.message_bytes = sizeof(FeedMessage);
+    std::memcpy(packet_.data(), &header, sizeof(header));
+
+    boost::system::error_code ec;
+    socket_.send_to(asio::buffer(packet_.data(), sizeof(FeedPacketHeader) + packet_messages_ * sizeof(FeedMessage)),
+                    group_endpoint_, 0, ec);
+    if (ec) {
+        // The sequence still advances: receivers see the gap and fetch a snapshot
+        send_errors_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        packets_sent_.fetch_add(1, std::memory_order_relaxed);
+    }
+    packet_messages_ = 0;
+}
+
+void MulticastFeedPublisher::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sendPacketLocked();
+}
+
+uint64_t MulticastFeedPublisher::lastSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sequence_;
+}
+
+void MulticastFeedPublisher::flushLoop() {
+    auto window = std::chrono::microseconds(options_.flush_interval_us);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        flush_cv_.wait(lock, [this] { return stopping_ || packet_messages_ > 0; });
+        if (stopping_) break;
+        // Let the packet fill for one window; a full packet is sent by its writer
+        flush_cv_.wait_for(lock, window, [this] { return stopping_; });
+        sendPacketLocked();
+    }
+    sendPacketLocked();
+}
+
+void MulticastFeedPublisher::applyLevelLocked(const BookUpdate& update) {
+    bool is_bid = update.side == Side::Buy;
+    auto& levels = is_bid ? bid_levels_ : ask_levels_;
+    auto it = is_bid
+        ? std::lower_bound(levels.begin(), levels.end(), update.price,
+                           [](const MarketDepth::Level& l, Price p) { return l.price > p; })
+        : std::lower_bound(levels.begin(), levels.end(), update.price,
+                           [](const MarketDepth::Level& l, Price p) { return l.price < p; });
+    bool found = it != levels.end() && it->price == update.price;
+    levels_timestamp_ = update.timestamp;
+
+    // Updates carry the level's total, so the type only matters for an emptied level
+    if (update.quantity == 0 || update.order_count == 0) {
+        if (found) levels.erase(it);
+    } else if (found) {
+        it->quantity = update.quantity;
+        it->order_count = update.order_count;
+    } else {
+        levels.insert(it, MarketDepth::Level{update.price, update.quantity, update.order_count});
+    }
+}
+
+void MulticastFeedPublisher::publishTrade(const Trade& trade) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        appendLocked(makeMarketDataRecord(trade));
+    }
+    if (next_) next_->publishTrade(trade);
+}
+
+void MulticastFeedPublisher::publishBookUpdate(const BookUpdate& update) {
+    {
+        // Level and sequence move together, so a snapshot never splits a message
+        std::lock_guard<std::mutex> lock(mutex_);
+        applyLevelLocked(update);
+        appendLocked(makeMarketDataRecord(update, options_.symbol_id));
+    }
+    if (next_) next_->publishBookUpdate(update);
+}
+
+void MulticastFeedPublisher::publishBestPrices(const BestPrices& prices) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        appendLocked(makeMarketDataRecord(prices, options_.symbol_id));
+    }
+    if (next_) next_->publishBestPrices(prices);
+}
+
+void MulticastFeedPublisher::publishDepth(const MarketDepth& depth) {
+    // Only the book's top levels: the snapshot is kept from book updates instead
+    if (next_) next_->publishDepth(depth);
+}
+
+void MulticastFeedPublisher::subscribe(std::function<void(const std::string&)> callback) {
+    if (next_) next_->subscribe(std::move(callback));
+}
+
+FeedSnapshot MulticastFeedPublisher::snapshot() const {
+    FeedSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot.header.session = session_;
+    snapshot.header.sequence = sequence_;
+    snapshot.header.timestamp = levels_timestamp_;
+    snapshot.header.symbol_id = options_.symbol_id;
+    snapshot.header.bid_count = static_cast<uint16_t>(std::min<size_t>(bid_levels_.size(), UINT16_MAX));
+    snapshot.header.ask_count = static_cast<uint16_t>(std::min<size_t>(ask_levels_.size(), UINT16_MAX));
+    snapshot.depth.bids.assign(bid_levels_.begin(), bid_levels_.begin() + snapshot.header.bid_count);
+    snapshot.depth.asks.assign(ask_levels_.begin(), ask_levels_.begin() + snapshot.header.ask_count);
+    snapshot.depth.timestamp = levels_timestamp_;
+    return snapshot;
+}
+
+std::vector<unsigned char> MulticastFeedPublisher::encodeSnapshot() {
+    // Copy under the lock, encode outside it
+    FeedSnapshot image = snapshot();
+    const FeedSnapshotHeader& header = image.header;
+    std::vector<unsigned char> bytes(sizeof(FeedSnapshotHeader) +
+                                     (size_t(header.bid_count) + header.ask_count) * sizeof(FeedSnapshotLevel));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    unsigned char* out = bytes.data() + sizeof(header);
+    auto put = [&out](const MarketDepth::Level& level) {
+        FeedSnapshotLevel encoded{level.price, level.quantity, level.order_count};
+        std::memcpy(out, &encoded, sizeof(encoded));
+        out += sizeof(encoded);
+    };
+    std::for_each(image.depth.bids.begin(), image.depth.bids.end(), put);
+    std::for_each(image.depth.asks.begin(), image.depth.asks.end(), put);
+    return bytes;
+}
+
+void MulticastFeedPublisher::acceptSnapshot() {
+    snapshot_acceptor_.async_accept([this](boost::system::error_code ec, tcp::socket socket) {
+        if (ec == asio::error::operation_aborted || !snapshot_acceptor_.is_open()) return;
+        if (!ec) {
+            auto client = std::make_shared<tcp::socket>(std::move(socket));
+            auto bytes = std::make_shared<std::vector<unsigned char>>(encodeSnapshot());
+            asio::async_write(*client, asio::buffer(*bytes), [client, bytes](boost::system::error_code, size_t) {
+                boost::system::error_code ignored;
+                client->shutdown(tcp::socket::shutdown_both, ignored);
+            });
+        }
+        acceptSnapshot();
+    });
+}
+
+bool parseFeedPacket(const void* data, size_t length, FeedPacketHeader& header,
+                     std::vector<FeedMessage>& messages) {
+    messages.clear();
+    if (length < sizeof(FeedPacketHeader)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.message_bytes != sizeof(FeedMessage) ||
+        length < sizeof(FeedPacketHeader) + size_t(header.count) * sizeof(FeedMessage)) {
+        return false;
+    }
+    messages.resize(header.count);
+    std::memcpy(messages.data(), static_cast<const unsigned char*>(data) + sizeof(FeedPacketHeader),
+                size_t(header.count) * sizeof(FeedMessage));
+    return true;
+}
+
+Result<FeedSnapshot> fetchFeedSnapshot(const std::string& host, uint16_t port) {
+    asio::io_context io;
+    tcp::socket socket(io);
+    boost::system::error_code ec;
+    tcp::resolver resolver(io);
+    auto endpoints = resolver.resolve(host, std::to_string(port), ec);
+    if (!ec) asio::connect(socket, endpoints, ec);
+    if (ec) {
+        return Result<FeedSnapshot>::error("Cannot connect to snapshot channel " + host + ":" +
+                                           std::to_string(port) + ": " + ec.message());
+    }
+
+    std::vector<unsigned char> bytes;
+    asio::read(socket, asio::dynamic_buffer(bytes), ec);
+    if (ec && ec != asio::error::eof) {
+        return Result<FeedSnapshot>::error("Snapshot read failed: " + ec.message());
+    }
+
+    FeedSnapshot snapshot;
+    if (bytes.size() < sizeof(FeedSnapshotHeader)) {
+        return Result<FeedSnapshot>::error("Snapshot reply is truncated");
+    }
+    std::memcpy(&snapshot.header, bytes.data(), sizeof(snapshot.header));
+    size_t levels = size_t(snapshot.header.bid_count) + snapshot.header.ask_count;
+    if (bytes.size() < sizeof(FeedSnapshotHeader) + levels * sizeof(FeedSnapshotLevel)) {
+        return Result<FeedSnapshot>::error("Snapshot reply is truncated");
+    }
+    const unsigned char* in = bytes.data() + sizeof(FeedSnapshotHeader);
+    for (size_t i = 0; i < levels; ++i, in += sizeof(FeedSnapshotLevel)) {
+        FeedSnapshotLevel level;
+        std::memcpy(&level, in, sizeof(level));
+        auto& side = i < snapshot.header.bid_count ? snapshot.depth.bids : snapshot.depth.asks;
+        side.push_back({level.price, level.quantity, static_cast<size_t>(level.order_count)});
+    }
+    snapshot.depth.timestamp = snapshot.header.timestamp;
+    return Result<FeedSnapshot>::success(std::move(snapshot));
+}
+
+}
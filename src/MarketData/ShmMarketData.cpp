@@ -0,0 +1,231 @@
+#include "orderbook/MarketData/ShmMarketData.hpp"
+#include "orderbook/Core/InternTable.hpp"
+#include "orderbook/Core/MarketData.hpp"
+#include "orderbook/Core/Order.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace orderbook {
+
+namespace {
+
+size_t roundUpPowerOfTwo(size_t n) {
+    size_t capacity = 1;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+}
+
+size_t ringBytes(size_t capacity) {
+    return sizeof(ShmRingHeader) + capacity * sizeof(ShmRingSlot);
+}
+
+}
+
+ShmMarketDataRecord makeMarketDataRecord(const Trade& trade) {
+    ShmMarketDataRecord record{};
+    record.type = ShmMarketDataRecord::Type::Trade;
+    record.symbol_id = trade.symbol_id;
+    record.timestamp = trade.timestamp;
+    record.trade.trade_id = trade.id.value;
+    record.trade.buy_order_id = trade.buy_order_id.value;
+    record.trade.sell_order_id = trade.sell_order_id.value;
+    record.trade.price = trade.price;
+    record.trade.quantity = trade.quantity;
+    return record;
+}
+
+ShmMarketDataRecord makeMarketDataRecord(const BookUpdate& update, SymbolId symbol_id) {
+    ShmMarketDataRecord record{};
+    record.type = ShmMarketDataRecord::Type::BookUpdate;
+    record.side = static_cast<uint8_t>(update.side);
+    record.update_type = static_cast<uint8_t>(update.type);
+    record.symbol_id = symbol_id;
+    record.timestamp = update.timestamp;
+    record.level.price = update.price;
+    record.level.quantity = update.quantity;
+    record.level.order_count = update.order_count;
+    record.level.book_sequence = update.sequence;
+    return record;
+}
+
+ShmMarketDataRecord makeMarketDataRecord(const BestPrices& prices, SymbolId symbol_id) {
+    ShmMarketDataRecord record{};
+    record.type = ShmMarketDataRecord::Type::BestPrices;
+    record.symbol_id = symbol_id;
+    record.timestamp = prices.timestamp;
+    if (prices.bid) {
+        record.flags |= ShmMarketDataRecord::HasBid;
+        record.best.bid = *prices.bid;
+        record.best.bid_size = prices.bid_size.value_or(0);
+    }
+    if (prices.ask) {
+        record.flags |= ShmMarketDataRecord::HasAsk;
+        record.best.ask = *prices.ask;
+        record.best.ask_size = prices.ask_size.value_or(0);
+    }
+    return record;
+}
+
+Result<std::unique_ptr<ShmMarketDataPublisher>> ShmMarketDataPublisher::create(const ShmMarketDataOptions& options,
+                                                                               MarketDataPublisherPtr next) {
+    using PublisherResult = Result<std::unique_ptr<ShmMarketDataPublisher>>;
+    if (options.name.empty()) {
+        return PublisherResult::error("Shared memory name not set");
+    }
+    std::unique_ptr<ShmMarketDataPublisher> publisher(new ShmMarketDataPublisher(options, std::move(next)));
+    size_t capacity = roundUpPowerOfTwo(std::max<size_t>(options.capacity, 2));
+
+    // A fresh object per run: never resize a ring another process still maps
+    ::shm_unlink(options.name.c_str());
+    int fd = ::shm_open(options.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        return PublisherResult::error("Cannot create shared memory " + options.name + ": " + std::strerror(errno));
+    }
+    size_t size = ringBytes(capacity);
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        int err = errno;
+        ::close(fd);
+        ::shm_unlink(options.name.c_str());
+        return PublisherResult::error("Cannot size shared memory " + options.name + ": " + std::strerror(err));
+    }
+    void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        ::shm_unlink(options.name.c_str());
+        return PublisherResult::error("Cannot map shared memory " + options.name + ": " + std::strerror(errno));
+    }
+
+    // The object is zero-filled, which is every atomic's initial state
+    publisher->data_ = p;
+    publisher->size_ = size;
+    publisher->header_ = new (p) ShmRingHeader;
+    publisher->slots_ = reinterpret_cast<ShmRingSlot*>(static_cast<unsigned char*>(p) + sizeof(ShmRingHeader));
+    publisher->mask_ = capacity - 1;
+
+    ShmRingHeader* header = publisher->header_;
+    std::memcpy(header->magic, ShmRingHeader::Magic, sizeof(header->magic));
+    header->slot_bytes = sizeof(ShmRingSlot);
+    header->capacity = capacity;
+    publisher->nameSymbol(options.symbol_id);
+    header->version.store(ShmRingHeader::FormatVersion, std::memory_order_release);
+    return PublisherResult::success(std::move(publisher));
+}
+
+ShmMarketDataPublisher::~ShmMarketDataPublisher() {
+    if (data_) {
+        ::munmap(data_, size_);
+        ::shm_unlink(options_.name.c_str());
+    }
+}
+
+void ShmMarketDataPublisher::write(const ShmMarketDataRecord& record) {
+    uint64_t sequence = header_->claimed.fetch_add(1, std::memory_order_relaxed) + 1;
+    ShmRingSlot& slot = slots_[sequence & mask_];
+    uint64_t words[ShmRingSlot::Words];
+    std::memcpy(words, &record, sizeof(record));
+
+    // Sequence lock: mark the slot, write the words, then publish the new sequence
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < ShmRingSlot::Words; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(sequence, std::memory_order_release);
+}
+
+void ShmMarketDataPublisher::nameSymbol(SymbolId symbol_id) {
+    if (symbol_id == 0 || symbol_id >= ShmRingHeader::SymbolCapacity) return;
+    ShmSymbolEntry& entry = header_->symbols[symbol_id];
+    if (entry.state.load(std::memory_order_acquire) != 0) return;
+    uint32_t unnamed = 0;
+    if (!entry.state.compare_exchange_strong(unnamed, 1, std::memory_order_acquire)) return;
+    const char* name = symbolTable().name(symbol_id);
+    std::strncpy(entry.name, name ? name : "", sizeof(entry.name) - 1);
+    entry.state.store(2, std::memory_order_release);
+}
+
+void ShmMarketDataPublisher::publishTrade(const Trade& trade) {
+    nameSymbol(trade.symbol_id);
+    write(makeMarketDataRecord(trade));
+    if (next_) next_->publishTrade(trade);
+}
+
+void ShmMarketDataPublisher::publishBookUpdate(const BookUpdate& update) {
+    write(makeMarketDataRecord(update, options_.symbol_id));
+    if (next_) next_->publishBookUpdate(update);
+}
+
+void ShmMarketDataPublisher::publishBestPrices(const BestPrices& prices) {
+    write(makeMarketDataRecord(prices, options_.symbol_id));
+    if (next_) next_->publishBestPrices(prices);
+}
+
+void ShmMarketDataPublisher::publishDepth(const MarketDepth& depth) {
+    // Depth is rebuilt from BookUpdate records on the ring side
+    if (next_) next_->publishDepth(depth);
+}
+
+void ShmMarketDataPublisher::subscribe(std::function<void(const std::string&)> callback) {
+    // String subscribers belong to the in-process publisher
+    if (next_) next_->subscribe(std::move(callback));
+}
+
+Result<std::unique_ptr<ShmMarketDataReader>> ShmMarketDataReader::open(const std::string& name) {
+    using ReaderResult = Result<std::unique_ptr<ShmMarketDataReader>>;
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return ReaderResult::error("Cannot open shared memory " + name + ": " + std::strerror(errno));
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader)) {
+        ::close(fd);
+        return ReaderResult::error("Shared memory " + name + " is not a market data ring");
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return ReaderResult::error("Cannot map shared memory " + name + ": " + std::strerror(errno));
+    }
+
+    std::unique_ptr<ShmMarketDataReader> reader(new ShmMarketDataReader());
+    reader->data_ = p;
+    reader->size_ = size;
+    const auto* header = static_cast<const ShmRingHeader*>(p);
+    if (header->version.load(std::memory_order_acquire) != ShmRingHeader::FormatVersion ||
+        std::memcmp(header->magic, ShmRingHeader::Magic, sizeof(header->magic)) != 0 ||
+        header->slot_bytes != sizeof(ShmRingSlot) ||
+        size < ringBytes(header->capacity)) {
+        return ReaderResult::error("Shared memory " + name + " is not a compatible market data ring");
+    }
+    reader->header_ = header;
+    reader->slots_ = reinterpret_cast<const ShmRingSlot*>(static_cast<const unsigned char*>(p) + sizeof(ShmRingHeader));
+    reader->mask_ = header->capacity - 1;
+    reader->next_ = header->claimed.load(std::memory_order_acquire) + 1;
+    return ReaderResult::success(std::move(reader));
+}
+
+ShmMarketDataReader::~ShmMarketDataReader() {
+    if (data_) ::munmap(data_, size_);
+}
+
+ShmMarketDataReader::Status ShmMarketDataReader::overrun() {
+    uint64_t live = header_->claimed.load(std::memory_order_acquire) + 1;
+    lost_ += live - next_;
+    next_ = live;
+    return Status::Overrun;
+}
+
+std::string ShmMarketDataReader::symbol(uint32_t symbol_id) const {
+    if (symbol_id >= ShmRingHeader::SymbolCapacity) return std::string();
+    const ShmSymbolEntry& entry = header_->symbols[symbol_id];
+    if (entry.state.load(std::memory_order_acquire) != 2) return std::string();
+    return std::string(entry.name, strnlen(entry.name, sizeof(entry.name)));
+}
+
+}
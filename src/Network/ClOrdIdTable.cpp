@@ -0,0 +1,108 @@
+#include "orderbook/Network/ClOrdIdTable.hpp"
+#include <algorithm>
+
+namespace orderbook {
+
+bool ClOrdIdTable::bind(std::string_view clOrdId, OrderId id) {
+    auto key = ClOrdIdKey::from(clOrdId);
+    if (!key || (id.value >> SequenceBits) != session_) return false;
+    uint64_t sequence = id.value & SequenceMask;
+    if (sequence < base_ || sequence > sequence_) return false;
+    if (forward_.find(*key) != forward_.end()) return false;
+
+    makeRoom(sequence);
+    if (sequence - base_ >= by_sequence_.size()) by_sequence_.resize(sequence - base_ + 1);
+    ClOrdIdKey& entry = by_sequence_[sequence - base_];
+    if (!entry.empty()) forward_.erase(entry);
+    entry = *key;
+    forward_[*key] = id;
+    trim();
+    return true;
+}
+
+bool ClOrdIdTable::rebind(OrderId id, std::string_view clOrdId) {
+    ClOrdIdKey* entry = entryFor(id);
+    auto key = ClOrdIdKey::from(clOrdId);
+    if (!entry || !key) return false;
+    if (*entry == *key) return true;
+    if (forward_.find(*key) != forward_.end()) return false;
+    forward_.erase(*entry);
+    *entry = *key;
+    forward_[*key] = id;
+    return true;
+}
+
+void ClOrdIdTable::unbind(OrderId id) {
+    size_t i = indexOf(id);
+    if (i == NoIndex) {
+        auto it = stragglers_.empty() ? stragglers_.end() : stragglers_.find(id);
+        if (it == stragglers_.end()) return;
+        forward_.erase(it->second);
+        stragglers_.erase(it);
+        return;
+    }
+    if (by_sequence_[i].empty()) return;
+    forward_.erase(by_sequence_[i]);
+    by_sequence_[i] = ClOrdIdKey();
+    trim();
+}
+
+std::optional<OrderId> ClOrdIdTable::find(std::string_view clOrdId) const {
+    auto key = ClOrdIdKey::from(clOrdId);
+    if (!key) return std::nullopt;
+    auto it = forward_.find(*key);
+    if (it == forward_.end()) return std::nullopt;
+    return it->second;
+}
+
+std::vector<OrderId> ClOrdIdTable::liveOrders() const {
+    std::vector<OrderId> ids;
+    ids.reserve(forward_.size());
+    // Stragglers all precede the window
+    for (const auto& entry : stragglers_) ids.push_back(entry.first);
+    std::sort(ids.begin(), ids.end());
+    for (size_t i = 0; i < by_sequence_.size(); ++i) {
+        if (!by_sequence_[i].empty()) {
+            ids.push_back(OrderId((uint64_t(session_) << SequenceBits) | (base_ + i)));
+        }
+    }
+    return ids;
+}
+
+void ClOrdIdTable::clear() {
+    forward_.clear();
+    by_sequence_.clear();
+    stragglers_.clear();
+    base_ = sequence_ + 1;
+}
+
+ClOrdIdKey* ClOrdIdTable::entryFor(OrderId id) {
+    size_t i = indexOf(id);
+    if (i != NoIndex) return !by_sequence_[i].empty() ? &by_sequence_[i] : nullptr;
+    if (stragglers_.empty()) return nullptr;
+    auto it = stragglers_.find(id);
+    return it != stragglers_.end() ? &it->second : nullptr;
+}
+
+void ClOrdIdTable::makeRoom(uint64_t sequence) {
+    if (sequence - base_ < MaxWindow) return;
+    uint64_t new_base = sequence - MaxWindow + 1;
+    while (base_ < new_base && !by_sequence_.empty()) {
+        if (!by_sequence_.front().empty()) {
+            stragglers_[OrderId((uint64_t(session_) << SequenceBits) | base_)] = by_sequence_.front();
+        }
+        by_sequence_.pop_front();
+        ++base_;
+    }
+    base_ = std::max(base_, new_base);
+    trim();
+}
+
+void ClOrdIdTable::trim() {
+    while (!by_sequence_.empty() && by_sequence_.front().empty()) {
+        by_sequence_.pop_front();
+        ++base_;
+    }
+}
+
+}
@@ -0,0 +1,149 @@
+#include "orderbook/Network/FixEncoder.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include <charconv>
+#include <cstring>
+#include <ctime>
+
+namespace orderbook {
+
+using namespace fix;
+
+namespace {
+
+/**
+ * @brief Bounded append cursor over a char buffer
+ */
+struct FieldWriter {
+    char* p;
+    char* end;
+
+    void raw(std::string_view text) {
+        size_t n = std::min(text.size(), static_cast<size_t>(end - p));
+        std::memcpy(p, text.data(), n);
+        p += n;
+    }
+    void tag(int tag) {
+        p = std::to_chars(p, end, tag).ptr;
+        if (p < end) *p++ = '=';
+    }
+    void soh() {
+        if (p < end) *p++ = FIELD_DELIMITER;
+    }
+    void field(int t, std::string_view value) { tag(t); raw(value); soh(); }
+    void field(int t, char value) { tag(t); if (p < end) *p++ = value; soh(); }
+    void field(int t, uint64_t value) { tag(t); p = std::to_chars(p, end, value).ptr; soh(); }
+    void price(int t, double value) {
+        tag(t);
+        p = std::to_chars(p, end, value, std::chars_format::fixed, 2).ptr;
+        soh();
+    }
+};
+
+constexpr std::string_view BeginStringField = "8=FIX.4.4\x01" "9=";
+
+}
+
+FixEncoder::FixEncoder(std::string_view senderCompId, std::string_view targetCompId) {
+    setSessionIds(senderCompId, targetCompId);
+}
+
+void FixEncoder::setSessionIds(std::string_view senderCompId, std::string_view targetCompId) {
+    session_header_.clear();
+    session_header_.append("49=").append(senderCompId).push_back(FIELD_DELIMITER);
+    session_header_.append("56=").append(targetCompId).push_back(FIELD_DELIMITER);
+}
+
+std::string_view FixEncoder::timestamp(std::chrono::system_clock::time_point time) {
+    thread_local char text[21] = {};
+    thread_local int64_t cached_second = -1;
+    thread_local int64_t cached_ms = -1;
+
+    int64_t ms_since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(
+        time.time_since_epoch()).count();
+    if (ms_since_epoch != cached_ms) {
+        int64_t second = ms_since_epoch / 1000;
+        if (second != cached_second) {
+            // Date and time of day only change once a second
+            std::time_t t = static_cast<std::time_t>(second);
+            std::tm tm{};
+            gmtime_r(&t, &tm);
+            std::strftime(text, sizeof(text), "%Y%m%d-%H:%M:%S", &tm);
+            text[17] = '.';
+            cached_second = second;
+        }
+        int ms = static_cast<int>(ms_since_epoch % 1000);
+        text[18] = static_cast<char>('0' + ms / 100);
+        text[19] = static_cast<char>('0' + ms / 10 % 10);
+        text[20] = static_cast<char>('0' + ms % 10);
+        cached_ms = ms_since_epoch;
+    }
+    return std::string_view(text, sizeof(text));
+}
+
+size_t FixEncoder::beginMessage(char* buffer, char msgType, SequenceNumber msgSeqNum) const {
+    FieldWriter w{buffer + PrefixReserve, buffer + PrefixReserve + MaxBodySize};
+    w.field(TAG_MSG_TYPE, msgType);
+    w.raw(session_header_);
+    w.field(TAG_MSG_SEQ_NUM, static_cast<uint64_t>(msgSeqNum));
+    w.field(TAG_SENDING_TIME, timestamp(std::chrono::system_clock::now()));
+    return static_cast<size_t>(w.p - buffer);
+}
+
+void FixEncoder::finishMessage(char* buffer, size_t body_end, std::string& out) const {
+    // Render "8=FIX.4.4<SOH>9=<len><SOH>" right-aligned against the body
+    size_t body_length = body_end - PrefixReserve;
+    char length_text[16];
+    char* length_end = std::to_chars(length_text, length_text + sizeof(length_text), body_length).ptr;
+    size_t length_size = static_cast<size_t>(length_end - length_text);
+    size_t start = PrefixReserve - BeginStringField.size() - length_size - 1;
+    std::memcpy(buffer + start, BeginStringField.data(), BeginStringField.size());
+    std::memcpy(buffer + start + BeginStringField.size(), length_text, length_size);
+    buffer[PrefixReserve - 1] = FIELD_DELIMITER;
+
+    uint32_t sum = 0;
+    for (size_t i = start; i < body_end; ++i) sum += static_cast<uint8_t>(buffer[i]);
+    uint8_t checksum = static_cast<uint8_t>(sum % 256);
+    char* trailer = buffer + body_end;
+    std::memcpy(trailer, "10=", 3);
+    trailer[3] = static_cast<char>('0' + checksum / 100);
+    trailer[4] = static_cast<char>('0' + checksum / 10 % 10);
+    trailer[5] = static_cast<char>('0' + checksum % 10);
+    trailer[6] = FIELD_DELIMITER;
+
+    out.assign(buffer + start, body_end + 7 - start);
+}
+
+bool FixEncoder::encodeExecutionReport(std::string& out, const FixMessageParser::ExecutionReport& report,
+                                       SequenceNumber msgSeqNum) const {
+    char buffer[PrefixReserve + MaxBodySize + 8];
+    size_t header_end = beginMessage(buffer, MSG_TYPE_EXECUTION_REPORT, msgSeqNum);
+    FieldWriter w{buffer + header_end, buffer + PrefixReserve + MaxBodySize};
+
+    w.field(TAG_ORDER_ID, report.orderId);
+    w.field(TAG_CLORD_ID, report.clOrdId);
+    w.field(TAG_EXEC_ID, report.execId);
+    w.field(TAG_EXEC_TYPE, report.execType);
+    w.field(TAG_ORD_STATUS, report.ordStatus);
+    w.field(TAG_SYMBOL, report.symbol);
+    w.field(TAG_SIDE, report.side == Side::Buy ? SIDE_BUY : SIDE_SELL);
+    w.field(TAG_ORDER_QTY, static_cast<uint64_t>(report.orderQty));
+    w.price(TAG_PRICE, report.price);
+    w.field(TAG_LEAVES_QTY, static_cast<uint64_t>(report.leavesQty));
+    w.field(TAG_CUM_QTY, static_cast<uint64_t>(report.cumQty));
+    w.price(TAG_AVG_PX, report.avgPx);
+    w.field(TAG_TRANSACT_TIME, timestamp(report.transactTime));
+
+    // Optional fields for fills
+    if (report.lastQty > 0) {
+        w.field(TAG_LAST_QTY, static_cast<uint64_t>(report.lastQty));
+        w.price(TAG_LAST_PX, report.lastPx);
+    }
+
+    if (w.p >= w.end) {
+        return false;  // ran out of room; the writer clips rather than overruns
+    }
+    finishMessage(buffer, static_cast<size_t>(w.p - buffer), out);
+    return true;
+}
+
+}
@@ -0,0 +1,113 @@
+#include "orderbook/Network/FixFramer.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include <charconv>
+#include <algorithm>
+#include <cstring>
+
+namespace orderbook {
+
+using namespace fix;
+
+FixFramer::FixFramer(size_t capacity) : buffer_(capacity) {}
+
+std::pair<char*, size_t> FixFramer::prepare(size_t min_bytes) {
+    if (buffer_.size() - end_ < min_bytes) {
+        // Slide the unconsumed tail (normally one partial message) to the front
+        size_t pending = end_ - begin_;
+        if (begin_ > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + begin_, pending);
+            begin_ = 0;
+            end_ = pending;
+        }
+        if (buffer_.size() - end_ < min_bytes) {
+            buffer_.resize(end_ + min_bytes);
+        }
+    }
+    return {buffer_.data() + end_, buffer_.size() - end_};
+}
+
+FixFramer::Status FixFramer::next(std::string_view& message, std::string& error) {
+    const char* start = buffer_.data() + begin_;
+    size_t available = end_ - begin_;
+    if (available == 0) {
+        begin_ = end_ = 0;
+        return Status::Incomplete;
+    }
+
+    // 8=FIX.x.y<SOH>
+    if (available < 2) return Status::Incomplete;
+    if (start[0] != '8' || start[1] != '=') {
+        error = "Message does not start with BeginString";
+        resync();
+        return Status::Malformed;
+    }
+    const char* begin_end = static_cast<const char*>(std::memchr(start, FIELD_DELIMITER, available));
+    if (!begin_end) {
+        if (available <= 32) return Status::Incomplete;
+        error = "BeginString too long";
+        resync();
+        return Status::Malformed;
+    }
+
+    // 9=<length><SOH>
+    const char* length_field = begin_end + 1;
+    size_t rest = available - static_cast<size_t>(length_field - start);
+    if (rest < 2) return Status::Incomplete;
+    if (length_field[0] != '9' || length_field[1] != '=') {
+        error = "BodyLength must follow BeginString";
+        resync();
+        return Status::Malformed;
+    }
+    const char* length_end = static_cast<const char*>(std::memchr(length_field, FIELD_DELIMITER, rest));
+    if (!length_end) {
+        if (rest <= 32) return Status::Incomplete;
+        error = "BodyLength too long";
+        resync();
+        return Status::Malformed;
+    }
+    size_t body_length = 0;
+    auto [parsed_end, ec] = std::from_chars(length_field + 2, length_end, body_length);
+    if (ec != std::errc() || parsed_end != length_end || body_length > MaxMessageSize) {
+        error = "Invalid BodyLength";
+        resync();
+        return Status::Malformed;
+    }
+
+    // Body, then the 10=nnn<SOH> trailer
+    constexpr size_t TrailerSize = 7;
+    size_t header_size = static_cast<size_t>(length_end + 1 - start);
+    size_t total = header_size + body_length + TrailerSize;
+    if (available < total) return Status::Incomplete;
+    const char* trailer = start + header_size + body_length;
+    if (trailer[0] != '1' || trailer[1] != '0' || trailer[2] != '=' || trailer[6] != FIELD_DELIMITER) {
+        error = "CheckSum not found at BodyLength";
+        resync();
+        return Status::Malformed;
+    }
+
+    message = std::string_view(start, total);
+    begin_ += total;
+    return Status::Message;
+}
+
+void FixFramer::resync() {
+    // Skip the current message start and look for the next BeginString
+    static constexpr std::string_view Marker = "8=FIX";
+    std::string_view pending(buffer_.data() + begin_ + 1, end_ - begin_ - 1);
+    size_t found = pending.find(Marker);
+    if (found != std::string_view::npos) {
+        begin_ += 1 + found;
+        return;
+    }
+    // Keep a tail that may be the start of a BeginString still arriving
+    size_t keep = 0;
+    for (size_t n = std::min(pending.size(), Marker.size() - 1); n > 0; --n) {
+        if (pending.substr(pending.size() - n) == Marker.substr(0, n)) {
+            keep = n;
+            break;
+        }
+    }
+    begin_ = end_ - keep;
+}
+
+}
@@ -1,58 +1,38 @@
 #include "orderbook/Network/FixMessageHandler.hpp"
 #include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Utilities/LatencyTracer.hpp"
 #include <sstream>
 #include <iomanip>
-#include <mutex>
+#include <atomic>
 #include <optional>
 
 namespace orderbook {
 
 using namespace fix;
 
-FixMessageHandler::FixMessageHandler(std::shared_ptr<OrderManager> orderManager,
-                                   std::shared_ptr<RiskManager> riskManager)
-    : orderManager_(std::move(orderManager)), riskManager_(std::move(riskManager)) {
-}
+namespace {
 
-// Mapping helpers - thread-safe
-void FixMessageHandler::addClOrdIdMapping(const std::string& clOrdId, OrderId orderId) {
-    std::lock_guard<std::mutex> lock(mapping_mutex_);
-    clOrdIdToOrderId_[clOrdId] = orderId;
-    orderIdToClOrdId_[orderId] = clOrdId;
+// Reportable copy of an order a book-backed OrderManager may drop as soon as it
+// cancels or fully trades
+Order reportCopy(const Order& order) {
+    Order copy(order.id.value, order.side, order.type, order.tif, order.price, order.quantity,
+               order.symbol_id, order.account_id);
+    copy.filled_quantity = order.filled_quantity;
+    copy.status = order.status;
+    copy.timestamp = order.timestamp;
+    return copy;
 }
 
-void FixMessageHandler::removeClOrdIdMapping(const std::string& clOrdId) {
-    std::lock_guard<std::mutex> lock(mapping_mutex_);
-    auto it = clOrdIdToOrderId_.find(clOrdId);
-    if (it != clOrdIdToOrderId_.end()) {
-        OrderId oid = it->second;
-        clOrdIdToOrderId_.erase(it);
-        orderIdToClOrdId_.erase(oid);
-    }
-}
+// Session index for each handler's OrderId range; 0 is left unused
+std::atomic<uint32_t> nextSessionIndex{1};
 
-void FixMessageHandler::removeOrderIdMapping(OrderId orderId) {
-    std::lock_guard<std::mutex> lock(mapping_mutex_);
-    auto it = orderIdToClOrdId_.find(orderId);
-    if (it != orderIdToClOrdId_.end()) {
-        std::string clOrd = it->second;
-        orderIdToClOrdId_.erase(it);
-        clOrdIdToOrderId_.erase(clOrd);
-    }
 }
 
-std::optional<OrderId> FixMessageHandler::getOrderIdForClOrdId(const std::string& clOrdId) {
-    std::lock_guard<std::mutex> lock(mapping_mutex_);
-    auto it = clOrdIdToOrderId_.find(clOrdId);
-    if (it != clOrdIdToOrderId_.end()) return it->second;
-    return std::nullopt;
-}
-
-std::optional<std::string> FixMessageHandler::getClOrdIdForOrderId(OrderId orderId) {
-    std::lock_guard<std::mutex> lock(mapping_mutex_);
-    auto it = orderIdToClOrdId_.find(orderId);
-    if (it != orderIdToClOrdId_.end()) return it->second;
-    return std::nullopt;
+FixMessageHandler::FixMessageHandler(std::shared_ptr<OrderManager> orderManager,
+                                   std::shared_ptr<RiskManager> riskManager,
+                                   PriceScale priceScale)
+    : orderManager_(std::move(orderManager)), riskManager_(std::move(riskManager)),
+      priceScale_(priceScale), clOrdIds_(nextSessionIndex.fetch_add(1, std::memory_order_relaxed)) {
 }
 
 void FixMessageHandler::setFixSession(std::shared_ptr<FixSession> session) {
@@ -61,6 +41,8 @@ void FixMessageHandler::setFixSession(std::shared_ptr<FixSession> session) {
 
 void FixMessageHandler::handleNewOrderSingle(const FixMessageParser::NewOrderSingle& newOrder) {
     ++ordersProcessed_;
+    TraceStamps trace = newOrder.trace;
+    trace.stamp(TraceStage::FixHandler);
     
     if (!newOrder.isValid) {
         sendRejectionReport(newOrder.clOrdId, newOrder.symbol, newOrder.side, 
@@ -69,6 +51,28 @@ void FixMessageHandler::handleNewOrderSingle(const FixMessageParser::NewOrderSin
         return;
     }
     
+    // ClOrdID must fit the inline key and not already name a live order on this session
+    if (newOrder.clOrdId.size() > ClOrdIdKey::MaxLength) {
+        sendRejectionReport(newOrder.clOrdId, newOrder.symbol, newOrder.side,
+                          "ClOrdID too long: " + newOrder.clOrdId);
+        ++ordersRejected_;
+        return;
+    }
+    if (clOrdIds_.find(newOrder.clOrdId)) {
+        sendRejectionReport(newOrder.clOrdId, newOrder.symbol, newOrder.side,
+                          "Duplicate ClOrdID: " + newOrder.clOrdId);
+        ++ordersRejected_;
+        return;
+    }
+    
+    // Reject prices that do not fall on the instrument tick grid
+    if (newOrder.orderType == OrderType::Limit && !priceScale_.isOnTick(newOrder.price)) {
+        sendRejectionReport(newOrder.clOrdId, newOrder.symbol, newOrder.side, 
+                          "Price not on tick size: " + std::to_string(newOrder.price));
+        ++ordersRejected_;
+        return;
+    }
+    
     // Convert to internal order
     auto order = convertToInternalOrder(newOrder);
     if (!order) {
@@ -92,7 +96,9 @@ void FixMessageHandler::handleNewOrderSingle(const FixMessageParser::NewOrderSin
         }
     }
     
-    // Submit order to order manager
+    // Submit order to order manager; the order carries its stamps onward
+    order->trace = trace;
+    Order submitted = reportCopy(*order);
     auto result = orderManager_->addOrder(std::move(order));
     
     if (result.isError()) {
@@ -103,11 +109,19 @@ void FixMessageHandler::handleNewOrderSingle(const FixMessageParser::NewOrderSin
         ++ordersRejected_;
     } else {
         // Add client order ID mapping after successful add
-        addClOrdIdMapping(newOrder.clOrdId, result.value());
+        clOrdIds_.bind(newOrder.clOrdId, result.value());
         // Retrieve stored order and send acknowledgment (New execution report) with client ClOrdID
         Order* storedOrder = orderManager_->getOrder(result.value());
-        if (storedOrder) {
-            sendExecutionReport(*storedOrder, newOrder.clOrdId, EXEC_TYPE_NEW);
+        sendExecutionReport(storedOrder ? *storedOrder : submitted, newOrder.clOrdId, EXEC_TYPE_NEW);
+        // Acknowledged: the trace ends with the New report on the wire (a book records its own)
+        if (storedOrder && !orderManager_->isBookBacked()) {
+            storedOrder->trace.stampOnce(TraceStage::Published);
+            LatencyTracer::getInstance().record(storedOrder->trace);
+            storedOrder->trace.clear();
+        }
+        // A book-backed manager drops an order that traded out on arrival
+        if (!storedOrder) {
+            clOrdIds_.unbind(result.value());
         }
     }
 }
@@ -121,8 +135,8 @@ void FixMessageHandler::handleOrderCancelReplaceRequest(const FixMessageParser::
         return;
     }
     
-    // Find original order (thread-safe)
-    auto maybeOrderId = getOrderIdForClOrdId(cancelReplace.origClOrdId);
+    // Find original order
+    auto maybeOrderId = clOrdIds_.find(cancelReplace.origClOrdId);
     if (!maybeOrderId.has_value()) {
         sendRejectionReport(cancelReplace.clOrdId, cancelReplace.symbol, cancelReplace.side, 
                           "Original order not found: " + cancelReplace.origClOrdId);
@@ -132,17 +146,19 @@ void FixMessageHandler::handleOrderCancelReplaceRequest(const FixMessageParser::
     OrderId originalOrderId = maybeOrderId.value();
     
     // Modify the order
-    auto result = orderManager_->modifyOrder(originalOrderId, cancelReplace.price, cancelReplace.quantity);
+    auto result = orderManager_->modifyOrder(originalOrderId, priceScale_.toTicks(cancelReplace.price),
+                                             cancelReplace.quantity);
     
     if (result.isSuccess()) {
-        // Update client order ID mapping (thread-safe)
-        removeClOrdIdMapping(cancelReplace.origClOrdId);
-        addClOrdIdMapping(cancelReplace.clOrdId, originalOrderId);
+        // Update client order ID mapping
+        clOrdIds_.rebind(originalOrderId, cancelReplace.clOrdId);
         
         // Find the modified order and send execution report
         Order* modifiedOrder = findOrderByClOrdId(cancelReplace.clOrdId);
         if (modifiedOrder) {
             sendExecutionReport(*modifiedOrder, EXEC_TYPE_NEW); // Modified order treated as new
+        } else {
+            clOrdIds_.unbind(originalOrderId);  // Repriced into a full fill
         }
     } else {
         sendRejectionReport(cancelReplace.clOrdId, cancelReplace.symbol, cancelReplace.side, 
@@ -159,8 +175,8 @@ void FixMessageHandler::handleOrderCancelRequest(const FixMessageParser::OrderCa
         return;
     }
     
-    // Find original order (thread-safe)
-    auto maybeOrderId = getOrderIdForClOrdId(cancelRequest.origClOrdId);
+    // Find original order
+    auto maybeOrderId = clOrdIds_.find(cancelRequest.origClOrdId);
     if (!maybeOrderId.has_value()) {
         sendRejectionReport(cancelRequest.clOrdId, cancelRequest.symbol, cancelRequest.side, 
                           "Original order not found: " + cancelRequest.origClOrdId);
@@ -169,17 +185,25 @@ void FixMessageHandler::handleOrderCancelRequest(const FixMessageParser::OrderCa
     OrderId originalOrderId = maybeOrderId.value();
     
     // Cancel the order
+    Order* existing = orderManager_->getOrder(originalOrderId);
+    std::optional<Order> before;
+    if (existing) before.emplace(reportCopy(*existing));
     auto result = orderManager_->cancelOrder(originalOrderId);
     
     if (result.isSuccess()) {
-        // Update client order ID mapping for the cancel confirmation (thread-safe)
-        removeClOrdIdMapping(cancelRequest.origClOrdId);
-        addClOrdIdMapping(cancelRequest.clOrdId, originalOrderId);
+        // Update client order ID mapping for the cancel confirmation
+        clOrdIds_.rebind(originalOrderId, cancelRequest.clOrdId);
         
         // Find the cancelled order and send execution report
         Order* cancelledOrder = findOrderByClOrdId(cancelRequest.clOrdId);
+        if (!cancelledOrder && before) {
+            before->cancel();
+            cancelledOrder = &*before;
+        }
         if (cancelledOrder) {
             sendExecutionReport(*cancelledOrder, EXEC_TYPE_CANCELLED);
+        } else {
+            clOrdIds_.unbind(originalOrderId);
         }
     } else {
         sendRejectionReport(cancelRequest.clOrdId, cancelRequest.symbol, cancelRequest.side, 
@@ -187,6 +211,15 @@ void FixMessageHandler::handleOrderCancelRequest(const FixMessageParser::OrderCa
     }
 }
 
+size_t FixMessageHandler::cancelSessionOrders() {
+    // The session's live orders are exactly its bound ClOrdIDs; their accounts may be
+    // shared with other sessions, so this is no account-wide cancel
+    std::vector<OrderId> live = clOrdIds_.liveOrders();
+    size_t cancelled = orderManager_->cancelOrders(live.data(), live.size());
+    clOrdIds_.clear();
+    return cancelled;
+}
+
 void FixMessageHandler::handleTradeExecution(const Trade& trade) {
     ++tradesReported_;
     
@@ -194,16 +227,13 @@ void FixMessageHandler::handleTradeExecution(const Trade& trade) {
     Order* buyOrder = nullptr;
     Order* sellOrder = nullptr;
     
-    // Find orders by their IDs
-    auto maybeBuyClOrd = getClOrdIdForOrderId(trade.buy_order_id);
-    auto maybeSellClOrd = getClOrdIdForOrderId(trade.sell_order_id);
-
-    if (maybeBuyClOrd.has_value()) {
-        buyOrder = findOrderByClOrdId(maybeBuyClOrd.value());
+    // Only this session's orders are reported here
+    if (clOrdIds_.clOrdIdFor(trade.buy_order_id)) {
+        buyOrder = orderManager_->getOrder(trade.buy_order_id);
     }
 
-    if (maybeSellClOrd.has_value()) {
-        sellOrder = findOrderByClOrdId(maybeSellClOrd.value());
+    if (clOrdIds_.clOrdIdFor(trade.sell_order_id)) {
+        sellOrder = orderManager_->getOrder(trade.sell_order_id);
     }
     
     // Send trade execution reports
@@ -249,19 +279,16 @@ std::string FixMessageHandler::generateExecutionId() {
 
 std::unique_ptr<Order> FixMessageHandler::convertToInternalOrder(const FixMessageParser::NewOrderSingle& newOrder) {
     try {
-        // Generate internal order ID (in production, would use a proper ID generator)
-        static std::atomic<uint64_t> orderIdCounter{1};
-        uint64_t orderId = orderIdCounter++;
-        
+        // Internal order ID: this session's index and its next sequence
         auto order = std::make_unique<Order>(
-            orderId,
+            clOrdIds_.allocate().value,
             newOrder.side,
             newOrder.orderType,
             newOrder.timeInForce,
-            newOrder.price,
+            priceScale_.toTicks(newOrder.price),
             newOrder.quantity,
-            newOrder.symbol.c_str(),
-            newOrder.account.c_str()
+            symbolTable().intern(newOrder.symbol),
+            accountTable().intern(newOrder.account)
         );
         
         return order;
@@ -272,35 +299,46 @@ std::unique_ptr<Order> FixMessageHandler::convertToInternalOrder(const FixMessag
 }
 
 void FixMessageHandler::sendExecutionReport(const Order& order, char execType, 
-                                          Quantity lastQty, Price lastPx) {
+                                          Quantity lastQty, Price lastPx, Timestamp transactTime) {
     if (!fixSession_ || !fixSession_->isLoggedIn()) {
+        retireIfTerminal(order);
         return;
     }
     
-    // Thread-safe lookup of client order ID
-    auto maybeClOrdId = getClOrdIdForOrderId(order.id);
-    if (!maybeClOrdId.has_value()) {
+    // Client order ID by sequence index (no string hashing)
+    const ClOrdIdKey* clOrdId = clOrdIds_.clOrdIdFor(order.id);
+    if (!clOrdId) {
         return; // No client order ID found
     }
     
     FixMessageParser::ExecutionReport execReport;
     execReport.orderId = std::to_string(order.id.value);
-    execReport.clOrdId = maybeClOrdId.value();
+    execReport.clOrdId = std::string(clOrdId->view());
     execReport.execId = generateExecutionId();
     execReport.execType = execType;
     execReport.ordStatus = orderStatusToFixChar(order.status);
-    execReport.symbol = order.symbol;
+    execReport.symbol = order.symbol();
     execReport.side = order.side;
     execReport.orderQty = order.quantity;
-    execReport.price = order.price;
+    execReport.price = priceScale_.toDouble(order.price);
     execReport.lastQty = lastQty;
-    execReport.lastPx = lastPx;
+    execReport.lastPx = priceScale_.toDouble(lastPx);
     execReport.leavesQty = order.remainingQuantity();
     execReport.cumQty = order.filled_quantity;
-    execReport.avgPx = order.price; // Simplified - in production would calculate actual average
-    execReport.transactTime = std::chrono::system_clock::now();
+    execReport.avgPx = execReport.price; // Simplified - in production would calculate actual average
+    execReport.transactTime = TscClock::toWallClock(transactTime ? transactTime : TscClock::now());
     
     fixSession_->sendExecutionReport(execReport);
+    retireIfTerminal(order);
+}
+
+void FixMessageHandler::retireIfTerminal(const Order& order) {
+    // A filled, cancelled or rejected order gets no further reports: its ClOrdID stops
+    // resolving and its sequence slot can leave the window
+    if (order.status == OrderStatus::Filled || order.status == OrderStatus::Cancelled ||
+        order.status == OrderStatus::Rejected) {
+        clOrdIds_.unbind(order.id);
+    }
 }
 
 // Overload: send execution report using explicit clOrdId (no lookup)
@@ -316,15 +354,15 @@ void FixMessageHandler::sendExecutionReport(const Order& order, const std::strin
     execReport.execId = generateExecutionId();
     execReport.execType = execType;
     execReport.ordStatus = orderStatusToFixChar(order.status);
-    execReport.symbol = order.symbol;
+    execReport.symbol = order.symbol();
     execReport.side = order.side;
     execReport.orderQty = order.quantity;
-    execReport.price = order.price;
+    execReport.price = priceScale_.toDouble(order.price);
     execReport.lastQty = lastQty;
-    execReport.lastPx = lastPx;
+    execReport.lastPx = priceScale_.toDouble(lastPx);
     execReport.leavesQty = order.remainingQuantity();
     execReport.cumQty = order.filled_quantity;
-    execReport.avgPx = order.price; // Simplified
+    execReport.avgPx = execReport.price; // Simplified
     execReport.transactTime = std::chrono::system_clock::now();
 
     fixSession_->sendExecutionReport(execReport);
@@ -332,11 +370,11 @@ void FixMessageHandler::sendExecutionReport(const Order& order, const std::strin
 
 void FixMessageHandler::sendTradeExecutionReport(const Trade& trade, const Order& order) {
     char execType = order.isFullyFilled() ? EXEC_TYPE_FILL : EXEC_TYPE_PARTIAL_FILL;
-    sendExecutionReport(order, execType, trade.quantity, trade.price);
+    sendExecutionReport(order, execType, trade.quantity, trade.price, trade.timestamp);
 }
 
 void FixMessageHandler::sendRejectionReport(const std::string& clOrdId, const std::string& symbol, 
-                                          Side side, const std::string& reason) {
+                                          Side side, [[maybe_unused]] const std::string& reason) {
     if (!fixSession_ || !fixSession_->isLoggedIn()) {
         return;
     }
@@ -362,18 +400,11 @@ void FixMessageHandler::sendRejectionReport(const std::string& clOrdId, const st
 }
 
 Order* FixMessageHandler::findOrderByClOrdId(const std::string& clOrdId) {
-    OrderId oid;
-    {
-        std::lock_guard<std::mutex> lock(mapping_mutex_);
-        auto it = clOrdIdToOrderId_.find(clOrdId);
-        if (it == clOrdIdToOrderId_.end()) {
-            return nullptr;
-        }
-        oid = it->second;
+    auto oid = clOrdIds_.find(clOrdId);
+    if (!oid) {
+        return nullptr;
     }
-
-    // Get order from order manager (do not hold mapping mutex while handing control out)
-    return orderManager_->getOrder(oid);
+    return orderManager_->getOrder(*oid);
 }
 
 // Helper function to convert OrderStatus to FIX character
@@ -1,15 +1,17 @@
 #include "orderbook/Network/FixParser.hpp"
 #include "orderbook/Network/FixConstants.hpp"
+#include "orderbook/Network/FixEncoder.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <ctime>
+#include <cstring>
 
 namespace orderbook {
 
 using namespace fix;
 
-FixMessageParser::FixMessage FixMessageParser::parseMessage(const std::string& rawMessage) {
+FixMessageParser::FixMessage FixMessageParser::parseMessage(std::string_view rawMessage) {
     FixMessage msg(rawMessage);
     
     if (rawMessage.empty()) {
@@ -17,42 +19,36 @@ FixMessageParser::FixMessage FixMessageParser::parseMessage(const std::string& r
         return msg;
     }
     
-    // Split message into fields using SOH delimiter
-    std::vector<std::string> fields;
-    std::string current_field;
-    
-    for (char c : rawMessage) {
-        if (c == FIELD_DELIMITER) {
-            if (!current_field.empty()) {
-                fields.push_back(current_field);
-                current_field.clear();
-            }
-        } else {
-            current_field += c;
+    // Single pass over tag=value<SOH> fields; memchr does the byte scanning
+    const char* begin = rawMessage.data();
+    const char* end = begin + rawMessage.size();
+    const char* cursor = begin;
+    while (cursor < end) {
+        const char* soh = static_cast<const char*>(std::memchr(cursor, FIELD_DELIMITER, end - cursor));
+        const char* field_end = soh ? soh : end;  // the last field may lack its SOH
+        if (field_end == cursor) {
+            ++cursor;  // empty field
+            continue;
         }
-    }
-    
-    // Add last field if it doesn't end with SOH
-    if (!current_field.empty()) {
-        fields.push_back(current_field);
-    }
-    
-    // Parse each field (tag=value)
-    for (const auto& field : fields) {
-        size_t eq_pos = field.find('=');
-        if (eq_pos == std::string::npos) {
-            msg.errorMessage = "Invalid field format: " + field;
+        
+        const char* eq = static_cast<const char*>(std::memchr(cursor, '=', field_end - cursor));
+        if (!eq) {
+            msg.errorMessage = "Invalid field format: " + std::string(cursor, field_end);
             return msg;
         }
         
-        try {
-            int tag = std::stoi(field.substr(0, eq_pos));
-            std::string value = field.substr(eq_pos + 1);
-            msg.fields[tag] = value;
-        } catch (const std::exception& e) {
-            msg.errorMessage = "Failed to parse field: " + field + " - " + e.what();
+        int tag = 0;
+        auto [tag_end, ec] = std::from_chars(cursor, eq, tag);
+        if (ec != std::errc() || tag_end != eq) {
+            msg.errorMessage = "Failed to parse field: " + std::string(cursor, field_end);
             return msg;
         }
+        
+        if (!msg.addField(tag, static_cast<uint32_t>(eq + 1 - begin), static_cast<uint32_t>(field_end - eq - 1))) {
+            msg.errorMessage = "Too many fields";
+            return msg;
+        }
+        cursor = field_end + 1;
     }
     
     // Validate required header fields
@@ -63,13 +59,13 @@ FixMessageParser::FixMessage FixMessageParser::parseMessage(const std::string& r
     }
     
     // Validate FIX version
-    if (msg.getField(TAG_BEGIN_STRING) != BEGIN_STRING_44) {
+    if (msg.field(TAG_BEGIN_STRING) != BEGIN_STRING_44) {
         msg.errorMessage = "Unsupported FIX version: " + msg.getField(TAG_BEGIN_STRING);
         return msg;
     }
     
     // Get message type
-    std::string msgTypeStr = msg.getField(TAG_MSG_TYPE);
+    std::string_view msgTypeStr = msg.field(TAG_MSG_TYPE);
     if (msgTypeStr.empty()) {
         msg.errorMessage = "Missing message type";
         return msg;
@@ -77,8 +73,7 @@ FixMessageParser::FixMessage FixMessageParser::parseMessage(const std::string& r
     msg.msgType = msgTypeStr[0];
     
     // Validate checksum (simplified - in production would calculate actual checksum)
-    std::string checksumStr = msg.getField(TAG_CHECKSUM);
-    if (checksumStr.length() != 3) {
+    if (msg.field(TAG_CHECKSUM).length() != 3) {
         msg.errorMessage = "Invalid checksum format";
         return msg;
     }
@@ -111,7 +106,7 @@ FixMessageParser::NewOrderSingle FixMessageParser::parseNewOrderSingle(const Fix
         }
         
         // Side
-        std::string sideStr = fixMsg.getField(TAG_SIDE);
+        std::string_view sideStr = fixMsg.field(TAG_SIDE);
         if (sideStr.empty()) {
             nos.errorMessage = "Missing Side field";
             return nos;
@@ -119,7 +114,7 @@ FixMessageParser::NewOrderSingle FixMessageParser::parseNewOrderSingle(const Fix
         nos.side = fixCharToSide(sideStr[0]);
         
         // Order Type
-        std::string ordTypeStr = fixMsg.getField(TAG_ORD_TYPE);
+        std::string_view ordTypeStr = fixMsg.field(TAG_ORD_TYPE);
         if (ordTypeStr.empty()) {
             nos.errorMessage = "Missing OrdType field";
             return nos;
@@ -127,34 +122,38 @@ FixMessageParser::NewOrderSingle FixMessageParser::parseNewOrderSingle(const Fix
         nos.orderType = fixCharToOrderType(ordTypeStr[0]);
         
         // Quantity
-        std::string qtyStr = fixMsg.getField(TAG_ORDER_QTY);
-        if (qtyStr.empty()) {
+        if (fixMsg.field(TAG_ORDER_QTY).empty()) {
             nos.errorMessage = "Missing OrderQty field";
             return nos;
         }
-        nos.quantity = std::stoull(qtyStr);
+        if (!fixMsg.getNumber(TAG_ORDER_QTY, nos.quantity)) {
+            nos.errorMessage = "Invalid OrderQty field";
+            return nos;
+        }
         
         // Price (required for limit orders)
-        std::string priceStr = fixMsg.getField(TAG_PRICE);
         if (nos.orderType == OrderType::Limit) {
-            if (priceStr.empty()) {
+            if (fixMsg.field(TAG_PRICE).empty()) {
                 nos.errorMessage = "Missing Price field for limit order";
                 return nos;
             }
-            nos.price = std::stod(priceStr);
+            if (!fixMsg.getNumber(TAG_PRICE, nos.price)) {
+                nos.errorMessage = "Invalid Price field";
+                return nos;
+            }
         } else {
             nos.price = 0.0; // Market order
         }
         
         // Time In Force (optional, default to GTC)
-        std::string tifStr = fixMsg.getField(TAG_TIME_IN_FORCE);
+        std::string_view tifStr = fixMsg.field(TAG_TIME_IN_FORCE);
         nos.timeInForce = tifStr.empty() ? TimeInForce::GTC : fixCharToTif(tifStr[0]);
         
         // Account (optional)
-        nos.account = fixMsg.getField(TAG_CLORD_ID); // Using ClOrdID as account for simplicity
+        nos.account = fixMsg.getField(TAG_ACCOUNT);
         
         // Transaction Time
-        std::string transactTimeStr = fixMsg.getField(TAG_TRANSACT_TIME);
+        std::string_view transactTimeStr = fixMsg.field(TAG_TRANSACT_TIME);
         nos.transactTime = transactTimeStr.empty() ? 
             std::chrono::system_clock::now() : parseTimestamp(transactTimeStr);
         
@@ -192,38 +191,38 @@ FixMessageParser::OrderCancelReplaceRequest FixMessageParser::parseOrderCancelRe
         }
         
         // Side
-        std::string sideStr = fixMsg.getField(TAG_SIDE);
+        std::string_view sideStr = fixMsg.field(TAG_SIDE);
         if (!sideStr.empty()) {
             ocrr.side = fixCharToSide(sideStr[0]);
         }
         
         // Order Type
-        std::string ordTypeStr = fixMsg.getField(TAG_ORD_TYPE);
+        std::string_view ordTypeStr = fixMsg.field(TAG_ORD_TYPE);
         if (!ordTypeStr.empty()) {
             ocrr.orderType = fixCharToOrderType(ordTypeStr[0]);
         }
         
         // Quantity
-        std::string qtyStr = fixMsg.getField(TAG_ORDER_QTY);
-        if (!qtyStr.empty()) {
-            ocrr.quantity = std::stoull(qtyStr);
+        if (fixMsg.hasField(TAG_ORDER_QTY) && !fixMsg.getNumber(TAG_ORDER_QTY, ocrr.quantity)) {
+            ocrr.errorMessage = "Invalid OrderQty field";
+            return ocrr;
         }
         
         // Price
-        std::string priceStr = fixMsg.getField(TAG_PRICE);
-        if (!priceStr.empty()) {
-            ocrr.price = std::stod(priceStr);
+        if (fixMsg.hasField(TAG_PRICE) && !fixMsg.getNumber(TAG_PRICE, ocrr.price)) {
+            ocrr.errorMessage = "Invalid Price field";
+            return ocrr;
         }
         
         // Time In Force
-        std::string tifStr = fixMsg.getField(TAG_TIME_IN_FORCE);
+        std::string_view tifStr = fixMsg.field(TAG_TIME_IN_FORCE);
         ocrr.timeInForce = tifStr.empty() ? TimeInForce::GTC : fixCharToTif(tifStr[0]);
         
         // Account
-        ocrr.account = fixMsg.getField(TAG_CLORD_ID);
+        ocrr.account = fixMsg.getField(TAG_ACCOUNT);
         
         // Transaction Time
-        std::string transactTimeStr = fixMsg.getField(TAG_TRANSACT_TIME);
+        std::string_view transactTimeStr = fixMsg.field(TAG_TRANSACT_TIME);
         ocrr.transactTime = transactTimeStr.empty() ? 
             std::chrono::system_clock::now() : parseTimestamp(transactTimeStr);
         
@@ -261,13 +260,13 @@ FixMessageParser::OrderCancelRequest FixMessageParser::parseOrderCancelRequest(c
         }
         
         // Side
-        std::string sideStr = fixMsg.getField(TAG_SIDE);
+        std::string_view sideStr = fixMsg.field(TAG_SIDE);
         if (!sideStr.empty()) {
             ocr.side = fixCharToSide(sideStr[0]);
         }
         
         // Transaction Time
-        std::string transactTimeStr = fixMsg.getField(TAG_TRANSACT_TIME);
+        std::string_view transactTimeStr = fixMsg.field(TAG_TRANSACT_TIME);
         ocr.transactTime = transactTimeStr.empty() ? 
             std::chrono::system_clock::now() : parseTimestamp(transactTimeStr);
         
@@ -371,17 +370,10 @@ uint8_t FixMessageParser::calculateChecksum(const std::string& message) {
 }
 
 std::string FixMessageParser::formatTimestamp(const std::chrono::system_clock::time_point& timestamp) {
-    auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        timestamp.time_since_epoch()) % 1000;
-    
-    std::ostringstream oss;
-    oss << std::put_time(std::gmtime(&time_t), "%Y%m%d-%H:%M:%S");
-    oss << "." << std::setfill('0') << std::setw(3) << ms.count();
-    return oss.str();
+    return std::string(FixEncoder::timestamp(timestamp));
 }
 
-std::chrono::system_clock::time_point FixMessageParser::parseTimestamp(const std::string& timestampStr) {
+std::chrono::system_clock::time_point FixMessageParser::parseTimestamp(std::string_view timestampStr) {
     // Simple timestamp parsing - in production would be more robust
     return std::chrono::system_clock::now();
 }
@@ -9,12 +9,23 @@ using namespace boost::asio::ip;
 
 FixServer::FixServer(boost::asio::io_context& io_context,
                     std::shared_ptr<OrderManager> orderManager,
-                    std::shared_ptr<RiskManager> riskManager)
-    : ioContext_(io_context), acceptor_(io_context),
+                    std::shared_ptr<RiskManager> riskManager,
+                    PriceScale priceScale)
+    : ioContext_(io_context), acceptor_(io_context), orderStrand_(boost::asio::make_strand(io_context)),
       orderManager_(std::move(orderManager)), riskManager_(std::move(riskManager)),
+      priceScale_(priceScale),
       startTime_(std::chrono::system_clock::now()) {
 }
 
+void FixServer::setIoThreads(size_t threads) {
+    if (running_) return;
+    if (threads == 1) {
+        sessionPool_.reset();
+    } else {
+        sessionPool_ = std::make_unique<IoContextPool>(threads);
+    }
+}
+
 void FixServer::start(uint16_t port, const std::string& senderCompId) {
     senderCompId_ = senderCompId;
     
@@ -27,8 +38,12 @@ void FixServer::start(uint16_t port, const std::string& senderCompId) {
         
         running_ = true;
         startTime_ = std::chrono::system_clock::now();
+        if (sessionPool_) {
+            sessionPool_->run();
+        }
         
-        std::cout << "FIX Server started on port " << port << " with SenderCompID: " << senderCompId << std::endl;
+        std::cout << "FIX Server started on port " << port << " with SenderCompID: " << senderCompId
+                  << " (" << (sessionPool_ ? sessionPool_->size() : 1) << " I/O threads)" << std::endl;
         
         startAccept();
         
@@ -52,6 +67,10 @@ void FixServer::stop() {
             }
         }
         
+        if (sessionPool_) {
+            sessionPool_->stop();
+        }
+        
         sessions_.clear();
         messageHandlers_.clear();
         
@@ -77,13 +96,17 @@ void FixServer::startAccept() {
         return;
     }
     
-    auto socket = std::make_unique<tcp::socket>(ioContext_);
+    // The session's socket lives on the context that will run it
+    io_context& sessionContext = sessionPool_ ? sessionPool_->next() : ioContext_;
+    auto socket = std::make_unique<tcp::socket>(sessionContext);
     auto* socketPtr = socket.get();
     
     acceptor_.async_accept(*socketPtr,
-        [this, socket = std::move(socket)](const boost::system::error_code& error) mutable {
+        [this, &sessionContext, socket = std::move(socket)](const boost::system::error_code& error) mutable {
             if (!error) {
-                auto newSession = std::make_shared<FixSession>(std::move(*socket), ioContext_);
+                auto newSession = transportFactory_
+                    ? std::make_shared<FixSession>(transportFactory_(std::move(*socket)), sessionContext)
+                    : std::make_shared<FixSession>(std::move(*socket), sessionContext);
                 handleAccept(newSession, error);
             } else {
                 handleAccept(nullptr, error);
@@ -96,24 +119,47 @@ void FixServer::handleAccept(std::shared_ptr<FixSession> session, const boost::s
         ++totalConnections_;
         
         // Create message handler for this session
-        auto messageHandler = std::make_shared<FixMessageHandler>(orderManager_, riskManager_);
+        auto messageHandler = std::make_shared<FixMessageHandler>(orderManager_, riskManager_, priceScale_);
         messageHandler->setFixSession(session);
+        session->setWriteOptions(sessionWriteOptions_);
+        
+        // Set up session handlers; with a pool, order entry hops from the session's
+        // thread onto the order strand so OrderManager is never entered concurrently
+        if (sessionPool_) {
+            auto strand = orderStrand_;
+            session->setNewOrderHandler([messageHandler, strand](const FixMessageParser::NewOrderSingle& newOrder) {
+                boost::asio::post(strand, [messageHandler, newOrder] {
+                    messageHandler->handleNewOrderSingle(newOrder);
+                });
+            });
+            
+            session->setCancelReplaceHandler([messageHandler, strand](const FixMessageParser::OrderCancelReplaceRequest& cancelReplace) {
+                boost::asio::post(strand, [messageHandler, cancelReplace] {
+                    messageHandler->handleOrderCancelReplaceRequest(cancelReplace);
+                });
+            });
+            
+            session->setCancelHandler([messageHandler, strand](const FixMessageParser::OrderCancelRequest& cancelRequest) {
+                boost::asio::post(strand, [messageHandler, cancelRequest] {
+                    messageHandler->handleOrderCancelRequest(cancelRequest);
+                });
+            });
+        } else {
+            session->setNewOrderHandler([messageHandler](const FixMessageParser::NewOrderSingle& newOrder) {
+                messageHandler->handleNewOrderSingle(newOrder);
+            });
+            
+            session->setCancelReplaceHandler([messageHandler](const FixMessageParser::OrderCancelReplaceRequest& cancelReplace) {
+                messageHandler->handleOrderCancelReplaceRequest(cancelReplace);
+            });
+            
+            session->setCancelHandler([messageHandler](const FixMessageParser::OrderCancelRequest& cancelRequest) {
+                messageHandler->handleOrderCancelRequest(cancelRequest);
+            });
+        }
         
-        // Set up session handlers
-        session->setNewOrderHandler([messageHandler](const FixMessageParser::NewOrderSingle& newOrder) {
-            messageHandler->handleNewOrderSingle(newOrder);
-        });
-        
-        session->setCancelReplaceHandler([messageHandler](const FixMessageParser::OrderCancelReplaceRequest& cancelReplace) {
-            messageHandler->handleOrderCancelReplaceRequest(cancelReplace);
-        });
-        
-        session->setCancelHandler([messageHandler](const FixMessageParser::OrderCancelRequest& cancelRequest) {
-            messageHandler->handleOrderCancelRequest(cancelRequest);
-        });
-        
-        session->setSessionEventHandler([this, session](FixSession::SessionState state, const std::string& reason) {
-            handleSessionEvent(session, state, reason);
+        session->setSessionEventHandler([this, session, messageHandler](FixSession::SessionState state, const std::string& reason) {
+            handleSessionEvent(session, messageHandler, state, reason);
         });
         
         // Set session IDs (client will provide TargetCompID in logon)
@@ -123,8 +169,12 @@ void FixServer::handleAccept(std::shared_ptr<FixSession> session, const boost::s
         sessions_.push_back(session);
         messageHandlers_.push_back(messageHandler);
         
-        // Start the session
-        session->start();
+        // Start the session on its own thread
+        if (sessionPool_) {
+            boost::asio::post(session->getIoContext(), [session] { session->start(); });
+        } else {
+            session->start();
+        }
         
         std::cout << "New FIX session accepted. Total connections: " << totalConnections_.load() << std::endl;
         
@@ -141,14 +191,23 @@ void FixServer::handleAccept(std::shared_ptr<FixSession> session, const boost::s
     startAccept();
 }
 
-void FixServer::handleSessionEvent(std::shared_ptr<FixSession> session, 
-                                 FixSession::SessionState state, const std::string& reason) {
+void FixServer::handleSessionEvent([[maybe_unused]] std::shared_ptr<FixSession> session,
+                                   std::shared_ptr<FixMessageHandler> handler,
+                                   FixSession::SessionState state, const std::string& reason) {
     switch (state) {
         case FixSession::SessionState::LoggedIn:
             std::cout << "Session logged in: " << reason << std::endl;
             break;
         case FixSession::SessionState::Disconnected:
             std::cout << "Session disconnected: " << reason << std::endl;
+            if (cancelOnDisconnect_ && handler) {
+                // Same serialization as the session's order entry
+                if (sessionPool_) {
+                    boost::asio::post(orderStrand_, [handler] { handler->cancelSessionOrders(); });
+                } else {
+                    handler->cancelSessionOrders();
+                }
+            }
             break;
         case FixSession::SessionState::LogoutSent:
             std::cout << "Session logout: " << reason << std::endl;
@@ -2,6 +2,7 @@
 #include "orderbook/Network/FixConstants.hpp"
 #include "orderbook/Utilities/Config.hpp"
 #include "orderbook/Utilities/PerformanceTimer.hpp"
+#include "orderbook/Utilities/LatencyTracer.hpp"
 #include <boost/asio.hpp>
 #include <iostream>
 #include <sstream>
@@ -13,7 +14,11 @@ using namespace boost::asio::ip;
 using namespace fix;
 
 FixSession::FixSession(tcp::socket socket, boost::asio::io_context& io_context, LoggerPtr logger)
-    : ioContext_(io_context), socket_(std::move(socket)), 
+    : FixSession(std::make_unique<AsioTcpTransport>(std::move(socket)), io_context, std::move(logger)) {
+}
+
+FixSession::FixSession(std::unique_ptr<FixTransport> transport, boost::asio::io_context& io_context, LoggerPtr logger)
+    : ioContext_(io_context), transport_(std::move(transport)), 
       heartbeatTimer_(io_context), testRequestTimer_(io_context),
       sessionStartTime_(std::chrono::system_clock::now()), logger_(logger) {
     if (logger_) {
@@ -22,7 +27,7 @@ FixSession::FixSession(tcp::socket socket, boost::asio::io_context& io_context,
 }
 
 FixSession::FixSession(boost::asio::io_context& io_context, LoggerPtr logger)
-    : ioContext_(io_context), socket_(io_context), 
+    : ioContext_(io_context), transport_(std::make_unique<AsioTcpTransport>(io_context)), 
       heartbeatTimer_(io_context), testRequestTimer_(io_context),
       sessionStartTime_(std::chrono::system_clock::now()), logger_(logger) {
     if (logger_) {
@@ -31,7 +36,7 @@ FixSession::FixSession(boost::asio::io_context& io_context, LoggerPtr logger)
 }
 
 FixSession::FixSession(boost::asio::io_context& io_context, std::shared_ptr<Config> config, LoggerPtr logger)
-    : ioContext_(io_context), socket_(io_context), 
+    : ioContext_(io_context), transport_(std::make_unique<AsioTcpTransport>(io_context)), 
       heartbeatTimer_(io_context), testRequestTimer_(io_context),
       sessionStartTime_(std::chrono::system_clock::now()), config_(config), logger_(logger) {
     loadConfiguration(config);
@@ -49,6 +54,7 @@ void FixSession::start() {
         logger_->info("Starting FIX session", "FixSession::start");
     }
     updateState(SessionState::LoggedIn, "Session started");
+    applySocketOptions();
     startRead();
     startHeartbeatTimer();
 }
@@ -62,13 +68,11 @@ void FixSession::connect(const std::string& host, uint16_t port,
     setSessionIds(senderCompId, targetCompId);
     updateState(SessionState::Connecting, "Connecting to " + host + ":" + std::to_string(port));
     
-    tcp::resolver resolver(ioContext_);
-    auto endpoints = resolver.resolve(host, std::to_string(port));
-    
-    async_connect(socket_, endpoints,
-        [self = shared_from_this()](boost::system::error_code ec, tcp::endpoint) {
+    transport_->asyncConnect(host, port,
+        [self = shared_from_this()](const boost::system::error_code& ec) {
             if (!ec) {
                 self->updateState(SessionState::LogonSent, "Connected, sending logon");
+                self->applySocketOptions();
                 self->sendLogon();
                 self->startRead();
                 self->startHeartbeatTimer();
@@ -98,8 +102,12 @@ void FixSession::sendExecutionReport(const FixMessageParser::ExecutionReport& ex
         return;
     }
     
-    std::string execReportMsg = parser_.generateExecutionReport(execReport, senderCompId_, 
-                                                              targetCompId_, getNextOutgoingSeqNum());
+    // Reused per thread so steady-state encoding does not allocate
+    thread_local std::string execReportMsg;
+    SequenceNumber seqNum = getNextOutgoingSeqNum();
+    if (!encoder_.encodeExecutionReport(execReportMsg, execReport, seqNum)) {
+        execReportMsg = parser_.generateExecutionReport(execReport, senderCompId_, targetCompId_, seqNum);
+    }
     sendMessage(execReportMsg);
 }
 
@@ -122,6 +130,7 @@ void FixSession::sendReject(SequenceNumber refSeqNum, const std::string& text) {
 void FixSession::setSessionIds(const std::string& senderCompId, const std::string& targetCompId) {
     senderCompId_ = senderCompId;
     targetCompId_ = targetCompId;
+    encoder_.setSessionIds(senderCompId_, targetCompId_);
 }
 
 FixSession::SessionStats FixSession::getStats() const {
@@ -145,8 +154,7 @@ void FixSession::close() {
         // Cancel timers (Boost.Asio cancel returns size and does not require error_code)
         heartbeatTimer_.cancel();
         testRequestTimer_.cancel();
-        boost::system::error_code ec;
-        socket_.close(ec);
+        transport_->close();
         
         updateState(SessionState::Disconnected, "Session closed");
     }
@@ -159,26 +167,44 @@ void FixSession::startRead() {
 void FixSession::readMessage() {
     auto self = shared_from_this();
     
-    // Read until we find a complete FIX message (ending with SOH)
-    async_read_until(socket_, boost::asio::dynamic_buffer(messageBuffer_), FIELD_DELIMITER,
-        [self](boost::system::error_code ec, std::size_t bytes_transferred) {
+    // One read fills as much of the receive buffer as the socket has ready
+    auto space = framer_.prepare(ReadChunkSize);
+    transport_->asyncReadSome(boost::asio::buffer(space.first, space.second),
+        [self](const boost::system::error_code& ec, std::size_t bytes_transferred) {
             if (!ec) {
-                // Extract the complete message
-                std::string message = self->messageBuffer_.substr(0, bytes_transferred);
-                self->messageBuffer_.erase(0, bytes_transferred);
-                
-                self->processMessage(message);
+                self->framer_.commit(bytes_transferred);
+                self->processReceived();
                 
                 // Continue reading
-                self->readMessage();
+                if (self->transport_->isOpen()) {
+                    self->readMessage();
+                }
             } else {
                 self->handleError(ec, "read");
             }
         });
 }
 
-void FixSession::processMessage(const std::string& message) {
+void FixSession::processReceived() {
+    // Every complete message in the buffer goes to the parser as a view
+    std::string_view message;
+    std::string error;
+    for (;;) {
+        auto status = framer_.next(message, error);
+        if (status == FixFramer::Status::Incomplete) break;
+        if (status == FixFramer::Status::Malformed) {
+            LOG_WARN(logger_, "FixSession::processReceived", "Discarding garbled input: {}", error);
+            continue;
+        }
+        processMessage(message);
+        if (!transport_->isOpen()) break;
+    }
+}
+
+void FixSession::processMessage(std::string_view message) {
     PERF_TIMER("FixSession::processMessage", logger_);
+    // Arrival stamp for latency sampling; only orders are offered to the sampler
+    TscClock::Ticks received = LatencyTracer::getInstance().enabled() ? TscClock::now() : 0;
     
     {
         std::lock_guard<std::mutex> lock(statsMutex_);
@@ -186,7 +212,7 @@ void FixSession::processMessage(const std::string& message) {
     }
     
     if (logger_) {
-        logger_->debug("Processing FIX message: " + message.substr(0, std::min(message.length(), size_t(100))) + 
+        logger_->debug("Processing FIX message: " + std::string(message.substr(0, 100)) + 
                       (message.length() > 100 ? "..." : ""), "FixSession::processMessage");
     }
     
@@ -202,12 +228,7 @@ void FixSession::processMessage(const std::string& message) {
     SequenceNumber expectedSeqNum = getNextIncomingSeqNum();
     SequenceNumber receivedSeqNum = 0;
     
-    try {
-        std::string seqNumStr = fixMsg.getField(TAG_MSG_SEQ_NUM);
-        if (!seqNumStr.empty()) {
-            receivedSeqNum = std::stoull(seqNumStr);
-        }
-    } catch (const std::exception&) {
+    if (fixMsg.hasField(TAG_MSG_SEQ_NUM) && !fixMsg.getNumber(TAG_MSG_SEQ_NUM, receivedSeqNum)) {
         sendReject(expectedSeqNum, "Invalid sequence number");
         return;
     }
@@ -232,7 +253,7 @@ void FixSession::processMessage(const std::string& message) {
             handleTestRequest(fixMsg);
             break;
         case MSG_TYPE_NEW_ORDER_SINGLE:
-            handleNewOrderSingle(fixMsg);
+            handleNewOrderSingle(fixMsg, received);
             break;
         case MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST:
             handleOrderCancelReplaceRequest(fixMsg);
@@ -254,13 +275,8 @@ void FixSession::handleLogon(const FixMessageParser::FixMessage& msg) {
         updateState(SessionState::LoggedIn, "Logon received");
         
         // Extract heartbeat interval
-        std::string heartBtIntStr = msg.getField(TAG_HEARTBT_INT);
-        if (!heartBtIntStr.empty()) {
-            try {
-                heartbeatInterval_ = std::stoi(heartBtIntStr);
-            } catch (const std::exception&) {
-                heartbeatInterval_ = HEARTBEAT_INTERVAL;
-            }
+        if (msg.hasField(TAG_HEARTBT_INT) && !msg.getNumber(TAG_HEARTBT_INT, heartbeatInterval_)) {
+            heartbeatInterval_ = HEARTBEAT_INTERVAL;
         }
         
         // Send logon response if we're the server
@@ -287,8 +303,7 @@ void FixSession::handleHeartbeat(const FixMessageParser::FixMessage& msg) {
     }
     
     // Reset test request flag if this was a response
-    std::string testReqId = msg.getField(TAG_TEST_REQ_ID);
-    if (!testReqId.empty()) {
+    if (!msg.field(TAG_TEST_REQ_ID).empty()) {
         testRequestSent_ = false;
         testRequestTimer_.cancel();
     }
@@ -299,12 +314,15 @@ void FixSession::handleTestRequest(const FixMessageParser::FixMessage& msg) {
     sendHeartbeat(testReqId);
 }
 
-void FixSession::handleNewOrderSingle(const FixMessageParser::FixMessage& msg) {
+void FixSession::handleNewOrderSingle(const FixMessageParser::FixMessage& msg, TscClock::Ticks received) {
     if (!isLoggedIn()) {
         return;
     }
     
     auto newOrder = parser_.parseNewOrderSingle(msg);
+    if (received) {
+        LatencyTracer::getInstance().begin(newOrder.trace, TraceStage::FixReceive, received);
+    }
     if (newOrder.isValid && newOrderHandler_) {
         newOrderHandler_(newOrder);
     } else {
@@ -359,10 +377,16 @@ void FixSession::sendMessage(const std::string& message) {
 void FixSession::writeMessage(const std::string& message) {
     std::lock_guard<std::mutex> lock(writeMutex_);
     
-    bool write_in_progress = !writeQueue_.empty();
-    writeQueue_.push(message);
+    // Copy into a recycled buffer; its capacity survives from earlier messages
+    std::string buffer;
+    if (!writeBufferPool_.empty()) {
+        buffer = std::move(writeBufferPool_.back());
+        writeBufferPool_.pop_back();
+    }
+    buffer.assign(message);
+    pendingWrites_.push_back(std::move(buffer));
     
-    if (!write_in_progress) {
+    if (!writeInProgress_) {
         doWrite();
     }
 }
@@ -370,21 +394,54 @@ void FixSession::writeMessage(const std::string& message) {
 void FixSession::doWrite() {
     auto self = shared_from_this();
     
-    async_write(socket_, buffer(writeQueue_.front()),
-        [self](boost::system::error_code ec, std::size_t) {
+    // Everything queued so far goes out in one writev
+    inflightWrites_.swap(pendingWrites_);
+    writeGather_.clear();
+    for (const auto& message : inflightWrites_) {
+        writeGather_.push_back(buffer(message));
+    }
+    writeInProgress_ = true;
+    
+    if (writeOptions_.tcp_cork && inflightWrites_.size() > 1) {
+        transport_->setCork(true);
+    }
+    
+    transport_->asyncWrite(writeGather_,
+        [self](const boost::system::error_code& ec, std::size_t) {
             std::lock_guard<std::mutex> lock(self->writeMutex_);
             
+            for (auto& message : self->inflightWrites_) {
+                if (self->writeBufferPool_.size() == MaxPooledWriteBuffers) break;
+                message.clear();
+                self->writeBufferPool_.push_back(std::move(message));
+            }
+            self->inflightWrites_.clear();
+            
             if (!ec) {
-                self->writeQueue_.pop();
-                if (!self->writeQueue_.empty()) {
+                if (!self->pendingWrites_.empty()) {
                     self->doWrite();
+                    return;
+                }
+                if (self->writeOptions_.tcp_cork) {
+                    // Uncork once the burst is drained so the tail is flushed now
+                    self->transport_->setCork(false);
                 }
+                self->writeInProgress_ = false;
             } else {
+                self->writeInProgress_ = false;
                 self->handleError(ec, "write");
             }
         });
 }
 
+void FixSession::applySocketOptions() {
+    boost::system::error_code ec;
+    transport_->setNoDelay(writeOptions_.tcp_no_delay, ec);
+    if (ec && logger_) {
+        logger_->warn("Failed to set TCP_NODELAY: " + ec.message(), "FixSession::applySocketOptions");
+    }
+}
+
 void FixSession::startHeartbeatTimer() {
     heartbeatTimer_.expires_after(std::chrono::seconds(heartbeatInterval_));
     
@@ -478,6 +535,8 @@ void FixSession::loadConfiguration(std::shared_ptr<Config> config) {
     
     // Load network settings
     heartbeatInterval_ = config_->getInt("network", "heartbeat_interval", fix::HEARTBEAT_INTERVAL);
+    writeOptions_.tcp_no_delay = config_->getBool("network", "tcp_nodelay", writeOptions_.tcp_no_delay);
+    writeOptions_.tcp_cork = config_->getBool("network", "tcp_cork", writeOptions_.tcp_cork);
     
     // Load session identifiers if available
     std::string senderCompId = config_->getString("network", "sender_comp_id", "");
@@ -0,0 +1,52 @@
+#include "orderbook/Network/FixTransport.hpp"
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace orderbook {
+
+using boost::asio::ip::tcp;
+
+void AsioTcpTransport::asyncConnect(const std::string& host, uint16_t port, ConnectHandler handler) {
+    tcp::resolver resolver(socket_.get_executor());
+    boost::system::error_code ec;
+    auto endpoints = resolver.resolve(host, std::to_string(port), ec);
+    if (ec) {
+        boost::asio::post(socket_.get_executor(), [handler = std::move(handler), ec] { handler(ec); });
+        return;
+    }
+    boost::asio::async_connect(socket_, endpoints,
+        [handler = std::move(handler)](const boost::system::error_code& error, const tcp::endpoint&) {
+            handler(error);
+        });
+}
+
+void AsioTcpTransport::asyncReadSome(boost::asio::mutable_buffer buffer, IoHandler handler) {
+    socket_.async_read_some(buffer, std::move(handler));
+}
+
+void AsioTcpTransport::asyncWrite(const std::vector<boost::asio::const_buffer>& buffers, IoHandler handler) {
+    boost::asio::async_write(socket_, buffers, std::move(handler));
+}
+
+void AsioTcpTransport::setNoDelay(bool enabled, boost::system::error_code& ec) {
+    socket_.set_option(tcp::no_delay(enabled), ec);
+}
+
+void AsioTcpTransport::setCork(bool enabled) {
+#ifdef TCP_CORK
+    int cork = enabled ? 1 : 0;
+    ::setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_CORK, &cork, sizeof(cork));
+#else
+    (void)enabled;
+#endif
+}
+
+void AsioTcpTransport::close() {
+    boost::system::error_code ec;
+    socket_.close(ec);
+}
+
+}
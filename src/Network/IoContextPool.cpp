@@ -0,0 +1,52 @@
+#include "orderbook/Network/IoContextPool.hpp"
+#include <iostream>
+
+namespace orderbook {
+
+IoContextPool::IoContextPool(size_t size) {
+    if (size == 0) {
+        size = std::max(1u, std::thread::hardware_concurrency());
+    }
+    contexts_.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        // Each context is only ever run by its own thread
+        contexts_.push_back(std::make_unique<boost::asio::io_context>(1));
+    }
+}
+
+IoContextPool::~IoContextPool() {
+    stop();
+}
+
+void IoContextPool::run() {
+    if (running()) return;
+    threads_.reserve(contexts_.size());
+    for (auto& context : contexts_) {
+        context->restart();
+        guards_.push_back(boost::asio::make_work_guard(*context));
+        threads_.emplace_back([ctx = context.get()] {
+            try {
+                ctx->run();
+            } catch (const std::exception& e) {
+                std::cerr << "IoContextPool thread error: " << e.what() << std::endl;
+            }
+        });
+    }
+}
+
+void IoContextPool::stop() {
+    guards_.clear();
+    for (auto& context : contexts_) {
+        context->stop();
+    }
+    for (auto& thread : threads_) {
+        if (thread.joinable()) thread.join();
+    }
+    threads_.clear();
+}
+
+boost::asio::io_context& IoContextPool::next() {
+    return *contexts_[next_.fetch_add(1, std::memory_order_relaxed) % contexts_.size()];
+}
+
+}
@@ -1,5 +1,7 @@
 #include "orderbook/Network/WsServer.hpp"
 #include <boost/asio/dispatch.hpp>
+#include <charconv>
+#include <cstring>
 
 namespace orderbook {
 
@@ -8,18 +10,57 @@ namespace orderbook {
 class WsSession : public std::enable_shared_from_this<WsSession> {
     websocket::stream<beast::tcp_stream> ws_;
     beast::flat_buffer buffer_;
+    http::request<http::string_body> request_;
     std::shared_ptr<WsServer> server_;
+    WsServerOptions options_;
+
+    // Touched only on the session's strand
+    WsFrameQueue queue_;
+    bool closed_ = false;
+    size_t lagged_ = 0;
 
 public:
-    explicit WsSession(tcp::socket&& socket, std::shared_ptr<WsServer> server)
+    explicit WsSession(tcp::socket&& socket, std::shared_ptr<WsServer> server, const WsServerOptions& options)
         : ws_(std::move(socket))
-        , server_(server) {
+        , server_(server)
+        , options_(options)
+        , queue_(options.max_queued_messages) {
     }
 
     void run() {
+        // Read the HTTP request first: an upgrade becomes a WebSocket session, a plain
+        // GET can be answered from the server's HTTP handler
+        beast::get_lowest_layer(ws_).expires_after(std::chrono::seconds(30));
+        http::async_read(ws_.next_layer(), buffer_, request_,
+            beast::bind_front_handler(&WsSession::on_request, shared_from_this()));
+    }
+
+    void on_request(beast::error_code ec, std::size_t) {
+        if (ec) {
+            return;
+        }
+        if (!websocket::is_upgrade(request_)) {
+            serveHttp();
+            return;
+        }
+        // The websocket stream applies its own timeouts from here on
+        beast::get_lowest_layer(ws_).expires_never();
+        startWebSocket();
+    }
+
+    void startWebSocket() {
         // Set suggested timeout settings for the websocket
         ws_.set_option(websocket::stream_base::timeout::suggested(beast::role_type::server));
 
+        ws_.binary(options_.binary_frames);
+
+        if (options_.permessage_deflate) {
+            // Only takes effect for clients that offer the extension in their handshake
+            websocket::permessage_deflate pmd;
+            pmd.server_enable = true;
+            ws_.set_option(pmd);
+        }
+
         // Set a decorator to change the Server of the handshake
         ws_.set_option(websocket::stream_base::decorator(
             [](websocket::response_type& res) {
@@ -29,6 +70,7 @@ public:
 
         // Accept the websocket handshake
         ws_.async_accept(
+            request_,
             beast::bind_front_handler(
                 &WsSession::on_accept,
                 shared_from_this()));
@@ -66,7 +108,9 @@ public:
         }
 
         if (ec) {
-            std::cerr << "WsSession read error: " << ec.message() << std::endl;
+            if (!closed_) {
+                std::cerr << "WsSession read error: " << ec.message() << std::endl;
+            }
             server_->leave(shared_from_this());
             return;
         }
@@ -86,20 +130,38 @@ public:
         do_read();
     }
 
-    void send(std::shared_ptr<std::string const> const& ss) {
+    void send(WsFrameQueue::Frame const& frame, WsFrameQueue::Frame const& snapshot) {
         // Post the work to the strand to ensure thread safety
         net::post(
             ws_.get_executor(),
             beast::bind_front_handler(
                 &WsSession::on_send,
                 shared_from_this(),
-                ss));
+                frame,
+                snapshot));
     }
 
-    void on_send(std::shared_ptr<std::string const> const& ss) {
-        // Always write the message
+    void on_send(WsFrameQueue::Frame const& frame, WsFrameQueue::Frame const& snapshot) {
+        if (closed_) return;
+
+        // A lagging client gets the latest snapshot in place of its unsent frames
+        if (queue_.push(frame, snapshot) &&
+            options_.max_lagged_updates > 0 && ++lagged_ >= options_.max_lagged_updates) {
+            std::cerr << "WsSession disconnecting slow consumer after "
+                      << lagged_ << " conflated updates" << std::endl;
+            close();
+            return;
+        }
+
+        if (!queue_.writing()) {
+            do_write();
+        }
+    }
+
+    void do_write() {
+        queue_.startWrite();
         ws_.async_write(
-            net::buffer(*ss),
+            net::buffer(*queue_.front()),
             beast::bind_front_handler(
                 &WsSession::on_write,
                 shared_from_this()));
@@ -107,19 +169,64 @@ public:
 
     void on_write(beast::error_code ec, std::size_t bytes_transferred) {
         boost::ignore_unused(bytes_transferred);
+        queue_.finishWrite();
+        if (closed_) return;
 
         if (ec) {
             std::cerr << "WsSession write error: " << ec.message() << std::endl;
-            server_->leave(shared_from_this());
+            close();
             return;
         }
+
+        // The client is draining, however slowly
+        lagged_ = 0;
+        if (!queue_.empty()) {
+            do_write();
+        }
+    }
+
+private:
+    void serveHttp() {
+        auto response = std::make_shared<http::response<http::string_body>>();
+        response->version(request_.version());
+        response->set(http::field::server, "OrderBook-WsServer");
+        std::string target(request_.target());
+        target = target.substr(0, target.find('?'));
+        std::string body;
+        if (request_.method() == http::verb::get && server_->handleHttp(target, body)) {
+            response->result(http::status::ok);
+            response->set(http::field::content_type, "application/json");
+        } else {
+            response->result(http::status::not_found);
+            response->set(http::field::content_type, "text/plain");
+            body = "Not found\n";
+        }
+        response->body() = std::move(body);
+        response->keep_alive(false);
+        response->prepare_payload();
+        http::async_write(ws_.next_layer(), *response,
+            [self = shared_from_this(), response](beast::error_code, std::size_t) {
+                beast::error_code ignored;
+                self->ws_.next_layer().socket().shutdown(tcp::socket::shutdown_send, ignored);
+            });
+    }
+
+    void close() {
+        if (closed_) return;
+        closed_ = true;
+        queue_.clear();
+        beast::error_code ignored;
+        beast::get_lowest_layer(ws_).socket().close(ignored);
+        server_->leave(shared_from_this());
     }
 };
 
 //------------------------------------------------------------------------------
 
-WsServer::WsServer() 
-    : ioc_(1) // Single threaded for now
+WsServer::WsServer(WsServerOptions options)
+    : options_(options)
+    , pool_(options.io_threads)
+    , sessions_(std::make_shared<const SessionList>())
     , running_(false) {
 }
 
@@ -134,7 +241,7 @@ void WsServer::start(uint16_t port) {
         auto const address = net::ip::make_address("0.0.0.0");
         auto endpoint = tcp::endpoint{address, port};
 
-        acceptor_ = std::make_unique<tcp::acceptor>(ioc_);
+        acceptor_ = std::make_unique<tcp::acceptor>(pool_.at(0));
         
         beast::error_code ec;
         acceptor_->open(endpoint.protocol(), ec);
@@ -165,12 +272,11 @@ void WsServer::start(uint16_t port) {
         stop_signal_ = false;
         do_accept();
 
-        std::cout << "WebSocket Server listening on port " << port << std::endl;
+        std::cout << "WebSocket Server listening on port " << port
+                  << " (" << pool_.size() << " I/O threads)" << std::endl;
 
-        // Run the I/O context in a separate thread
-        thread_ = std::make_unique<std::thread>([this] {
-            run();
-        });
+        // Run the I/O contexts, one thread each
+        pool_.run();
 
         // Start broadcast loop
         broadcast_thread_ = std::make_unique<std::thread>([this] {
@@ -186,33 +292,26 @@ void WsServer::stop() {
     if (!running_) return;
     
     running_ = false;
-    stop_signal_ = true;
-    
-    // Stop the I/O context
-    ioc_.stop();
-    
-    if (thread_ && thread_->joinable()) {
-        thread_->join();
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stop_signal_ = true;
     }
+    state_cv_.notify_all();
+    
+    // Stop the I/O contexts
+    pool_.stop();
 
     if (broadcast_thread_ && broadcast_thread_->joinable()) {
         broadcast_thread_->join();
     }
     
-    sessions_.clear();
-}
-
-void WsServer::run() {
-    try {
-        ioc_.run();
-    } catch (const std::exception& e) {
-        std::cerr << "WsServer run error: " << e.what() << std::endl;
-    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::atomic_store(&sessions_, std::make_shared<const SessionList>());
 }
 
 void WsServer::do_accept() {
     acceptor_->async_accept(
-        net::make_strand(ioc_),
+        net::make_strand(pool_.next()),
         beast::bind_front_handler(
             &WsServer::on_accept,
             shared_from_this()));
@@ -225,7 +324,8 @@ void WsServer::on_accept(beast::error_code ec, tcp::socket socket) {
         // Create the session and run it
         std::make_shared<WsSession>(
             std::move(socket),
-            shared_from_this())->run();
+            shared_from_this(),
+            options_)->run();
     }
 
     // Accept another connection
@@ -234,67 +334,257 @@ void WsServer::on_accept(beast::error_code ec, tcp::socket socket) {
     }
 }
 
+void WsServer::setHttpHandler(const std::string& target, HttpHandler handler) {
+    std::lock_guard<std::mutex> lock(http_mutex_);
+    http_handlers_[target] = std::move(handler);
+}
+
+bool WsServer::handleHttp(const std::string& target, std::string& body) {
+    HttpHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(http_mutex_);
+        auto it = http_handlers_.find(target);
+        if (it == http_handlers_.end()) return false;
+        handler = it->second;
+    }
+    body = handler();
+    return true;
+}
+
 void WsServer::join(std::shared_ptr<WsSession> session) {
     std::lock_guard<std::mutex> lock(mutex_);
-    sessions_.insert(session);
+    auto next = std::make_shared<SessionList>(*sessions_);
+    next->push_back(std::move(session));
+    std::atomic_store(&sessions_, std::shared_ptr<const SessionList>(std::move(next)));
+
+    // The newcomer has no depth baseline, so the next broadcast is a full snapshot
+    {
+        std::lock_guard<std::mutex> state_lock(state_mutex_);
+        full_pending_ = true;
+        dirty_ = true;
+    }
+    state_cv_.notify_one();
 }
 
 void WsServer::leave(std::shared_ptr<WsSession> session) {
     std::lock_guard<std::mutex> lock(mutex_);
-    sessions_.erase(session);
+    auto it = std::find(sessions_->begin(), sessions_->end(), session);
+    if (it == sessions_->end()) return;
+    auto next = std::make_shared<SessionList>(*sessions_);
+    next->erase(next->begin() + (it - sessions_->begin()));
+    std::atomic_store(&sessions_, std::shared_ptr<const SessionList>(std::move(next)));
 }
 
-void WsServer::broadcast(const std::string& msg) {
+void WsServer::broadcast(const std::string& msg, const std::string* snapshot) {
+    // Serialized once; every session queues the same immutable payloads
     auto const ss = std::make_shared<std::string const>(msg);
+    auto const full = snapshot ? std::make_shared<std::string const>(*snapshot) : ss;
     
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(auto const& session : sessions_) {
-        session->send(ss);
+    auto sessions = std::atomic_load(&sessions_);
+    for(auto const& session : *sessions) {
+        session->send(ss, full);
     }
 }
 
-void WsServer::updateTopOfBook(double bid, double bidQty, double ask, double askQty) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    latest_state_.bid = bid;
-    latest_state_.bidQty = bidQty;
-    latest_state_.ask = ask;
-    latest_state_.askQty = askQty;
+void WsServer::markDirty() {
     latest_state_.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
+    dirty_ = true;
+}
+
+void WsServer::updateTopOfBook(double bid, double bidQty, double ask, double askQty) {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (latest_state_.bid == bid && latest_state_.bidQty == bidQty &&
+            latest_state_.ask == ask && latest_state_.askQty == askQty) {
+            return;
+        }
+        latest_state_.bid = bid;
+        latest_state_.bidQty = bidQty;
+        latest_state_.ask = ask;
+        latest_state_.askQty = askQty;
+        markDirty();
+    }
+    state_cv_.notify_one();
 }
 
 void WsServer::updateLastTrade(double price, double qty) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    latest_state_.lastPrice = price;
-    latest_state_.lastQty = qty;
-    latest_state_.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        latest_state_.lastPrice = price;
+        latest_state_.lastQty = qty;
+        markDirty();
+    }
+    state_cv_.notify_one();
+}
+
+void WsServer::updateDepth(const std::vector<WsDepthLevel>& bids, const std::vector<WsDepthLevel>& asks) {
+    if (options_.depth_levels == 0) return;
+    size_t bid_count = std::min(bids.size(), options_.depth_levels);
+    size_t ask_count = std::min(asks.size(), options_.depth_levels);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (std::equal(bids.begin(), bids.begin() + bid_count,
+                       latest_state_.bids.begin(), latest_state_.bids.end()) &&
+            std::equal(asks.begin(), asks.begin() + ask_count,
+                       latest_state_.asks.begin(), latest_state_.asks.end())) {
+            return;
+        }
+        latest_state_.bids.assign(bids.begin(), bids.begin() + bid_count);
+        latest_state_.asks.assign(asks.begin(), asks.begin() + ask_count);
+        markDirty();
+    }
+    state_cv_.notify_one();
+}
+
+namespace {
+
+/**
+ * @brief Levels of `current` that differ from `previous`, plus removed prices at quantity 0
+ */
+void diffLevels(const std::vector<WsDepthLevel>& previous, const std::vector<WsDepthLevel>& current,
+                std::vector<WsDepthLevel>& out) {
+    out.clear();
+    for (const auto& level : current) {
+        if (std::find(previous.begin(), previous.end(), level) == previous.end()) {
+            out.push_back(level);
+        }
+    }
+    for (const auto& level : previous) {
+        bool present = std::any_of(current.begin(), current.end(),
+            [&level](const WsDepthLevel& l) { return l.price == level.price; });
+        if (!present) {
+            out.push_back(WsDepthLevel{level.price, 0.0});
+        }
+    }
+}
+
+void appendNumber(std::string& out, double value) {
+    char buf[32];
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+void appendNumber(std::string& out, long long value) {
+    char buf[24];
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+void appendLevels(std::string& out, const char* key, const std::vector<WsDepthLevel>& levels) {
+    out += ",\"";
+    out += key;
+    out += "\":[";
+    for (size_t i = 0; i < levels.size(); ++i) {
+        if (i) out += ',';
+        out += '[';
+        appendNumber(out, levels[i].price);
+        out += ',';
+        appendNumber(out, levels[i].quantity);
+        out += ']';
+    }
+    out += ']';
+}
+
+template<typename T>
+void appendRaw(std::string& out, T value) {
+    // Wire format is little-endian; every supported target is
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+}
+
+void WsServer::encodeJson(std::string& out, const BookState& state, bool full,
+                          const std::vector<WsDepthLevel>& bids, const std::vector<WsDepthLevel>& asks) {
+    out.clear();
+    out += full ? "{\"type\":\"SNAPSHOT\",\"timestamp\":" : "{\"type\":\"DELTA\",\"timestamp\":";
+    appendNumber(out, state.timestamp);
+    out += ",\"bid\":"; appendNumber(out, state.bid);
+    out += ",\"bid_qty\":"; appendNumber(out, state.bidQty);
+    out += ",\"ask\":"; appendNumber(out, state.ask);
+    out += ",\"ask_qty\":"; appendNumber(out, state.askQty);
+    out += ",\"last_price\":"; appendNumber(out, state.lastPrice);
+    out += ",\"last_qty\":"; appendNumber(out, state.lastQty);
+    appendLevels(out, "bids", bids);
+    appendLevels(out, "asks", asks);
+    out += '}';
+}
+
+void WsServer::encodeBinary(std::string& out, const BookState& state, bool full,
+                            const std::vector<WsDepthLevel>& bids, const std::vector<WsDepthLevel>& asks) {
+    out.clear();
+    appendRaw<uint8_t>(out, full ? 1 : 2);
+    appendRaw<uint8_t>(out, 1);
+    appendRaw<uint16_t>(out, static_cast<uint16_t>(bids.size()));
+    appendRaw<uint16_t>(out, static_cast<uint16_t>(asks.size()));
+    appendRaw<uint16_t>(out, 0);
+    appendRaw<int64_t>(out, state.timestamp);
+    for (double value : {state.bid, state.bidQty, state.ask, state.askQty, state.lastPrice, state.lastQty}) {
+        appendRaw<double>(out, value);
+    }
+    for (const auto* side : {&bids, &asks}) {
+        for (const auto& level : *side) {
+            appendRaw<double>(out, level.price);
+            appendRaw<double>(out, level.quantity);
+        }
+    }
 }
 
 void WsServer::broadcastLoop() {
+    const auto min_interval = std::chrono::milliseconds(options_.min_interval_ms);
+    auto last_broadcast = std::chrono::steady_clock::time_point{};
+    std::vector<WsDepthLevel> published_bids, published_asks;
+    std::vector<WsDepthLevel> bid_diff, ask_diff;
+    size_t deltas_since_full = 0;
+    std::string msg, snapshot;
+
+    std::unique_lock<std::mutex> lock(state_mutex_);
     while (running_ && !stop_signal_) {
-        // Sleep for ~16ms (60 FPS)
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
-
-        std::string msg;
-        {
-            std::lock_guard<std::mutex> lock(state_mutex_);
-            // Simple JSON serialization manually to avoid dependency in this file if possible, 
-            // but we can use nlohmann/json if included. 
-            // Given main.cpp uses nlohmann/json, we should probably use it here too or just string format for speed.
-            // Let's use string formatting for zero-dependency in this file if we can, or just include json.
-            // Actually, let's just format a simple JSON string.
-            
-            msg = "{\"type\":\"SNAPSHOT\",\"timestamp\":" + std::to_string(latest_state_.timestamp) + 
-                  ",\"bid\":" + std::to_string(latest_state_.bid) + 
-                  ",\"bid_qty\":" + std::to_string(latest_state_.bidQty) + 
-                  ",\"ask\":" + std::to_string(latest_state_.ask) + 
-                  ",\"ask_qty\":" + std::to_string(latest_state_.askQty) + 
-                  ",\"last_price\":" + std::to_string(latest_state_.lastPrice) + 
-                  ",\"last_qty\":" + std::to_string(latest_state_.lastQty) + "}";
+        // Nothing is sent until something changes
+        state_cv_.wait(lock, [this] { return dirty_ || stop_signal_; });
+        if (stop_signal_) break;
+
+        // Rate limit: updates arriving inside the window fold into this broadcast
+        auto due = last_broadcast + min_interval;
+        if (std::chrono::steady_clock::now() < due) {
+            if (state_cv_.wait_until(lock, due, [this] { return stop_signal_.load(); })) break;
         }
-        
-        broadcast(msg);
+
+        BookState state = latest_state_;
+        dirty_ = false;
+        bool full = full_pending_ || ++deltas_since_full >= options_.full_snapshot_interval;
+        full_pending_ = false;
+        lock.unlock();
+
+        if (full) {
+            deltas_since_full = 0;
+        } else {
+            diffLevels(published_bids, state.bids, bid_diff);
+            diffLevels(published_asks, state.asks, ask_diff);
+        }
+        const auto& bids = full ? state.bids : bid_diff;
+        const auto& asks = full ? state.asks : ask_diff;
+        auto encode = [this, &state](std::string& out, bool as_full, const std::vector<WsDepthLevel>& b,
+                                     const std::vector<WsDepthLevel>& a) {
+            if (options_.binary_frames) {
+                encodeBinary(out, state, as_full, b, a);
+            } else {
+                encodeJson(out, state, as_full, b, a);
+            }
+        };
+        encode(msg, full, bids, asks);
+        if (!full) {
+            // Sessions that had to drop deltas resync from this instead
+            encode(snapshot, true, state.bids, state.asks);
+        }
+        broadcast(msg, full ? nullptr : &snapshot);
+
+        published_bids = std::move(state.bids);
+        published_asks = std::move(state.asks);
+        last_broadcast = std::chrono::steady_clock::now();
+        lock.lock();
     }
 }
 
@@ -6,7 +6,8 @@
 namespace orderbook {
 
 RiskManager::RiskManager(const RiskLimits& limits, LoggerPtr logger) 
-    : limits_(limits), logger_(logger) {
+    : default_account_(accountTable().intern("default")), logger_(logger) {
+    publishLimits(limits);
     if (logger_) {
         logger_->info("RiskManager initialized with custom limits", "RiskManager::ctor");
     }
@@ -15,7 +16,8 @@ RiskManager::RiskManager(const RiskLimits& limits, LoggerPtr logger)
 RiskManager::RiskManager(LoggerPtr logger) : RiskManager(RiskLimits{}, logger) {}
 
 RiskManager::RiskManager(std::shared_ptr<Config> config, LoggerPtr logger) 
-    : config_(config), logger_(logger) {
+    : default_account_(accountTable().intern("default")), config_(config), logger_(logger) {
+    publishLimits(RiskLimits{});
     loadConfiguration(config);
     if (logger_) {
         logger_->info("RiskManager initialized with configuration", "RiskManager::ctor");
@@ -28,73 +30,171 @@ RiskCheck RiskManager::validateOrder(const Order& order, const Portfolio& portfo
     }
     PERF_TIMER("RiskManager::validateOrder", logger_);
     
-    if (logger_) {
-        logger_->debug("Validating order ID: " + std::to_string(order.id.value) +
-                      " Symbol: " + order.symbol + " Quantity: " + std::to_string(order.quantity) +
-                      " Price: " + std::to_string(order.price), "RiskManager::validateOrder");
-    }
+    LOG_DEBUG(logger_, "RiskManager::validateOrder", "Validating order ID: {} Symbol: {} Quantity: {} Price: {}",
+              order.id, order.symbol(), order.quantity, order.price);
+    const RiskLimits& limits = currentLimits();
     
     // Validate order size
-    if (!validateOrderSize(order.quantity)) {
+    if (!validateOrderSize(limits, order.quantity)) {
         std::ostringstream oss;
-        oss << "Order size " << order.quantity << " exceeds maximum allowed " << limits_.max_order_size;
-        if (logger_) {
-            logger_->warn("Order size validation failed: " + oss.str(), 
-                         "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
-        }
+        oss << "Order size " << order.quantity << " exceeds maximum allowed " << limits.max_order_size;
+        LOG_WARN(logger_, "RiskManager::validateOrder", "Order size validation failed: {} OrderID: {}",
+                 oss.str(), order.id);
         return RiskCheck(RiskResult::Rejected, oss.str());
     }
     
     // Validate price
-    if (!validatePrice(order.price)) {
+    if (!validatePrice(limits, order.price)) {
         std::ostringstream oss;
         oss << "Order price " << order.price << " outside allowed range [" 
-            << limits_.min_price << ", " << limits_.max_price << "]";
-        if (logger_) {
-            logger_->warn("Order price validation failed: " + oss.str(), 
-                         "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
-        }
+            << limits.min_price << ", " << limits.max_price << "]";
+        LOG_WARN(logger_, "RiskManager::validateOrder", "Order price validation failed: {} OrderID: {}",
+                 oss.str(), order.id);
         return RiskCheck(RiskResult::Rejected, oss.str());
     }
     
+    // Validate lot size and price band of the instrument
+    std::string reason;
+    if (!validateInstrument(order, reason)) {
+        LOG_WARN(logger_, "RiskManager::validateOrder", "Instrument validation failed: {} OrderID: {}",
+                 reason, order.id);
+        return RiskCheck(RiskResult::Rejected, reason);
+    }
+    
     // Validate position limits
-    if (!validatePosition(portfolio, order)) {
+    if (!validatePosition(limits, portfolio, order)) {
         std::ostringstream oss;
-        oss << "Order would exceed position limits for symbol " << order.symbol;
-        if (logger_) {
-            logger_->warn("Position limit validation failed: " + oss.str(), 
-                         "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
-        }
+        oss << "Order would exceed position limits for symbol " << order.symbol();
+        LOG_WARN(logger_, "RiskManager::validateOrder", "Position limit validation failed: {} OrderID: {}",
+                 oss.str(), order.id);
         return RiskCheck(RiskResult::Rejected, oss.str());
     }
     
-    if (logger_) {
-        logger_->debug("Order passed all risk validations", 
-                      "RiskManager::validateOrder - OrderID: " + std::to_string(order.id.value));
-    }
+    LOG_DEBUG(logger_, "RiskManager::validateOrder", "Order passed all risk validations OrderID: {}", order.id);
     
     return RiskCheck(RiskResult::Approved, "Order passed all risk checks");
 }
 
+RiskCheck RiskManager::preTradeCheck(const Order& order) {
+    const RiskLimits& limits = currentLimits();
+    if (!validateOrderSize(limits, order.quantity)) {
+        std::ostringstream oss;
+        oss << "Order size " << order.quantity << " exceeds maximum allowed " << limits.max_order_size;
+        LOG_WARN(logger_, "RiskManager::preTradeCheck", "{} OrderID: {}", oss.str(), order.id);
+        return RiskCheck(RiskResult::Rejected, oss.str());
+    }
+    // Market orders carry no price to bound
+    if (order.type != OrderType::Market && !validatePrice(limits, order.price)) {
+        std::ostringstream oss;
+        oss << "Order price " << order.price << " outside allowed range ["
+            << limits.min_price << ", " << limits.max_price << "]";
+        LOG_WARN(logger_, "RiskManager::preTradeCheck", "{} OrderID: {}", oss.str(), order.id);
+        return RiskCheck(RiskResult::Rejected, oss.str());
+    }
+    std::string reason;
+    if (!validateInstrument(order, reason)) {
+        LOG_WARN(logger_, "RiskManager::preTradeCheck", "{} OrderID: {}", reason, order.id);
+        return RiskCheck(RiskResult::Rejected, reason);
+    }
+
+    PositionCell* cell = cellFor(order.account_id, order.symbol_id);
+    if (!cell) {
+        LOG_WARN(logger_, "RiskManager::preTradeCheck", "No position slot for account {} symbol {} OrderID: {}",
+                 order.account_id, order.symbol_id, order.id);
+        return RiskCheck(RiskResult::Rejected, "Account or symbol outside risk table");
+    }
+
+    // Reserve first, then check: concurrent submitters on one account may both be
+    // refused near the limit, but the limit itself can never be overshot
+    auto quantity = static_cast<int64_t>(order.quantity);
+    bool within_limit;
+    if (order.isBuy()) {
+        int64_t open = cell->open_buy.fetch_add(quantity, std::memory_order_acq_rel) + quantity;
+        within_limit = cell->position.load(std::memory_order_acquire) + open <= limits.max_position;
+        if (!within_limit) cell->open_buy.fetch_sub(quantity, std::memory_order_acq_rel);
+    } else {
+        int64_t open = cell->open_sell.fetch_add(quantity, std::memory_order_acq_rel) + quantity;
+        within_limit = cell->position.load(std::memory_order_acquire) - open >= limits.min_position;
+        if (!within_limit) cell->open_sell.fetch_sub(quantity, std::memory_order_acq_rel);
+    }
+    if (!within_limit) {
+        std::ostringstream oss;
+        oss << "Order would exceed position limits for symbol " << order.symbol();
+        LOG_WARN(logger_, "RiskManager::preTradeCheck", "{} OrderID: {}", oss.str(), order.id);
+        return RiskCheck(RiskResult::Rejected, oss.str());
+    }
+    return RiskCheck(RiskResult::Approved);
+}
+
+void RiskManager::onFill(AccountId account, SymbolId symbol, Side side, Quantity quantity, Price price,
+                         bool reserved) {
+    // A reserved order must drain its exposure even if bypass was switched on meanwhile
+    if (!reserved && bypass_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (PositionCell* cell = cellFor(account, symbol)) {
+        applyFill(*cell, side, quantity, price, reserved);
+    }
+}
+
+void RiskManager::adjustExposure(AccountId account, SymbolId symbol, Side side, int64_t delta) {
+    if (delta == 0) return;
+    if (PositionCell* cell = cellFor(account, symbol)) {
+        (side == Side::Buy ? cell->open_buy : cell->open_sell).fetch_add(delta, std::memory_order_acq_rel);
+    }
+}
+
+void RiskManager::applyFill(PositionCell& cell, Side side, Quantity quantity, Price price, bool reserved) {
+    auto filled = static_cast<int64_t>(quantity);
+    // Move the quantity from open exposure into the position
+    cell.position.fetch_add(side == Side::Buy ? filled : -filled, std::memory_order_acq_rel);
+    if (reserved) {
+        (side == Side::Buy ? cell.open_buy : cell.open_sell).fetch_sub(filled, std::memory_order_acq_rel);
+    }
+    cell.last_price.store(price, std::memory_order_relaxed);
+}
+
 void RiskManager::updatePosition(const Trade& trade) {
     if (bypass_.load(std::memory_order_relaxed)) {
         return;
     }
     // Get accounts for the orders involved in the trade
-    std::string buy_account = getAccountForOrder(trade.buy_order_id);
-    std::string sell_account = getAccountForOrder(trade.sell_order_id);
-    
-    // Update buyer's position (positive quantity)
-    if (portfolios_.find(buy_account) == portfolios_.end()) {
-        portfolios_[buy_account] = Portfolio(buy_account);
+    AccountId buy_account;
+    AccountId sell_account;
+    {
+        std::lock_guard<std::mutex> lock(account_map_mutex_);
+        buy_account = accountForOrderLocked(trade.buy_order_id);
+        sell_account = accountForOrderLocked(trade.sell_order_id);
     }
-    portfolios_[buy_account].updatePosition(trade.symbol, static_cast<int64_t>(trade.quantity), trade.price);
-    
-    // Update seller's position (negative quantity)
-    if (portfolios_.find(sell_account) == portfolios_.end()) {
-        portfolios_[sell_account] = Portfolio(sell_account);
+    if (PositionCell* buy = cellFor(buy_account, trade.symbol_id)) {
+        applyFill(*buy, Side::Buy, trade.quantity, trade.price, false);
     }
-    portfolios_[sell_account].updatePosition(trade.symbol, -static_cast<int64_t>(trade.quantity), trade.price);
+    if (PositionCell* sell = cellFor(sell_account, trade.symbol_id)) {
+        applyFill(*sell, Side::Sell, trade.quantity, trade.price, false);
+    }
+}
+
+RiskManager::PositionCell* RiskManager::cellFor(AccountId account, SymbolId symbol) {
+    AccountSlot* slot = accounts_.get(resolveAccount(account));
+    if (!slot) return nullptr;
+    AccountRow* row = slot->row.load(std::memory_order_acquire);
+    if (!row) {
+        auto* fresh = new AccountRow();
+        if (slot->row.compare_exchange_strong(row, fresh, std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+            row = fresh;
+        } else {
+            delete fresh;
+        }
+    }
+    return row->get(symbol);
+}
+
+const RiskManager::PositionCell* RiskManager::findCell(AccountId account, SymbolId symbol) const {
+    const AccountSlot* slot = accounts_.find(resolveAccount(account));
+    if (!slot) return nullptr;
+    const AccountRow* row = slot->row.load(std::memory_order_acquire);
+    return row ? row->find(symbol) : nullptr;
 }
 
 void RiskManager::setBypass(bool bypass) {
@@ -105,35 +205,60 @@ bool RiskManager::isBypassed() const {
     return bypass_.load(std::memory_order_relaxed);
 }
 
-void RiskManager::associateOrderWithAccount(OrderId order_id, const std::string& account) {
+void RiskManager::associateOrderWithAccount(OrderId order_id, AccountId account) {
+    std::lock_guard<std::mutex> lock(account_map_mutex_);
     order_to_account_[order_id] = account;
 }
 
-std::string RiskManager::getAccountForOrder(OrderId order_id) const {
+AccountId RiskManager::getAccountForOrder(OrderId order_id) const {
+    std::lock_guard<std::mutex> lock(account_map_mutex_);
+    return accountForOrderLocked(order_id);
+}
+
+AccountId RiskManager::accountForOrderLocked(OrderId order_id) const {
     auto it = order_to_account_.find(order_id);
     if (it != order_to_account_.end()) {
         return it->second;
     }
     // Return default account if not found
-    return "account_" + std::to_string(order_id.value);
+    return accountTable().intern("account_" + std::to_string(order_id.value));
 }
 
-const Portfolio& RiskManager::getPortfolio(const std::string& account) const {
-    auto it = portfolios_.find(account);
-    if (it == portfolios_.end()) {
-        // Create new portfolio if it doesn't exist
-        portfolios_[account] = Portfolio(account);
-        return portfolios_[account];
-    }
-    return it->second;
+int64_t RiskManager::getPosition(AccountId account, SymbolId symbol) const {
+    const PositionCell* cell = findCell(account, symbol);
+    return cell ? cell->position.load(std::memory_order_acquire) : 0;
+}
+
+Portfolio RiskManager::getPortfolio(AccountId account) const {
+    // Snapshot of the account's non-flat positions (cold path)
+    Portfolio portfolio(account);
+    const AccountSlot* slot = accounts_.find(resolveAccount(account));
+    const AccountRow* row = slot ? slot->row.load(std::memory_order_acquire) : nullptr;
+    if (!row) return portfolio;
+    row->forEachChunk([&](size_t base, const PositionCell* cells, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            int64_t position = cells[i].position.load(std::memory_order_acquire);
+            if (position == 0) continue;
+            auto symbol = static_cast<SymbolId>(base + i);
+            portfolio.positions[symbol] = position;
+            portfolio.avg_prices[symbol] = cells[i].last_price.load(std::memory_order_relaxed);
+        }
+    });
+    return portfolio;
 }
 
 void RiskManager::setLimits(const RiskLimits& limits) {
-    limits_ = limits;
+    publishLimits(limits);
 }
 
 const RiskManager::RiskLimits& RiskManager::getLimits() const {
-    return limits_;
+    return currentLimits();
+}
+
+void RiskManager::publishLimits(const RiskLimits& limits) {
+    std::lock_guard<std::mutex> lock(limits_mutex_);
+    limit_versions_.push_back(std::make_unique<const RiskLimits>(limits));
+    limits_.store(limit_versions_.back().get(), std::memory_order_release);
 }
 
 void RiskManager::loadConfiguration(std::shared_ptr<Config> config) {
@@ -142,12 +267,19 @@ void RiskManager::loadConfiguration(std::shared_ptr<Config> config) {
         return;
     }
     
+    // Price limits are configured in decimal units and held in instrument ticks
+    price_scale_ = PriceScale(config_->getDouble("orderbook", "tick_size", price_scale_.tick_size));
+
     // Load risk limits from configuration
-    limits_.max_order_size = config_->getInt("risk", "max_order_size", limits_.max_order_size);
-    limits_.max_price = config_->getDouble("risk", "max_price", limits_.max_price);
-    limits_.min_price = config_->getDouble("risk", "min_price", limits_.min_price);
-    limits_.max_position = config_->getInt("risk", "max_position", limits_.max_position);
-    limits_.min_position = config_->getInt("risk", "min_position", limits_.min_position);
+    RiskLimits limits = currentLimits();
+    limits.max_order_size = config_->getInt("risk", "max_order_size", limits.max_order_size);
+    limits.max_price = price_scale_.toTicks(
+        config_->getDouble("risk", "max_price", price_scale_.toDouble(limits.max_price)));
+    limits.min_price = price_scale_.toTicks(
+        config_->getDouble("risk", "min_price", price_scale_.toDouble(limits.min_price)));
+    limits.max_position = config_->getInt("risk", "max_position", limits.max_position);
+    limits.min_position = config_->getInt("risk", "min_position", limits.min_position);
+    publishLimits(limits);
 }
 
 void RiskManager::reloadConfiguration() {
@@ -156,16 +288,37 @@ void RiskManager::reloadConfiguration() {
     }
 }
 
-bool RiskManager::validateOrderSize(Quantity quantity) const {
-    return quantity > 0 && quantity <= limits_.max_order_size;
+bool RiskManager::validateOrderSize(const RiskLimits& limits, Quantity quantity) {
+    return quantity > 0 && quantity <= limits.max_order_size;
+}
+
+bool RiskManager::validatePrice(const RiskLimits& limits, Price price) {
+    return price >= limits.min_price && price <= limits.max_price;
 }
 
-bool RiskManager::validatePrice(Price price) const {
-    return price >= limits_.min_price && price <= limits_.max_price;
+bool RiskManager::validateInstrument(const Order& order, std::string& reason) const {
+    const SymbolMasterEntry* entry = symbol_master_ ? symbol_master_->byId(order.symbol_id) : nullptr;
+    if (!entry) {
+        return true;
+    }
+    if (order.quantity % entry->lot_size != 0) {
+        reason = "Order size " + std::to_string(order.quantity) + " is not a multiple of lot size " +
+                 std::to_string(entry->lot_size) + " for " + std::string(entry->symbolView());
+        return false;
+    }
+    // Market orders carry no price to bound
+    if (order.type != OrderType::Market && entry->hasPriceBand() &&
+        (order.price < entry->min_price || order.price > entry->max_price)) {
+        reason = "Order price " + std::to_string(order.price) + " outside band [" +
+                 std::to_string(entry->min_price) + ", " + std::to_string(entry->max_price) + "] for " +
+                 std::string(entry->symbolView());
+        return false;
+    }
+    return true;
 }
 
-bool RiskManager::validatePosition(const Portfolio& portfolio, const Order& order) const {
-    int64_t current_position = portfolio.getPosition(order.symbol);
+bool RiskManager::validatePosition(const RiskLimits& limits, const Portfolio& portfolio, const Order& order) {
+    int64_t current_position = portfolio.getPosition(order.symbol_id);
     int64_t position_change = static_cast<int64_t>(order.quantity);
     
     if (order.side == Side::Sell) {
@@ -174,7 +327,7 @@ bool RiskManager::validatePosition(const Portfolio& portfolio, const Order& orde
     
     int64_t new_position = current_position + position_change;
     
-    return new_position >= limits_.min_position && new_position <= limits_.max_position;
+    return new_position >= limits.min_position && new_position <= limits.max_position;
 }
 
 }
\ No newline at end of file
@@ -7,15 +7,83 @@
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
+#include <cstring>
 
 namespace orderbook {
 
 std::shared_ptr<Logger> Logger::global_logger_;
 std::mutex Logger::global_mutex_;
 
+namespace {
+std::atomic<uint64_t> next_logger_id{1};
+
+int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+}
+
+size_t Logger::LogRecord::append(const char* data, size_t length) {
+    // Truncate rather than fail; the record is fixed-size
+    size_t room = sizeof(text) - text_used;
+    size_t n = std::min(length, room);
+    std::memcpy(text + text_used, data, n);
+    text_used = static_cast<uint16_t>(text_used + n);
+    return n;
+}
+
+Logger::LogRing::LogRing(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size *= 2;
+    slots_.resize(size);
+    mask_ = size - 1;
+}
+
+Logger::LogRecord* Logger::LogRing::claim() {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail - cached_head_ > mask_) {
+            return nullptr;
+        }
+    }
+    return &slots_[tail & mask_];
+}
+
+Logger::LogRecord* Logger::LogRing::front() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head == cached_tail_) {
+            return nullptr;
+        }
+    }
+    return &slots_[head & mask_];
+}
+
 Logger::Logger() : Logger(LogConfig{}) {}
 
-Logger::Logger(const LogConfig& config) : config_(config), current_file_size_(0) {
+Logger::Logger(const LogConfig& config)
+    : config_(config), current_file_size_(0), instance_id_(next_logger_id.fetch_add(1)) {
+    min_level_.store(config_.min_level, std::memory_order_relaxed);
+    openLogFile();
+    startWriter();
+}
+
+Logger::Logger(std::shared_ptr<Config> config)
+    : current_file_size_(0), instance_id_(next_logger_id.fetch_add(1)) {
+    loadConfiguration(config);
+    startWriter();
+}
+
+Logger::~Logger() {
+    stopWriter();
+    if (file_stream_ && file_stream_->is_open()) {
+        file_stream_->close();
+    }
+}
+
+void Logger::openLogFile() {
     if (!config_.filename.empty()) {
         file_stream_ = std::make_unique<std::ofstream>(config_.filename, std::ios::app);
         if (file_stream_->is_open()) {
@@ -26,14 +94,152 @@ Logger::Logger(const LogConfig& config) : config_(config), current_file_size_(0)
     }
 }
 
-Logger::Logger(std::shared_ptr<Config> config) : current_file_size_(0) {
-    loadConfiguration(config);
+void Logger::startWriter() {
+    if (!config_.async || writer_.joinable()) {
+        return;
+    }
+    stop_writer_.store(false, std::memory_order_relaxed);
+    async_.store(true, std::memory_order_release);
+    writer_ = std::thread(&Logger::writerLoop, this);
 }
 
-Logger::~Logger() {
+void Logger::stopWriter() {
+    if (!writer_.joinable()) {
+        return;
+    }
+    // New records go synchronous from here; the writer drains what is queued
+    async_.store(false, std::memory_order_release);
+    stop_writer_.store(true, std::memory_order_release);
+    writer_.join();
+}
+
+Logger::LogRing* Logger::threadRing() {
+    // One-entry cache; logger IDs are never reused, so a stale entry cannot match
+    struct Cache { uint64_t owner = 0; LogRing* ring = nullptr; };
+    static thread_local Cache cache;
+    if (cache.owner == instance_id_) {
+        return cache.ring;
+    }
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    auto& ring = ring_by_thread_[std::this_thread::get_id()];
+    if (!ring) {
+        rings_.push_back(std::make_unique<LogRing>(config_.ring_capacity));
+        ring = rings_.back().get();
+    }
+    cache.owner = instance_id_;
+    cache.ring = ring;
+    return ring;
+}
+
+Logger::LogRecord* Logger::beginRecord(LogLevel level) {
+    LogRecord* record = threadRing()->claim();
+    if (!record) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    record->timestamp_ns = nowNanos();
+    record->level = level;
+    record->format = nullptr;
+    record->arg_count = 0;
+    record->message_length = 0;
+    record->context_length = 0;
+    record->text_used = 0;
+    return record;
+}
+
+void Logger::writerLoop() {
+    while (!stop_writer_.load(std::memory_order_acquire)) {
+        if (drainRings() == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(config_.flush_interval_us));
+        }
+    }
+    // Producers fall back to synchronous writes before stop, so this final pass is complete
+    while (drainRings() > 0) {}
+}
+
+size_t Logger::drainRings() {
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        writer_rings_.clear();
+        for (auto& ring : rings_) writer_rings_.push_back(ring.get());
+    }
+
+    size_t written = 0;
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    for (LogRing* ring : writer_rings_) {
+        while (LogRecord* record = ring->front()) {
+            writeRecord(*record);
+            ring->pop();
+            ++written;
+        }
+    }
+
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != dropped_reported_) {
+        emit(LogLevel::WARN, "Dropped " + std::to_string(dropped - dropped_reported_) +
+             " log records (producer ring full)", "Logger", std::chrono::system_clock::now());
+        dropped_reported_ = dropped;
+        ++written;
+    }
+
+    if (written > 0) {
+        // One flush per batch instead of per line
+        if (config_.console_output) std::cout.flush();
+        if (file_stream_ && file_stream_->is_open()) file_stream_->flush();
+    }
+    return written;
+}
+
+void Logger::writeRecord(const LogRecord& record) {
+    std::string message;
+    if (record.format) {
+        appendLogFormat(message, record.format, record.args, record.arg_count);
+    } else {
+        message.assign(record.text, record.message_length);
+    }
+    std::string context(record.text + record.message_length, record.context_length);
+    auto when = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(record.timestamp_ns)));
+    emit(record.level, message, context, when);
+}
+
+void Logger::emit(LogLevel level, const std::string& message, const std::string& context,
+                  std::chrono::system_clock::time_point when) {
+    std::string formatted_message;
+    if (config_.json_format) {
+        formatted_message = formatJsonMessage(level, message, context, when);
+    } else {
+        formatted_message = formatMessage(level, message, context, when);
+    }
+    
+    if (config_.console_output) {
+        writeToConsole(formatted_message);
+    }
+    
     if (file_stream_ && file_stream_->is_open()) {
-        file_stream_->close();
+        writeToFile(formatted_message);
+    }
+}
+
+void Logger::flush() {
+    if (async_.load(std::memory_order_acquire)) {
+        while (true) {
+            bool pending = false;
+            {
+                std::lock_guard<std::mutex> lock(rings_mutex_);
+                for (auto& ring : rings_) {
+                    if (!ring->empty()) { pending = true; break; }
+                }
+            }
+            if (!pending) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
     }
+    // Wait out a batch the writer may still be writing
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    if (config_.console_output) std::cout.flush();
+    if (file_stream_ && file_stream_->is_open()) file_stream_->flush();
 }
 
 void Logger::loadConfiguration(std::shared_ptr<Config> config) {
@@ -48,19 +254,17 @@ void Logger::loadConfiguration(std::shared_ptr<Config> config) {
     config_.max_file_size = config->getInt("logging", "max_file_size", 100 * 1024 * 1024);
     config_.max_files = config->getInt("logging", "max_files", 5);
     
+    config_.async = config->getBool("logging", "async", config_.async);
+    config_.ring_capacity = static_cast<size_t>(
+        config->getInt("logging", "ring_capacity", static_cast<int>(config_.ring_capacity)));
+    
     // Parse log level
     std::string level_str = config->getString("logging", "level", "info");
     config_.min_level = parseLogLevel(level_str);
+    min_level_.store(config_.min_level, std::memory_order_relaxed);
     
     // Initialize file stream
-    if (!config_.filename.empty()) {
-        file_stream_ = std::make_unique<std::ofstream>(config_.filename, std::ios::app);
-        if (file_stream_->is_open()) {
-            // Get current file size
-            file_stream_->seekp(0, std::ios::end);
-            current_file_size_ = file_stream_->tellp();
-        }
-    }
+    openLogFile();
 }
 
 LogLevel Logger::parseLogLevel(const std::string& level_str) {
@@ -80,22 +284,53 @@ void Logger::log(LogLevel level, const std::string& message, const std::string&
         return;
     }
     
-    std::lock_guard<std::mutex> lock(log_mutex_);
-    
-    std::string formatted_message;
-    if (config_.json_format) {
-        formatted_message = formatJsonMessage(level, message, context);
-    } else {
-        formatted_message = formatMessage(level, message, context);
+    if (async_.load(std::memory_order_acquire)) {
+        LogRecord* record = beginRecord(level);
+        if (!record) {
+            return;
+        }
+        record->message_length = static_cast<uint16_t>(record->append(message.data(), message.size()));
+        record->context_length = static_cast<uint16_t>(record->append(context.data(), context.size()));
+        threadRing()->publish();
+        return;
     }
     
-    if (config_.console_output) {
-        writeToConsole(formatted_message);
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    emit(level, message, context, std::chrono::system_clock::now());
+    if (config_.console_output) std::cout.flush();
+    if (file_stream_ && file_stream_->is_open()) file_stream_->flush();
+}
+
+void Logger::logFormat(LogLevel level, const char* context, const char* format,
+                       const LogArg* args, size_t count) {
+    if (!shouldLog(level)) {
+        return;
+    }
+    if (!async_.load(std::memory_order_acquire)) {
+        ILogger::logFormat(level, context, format, args, count);
+        return;
     }
     
-    if (file_stream_ && file_stream_->is_open()) {
-        writeToFile(formatted_message);
+    LogRecord* record = beginRecord(level);
+    if (!record) {
+        return;
+    }
+    // Keep the format pointer as the format ID; copy only argument values
+    record->format = format;
+    record->arg_count = static_cast<uint8_t>(std::min(count, MaxRecordArgs));
+    for (size_t i = 0; i < record->arg_count; ++i) {
+        record->args[i] = args[i];
+        if (args[i].type == LogArg::Type::Str) {
+            char* dest = record->text + record->text_used;
+            record->args[i].length = static_cast<uint32_t>(record->append(args[i].s, args[i].length));
+            record->args[i].s = dest;
+        }
+    }
+    record->message_length = record->text_used;
+    if (context) {
+        record->context_length = static_cast<uint16_t>(record->append(context, std::strlen(context)));
     }
+    threadRing()->publish();
 }
 
 void Logger::debug(const std::string& message, const std::string& context) {
@@ -207,10 +442,10 @@ void Logger::logMemoryUsage(const std::string& component, size_t bytes_used, siz
 void Logger::setLogLevel(LogLevel level) {
     std::lock_guard<std::mutex> lock(log_mutex_);
     config_.min_level = level;
+    min_level_.store(level, std::memory_order_relaxed);
 }
 
 bool Logger::isLogLevelEnabled(LogLevel level) {
-    std::lock_guard<std::mutex> lock(log_mutex_);
     return shouldLog(level);
 }
 
@@ -228,8 +463,14 @@ std::shared_ptr<Logger> Logger::getGlobalLogger() {
 }
 
 void Logger::setConfig(const LogConfig& config) {
+    // Ring sizing and the writer are fixed at construction; async is not toggled here
     std::lock_guard<std::mutex> lock(log_mutex_);
+    bool async = config_.async;
+    size_t ring_capacity = config_.ring_capacity;
     config_ = config;
+    config_.async = async;
+    config_.ring_capacity = ring_capacity;
+    min_level_.store(config_.min_level, std::memory_order_relaxed);
 }
 
 const Logger::LogConfig& Logger::getConfig() const {
@@ -241,8 +482,7 @@ void Logger::writeToFile(const std::string& formatted_message) {
         return;
     }
     
-    *file_stream_ << formatted_message << std::endl;
-    file_stream_->flush();
+    *file_stream_ << formatted_message << '\n';
     
     current_file_size_ += formatted_message.length() + 1; // +1 for newline
     
@@ -252,11 +492,11 @@ void Logger::writeToFile(const std::string& formatted_message) {
 }
 
 void Logger::writeToConsole(const std::string& formatted_message) {
-    std::cout << formatted_message << std::endl;
+    std::cout << formatted_message << '\n';
 }
 
-std::string Logger::formatMessage(LogLevel level, const std::string& message, const std::string& context) {
-    auto now = std::chrono::system_clock::now();
+std::string Logger::formatMessage(LogLevel level, const std::string& message, const std::string& context,
+                                  std::chrono::system_clock::time_point now) {
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
@@ -274,8 +514,8 @@ std::string Logger::formatMessage(LogLevel level, const std::string& message, co
     return oss.str();
 }
 
-std::string Logger::formatJsonMessage(LogLevel level, const std::string& message, const std::string& context) {
-    auto now = std::chrono::system_clock::now();
+std::string Logger::formatJsonMessage(LogLevel level, const std::string& message, const std::string& context,
+                                      std::chrono::system_clock::time_point now) {
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
@@ -337,7 +577,7 @@ void Logger::rotateLogFile() {
 }
 
 bool Logger::shouldLog(LogLevel level) const {
-    return level >= config_.min_level;
+    return level >= min_level_.load(std::memory_order_relaxed);
 }
 
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include "orderbook/Utilities/PerformanceTest.hpp"
 #include "orderbook/Utilities/PerformanceMeasurement.hpp"
 #include "orderbook/Utilities/MemoryManager.hpp"
 #include "orderbook/Core/OrderBook.hpp"
@@ -5,6 +6,9 @@
 #include "orderbook/Risk/RiskManager.hpp"
 #include "orderbook/MarketData/MarketDataFeed.hpp"
 #include "orderbook/Utilities/Logger.hpp"
+#include "orderbook/Utilities/TscClock.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <random>
 #include <thread>
@@ -13,43 +17,6 @@
 
 namespace orderbook {
 
-class PerformanceTest {
-public:
-    struct TestConfig {
-        size_t num_orders = 1000000;
-        size_t num_threads = 1;
-        double buy_sell_ratio = 0.5;
-        Price min_price = 100.0;
-        Price max_price = 200.0;
-        Quantity min_quantity = 100;
-        Quantity max_quantity = 1000;
-        bool enable_risk_management = true;
-        bool enable_market_data = true;
-        std::string symbol = "AAPL";
-    };
-
-    struct TestResults {
-        std::unordered_map<std::string, orderbook::PerformanceMeasurement::OperationStats> operation_stats;
-        std::vector<PerformanceValidator::ValidationResult> validation_results;
-        MemoryManager::MemoryStats memory_stats;
-        std::chrono::milliseconds total_test_time{0};
-        size_t orders_processed = 0;
-        size_t trades_executed = 0;
-        bool all_validations_passed = true;
-    };
-
-    static TestResults runPerformanceTest(const TestConfig& config);
-    static TestResults runPerformanceTest();
-
-    static void printResults(const TestResults& results);
-    static void runLatencyBenchmark();
-    static void runThroughputStressTest(size_t target_ops_per_sec, int duration_seconds);
-
-private:
-    static TestResults runSingleThreadedTest(OrderBook& order_book, const TestConfig& config);
-    static TestResults runMultiThreadedTest(OrderBook& order_book, const TestConfig& config);
-};
-
 // Definitions
 PerformanceTest::TestResults PerformanceTest::runPerformanceTest(const TestConfig& config) {
     std::cout << "Starting performance test with " << config.num_orders 
@@ -207,28 +174,192 @@ void PerformanceTest::runLatencyBenchmark() {
     std::cout << "Latency benchmarks completed.\n";
 }
 
-void PerformanceTest::runThroughputStressTest(size_t /*target_ops_per_sec*/, int duration_seconds) {
-    std::cout << "Starting throughput stress test for " << duration_seconds << " seconds...\n";
+void PerformanceTest::runThroughputStressTest(size_t target_ops_per_sec, int duration_seconds) {
+    OpenLoopConfig config;
+    config.rate = static_cast<double>(target_ops_per_sec);
+    config.duration_seconds = duration_seconds;
+    auto results = runOpenLoopTest(config);
+    printOpenLoopResults(config, *results);
+}
+
+namespace {
+
+uint64_t histogramPercentile(const PerformanceMeasurement::Histogram& h, uint64_t count, double q) {
+    if (count == 0) return 0;
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < PerformanceMeasurement::Histogram::BucketCount; ++i) {
+        seen += h.bucket(i);
+        if (seen >= target) return std::min(PerformanceMeasurement::Histogram::valueFor(i), h.max());
+    }
+    return h.max();
+}
+
+}
 
-    std::atomic<bool> running{true};
-    std::atomic<size_t> operations{0};
+std::unique_ptr<PerformanceTest::OpenLoopResults> PerformanceTest::runOpenLoopTest(const OpenLoopConfig& config) {
+    auto results = std::make_unique<OpenLoopResults>();
+    TscClock::calibrate();
 
-    auto worker = [&running, &operations]() {
-        while (running.load()) {
-            operations.fetch_add(1, std::memory_order_relaxed);
+    Logger::LogConfig log_config;
+    log_config.console_output = false;
+    // Cancels racing fills are expected here; keep them out of the log
+    log_config.min_level = LogLevel::ERROR;
+    auto logger = std::make_shared<Logger>(log_config);
+    auto risk_manager = config.enable_risk_management ? std::make_shared<RiskManager>(logger) : nullptr;
+    auto market_data = config.enable_market_data ? std::make_shared<MarketDataPublisher>(logger) : nullptr;
+
+    OrderBook book(risk_manager, market_data, logger);
+    auto registered = book.registerProducer();
+    if (registered.isError()) {
+        std::cerr << "Open-loop test: " << registered.error() << "\n";
+        return results;
+    }
+    OrderBook::Producer producer = registered.moveValue();
+    MemoryManager::getInstance().prewarmPools();
+
+    const uint64_t total = config.rate > 0 && config.duration_seconds > 0
+        ? static_cast<uint64_t>(config.rate * config.duration_seconds) : 0;
+    const double ticks_per_ns = TscClock::ticksPerNs();
+    const double period_ns = total ? 1e9 / config.rate : 0.0;
+    const auto yield_margin = static_cast<TscClock::Ticks>(50000 * ticks_per_ns);
+    const auto late_margin = static_cast<TscClock::Ticks>(1000 * ticks_per_ns);
+
+    std::mt19937_64 rng(config.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::exponential_distribution<double> gap(1.0);
+    std::normal_distribution<double> distance(0.0, config.price_sigma_ticks);
+    std::uniform_int_distribution<uint64_t> qty_dist(config.min_quantity, config.max_quantity);
+    std::uniform_int_distribution<int> through(1, 5);
+
+    Price mid = book.getPriceScale().toTicks(config.mid_price);
+    auto passivePrice = [&](Side side) {
+        auto away = static_cast<Price>(1 + std::llround(std::fabs(distance(rng))));
+        return side == Side::Buy ? std::max<Price>(1, mid - away) : mid + away;
+    };
+
+    struct LiveOrder {
+        OrderId id;
+        Side side;
+    };
+    std::vector<LiveOrder> live;
+    live.reserve(1 << 16);
+    uint64_t next_id = 1;
+
+    // Intended send time of every request that entered the ring; the ring is FIFO,
+    // so the k-th applied request is the k-th entry here
+    std::vector<TscClock::Ticks> intended;
+    intended.reserve(static_cast<size_t>(total));
+    const uint64_t applied_base = producer.appliedCount();
+    size_t acked = 0;
+    auto collectAcks = [&](TscClock::Ticks now) {
+        uint64_t applied = producer.appliedCount() - applied_base;
+        for (; acked < applied; ++acked) {
+            results->latency.record(TscClock::toNanos(now - intended[acked]));
         }
     };
 
-    std::vector<std::thread> workers;
-    size_t thread_count = std::thread::hardware_concurrency();
-    for (size_t i = 0; i < thread_count; ++i) workers.emplace_back(worker);
+    const TscClock::Ticks start = TscClock::now();
+    double offset_ns = 0.0;
+    for (uint64_t i = 0; i < total; ++i) {
+        // The schedule never waits on the system under test: a stalled book makes
+        // later requests late, and their latency counts from when they were due
+        offset_ns += config.poisson ? gap(rng) * period_ns : period_ns;
+        const TscClock::Ticks due = start + static_cast<TscClock::Ticks>(offset_ns * ticks_per_ns);
+        TscClock::Ticks now = TscClock::now();
+        while (now < due) {
+            collectAcks(now);
+            if (due - now > yield_margin) std::this_thread::yield();
+            now = TscClock::now();
+        }
+        if (now - due > late_margin) ++results->late_sends;
+        results->max_send_lag_ns = std::max(results->max_send_lag_ns, TscClock::toNanos(now - due));
 
-    std::this_thread::sleep_for(std::chrono::seconds(duration_seconds));
-    running.store(false);
-    for (auto& t : workers) if (t.joinable()) t.join();
+        if (unit(rng) < config.mid_drift_ratio) {
+            mid = std::max<Price>(2, mid + (unit(rng) < 0.5 ? -1 : 1));
+        }
+        double pick = unit(rng);
+        bool accepted;
+        if (!live.empty() && pick < config.cancel_ratio) {
+            size_t slot = static_cast<size_t>(unit(rng) * static_cast<double>(live.size())) % live.size();
+            OrderId id = live[slot].id;
+            live[slot] = live.back();
+            live.pop_back();
+            accepted = producer.cancelOrder(id).isSuccess();
+            ++results->cancels;
+        } else if (!live.empty() && pick < config.cancel_ratio + config.modify_ratio) {
+            const LiveOrder& target = live[static_cast<size_t>(unit(rng) * static_cast<double>(live.size())) % live.size()];
+            accepted = producer.modifyOrder(target.id, passivePrice(target.side), static_cast<Quantity>(qty_dist(rng))).isSuccess();
+            ++results->modifies;
+        } else {
+            Side side = unit(rng) < 0.5 ? Side::Buy : Side::Sell;
+            Price price;
+            if (unit(rng) < config.marketable_ratio) {
+                Price cross = through(rng);
+                price = side == Side::Buy ? mid + cross : std::max<Price>(1, mid - cross);
+            } else {
+                price = passivePrice(side);
+            }
+            Order order(next_id++, side, OrderType::Limit, price, static_cast<Quantity>(qty_dist(rng)), config.symbol.c_str());
+            accepted = producer.addOrder(order).isSuccess();
+            if (accepted) live.push_back({order.id, side});
+            ++results->adds;
+        }
+        ++results->scheduled;
+        if (accepted) {
+            intended.push_back(due);
+        } else {
+            // A refusal is the response; it is as late as the send was
+            ++results->refused;
+            results->latency.record(TscClock::toNanos(TscClock::now() - due));
+        }
+    }
+
+    // Drain what is still in flight, bounded so a wedged consumer cannot hang the run
+    const TscClock::Ticks deadline = TscClock::now() + static_cast<TscClock::Ticks>(10e9 * ticks_per_ns);
+    TscClock::Ticks now = TscClock::now();
+    while (acked < intended.size() && now < deadline) {
+        collectAcks(now);
+        std::this_thread::yield();
+        now = TscClock::now();
+    }
+    collectAcks(TscClock::now());
+
+    results->elapsed_seconds = static_cast<double>(TscClock::toNanos(TscClock::now() - start)) / 1e9;
+    results->acknowledged = acked;
+    results->trades = book.getTradeCount();
+    return results;
+}
 
-    auto ops_per_sec = operations.load() / static_cast<double>(duration_seconds);
-    std::cout << "Throughput: " << ops_per_sec << " ops/sec\n";
+void PerformanceTest::printOpenLoopResults(const OpenLoopConfig& config, const OpenLoopResults& results) {
+    const uint64_t count = results.acknowledged + results.refused;
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "OPEN-LOOP LOAD RESULTS\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "Schedule: " << std::fixed << std::setprecision(0) << config.rate << " req/s "
+              << (config.poisson ? "Poisson" : "constant") << " for " << std::setprecision(1)
+              << config.duration_seconds << " s\n";
+    std::cout << "Scheduled: " << results.scheduled << " (adds " << results.adds << ", cancels "
+              << results.cancels << ", modifies " << results.modifies << ")\n";
+    std::cout << "Acknowledged: " << results.acknowledged << ", refused: " << results.refused
+              << ", unacknowledged: " << (results.scheduled - count) << "\n";
+    std::cout << "Trades Executed: " << results.trades << "\n";
+    std::cout << "Achieved Rate: " << std::setprecision(0)
+              << (results.elapsed_seconds > 0 ? static_cast<double>(count) / results.elapsed_seconds : 0.0) << " req/s\n";
+    std::cout << "Late Sends (>1 us behind schedule): " << results.late_sends
+              << ", max lag " << std::setprecision(1) << (results.max_send_lag_ns / 1000.0) << " us\n\n";
+
+    std::cout << "LATENCY FROM INTENDED SEND TIME (us)\n";
+    std::cout << std::string(80, '-') << "\n";
+    const std::pair<const char*, double> quantiles[] = {
+        {"p50", 0.50}, {"p90", 0.90}, {"p99", 0.99}, {"p99.9", 0.999}, {"p99.99", 0.9999}};
+    for (const auto& [label, q] : quantiles) {
+        std::cout << std::left << std::setw(10) << label << std::right << std::setw(14) << std::setprecision(2)
+                  << (histogramPercentile(results.latency, count, q) / 1000.0) << "\n";
+    }
+    std::cout << std::left << std::setw(10) << "max" << std::right << std::setw(14)
+              << (count ? results.latency.max() / 1000.0 : 0.0) << "\n";
+    std::cout << std::left;
 }
 
 PerformanceTest::TestResults PerformanceTest::runSingleThreadedTest(OrderBook& order_book, const TestConfig& config) {
@@ -239,7 +370,7 @@ PerformanceTest::TestResults PerformanceTest::runSingleThreadedTest(OrderBook& o
     std::uniform_real_distribution<double> side_dist(0.0, 1.0);
     uint64_t next_id = 1;
     for (size_t i = 0; i < config.num_orders; ++i) {
-        Price price = std::round(price_dist(rng) * 100.0) / 100.0;
+        Price price = order_book.getPriceScale().toTicks(price_dist(rng));
         Quantity qty = static_cast<Quantity>(qty_dist(rng));
         Side side = (side_dist(rng) < config.buy_sell_ratio) ? Side::Buy : Side::Sell;
             Order order(next_id++, side, OrderType::Limit, price, qty, config.symbol.c_str());
@@ -269,7 +400,7 @@ PerformanceTest::TestResults PerformanceTest::runMultiThreadedTest(OrderBook& or
         std::uniform_int_distribution<uint64_t> qty_dist(config.min_quantity, config.max_quantity);
         std::uniform_real_distribution<double> side_dist(0.0, 1.0);
         for (size_t i = 0; i < config.num_orders / config.num_threads; ++i) {
-            Price price = std::round(price_dist(rng) * 100.0) / 100.0;
+            Price price = order_book.getPriceScale().toTicks(price_dist(rng));
             Quantity qty = static_cast<Quantity>(qty_dist(rng));
             Side side = (side_dist(rng) < config.buy_sell_ratio) ? Side::Buy : Side::Sell;
             uint64_t id = next_id.fetch_add(1);
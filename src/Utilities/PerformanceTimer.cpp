@@ -7,7 +7,7 @@ PerformanceTimer::PerformanceTimer(const std::string& operation_name,
                                  std::shared_ptr<ILogger> logger)
     : operation_name_(operation_name)
     , logger_(logger)
-    , start_time_(std::chrono::high_resolution_clock::now())
+    , start_ticks_(TscClock::now())
     , logged_(false) {
 }
 
@@ -18,9 +18,7 @@ PerformanceTimer::~PerformanceTimer() {
 }
 
 uint64_t PerformanceTimer::getElapsedNs() const {
-    auto end_time = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(
-        end_time - start_time_).count();
+    return static_cast<uint64_t>(TscClock::elapsed(start_ticks_, TscClock::now()).count());
 }
 
 void PerformanceTimer::stopAndLog() {
@@ -1,12 +1,17 @@
 #include "orderbook/Core/OrderBook.hpp"
 #include "orderbook/Core/Order.hpp"
+#include "orderbook/Core/SymbolMaster.hpp"
 #include "orderbook/Risk/RiskManager.hpp"
 #include "orderbook/MarketData/MarketDataFeed.hpp"
 #ifdef WITH_QUICKFIX
 #include "orderbook/MarketData/QuickFixConnector.hpp"
 #endif
+#include "orderbook/MarketData/ShmMarketData.hpp"
+#include "orderbook/MarketData/MulticastFeed.hpp"
 #include "orderbook/Utilities/Logger.hpp"
 #include "orderbook/Utilities/Config.hpp"
+#include "orderbook/Utilities/TscClock.hpp"
+#include "orderbook/Utilities/LatencyTracer.hpp"
 #include "orderbook/Network/WsServer.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
@@ -15,6 +20,8 @@
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <fstream>
 
 using namespace orderbook;
 using json = nlohmann::json;
@@ -22,34 +29,45 @@ using json = nlohmann::json;
 // WebSocket Bridge for Market Data
 class WsMarketDataBridge : public IMarketDataSubscriber {
 public:
-    explicit WsMarketDataBridge(std::shared_ptr<WsServer> server) 
-        : server_(std::move(server)) {}
+    WsMarketDataBridge(std::shared_ptr<WsServer> server, PriceScale price_scale) 
+        : server_(std::move(server)), price_scale_(price_scale) {}
 
-    void onTrade(const Trade& trade, SequenceNumber sequence) override {
-        server_->updateLastTrade(trade.price, trade.quantity);
+    void onTrade(const Trade& trade, SequenceNumber /*sequence*/) override {
+        server_->updateLastTrade(price_scale_.toDouble(trade.price), trade.quantity);
     }
 
-    void onBookUpdate(const BookUpdate& update) override {
+    void onBookUpdate(const BookUpdate& /*update*/) override {
         // For high-frequency updates, we rely on onBestPrices for the snapshot.
         // Individual book updates are too frequent to broadcast directly in this mode.
     }
 
-    void onBestPrices(const BestPrices& prices, SequenceNumber sequence) override {
-        double bid = prices.bid.value_or(0.0);
+    void onBestPrices(const BestPrices& prices, SequenceNumber /*sequence*/) override {
+        double bid = prices.bid ? price_scale_.toDouble(*prices.bid) : 0.0;
         double bidQty = prices.bid_size.value_or(0.0);
-        double ask = prices.ask.value_or(0.0);
+        double ask = prices.ask ? price_scale_.toDouble(*prices.ask) : 0.0;
         double askQty = prices.ask_size.value_or(0.0);
         
         server_->updateTopOfBook(bid, bidQty, ask, askQty);
     }
 
-    void onDepth(const MarketDepth& depth, SequenceNumber sequence) override {
-        // Optional: Implement if full depth is needed on frontend
-        // For high-frequency, full depth might be too heavy to broadcast constantly
+    void onDepth(const MarketDepth& depth, SequenceNumber /*sequence*/) override {
+        // The server conflates and diffs; only changed levels go over the wire
+        bids_.clear();
+        asks_.clear();
+        for (const auto& level : depth.bids) {
+            bids_.push_back(WsDepthLevel{price_scale_.toDouble(level.price), static_cast<double>(level.quantity)});
+        }
+        for (const auto& level : depth.asks) {
+            asks_.push_back(WsDepthLevel{price_scale_.toDouble(level.price), static_cast<double>(level.quantity)});
+        }
+        server_->updateDepth(bids_, asks_);
     }
 
 private:
     std::shared_ptr<WsServer> server_;
+    PriceScale price_scale_;
+    std::vector<WsDepthLevel> bids_;
+    std::vector<WsDepthLevel> asks_;
 };
 
 // Forward declaration for demo mode
@@ -69,12 +87,18 @@ void runDemoMode(OrderBook& book, Logger& logger) {
     uint64_t max_latency_ns = 0;
     uint64_t min_latency_ns = UINT64_MAX;
     
+    // Demo prices are quoted in decimal and converted to book ticks
+    const PriceScale& scale = book.getPriceScale();
+    auto formatPrice = [&scale](const std::optional<Price>& ticks) {
+        return ticks ? std::to_string(scale.toDouble(*ticks)) : std::string("None");
+    };
+    
     // Demo scenario data
-    std::vector<std::pair<Price, Quantity>> buy_orders = {
+    std::vector<std::pair<double, Quantity>> buy_orders = {
         {99.50, 1000}, {99.25, 1500}, {99.00, 2000}, {98.75, 1200}, {98.50, 800}
     };
     
-    std::vector<std::pair<Price, Quantity>> sell_orders = {
+    std::vector<std::pair<double, Quantity>> sell_orders = {
         {100.50, 800}, {100.75, 1200}, {101.00, 1800}, {101.25, 1000}, {101.50, 1500}
     };
     
@@ -89,7 +113,7 @@ void runDemoMode(OrderBook& book, Logger& logger) {
         auto op_start = std::chrono::high_resolution_clock::now();
         
         Order buy_order(next_order_id.value, Side::Buy, OrderType::Limit, TimeInForce::GTC,
-                       buy_orders[i].first, buy_orders[i].second, "BTC/USD", "demo_account");
+                       scale.toTicks(buy_orders[i].first), buy_orders[i].second, "BTC/USD", "demo_account");
         
         auto result = book.addOrder(buy_order);
         
@@ -120,7 +144,7 @@ void runDemoMode(OrderBook& book, Logger& logger) {
         auto op_start = std::chrono::high_resolution_clock::now();
         
         Order sell_order(next_order_id.value, Side::Sell, OrderType::Limit, TimeInForce::GTC,
-                        sell_orders[i].first, sell_orders[i].second, "BTC/USD", "demo_account");
+                        scale.toTicks(sell_orders[i].first), sell_orders[i].second, "BTC/USD", "demo_account");
         
         auto result = book.addOrder(sell_order);
         
@@ -149,8 +173,8 @@ void runDemoMode(OrderBook& book, Logger& logger) {
     std::cout << "\nCurrent Order Book State:\n";
     auto best_bid = book.bestBid();
     auto best_ask = book.bestAsk();
-    std::cout << "  Best Bid: " << (best_bid ? std::to_string(*best_bid) : "None") << "\n";
-    std::cout << "  Best Ask: " << (best_ask ? std::to_string(*best_ask) : "None") << "\n";
+    std::cout << "  Best Bid: " << formatPrice(best_bid) << "\n";
+    std::cout << "  Best Ask: " << formatPrice(best_ask) << "\n";
     std::cout << "  Total Orders: " << book.getOrderCount() << "\n";
     std::cout << "  Bid Levels: " << book.getBidLevelCount() << "\n";
     std::cout << "  Ask Levels: " << book.getAskLevelCount() << "\n";
@@ -159,7 +183,7 @@ void runDemoMode(OrderBook& book, Logger& logger) {
     std::cout << "\nPhase 2: Executing matching trades...\n";
     
     // Add aggressive orders that will match
-    std::vector<std::pair<Side, std::pair<Price, Quantity>>> aggressive_orders = {
+    std::vector<std::pair<Side, std::pair<double, Quantity>>> aggressive_orders = {
         {Side::Buy, {100.75, 500}},   // Should match with sell at 100.50
         {Side::Sell, {99.25, 300}},   // Should match with buy at 99.50
         {Side::Buy, {101.00, 800}},   // Should match multiple sell levels
@@ -172,7 +196,7 @@ void runDemoMode(OrderBook& book, Logger& logger) {
         auto op_start = std::chrono::high_resolution_clock::now();
         
         Order aggressive_order(next_order_id.value, order_spec.first, OrderType::Limit, TimeInForce::GTC,
-                              order_spec.second.first, order_spec.second.second, "BTC/USD", "demo_account");
+                              scale.toTicks(order_spec.second.first), order_spec.second.second, "BTC/USD", "demo_account");
         
         auto result = book.addOrder(aggressive_order);
         
@@ -198,8 +222,8 @@ void runDemoMode(OrderBook& book, Logger& logger) {
         // Display updated book state
         auto new_best_bid = book.bestBid();
         auto new_best_ask = book.bestAsk();
-        std::cout << "    New Best Bid: " << (new_best_bid ? std::to_string(*new_best_bid) : "None") 
-                  << ", Best Ask: " << (new_best_ask ? std::to_string(*new_best_ask) : "None") << "\n";
+        std::cout << "    New Best Bid: " << formatPrice(new_best_bid) 
+                  << ", Best Ask: " << formatPrice(new_best_ask) << "\n";
         
         next_order_id = OrderId(next_order_id.value + 1);
         std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -213,7 +237,7 @@ void runDemoMode(OrderBook& book, Logger& logger) {
         auto op_start = std::chrono::high_resolution_clock::now();
         
         OrderId order_id(id);
-        auto result = book.modifyOrder(order_id, 99.75, 750);  // New price and quantity
+        auto result = book.modifyOrder(order_id, scale.toTicks(99.75), 750);  // New price and quantity
         
         auto op_end = std::chrono::high_resolution_clock::now();
         auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - op_start).count();
@@ -263,8 +287,8 @@ void runDemoMode(OrderBook& book, Logger& logger) {
     std::cout << "\n=== Final Order Book State ===\n";
     auto final_best_bid = book.bestBid();
     auto final_best_ask = book.bestAsk();
-    std::cout << "Best Bid: " << (final_best_bid ? std::to_string(*final_best_bid) : "None") << "\n";
-    std::cout << "Best Ask: " << (final_best_ask ? std::to_string(*final_best_ask) : "None") << "\n";
+    std::cout << "Best Bid: " << formatPrice(final_best_bid) << "\n";
+    std::cout << "Best Ask: " << formatPrice(final_best_ask) << "\n";
     std::cout << "Total Orders: " << book.getOrderCount() << "\n";
     std::cout << "Bid Levels: " << book.getBidLevelCount() << "\n";
     std::cout << "Ask Levels: " << book.getAskLevelCount() << "\n";
@@ -361,6 +385,9 @@ int main(int argc, char* argv[]) {
     }
     
     try {
+        // Measure the cycle-counter rate before anything stamps or exports times
+        TscClock::calibrate();
+
         // Initialize configuration
         std::cout << "Loading configuration from: " << app_config.config_file << "\n";
         auto config = std::make_shared<Config>(app_config.config_file);
@@ -379,31 +406,200 @@ int main(int argc, char* argv[]) {
         
         logger->info("OrderBook application starting", "main");
         
+        // Optional binary symbol master: instrument metadata is mapped, not parsed
+        SymbolMasterPtr symbol_master;
+        std::string symbol_master_path = config->getString("orderbook", "symbol_master", "");
+        if (!symbol_master_path.empty()) {
+            auto master = SymbolMaster::open(symbol_master_path);
+            if (master.isError()) {
+                logger->error("Symbol master not loaded: " + master.error(), "main");
+            } else {
+                symbol_master = std::shared_ptr<const SymbolMaster>(std::move(master.value()));
+                logger->info("Symbol master " + symbol_master_path + " maps " +
+                             std::to_string(symbol_master->size()) + " symbols", "main");
+            }
+        }
+        
         // Initialize risk manager
         auto risk_manager = std::make_shared<RiskManager>(config, logger);
+        risk_manager->setSymbolMaster(symbol_master);
         logger->info("Risk manager initialized", "main");
         
         // Initialize market data publisher
-        auto market_data = std::make_shared<MarketDataPublisher>(logger);
+        MarketDataPublisherOptions market_data_options;
+        market_data_options.async = config->getBool("marketdata", "async_publish", true);
+        market_data_options.journal_capacity = static_cast<size_t>(
+            config->getInt("marketdata", "journal_capacity", static_cast<int>(market_data_options.journal_capacity)));
+        auto market_data = std::make_shared<MarketDataPublisher>(logger, market_data_options);
         logger->info("Market data publisher initialized", "main");
         
+        // Instrument tick size shared by the book and the protocol edges; a symbol
+        // master entry for the book's symbol overrides tick_size
+        std::string book_symbol_name = config->getString("orderbook", "symbol", "BTC/USD");
+        PriceScale price_scale(config->getDouble("orderbook", "tick_size", PriceScale().tick_size));
+        if (const SymbolMasterEntry* entry = symbol_master ? symbol_master->find(book_symbol_name) : nullptr) {
+            price_scale = entry->priceScale();
+        }
+        
         // Initialize WebSocket Server
-        auto ws_server = std::make_shared<WsServer>();
+        WsServerOptions ws_options;
+        ws_options.io_threads = static_cast<size_t>(std::max(0, config->getInt("network", "io_threads", 1)));
+        ws_options.max_queued_messages = static_cast<size_t>(std::max(1,
+            config->getInt("websocket", "max_queued_messages", static_cast<int>(ws_options.max_queued_messages))));
+        ws_options.max_lagged_updates = static_cast<size_t>(std::max(0,
+            config->getInt("websocket", "max_lagged_updates", static_cast<int>(ws_options.max_lagged_updates))));
+        ws_options.permessage_deflate = config->getBool("websocket", "permessage_deflate", false);
+        ws_options.min_interval_ms = static_cast<uint32_t>(std::max(0,
+            config->getInt("websocket", "min_interval_ms", static_cast<int>(ws_options.min_interval_ms))));
+        ws_options.depth_levels = static_cast<size_t>(std::max(0,
+            config->getInt("websocket", "depth_levels", static_cast<int>(ws_options.depth_levels))));
+        ws_options.full_snapshot_interval = static_cast<size_t>(std::max(1,
+            config->getInt("websocket", "full_snapshot_interval", static_cast<int>(ws_options.full_snapshot_interval))));
+        ws_options.binary_frames = config->getString("websocket", "frame_format", "json") == "binary";
+        auto ws_server = std::make_shared<WsServer>(ws_options);
+        // 1-in-N order latency tracing, served as JSON at GET /stats
+        LatencyTracer::getInstance().setSampleInterval(static_cast<uint32_t>(
+            std::max(0, config->getInt("trace", "sample_interval", 0))));
+        ws_server->setHttpHandler("/stats", [] { return LatencyTracer::getInstance().statsJson(); });
         ws_server->start(8080);
         logger->info("WebSocket server started on port 8080", "main");
         
         // Initialize WebSocket Bridge
-        auto ws_bridge = std::make_shared<WsMarketDataBridge>(ws_server);
+        auto ws_bridge = std::make_shared<WsMarketDataBridge>(ws_server, price_scale);
         market_data->subscribe(ws_bridge);
         logger->info("WebSocket bridge subscribed to market data", "main");
         
         // Initialize OrderBook with all dependencies
-        OrderBook book(risk_manager, market_data, logger);
+        OrderBookOptions book_options;
+        book_options.price_scale = price_scale;
+        book_options.ladder_mode = config->getString("orderbook", "book_mode", "sorted") == "ladder";
+        book_options.ladder_levels = static_cast<size_t>(
+            config->getInt("orderbook", "ladder_levels", static_cast<int>(PriceLadder::DefaultLevels)));
+        book_options.max_orders = static_cast<size_t>(
+            config->getInt("orderbook", "max_orders", static_cast<int>(DefaultMaxOrders)));
+        book_options.huge_pages = config->getBool("orderbook", "huge_pages", false);
+        book_options.numa_bind = config->getBool("orderbook", "numa_bind", true);
+        std::string wait_name = config->getString("orderbook", "wait_strategy", "spin_park");
+        if (auto strategy = parseWaitStrategy(wait_name)) {
+            book_options.wait.strategy = *strategy;
+        } else {
+            logger->warn("Unknown wait_strategy '" + wait_name + "', using spin_park", "main");
+        }
+        book_options.wait.spin_iterations = static_cast<uint32_t>(
+            config->getInt("orderbook", "spin_iterations", static_cast<int>(book_options.wait.spin_iterations)));
+        book_options.wait.cpu_affinity = config->getInt("orderbook", "consumer_cpu", -1);
+        std::string backpressure_name = config->getString("orderbook", "backpressure", "spin_wait");
+        if (auto policy = parseBackpressurePolicy(backpressure_name)) {
+            book_options.backpressure = *policy;
+        } else {
+            logger->warn("Unknown backpressure '" + backpressure_name + "', using spin_wait", "main");
+        }
+        book_options.backpressure_spin_budget = static_cast<uint32_t>(
+            config->getInt("orderbook", "backpressure_spin_budget", static_cast<int>(book_options.backpressure_spin_budget)));
+        book_options.overflow_capacity = static_cast<size_t>(
+            config->getInt("orderbook", "overflow_capacity", static_cast<int>(book_options.overflow_capacity)));
+        std::string matching_name = config->getString("orderbook", "matching_mode", "continuous");
+        if (auto mode = parseMatchingMode(matching_name)) {
+            book_options.matching_mode = *mode;
+        } else {
+            logger->warn("Unknown matching_mode '" + matching_name + "', using continuous", "main");
+        }
+        book_options.auction_interval_us = static_cast<uint32_t>(
+            std::max(0, config->getInt("orderbook", "auction_interval_us", 0)));
+        // Optional shared-memory ring in front of the in-process publisher, forwarding
+        // every event to it. The multicast feed hangs off the publisher's subscribers
+        // instead, so with async_publish its lock and sendto stay off the matching thread.
+        MarketDataPublisherPtr book_market_data = market_data;
+        std::shared_ptr<ForwardingSubscriber> feed_forwarder;
+        SymbolId book_symbol = symbolTable().intern(book_symbol_name);
+        std::string multicast_group = config->getString("marketdata", "multicast_group", "");
+        if (!multicast_group.empty()) {
+            MulticastFeedOptions feed_options;
+            feed_options.group = multicast_group;
+            feed_options.port = static_cast<uint16_t>(config->getInt("marketdata", "multicast_port", feed_options.port));
+            feed_options.interface_address = config->getString("marketdata", "multicast_interface", feed_options.interface_address);
+            feed_options.ttl = config->getInt("marketdata", "multicast_ttl", feed_options.ttl);
+            feed_options.packet_bytes = static_cast<size_t>(std::max(0, config->getInt(
+                "marketdata", "packet_bytes", static_cast<int>(feed_options.packet_bytes))));
+            feed_options.flush_interval_us = static_cast<uint32_t>(std::max(0, config->getInt(
+                "marketdata", "packet_flush_us", static_cast<int>(feed_options.flush_interval_us))));
+            feed_options.snapshot_port = static_cast<uint16_t>(config->getInt("marketdata", "snapshot_port", 0));
+            feed_options.symbol_id = book_symbol;
+            auto feed = MulticastFeedPublisher::create(feed_options);
+            if (feed.isError()) {
+                logger->error("Multicast feed disabled: " + feed.error(), "main");
+            } else {
+                feed_forwarder = std::make_shared<ForwardingSubscriber>(
+                    std::shared_ptr<MulticastFeedPublisher>(std::move(feed.value())));
+                market_data->subscribe(feed_forwarder);
+                logger->info("Multicast feed on " + multicast_group + ":" + std::to_string(feed_options.port), "main");
+            }
+        }
+        std::string shm_name = config->getString("marketdata", "shm_name", "");
+        if (!shm_name.empty()) {
+            ShmMarketDataOptions shm_options;
+            shm_options.name = shm_name;
+            shm_options.capacity = static_cast<size_t>(std::max(2, config->getInt(
+                "marketdata", "shm_capacity", static_cast<int>(shm_options.capacity))));
+            shm_options.symbol_id = book_symbol;
+            auto shm = ShmMarketDataPublisher::create(shm_options, book_market_data);
+            if (shm.isError()) {
+                logger->error("Shared memory market data disabled: " + shm.error(), "main");
+            } else {
+                book_market_data = std::shared_ptr<ShmMarketDataPublisher>(std::move(shm.value()));
+                logger->info("Shared memory market data ring " + shm_name, "main");
+            }
+        }
+        OrderBook book(risk_manager, book_market_data, logger, book_options);
         logger->info("OrderBook initialized with all dependencies", "main");
+
+        // Startup state: latest snapshot, then the journal tail after it
+        std::string snapshot_path = config->getString("snapshot", "path", "");
+        if (!snapshot_path.empty() && std::ifstream(snapshot_path).good()) {
+            auto loaded = book.loadSnapshot(snapshot_path);
+            if (loaded.isError()) {
+                logger->error("Snapshot not loaded: " + loaded.error(), "main");
+            }
+        }
+
+        // Recover from and write ahead to the command journal before any order arrives
+        if (config->getBool("journal", "enabled", false)) {
+            CommandJournalOptions journal_options;
+            journal_options.directory = config->getString("journal", "directory", "journal");
+            journal_options.segment_bytes = static_cast<size_t>(
+                std::max(1, config->getInt("journal", "segment_mb", 64))) << 20;
+            journal_options.sync_interval_us = static_cast<uint32_t>(
+                std::max(1, config->getInt("journal", "sync_interval_us", static_cast<int>(journal_options.sync_interval_us))));
+            journal_options.recover = config->getBool("journal", "recover", true);
+            auto journal = book.openJournal(journal_options);
+            if (journal.isError()) {
+                logger->error("Command journal disabled: " + journal.error(), "main");
+            }
+        }
+
+
+        // Periodic snapshots; each one also drops the journal segments it covers
+        std::atomic<bool> snapshots_running{false};
+        std::thread snapshot_thread;
+        int snapshot_interval_s = config->getInt("snapshot", "interval_s", 0);
+        if (!snapshot_path.empty() && snapshot_interval_s > 0) {
+            snapshots_running = true;
+            snapshot_thread = std::thread([&book, &snapshots_running, snapshot_path, snapshot_interval_s]() {
+                auto next = std::chrono::steady_clock::now() + std::chrono::seconds(snapshot_interval_s);
+                while (snapshots_running.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    if (std::chrono::steady_clock::now() < next) continue;
+                    book.snapshot(snapshot_path);
+                    next = std::chrono::steady_clock::now() + std::chrono::seconds(snapshot_interval_s);
+                }
+            });
+        }
         
         // Display configuration summary
         std::cout << "\n=== OrderBook Configuration ===\n";
-        std::cout << "Symbol: " << config->getString("orderbook", "symbol", "BTC/USD") << "\n";
+        std::cout << "Symbol: " << book_symbol_name << "\n";
+        std::cout << "Tick Size: " << price_scale.tick_size << "\n";
+        std::cout << "Book Mode: " << (book.isLadderMode() ? "ladder" : "sorted") << "\n";
         std::cout << "Max Orders: " << config->getInt("orderbook", "max_orders", 1000000) << "\n";
         std::cout << "Risk Limits:\n";
         std::cout << "  Max Order Size: " << config->getInt("risk", "max_order_size", 10000) << "\n";
@@ -415,7 +611,7 @@ int main(int argc, char* argv[]) {
         // Optional QuickFIX-based market-data integration
 #ifdef WITH_QUICKFIX
         if (config->getBool("marketdata", "use_quickfix", false)) {
-            auto qfConnector = std::make_shared<QuickFixConnector>(market_data, config, logger, &book);
+            auto qfConnector = std::make_shared<QuickFixConnector>(market_data, config, logger, &book, symbol_master);
             if (!qfConnector->start()) {
                 logger->error("Failed to start QuickFIX connector", "main");
             } else {
@@ -444,9 +640,9 @@ int main(int argc, char* argv[]) {
             
             // Create test orders
             Order buy_order(1, Side::Buy, OrderType::Limit, TimeInForce::GTC,
-                           100.0, 500, "BTC/USD", "test_account");
+                           price_scale.toTicks(100.0), 500, "BTC/USD", "test_account");
             Order sell_order(2, Side::Sell, OrderType::Limit, TimeInForce::GTC,
-                            101.0, 300, "BTC/USD", "test_account");
+                            price_scale.toTicks(101.0), 300, "BTC/USD", "test_account");
             
             // Add orders
             auto result1 = book.addOrder(buy_order);
@@ -467,8 +663,8 @@ int main(int argc, char* argv[]) {
             auto best_bid = book.bestBid();
             auto best_ask = book.bestAsk();
             
-            std::cout << "Best Bid: " << (best_bid ? std::to_string(*best_bid) : "None") << "\n";
-            std::cout << "Best Ask: " << (best_ask ? std::to_string(*best_ask) : "None") << "\n";
+            std::cout << "Best Bid: " << (best_bid ? std::to_string(price_scale.toDouble(*best_bid)) : "None") << "\n";
+            std::cout << "Best Ask: " << (best_ask ? std::to_string(price_scale.toDouble(*best_ask)) : "None") << "\n";
             
             std::cout << "\nOrderBook statistics:\n";
             std::cout << "Total Orders: " << book.getOrderCount() << "\n";
@@ -480,6 +676,11 @@ int main(int argc, char* argv[]) {
         }
         
         logger->info("OrderBook application completed successfully", "main");
+
+        snapshots_running = false;
+        if (snapshot_thread.joinable()) {
+            snapshot_thread.join();
+        }
         
         // Stop WebSocket server
         ws_server->stop();
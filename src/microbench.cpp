@@ -0,0 +1,621 @@
+#include "orderbook/Core/Order.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Network/FixEncoder.hpp"
+#include "orderbook/Network/FixParser.hpp"
+#include "orderbook/Utilities/FlatHashMap.hpp"
+#include "orderbook/Utilities/LockFreeQueue.hpp"
+#include "orderbook/Utilities/MemoryAllocators.hpp"
+#include "orderbook/Utilities/MpscQueue.hpp"
+#include "orderbook/Utilities/ObjectPool.hpp"
+#include <boost/lockfree/spsc_queue.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// Keep a value alive so the optimizer cannot drop the work that produced it
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief One registered microbenchmark
+ * run(n) performs n operations; setup it needs lives in state captured by the closure,
+ * so only the operations themselves are timed.
+ */
+struct Benchmark {
+    std::string name;
+    std::function<void(size_t)> run;
+};
+
+struct BenchResult {
+    std::string name;
+    size_t iterations = 0;
+    size_t repetitions = 0;
+    double median_ns = 0.0;
+    double min_ns = 0.0;
+    double max_ns = 0.0;
+    double stddev_ns = 0.0;
+};
+
+struct SuiteOptions {
+    double min_time_s = 0.1;  // per repetition
+    size_t repetitions = 5;
+    std::string filter;
+    std::string json_path;
+    std::string baseline_path;
+    double tolerance = 0.10;  // allowed slowdown against the baseline
+};
+
+double timeRun(const Benchmark& bench, size_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    bench.run(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+/**
+ * @brief Calibrate an iteration count to min_time, then time each repetition
+ * The reported figure is the median ns/op across repetitions, which is stable against
+ * the odd preempted run; min/max/stddev show how noisy the machine was.
+ */
+BenchResult measure(const Benchmark& bench, const SuiteOptions& options) {
+    // Untimed first run absorbs lazy setup (books, filled indexes, pool growth)
+    bench.run(1);
+    size_t iterations = 1;
+    double target_ns = options.min_time_s * 1e9;
+    for (;;) {
+        double ns = timeRun(bench, iterations);
+        if (ns >= target_ns / 10 || iterations >= (size_t(1) << 30)) {
+            double per_op = ns / static_cast<double>(iterations);
+            iterations = std::max<size_t>(1, static_cast<size_t>(target_ns / std::max(per_op, 0.1)));
+            break;
+        }
+        iterations *= 10;
+    }
+
+    std::vector<double> samples;
+    for (size_t r = 0; r < options.repetitions; ++r) {
+        samples.push_back(timeRun(bench, iterations) / static_cast<double>(iterations));
+    }
+    std::sort(samples.begin(), samples.end());
+    double mean = 0.0;
+    for (double s : samples) mean += s;
+    mean /= static_cast<double>(samples.size());
+    double variance = 0.0;
+    for (double s : samples) variance += (s - mean) * (s - mean);
+
+    BenchResult result;
+    result.name = bench.name;
+    result.iterations = iterations;
+    result.repetitions = samples.size();
+    result.median_ns = samples[samples.size() / 2];
+    result.min_ns = samples.front();
+    result.max_ns = samples.back();
+    result.stddev_ns = std::sqrt(variance / static_cast<double>(samples.size()));
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// PriceLevel
+
+void addPriceLevelBenchmarks(std::vector<Benchmark>& benches) {
+    constexpr size_t QueueDepth = 1024;
+
+    // Append then unlink from the front: the matching pattern
+    benches.push_back({"PriceLevel/addRemoveFifo", [](size_t n) {
+        static std::vector<Order> orders(QueueDepth);
+        PriceLevel level(10000);
+        for (auto& o : orders) o.quantity = 100;
+        for (size_t done = 0; done < n; done += QueueDepth) {
+            for (auto& o : orders) level.addOrder(&o);
+            for (auto& o : orders) level.removeOrder(&o);
+        }
+        doNotOptimize(level.getTotalQuantity());
+    }});
+
+    // Unlink from the middle of a deep queue: the cancel pattern
+    benches.push_back({"PriceLevel/removeMiddle", [](size_t n) {
+        static std::vector<Order> orders(QueueDepth);
+        static std::vector<size_t> cancel_order = [] {
+            std::vector<size_t> order(QueueDepth);
+            for (size_t i = 0; i < QueueDepth; ++i) order[i] = i;
+            std::shuffle(order.begin(), order.end(), std::mt19937_64(42));
+            return order;
+        }();
+        PriceLevel level(10000);
+        for (auto& o : orders) o.quantity = 100;
+        for (size_t done = 0; done < n; done += QueueDepth) {
+            for (auto& o : orders) level.addOrder(&o);
+            for (size_t i : cancel_order) level.removeOrder(&orders[i]);
+        }
+        doNotOptimize(level.getOrderCount());
+    }});
+}
+
+// ---------------------------------------------------------------------------
+// OrderBook level lookup (findOrCreatePriceLevel) and order_index_
+
+/**
+ * @brief Inline book (no consumer thread) with depth levels resting per side
+ * Bids rest on even ticks below 10000 and asks on even ticks above 10002, so odd ticks
+ * are free for new levels and nothing submitted by these benchmarks crosses.
+ */
+struct DepthBook {
+    DepthBook(size_t depth, bool ladder_mode) : depth(depth) {
+        OrderBookOptions options;
+        options.own_consumer_thread = false;
+        options.ladder_mode = ladder_mode;
+        options.max_orders = 1 << 16;
+        book = std::make_unique<OrderBook>(nullptr, nullptr, nullptr, options);
+        symbol = symbolTable().intern("BENCH");
+        account = accountTable().intern("");
+        for (size_t i = 0; i < depth; ++i) {
+            submit(Side::Buy, bidTick(i));
+            submit(Side::Sell, askTick(i));
+        }
+        book->processPending();
+    }
+
+    Price bidTick(size_t level) const { return 10000 - 2 * static_cast<Price>(level); }
+    Price askTick(size_t level) const { return 10002 + 2 * static_cast<Price>(level); }
+
+    OrderId submit(Side side, Price price) {
+        OrderId id(next_id++);
+        book->addOrder(Order(id, side, OrderType::Limit, TimeInForce::GTC, price, 100, symbol, account));
+        return id;
+    }
+
+    std::unique_ptr<OrderBook> book;
+    size_t depth;
+    SymbolId symbol = 0;
+    AccountId account = 0;
+    uint64_t next_id = 1;
+};
+
+void addOrderBookBenchmarks(std::vector<Benchmark>& benches) {
+    for (bool ladder_mode : {false, true}) {
+        for (size_t depth : {10, 100, 1000}) {
+            std::string suffix = std::string(ladder_mode ? "/ladder" : "/vector") + "/depth:" + std::to_string(depth);
+
+            // Join an existing level at a random depth, then cancel: lookup hits
+            // Books are built on first run, so filtered-out benchmarks cost nothing
+            auto existing_book = std::make_shared<std::unique_ptr<DepthBook>>();
+            benches.push_back({"OrderBook/addCancelExistingLevel" + suffix, [existing_book, depth, ladder_mode](size_t n) {
+                if (!*existing_book) *existing_book = std::make_unique<DepthBook>(depth, ladder_mode);
+                DepthBook* existing = existing_book->get();
+                std::mt19937_64 rng(7);
+                for (size_t i = 0; i < n; ++i) {
+                    size_t level = rng() % existing->depth;
+                    OrderId id = existing->submit(i & 1 ? Side::Sell : Side::Buy,
+                                                  i & 1 ? existing->askTick(level) : existing->bidTick(level));
+                    existing->book->processPending();
+                    existing->book->cancelOrder(id);
+                    existing->book->processPending();
+                }
+            }});
+
+            // Open a new level between resting ones, then cancel it: lookup misses and inserts
+            auto fresh_book = std::make_shared<std::unique_ptr<DepthBook>>();
+            benches.push_back({"OrderBook/addCancelNewLevel" + suffix, [fresh_book, depth, ladder_mode](size_t n) {
+                if (!*fresh_book) *fresh_book = std::make_unique<DepthBook>(depth, ladder_mode);
+                DepthBook* fresh = fresh_book->get();
+                std::mt19937_64 rng(11);
+                for (size_t i = 0; i < n; ++i) {
+                    size_t level = rng() % fresh->depth;
+                    OrderId id = fresh->submit(i & 1 ? Side::Sell : Side::Buy,
+                                               i & 1 ? fresh->askTick(level) + 1 : fresh->bidTick(level) - 1);
+                    fresh->book->processPending();
+                    fresh->book->cancelOrder(id);
+                    fresh->book->processPending();
+                }
+            }});
+        }
+    }
+
+    // order_index_ is a FlatHashMap<OrderId, OrderLocation>; benchmark the same instantiation
+    using OrderIndex = FlatHashMap<OrderId, OrderLocation, OrderIdHash>;
+    for (size_t size : {size_t(1000), size_t(100000), size_t(1000000)}) {
+        auto index = std::make_shared<OrderIndex>();
+        auto fill = [index, size] {
+            if (!index->empty()) return;
+            index->reserve(size);
+            for (size_t i = 1; i <= size; ++i) (*index)[OrderId(i * 7919)] = OrderLocation();
+        };
+        std::string suffix = "/size:" + std::to_string(size);
+
+        benches.push_back({"OrderIndex/findHit" + suffix, [index, size, fill](size_t n) {
+            fill();
+            uint64_t key = 1;
+            size_t found = 0;
+            for (size_t i = 0; i < n; ++i) {
+                key = key * 6364136223846793005ull + 1442695040888963407ull;
+                found += index->find(OrderId((key % size + 1) * 7919)) != index->end();
+            }
+            doNotOptimize(found);
+        }});
+        benches.push_back({"OrderIndex/findMiss" + suffix, [index, fill](size_t n) {
+            fill();
+            uint64_t key = 1;
+            size_t found = 0;
+            for (size_t i = 0; i < n; ++i) {
+                key = key * 6364136223846793005ull + 1442695040888963407ull;
+                found += index->find(OrderId((key | 1) * 7919 + 1)) != index->end();
+            }
+            doNotOptimize(found);
+        }});
+        benches.push_back({"OrderIndex/insertErase" + suffix, [index, fill](size_t n) {
+            fill();
+            for (size_t i = 0; i < n; ++i) {
+                OrderId id((uint64_t(1) << 62) + i);
+                (*index)[id] = OrderLocation();
+                index->erase(id);
+            }
+            doNotOptimize(index->size());
+        }});
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FIX parsing and encoding
+
+std::string soh(std::string message) {
+    std::replace(message.begin(), message.end(), '|', fix::FIELD_DELIMITER);
+    return message;
+}
+
+FixMessageParser::ExecutionReport sampleExecutionReport() {
+    FixMessageParser::ExecutionReport report;
+    report.orderId = "123456789";
+    report.clOrdId = "CLIENT-000042";
+    report.execId = "EXEC-987654";
+    report.execType = fix::EXEC_TYPE_PARTIAL_FILL;
+    report.ordStatus = fix::ORD_STATUS_PARTIALLY_FILLED;
+    report.symbol = "AAPL";
+    report.side = Side::Buy;
+    report.orderQty = 1000;
+    report.price = 150.25;
+    report.lastQty = 400;
+    report.lastPx = 150.25;
+    report.leavesQty = 600;
+    report.cumQty = 400;
+    report.avgPx = 150.25;
+    report.transactTime = std::chrono::system_clock::now();
+    return report;
+}
+
+void addFixBenchmarks(std::vector<Benchmark>& benches) {
+    auto nos = std::make_shared<std::string>(soh(
+        "8=FIX.4.4|9=178|35=D|49=CLIENT1|56=ORDERBOOK|34=1042|52=20240102-09:30:00.123|"
+        "11=CLIENT-000042|1=ACC1|55=AAPL|54=1|38=1000|40=2|44=150.25|59=0|"
+        "60=20240102-09:30:00.123|10=123|"));
+
+    benches.push_back({"FixParser/parseMessage", [nos](size_t n) {
+        FixMessageParser parser;
+        for (size_t i = 0; i < n; ++i) {
+            auto message = parser.parseMessage(*nos);
+            doNotOptimize(message.fieldCount);
+        }
+    }});
+    benches.push_back({"FixParser/parseNewOrderSingle", [nos](size_t n) {
+        FixMessageParser parser;
+        for (size_t i = 0; i < n; ++i) {
+            auto order = parser.parseNewOrderSingle(parser.parseMessage(*nos));
+            doNotOptimize(order.quantity);
+        }
+    }});
+    benches.push_back({"FixParser/generateExecutionReport", [](size_t n) {
+        FixMessageParser parser;
+        auto report = sampleExecutionReport();
+        for (size_t i = 0; i < n; ++i) {
+            std::string wire = parser.generateExecutionReport(report, "ORDERBOOK", "CLIENT1", i + 1);
+            doNotOptimize(wire.size());
+        }
+    }});
+    benches.push_back({"FixEncoder/encodeExecutionReport", [](size_t n) {
+        FixEncoder encoder("ORDERBOOK", "CLIENT1");
+        auto report = sampleExecutionReport();
+        std::string out;
+        for (size_t i = 0; i < n; ++i) {
+            encoder.encodeExecutionReport(out, report, i + 1);
+            doNotOptimize(out.size());
+        }
+    }});
+}
+
+// ---------------------------------------------------------------------------
+// Pools
+
+void addPoolBenchmarks(std::vector<Benchmark>& benches) {
+    constexpr size_t Burst = 64;
+
+    // Order's class operator new/delete (the shared order pool), for reference
+    benches.push_back({"Pool/OrderNewDelete", [](size_t n) {
+        Order* held[Burst];
+        for (size_t done = 0; done < n; done += Burst) {
+            for (size_t i = 0; i < Burst; ++i) held[i] = new Order();
+            doNotOptimize(held[Burst - 1]);
+            for (size_t i = 0; i < Burst; ++i) delete held[i];
+        }
+    }});
+    benches.push_back({"Pool/ObjectPool", [](size_t n) {
+        static ObjectPool<Order> pool(Burst);
+        Order* held[Burst];
+        for (size_t done = 0; done < n; done += Burst) {
+            for (size_t i = 0; i < Burst; ++i) held[i] = pool.allocate();
+            doNotOptimize(held[Burst - 1]);
+            for (size_t i = 0; i < Burst; ++i) pool.release(held[i]);
+        }
+    }});
+    benches.push_back({"Pool/PoolAllocator", [](size_t n) {
+        static PoolAllocator<Order, 64 * 1024> pool;
+        Order* held[Burst];
+        for (size_t done = 0; done < n; done += Burst) {
+            for (size_t i = 0; i < Burst; ++i) held[i] = pool.allocate();
+            doNotOptimize(held[Burst - 1]);
+            for (size_t i = 0; i < Burst; ++i) pool.deallocate(held[i]);
+        }
+    }});
+}
+
+// ---------------------------------------------------------------------------
+// Queues
+
+template<typename Queue>
+void pingPong(Queue& queue, size_t n) {
+    uint64_t out = 0;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        queue.push(static_cast<uint64_t>(i));
+        queue.pop(out);
+        sum += out;
+    }
+    doNotOptimize(sum);
+}
+
+// Producer and consumer on separate threads; ns per item transferred
+template<typename Queue>
+void crossThread(Queue& queue, size_t n) {
+    std::thread consumer([&] {
+        uint64_t out = 0;
+        uint64_t sum = 0;
+        for (size_t received = 0; received < n;) {
+            if (queue.pop(out)) {
+                sum += out;
+                ++received;
+            }
+        }
+        doNotOptimize(sum);
+    });
+    for (size_t i = 0; i < n; ++i) {
+        while (!queue.push(static_cast<uint64_t>(i))) {}
+    }
+    consumer.join();
+}
+
+void addQueueBenchmarks(std::vector<Benchmark>& benches) {
+    constexpr size_t Capacity = 1024;
+    using RepoQueue = LockFreeQueue<uint64_t, Capacity>;
+    using BoostQueue = boost::lockfree::spsc_queue<uint64_t, boost::lockfree::capacity<Capacity>>;
+
+    benches.push_back({"SpscQueue/LockFreeQueue/pushPop", [](size_t n) {
+        static RepoQueue queue;
+        pingPong(queue, n);
+    }});
+    benches.push_back({"SpscQueue/boost_spsc/pushPop", [](size_t n) {
+        static BoostQueue queue;
+        pingPong(queue, n);
+    }});
+    // Bursts of 32 through one index publish each way
+    benches.push_back({"SpscQueue/LockFreeQueue/bulk32", [](size_t n) {
+        static RepoQueue queue;
+        constexpr size_t Burst = 32;
+        uint64_t items[Burst];
+        uint64_t sum = 0;
+        for (size_t done = 0; done < n; done += Burst) {
+            for (size_t i = 0; i < Burst; ++i) items[i] = done + i;
+            queue.try_push_n(items, Burst);
+            size_t got = queue.pop_n(items, Burst);
+            for (size_t i = 0; i < got; ++i) sum += items[i];
+        }
+        doNotOptimize(sum);
+    }});
+    benches.push_back({"MpscQueue/pushPop", [](size_t n) {
+        static MpscQueue<uint64_t, Capacity> queue;
+        pingPong(queue, n);
+    }});
+    // Spinning producer and consumer need a core each to mean anything
+    if (std::thread::hardware_concurrency() < 2) return;
+    benches.push_back({"SpscQueue/LockFreeQueue/crossThread", [](size_t n) {
+        static RepoQueue queue;
+        crossThread(queue, n);
+    }});
+    benches.push_back({"SpscQueue/boost_spsc/crossThread", [](size_t n) {
+        static BoostQueue queue;
+        crossThread(queue, n);
+    }});
+    benches.push_back({"MpscQueue/crossThread", [](size_t n) {
+        static MpscQueue<uint64_t, Capacity> queue;
+        crossThread(queue, n);
+    }});
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+
+std::string timestampNow() {
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    return buffer;
+}
+
+// Google Benchmark's JSON layout, so its compare tooling reads these files as-is
+nlohmann::json toJson(const std::vector<BenchResult>& results, const SuiteOptions& options) {
+    nlohmann::json doc;
+    doc["context"] = {
+        {"date", timestampNow()},
+        {"num_cpus", std::thread::hardware_concurrency()},
+        {"repetitions", options.repetitions},
+        {"min_time_s", options.min_time_s},
+#ifdef NDEBUG
+        {"library_build_type", "release"},
+#else
+        {"library_build_type", "debug"},
+#endif
+    };
+    doc["benchmarks"] = nlohmann::json::array();
+    for (const BenchResult& r : results) {
+        doc["benchmarks"].push_back({
+            {"name", r.name},
+            {"run_type", "aggregate"},
+            {"aggregate_name", "median"},
+            {"iterations", r.iterations},
+            {"repetitions", r.repetitions},
+            {"real_time", r.median_ns},
+            {"cpu_time", r.median_ns},
+            {"min_time", r.min_ns},
+            {"max_time", r.max_ns},
+            {"stddev", r.stddev_ns},
+            {"time_unit", "ns"},
+        });
+    }
+    return doc;
+}
+
+/**
+ * @brief Compare against a previous run's JSON
+ * @return Number of benchmarks slower than baseline by more than tolerance
+ */
+size_t compareBaseline(const std::vector<BenchResult>& results, const SuiteOptions& options) {
+    std::ifstream in(options.baseline_path);
+    if (!in) {
+        std::cerr << "Cannot open baseline " << options.baseline_path << "\n";
+        return 0;
+    }
+    nlohmann::json baseline = nlohmann::json::parse(in, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("benchmarks")) {
+        std::cerr << "Baseline " << options.baseline_path << " is not benchmark JSON\n";
+        return 0;
+    }
+    std::unordered_map<std::string, double> previous;
+    for (const auto& entry : baseline["benchmarks"]) {
+        if (entry.contains("name") && entry.contains("real_time")) {
+            previous[entry["name"].get<std::string>()] = entry["real_time"].get<double>();
+        }
+    }
+
+    size_t regressions = 0;
+    std::cout << "\nAgainst baseline " << options.baseline_path << " (tolerance "
+              << options.tolerance * 100.0 << "%)\n";
+    for (const BenchResult& r : results) {
+        auto it = previous.find(r.name);
+        if (it == previous.end() || it->second <= 0.0) continue;
+        double change = r.median_ns / it->second - 1.0;
+        bool regressed = change > options.tolerance;
+        regressions += regressed;
+        char line[200];
+        std::snprintf(line, sizeof(line), "%-56s %10.1f -> %10.1f ns  %+6.1f%%%s\n", r.name.c_str(),
+                      it->second, r.median_ns, change * 100.0, regressed ? "  REGRESSION" : "");
+        std::cout << line;
+    }
+    return regressions;
+}
+
+}
+
+/**
+ * @brief Per-component microbenchmarks with JSON output and regression gating
+ */
+int main(int argc, char* argv[]) {
+    SuiteOptions options;
+    bool list_only = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.min_time_s = std::stod(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::max<size_t>(1, std::stoull(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.json_path = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            options.baseline_path = argv[++i];
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            options.tolerance = std::stod(argv[++i]) / 100.0;
+        } else if (arg == "--list") {
+            list_only = true;
+        } else if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [options]\n";
+            std::cout << "Options:\n";
+            std::cout << "  --filter TEXT      Run only benchmarks whose name contains TEXT\n";
+            std::cout << "  --min-time S       Seconds per repetition (default: 0.1)\n";
+            std::cout << "  --repetitions N    Timed repetitions per benchmark (default: 5)\n";
+            std::cout << "  --json FILE        Write results as JSON (- for stdout)\n";
+            std::cout << "  --baseline FILE    Compare against an earlier --json output\n";
+            std::cout << "  --tolerance PCT    Allowed slowdown before failing (default: 10)\n";
+            std::cout << "  --list             List benchmark names and exit\n";
+            std::cout << "  --help             Show this help message\n";
+            return 0;
+        }
+    }
+
+    std::vector<Benchmark> benches;
+    addPriceLevelBenchmarks(benches);
+    addOrderBookBenchmarks(benches);
+    addFixBenchmarks(benches);
+    addPoolBenchmarks(benches);
+    addQueueBenchmarks(benches);
+
+    std::vector<BenchResult> results;
+    for (const Benchmark& bench : benches) {
+        if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos) continue;
+        if (list_only) {
+            std::cout << bench.name << "\n";
+            continue;
+        }
+        results.push_back(measure(bench, options));
+        const BenchResult& r = results.back();
+        char line[200];
+        std::snprintf(line, sizeof(line), "%-56s %10.1f ns/op  (min %.1f, max %.1f, %zu iterations)\n",
+                      r.name.c_str(), r.median_ns, r.min_ns, r.max_ns, r.iterations);
+        std::cerr << line;
+    }
+    if (list_only) return 0;
+
+    if (!options.json_path.empty()) {
+        std::string json = toJson(results, options).dump(2);
+        if (options.json_path == "-") {
+            std::cout << json << "\n";
+        } else {
+            std::ofstream(options.json_path) << json << "\n";
+        }
+    }
+    if (!options.baseline_path.empty() && compareBaseline(results, options) > 0) {
+        std::cout << "\nPerformance regression detected\n";
+        return 2;
+    }
+    return 0;
+}
@@ -11,6 +11,10 @@
 int main(int argc, char* argv[]) {
     std::cout << "OrderBook Performance Validation Suite\n";
     std::cout << "======================================\n\n";
+#ifndef ORDERBOOK_PERF_MEASURE
+    std::cout << "Note: built without ORDERBOOK_PERF_MEASURE, so per-operation latency scopes are\n"
+                 "compiled out; use the RelWithInstrumentation build for those figures.\n\n";
+#endif
     
     try {
         // Parse command line arguments
@@ -19,6 +23,7 @@ int main(int argc, char* argv[]) {
         bool run_full_test = true;
         size_t num_orders = 1000000;
         size_t num_threads = 1;
+        orderbook::PerformanceTest::OpenLoopConfig open_loop;
         
         for (int i = 1; i < argc; ++i) {
             std::string arg = argv[i];
@@ -28,6 +33,16 @@ int main(int argc, char* argv[]) {
             } else if (arg == "--throughput") {
                 run_throughput_stress = true;
                 run_full_test = false;
+            } else if (arg == "--rate" && i + 1 < argc) {
+                open_loop.rate = std::stod(argv[++i]);
+            } else if (arg == "--duration" && i + 1 < argc) {
+                open_loop.duration_seconds = std::stod(argv[++i]);
+            } else if (arg == "--poisson") {
+                open_loop.poisson = true;
+            } else if (arg == "--cancel-ratio" && i + 1 < argc) {
+                open_loop.cancel_ratio = std::stod(argv[++i]);
+            } else if (arg == "--modify-ratio" && i + 1 < argc) {
+                open_loop.modify_ratio = std::stod(argv[++i]);
             } else if (arg == "--orders" && i + 1 < argc) {
                 num_orders = std::stoull(argv[++i]);
             } else if (arg == "--threads" && i + 1 < argc) {
@@ -36,7 +51,12 @@ int main(int argc, char* argv[]) {
                 std::cout << "Usage: " << argv[0] << " [options]\n";
                 std::cout << "Options:\n";
                 std::cout << "  --latency          Run latency benchmark only\n";
-                std::cout << "  --throughput       Run throughput stress test only\n";
+                std::cout << "  --throughput       Run open-loop load test only\n";
+                std::cout << "  --rate R           Open-loop requests per second (default: 100000)\n";
+                std::cout << "  --duration S       Open-loop run length in seconds (default: 10)\n";
+                std::cout << "  --poisson          Poisson arrivals instead of a constant rate\n";
+                std::cout << "  --cancel-ratio F   Share of requests that cancel (default: 0.35)\n";
+                std::cout << "  --modify-ratio F   Share of requests that modify (default: 0.10)\n";
                 std::cout << "  --orders N         Number of orders to process (default: 100000)\n";
                 std::cout << "  --threads N        Number of threads to use (default: 1)\n";
                 std::cout << "  --help             Show this help message\n";
@@ -50,8 +70,9 @@ int main(int argc, char* argv[]) {
         }
         
         if (run_throughput_stress) {
-            std::cout << "Running Throughput Stress Test...\n";
-            orderbook::PerformanceTest::runThroughputStressTest();
+            std::cout << "Running Open-Loop Load Test...\n";
+            auto results = orderbook::PerformanceTest::runOpenLoopTest(open_loop);
+            orderbook::PerformanceTest::printOpenLoopResults(open_loop, *results);
         }
         
         if (run_full_test) {
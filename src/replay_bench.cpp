@@ -0,0 +1,568 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/CommandJournal.hpp"
+#include "orderbook/Core/InternTable.hpp"
+#include "orderbook/MarketData/L2Book.hpp"
+#include "orderbook/MarketData/MarketDataFeed.hpp"
+#include "orderbook/Network/FixParser.hpp"
+#include "orderbook/Risk/RiskManager.hpp"
+#include "orderbook/Utilities/PerformanceMeasurement.hpp"
+#include "orderbook/Utilities/TscClock.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::fix;
+
+namespace {
+
+using Histogram = PerformanceMeasurement::Histogram;
+
+/**
+ * @brief One captured input, loaded fully before the clock starts
+ */
+struct ReplayEvent {
+    enum class Kind : uint8_t { Fix, MarketData, Journal };
+    Kind kind = Kind::Fix;
+    // Capture time in ns since the epoch (0 when the source carries none)
+    uint64_t recorded_ns = 0;
+    std::string raw;
+    JournalCommand command;
+};
+
+struct BenchConfig {
+    std::vector<std::string> fix_files;
+    std::vector<std::string> md_files;
+    std::string journal_dir;
+    bool paced = false;
+    double speed = 1.0;
+    bool ladder_mode = false;
+    double tick_size = 0.01;
+    bool risk = false;
+    size_t repeat = 1;
+};
+
+// Per-stage latency distributions; a stage is only reported if it saw samples
+struct StageStats {
+    const char* name;
+    Histogram histogram;
+    uint64_t count = 0;
+
+    explicit StageStats(const char* stage) : name(stage) {}
+    void record(uint64_t ns) { histogram.record(ns); ++count; }
+};
+
+/**
+ * @brief Forwards to the real publisher and times each call
+ * Runs on the bench thread inside processPending(), so its samples are the publish
+ * share of the match stage.
+ */
+class TimedPublisher : public IMarketDataPublisher {
+public:
+    TimedPublisher(std::shared_ptr<IMarketDataPublisher> inner, StageStats& stats)
+        : inner_(std::move(inner)), stats_(stats) {}
+
+    void publishTrade(const Trade& trade) override { timed([&] { inner_->publishTrade(trade); }); }
+    void publishBookUpdate(const BookUpdate& update) override { timed([&] { inner_->publishBookUpdate(update); }); }
+    void publishBestPrices(const BestPrices& prices) override { timed([&] { inner_->publishBestPrices(prices); }); }
+    void publishDepth(const MarketDepth& depth) override { timed([&] { inner_->publishDepth(depth); }); }
+    void subscribe(std::function<void(const std::string&)> callback) override { inner_->subscribe(std::move(callback)); }
+
+private:
+    template<typename Fn>
+    void timed(Fn&& fn) {
+        TscClock::Ticks start = TscClock::now();
+        fn();
+        stats_.record(TscClock::toNanos(TscClock::now() - start));
+    }
+
+    std::shared_ptr<IMarketDataPublisher> inner_;
+    StageStats& stats_;
+};
+
+// Counts what reaches subscribers, so the delivery path is exercised but cheap
+class CountingSubscriber : public IMarketDataSubscriber {
+public:
+    void onTrade(const Trade&, SequenceNumber) override { ++trades; }
+    void onBookUpdate(const BookUpdate&) override { ++book_updates; }
+    void onBestPrices(const BestPrices&, SequenceNumber) override { ++best_prices; }
+    void onDepth(const MarketDepth&, SequenceNumber) override { ++depths; }
+
+    uint64_t trades = 0;
+    uint64_t book_updates = 0;
+    uint64_t best_prices = 0;
+    uint64_t depths = 0;
+};
+
+// FIX UTCTimestamp (YYYYMMDD-HH:MM:SS[.fff...]) to ns since the epoch, 0 if malformed
+uint64_t parseUtcTimestamp(std::string_view text) {
+    auto number = [&](size_t at, size_t digits, int& out) {
+        if (at + digits > text.size()) return false;
+        auto [end, ec] = std::from_chars(text.data() + at, text.data() + at + digits, out);
+        return ec == std::errc() && end == text.data() + at + digits;
+    };
+    int year, month, day, hour, minute, second;
+    if (text.size() < 17 || text[8] != '-' || text[11] != ':' || text[14] != ':' ||
+        !number(0, 4, year) || !number(4, 2, month) || !number(6, 2, day) ||
+        !number(9, 2, hour) || !number(12, 2, minute) || !number(15, 2, second)) {
+        return 0;
+    }
+    // Days from civil date (proleptic Gregorian)
+    int y = year - (month <= 2);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = static_cast<int64_t>(era) * 146097 + doe - 719468;
+    uint64_t ns = static_cast<uint64_t>(((days * 24 + hour) * 60 + minute) * 60 + second) * 1000000000ull;
+
+    uint64_t fraction = 0;
+    uint64_t scale = 1000000000ull;
+    for (size_t i = 18; text.size() > 17 && text[17] == '.' && i < text.size() && scale > 1; ++i) {
+        if (text[i] < '0' || text[i] > '9') break;
+        scale /= 10;
+        fraction += static_cast<uint64_t>(text[i] - '0') * scale;
+    }
+    return ns + fraction;
+}
+
+// Value of the first occurrence of tag in a SOH-delimited message
+std::string_view findTag(std::string_view message, std::string_view tag_eq) {
+    size_t at = 0;
+    while ((at = message.find(tag_eq, at)) != std::string_view::npos) {
+        if (at == 0 || message[at - 1] == FIELD_DELIMITER) {
+            size_t begin = at + tag_eq.size();
+            size_t end = message.find(FIELD_DELIMITER, begin);
+            return message.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+        }
+        at += tag_eq.size();
+    }
+    return {};
+}
+
+/**
+ * @brief Load a FIX log: one message per line, '|' or SOH delimited
+ * Accepts QuickFIX file logs ("YYYYMMDD-HH:MM:SS.fff : 8=FIX...") and bare messages;
+ * the capture time is the line prefix if present, else SendingTime(52). Only order
+ * entry (D/F/G) and market data (W/X) messages are kept.
+ */
+size_t loadFixLog(const std::string& path, std::vector<ReplayEvent>& events, bool market_data) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot open " << path << "\n";
+        return 0;
+    }
+    size_t loaded = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t begin = line.find("8=FIX");
+        if (begin == std::string::npos) continue;
+        std::string message = line.substr(begin);
+        while (!message.empty() && (message.back() == '\r' || message.back() == '\n')) message.pop_back();
+        std::replace(message.begin(), message.end(), '|', FIELD_DELIMITER);
+
+        std::string_view type = findTag(message, "35=");
+        if (type.size() != 1) continue;
+        bool is_order = type[0] == MSG_TYPE_NEW_ORDER_SINGLE || type[0] == MSG_TYPE_ORDER_CANCEL_REQUEST ||
+                        type[0] == MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST;
+        bool is_md = type[0] == 'W' || type[0] == 'X';
+        if (market_data ? !is_md : !(is_order || is_md)) continue;
+
+        ReplayEvent event;
+        event.kind = is_md ? ReplayEvent::Kind::MarketData : ReplayEvent::Kind::Fix;
+        event.recorded_ns = parseUtcTimestamp(std::string_view(line).substr(0, begin));
+        if (event.recorded_ns == 0) event.recorded_ns = parseUtcTimestamp(findTag(message, "52="));
+        event.raw = std::move(message);
+        events.push_back(std::move(event));
+        ++loaded;
+    }
+    return loaded;
+}
+
+// Journal commands carry no wall-clock time; they replay back to back
+size_t loadJournal(const std::string& directory, std::vector<ReplayEvent>& events) {
+    CommandJournalReader reader(directory);
+    size_t loaded = 0;
+    ReplayEvent event;
+    event.kind = ReplayEvent::Kind::Journal;
+    while (reader.next(event.command)) {
+        events.push_back(event);
+        ++loaded;
+    }
+    if (reader.damaged()) {
+        std::cerr << "Journal " << directory << " stops early: " << reader.error() << "\n";
+    }
+    return loaded;
+}
+
+/**
+ * @brief Drives every event through parse -> OrderBook -> publisher on one thread
+ *
+ * The book runs without its own consumer thread and the bench calls processPending()
+ * after each submission, so matching happens inline and every stage is timed on the
+ * same core. Order IDs are assigned in input order, making runs reproducible.
+ */
+class ReplayBench {
+public:
+    explicit ReplayBench(const BenchConfig& config)
+        : config_(config), price_scale_(config.tick_size) {
+        subscriber_ = std::make_shared<CountingSubscriber>();
+        auto publisher = std::make_shared<MarketDataPublisher>();
+        publisher->subscribe(subscriber_);
+        publisher_ = std::make_shared<TimedPublisher>(publisher, publish_);
+
+        OrderBookOptions options;
+        options.price_scale = price_scale_;
+        options.ladder_mode = config.ladder_mode;
+        options.own_consumer_thread = false;
+        RiskManagerPtr risk = config.risk ? std::make_shared<RiskManager>() : nullptr;
+        book_ = std::make_unique<OrderBook>(risk, publisher_, nullptr, options);
+    }
+
+    void run(const std::vector<ReplayEvent>& events) {
+        uint64_t first_recorded = 0;
+        for (const ReplayEvent& event : events) {
+            if (event.recorded_ns) { first_recorded = event.recorded_ns; break; }
+        }
+        auto start = std::chrono::steady_clock::now();
+        uint64_t busy_ns = 0;
+        for (const ReplayEvent& event : events) {
+            if (config_.paced && event.recorded_ns >= first_recorded && first_recorded) {
+                auto due = start + std::chrono::nanoseconds(static_cast<uint64_t>(
+                    static_cast<double>(event.recorded_ns - first_recorded) / config_.speed));
+                while (std::chrono::steady_clock::now() < due) std::this_thread::yield();
+            }
+            TscClock::Ticks begin = TscClock::now();
+            switch (event.kind) {
+                case ReplayEvent::Kind::Fix: replayOrderEntry(event.raw, begin); break;
+                case ReplayEvent::Kind::MarketData: replayMarketData(event.raw, begin); break;
+                case ReplayEvent::Kind::Journal: replayCommand(event.command, begin); break;
+            }
+            busy_ns += TscClock::toNanos(TscClock::now() - begin);
+        }
+        wall_ns_ += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        busy_ns_ += busy_ns;
+        events_ += events.size();
+    }
+
+    void report(std::ostream& out) const {
+        out << "\nStage latency (ns)\n";
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-14s %10s %8s %8s %8s %8s %8s %10s\n",
+                      "stage", "count", "min", "p50", "p90", "p99", "p99.9", "max");
+        out << line;
+        for (const StageStats* stage : {&fix_parse_, &submit_, &match_, &publish_, &md_parse_, &md_apply_, &end_to_end_}) {
+            if (stage->count == 0) continue;
+            const Histogram& h = stage->histogram;
+            std::snprintf(line, sizeof(line), "%-14s %10llu %8llu %8llu %8llu %8llu %8llu %10llu\n",
+                          stage->name, static_cast<unsigned long long>(stage->count),
+                          static_cast<unsigned long long>(h.min()),
+                          static_cast<unsigned long long>(percentile(h, stage->count, 0.50)),
+                          static_cast<unsigned long long>(percentile(h, stage->count, 0.90)),
+                          static_cast<unsigned long long>(percentile(h, stage->count, 0.99)),
+                          static_cast<unsigned long long>(percentile(h, stage->count, 0.999)),
+                          static_cast<unsigned long long>(h.max()));
+            out << line;
+        }
+
+        double wall_s = static_cast<double>(wall_ns_) / 1e9;
+        double busy_s = static_cast<double>(busy_ns_) / 1e9;
+        out << "\nEvents:      " << events_ << " (" << rejected_ << " rejected, " << unmatched_ << " unknown ClOrdID)\n";
+        out << "Wall time:   " << wall_s << " s\n";
+        if (wall_s > 0) out << "Throughput:  " << static_cast<uint64_t>(events_ / wall_s) << " events/s wall";
+        if (busy_s > 0) out << ", " << static_cast<uint64_t>(events_ / busy_s) << " events/s busy";
+        out << "\n";
+        out << "Book:        trades=" << book_->getTradeCount() << " resting=" << book_->getOrderCount() << "\n";
+        out << "Published:   trades=" << subscriber_->trades << " book_updates=" << subscriber_->book_updates
+            << " best_prices=" << subscriber_->best_prices << " depth=" << subscriber_->depths << "\n";
+    }
+
+private:
+    static uint64_t percentile(const Histogram& h, uint64_t count, double q) {
+        uint64_t target = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < Histogram::BucketCount; ++i) {
+            seen += h.bucket(i);
+            if (seen >= target) return std::min(Histogram::valueFor(i), h.max());
+        }
+        return h.max();
+    }
+
+    void finish(TscClock::Ticks begin, TscClock::Ticks submitted) {
+        book_->processPending();
+        TscClock::Ticks end = TscClock::now();
+        submit_.record(TscClock::toNanos(submitted - begin));
+        match_.record(TscClock::toNanos(end - submitted));
+    }
+
+    void replayOrderEntry(const std::string& raw, TscClock::Ticks begin) {
+        FixMessageParser::FixMessage message = parser_.parseMessage(raw);
+        if (!message.isValid) { ++rejected_; return; }
+
+        if (message.msgType == MSG_TYPE_NEW_ORDER_SINGLE) {
+            FixMessageParser::NewOrderSingle nos = parser_.parseNewOrderSingle(message);
+            TscClock::Ticks parsed = TscClock::now();
+            fix_parse_.record(TscClock::toNanos(parsed - begin));
+            if (!nos.isValid) { ++rejected_; return; }
+            OrderId id(next_order_id_++);
+            Order order(id, nos.side, nos.orderType, nos.timeInForce, price_scale_.toTicks(nos.price),
+                        nos.quantity, symbolTable().intern(nos.symbol), accountTable().intern(nos.account));
+            if (book_->addOrder(order).isError()) ++rejected_;
+            else live_orders_[nos.clOrdId] = id;
+            TscClock::Ticks submitted = TscClock::now();
+            finish(parsed, submitted);
+            end_to_end_.record(TscClock::toNanos(TscClock::now() - begin));
+        } else if (message.msgType == MSG_TYPE_ORDER_CANCEL_REQUEST) {
+            FixMessageParser::OrderCancelRequest cancel = parser_.parseOrderCancelRequest(message);
+            TscClock::Ticks parsed = TscClock::now();
+            fix_parse_.record(TscClock::toNanos(parsed - begin));
+            auto it = live_orders_.find(cancel.origClOrdId);
+            if (!cancel.isValid || it == live_orders_.end()) { ++unmatched_; return; }
+            if (book_->cancelOrder(it->second).isError()) ++rejected_;
+            live_orders_.erase(it);
+            TscClock::Ticks submitted = TscClock::now();
+            finish(parsed, submitted);
+            end_to_end_.record(TscClock::toNanos(TscClock::now() - begin));
+        } else if (message.msgType == MSG_TYPE_ORDER_CANCEL_REPLACE_REQUEST) {
+            FixMessageParser::OrderCancelReplaceRequest replace = parser_.parseOrderCancelReplaceRequest(message);
+            TscClock::Ticks parsed = TscClock::now();
+            fix_parse_.record(TscClock::toNanos(parsed - begin));
+            auto it = live_orders_.find(replace.origClOrdId);
+            if (!replace.isValid || it == live_orders_.end()) { ++unmatched_; return; }
+            OrderId id = it->second;
+            if (book_->modifyOrder(id, price_scale_.toTicks(replace.price), replace.quantity).isError()) ++rejected_;
+            // The replacement keeps the book's order ID under its new ClOrdID
+            live_orders_.erase(it);
+            live_orders_[replace.clOrdId] = id;
+            TscClock::Ticks submitted = TscClock::now();
+            finish(parsed, submitted);
+            end_to_end_.record(TscClock::toNanos(TscClock::now() - begin));
+        }
+    }
+
+    /**
+     * @brief Apply a W/X message to the per-symbol L2Book mirror and publish its levels
+     * Repeating groups are walked directly: a full snapshot has more entries than
+     * FixMessage's fixed field table holds.
+     */
+    void replayMarketData(const std::string& raw, TscClock::Ticks begin) {
+        std::string_view message(raw);
+        bool snapshot = findTag(message, "35=") == "W";
+        SymbolId message_symbol = InternTable::EmptyId;
+        depth_.bids.clear();
+        depth_.asks.clear();
+        updates_.clear();
+
+        // Current group entry; flushed when the next 269 starts or the message ends
+        char entry_type = 0, action = '0';
+        double px = 0.0, size = 0.0;
+        size_t orders = 0;
+        auto flush = [&] {
+            if (entry_type != '0' && entry_type != '1') return;
+            Side side = entry_type == '0' ? Side::Buy : Side::Sell;
+            Price price = price_scale_.toTicks(px);
+            if (snapshot) {
+                MarketDepth::Level level{price, static_cast<Quantity>(size), orders};
+                (side == Side::Buy ? depth_.bids : depth_.asks).push_back(level);
+            } else {
+                BookUpdate::Type type = action == '0' ? BookUpdate::Type::Add
+                                      : action == '2' ? BookUpdate::Type::Remove : BookUpdate::Type::Modify;
+                updates_.emplace_back(type, side, price, static_cast<Quantity>(size), orders, 0);
+            }
+        };
+
+        size_t at = 0;
+        while (at < message.size()) {
+            size_t end = message.find(FIELD_DELIMITER, at);
+            if (end == std::string_view::npos) end = message.size();
+            std::string_view field = message.substr(at, end - at);
+            at = end + 1;
+            size_t eq = field.find('=');
+            if (eq == std::string_view::npos) continue;
+            int tag = 0;
+            std::from_chars(field.data(), field.data() + eq, tag);
+            std::string_view value = field.substr(eq + 1);
+            switch (tag) {
+                case 55:
+                    if (message_symbol == InternTable::EmptyId) message_symbol = symbolTable().intern(value);
+                    break;
+                case 269:
+                    flush();
+                    entry_type = value.empty() ? 0 : value[0];
+                    action = '0';
+                    px = size = 0.0;
+                    orders = 0;
+                    break;
+                case 279: action = value.empty() ? '0' : value[0]; break;
+                case 270: px = std::strtod(std::string(value).c_str(), nullptr); break;
+                case 271: size = std::strtod(std::string(value).c_str(), nullptr); break;
+                case 346: std::from_chars(value.data(), value.data() + value.size(), orders); break;
+                default: break;
+            }
+        }
+        flush();
+        TscClock::Ticks parsed = TscClock::now();
+        md_parse_.record(TscClock::toNanos(parsed - begin));
+
+        L2Book& mirror = mirrorFor(message_symbol);
+        if (snapshot) {
+            mirror.applySnapshot(depth_);
+            publisher_->publishDepth(depth_);
+        } else if (!updates_.empty()) {
+            mirror.applyUpdates(updates_.data(), updates_.size());
+            for (const BookUpdate& update : updates_) publisher_->publishBookUpdate(update);
+        }
+        TscClock::Ticks applied = TscClock::now();
+        md_apply_.record(TscClock::toNanos(applied - parsed));
+        end_to_end_.record(TscClock::toNanos(applied - begin));
+    }
+
+    void replayCommand(const JournalCommand& command, TscClock::Ticks begin) {
+        bool ok = true;
+        switch (command.type) {
+            case JournalCommand::Type::Add: {
+                Order order(command.id, command.side, command.order_type, command.tif, command.price,
+                            command.quantity, command.symbol_id, command.account_id);
+                ok = !book_->addOrder(order).isError();
+                break;
+            }
+            case JournalCommand::Type::Cancel:
+                ok = !book_->cancelOrder(command.id).isError();
+                break;
+            case JournalCommand::Type::Modify:
+                ok = !book_->modifyOrder(command.id, command.price, command.quantity).isError();
+                break;
+            case JournalCommand::Type::CancelAccount:
+                ok = !book_->cancelAll(MassCancel::account(command.account_id)).isError();
+                break;
+            case JournalCommand::Type::CancelSymbol:
+                ok = !book_->cancelAll(MassCancel::symbol(command.symbol_id)).isError();
+                break;
+            case JournalCommand::Type::Auction:
+                // The bench book keeps its own auction cadence
+                break;
+        }
+        if (!ok) ++rejected_;
+        finish(begin, TscClock::now());
+        end_to_end_.record(TscClock::toNanos(TscClock::now() - begin));
+    }
+
+    L2Book& mirrorFor(SymbolId symbol) {
+        auto& book = mirrors_[symbol];
+        if (!book) book = std::make_unique<L2Book>();
+        return *book;
+    }
+
+    BenchConfig config_;
+    PriceScale price_scale_;
+    FixMessageParser parser_;
+    std::shared_ptr<CountingSubscriber> subscriber_;
+    std::shared_ptr<IMarketDataPublisher> publisher_;
+    std::unique_ptr<OrderBook> book_;
+    std::unordered_map<std::string, OrderId> live_orders_;
+    std::unordered_map<SymbolId, std::unique_ptr<L2Book>> mirrors_;
+    MarketDepth depth_;
+    std::vector<BookUpdate> updates_;
+    uint64_t next_order_id_ = 1;
+
+    StageStats fix_parse_{"fix_parse"};
+    StageStats submit_{"submit"};
+    StageStats match_{"match"};
+    StageStats publish_{"publish"};
+    StageStats md_parse_{"md_parse"};
+    StageStats md_apply_{"md_apply"};
+    StageStats end_to_end_{"end_to_end"};
+    uint64_t events_ = 0;
+    uint64_t rejected_ = 0;
+    uint64_t unmatched_ = 0;
+    uint64_t wall_ns_ = 0;
+    uint64_t busy_ns_ = 0;
+};
+
+}
+
+/**
+ * @brief Replay benchmark over captured traffic
+ * Feeds recorded FIX order entry, QuickFIX market data logs or a command journal
+ * through the same parser, book and publisher as production and reports per-stage
+ * latency percentiles and throughput.
+ */
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--fix" && i + 1 < argc) {
+            config.fix_files.push_back(argv[++i]);
+        } else if (arg == "--md" && i + 1 < argc) {
+            config.md_files.push_back(argv[++i]);
+        } else if (arg == "--journal" && i + 1 < argc) {
+            config.journal_dir = argv[++i];
+        } else if (arg == "--paced") {
+            config.paced = true;
+        } else if (arg == "--speed" && i + 1 < argc) {
+            config.speed = std::stod(argv[++i]);
+            if (config.speed <= 0.0) config.speed = 1.0;
+        } else if (arg == "--ladder") {
+            config.ladder_mode = true;
+        } else if (arg == "--tick" && i + 1 < argc) {
+            config.tick_size = std::stod(argv[++i]);
+        } else if (arg == "--risk") {
+            config.risk = true;
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            config.repeat = std::max<size_t>(1, std::stoull(argv[++i]));
+        } else if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [inputs] [options]\n";
+            std::cout << "Inputs (at least one):\n";
+            std::cout << "  --fix FILE         FIX log with order entry (D/F/G) and/or market data (W/X)\n";
+            std::cout << "  --md FILE          QuickFIX market data log (W/X only)\n";
+            std::cout << "  --journal DIR      Command journal directory\n";
+            std::cout << "Options:\n";
+            std::cout << "  --paced            Replay at the recorded pace instead of as fast as possible\n";
+            std::cout << "  --speed X          Pace multiplier for --paced (default: 1.0)\n";
+            std::cout << "  --ladder           Use the PriceLadder level store\n";
+            std::cout << "  --tick X           Tick size for decimal FIX prices (default: 0.01)\n";
+            std::cout << "  --risk             Run orders through the default RiskManager\n";
+            std::cout << "  --repeat N         Replay the input N times into the same book (default: 1)\n";
+            std::cout << "  --help             Show this help message\n";
+            return 0;
+        }
+    }
+
+    std::vector<ReplayEvent> events;
+    for (const std::string& path : config.fix_files) {
+        std::cout << "Loaded " << loadFixLog(path, events, false) << " messages from " << path << "\n";
+    }
+    for (const std::string& path : config.md_files) {
+        std::cout << "Loaded " << loadFixLog(path, events, true) << " messages from " << path << "\n";
+    }
+    if (!config.fix_files.empty() && !config.md_files.empty()) {
+        // Interleave the captures by recorded time; ties keep file order
+        std::stable_sort(events.begin(), events.end(), [](const ReplayEvent& a, const ReplayEvent& b) {
+            return a.recorded_ns < b.recorded_ns;
+        });
+    }
+    if (!config.journal_dir.empty()) {
+        std::cout << "Loaded " << loadJournal(config.journal_dir, events) << " commands from "
+                  << config.journal_dir << "\n";
+    }
+    if (events.empty()) {
+        std::cerr << "Nothing to replay (see --help)\n";
+        return 1;
+    }
+
+    ReplayBench bench(config);
+    for (size_t pass = 0; pass < config.repeat; ++pass) {
+        bench.run(events);
+    }
+    bench.report(std::cout);
+    return 0;
+}
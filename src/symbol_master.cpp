@@ -0,0 +1,186 @@
+#include "orderbook/Core/SymbolMaster.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+// One CSV record; quoted fields may hold commas and doubled quotes
+std::vector<std::string> splitCsv(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    for (auto& field : fields) {
+        auto first = field.find_first_not_of(" \t");
+        auto last = field.find_last_not_of(" \t");
+        field = first == std::string::npos ? std::string() : field.substr(first, last - first + 1);
+    }
+    return fields;
+}
+
+// Header name folded to lower case without separators: "Tick Size" -> "ticksize"
+std::string columnKey(const std::string& name) {
+    std::string key;
+    for (char c : name) {
+        if (std::isalnum(static_cast<unsigned char>(c))) key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+/**
+ * @brief Read instrument definitions from a CSV with a header row
+ * Recognized columns: Symbol, ID, Name, TickSize, LotSize, MinPrice, MaxPrice
+ * (decimal prices). Without a Symbol column the ID is the wire symbol, which is
+ * how scripts/extract_symbols.py output is keyed.
+ */
+bool loadCsv(const std::string& path, double default_tick, Quantity default_lot,
+             std::vector<SymbolDefinition>& symbols) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot open " << path << "\n";
+        return false;
+    }
+    std::string line;
+    if (!std::getline(in, line)) {
+        std::cerr << path << " is empty\n";
+        return false;
+    }
+    std::vector<std::string> header = splitCsv(line);
+    auto column = [&header](const char* key) {
+        for (size_t i = 0; i < header.size(); ++i) {
+            if (columnKey(header[i]) == key) return static_cast<int>(i);
+        }
+        return -1;
+    };
+    int symbol_col = column("symbol");
+    int id_col = column("id");
+    int name_col = column("name");
+    int tick_col = column("ticksize");
+    int lot_col = column("lotsize");
+    int min_col = column("minprice");
+    int max_col = column("maxprice");
+    if (symbol_col < 0) symbol_col = id_col;
+    if (symbol_col < 0) {
+        std::cerr << path << " has neither a Symbol nor an ID column\n";
+        return false;
+    }
+
+    size_t line_number = 1;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        std::vector<std::string> fields = splitCsv(line);
+        auto field = [&fields](int col) { return col >= 0 && col < static_cast<int>(fields.size()) ? fields[col] : std::string(); };
+        try {
+            SymbolDefinition definition;
+            definition.symbol = field(symbol_col);
+            definition.name = field(name_col);
+            std::string id = field(id_col);
+            if (!id.empty()) {
+                auto [end, ec] = std::from_chars(id.data(), id.data() + id.size(), definition.security_id);
+                if (ec != std::errc() || end != id.data() + id.size()) definition.security_id = 0;
+            }
+            std::string tick = field(tick_col);
+            definition.tick_size = tick.empty() ? default_tick : std::stod(tick);
+            std::string lot = field(lot_col);
+            definition.lot_size = lot.empty() ? default_lot : std::stoull(lot);
+            PriceScale scale(definition.tick_size);
+            std::string min_price = field(min_col);
+            std::string max_price = field(max_col);
+            if (!min_price.empty()) definition.min_price = scale.toTicks(std::stod(min_price));
+            if (!max_price.empty()) definition.max_price = scale.toTicks(std::stod(max_price));
+            symbols.push_back(std::move(definition));
+        } catch (const std::exception&) {
+            std::cerr << path << ":" << line_number << ": malformed number\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+/**
+ * @brief Offline builder for the binary symbol master
+ * Converts instrument CSV into the file SymbolMaster::open() maps at startup, then
+ * reopens it and checks that every symbol resolves.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<std::string> inputs;
+    std::string output;
+    double tick_size = 0.01;
+    Quantity lot_size = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--csv" && i + 1 < argc) {
+            inputs.push_back(argv[++i]);
+        } else if (arg == "--out" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--tick" && i + 1 < argc) {
+            tick_size = std::stod(argv[++i]);
+        } else if (arg == "--lot" && i + 1 < argc) {
+            lot_size = std::max<Quantity>(1, std::stoull(argv[++i]));
+        } else if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " --csv FILE [--csv FILE ...] --out FILE [options]\n";
+            std::cout << "  --csv FILE   Instrument CSV (Symbol/ID, Name, TickSize, LotSize, MinPrice, MaxPrice)\n";
+            std::cout << "  --out FILE   Symbol master to write\n";
+            std::cout << "  --tick X     Tick size for rows without one (default: 0.01)\n";
+            std::cout << "  --lot N      Lot size for rows without one (default: 1)\n";
+            std::cout << "  --help       Show this help message\n";
+            return 0;
+        }
+    }
+    if (inputs.empty() || output.empty()) {
+        std::cerr << "Need --csv and --out (see --help)\n";
+        return 1;
+    }
+
+    std::vector<SymbolDefinition> symbols;
+    for (const std::string& path : inputs) {
+        if (!loadCsv(path, tick_size, lot_size, symbols)) return 1;
+    }
+    auto written = writeSymbolMaster(output, symbols);
+    if (written.isError()) {
+        std::cerr << written.error() << "\n";
+        return 1;
+    }
+
+    InternTable check_table;
+    auto master = SymbolMaster::open(output, check_table);
+    if (master.isError()) {
+        std::cerr << master.error() << "\n";
+        return 1;
+    }
+    for (const SymbolDefinition& definition : symbols) {
+        if (!master.value()->find(definition.symbol)) {
+            std::cerr << "Symbol " << definition.symbol << " does not resolve in " << output << "\n";
+            return 1;
+        }
+    }
+    std::cout << "Wrote " << written.value() << " symbols to " << output << "\n";
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+OrderBookOptions policy(BackpressurePolicy backpressure) {
+    OrderBookOptions options = callerConsumer();
+    options.backpressure = backpressure;
+    return options;
+}
+
+// Fill the shared ring with cheap requests until the policy first refuses one
+size_t fillSharedRing(OrderBook& book) {
+    size_t accepted = 0;
+    while (book.cancelOrder(OrderId(1000000 + accepted)).isSuccess()) {
+        ++accepted;
+    }
+    return accepted;
+}
+
+size_t drain(OrderBook& book) {
+    size_t total = 0;
+    while (size_t processed = book.processPending()) {
+        total += processed;
+    }
+    return total;
+}
+
+}
+
+void testParsePolicy() {
+    std::cout << "Testing backpressure policy names..." << std::endl;
+
+    assert(parseBackpressurePolicy("reject") == BackpressurePolicy::Reject);
+    assert(parseBackpressurePolicy("spin_wait") == BackpressurePolicy::SpinWait);
+    assert(parseBackpressurePolicy("overflow") == BackpressurePolicy::Overflow);
+    assert(!parseBackpressurePolicy("block"));
+
+    std::cout << "Policy name test passed!" << std::endl;
+}
+
+void testRejectWhenFull() {
+    std::cout << "Testing reject policy..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, policy(BackpressurePolicy::Reject));
+    size_t accepted = fillSharedRing(book);
+    OrderQueueStats stats = book.getOrderQueueStats()[0];
+    assert(accepted > 0 && accepted <= stats.capacity);
+    assert(stats.high_water_mark == accepted);
+    assert(stats.full_events == 1 && stats.rejected == 1 && stats.overflowed == 0);
+
+    // Every entry point reports the saturation instead of dropping the request
+    auto add = book.addOrder(limit(1, Side::Buy, 10000, 10));
+    assert(add.isError() && add.errorCode() == ErrorCode::QueueFull);
+    auto modify = book.modifyOrder(OrderId(1), 10100, 10);
+    assert(modify.isError() && modify.errorCode() == ErrorCode::QueueFull);
+    assert(book.getOrderQueueStats()[0].rejected == 3);
+
+    // Draining frees the ring; the refused add never reached the book
+    assert(drain(book) == accepted);
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 10)).isSuccess());
+    drain(book);
+    assert(book.getOrderCount() == 1);
+
+    std::cout << "Reject policy test passed!" << std::endl;
+}
+
+void testOverflowKeepsOrder() {
+    std::cout << "Testing overflow policy..." << std::endl;
+
+    OrderBookOptions options = policy(BackpressurePolicy::Overflow);
+    options.overflow_capacity = 4;
+    OrderBook book(nullptr, nullptr, nullptr, options);
+
+    // Saturate the ring, then let the spill take the rest
+    size_t in_ring = 0;
+    while (book.getOrderQueueStats()[0].full_events == 0) {
+        assert(book.cancelOrder(OrderId(1000000 + in_ring)).isSuccess());
+        ++in_ring;
+    }
+    --in_ring;  // The push that found the ring full went to the overflow
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 10)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Buy, 9900, 10)).isSuccess());
+    // A cancel behind its add in the overflow still applies after it
+    assert(book.cancelOrder(OrderId(1)).isSuccess());
+    auto refused = book.addOrder(limit(3, Side::Buy, 9800, 10));
+    assert(refused.isError() && refused.errorCode() == ErrorCode::QueueFull);
+
+    OrderQueueStats stats = book.getOrderQueueStats()[0];
+    assert(stats.overflowed == 4 && stats.rejected == 1);
+    assert(stats.high_water_mark == stats.capacity + 4);
+
+    assert(drain(book) == in_ring + 4);
+    assert(book.getOrderCount() == 1);
+    assert(book.bestBid() && *book.bestBid() == 9900);
+    // With the overflow emptied, new requests go straight to the ring again
+    assert(book.addOrder(limit(4, Side::Buy, 9700, 10)).isSuccess());
+    assert(book.getOrderQueueStats()[0].overflowed == 4);
+    drain(book);
+    assert(book.getOrderCount() == 2);
+
+    std::cout << "Overflow policy test passed!" << std::endl;
+}
+
+void testSpinWaitBudget() {
+    std::cout << "Testing spin-wait policy..." << std::endl;
+
+    // With nobody draining, the budget runs out and the request is refused
+    OrderBookOptions options = policy(BackpressurePolicy::SpinWait);
+    options.backpressure_spin_budget = 16;
+    OrderBook idle(nullptr, nullptr, nullptr, options);
+    size_t accepted = fillSharedRing(idle);
+    OrderQueueStats stats = idle.getOrderQueueStats()[0];
+    assert(stats.full_events == 1 && stats.rejected == 1);
+    assert(drain(idle) == accepted);
+
+    // A consumer that frees space within the budget lets the spinning producer in
+    options.backpressure_spin_budget = 4000000000u;
+    OrderBook book(nullptr, nullptr, nullptr, options);
+    size_t filled = 0;
+    while (book.getOrderQueueStats()[0].high_water_mark < stats.high_water_mark) {
+        assert(book.cancelOrder(OrderId(1000000 + filled)).isSuccess());
+        ++filled;
+    }
+    std::thread consumer([&book] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        book.processPending();
+    });
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 10)).isSuccess());
+    consumer.join();
+    stats = book.getOrderQueueStats()[0];
+    assert(stats.full_events == 1 && stats.rejected == 0);
+    drain(book);
+    assert(book.getOrderCount() == 1);
+
+    std::cout << "Spin-wait policy test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running backpressure tests..." << std::endl;
+
+    testParsePolicy();
+    testRejectWhenFull();
+    testOverflowKeepsOrder();
+    testSpinWaitBudget();
+
+    std::cout << "\nAll backpressure tests passed successfully!" << std::endl;
+    return 0;
+}
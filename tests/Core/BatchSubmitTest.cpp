@@ -0,0 +1,114 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+// Bids one tick apart below 10000, ids from first
+std::vector<Order> bidLadder(uint64_t first, size_t count) {
+    std::vector<Order> orders;
+    for (size_t i = 0; i < count; ++i) {
+        orders.push_back(limit(first + i, Side::Buy, Price(10000 - i), 10));
+    }
+    return orders;
+}
+
+}
+
+void testBatchAppliesInOrder() {
+    std::cout << "Testing batch add and cancel..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    // Spans several staging chunks, the last one partial
+    std::vector<Order> orders = bidLadder(1, 150);
+    assert(book.addOrders(orders.data(), orders.size()) == orders.size());
+    assert(book.processPending() == orders.size());
+    assert(book.getOrderCount() == 150 && book.getBidLevelCount() == 150);
+    assert(*book.bestBid() == 10000);
+
+    std::vector<OrderId> ids;
+    for (uint64_t id = 1; id <= 100; ++id) ids.push_back(OrderId(id));
+    assert(book.cancelOrders(ids.data(), ids.size()) == ids.size());
+    book.processPending();
+    assert(book.getOrderCount() == 50 && *book.bestBid() == 9900);
+
+    // Batches apply in submission order: the cancels land before the sell that would
+    // otherwise have crossed the remaining bids
+    std::vector<OrderId> rest;
+    for (uint64_t id = 101; id <= 150; ++id) rest.push_back(OrderId(id));
+    assert(book.cancelOrders(rest.data(), rest.size()) == rest.size());
+    Order sell = limit(500, Side::Sell, 9880, 10);
+    assert(book.addOrders(&sell, 1) == 1);
+    assert(book.addOrders(nullptr, 0) == 0);
+    book.processPending();
+    assert(book.getTradeCount() == 0);
+    assert(book.getOrderCount() == 1 && *book.bestAsk() == 9880);
+
+    std::cout << "Batch add and cancel test passed!" << std::endl;
+}
+
+void testBatchReturnsAcceptedPrefix() {
+    std::cout << "Testing partially accepted batch..." << std::endl;
+
+    OrderBookOptions options = callerConsumer();
+    options.backpressure = BackpressurePolicy::Reject;
+    OrderBook book(nullptr, nullptr, nullptr, options);
+    size_t capacity = book.getOrderQueueStats()[0].capacity;
+
+    // Leave exactly 10 free slots, then offer a batch of 40
+    size_t filled = 0;
+    while (book.cancelOrder(OrderId(1000000 + filled)).isSuccess()) ++filled;
+    size_t free_slots = 10;
+    while (book.processPending() > 0) {}
+    for (size_t i = 0; i + free_slots < filled; ++i) {
+        assert(book.cancelOrder(OrderId(2000000 + i)).isSuccess());
+    }
+    std::vector<Order> orders = bidLadder(1, 40);
+    size_t accepted = book.addOrders(orders.data(), orders.size());
+    assert(accepted == free_slots);
+    assert(book.getOrderQueueStats()[0].high_water_mark <= capacity);
+
+    // Exactly the leading entries reach the book; the caller resubmits from there
+    while (book.processPending() > 0) {}
+    assert(book.getOrderCount() == accepted);
+    assert(*book.bestBid() == 10000);
+    assert(book.addOrders(orders.data() + accepted, orders.size() - accepted) == orders.size() - accepted);
+    book.processPending();
+    assert(book.getOrderCount() == orders.size());
+
+    std::cout << "Partially accepted batch test passed!" << std::endl;
+}
+
+void testProducerBatchWakesConsumer() {
+    std::cout << "Testing producer batch on a consumer thread..." << std::endl;
+
+    OrderBook book;
+    auto producer = book.registerProducer();
+    assert(producer.isSuccess());
+    std::vector<Order> orders = bidLadder(1, 300);
+    assert(producer.value().addOrders(orders.data(), orders.size()) == orders.size());
+    std::vector<OrderId> ids;
+    for (uint64_t id = 1; id <= 300; id += 2) ids.push_back(OrderId(id));
+    assert(producer.value().cancelOrders(ids.data(), ids.size()) == ids.size());
+    book.waitForCompletion();
+    assert(book.getOrderCount() == 150);
+    assert(*book.bestBid() == 9999);
+
+    std::cout << "Producer batch test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running batch submit tests..." << std::endl;
+
+    testBatchAppliesInOrder();
+    testBatchReturnsAcceptedPrefix();
+    testProducerBatchWakesConsumer();
+
+    std::cout << "\nAll batch submit tests passed successfully!" << std::endl;
+    return 0;
+}
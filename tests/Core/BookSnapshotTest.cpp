@@ -0,0 +1,190 @@
+#include "orderbook/Core/BookSnapshot.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/ExchangeEngine.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+void assertSameDepth(const MarketDepth& a, const MarketDepth& b) {
+    assert(a.bids.size() == b.bids.size() && a.asks.size() == b.asks.size());
+    for (size_t i = 0; i < a.bids.size(); ++i) {
+        assert(a.bids[i].price == b.bids[i].price && a.bids[i].quantity == b.bids[i].quantity &&
+               a.bids[i].order_count == b.bids[i].order_count);
+    }
+    for (size_t i = 0; i < a.asks.size(); ++i) {
+        assert(a.asks[i].price == b.asks[i].price && a.asks[i].quantity == b.asks[i].quantity &&
+               a.asks[i].order_count == b.asks[i].order_count);
+    }
+}
+
+}
+
+void testSnapshotRoundTrip() {
+    std::cout << "Testing snapshot write and load..." << std::endl;
+
+    auto directory = freshDirectory("snapshot-roundtrip");
+    std::string path = (directory / "book.snap").string();
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    assert(book.addOrder(limit(1, Side::Buy, 9900, 30)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Buy, 9900, 100)).isSuccess());
+    assert(book.addOrder(limit(3, Side::Buy, 9800, 70)).isSuccess());
+    assert(book.addOrder(limit(4, Side::Sell, 10100, 50)).isSuccess());
+    assert(book.addOrder(limit(5, Side::Sell, 10200, 80)).isSuccess());
+    // Leaves order 5 partly filled
+    assert(book.addOrder(limit(6, Side::Buy, 10200, 70)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 2);
+
+    auto written = book.snapshot(path);
+    assert(written.isSuccess());
+    assert(written.value().order_count == 4);
+    assert(written.value().level_count == 3);
+    assert(written.value().trade_count == 2);
+
+    auto mapped = MappedBookSnapshot::open(path);
+    assert(mapped.isSuccess());
+    assert(mapped.value()->info().order_count == 4);
+    assert(mapped.value()->orders()[0].id == 1 && mapped.value()->orders()[1].id == 2);
+
+    OrderBook loaded(nullptr, nullptr, nullptr, callerConsumer());
+    auto info = loaded.loadSnapshot(path);
+    assert(info.isSuccess());
+    assert(loaded.getOrderCount() == 4);
+    assert(loaded.getTradeCount() == 2);
+    assertSameDepth(loaded.getDepth(10), book.getDepth(10));
+    assert(loaded.getDepth(10).asks[0].quantity == 60);
+
+    // Queue order survives: 30 against 9900 fills order 1 and leaves order 2 whole
+    assert(loaded.addOrder(limit(7, Side::Sell, 9900, 30)).isSuccess());
+    loaded.processPending();
+    MarketDepth depth = loaded.getDepth(10);
+    assert(depth.bids[0].price == 9900 && depth.bids[0].quantity == 100 && depth.bids[0].order_count == 1);
+    assert(loaded.getTradeCount() == 3);
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Round trip test passed!" << std::endl;
+}
+
+void testSnapshotThenJournalTail() {
+    std::cout << "Testing snapshot plus journal tail recovery..." << std::endl;
+
+    auto directory = freshDirectory("snapshot-journal");
+    auto journal_directory = directory / "journal";
+    std::string path = (directory / "book.snap").string();
+    {
+        OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+        assert(book.openJournal(journalIn(journal_directory)).isSuccess());
+        assert(book.addOrder(limit(1, Side::Buy, 9900, 100)).isSuccess());
+        assert(book.addOrder(limit(2, Side::Sell, 10100, 100)).isSuccess());
+        book.processPending();
+        auto written = book.snapshot(path);
+        assert(written.isSuccess() && written.value().journal_sequence == 2);
+
+        // After the image: only these come from the journal
+        assert(book.addOrder(limit(3, Side::Buy, 9950, 20)).isSuccess());
+        assert(book.cancelOrder(OrderId(2)).isSuccess());
+        book.processPending();
+        assert(book.getJournalSequence() == 4);
+    }
+
+    OrderBook recovered(nullptr, nullptr, nullptr, callerConsumer());
+    auto info = recovered.loadSnapshot(path);
+    assert(info.isSuccess() && info.value().journal_sequence == 2);
+    auto replayed = recovered.openJournal(journalIn(journal_directory));
+    assert(replayed.isSuccess() && replayed.value() == 2);
+    assert(recovered.getOrderCount() == 2);
+    assert(recovered.bestBid() && *recovered.bestBid() == 9950);
+    assert(!recovered.bestAsk());
+    assert(recovered.getJournalSequence() == 4);
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Snapshot plus journal test passed!" << std::endl;
+}
+
+void testCorruptSnapshotIsRefused() {
+    std::cout << "Testing a corrupted snapshot file..." << std::endl;
+
+    auto directory = freshDirectory("snapshot-corrupt");
+    std::string path = (directory / "book.snap").string();
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    assert(book.addOrder(limit(1, Side::Buy, 9900, 100)).isSuccess());
+    book.processPending();
+    assert(book.snapshot(path).isSuccess());
+
+    // Flip a byte of the first order record, past the header
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(0, std::ios::end);
+        auto size = static_cast<std::streamoff>(file.tellg());
+        assert(size > 128 + 16);
+        file.seekg(128 + 8);
+        char byte = 0;
+        file.get(byte);
+        file.seekp(128 + 8);
+        file.put(static_cast<char>(byte ^ 0x5a));
+    }
+    assert(MappedBookSnapshot::open(path).isError());
+
+    OrderBook loaded(nullptr, nullptr, nullptr, callerConsumer());
+    assert(loaded.loadSnapshot(path).isError());
+    assert(loaded.getOrderCount() == 0);
+    assert(MappedBookSnapshot::open((directory / "missing.snap").string()).isError());
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Corrupt snapshot test passed!" << std::endl;
+}
+
+void testSnapshotWithoutRunningConsumer() {
+    std::cout << "Testing snapshot with an idle consumer waiter..." << std::endl;
+
+    auto directory = freshDirectory("snapshot-idle");
+    std::string path = (directory / "book.snap").string();
+
+    // A waiter nobody loops on: the copy is taken on the calling thread
+    ConsumerWaiter waiter;
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    book.setConsumerWaiter(&waiter);
+    assert(book.addOrder(limit(1, Side::Buy, 9900, 100)).isSuccess());
+    book.processPending();
+    auto written = book.snapshot(path);
+    assert(written.isSuccess() && written.value().order_count == 1);
+
+    // An engine's shard serves the copy while running, and not at all once stopped
+    ExchangeEngine engine;
+    auto symbol = engine.addSymbol("TEST");
+    assert(symbol.isSuccess());
+    OrderBook* shard_book = engine.getBook(symbol.value());
+    assert(shard_book->snapshot(path).isSuccess());
+    engine.start();
+    assert(engine.addOrder(symbol.value(), limit(2, Side::Sell, 10100, 40)).isSuccess());
+    engine.waitForCompletion();
+    written = shard_book->snapshot(path);
+    assert(written.isSuccess() && written.value().order_count == 1);
+    engine.stop();
+    written = shard_book->snapshot(path);
+    assert(written.isSuccess() && written.value().order_count == 1);
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Idle consumer snapshot test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running BookSnapshot tests..." << std::endl;
+
+    testSnapshotRoundTrip();
+    testSnapshotThenJournalTail();
+    testCorruptSnapshotIsRefused();
+    testSnapshotWithoutRunningConsumer();
+
+    std::cout << "\nAll BookSnapshot tests passed successfully!" << std::endl;
+    return 0;
+}
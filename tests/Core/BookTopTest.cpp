@@ -0,0 +1,131 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+void testOnePublishPerDrain() {
+    std::cout << "Testing top-of-book publication..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    uint64_t initial = book.getTopOfBook().version;
+    // An empty drain republishes nothing
+    book.processPending();
+    assert(book.getTopOfBook().version == initial);
+
+    const size_t levels = BookTop::MaxLevels + 5;
+    for (size_t i = 0; i < levels; ++i) {
+        assert(book.addOrder(limit(1 + i, Side::Buy, Price(10000 - i), 10 + i)).isSuccess());
+    }
+    assert(book.addOrder(limit(100, Side::Sell, 10100, 7)).isSuccess());
+    // Queued requests are invisible to readers until the consumer drains them
+    assert(!book.bestBid() && book.getOrderCount() == 0);
+    book.processPending();
+
+    BookTop top = book.getTopOfBook();
+    assert(top.version == initial + 1);
+    assert(top.timestamp != 0);
+    assert(top.bid_count == BookTop::MaxLevels && top.ask_count == 1);
+    assert(top.bid_level_count == levels && top.ask_level_count == 1);
+    assert(top.order_count == levels + 1);
+    for (size_t i = 0; i < top.bid_count; ++i) {
+        assert(top.bids[i].price == Price(10000 - i) && top.bids[i].quantity == 10 + i);
+    }
+    assert(top.asks[0].price == 10100 && top.asks[0].quantity == 7);
+    assert(top.bid_dirty != 0 && top.ask_dirty != 0);
+
+    // The queries read the same snapshot
+    assert(*book.bestBid() == 10000 && *book.bestAsk() == 10100);
+    BestPrices prices = book.getBestPrices();
+    assert(*prices.bid == 10000 && *prices.ask == 10100);
+    MarketDepth depth = book.getDepth(100);
+    assert(depth.bids.size() == BookTop::MaxLevels && depth.asks.size() == 1);
+
+    // Only the touched slot is flagged on the next version
+    assert(book.cancelOrder(OrderId(100)).isSuccess());
+    book.processPending();
+    top = book.getTopOfBook();
+    assert(top.version == initial + 2 && top.ask_count == 0);
+    assert(top.bid_dirty == 0 && (top.ask_dirty & 1) != 0);
+
+    // A drained feed delta publishes too
+    book.applyExternalBookUpdate(BookUpdate(BookUpdate::Type::Add, Side::Sell, 10300, 50, 1, 0));
+    book.poll();
+    assert(book.getTopOfBook().version == initial + 3);
+    assert(book.getAskLevelCount() == 1);
+
+    std::cout << "Top-of-book publication test passed!" << std::endl;
+}
+
+void testReadersSeeConsistentTops() {
+    std::cout << "Testing concurrent top-of-book readers..." << std::endl;
+
+    OrderBook book;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            uint64_t last_version = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                BookTop top = book.getTopOfBook();
+                // Versions only move forward, and each copy is one coherent book
+                assert(top.version >= last_version);
+                last_version = top.version;
+                assert(top.bid_count <= BookTop::MaxLevels && top.ask_count <= BookTop::MaxLevels);
+                assert(top.bid_count <= top.bid_level_count && top.ask_count <= top.ask_level_count);
+                size_t visible = 0;
+                for (size_t i = 0; i < top.bid_count; ++i) {
+                    assert(i == 0 || top.bids[i].price < top.bids[i - 1].price);
+                    visible += top.bids[i].order_count;
+                }
+                for (size_t i = 0; i < top.ask_count; ++i) {
+                    assert(i == 0 || top.asks[i].price > top.asks[i - 1].price);
+                    visible += top.asks[i].order_count;
+                }
+                assert(visible <= top.order_count);
+                if (top.bid_count && top.ask_count) assert(top.bids[0].price < top.asks[0].price);
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // Orders that never cross, added and cancelled in waves
+    uint64_t id = 1;
+    for (int wave = 0; wave < 50; ++wave) {
+        std::vector<uint64_t> ids;
+        for (int i = 0; i < 40; ++i) {
+            Side side = i % 2 ? Side::Sell : Side::Buy;
+            Price price = side == Side::Buy ? Price(10000 - (i + wave) % 25) : Price(10001 + (i + wave) % 25);
+            assert(book.addOrder(limit(id, side, price, 1 + i)).isSuccess());
+            ids.push_back(id++);
+        }
+        for (size_t i = 0; i < ids.size(); i += 2) {
+            assert(book.cancelOrder(OrderId(ids[i])).isSuccess());
+        }
+    }
+    book.waitForCompletion();
+    while (reads.load(std::memory_order_relaxed) < 100) std::this_thread::yield();
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) reader.join();
+
+    BookTop top = book.getTopOfBook();
+    assert(top.order_count == 50 * 20 && book.getOrderCount() == 1000);
+
+    std::cout << "Concurrent reader test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running top-of-book tests..." << std::endl;
+
+    testOnePublishPerDrain();
+    testReadersSeeConsistentTops();
+
+    std::cout << "\nAll top-of-book tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include "orderbook/Core/DepthCache.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+Order resting;
+
+// A level holding one order, or an emptied one when quantity is zero
+PriceLevel level(Price price, Quantity quantity) {
+    PriceLevel result(price);
+    if (quantity > 0) {
+        result.total_quantity = quantity;
+        result.order_count = 1;
+        result.head = result.tail = &resting;
+    }
+    return result;
+}
+
+OrderBookOptions mode(bool ladder) {
+    OrderBookOptions options = callerConsumer();
+    options.ladder_mode = ladder;
+    return options;
+}
+
+}
+
+void testWindowUpdates() {
+    std::cout << "Testing depth cache window updates..." << std::endl;
+
+    DepthCache cache;
+    // Bids arrive in any order and are kept best-first
+    cache.update(Side::Buy, level(9900, 10));
+    cache.update(Side::Buy, level(10000, 20));
+    cache.update(Side::Buy, level(9950, 30));
+    const DepthCache::SideDepth& bids = cache.side(Side::Buy);
+    assert(bids.count == 3 && bids.levels[0].price == 10000 && bids.levels[1].price == 9950);
+    assert(cache.consumeDirty(Side::Buy) == 0b111 && cache.consumeDirty(Side::Buy) == 0);
+
+    // A quantity change flags its slot only; an insert flags it and everything it shifted
+    cache.update(Side::Buy, level(9950, 35));
+    assert(bids.levels[1].quantity == 35 && cache.consumeDirty(Side::Buy) == 0b010);
+    cache.update(Side::Buy, level(9960, 5));
+    assert(bids.levels[1].price == 9960 && cache.consumeDirty(Side::Buy) == 0b1110);
+
+    // Removing an unseen level changes nothing; removing a cached one shifts up
+    cache.update(Side::Buy, level(9000, 0));
+    assert(bids.count == 4 && cache.consumeDirty(Side::Buy) == 0);
+    cache.update(Side::Buy, level(10000, 0));
+    assert(bids.count == 3 && bids.levels[0].price == 9960 && cache.consumeDirty(Side::Buy) == 0b1111);
+    // Nothing lies beyond the window, so it is still complete
+    assert(!cache.stale(Side::Buy));
+
+    // Asks sort the other way, independently of bids
+    cache.update(Side::Sell, level(10200, 1));
+    cache.update(Side::Sell, level(10100, 1));
+    assert(cache.side(Side::Sell).levels[0].price == 10100 && cache.consumeDirty(Side::Sell) == 0b11);
+    assert(cache.consumeDirty(Side::Buy) == 0);
+
+    std::cout << "Depth cache window test passed!" << std::endl;
+}
+
+void testOverflowAndRefill() {
+    std::cout << "Testing depth cache overflow and refill..." << std::endl;
+
+    DepthCache cache;
+    const size_t total = DepthCache::Capacity + 3;
+    for (size_t i = 0; i < total; ++i) cache.update(Side::Sell, level(Price(10100 + i), 1 + i));
+    const DepthCache::SideDepth& asks = cache.side(Side::Sell);
+    assert(asks.count == DepthCache::Capacity && asks.beyond);
+    assert(asks.levels[DepthCache::Capacity - 1].price == Price(10100 + DepthCache::Capacity - 1));
+
+    // A better level pushes the worst cached one out of the window
+    cache.update(Side::Sell, level(10050, 9));
+    assert(asks.count == DepthCache::Capacity && asks.levels[0].price == 10050);
+    cache.consumeDirty(Side::Sell);
+
+    // Emptying a cached level leaves a hole only a walk can fill
+    cache.update(Side::Sell, level(10100, 0));
+    assert(cache.stale(Side::Sell) && asks.count == DepthCache::Capacity - 1);
+    cache.beginRefill(Side::Sell);
+    assert(!cache.stale(Side::Sell) && asks.count == 0);
+    size_t appended = 0;
+    for (size_t i = 0; i < total; ++i) {
+        if (!cache.append(Side::Sell, level(Price(10101 + i), 1))) break;
+        ++appended;
+    }
+    assert(appended == DepthCache::Capacity && asks.beyond && asks.levels[0].price == 10101);
+    assert(cache.consumeDirty(Side::Sell) == (DepthCache::DirtyMask(1) << DepthCache::Capacity) - 1);
+
+    // Invalidation forces both sides to refill; clear leaves an empty, complete window
+    cache.invalidate();
+    assert(cache.stale(Side::Buy) && cache.stale(Side::Sell) && asks.count == 0);
+    cache.clear();
+    assert(!cache.stale(Side::Buy) && !cache.stale(Side::Sell) && !asks.beyond);
+
+    std::cout << "Depth cache overflow test passed!" << std::endl;
+}
+
+void testBookDepthMatchesLevels(bool ladder) {
+    std::cout << "Testing cached book depth" << (ladder ? " (ladder)" : "") << "..." << std::endl;
+
+    // Random resting adds and cancels against a reference book of level totals
+    OrderBook book(nullptr, nullptr, nullptr, mode(ladder));
+    std::map<Price, Quantity, std::greater<Price>> bids;
+    std::map<Price, Quantity> asks;
+    std::vector<uint64_t> ids;
+    std::mt19937 rng(41);
+    uint64_t next_id = 1;
+
+    for (int step = 0; step < 3000; ++step) {
+        if (ids.empty() || rng() % 3 != 0) {
+            bool buy = rng() % 2;
+            Price price = buy ? Price(10000 - rng() % 30) : Price(10001 + rng() % 30);
+            Quantity quantity = 1 + rng() % 20;
+            assert(book.addOrder(limit(next_id, buy ? Side::Buy : Side::Sell, price, quantity)).isSuccess());
+            if (buy) bids[price] += quantity; else asks[price] += quantity;
+            ids.push_back(next_id++);
+        } else {
+            size_t pick = rng() % ids.size();
+            uint64_t id = ids[pick];
+            ids[pick] = ids.back();
+            ids.pop_back();
+            const Order* order = book.getOrderStore().order(OrderId(id));
+            assert(order);
+            auto drop = [&](auto& side) {
+                if ((side[order->price] -= order->quantity) == 0) side.erase(order->price);
+            };
+            if (order->isBuy()) drop(bids); else drop(asks);
+            assert(book.cancelOrder(OrderId(id)).isSuccess());
+        }
+        book.processPending();
+
+        MarketDepth depth = book.getDepth(DepthCache::Capacity);
+        assert(depth.bids.size() == std::min(bids.size(), DepthCache::Capacity));
+        assert(depth.asks.size() == std::min(asks.size(), DepthCache::Capacity));
+        auto bid = bids.begin();
+        for (const auto& cached : depth.bids) {
+            assert(cached.price == bid->first && cached.quantity == bid->second);
+            ++bid;
+        }
+        auto ask = asks.begin();
+        for (const auto& cached : depth.asks) {
+            assert(cached.price == ask->first && cached.quantity == ask->second);
+            ++ask;
+        }
+    }
+
+    std::cout << "Cached book depth test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running depth cache tests..." << std::endl;
+
+    testWindowUpdates();
+    testOverflowAndRefill();
+    testBookDepthMatchesLevels(false);
+    testBookDepthMatchesLevels(true);
+
+    std::cout << "\nAll depth cache tests passed successfully!" << std::endl;
+    return 0;
+}
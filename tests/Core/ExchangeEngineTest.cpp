@@ -0,0 +1,161 @@
+#include "orderbook/Core/ExchangeEngine.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+// Records which thread published each symbol's trades
+struct ThreadRecordingPublisher : IMarketDataPublisher {
+    std::mutex mutex;
+    std::map<SymbolId, std::set<std::thread::id>> trade_threads;
+
+    void publishTrade(const Trade& trade) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        trade_threads[trade.symbol_id].insert(std::this_thread::get_id());
+    }
+    void publishBookUpdate(const BookUpdate&) override {}
+    void publishBestPrices(const BestPrices&) override {}
+    void publishDepth(const MarketDepth&) override {}
+    void subscribe(std::function<void(const std::string&)>) override {}
+};
+
+ExchangeEngineOptions threads(size_t count) {
+    ExchangeEngineOptions options;
+    options.matching_threads = count;
+    return options;
+}
+
+}
+
+void testSymbolsSpreadRoundRobin() {
+    std::cout << "Testing symbol registration and shard assignment..." << std::endl;
+
+    ExchangeEngine engine(nullptr, nullptr, nullptr, threads(2));
+    std::vector<SymbolId> ids;
+    for (const char* symbol : {"XSA", "XSB", "XSC", "XSD"}) {
+        auto added = engine.addSymbol(symbol);
+        assert(added.isSuccess());
+        ids.push_back(added.value());
+    }
+    assert(engine.getSymbolCount() == 4 && engine.getMatchingThreadCount() == 2);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        assert(engine.getShardForSymbol(ids[i]) == i % 2);
+    }
+
+    // Registering again returns the existing book; names resolve only when registered
+    auto again = engine.addSymbol("XSB");
+    assert(again.isSuccess() && again.value() == ids[1]);
+    assert(engine.getSymbolCount() == 4);
+    assert(engine.getBook("XSC") == engine.getBook(ids[2]) && engine.getBook(ids[2]));
+    assert(std::string(engine.getSymbolName(ids[3])) == "XSD");
+    symbolTable().intern("XSZ");
+    assert(!engine.findSymbol("XSZ") && !engine.getBook("XSZ"));
+    assert(engine.addSymbol("").isError());
+
+    // The set of books is fixed once the threads run
+    engine.start();
+    assert(engine.isRunning());
+    assert(engine.addSymbol("XSE").isError());
+    assert(engine.addSymbol("XSA").isSuccess());
+    engine.stop();
+
+    std::cout << "Shard assignment test passed!" << std::endl;
+}
+
+void testOrdersRouteToTheirBook() {
+    std::cout << "Testing order routing by symbol..." << std::endl;
+
+    ExchangeEngine engine(nullptr, nullptr, nullptr, threads(2));
+    SymbolId first = engine.addSymbol("XRA").value();
+    SymbolId second = engine.addSymbol("XRB").value();
+    engine.start();
+
+    assert(engine.addOrder(limit(1, Side::Buy, 10000, 10, "XRA")).isSuccess());
+    assert(engine.addOrder(limit(2, Side::Buy, 9900, 10, "XRA")).isSuccess());
+    assert(engine.addOrder(second, limit(3, Side::Sell, 20000, 10, "XRB")).isSuccess());
+    assert(engine.addOrder(limit(4, Side::Buy, 10000, 10, "XRU")).isError());
+    assert(engine.cancelOrder(SymbolId(60000), OrderId(1)).isError());
+    engine.waitForCompletion();
+
+    assert(engine.getBook(first)->getOrderCount() == 2);
+    assert(engine.getBook(second)->getOrderCount() == 1);
+    assert(*engine.getBook(first)->bestBid() == 10000);
+    assert(!engine.getBook(second)->bestBid() && *engine.getBook(second)->bestAsk() == 20000);
+
+    // Cancel and modify go to the named book only
+    assert(engine.cancelOrder(first, OrderId(2)).isSuccess());
+    assert(engine.modifyOrder(second, OrderId(3), 19900, 10).isSuccess());
+    engine.waitForCompletion();
+    assert(engine.getBook(first)->getOrderCount() == 1);
+    assert(*engine.getBook(second)->bestAsk() == 19900);
+    engine.stop();
+
+    std::cout << "Order routing test passed!" << std::endl;
+}
+
+void testShardsMatchOnTheirOwnThreads() {
+    std::cout << "Testing per-shard matching threads..." << std::endl;
+
+    auto publisher = std::make_shared<ThreadRecordingPublisher>();
+    ExchangeEngine engine(nullptr, publisher, nullptr, threads(2));
+    std::vector<SymbolId> ids;
+    for (const char* symbol : {"XTA", "XTB", "XTC", "XTD"}) {
+        ids.push_back(engine.addSymbol(symbol).value());
+    }
+    engine.start();
+
+    // One producer thread per symbol, each with its own ring into the book
+    std::vector<std::thread> producers;
+    for (size_t s = 0; s < ids.size(); ++s) {
+        producers.emplace_back([&engine, &ids, s] {
+            auto producer = engine.registerProducer(ids[s]);
+            assert(producer.isSuccess());
+            const char* symbol = engine.getSymbolName(ids[s]);
+            for (uint64_t i = 0; i < 200; ++i) {
+                uint64_t id = (s + 1) * 10000 + i * 2;
+                assert(producer.value().addOrder(limit(id, Side::Sell, 10000, 5, symbol)).isSuccess());
+                assert(producer.value().addOrder(limit(id + 1, Side::Buy, 10000, 5, symbol)).isSuccess());
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    engine.waitForCompletion();
+
+    std::set<std::thread::id> seen;
+    for (size_t s = 0; s < ids.size(); ++s) {
+        OrderBook* book = engine.getBook(ids[s]);
+        assert(book->getTradeCount() == 200 && book->getOrderCount() == 0);
+        // Every trade of a book comes from the one thread that owns its shard
+        const auto& publishers = publisher->trade_threads[ids[s]];
+        assert(publishers.size() == 1 && *publishers.begin() != std::this_thread::get_id());
+        seen.insert(*publishers.begin());
+    }
+    // Symbols sharing a shard share its thread; the two shards are distinct threads
+    assert(seen.size() == 2);
+    assert(publisher->trade_threads[ids[0]] == publisher->trade_threads[ids[2]]);
+    assert(publisher->trade_threads[ids[1]] == publisher->trade_threads[ids[3]]);
+    engine.stop();
+
+    std::cout << "Per-shard matching test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running exchange engine tests..." << std::endl;
+
+    testSymbolsSpreadRoundRobin();
+    testOrdersRouteToTheirBook();
+    testShardsMatchOnTheirOwnThreads();
+
+    std::cout << "\nAll exchange engine tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+BookUpdate level(BookUpdate::Type type, Side side, Price price, Quantity quantity, size_t orders) {
+    return BookUpdate(type, side, price, quantity, orders, 0);
+}
+
+}
+
+void testDeltaReachesBookOnDrain() {
+    std::cout << "Testing external book updates applied by processPending..." << std::endl;
+
+    // Feed levels carry no orders of ours, so they show in the level counts, not the top
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    BookUpdate delta[] = {
+        level(BookUpdate::Type::Add, Side::Buy, 9900, 300, 3),
+        level(BookUpdate::Type::Add, Side::Buy, 9800, 100, 1),
+        level(BookUpdate::Type::Add, Side::Sell, 10100, 200, 2),
+    };
+    assert(book.applyExternalBookUpdates(delta, 3) == 3);
+    // Queued only: nothing is applied until the consumer drains
+    assert(book.getBidLevelCount() == 0 && book.getAskLevelCount() == 0);
+    book.processPending();
+    assert(book.getBidLevelCount() == 2 && book.getAskLevelCount() == 1);
+
+    book.applyExternalBookUpdate(level(BookUpdate::Type::Remove, Side::Sell, 10100, 0, 0));
+    book.processPending();
+    assert(book.getAskLevelCount() == 0);
+
+    // A full snapshot clears the book, resting orders included, then adds its levels
+    assert(book.addOrder(limit(1, Side::Buy, 9950, 10)).isSuccess());
+    book.processPending();
+    assert(book.getOrderCount() == 1 && book.bestBid() && *book.bestBid() == 9950);
+    MarketDepth image;
+    image.bids.push_back({9700, 50, 1});
+    image.asks.push_back({9750, 80, 2});
+    book.applyExternalMarketData(image);
+    book.processPending();
+    assert(book.getOrderCount() == 0 && !book.bestBid());
+    assert(book.getBidLevelCount() == 1 && book.getAskLevelCount() == 1);
+
+    std::cout << "External delta test passed!" << std::endl;
+}
+
+void testFeedWakesConsumerThread() {
+    std::cout << "Testing external book updates on a consumer thread..." << std::endl;
+
+    OrderBook book;
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 40)).isSuccess());
+    book.waitForCompletion();
+    assert(book.getOrderCount() == 1);
+
+    // Nothing else is submitted: the queued clear alone has to wake the consumer
+    book.clearBook();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (book.getOrderCount() != 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(book.getOrderCount() == 0);
+
+    std::cout << "Consumer thread feed test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running external book tests..." << std::endl;
+
+    testDeltaReachesBookOnDrain();
+    testFeedWakesConsumerThread();
+
+    std::cout << "\nAll external book tests passed successfully!" << std::endl;
+    return 0;
+}
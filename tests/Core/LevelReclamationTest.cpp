@@ -0,0 +1,108 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+void testBestLevelIsPopped() {
+    std::cout << "Testing emptied best level reclamation..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 10)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Buy, 9900, 10)).isSuccess());
+    assert(book.addOrder(limit(3, Side::Buy, 9800, 10)).isSuccess());
+    book.processPending();
+    assert(book.getBidLevelCount() == 3);
+
+    // The best level comes off the back of the vector, no tombstone left behind
+    assert(book.cancelOrder(OrderId(1)).isSuccess());
+    book.processPending();
+    assert(book.getBidLevelCount() == 2 && book.getTombstoneLevelCount() == 0);
+    assert(book.bestBid() && *book.bestBid() == 9900);
+
+    // A deeper level is only flagged, and is reused in place when its price returns
+    assert(book.cancelOrder(OrderId(3)).isSuccess());
+    book.processPending();
+    assert(book.getBidLevelCount() == 2 && book.getTombstoneLevelCount() == 1);
+    assert(book.addOrder(limit(4, Side::Buy, 9800, 20)).isSuccess());
+    book.processPending();
+    assert(book.getBidLevelCount() == 2 && book.getTombstoneLevelCount() == 0);
+
+    // Emptying the best level also pops the tombstones it exposes
+    assert(book.cancelOrder(OrderId(4)).isSuccess());
+    book.processPending();
+    assert(book.getTombstoneLevelCount() == 1);
+    assert(book.cancelOrder(OrderId(2)).isSuccess());
+    book.processPending();
+    assert(book.getBidLevelCount() == 0 && book.getTombstoneLevelCount() == 0);
+    assert(!book.bestBid());
+
+    std::cout << "Best level reclamation test passed!" << std::endl;
+}
+
+void testTombstonesCompactWhenIdle() {
+    std::cout << "Testing tombstone compaction..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    const uint64_t deep = 300;
+    assert(book.addOrder(limit(1, Side::Sell, 10000, 10)).isSuccess());
+    for (uint64_t i = 0; i < deep; ++i) {
+        assert(book.addOrder(limit(2 + i, Side::Sell, Price(10001 + i), 10)).isSuccess());
+    }
+    book.processPending();
+    assert(book.getAskLevelCount() == deep + 1);
+
+    // Cancelling every level behind the best one crosses the compaction threshold
+    for (uint64_t i = 0; i < deep; ++i) {
+        assert(book.cancelOrder(OrderId(2 + i)).isSuccess());
+    }
+    book.processPending();
+    assert(book.getTombstoneLevelCount() == 0);
+    assert(book.getOrderCount() == 1);
+    assert(book.bestAsk() && *book.bestAsk() == 10000);
+
+    // The compacted prices can be created again
+    assert(book.addOrder(limit(1000, Side::Sell, 10005, 10)).isSuccess());
+    book.processPending();
+    assert(book.getAskLevelCount() == 2);
+    MarketDepth depth = book.getDepth(5);
+    assert(depth.asks.size() == 2 && depth.asks[1].price == 10005);
+
+    std::cout << "Tombstone compaction test passed!" << std::endl;
+}
+
+void testTombstonedBidDoesNotServeAsk() {
+    std::cout << "Testing per-side price index..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 100)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Buy, 9900, 10)).isSuccess());
+    assert(book.cancelOrder(OrderId(2)).isSuccess());
+    book.processPending();
+    assert(book.getTombstoneLevelCount() == 1);
+
+    // Sweeps the live bid, then rests at the tombstoned bid's price on its own side
+    assert(book.addOrder(limit(3, Side::Sell, 9900, 150)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 1);
+    assert(!book.bestBid());
+    assert(book.bestAsk() && *book.bestAsk() == 9900);
+    assert(book.getAskLevelCount() == 1);
+    MarketDepth depth = book.getDepth(1);
+    assert(depth.asks.size() == 1 && depth.asks[0].quantity == 50);
+
+    std::cout << "Per-side price index test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running level reclamation tests..." << std::endl;
+
+    testBestLevelIsPopped();
+    testTombstonesCompactWhenIdle();
+    testTombstonedBidDoesNotServeAsk();
+
+    std::cout << "\nAll level reclamation tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -11,7 +11,7 @@ namespace orderbook {
 class TestMarketDataSubscriber : public IMarketDataSubscriber {
 public:
     void onTrade(const Trade& trade, SequenceNumber sequence) override {
-        std::cout << "TRADE [" << sequence << "]: " << trade.symbol 
+        std::cout << "TRADE [" << sequence << "]: " << trade.symbol() 
                   << " " << trade.quantity << "@" << trade.price 
                   << " (Buy: " << trade.buy_order_id.value 
                   << ", Sell: " << trade.sell_order_id.value << ")" << std::endl;
@@ -72,39 +72,41 @@ void testMarketDataIntegration() {
     // Note: In a real implementation, we'd need a way to access the publisher
     // For now, we'll demonstrate the functionality through order operations
     
+    const PriceScale& scale = orderbook->getPriceScale();
+    
     std::cout << "\n1. Adding buy orders..." << std::endl;
     
     // Add some buy orders
     Order buy1(OrderId(1), Side::Buy, OrderType::Limit, TimeInForce::GTC, 
-               100.0, 1000, "AAPL", "account1");
+               scale.toTicks(100.0), 1000, "AAPL", "account1");
     auto result1 = orderbook->addOrder(buy1);
     
     Order buy2(OrderId(2), Side::Buy, OrderType::Limit, TimeInForce::GTC, 
-               99.5, 500, "AAPL", "account1");
+               scale.toTicks(99.5), 500, "AAPL", "account1");
     auto result2 = orderbook->addOrder(buy2);
     
     std::cout << "\n2. Adding sell orders..." << std::endl;
     
     // Add some sell orders
     Order sell1(OrderId(3), Side::Sell, OrderType::Limit, TimeInForce::GTC, 
-                101.0, 800, "AAPL", "account2");
+                scale.toTicks(101.0), 800, "AAPL", "account2");
     auto result3 = orderbook->addOrder(sell1);
     
     Order sell2(OrderId(4), Side::Sell, OrderType::Limit, TimeInForce::GTC, 
-                101.5, 300, "AAPL", "account2");
+                scale.toTicks(101.5), 300, "AAPL", "account2");
     auto result4 = orderbook->addOrder(sell2);
     
     std::cout << "\n3. Adding matching order (should trigger trade)..." << std::endl;
     
     // Add a buy order that should match with sell1
     Order buy3(OrderId(5), Side::Buy, OrderType::Limit, TimeInForce::GTC, 
-               101.0, 600, "AAPL", "account3");
+               scale.toTicks(101.0), 600, "AAPL", "account3");
     auto result5 = orderbook->addOrder(buy3);
     
     std::cout << "\n4. Modifying an order..." << std::endl;
     
     // Modify an existing order
-    auto modify_result = orderbook->modifyOrder(OrderId(2), 99.8, 750);
+    auto modify_result = orderbook->modifyOrder(OrderId(2), scale.toTicks(99.8), 750);
     
     std::cout << "\n5. Canceling an order..." << std::endl;
     
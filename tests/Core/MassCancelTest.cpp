@@ -0,0 +1,111 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/InternTable.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+struct RecordingPublisher : IMarketDataPublisher {
+    std::vector<BookUpdate> updates;
+
+    void publishTrade(const Trade&) override {}
+    void publishBookUpdate(const BookUpdate& update) override { updates.push_back(update); }
+    void publishBestPrices(const BestPrices&) override {}
+    void publishDepth(const MarketDepth&) override {}
+    void subscribe(std::function<void(const std::string&)>) override {}
+};
+
+bool rests(const OrderBook& book, uint64_t id) {
+    const OrderStore& orders = book.getOrderStore();
+    return orders.find(OrderId(id)) != orders.end();
+}
+
+}
+
+void testSymbolCancelLeavesOtherSymbols() {
+    std::cout << "Testing symbol-scoped mass cancel..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 100, "MCXA")).isSuccess());
+    assert(book.addOrder(limit(2, Side::Buy, 10000, 50, "MCXB")).isSuccess());
+    assert(book.addOrder(limit(3, Side::Sell, 10200, 100, "MCXA")).isSuccess());
+    assert(book.addOrder(limit(4, Side::Buy, 9900, 100, "MCXA")).isSuccess());
+    assert(book.addOrder(limit(5, Side::Sell, 10300, 70, "MCXB")).isSuccess());
+    book.processPending();
+    assert(book.getOrderCount() == 5);
+
+    assert(book.cancelAll(MassCancel::symbol(symbolTable().intern("MCXA"))).isSuccess());
+    book.processPending();
+
+    // Only the other symbol's orders are left, at their own levels
+    assert(book.getOrderCount() == 2);
+    assert(rests(book, 2) && rests(book, 5));
+    assert(!rests(book, 1) && !rests(book, 3) && !rests(book, 4));
+    assert(book.bestBid() && *book.bestBid() == 10000);
+    assert(book.bestAsk() && *book.bestAsk() == 10300);
+    assert(book.getBidLevelCount() - book.getTombstoneLevelCount() == 1);
+
+    // A second cancel finds nothing; orders added afterwards are indexed again
+    assert(book.cancelAll(MassCancel::symbol(symbolTable().intern("MCXA"))).isSuccess());
+    assert(book.addOrder(limit(6, Side::Buy, 9800, 10, "MCXA")).isSuccess());
+    book.processPending();
+    assert(book.getOrderCount() == 3);
+    assert(book.cancelAll(MassCancel::symbol(symbolTable().intern("MCXB"))).isSuccess());
+    book.processPending();
+    assert(book.getOrderCount() == 1 && rests(book, 6));
+
+    std::cout << "Symbol-scoped mass cancel test passed!" << std::endl;
+}
+
+void testRemovesPublishInSideAndPriceOrder() {
+    std::cout << "Testing mass cancel update order..." << std::endl;
+
+    auto publisher = std::make_shared<RecordingPublisher>();
+    OrderBook book(nullptr, publisher, nullptr, callerConsumer());
+    // Added out of price order so levels are not allocated in the order they sort
+    Price bids[] = {9800, 10000, 9900};
+    Price asks[] = {10300, 10100, 10200};
+    uint64_t id = 1;
+    for (Price price : bids) assert(book.addOrder(limit(id++, Side::Buy, price, 10, "MCXO", "mass-cancel")).isSuccess());
+    for (Price price : asks) assert(book.addOrder(limit(id++, Side::Sell, price, 10, "MCXO", "mass-cancel")).isSuccess());
+    // A second order at one bid level leaves it partly emptied by the account cancel
+    assert(book.addOrder(limit(id++, Side::Buy, 9900, 5, "MCXO", "other-account")).isSuccess());
+    book.processPending();
+    publisher->updates.clear();
+
+    assert(book.cancelAll(MassCancel::account(accountTable().intern("mass-cancel"))).isSuccess());
+    book.processPending();
+
+    std::vector<BookUpdate> removes;
+    for (const BookUpdate& update : publisher->updates) {
+        if (update.type == BookUpdate::Type::Remove) removes.push_back(update);
+    }
+    assert(removes.size() == 6);
+    Price expected[] = {9800, 9900, 10000, 10100, 10200, 10300};
+    for (size_t i = 0; i < removes.size(); ++i) {
+        assert(removes[i].side == (i < 3 ? Side::Buy : Side::Sell));
+        assert(removes[i].price == expected[i]);
+        assert(i == 0 || removes[i].sequence > removes[i - 1].sequence);
+    }
+    // The shared level reports what is left on it
+    assert(removes[1].quantity == 5 && removes[1].order_count == 1);
+    assert(book.getOrderCount() == 1);
+
+    std::cout << "Mass cancel update order test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running mass cancel tests..." << std::endl;
+
+    testSymbolCancelLeavesOtherSymbols();
+    testRemovesPublishInSideAndPriceOrder();
+
+    std::cout << "\nAll mass cancel tests passed successfully!" << std::endl;
+    return 0;
+}
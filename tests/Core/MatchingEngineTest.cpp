@@ -15,36 +15,38 @@ void testBasicMatching() {
     // Create matching engine
     MatchingEngine engine(logger);
     
-    // Create orders
-    Order buy_order(1, Side::Buy, OrderType::Limit, 100.0, 50, "AAPL", "account1");
-    Order sell_order(2, Side::Sell, OrderType::Limit, 99.0, 30, "AAPL", "account2");
+    // Create orders (prices in ticks)
+    Order buy_order(1, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10000, 50, "AAPL", "account1");
+    Order sell_order(2, Side::Sell, OrderType::Limit, TimeInForce::GTC, 9900, 30, "AAPL", "account2");
     
-    // Create price levels
+    // Create price levels (best first)
     std::vector<PriceLevel> ask_levels;
-    ask_levels.emplace_back(99.0);
+    ask_levels.emplace_back(9900);
     ask_levels.back().addOrder(&sell_order);
     
     // Match buy order against ask levels
-    MatchResult result = engine.matchBuyOrder(buy_order, ask_levels);
+    FillBuffer<8> fills;
+    MatchResult result = engine.matchLevels(buy_order, ask_levels, fills);
     
     // Verify results
     assert(result.hasTrades());
     assert(result.getTradeCount() == 1);
     assert(result.total_filled_quantity == 30);
     assert(!result.fully_filled);
-    assert(result.hasRemainingOrder());
-    assert(result.hasExecutionReports());
+    assert(buy_order.remainingQuantity() == 20);
+    assert(sell_order.isFullyFilled());
+    assert(ask_levels[0].isEmpty());
     
     // Verify trade details
-    const Trade& trade = result.trades[0];
+    assert(fills.size() == 1);
+    Trade trade = MatchingEngine::makeTrade(TradeId(1), buy_order, fills[0]);
     assert(trade.buy_order_id == OrderId(1));
     assert(trade.sell_order_id == OrderId(2));
-    assert(trade.price == 99.0);
+    assert(trade.price == 9900);
     assert(trade.quantity == 30);
     
-    // Verify execution report
-    assert(result.execution_reports.size() == 1);
-    const ExecutionReport& report = result.execution_reports[0];
+    // Verify execution report for the aggressive side
+    ExecutionReport report = MatchingEngine::generateExecutionReport(buy_order, trade.id);
     assert(report.order_id == OrderId(1));
     assert(report.exec_type == ExecutionReport::ExecType::PartialFill);
     assert(report.filled_quantity == 30);
@@ -60,27 +62,26 @@ void testFullFill() {
     MatchingEngine engine(logger);
     
     // Create orders with exact matching quantities
-    Order buy_order(3, Side::Buy, OrderType::Limit, 100.0, 50, "AAPL", "account1");
-    Order sell_order(4, Side::Sell, OrderType::Limit, 99.0, 50, "AAPL", "account2");
+    Order buy_order(3, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10000, 50, "AAPL", "account1");
+    Order sell_order(4, Side::Sell, OrderType::Limit, TimeInForce::GTC, 9900, 50, "AAPL", "account2");
     
     // Create price levels
     std::vector<PriceLevel> ask_levels;
-    ask_levels.emplace_back(99.0);
+    ask_levels.emplace_back(9900);
     ask_levels.back().addOrder(&sell_order);
     
     // Match buy order
-    MatchResult result = engine.matchBuyOrder(buy_order, ask_levels);
+    FillBuffer<8> fills;
+    MatchResult result = engine.matchLevels(buy_order, ask_levels, fills);
     
     // Verify full fill
     assert(result.hasTrades());
     assert(result.getTradeCount() == 1);
     assert(result.total_filled_quantity == 50);
     assert(result.fully_filled);
-    assert(!result.hasRemainingOrder());
     
     // Verify execution report shows full fill
-    assert(result.execution_reports.size() == 1);
-    const ExecutionReport& report = result.execution_reports[0];
+    ExecutionReport report = MatchingEngine::generateExecutionReport(buy_order);
     assert(report.exec_type == ExecutionReport::ExecType::Fill);
     assert(report.filled_quantity == 50);
     assert(report.leaves_quantity == 0);
@@ -95,24 +96,25 @@ void testMultiplePriceLevels() {
     MatchingEngine engine(logger);
     
     // Create large buy order
-    Order buy_order(5, Side::Buy, OrderType::Limit, 102.0, 100, "AAPL", "account1");
+    Order buy_order(5, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10200, 100, "AAPL", "account1");
     
     // Create multiple sell orders at different prices
-    Order sell_order1(6, Side::Sell, OrderType::Limit, 99.0, 30, "AAPL", "account2");
-    Order sell_order2(7, Side::Sell, OrderType::Limit, 100.0, 40, "AAPL", "account3");
-    Order sell_order3(8, Side::Sell, OrderType::Limit, 101.0, 50, "AAPL", "account4");
+    Order sell_order1(6, Side::Sell, OrderType::Limit, TimeInForce::GTC, 9900, 30, "AAPL", "account2");
+    Order sell_order2(7, Side::Sell, OrderType::Limit, TimeInForce::GTC, 10000, 40, "AAPL", "account3");
+    Order sell_order3(8, Side::Sell, OrderType::Limit, TimeInForce::GTC, 10100, 50, "AAPL", "account4");
     
     // Create price levels
     std::vector<PriceLevel> ask_levels;
-    ask_levels.emplace_back(99.0);
+    ask_levels.emplace_back(9900);
     ask_levels.back().addOrder(&sell_order1);
-    ask_levels.emplace_back(100.0);
+    ask_levels.emplace_back(10000);
     ask_levels.back().addOrder(&sell_order2);
-    ask_levels.emplace_back(101.0);
+    ask_levels.emplace_back(10100);
     ask_levels.back().addOrder(&sell_order3);
     
     // Match buy order
-    MatchResult result = engine.matchBuyOrder(buy_order, ask_levels);
+    FillBuffer<8> fills;
+    MatchResult result = engine.matchLevels(buy_order, ask_levels, fills);
     
     // Verify multiple trades
     assert(result.hasTrades());
@@ -121,23 +123,64 @@ void testMultiplePriceLevels() {
     assert(result.fully_filled);
     
     // Verify trades are at correct prices (price-time priority)
-    assert(result.trades[0].price == 99.0);
-    assert(result.trades[0].quantity == 30);
-    assert(result.trades[1].price == 100.0);
-    assert(result.trades[1].quantity == 40);
-    assert(result.trades[2].price == 101.0);
-    assert(result.trades[2].quantity == 30);
+    assert(fills[0].price == 9900);
+    assert(fills[0].quantity == 30);
+    assert(fills[1].price == 10000);
+    assert(fills[1].quantity == 40);
+    assert(fills[2].price == 10100);
+    assert(fills[2].quantity == 30);
+    assert(ask_levels[2].getTotalQuantity() == 20);
     
     std::cout << "Multiple price levels test passed!" << std::endl;
 }
 
+void testPriceLimitAndBufferCapacity() {
+    std::cout << "Testing price limit and fill buffer capacity..." << std::endl;
+    
+    MatchingEngine engine;
+    
+    Order sell_a(10, Side::Sell, OrderType::Limit, TimeInForce::GTC, 10000, 10, "AAPL", "account2");
+    Order sell_b(11, Side::Sell, OrderType::Limit, TimeInForce::GTC, 10000, 10, "AAPL", "account3");
+    Order sell_c(12, Side::Sell, OrderType::Limit, TimeInForce::GTC, 10100, 10, "AAPL", "account4");
+    std::vector<PriceLevel> ask_levels;
+    ask_levels.emplace_back(10000);
+    ask_levels.back().addOrder(&sell_a);
+    ask_levels.back().addOrder(&sell_b);
+    ask_levels.emplace_back(10100);
+    ask_levels.back().addOrder(&sell_c);
+    
+    // Limit below the second level: only the first level trades
+    Order buy_limited(13, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10050, 100, "AAPL", "account1");
+    FillBuffer<8> fills;
+    MatchResult result = engine.matchLevels(buy_limited, ask_levels, fills);
+    assert(result.getTradeCount() == 2);
+    assert(result.total_filled_quantity == 20);
+    assert(fills[0].passive == &sell_a);
+    assert(fills[1].passive == &sell_b);
+    assert(ask_levels[1].getTotalQuantity() == 10);
+    
+    // A full buffer stops matching without losing the fill that filled it
+    Order sell_d(14, Side::Sell, OrderType::Limit, TimeInForce::GTC, 10100, 10, "AAPL", "account5");
+    ask_levels[1].addOrder(&sell_d);
+    Order buy_wide(15, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10200, 100, "AAPL", "account1");
+    FillBuffer<1> one_fill;
+    result = engine.matchLevels(buy_wide, ask_levels, one_fill);
+    assert(one_fill.full());
+    assert(result.getTradeCount() == 1);
+    assert(one_fill[0].passive == &sell_c);
+    assert(buy_wide.remainingQuantity() == 90);
+    assert(ask_levels[1].getFirstOrder() == &sell_d);
+    
+    std::cout << "Price limit and buffer capacity test passed!" << std::endl;
+}
+
 void testExecutionReportGeneration() {
     std::cout << "Testing execution report generation..." << std::endl;
     
     MatchingEngine engine;
     
     // Test new order report
-    Order order(9, Side::Buy, OrderType::Limit, 100.0, 50, "AAPL", "account1");
+    Order order(9, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10000, 50, "AAPL", "account1");
     ExecutionReport new_report = MatchingEngine::generateNewOrderReport(order);
     
     assert(new_report.order_id == OrderId(9));
@@ -166,6 +209,7 @@ int main() {
         testBasicMatching();
         testFullFill();
         testMultiplePriceLevels();
+        testPriceLimitAndBufferCapacity();
         testExecutionReportGeneration();
         
         std::cout << "\nAll MatchingEngine tests passed successfully!" << std::endl;
@@ -0,0 +1,127 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/MatchingEngine.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+static_assert(SideTraits<Side::Buy>::opposite == Side::Sell && SideTraits<Side::Sell>::opposite == Side::Buy,
+              "each aggressor side matches the other");
+static_assert(SideTraits<Side::Buy>::crosses(10000, 10000) && !SideTraits<Side::Buy>::crosses(9999, 10000),
+              "a buy reaches asks at or below its limit");
+static_assert(SideTraits<Side::Sell>::crosses(10000, 10000) && !SideTraits<Side::Sell>::crosses(10001, 10000),
+              "a sell reaches bids at or above its limit");
+
+// Buy ID, sell ID, price, quantity: trade IDs are process-wide, so left out
+using Execution = std::tuple<OrderId, OrderId, Price, Quantity>;
+
+struct TradeRecorder : IMarketDataPublisher {
+    std::vector<Execution> fills;
+
+    void publishTrade(const Trade& trade) override {
+        fills.emplace_back(trade.buy_order_id, trade.sell_order_id, trade.price, trade.quantity);
+    }
+    void publishBookUpdate(const BookUpdate&) override {}
+    void publishBestPrices(const BestPrices&) override {}
+    void publishDepth(const MarketDepth&) override {}
+    void subscribe(std::function<void(const std::string&)>) override {}
+};
+
+OrderBookOptions mode(bool ladder) {
+    OrderBookOptions options = callerConsumer();
+    options.ladder_mode = ladder;
+    return options;
+}
+
+}
+
+void testSweepsBothSides(bool ladder) {
+    std::cout << "Testing aggressor sweeps" << (ladder ? " (ladder)" : "") << "..." << std::endl;
+
+    auto recorder = std::make_shared<TradeRecorder>();
+    OrderBook book(nullptr, recorder, nullptr, mode(ladder));
+    for (uint64_t i = 0; i < 3; ++i) {
+        assert(book.addOrder(limit(1 + i, Side::Sell, Price(10100 + i), 10)).isSuccess());
+        assert(book.addOrder(limit(11 + i, Side::Buy, Price(9900 - i), 10)).isSuccess());
+    }
+    // Second order at the best ask queues behind the first
+    assert(book.addOrder(limit(4, Side::Sell, 10100, 5)).isSuccess());
+
+    // A buy walks asks upwards to its limit, in time priority within a level
+    assert(book.addOrder(limit(20, Side::Buy, 10101, 22)).isSuccess());
+    book.processPending();
+    std::vector<Execution> expected = {
+        {OrderId(20), OrderId(1), 10100, 10},
+        {OrderId(20), OrderId(4), 10100, 5},
+        {OrderId(20), OrderId(2), 10101, 7},
+    };
+    assert(recorder->fills == expected);
+    assert(*book.bestAsk() == 10101 && *book.bestBid() == 9900);
+
+    // A sell walks bids downwards; the unfilled remainder rests at its limit
+    recorder->fills.clear();
+    assert(book.addOrder(limit(21, Side::Sell, 9899, 25)).isSuccess());
+    book.processPending();
+    expected = {
+        {OrderId(11), OrderId(21), 9900, 10},
+        {OrderId(12), OrderId(21), 9899, 10},
+    };
+    assert(recorder->fills == expected);
+    assert(*book.bestAsk() == 9899 && *book.bestBid() == 9898);
+
+    std::cout << "Aggressor sweep test passed!" << std::endl;
+}
+
+void testStorageModesAgree() {
+    std::cout << "Testing sorted and ladder matching agree..." << std::endl;
+
+    // The same crossing flow through both level stores produces the same fills
+    auto sorted_trades = std::make_shared<TradeRecorder>();
+    auto ladder_trades = std::make_shared<TradeRecorder>();
+    OrderBook sorted(nullptr, sorted_trades, nullptr, mode(false));
+    OrderBook ladder(nullptr, ladder_trades, nullptr, mode(true));
+    std::mt19937 rng(46);
+    for (uint64_t id = 1; id <= 5000; ++id) {
+        Side side = rng() % 2 ? Side::Buy : Side::Sell;
+        Price price = Price(9980 + rng() % 41);
+        Quantity quantity = 1 + rng() % 50;
+        TimeInForce tif = rng() % 10 == 0 ? TimeInForce::IOC : TimeInForce::GTC;
+        OrderType type = rng() % 25 == 0 ? OrderType::Market : OrderType::Limit;
+        for (OrderBook* book : {&sorted, &ladder}) {
+            assert(book->addOrder(Order(id, side, type, tif, price, quantity, "TEST", "test-account")).isSuccess());
+        }
+        if (id % 64 == 0) {
+            sorted.processPending();
+            ladder.processPending();
+        }
+    }
+    sorted.processPending();
+    ladder.processPending();
+
+    assert(!sorted_trades->fills.empty());
+    assert(sorted_trades->fills == ladder_trades->fills);
+    assert(sorted.getOrderCount() == ladder.getOrderCount());
+    assert(*sorted.bestBid() == *ladder.bestBid() && *sorted.bestAsk() == *ladder.bestAsk());
+    assert(*sorted.bestBid() < *sorted.bestAsk());
+
+    std::cout << "Storage mode agreement test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running matching path tests..." << std::endl;
+
+    testSweepsBothSides(false);
+    testSweepsBothSides(true);
+    testStorageModesAgree();
+
+    std::cout << "\nAll matching path tests passed successfully!" << std::endl;
+    return 0;
+}
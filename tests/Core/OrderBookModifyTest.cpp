@@ -0,0 +1,86 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+
+using namespace orderbook;
+using testing::limit;
+
+namespace {
+
+OrderBookOptions callerConsumer(bool ladder) {
+    OrderBookOptions options = testing::callerConsumer();
+    options.ladder_mode = ladder;
+    return options;
+}
+
+}
+
+void testRepriceToUnreachableLevelIsDropped() {
+    std::cout << "Testing reprice to a level the ladder cannot hold..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer(true));
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 100)).isSuccess());
+    book.processPending();
+
+    // Far outside PriceLadder::MaxLevels of the resting bid: no level, no change
+    assert(book.modifyOrder(OrderId(1), 10000 + Price(PriceLadder::MaxLevels) + 1, 0).isSuccess());
+    book.processPending();
+    assert(book.getOrderCount() == 1);
+    assert(book.bestBid() && *book.bestBid() == 10000);
+
+    std::cout << "Unreachable reprice test passed!" << std::endl;
+}
+
+void testRepriceIntoFullFillLeavesNoLevel() {
+    for (bool ladder : {false, true}) {
+        std::cout << "Testing reprice into a full fill (" << (ladder ? "ladder" : "sorted") << ")..." << std::endl;
+
+        OrderBook book(nullptr, nullptr, nullptr, callerConsumer(ladder));
+        assert(book.addOrder(limit(1, Side::Sell, 10100, 100)).isSuccess());
+        assert(book.addOrder(limit(2, Side::Buy, 10000, 100)).isSuccess());
+        book.processPending();
+
+        // The bid crosses at its new price and trades out; nothing rests at either price
+        assert(book.modifyOrder(OrderId(2), 10100, 0).isSuccess());
+        book.processPending();
+        assert(book.getTradeCount() == 1);
+        assert(book.getOrderCount() == 0);
+        assert(book.getBidLevelCount() == 0);
+        assert(!book.bestBid());
+        assert(!book.bestAsk());
+
+        std::cout << "Full-fill reprice test passed!" << std::endl;
+    }
+}
+
+void testRepricePartialFillRestsAtNewPrice() {
+    std::cout << "Testing reprice into a partial fill..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer(false));
+    assert(book.addOrder(limit(1, Side::Sell, 10100, 40)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Buy, 10000, 100)).isSuccess());
+    book.processPending();
+
+    // The remainder rests at the target price, never back at the old one
+    assert(book.modifyOrder(OrderId(2), 10100, 0).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 1);
+    assert(book.bestBid() && *book.bestBid() == 10100);
+    // The vacated level stays as a tombstone until compaction
+    assert(book.getBidLevelCount() - book.getTombstoneLevelCount() == 1);
+    assert(!book.bestAsk());
+
+    std::cout << "Partial-fill reprice test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running OrderBook modify tests..." << std::endl;
+
+    testRepriceToUnreachableLevelIsDropped();
+    testRepriceIntoFullFillLeavesNoLevel();
+    testRepricePartialFillRestsAtNewPrice();
+
+    std::cout << "\nAll OrderBook modify tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "orderbook/Core/Order.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+// Fields the matching and queue walks read must sit in the first line
+constexpr size_t HotLine = 64;
+static_assert(offsetof(Order, id) < HotLine && offsetof(Order, price) < HotLine, "id/price are hot");
+static_assert(offsetof(Order, quantity) < HotLine && offsetof(Order, filled_quantity) < HotLine, "quantities are hot");
+static_assert(offsetof(Order, next) < HotLine && offsetof(Order, prev) < HotLine, "level links are hot");
+static_assert(offsetof(Order, side) < HotLine && offsetof(Order, status) < HotLine, "side/status are hot");
+static_assert(offsetof(Order, tif) < HotLine && offsetof(Order, risk_reserved) < HotLine, "tif/risk flag are hot");
+static_assert(offsetof(Order, account_id) >= HotLine && offsetof(Order, timestamp) >= HotLine, "metadata is cold");
+static_assert(offsetof(Order, trace) >= HotLine && offsetof(Order, account_next) >= HotLine, "trace/account links are cold");
+static_assert(alignof(Order) == 64, "an order starts on a cache line");
+
+bool lineAligned(const void* pointer) {
+    return reinterpret_cast<uintptr_t>(pointer) % 64 == 0;
+}
+
+}
+
+void testLineAlignment() {
+    std::cout << "Testing order cache-line alignment..." << std::endl;
+
+    // Pool, heap and array storage all start each order on a line
+    std::vector<std::unique_ptr<Order>> pooled;
+    for (uint64_t id = 1; id <= 16; ++id) {
+        pooled.push_back(std::make_unique<Order>(limit(id, Side::Buy, 10000, 10)));
+        assert(lineAligned(pooled.back().get()));
+        assert(lineAligned(&pooled.back()->symbol_id));
+    }
+    Order orders[4];
+    for (const Order& order : orders) assert(lineAligned(&order));
+    assert(reinterpret_cast<const char*>(&orders[1]) - reinterpret_cast<const char*>(&orders[0]) == 128);
+
+    std::cout << "Order alignment test passed!" << std::endl;
+}
+
+void testFieldsAcrossLines() {
+    std::cout << "Testing order hot and cold fields..." << std::endl;
+
+    Order order = limit(7, Side::Sell, 10100, 10, "LAYOUT", "layout-acct");
+    assert(order.id == OrderId(7) && order.price == 10100 && order.isSell());
+    assert(std::string(order.symbol()) == "LAYOUT" && std::string(order.account()) == "layout-acct");
+    assert(order.timestamp != 0 && order.status == OrderStatus::New);
+
+    // Fill and modify touch only the hot record
+    assert(!order.fill(4));
+    assert(order.status == OrderStatus::PartiallyFilled && order.remainingQuantity() == 6);
+    order.modify(10050, 3);
+    assert(order.price == 10050 && order.filled_quantity == 3 && order.status == OrderStatus::Filled);
+
+    // A move carries both lines
+    SymbolId symbol = order.symbol_id;
+    Order moved = std::move(order);
+    assert(moved.id == OrderId(7) && moved.symbol_id == symbol && moved.price == 10050);
+
+    // Reset clears both lines for reuse
+    moved.account_next = &moved;
+    moved.risk_reserved = true;
+    moved.reset();
+    assert(moved.id == OrderId(0) && moved.quantity == 0 && !moved.risk_reserved);
+    assert(moved.symbol_id == 0 && moved.account_id == 0 && !moved.account_next && !moved.next);
+
+    std::cout << "Order hot and cold field test passed!" << std::endl;
+}
+
+void testBookWalksSplitOrders() {
+    std::cout << "Testing matching over split orders..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    for (uint64_t id = 1; id <= 5; ++id) {
+        assert(book.addOrder(limit(id, Side::Buy, 10000, 10, "TEST", "layout-bid")).isSuccess());
+    }
+    assert(book.addOrder(limit(10, Side::Sell, 10000, 35, "TEST", "layout-ask")).isSuccess());
+    book.processPending();
+
+    // Three full fills walk the level's links in time priority, leaving a half-filled fourth
+    assert(book.getOrderCount() == 2 && *book.bestBid() == 10000);
+    const Order* partial = book.getOrderStore().order(OrderId(4));
+    assert(partial && partial->remainingQuantity() == 5 && partial->next == book.getOrderStore().order(OrderId(5)));
+    assert(std::string(partial->account()) == "layout-bid");
+
+    std::cout << "Split order matching test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running order layout tests..." << std::endl;
+
+    testLineAlignment();
+    testFieldsAcrossLines();
+    testBookWalksSplitOrders();
+
+    std::cout << "\nAll order layout tests passed successfully!" << std::endl;
+    return 0;
+}
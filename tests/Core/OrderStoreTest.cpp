@@ -0,0 +1,137 @@
+#include "orderbook/Core/OrderStore.hpp"
+#include "orderbook/Core/OrderManager.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+Order* store(OrderStore& orders, Order order) {
+    Order* stored = orders.acquire();
+    *stored = std::move(order);
+    orders.insert(OrderLocation(stored, nullptr, stored->side));
+    return stored;
+}
+
+size_t accountLength(const OrderStore& orders, const char* account) {
+    size_t length = 0;
+    for (Order* order = orders.accountOrders(accountTable().intern(account)); order; order = order->account_next) {
+        ++length;
+    }
+    return length;
+}
+
+}
+
+void testStoreIndexAndLists() {
+    std::cout << "Testing order store index and lists..." << std::endl;
+
+    OrderStore orders(2);
+    Order* a = store(orders, limit(1, Side::Buy, 10000, 10, "OSA", "os-one"));
+    Order* b = store(orders, limit(2, Side::Buy, 9900, 10, "OSB", "os-one"));
+    // Past the arena the store falls back to the heap, indexed the same way
+    Order* c = store(orders, limit(3, Side::Sell, 10100, 10, "OSA", "os-two"));
+    assert(orders.owns(a) && orders.owns(b) && !orders.owns(c));
+    assert(orders.heapCount() == 1 && orders.pool().inUse() == 2);
+    assert(orders.size() == 3 && orders.order(OrderId(3)) == c && !orders.order(OrderId(4)));
+
+    assert(accountLength(orders, "os-one") == 2 && accountLength(orders, "os-two") == 1);
+    assert(orders.symbolOrders(symbolTable().intern("OSA")).size() == 2);
+    assert(orders.symbolOrders(symbolTable().intern("OSUNSEEN")).empty());
+
+    // Erasing swaps the symbol list and unlinks the account list
+    orders.erase(OrderId(1));
+    orders.release(a);
+    const auto& osa = orders.symbolOrders(symbolTable().intern("OSA"));
+    assert(osa.size() == 1 && osa[0] == c && c->symbol_slot == 0);
+    assert(accountLength(orders, "os-one") == 1);
+    assert(orders.accountOrders(accountTable().intern("os-one")) == b);
+
+    // A freed arena slot is reused before the heap
+    Order* d = store(orders, limit(4, Side::Buy, 9800, 10, "OSB", "os-two"));
+    assert(d == a && orders.heapCount() == 1);
+    assert(accountLength(orders, "os-two") == 2);
+
+    orders.clear();
+    assert(orders.empty() && orders.heapCount() == 0 && orders.pool().inUse() == 0);
+    assert(!orders.accountOrders(accountTable().intern("os-two")));
+
+    std::cout << "Order store index test passed!" << std::endl;
+}
+
+void testStandaloneManager() {
+    std::cout << "Testing standalone order manager..." << std::endl;
+
+    OrderManager manager(nullptr, 16);
+    assert(!manager.isBookBacked());
+    assert(manager.addOrder(std::make_unique<Order>(limit(1, Side::Buy, 10000, 10, "OSM", "om-acct"))).isSuccess());
+    assert(manager.addOrder(std::make_unique<Order>(limit(2, Side::Sell, 10100, 10, "OSM", "om-acct"))).isSuccess());
+    assert(manager.addOrder(std::make_unique<Order>(limit(1, Side::Buy, 9900, 5, "OSM", "om-acct"))).isError());
+    assert(manager.getActiveOrderCount() == 2);
+
+    assert(!manager.fillOrder(OrderId(1), 4));
+    assert(manager.getOrder(OrderId(1))->remainingQuantity() == 6);
+    assert(manager.modifyOrder(OrderId(1), 9950, 0).isSuccess());
+    assert(manager.getOrder(OrderId(1))->price == 9950);
+
+    // Cancelled orders stay stored until removed
+    assert(manager.cancelAll(accountTable().intern("om-acct")) == 2);
+    assert(!manager.getOrder(OrderId(2))->isActive());
+    assert(manager.cancelOrder(OrderId(2)).isError());
+    assert(manager.getActiveOrderCount() == 0);
+    assert(manager.removeOrder(OrderId(2)) && !manager.removeOrder(OrderId(2)));
+    assert(!manager.getOrder(OrderId(2)) && manager.getOrder(OrderId(1)));
+
+    std::cout << "Standalone order manager test passed!" << std::endl;
+}
+
+void testManagerSharesTheBookStore() {
+    std::cout << "Testing book-backed order manager..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, callerConsumer());
+    OrderManager manager(book);
+    assert(manager.isBookBacked());
+
+    assert(manager.addOrder(std::make_unique<Order>(limit(1, Side::Buy, 10000, 10, "OSK", "ob-acct"))).isSuccess());
+    assert(manager.addOrder(std::make_unique<Order>(limit(2, Side::Buy, 9900, 10, "OSK", "ob-acct"))).isSuccess());
+    assert(manager.addOrder(std::make_unique<Order>(limit(3, Side::Sell, 10200, 10, "OSK", "ob-other"))).isSuccess());
+    // Applied before the call returns, and read straight from the book's index
+    assert(book.getOrderCount() == 3 && manager.getActiveOrderCount() == 3);
+    Order* resting = manager.getOrder(OrderId(1));
+    assert(resting && resting == book.getOrderStore().order(OrderId(1)));
+    OrderLocation location = manager.getOrderLocation(OrderId(1));
+    assert(location.isValid() && location.price_level->price == 10000);
+    assert(manager.addOrder(std::make_unique<Order>(limit(1, Side::Buy, 9800, 1, "OSK", "ob-acct"))).isError());
+
+    // A crossing add trades in the book; the manager sees the result immediately
+    assert(manager.addOrder(std::make_unique<Order>(limit(4, Side::Sell, 10000, 4, "OSK", "ob-other"))).isSuccess());
+    assert(manager.getOrder(OrderId(1))->remainingQuantity() == 6 && !manager.getOrder(OrderId(4)));
+
+    // Modify, cancel and mass cancel go through the book
+    assert(manager.modifyOrder(OrderId(3), 10150, 0).isSuccess());
+    assert(*book.bestAsk() == 10150);
+    assert(manager.cancelOrder(OrderId(3)).isSuccess());
+    assert(!manager.getOrder(OrderId(3)) && !book.bestAsk());
+    assert(manager.cancelAll(accountTable().intern("ob-acct")) == 2);
+    assert(book.getOrderCount() == 0 && manager.getActiveOrderCount() == 0);
+    assert(!manager.removeOrder(OrderId(1)));
+
+    std::cout << "Book-backed order manager test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running order store tests..." << std::endl;
+
+    testStoreIndexAndLists();
+    testStandaloneManager();
+    testManagerSharesTheBookStore();
+
+    std::cout << "\nAll order store tests passed successfully!" << std::endl;
+    return 0;
+}
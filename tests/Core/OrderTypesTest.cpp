@@ -0,0 +1,171 @@
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/MatchingEngine.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+Order order(uint64_t id, Side side, OrderType type, TimeInForce tif, Price price, Quantity quantity) {
+    return Order(id, side, type, tif, price, quantity, "TEST", "test-account");
+}
+
+OrderBookOptions mode(bool ladder) {
+    OrderBookOptions options = callerConsumer();
+    options.ladder_mode = ladder;
+    return options;
+}
+
+// Two ask levels: 30 @ 10100 and 30 @ 10200
+void seedAsks(OrderBook& book) {
+    assert(book.addOrder(limit(1, Side::Sell, 10100, 30)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Sell, 10200, 30)).isSuccess());
+    book.processPending();
+}
+
+}
+
+void testImmediateOrCancel(bool ladder) {
+    std::cout << "Testing IOC orders" << (ladder ? " (ladder)" : "") << "..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, mode(ladder));
+    seedAsks(book);
+    // Fills what crosses, the remainder is cancelled instead of resting
+    assert(book.addOrder(order(10, Side::Buy, OrderType::Limit, TimeInForce::IOC, 10100, 50)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 1);
+    assert(book.getOrderCount() == 1);
+    assert(!book.bestBid() && *book.bestAsk() == 10200);
+    assert(book.getBidLevelCount() == 0);
+
+    // Nothing crosses: no trade, nothing rests
+    assert(book.addOrder(order(11, Side::Buy, OrderType::Limit, TimeInForce::IOC, 10000, 10)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 1 && book.getOrderCount() == 1 && !book.bestBid());
+
+    std::cout << "IOC test passed!" << std::endl;
+}
+
+void testFillOrKill(bool ladder) {
+    std::cout << "Testing FOK orders" << (ladder ? " (ladder)" : "") << "..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, mode(ladder));
+    seedAsks(book);
+    // Enough on the book overall, but not within the limit: killed untouched
+    assert(book.addOrder(order(10, Side::Buy, OrderType::Limit, TimeInForce::FOK, 10100, 40)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 0 && book.getOrderCount() == 2);
+    MarketDepth depth = book.getDepth(2);
+    assert(depth.asks.size() == 2 && depth.asks[0].quantity == 30);
+
+    // More than the whole book
+    assert(book.addOrder(order(11, Side::Buy, OrderType::Limit, TimeInForce::FOK, 10300, 61)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 0 && book.getOrderCount() == 2);
+
+    // Exactly what the crossing levels hold fills across both
+    assert(book.addOrder(order(12, Side::Buy, OrderType::Limit, TimeInForce::FOK, 10200, 60)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 2 && book.getOrderCount() == 0);
+    assert(!book.bestAsk() && !book.bestBid());
+
+    std::cout << "FOK test passed!" << std::endl;
+}
+
+void testMarketOrders(bool ladder) {
+    std::cout << "Testing market orders" << (ladder ? " (ladder)" : "") << "..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, mode(ladder));
+    seedAsks(book);
+    // The price is ignored: a market order sweeps every level it needs
+    assert(book.addOrder(order(10, Side::Buy, OrderType::Market, TimeInForce::IOC, 0, 45)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 2 && book.getOrderCount() == 1);
+    MarketDepth depth = book.getDepth(1);
+    assert(depth.asks.size() == 1 && depth.asks[0].price == 10200 && depth.asks[0].quantity == 15);
+
+    // Its unfilled remainder never rests, even marked GTC
+    assert(book.addOrder(order(11, Side::Buy, OrderType::Market, TimeInForce::GTC, 0, 100)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 3 && book.getOrderCount() == 0);
+    assert(!book.bestBid() && book.getBidLevelCount() == 0);
+
+    // Against an empty side it is simply cancelled
+    assert(book.addOrder(order(12, Side::Sell, OrderType::Market, TimeInForce::IOC, 0, 10)).isSuccess());
+    book.processPending();
+    assert(book.getOrderCount() == 0 && !book.bestAsk());
+
+    std::cout << "Market order test passed!" << std::endl;
+}
+
+void testLimitRemainderRests(bool ladder) {
+    std::cout << "Testing GTC remainder" << (ladder ? " (ladder)" : "") << "..." << std::endl;
+
+    OrderBook book(nullptr, nullptr, nullptr, mode(ladder));
+    seedAsks(book);
+    // Matched first, so only the unfilled 20 ever reaches the bid side
+    assert(book.addOrder(limit(10, Side::Buy, 10100, 50)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 1 && book.getOrderCount() == 2);
+    MarketDepth depth = book.getDepth(1);
+    assert(depth.bids.size() == 1 && depth.bids[0].price == 10100 && depth.bids[0].quantity == 20);
+    assert(*book.bestAsk() == 10200);
+
+    std::cout << "GTC remainder test passed!" << std::endl;
+}
+
+void testMatchSideCrossing() {
+    std::cout << "Testing side-specialized crossing..." << std::endl;
+
+    MatchingEngine engine;
+    Order bid_high(1, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10000, 10, "TEST", "a");
+    Order bid_low(2, Side::Buy, OrderType::Limit, TimeInForce::GTC, 9000, 10, "TEST", "a");
+    std::vector<PriceLevel> bids;
+    bids.emplace_back(10000);
+    bids.back().addOrder(&bid_high);
+    bids.emplace_back(9000);
+    bids.back().addOrder(&bid_low);
+    auto walk = [&bids](auto&& visitor) {
+        for (auto& level : bids) {
+            if (level.isEmpty()) continue;
+            if (!visitor(level)) break;
+        }
+    };
+
+    // A limit sell stops at its price; the FOK pre-check agrees with the walk
+    Order sell_limit(3, Side::Sell, OrderType::Limit, TimeInForce::FOK, 9500, 15, "TEST", "b");
+    assert(!MatchingEngine::hasLiquidity(sell_limit, walk));
+    assert(MatchingEngine::crosses<Side::Sell>(sell_limit, 10000));
+    assert(!MatchingEngine::crosses<Side::Sell>(sell_limit, 9000));
+
+    // A market sell crosses any price
+    Order sell_market(4, Side::Sell, OrderType::Market, TimeInForce::IOC, 0, 15, "TEST", "b");
+    assert(MatchingEngine::crosses<Side::Sell>(sell_market, 1));
+    assert(MatchingEngine::hasLiquidity(sell_market, walk));
+    FillBuffer<8> fills;
+    MatchResult result = engine.matchSide<Side::Sell>(sell_market, walk, fills);
+    assert(result.fully_filled && result.getTradeCount() == 2);
+    assert(fills[0].price == 10000 && fills[1].price == 9000 && fills[1].quantity == 5);
+    assert(bid_high.isFullyFilled() && bid_low.remainingQuantity() == 5);
+
+    std::cout << "Side-specialized crossing test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running order type tests..." << std::endl;
+
+    for (bool ladder : {false, true}) {
+        testImmediateOrCancel(ladder);
+        testFillOrKill(ladder);
+        testMarketOrders(ladder);
+        testLimitRemainderRests(ladder);
+    }
+    testMatchSideCrossing();
+
+    std::cout << "\nAll order type tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "orderbook/Core/PriceLadder.hpp"
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+std::vector<Price> levelPrices(const PriceLadder& ladder) {
+    std::vector<Price> prices;
+    ladder.forEachLevel([&prices](const PriceLevel& level) {
+        prices.push_back(level.price);
+        return true;
+    });
+    return prices;
+}
+
+}
+
+void testBestAndOrderPerSide() {
+    std::cout << "Testing best level and walk order per side..." << std::endl;
+
+    PriceLadder bids(Side::Buy, 256);
+    PriceLadder asks(Side::Sell, 256);
+    for (Price price : {1000, 1005, 1003, 1001}) {
+        assert(bids.findOrCreate(price));
+        assert(asks.findOrCreate(price));
+    }
+    assert(bids.best()->price == 1005);
+    assert(asks.best()->price == 1000);
+    assert((levelPrices(bids) == std::vector<Price>{1005, 1003, 1001, 1000}));
+    assert((levelPrices(asks) == std::vector<Price>{1000, 1001, 1003, 1005}));
+    assert(bids.activeLevelCount() == 4);
+
+    // Removing the best moves to the next worse level
+    bids.remove(bids.find(1005));
+    asks.remove(asks.find(1000));
+    assert(bids.best()->price == 1003);
+    assert(asks.best()->price == 1001);
+    assert(!bids.find(1005));
+    assert(bids.activeLevelCount() == 3);
+
+    // A visitor that returns false stops the walk
+    size_t visited = 0;
+    bids.forEachLevel([&visited](PriceLevel&) { return ++visited < 2; });
+    assert(visited == 2);
+
+    std::cout << "Best level test passed!" << std::endl;
+}
+
+void testScanAcrossBitmapWords() {
+    std::cout << "Testing scans across bitmap word boundaries..." << std::endl;
+
+    // Levels either side of a 64-bit word edge, and one a few words away
+    PriceLadder asks(Side::Sell, 256);
+    assert(asks.findOrCreate(5000));
+    Price base = asks.basePrice();
+    asks.remove(asks.find(5000));
+    for (Price price : {base + 200, base + 64, base + 63}) {
+        assert(asks.findOrCreate(price));
+    }
+    assert(asks.basePrice() == base);
+    assert((levelPrices(asks) == std::vector<Price>{base + 63, base + 64, base + 200}));
+    asks.remove(asks.find(base + 63));
+    assert(asks.best()->price == base + 64);
+
+    PriceLadder bids(Side::Buy, 256);
+    assert(bids.findOrCreate(5000));
+    base = bids.basePrice();
+    bids.remove(bids.find(5000));
+    for (Price price : {base + 1, base + 127, base + 128}) {
+        assert(bids.findOrCreate(price));
+    }
+    assert((levelPrices(bids) == std::vector<Price>{base + 128, base + 127, base + 1}));
+    bids.remove(bids.find(base + 128));
+    bids.remove(bids.find(base + 127));
+    assert(bids.best()->price == base + 1);
+
+    std::cout << "Word boundary test passed!" << std::endl;
+}
+
+void testRecenterKeepsLevels() {
+    std::cout << "Testing recentering with resting orders..." << std::endl;
+
+    PriceLadder bids(Side::Buy, 64);
+    PriceLevel* level = bids.findOrCreate(20000);
+    assert(level);
+    Order order(1, Side::Buy, OrderType::Limit, 20000, 40, "LADR");
+    level->addOrder(&order);
+    uint64_t generation = bids.generation();
+
+    // Far below the current window: the ladder moves and grows, the level survives
+    assert(bids.findOrCreate(20000 - 500));
+    assert(bids.generation() > generation);
+    assert(bids.capacity() > 64);
+    PriceLevel* moved = bids.find(20000);
+    assert(moved && moved->total_quantity == 40 && moved->getFirstOrder() == &order);
+    assert(bids.best()->price == 20000);
+    moved->removeOrder(&order);
+
+    // A span wider than MaxLevels cannot be held
+    assert(!bids.findOrCreate(20000 + Price(PriceLadder::MaxLevels)));
+    assert(bids.activeLevelCount() == 2);
+
+    bids.clear();
+    assert(!bids.best());
+    assert(bids.activeLevelCount() == 0);
+    assert(!bids.find(20000));
+
+    std::cout << "Recenter test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running PriceLadder tests..." << std::endl;
+
+    testBestAndOrderPerSide();
+    testScanAcrossBitmapWords();
+    testRecenterKeepsLevels();
+
+    std::cout << "\nAll PriceLadder tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include "orderbook/Core/SymbolMaster.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+SymbolDefinition definition(const std::string& symbol, uint32_t security_id) {
+    SymbolDefinition def;
+    def.symbol = symbol;
+    def.name = symbol + " Holdings";
+    def.security_id = security_id;
+    def.tick_size = 0.05;
+    def.lot_size = 100;
+    return def;
+}
+
+void writeImage(const std::filesystem::path& path, const std::vector<unsigned char>& image) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+}
+
+SymbolMasterHeader headerOf(const std::vector<unsigned char>& image) {
+    SymbolMasterHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    return header;
+}
+
+}
+
+void testRoundTripAndLookups() {
+    std::cout << "Testing write, open and lookups..." << std::endl;
+
+    auto directory = freshDirectory("symbol-master");
+    std::string path = (directory / "symbols.master").string();
+    std::vector<SymbolDefinition> symbols;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        symbols.push_back(definition("SYM" + std::to_string(i), 100000 + i));
+    }
+    SymbolDefinition banded = definition("BAND", 7);
+    banded.min_price = 900;
+    banded.max_price = 1100;
+    banded.name = std::string(80, 'N');
+    banded.lot_size = 0;
+    banded.tick_size = 0;
+    symbols.push_back(banded);
+    symbols.push_back(definition(std::string(31, 'L'), 8));
+
+    auto written = writeSymbolMaster(path, symbols);
+    assert(written.isSuccess() && written.value() == symbols.size());
+    assert(!std::filesystem::exists(path + ".tmp"));
+
+    InternTable table;
+    auto master = SymbolMaster::open(path, table);
+    assert(master.isSuccess());
+    const SymbolMaster& symbol_master = *master.value();
+    assert(symbol_master.size() == symbols.size());
+
+    // Every name resolves through the perfect hash, and by its interned ID
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        const SymbolMasterEntry* entry = symbol_master.find(symbols[i].symbol);
+        assert(entry == &symbol_master.entry(i));
+        assert(entry->symbolView() == symbols[i].symbol);
+        assert(entry->security_id == symbols[i].security_id);
+        SymbolId id = symbol_master.symbolId(i);
+        assert(table.find(symbols[i].symbol) == id);
+        assert(symbol_master.byId(id) == entry);
+    }
+    const SymbolMasterEntry* sym = symbol_master.find("SYM42");
+    assert(sym->lot_size == 100 && sym->tick_size == 0.05 && !sym->hasPriceBand());
+    assert(std::string(sym->name) == "SYM42 Holdings");
+    assert(sym->priceScale().toTicks(2.5) == 50);
+
+    // Out-of-range definitions are clamped, long names truncated
+    const SymbolMasterEntry* band = symbol_master.find("BAND");
+    assert(band->hasPriceBand() && band->min_price == 900 && band->max_price == 1100);
+    assert(band->lot_size == 1 && band->tick_size == 0.01);
+    assert(std::string(band->name) == std::string(sizeof(band->name) - 1, 'N'));
+
+    assert(!symbol_master.find("MISSING"));
+    assert(!symbol_master.find(""));
+    assert(!symbol_master.find("SYM5000"));
+    assert(!symbol_master.byId(table.intern("UNLISTED")));
+    assert(!symbol_master.byId(SymbolId(1) << 30));
+    assert(static_cast<size_t>(symbol_master.end() - symbol_master.begin()) == symbols.size());
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Round trip test passed!" << std::endl;
+}
+
+void testEmptyMaster() {
+    std::cout << "Testing an empty symbol master..." << std::endl;
+
+    auto directory = freshDirectory("symbol-master-empty");
+    std::string path = (directory / "empty.master").string();
+    assert(writeSymbolMaster(path, {}).isSuccess());
+    InternTable table;
+    auto master = SymbolMaster::open(path, table);
+    assert(master.isSuccess());
+    assert(master.value()->size() == 0);
+    assert(!master.value()->find("AAPL"));
+    assert(master.value()->begin() == master.value()->end());
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Empty master test passed!" << std::endl;
+}
+
+void testBuildRejects() {
+    std::cout << "Testing rejected definitions..." << std::endl;
+
+    assert(buildSymbolMaster({definition("", 1)}).isError());
+    assert(buildSymbolMaster({definition(std::string(32, 'X'), 1)}).isError());
+    assert(buildSymbolMaster({definition("AAPL", 1), definition("MSFT", 2), definition("AAPL", 3)}).isError());
+
+    // A failed build leaves no file behind
+    auto directory = freshDirectory("symbol-master-reject");
+    std::string path = (directory / "bad.master").string();
+    assert(writeSymbolMaster(path, {definition("DUP", 1), definition("DUP", 2)}).isError());
+    assert(!std::filesystem::exists(path));
+    assert(writeSymbolMaster((directory / "no-such-dir" / "x.master").string(), {definition("A", 1)}).isError());
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Build reject test passed!" << std::endl;
+}
+
+void testCorruptFilesRefused() {
+    std::cout << "Testing corrupt symbol master files..." << std::endl;
+
+    auto directory = freshDirectory("symbol-master-corrupt");
+    std::string path = (directory / "corrupt.master").string();
+    InternTable table;
+    assert(SymbolMaster::open(path, table).isError());
+
+    auto built = buildSymbolMaster({definition("AAPL", 1), definition("MSFT", 2), definition("IBM", 3)});
+    assert(built.isSuccess());
+    const std::vector<unsigned char>& image = built.value();
+    SymbolMasterHeader header = headerOf(image);
+
+    // Shorter than a header
+    writeImage(path, std::vector<unsigned char>(image.begin(), image.begin() + 16));
+    assert(SymbolMaster::open(path, table).isError());
+
+    auto bad_magic = image;
+    bad_magic[0] = 'X';
+    writeImage(path, bad_magic);
+    assert(SymbolMaster::open(path, table).isError());
+
+    auto bad_version = image;
+    uint32_t version = SymbolMasterHeader::FormatVersion + 1;
+    std::memcpy(bad_version.data() + offsetof(SymbolMasterHeader, version), &version, sizeof(version));
+    writeImage(path, bad_version);
+    assert(SymbolMaster::open(path, table).isError());
+
+    // Entries past the end of the file
+    writeImage(path, std::vector<unsigned char>(image.begin(), image.end() - 1));
+    assert(SymbolMaster::open(path, table).isError());
+
+    auto bad_slot = image;
+    uint32_t out_of_range = header.count;
+    std::memcpy(bad_slot.data() + header.slots_offset, &out_of_range, sizeof(out_of_range));
+    writeImage(path, bad_slot);
+    assert(SymbolMaster::open(path, table).isError());
+
+    auto zero_lot = image;
+    uint64_t lot = 0;
+    std::memcpy(zero_lot.data() + header.entries_offset + sizeof(SymbolMasterEntry) + offsetof(SymbolMasterEntry, lot_size),
+                &lot, sizeof(lot));
+    writeImage(path, zero_lot);
+    assert(SymbolMaster::open(path, table).isError());
+
+    // The untouched image still opens
+    writeImage(path, image);
+    auto master = SymbolMaster::open(path, table);
+    assert(master.isSuccess() && master.value()->find("IBM"));
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Corrupt file test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running SymbolMaster tests..." << std::endl;
+
+    testRoundTripAndLookups();
+    testEmptyMaster();
+    testBuildRejects();
+    testCorruptFilesRefused();
+
+    std::cout << "\nAll SymbolMaster tests passed successfully!" << std::endl;
+    return 0;
+}
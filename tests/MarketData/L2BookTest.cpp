@@ -0,0 +1,152 @@
+#include "orderbook/MarketData/L2Book.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <thread>
+
+using namespace orderbook;
+
+namespace {
+
+MarketDepth depthOf(std::initializer_list<MarketDepth::Level> bids, std::initializer_list<MarketDepth::Level> asks) {
+    MarketDepth depth;
+    depth.bids.assign(bids);
+    depth.asks.assign(asks);
+    return depth;
+}
+
+BookUpdate level(BookUpdate::Type type, Side side, Price price, Quantity quantity, size_t orders = 1) {
+    return BookUpdate(type, side, price, quantity, orders, 0);
+}
+
+}
+
+void testSnapshotThenDeltas() {
+    std::cout << "Testing L2 snapshot and deltas..." << std::endl;
+
+    L2Book book;
+    // Stale until the first snapshot: deltas are ignored
+    assert(book.isStale() && book.snapshot().stale);
+    auto early = level(BookUpdate::Type::Add, Side::Buy, 9900, 10);
+    assert(book.applyUpdate(early) == L2Book::ApplyResult::Stale);
+    assert(book.bids().empty());
+
+    // Levels arrive out of order and with an empty one; the mirror sorts and drops it
+    auto result = book.applySnapshot(depthOf({{9800, 20, 2}, {9900, 10, 1}, {9700, 0, 0}},
+                                             {{10200, 5, 1}, {10100, 7, 3}}), 10);
+    assert(result == L2Book::ApplyResult::Applied && !book.isStale());
+    assert(book.bids().size() == 2 && book.bids()[0].price == 9900 && book.bids()[1].price == 9800);
+    assert(book.asks().size() == 2 && book.asks()[0].price == 10100);
+
+    // One message: modify a level, add a better one, remove another
+    BookUpdate delta[] = {
+        level(BookUpdate::Type::Modify, Side::Buy, 9800, 25, 3),
+        level(BookUpdate::Type::Add, Side::Buy, 9950, 4),
+        level(BookUpdate::Type::Remove, Side::Sell, 10100, 0, 0),
+        level(BookUpdate::Type::Modify, Side::Sell, 10200, 0, 0),
+    };
+    assert(book.applyUpdates(delta, 4, 11) == L2Book::ApplyResult::Applied);
+    assert(book.bids().size() == 3 && book.bids()[0].price == 9950);
+    assert(book.bids()[2].quantity == 25 && book.bids()[2].order_count == 3);
+    assert(book.asks().empty());
+
+    L2Snapshot snap = book.snapshot();
+    assert(!snap.stale && snap.sequence == 11);
+    assert(snap.bid_count == 3 && snap.ask_count == 0);
+    assert(snap.bids[0].price == 9950 && snap.bids[1].price == 9900);
+
+    std::cout << "L2 snapshot and delta test passed!" << std::endl;
+}
+
+void testDuplicateAndGap() {
+    std::cout << "Testing L2 duplicate and gap handling..." << std::endl;
+
+    L2Book book;
+    book.applySnapshot(depthOf({{9900, 10, 1}}, {{10100, 10, 1}}), 100);
+    auto add = level(BookUpdate::Type::Add, Side::Buy, 9950, 5);
+    assert(book.applyUpdate(add, 101) == L2Book::ApplyResult::Applied);
+
+    // Replays at or behind the last sequence change nothing
+    auto replay = level(BookUpdate::Type::Remove, Side::Buy, 9950, 0);
+    assert(book.applyUpdate(replay, 101) == L2Book::ApplyResult::Duplicate);
+    assert(book.applyUpdate(replay, 90) == L2Book::ApplyResult::Duplicate);
+    assert(book.bids().size() == 2);
+
+    // A skipped number marks the mirror stale and holds the last good levels
+    uint64_t version = book.version();
+    assert(book.applyUpdate(replay, 103) == L2Book::ApplyResult::Gap);
+    assert(book.isStale() && book.gapCount() == 1 && book.lastSequence() == 103);
+    assert(book.bids().size() == 2);
+    L2Snapshot stale = book.snapshot();
+    assert(stale.stale && stale.bid_count == 2 && book.version() != version);
+
+    // Incrementals stay ignored, without counting more gaps, until a snapshot
+    assert(book.applyUpdate(replay, 104) == L2Book::ApplyResult::Stale);
+    assert(book.applyUpdate(replay, 110) == L2Book::ApplyResult::Stale);
+    assert(book.gapCount() == 1 && book.bids().size() == 2);
+
+    // The recovery snapshot may carry an older sequence than the gapped delta
+    assert(book.applySnapshot(depthOf({{9800, 1, 1}}, {}), 108) == L2Book::ApplyResult::Applied);
+    assert(!book.isStale() && book.lastSequence() == 108);
+    assert(book.applyUpdate(add, 109) == L2Book::ApplyResult::Applied);
+    assert(book.bids().size() == 2 && book.bids()[0].price == 9950);
+    // A snapshot behind a live book is a duplicate
+    assert(book.applySnapshot(depthOf({}, {}), 105) == L2Book::ApplyResult::Duplicate);
+
+    // Session-level gaps and clears go stale too
+    book.markStale();
+    assert(book.snapshot().stale);
+    book.applySnapshot(depthOf({{9900, 10, 1}}, {}), 0);
+    book.clear();
+    assert(book.isStale() && book.bids().empty() && book.snapshot().bid_count == 0);
+
+    std::cout << "L2 duplicate and gap test passed!" << std::endl;
+}
+
+void testPublishedDepthAndReaders() {
+    std::cout << "Testing L2 reader snapshots..." << std::endl;
+
+    // Publishes only the configured number of levels
+    L2Book shallow(3);
+    MarketDepth wide;
+    for (int i = 0; i < 10; ++i) wide.bids.push_back({Price(9900 - i), Quantity(1 + i), 1});
+    shallow.applySnapshot(wide);
+    assert(shallow.bids().size() == 10 && shallow.snapshot().bid_count == 3);
+
+    // Every level of a snapshot carries the same quantity; a torn read would mix two
+    L2Book book;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            L2Snapshot snap = book.snapshot();
+            for (uint16_t i = 1; i < snap.bid_count; ++i) {
+                assert(snap.bids[i].quantity == snap.bids[0].quantity);
+                assert(snap.bids[i].price == snap.bids[i - 1].price - 1);
+            }
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    for (Quantity round = 1; round <= 20000; ++round) {
+        MarketDepth depth;
+        for (int i = 0; i < 20; ++i) depth.bids.push_back({Price(9900 - i), round, 1});
+        book.applySnapshot(depth);
+    }
+    while (reads.load(std::memory_order_relaxed) == 0) std::this_thread::yield();
+    done.store(true, std::memory_order_release);
+    reader.join();
+    assert(book.snapshot().bids[19].quantity == 20000);
+
+    std::cout << "L2 reader snapshot test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running L2 book tests..." << std::endl;
+
+    testSnapshotThenDeltas();
+    testDuplicateAndGap();
+    testPublishedDepthAndReaders();
+
+    std::cout << "\nAll L2 book tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "orderbook/MarketData/MarketDataFeed.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+struct RecordingSubscriber : IMarketDataSubscriber {
+    struct Delivery {
+        uint64_t trade_id;
+        SequenceNumber sequence;
+        std::thread::id thread;
+    };
+
+    std::mutex mutex;
+    std::vector<Delivery> trades;
+    std::vector<MarketDepth> depths;
+
+    void onTrade(const Trade& trade, SequenceNumber sequence) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        trades.push_back({trade.id.value, sequence, std::this_thread::get_id()});
+    }
+    void onBookUpdate(const BookUpdate&) override {}
+    void onBestPrices(const BestPrices&, SequenceNumber) override {}
+    void onDepth(const MarketDepth& depth, SequenceNumber) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        depths.push_back(depth);
+    }
+};
+
+Trade trade(uint64_t id) {
+    return Trade(id, OrderId(id), OrderId(id + 1), 10000, 1, "MDPT");
+}
+
+MarketDataPublisherOptions async(size_t journal_capacity, uint32_t idle_sleep_us) {
+    MarketDataPublisherOptions options;
+    options.async = true;
+    options.journal_capacity = journal_capacity;
+    options.idle_sleep_us = idle_sleep_us;
+    return options;
+}
+
+}
+
+void testJournalsPublishOffTheCallerThread() {
+    std::cout << "Testing per-thread journals..." << std::endl;
+
+    MarketDataPublisher publisher(nullptr, async(4096, 50));
+    assert(publisher.isAsync());
+    auto subscriber = std::make_shared<RecordingSubscriber>();
+    publisher.subscribe(subscriber);
+
+    // Two matching threads, trade ids 1..300 and 1001..1300
+    const uint64_t per_thread = 300;
+    std::set<std::thread::id> callers;
+    std::mutex callers_mutex;
+    std::vector<std::thread> threads;
+    for (uint64_t base : {uint64_t(1), uint64_t(1001)}) {
+        threads.emplace_back([&, base] {
+            {
+                std::lock_guard<std::mutex> lock(callers_mutex);
+                callers.insert(std::this_thread::get_id());
+            }
+            for (uint64_t i = 0; i < per_thread; ++i) publisher.publishTrade(trade(base + i));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    publisher.flush();
+
+    std::lock_guard<std::mutex> lock(subscriber->mutex);
+    assert(subscriber->trades.size() == 2 * per_thread);
+    std::map<bool, uint64_t> next = {{false, 1}, {true, 1001}};
+    SequenceNumber last = 0;
+    for (const auto& delivery : subscriber->trades) {
+        // One publisher thread delivers, none of the callers
+        assert(delivery.thread == subscriber->trades.front().thread);
+        assert(!callers.count(delivery.thread) && delivery.thread != std::this_thread::get_id());
+        // Each journal keeps its thread's order; public sequence numbers stay dense
+        uint64_t& expected = next[delivery.trade_id > 1000];
+        assert(delivery.trade_id == expected++);
+        assert(delivery.sequence == last + 1);
+        last = delivery.sequence;
+    }
+    auto stats = publisher.getStats();
+    assert(stats.trades_published == 2 * per_thread);
+    assert(stats.journal_drops == 0 && stats.sequence_gaps == 0);
+
+    std::cout << "Per-thread journal test passed!" << std::endl;
+}
+
+void testDroppedEventsLeaveSequenceGaps() {
+    std::cout << "Testing full journal drops..." << std::endl;
+
+    // A tiny journal and a sleepy publisher, so a burst overruns the ring
+    MarketDataPublisher publisher(nullptr, async(4, 200000));
+    auto subscriber = std::make_shared<RecordingSubscriber>();
+    publisher.subscribe(subscriber);
+    const uint64_t total = 1000;
+    for (uint64_t id = 1; id <= total; ++id) publisher.publishTrade(trade(id));
+    publisher.flush();
+    // The hole is only visible once an event after it gets through
+    publisher.publishTrade(trade(total + 1));
+    publisher.flush();
+
+    std::lock_guard<std::mutex> lock(subscriber->mutex);
+    auto stats = publisher.getStats();
+    assert(stats.journal_drops > 0 && stats.sequence_gaps > 0);
+    assert(subscriber->trades.size() + stats.journal_drops == total + 1);
+    assert(subscriber->trades.back().trade_id == total + 1);
+    // A dropped event still burns its sequence number, so subscribers see the hole
+    bool saw_gap = false;
+    for (size_t i = 0; i < subscriber->trades.size(); ++i) {
+        assert(subscriber->trades[i].sequence == subscriber->trades[i].trade_id);
+        if (i > 0 && subscriber->trades[i].sequence != subscriber->trades[i - 1].sequence + 1) saw_gap = true;
+    }
+    assert(saw_gap);
+
+    std::cout << "Full journal drop test passed!" << std::endl;
+}
+
+void testDepthTravelsInline() {
+    std::cout << "Testing journaled depth..." << std::endl;
+
+    MarketDataPublisher publisher(nullptr, async(64, 50));
+    auto subscriber = std::make_shared<RecordingSubscriber>();
+    publisher.subscribe(subscriber);
+    MarketDepth depth;
+    for (int i = 0; i < 8; ++i) {
+        depth.bids.push_back({Price(9999 - i), Quantity(10 + i), 1});
+    }
+    depth.asks.push_back({10001, 7, 2});
+    publisher.publishDepth(depth);
+    publisher.flush();
+
+    // Carried inline up to the five levels the book publishes
+    std::lock_guard<std::mutex> lock(subscriber->mutex);
+    assert(subscriber->depths.size() == 1);
+    const MarketDepth& received = subscriber->depths[0];
+    assert(received.bids.size() == 5 && received.asks.size() == 1);
+    assert(received.bids[4].price == 9995 && received.bids[4].quantity == 14);
+    assert(received.asks[0].quantity == 7 && received.asks[0].order_count == 2);
+
+    std::cout << "Journaled depth test passed!" << std::endl;
+}
+
+void testInlineByDefault() {
+    std::cout << "Testing inline publishing..." << std::endl;
+
+    MarketDataPublisher publisher;
+    assert(!publisher.isAsync());
+    auto subscriber = std::make_shared<RecordingSubscriber>();
+    publisher.subscribe(subscriber);
+    publisher.publishTrade(trade(1));
+    // Delivered before the call returns, on the caller's thread
+    assert(subscriber->trades.size() == 1);
+    assert(subscriber->trades[0].thread == std::this_thread::get_id());
+    publisher.flush();
+
+    std::cout << "Inline publishing test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running market data publisher tests..." << std::endl;
+
+    testJournalsPublishOffTheCallerThread();
+    testDroppedEventsLeaveSequenceGaps();
+    testDepthTravelsInline();
+    testInlineByDefault();
+
+    std::cout << "\nAll market data publisher tests passed successfully!" << std::endl;
+    return 0;
+}
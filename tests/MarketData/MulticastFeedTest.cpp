@@ -0,0 +1,197 @@
+#include "orderbook/MarketData/MulticastFeed.hpp"
+#include "orderbook/MarketData/MarketDataFeed.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <thread>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+std::shared_ptr<MulticastFeedPublisher> makeFeed(uint16_t snapshot_port = 0) {
+    MulticastFeedOptions options;
+    options.snapshot_port = snapshot_port;
+    auto feed = MulticastFeedPublisher::create(options);
+    if (feed.isError()) return nullptr;
+    return std::shared_ptr<MulticastFeedPublisher>(std::move(feed.value()));
+}
+
+// Notes the thread each book update arrives on, then passes it to the feed
+struct ThreadRecordingPublisher : IMarketDataPublisher {
+    explicit ThreadRecordingPublisher(MarketDataPublisherPtr feed) : feed(std::move(feed)) {}
+
+    void publishTrade(const Trade& trade) override { feed->publishTrade(trade); }
+    void publishBookUpdate(const BookUpdate& update) override {
+        if (std::this_thread::get_id() == caller) on_caller = true;
+        ++updates;
+        feed->publishBookUpdate(update);
+    }
+    void publishBestPrices(const BestPrices& prices) override { feed->publishBestPrices(prices); }
+    void publishDepth(const MarketDepth& depth) override { feed->publishDepth(depth); }
+    void subscribe(std::function<void(const std::string&)>) override {}
+
+    MarketDataPublisherPtr feed;
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<bool> on_caller{false};
+    std::atomic<int> updates{0};
+};
+
+const MarketDepth::Level* findLevel(const std::vector<MarketDepth::Level>& levels, Price price) {
+    for (const auto& level : levels) {
+        if (level.price == price) return &level;
+    }
+    return nullptr;
+}
+
+}
+
+void testSnapshotCoversWholeBook() {
+    std::cout << "Testing snapshot beyond the published top levels..." << std::endl;
+
+    auto feed = makeFeed();
+    assert(feed);
+    OrderBook book(nullptr, feed, nullptr, callerConsumer());
+    // More levels than both the published depth and the depth cache hold
+    constexpr int Levels = 20;
+    for (int i = 0; i < Levels; ++i) {
+        assert(book.addOrder(limit(1 + i, Side::Buy, 10000 - i, 100)).isSuccess());
+        assert(book.addOrder(limit(101 + i, Side::Sell, 10100 + i, 200)).isSuccess());
+    }
+    // A second order on a deep level
+    assert(book.addOrder(limit(201, Side::Buy, 10000 - 15, 50)).isSuccess());
+    book.processPending();
+
+    FeedSnapshot snapshot = feed->snapshot();
+    assert(snapshot.depth.bids.size() == Levels);
+    assert(snapshot.depth.asks.size() == Levels);
+    assert(snapshot.depth.bids.front().price == 10000);
+    assert(snapshot.depth.bids.back().price == 10000 - (Levels - 1));
+    assert(snapshot.depth.asks.front().price == 10100);
+    const MarketDepth::Level* deep = findLevel(snapshot.depth.bids, 10000 - 15);
+    assert(deep && deep->quantity == 150 && deep->order_count == 2);
+    assert(snapshot.header.sequence == feed->lastSequence());
+    assert(snapshot.header.session == feed->session());
+
+    std::cout << "Whole book snapshot test passed!" << std::endl;
+}
+
+void testDeepChangesReachSnapshot() {
+    std::cout << "Testing deep-level changes without a top-of-book change..." << std::endl;
+
+    auto feed = makeFeed();
+    assert(feed);
+    OrderBook book(nullptr, feed, nullptr, callerConsumer());
+    for (int i = 0; i < 12; ++i) {
+        assert(book.addOrder(limit(1 + i, Side::Sell, 10100 + i, 100)).isSuccess());
+    }
+    assert(book.addOrder(limit(50, Side::Sell, 10110, 40)).isSuccess());
+    book.processPending();
+    uint64_t before = feed->snapshot().header.sequence;
+
+    // Partial cancel, size-down and a full cancel, all below the top five
+    assert(book.cancelOrder(OrderId(50)).isSuccess());
+    assert(book.modifyOrder(OrderId(9), 0, 60).isSuccess());
+    assert(book.cancelOrder(OrderId(12)).isSuccess());
+    book.processPending();
+
+    FeedSnapshot snapshot = feed->snapshot();
+    assert(snapshot.header.sequence > before);
+    assert(snapshot.header.sequence == feed->lastSequence());
+    const MarketDepth::Level* partial = findLevel(snapshot.depth.asks, 10110);
+    assert(partial && partial->quantity == 100 && partial->order_count == 1);
+    const MarketDepth::Level* resized = findLevel(snapshot.depth.asks, 10108);
+    assert(resized && resized->quantity == 60);
+    assert(!findLevel(snapshot.depth.asks, 10111));
+    assert(snapshot.depth.asks.size() == 11);
+
+    std::cout << "Deep change test passed!" << std::endl;
+}
+
+void testTradesEmptyLevels() {
+    std::cout << "Testing levels consumed by a trade..." << std::endl;
+
+    auto feed = makeFeed();
+    assert(feed);
+    OrderBook book(nullptr, feed, nullptr, callerConsumer());
+    assert(book.addOrder(limit(1, Side::Sell, 10100, 100)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Sell, 10101, 100)).isSuccess());
+    assert(book.addOrder(limit(3, Side::Buy, 10101, 150)).isSuccess());
+    book.processPending();
+    assert(book.getTradeCount() == 2);
+
+    FeedSnapshot snapshot = feed->snapshot();
+    assert(snapshot.depth.bids.empty());
+    assert(snapshot.depth.asks.size() == 1);
+    assert(snapshot.depth.asks[0].price == 10101 && snapshot.depth.asks[0].quantity == 50);
+
+    std::cout << "Trade level test passed!" << std::endl;
+}
+
+void testSnapshotChannelRoundTrip() {
+    std::cout << "Testing the snapshot channel..." << std::endl;
+
+    auto feed = makeFeed(39517);
+    if (!feed) {
+        std::cout << "Snapshot port unavailable, skipped" << std::endl;
+        return;
+    }
+    for (int i = 0; i < 8; ++i) {
+        feed->publishBookUpdate(BookUpdate(BookUpdate::Type::Add, Side::Buy, 500 - i, 10 * (i + 1), 1, 0));
+    }
+    feed->publishBookUpdate(BookUpdate(BookUpdate::Type::Add, Side::Sell, 510, 70, 2, 0));
+
+    auto fetched = fetchFeedSnapshot("127.0.0.1", feed->snapshotPort());
+    assert(fetched.isSuccess());
+    const FeedSnapshot& snapshot = fetched.value();
+    assert(snapshot.header.sequence == 9);
+    assert(snapshot.depth.bids.size() == 8);
+    assert(snapshot.depth.bids[7].price == 493 && snapshot.depth.bids[7].quantity == 80);
+    assert(snapshot.depth.asks.size() == 1 && snapshot.depth.asks[0].order_count == 2);
+
+    std::cout << "Snapshot channel test passed!" << std::endl;
+}
+
+void testFeedBehindAsyncPublisher() {
+    std::cout << "Testing the feed on the async publisher thread..." << std::endl;
+
+    auto feed = makeFeed();
+    assert(feed);
+    auto recorder = std::make_shared<ThreadRecordingPublisher>(feed);
+    MarketDataPublisherOptions options;
+    options.async = true;
+    auto market_data = std::make_shared<MarketDataPublisher>(nullptr, options);
+    auto forwarder = std::make_shared<ForwardingSubscriber>(recorder);
+    market_data->subscribe(forwarder);
+
+    // The book (drained here, as a matching thread would) only journals the events
+    OrderBook book(nullptr, market_data, nullptr, callerConsumer());
+    assert(book.addOrder(limit(1, Side::Buy, 10000, 100)).isSuccess());
+    assert(book.addOrder(limit(2, Side::Sell, 10100, 60)).isSuccess());
+    book.processPending();
+    market_data->flush();
+
+    assert(recorder->updates == 2);
+    assert(!recorder->on_caller);
+    FeedSnapshot snapshot = feed->snapshot();
+    assert(snapshot.depth.bids.size() == 1 && snapshot.depth.bids[0].price == 10000);
+    assert(snapshot.depth.asks.size() == 1 && snapshot.depth.asks[0].quantity == 60);
+
+    std::cout << "Async publisher feed test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running MulticastFeed tests..." << std::endl;
+
+    testSnapshotCoversWholeBook();
+    testDeepChangesReachSnapshot();
+    testTradesEmptyLevels();
+    testSnapshotChannelRoundTrip();
+    testFeedBehindAsyncPublisher();
+
+    std::cout << "\nAll MulticastFeed tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,221 @@
+#include "orderbook/MarketData/ShmMarketData.hpp"
+#include "orderbook/Core/Order.hpp"
+#include "orderbook/Core/MarketData.hpp"
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <unistd.h>
+
+using namespace orderbook;
+
+namespace {
+
+std::string ringName(const std::string& test) {
+    return "/orderbook-md-" + test + "-" + std::to_string(::getpid());
+}
+
+struct CountingPublisher : IMarketDataPublisher {
+    int trades = 0;
+    int updates = 0;
+    int best = 0;
+    int depths = 0;
+
+    void publishTrade(const Trade&) override { ++trades; }
+    void publishBookUpdate(const BookUpdate&) override { ++updates; }
+    void publishBestPrices(const BestPrices&) override { ++best; }
+    void publishDepth(const MarketDepth&) override { ++depths; }
+    void subscribe(std::function<void(const std::string&)>) override {}
+};
+
+BookUpdate levelUpdate(Price price, Quantity quantity, SequenceNumber sequence) {
+    return BookUpdate(BookUpdate::Type::Modify, Side::Sell, price, quantity, 3, sequence);
+}
+
+}
+
+void testRecordsRoundTrip() {
+    std::cout << "Testing trade, level and best-price records..." << std::endl;
+
+    ShmMarketDataOptions options;
+    options.name = ringName("roundtrip");
+    options.capacity = 16;
+    options.symbol_id = symbolTable().intern("SHMB");
+    auto counter = std::make_shared<CountingPublisher>();
+    auto publisher = ShmMarketDataPublisher::create(options, counter);
+    assert(publisher.isSuccess());
+    auto reader = ShmMarketDataReader::open(options.name);
+    assert(reader.isSuccess());
+    assert(reader.value()->capacity() == 16);
+
+    ShmMarketDataRecord record{};
+    assert(reader.value()->poll(record) == ShmMarketDataReader::Status::Empty);
+
+    Trade trade(77, OrderId(5), OrderId(6), 10050, 300, "SHMT");
+    publisher.value()->publishTrade(trade);
+    publisher.value()->publishBookUpdate(levelUpdate(10060, 900, 41));
+    BestPrices best;
+    best.bid = 10040;
+    best.bid_size = 200;
+    publisher.value()->publishBestPrices(best);
+    publisher.value()->publishDepth(MarketDepth{});
+    assert(publisher.value()->published() == 3);
+
+    auto& ring = *reader.value();
+    assert(ring.poll(record) == ShmMarketDataReader::Status::Record);
+    assert(record.type == ShmMarketDataRecord::Type::Trade);
+    assert(record.trade.trade_id == 77 && record.trade.buy_order_id == 5 && record.trade.sell_order_id == 6);
+    assert(record.trade.price == 10050 && record.trade.quantity == 300);
+    assert(ring.symbol(record.symbol_id) == "SHMT");
+
+    assert(ring.poll(record) == ShmMarketDataReader::Status::Record);
+    assert(record.type == ShmMarketDataRecord::Type::BookUpdate);
+    assert(record.side == static_cast<uint8_t>(Side::Sell));
+    assert(record.update_type == static_cast<uint8_t>(BookUpdate::Type::Modify));
+    assert(record.level.price == 10060 && record.level.quantity == 900);
+    assert(record.level.order_count == 3 && record.level.book_sequence == 41);
+    // Book events carry the configured symbol, named when the ring was created
+    assert(record.symbol_id == options.symbol_id);
+    assert(ring.symbol(record.symbol_id) == "SHMB");
+
+    assert(ring.poll(record) == ShmMarketDataReader::Status::Record);
+    assert(record.type == ShmMarketDataRecord::Type::BestPrices);
+    assert(record.flags == ShmMarketDataRecord::HasBid);
+    assert(record.best.bid == 10040 && record.best.bid_size == 200);
+    assert(ring.poll(record) == ShmMarketDataReader::Status::Empty);
+    assert(ring.nextSequence() == 4 && ring.lost() == 0);
+    assert(ring.symbol(0).empty() && ring.symbol(ShmRingHeader::SymbolCapacity).empty());
+
+    // Every event, depth included, still reaches the in-process publisher
+    assert(counter->trades == 1 && counter->updates == 1 && counter->best == 1 && counter->depths == 1);
+
+    std::cout << "Round trip test passed!" << std::endl;
+}
+
+void testReaderStartsAtLiveEdge() {
+    std::cout << "Testing a reader opened after records were written..." << std::endl;
+
+    ShmMarketDataOptions options;
+    options.name = ringName("edge");
+    options.capacity = 8;
+    auto publisher = ShmMarketDataPublisher::create(options);
+    assert(publisher.isSuccess());
+    for (SequenceNumber i = 1; i <= 5; ++i) {
+        publisher.value()->publishBookUpdate(levelUpdate(1000, i, i));
+    }
+
+    auto reader = ShmMarketDataReader::open(options.name);
+    assert(reader.isSuccess());
+    ShmMarketDataRecord record{};
+    assert(reader.value()->nextSequence() == 6);
+    assert(reader.value()->poll(record) == ShmMarketDataReader::Status::Empty);
+    publisher.value()->publishBookUpdate(levelUpdate(1000, 6, 6));
+    assert(reader.value()->poll(record) == ShmMarketDataReader::Status::Record);
+    assert(record.level.book_sequence == 6);
+
+    std::cout << "Live edge test passed!" << std::endl;
+}
+
+void testOverrunSkipsToLiveEdge() {
+    std::cout << "Testing overrun of a slow reader..." << std::endl;
+
+    ShmMarketDataOptions options;
+    options.name = ringName("overrun");
+    options.capacity = 8;
+    auto publisher = ShmMarketDataPublisher::create(options);
+    assert(publisher.isSuccess());
+    auto reader = ShmMarketDataReader::open(options.name);
+    assert(reader.isSuccess());
+    auto& ring = *reader.value();
+
+    for (SequenceNumber i = 1; i <= 20; ++i) {
+        publisher.value()->publishBookUpdate(levelUpdate(1000, i, i));
+    }
+    ShmMarketDataRecord record{};
+    assert(ring.poll(record) == ShmMarketDataReader::Status::Overrun);
+    assert(ring.lost() == 20);
+    assert(ring.poll(record) == ShmMarketDataReader::Status::Empty);
+
+    // Reading resumes with the next record written
+    publisher.value()->publishBookUpdate(levelUpdate(1000, 21, 21));
+    assert(ring.poll(record) == ShmMarketDataReader::Status::Record);
+    assert(record.level.book_sequence == 21);
+    assert(ring.lost() == 20);
+
+    std::cout << "Overrun test passed!" << std::endl;
+}
+
+void testConcurrentReaderSeesWholeRecords() {
+    std::cout << "Testing a reader racing the publisher..." << std::endl;
+
+    ShmMarketDataOptions options;
+    options.name = ringName("race");
+    options.capacity = 64;
+    auto publisher = ShmMarketDataPublisher::create(options);
+    assert(publisher.isSuccess());
+    auto reader = ShmMarketDataReader::open(options.name);
+    assert(reader.isSuccess());
+
+    constexpr SequenceNumber Records = 200000;
+    std::thread writer([&publisher] {
+        for (SequenceNumber i = 1; i <= Records; ++i) {
+            publisher.value()->publishBookUpdate(levelUpdate(Price(i), i * 3, i));
+        }
+    });
+
+    // Records come out whole and in order; only overruns may skip ahead
+    auto& ring = *reader.value();
+    ShmMarketDataRecord record{};
+    SequenceNumber last = 0;
+    uint64_t received = 0;
+    while (ring.nextSequence() <= Records) {
+        auto status = ring.poll(record);
+        if (status == ShmMarketDataReader::Status::Empty) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (status == ShmMarketDataReader::Status::Overrun) continue;
+        assert(record.level.book_sequence > last);
+        assert(record.level.price == Price(record.level.book_sequence));
+        assert(record.level.quantity == record.level.book_sequence * 3);
+        last = record.level.book_sequence;
+        ++received;
+    }
+    writer.join();
+    assert(received + ring.lost() == Records);
+
+    std::cout << "Concurrent reader test passed!" << std::endl;
+}
+
+void testOpenErrors() {
+    std::cout << "Testing reader open errors..." << std::endl;
+
+    ShmMarketDataOptions options;
+    options.name = ringName("lifetime");
+    options.capacity = 8;
+    {
+        auto publisher = ShmMarketDataPublisher::create(options);
+        assert(publisher.isSuccess());
+        assert(ShmMarketDataReader::open(options.name).isSuccess());
+    }
+    // The publisher unlinks its ring on destruction
+    assert(!ShmMarketDataReader::open(options.name).isSuccess());
+    assert(!ShmMarketDataReader::open(ringName("missing")).isSuccess());
+
+    options.name.clear();
+    assert(!ShmMarketDataPublisher::create(options).isSuccess());
+
+    std::cout << "Open error test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running ShmMarketData tests..." << std::endl;
+
+    testRecordsRoundTrip();
+    testReaderStartsAtLiveEdge();
+    testOverrunSkipsToLiveEdge();
+    testConcurrentReaderSeesWholeRecords();
+    testOpenErrors();
+
+    std::cout << "\nAll ShmMarketData tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "orderbook/Network/ClOrdIdTable.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+
+using namespace orderbook;
+
+void testBindAndResolve() {
+    std::cout << "Testing ClOrdID bind and lookup..." << std::endl;
+
+    ClOrdIdTable table(7);
+    OrderId first = table.allocate();
+    OrderId second = table.allocate();
+    assert((first.value >> ClOrdIdTable::SequenceBits) == 7);
+    assert(second.value == first.value + 1);
+
+    assert(table.bind("ORD-1", first));
+    assert(table.bind("ORD-2", second));
+    assert(table.size() == 2);
+    assert(table.find("ORD-1") == first);
+    assert(table.clOrdIdFor(second)->view() == "ORD-2");
+
+    // Live IDs are unique; empty, over-long, unallocated and foreign IDs never bind
+    assert(!table.bind("ORD-1", table.allocate()));
+    assert(!table.bind("", table.allocate()));
+    assert(!table.bind(std::string(ClOrdIdKey::MaxLength + 1, 'X'), table.allocate()));
+    assert(!table.bind("ORD-9", OrderId(first.value + 100)));
+    ClOrdIdTable other(8);
+    assert(!table.bind("ORD-3", other.allocate()));
+    assert(!table.clOrdIdFor(other.allocate()));
+
+    std::cout << "Bind and lookup test passed!" << std::endl;
+}
+
+void testRebindMovesTheKey() {
+    std::cout << "Testing ClOrdID rebind..." << std::endl;
+
+    ClOrdIdTable table(1);
+    OrderId id = table.allocate();
+    OrderId other = table.allocate();
+    assert(table.bind("A", id));
+    assert(table.bind("B", other));
+
+    assert(table.rebind(id, "A2"));
+    assert(!table.find("A"));
+    assert(table.find("A2") == id);
+    assert(table.clOrdIdFor(id)->view() == "A2");
+    // A key held by another live order is refused
+    assert(!table.rebind(id, "B"));
+    assert(table.size() == 2);
+
+    std::cout << "Rebind test passed!" << std::endl;
+}
+
+void testUnbindShrinksTheWindow() {
+    std::cout << "Testing ClOrdID unbind..." << std::endl;
+
+    ClOrdIdTable table(1);
+    OrderId ids[4];
+    for (int i = 0; i < 4; ++i) {
+        ids[i] = table.allocate();
+        assert(table.bind("ORD-" + std::to_string(i), ids[i]));
+    }
+
+    // A dead ClOrdID stops resolving and can name a new order
+    table.unbind(ids[1]);
+    assert(!table.find("ORD-1"));
+    assert(!table.clOrdIdFor(ids[1]));
+    assert(!table.rebind(ids[1], "ORD-1b"));
+    OrderId reused = table.allocate();
+    assert(table.bind("ORD-1", reused));
+
+    // Unbinding from the front lets the window drop the dead sequences
+    table.unbind(ids[0]);
+    table.unbind(ids[2]);
+    table.unbind(ids[3]);
+    table.unbind(ids[3]);
+    assert(table.size() == 1);
+    assert(table.find("ORD-1") == reused);
+    assert(table.clOrdIdFor(reused)->view() == "ORD-1");
+
+    // An ID behind the window can no longer bind
+    assert(!table.bind("ORD-0", ids[0]));
+
+    std::cout << "Unbind test passed!" << std::endl;
+}
+
+void testClearForgetsEverything() {
+    std::cout << "Testing ClOrdID clear..." << std::endl;
+
+    ClOrdIdTable table(1);
+    OrderId id = table.allocate();
+    assert(table.bind("A", id));
+    table.clear();
+    assert(table.size() == 0);
+    assert(!table.find("A"));
+    assert(!table.clOrdIdFor(id));
+    assert(table.bind("A", table.allocate()));
+
+    std::cout << "Clear test passed!" << std::endl;
+}
+
+void testLongLivedOrderDoesNotPinTheWindow() {
+    std::cout << "Testing ClOrdID window with one long-lived order..." << std::endl;
+
+    ClOrdIdTable table(3);
+    OrderId resting = table.allocate();
+    assert(table.bind("REST", resting));
+
+    // Many short-lived orders behind it: the window stays capped
+    OrderId last;
+    for (size_t i = 0; i < 3 * ClOrdIdTable::MaxWindow; ++i) {
+        last = table.allocate();
+        std::string id = "ORD-" + std::to_string(i);
+        assert(table.bind(id, last));
+        if (i + 1 < 3 * ClOrdIdTable::MaxWindow) table.unbind(last);
+    }
+    assert(table.windowSize() <= ClOrdIdTable::MaxWindow);
+    assert(table.stragglerCount() == 1);
+    assert(table.size() == 2);
+
+    // The straggler still resolves both ways, moves, and reports as live
+    assert(table.find("REST") == resting);
+    assert(table.clOrdIdFor(resting)->view() == "REST");
+    assert(table.rebind(resting, "REST-2"));
+    assert(!table.find("REST") && table.find("REST-2") == resting);
+    std::vector<OrderId> live = table.liveOrders();
+    assert(live.size() == 2 && live[0] == resting && live[1] == last);
+
+    table.unbind(resting);
+    assert(table.stragglerCount() == 0 && table.size() == 1);
+    assert(!table.clOrdIdFor(resting));
+    assert(!table.find("REST-2"));
+
+    std::cout << "Long-lived order window test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running ClOrdIdTable tests..." << std::endl;
+
+    testBindAndResolve();
+    testRebindMovesTheKey();
+    testUnbindShrinksTheWindow();
+    testClearForgetsEverything();
+    testLongLivedOrderDoesNotPinTheWindow();
+
+    std::cout << "\nAll ClOrdIdTable tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "orderbook/Network/FixFramer.hpp"
+#include "orderbook/Network/FixParser.hpp"
+#include "orderbook/Network/FixConstants.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+using namespace orderbook;
+using namespace orderbook::fix;
+
+namespace {
+
+// Whole message with a correct BodyLength and CheckSum; '|' stands for SOH
+std::string fixMessage(const std::string& body_fields) {
+    std::string body = body_fields;
+    for (char& c : body) {
+        if (c == '|') c = FIELD_DELIMITER;
+    }
+    std::string message = "8=FIX.4.4";
+    message += FIELD_DELIMITER;
+    message += "9=" + std::to_string(body.size());
+    message += FIELD_DELIMITER;
+    message += body;
+    unsigned sum = 0;
+    for (char c : message) sum += static_cast<unsigned char>(c);
+    char trailer[8];
+    std::snprintf(trailer, sizeof(trailer), "10=%03u", sum % 256);
+    message += trailer;
+    message += FIELD_DELIMITER;
+    return message;
+}
+
+void feed(FixFramer& framer, const std::string& bytes) {
+    auto [space, capacity] = framer.prepare(bytes.size());
+    assert(capacity >= bytes.size());
+    std::memcpy(space, bytes.data(), bytes.size());
+    framer.commit(bytes.size());
+}
+
+const std::string NewOrder = "35=D|49=CLIENT|56=EXCH|34=2|11=ORD-1|1=ACC-7|55=AAPL|54=1|40=2|38=100|44=150.25|59=3|";
+
+}
+
+void testFramesBackToBackMessages() {
+    std::cout << "Testing framing of several messages in one read..." << std::endl;
+
+    FixFramer framer;
+    std::string first = fixMessage(NewOrder);
+    std::string second = fixMessage("35=0|49=CLIENT|56=EXCH|34=3|");
+    std::string third = fixMessage("35=F|49=CLIENT|56=EXCH|34=4|11=ORD-2|41=ORD-1|55=AAPL|54=1|");
+    feed(framer, first + second + third);
+
+    std::string_view message;
+    std::string error;
+    assert(framer.next(message, error) == FixFramer::Status::Message && message == first);
+    assert(framer.next(message, error) == FixFramer::Status::Message && message == second);
+    assert(framer.next(message, error) == FixFramer::Status::Message && message == third);
+    assert(framer.next(message, error) == FixFramer::Status::Incomplete);
+    assert(framer.buffered() == 0);
+
+    std::cout << "Back-to-back framing test passed!" << std::endl;
+}
+
+void testPartialReadsWaitForWholeMessage() {
+    std::cout << "Testing framing across byte-sized reads..." << std::endl;
+
+    FixFramer framer(16);
+    std::string whole = fixMessage(NewOrder);
+    std::string_view message;
+    std::string error;
+    for (size_t i = 0; i + 1 < whole.size(); ++i) {
+        feed(framer, whole.substr(i, 1));
+        assert(framer.next(message, error) == FixFramer::Status::Incomplete);
+    }
+    feed(framer, whole.substr(whole.size() - 1));
+    assert(framer.next(message, error) == FixFramer::Status::Message);
+    assert(message == whole);
+    // The buffer grew past its initial capacity to hold the message
+    assert(framer.capacity() >= whole.size());
+
+    std::cout << "Partial read test passed!" << std::endl;
+}
+
+void testMalformedInputResyncs() {
+    std::cout << "Testing resync after malformed input..." << std::endl;
+
+    FixFramer framer;
+    std::string good = fixMessage("35=0|49=CLIENT|56=EXCH|34=5|");
+    std::string_view message;
+    std::string error;
+
+    // Leading garbage is skipped up to the next BeginString
+    feed(framer, "garbage" + good);
+    assert(framer.next(message, error) == FixFramer::Status::Malformed);
+    assert(!error.empty());
+    assert(framer.next(message, error) == FixFramer::Status::Message && message == good);
+
+    // A BodyLength that does not land on the trailer
+    std::string bad = good;
+    size_t length_at = bad.find("9=") + 2;
+    bad[length_at] = static_cast<char>(bad[length_at] == '1' ? '2' : '1');
+    feed(framer, bad + good);
+    assert(framer.next(message, error) == FixFramer::Status::Malformed);
+    assert(framer.next(message, error) == FixFramer::Status::Message && message == good);
+
+    // BodyLength must come right after BeginString
+    std::string swapped = "8=FIX.4.4";
+    swapped += FIELD_DELIMITER;
+    swapped += "35=0";
+    swapped += FIELD_DELIMITER;
+    feed(framer, swapped + good);
+    assert(framer.next(message, error) == FixFramer::Status::Malformed);
+    assert(framer.next(message, error) == FixFramer::Status::Message && message == good);
+    assert(framer.next(message, error) == FixFramer::Status::Incomplete);
+
+    std::cout << "Resync test passed!" << std::endl;
+}
+
+void testParsesFramedNewOrder() {
+    std::cout << "Testing parse of a framed New Order Single..." << std::endl;
+
+    FixFramer framer;
+    feed(framer, fixMessage(NewOrder));
+    std::string_view raw;
+    std::string error;
+    assert(framer.next(raw, error) == FixFramer::Status::Message);
+
+    FixMessageParser parser;
+    auto parsed = parser.parseMessage(raw);
+    assert(parsed.isValid);
+    assert(parsed.msgType == MSG_TYPE_NEW_ORDER_SINGLE);
+    assert(parsed.field(TAG_SENDER_COMP_ID) == "CLIENT");
+    // Field views point into the framer's buffer, not a copy
+    assert(parsed.field(TAG_SYMBOL).data() >= raw.data() &&
+           parsed.field(TAG_SYMBOL).data() < raw.data() + raw.size());
+    int seq = 0;
+    assert(parsed.getNumber(TAG_MSG_SEQ_NUM, seq) && seq == 2);
+
+    auto order = parser.parseNewOrderSingle(parsed);
+    assert(order.isValid);
+    assert(order.clOrdId == "ORD-1");
+    assert(order.account == "ACC-7");
+    assert(order.symbol == "AAPL");
+    assert(order.side == Side::Buy);
+    assert(order.orderType == OrderType::Limit);
+    assert(order.timeInForce == TimeInForce::IOC);
+    assert(order.quantity == 100);
+    assert(order.price == 150.25);
+
+    // Cancel/replace takes its Account from tag 1, not from the ClOrdID
+    auto replace = parser.parseOrderCancelReplaceRequest(
+        parser.parseMessage(fixMessage("35=G|49=CLIENT|56=EXCH|34=3|11=ORD-2|41=ORD-1|1=ACC-7|55=AAPL|54=1|40=2|38=50|44=150.5|")));
+    assert(replace.isValid);
+    assert(replace.clOrdId == "ORD-2" && replace.origClOrdId == "ORD-1");
+    assert(replace.account == "ACC-7");
+
+    std::cout << "Framed parse test passed!" << std::endl;
+}
+
+void testParserFieldTable() {
+    std::cout << "Testing parser field lookup rules..." << std::endl;
+
+    FixMessageParser parser;
+    std::string raw = fixMessage("35=D|49=CLIENT|56=EXCH|34=2|11=FIRST|11=SECOND|5001=high|5001=higher|");
+    auto parsed = parser.parseMessage(raw);
+    assert(parsed.isValid);
+    // Repeated tags: the last value wins, for indexed and high tags alike
+    assert(parsed.field(TAG_CLORD_ID) == "SECOND");
+    assert(parsed.field(5001) == "higher");
+    assert(!parsed.hasField(TAG_PRICE));
+    assert(parsed.field(TAG_PRICE).empty());
+    int number = 0;
+    assert(!parsed.getNumber(TAG_SENDER_COMP_ID, number));
+
+    std::cout << "Field lookup test passed!" << std::endl;
+}
+
+void testParserRejects() {
+    std::cout << "Testing parser rejects..." << std::endl;
+
+    FixMessageParser parser;
+    assert(!parser.parseMessage("").isValid);
+
+    std::string no_type = fixMessage("49=CLIENT|56=EXCH|34=2|");
+    assert(!parser.parseMessage(no_type).isValid);
+
+    std::string old_version = fixMessage("35=0|49=CLIENT|56=EXCH|34=2|");
+    old_version.replace(old_version.find("FIX.4.4"), 7, "FIX.4.2");
+    auto parsed = parser.parseMessage(old_version);
+    assert(!parsed.isValid && parsed.errorMessage.find("FIX.4.2") != std::string::npos);
+
+    std::string bad_field = fixMessage("35=0|49=CLIENT|novalue|");
+    assert(!parser.parseMessage(bad_field).isValid);
+
+    // Well-formed envelope, unusable order fields
+    std::string bad_qty = fixMessage("35=D|49=CLIENT|56=EXCH|34=2|11=ORD-1|55=AAPL|54=1|40=2|38=10x|44=1.5|");
+    auto order = parser.parseNewOrderSingle(parser.parseMessage(bad_qty));
+    assert(!order.isValid && !order.errorMessage.empty());
+    std::string no_price = fixMessage("35=D|49=CLIENT|56=EXCH|34=2|11=ORD-1|55=AAPL|54=1|40=2|38=10|");
+    assert(!parser.parseNewOrderSingle(parser.parseMessage(no_price)).isValid);
+    std::string heartbeat = fixMessage("35=0|49=CLIENT|56=EXCH|34=2|");
+    assert(!parser.parseNewOrderSingle(parser.parseMessage(heartbeat)).isValid);
+
+    std::cout << "Parser reject test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running FixFramer tests..." << std::endl;
+
+    testFramesBackToBackMessages();
+    testPartialReadsWaitForWholeMessage();
+    testMalformedInputResyncs();
+    testParsesFramedNewOrder();
+    testParserFieldTable();
+    testParserRejects();
+
+    std::cout << "\nAll FixFramer tests passed successfully!" << std::endl;
+    return 0;
+}
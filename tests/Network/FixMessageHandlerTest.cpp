@@ -0,0 +1,167 @@
+#include "orderbook/Network/FixMessageHandler.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include <iostream>
+#include <cassert>
+
+using namespace orderbook;
+
+namespace {
+
+FixMessageParser::NewOrderSingle newOrder(const std::string& clOrdId, Side side, double price) {
+    FixMessageParser::NewOrderSingle order;
+    order.clOrdId = clOrdId;
+    order.symbol = "AAPL";
+    order.side = side;
+    order.orderType = OrderType::Limit;
+    order.timeInForce = TimeInForce::GTC;
+    order.price = price;
+    order.quantity = 100;
+    order.isValid = true;
+    return order;
+}
+
+}
+
+void testSessionOwnsItsOrders() {
+    std::cout << "Testing per-session order ownership..." << std::endl;
+
+    auto manager = std::make_shared<OrderManager>();
+    FixMessageHandler first(manager, nullptr);
+    FixMessageHandler second(manager, nullptr);
+    assert(first.sessionIndex() != second.sessionIndex());
+
+    // Orders keep the client's Account(1), whichever session entered them
+    auto order = newOrder("A1", Side::Buy, 100.0);
+    order.account = "ACC-7";
+    first.handleNewOrderSingle(order);
+    order.clOrdId = "A2";
+    second.handleNewOrderSingle(order);
+    assert(manager->getActiveOrderCount() == 2);
+    OrderId first_id((uint64_t(first.sessionIndex()) << ClOrdIdTable::SequenceBits) | 1);
+    OrderId second_id((uint64_t(second.sessionIndex()) << ClOrdIdTable::SequenceBits) | 1);
+    assert(manager->getOrder(first_id)->account_id == accountTable().intern("ACC-7"));
+    assert(manager->getOrder(second_id)->account_id == manager->getOrder(first_id)->account_id);
+
+    std::cout << "Session ownership test passed!" << std::endl;
+}
+
+void testReconnectKeepsAccountPosition() {
+    std::cout << "Testing risk limits across a reconnect..." << std::endl;
+
+    RiskManager::RiskLimits limits;
+    limits.max_position = 150;
+    limits.min_position = -150;
+    auto risk = std::make_shared<RiskManager>(limits);
+    OrderBookOptions options;
+    options.own_consumer_thread = false;
+    OrderBook book(risk, nullptr, nullptr, options);
+    auto manager = std::make_shared<OrderManager>(book);
+
+    auto seller = std::make_unique<FixMessageHandler>(manager, nullptr);
+    auto order = newOrder("S1", Side::Sell, 100.0);
+    order.account = "SELLER";
+    order.quantity = 150;
+    seller->handleNewOrderSingle(order);
+
+    // Buy 100 on one session, then disconnect and reconnect
+    auto session = std::make_unique<FixMessageHandler>(manager, nullptr);
+    order = newOrder("B1", Side::Buy, 100.0);
+    order.account = "MM-1";
+    session->handleNewOrderSingle(order);
+    assert(book.getTradeCount() == 1);
+    session->cancelSessionOrders();
+    session = std::make_unique<FixMessageHandler>(manager, nullptr);
+
+    // The position followed the account, so another 100 would breach the limit
+    order.clOrdId = "B2";
+    session->handleNewOrderSingle(order);
+    assert(book.getTradeCount() == 1);
+    assert(risk->getPosition(accountTable().intern("MM-1"), symbolTable().intern("AAPL")) == 100);
+    assert(session->liveClOrdIdCount() == 0);
+
+    std::cout << "Reconnect risk test passed!" << std::endl;
+}
+
+void testCancelOnDisconnectIsOneMassCancel() {
+    std::cout << "Testing cancel-on-disconnect..." << std::endl;
+
+    auto manager = std::make_shared<OrderManager>();
+    FixMessageHandler first(manager, nullptr);
+    FixMessageHandler second(manager, nullptr);
+
+    first.handleNewOrderSingle(newOrder("A1", Side::Buy, 100.0));
+    first.handleNewOrderSingle(newOrder("A2", Side::Sell, 105.0));
+    first.handleNewOrderSingle(newOrder("A3", Side::Buy, 98.0));
+    // The same ClOrdID and account on another session is a different session's order
+    second.handleNewOrderSingle(newOrder("A1", Side::Buy, 97.0));
+    assert(manager->getActiveOrderCount() == 4);
+
+    assert(first.cancelSessionOrders() == 3);
+    assert(manager->getActiveOrderCount() == 1);
+
+    // Nothing is left to cancel, and the other session's order survives
+    assert(first.cancelSessionOrders() == 0);
+    assert(second.cancelSessionOrders() == 1);
+    assert(manager->getActiveOrderCount() == 0);
+
+    std::cout << "Cancel-on-disconnect test passed!" << std::endl;
+}
+
+void testTerminalOrdersReleaseClOrdId() {
+    std::cout << "Testing ClOrdID release on terminal reports..." << std::endl;
+
+    auto manager = std::make_shared<OrderManager>();
+    FixMessageHandler handler(manager, nullptr);
+    handler.handleNewOrderSingle(newOrder("A1", Side::Buy, 100.0));
+    handler.handleNewOrderSingle(newOrder("A2", Side::Buy, 99.0));
+    assert(handler.liveClOrdIdCount() == 2);
+
+    FixMessageParser::OrderCancelRequest cancel;
+    cancel.clOrdId = "C1";
+    cancel.origClOrdId = "A1";
+    cancel.symbol = "AAPL";
+    cancel.side = Side::Buy;
+    cancel.isValid = true;
+    handler.handleOrderCancelRequest(cancel);
+    assert(handler.liveClOrdIdCount() == 1);
+
+    // The cancelled order's ClOrdIDs no longer resolve, so a repeat cancel finds nothing
+    cancel.clOrdId = "C2";
+    cancel.origClOrdId = "C1";
+    handler.handleOrderCancelRequest(cancel);
+    assert(handler.liveClOrdIdCount() == 1);
+    assert(manager->getActiveOrderCount() == 1);
+
+    std::cout << "ClOrdID release test passed!" << std::endl;
+}
+
+void testFilledOnArrivalReleasesClOrdId() {
+    std::cout << "Testing ClOrdID release of an order filled on arrival..." << std::endl;
+
+    OrderBookOptions options;
+    options.own_consumer_thread = false;
+    OrderBook book(nullptr, nullptr, nullptr, options);
+    auto manager = std::make_shared<OrderManager>(book);
+    FixMessageHandler handler(manager, nullptr);
+
+    handler.handleNewOrderSingle(newOrder("B1", Side::Buy, 100.0));
+    handler.handleNewOrderSingle(newOrder("S1", Side::Sell, 100.0));
+    // S1 traded out before it could rest; only B1's binding remains
+    assert(book.getTradeCount() == 1);
+    assert(handler.liveClOrdIdCount() == 1);
+
+    std::cout << "Filled-on-arrival release test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running FixMessageHandler tests..." << std::endl;
+
+    testSessionOwnsItsOrders();
+    testReconnectKeepsAccountPosition();
+    testCancelOnDisconnectIsOneMassCancel();
+    testTerminalOrdersReleaseClOrdId();
+    testFilledOnArrivalReleasesClOrdId();
+
+    std::cout << "\nAll FixMessageHandler tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include "orderbook/Network/FixSession.hpp"
+#include "orderbook/Network/FixTransport.hpp"
+#include <boost/asio.hpp>
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace orderbook;
+using boost::asio::ip::tcp;
+
+namespace {
+
+// In-memory transport: the test feeds reads and completes writes by hand
+struct ScriptedTransport : FixTransport {
+    boost::asio::io_context& io;
+    boost::asio::mutable_buffer read_buffer;
+    IoHandler read_handler;
+    IoHandler write_handler;
+    std::string written;
+    size_t writes = 0;
+    std::vector<bool> corks;
+    bool no_delay = false;
+    bool open = true;
+
+    explicit ScriptedTransport(boost::asio::io_context& context) : io(context) {}
+
+    void asyncConnect(const std::string&, uint16_t, ConnectHandler handler) override {
+        boost::asio::post(io, [handler] { handler({}); });
+    }
+    void asyncReadSome(boost::asio::mutable_buffer buffer, IoHandler handler) override {
+        read_buffer = buffer;
+        read_handler = std::move(handler);
+    }
+    void asyncWrite(const std::vector<boost::asio::const_buffer>& buffers, IoHandler handler) override {
+        for (const auto& buffer : buffers) written.append(static_cast<const char*>(buffer.data()), buffer.size());
+        ++writes;
+        write_handler = std::move(handler);
+    }
+    void setNoDelay(bool enabled, boost::system::error_code&) override { no_delay = enabled; }
+    void setCork(bool enabled) override { corks.push_back(enabled); }
+    bool isOpen() const override { return open; }
+    void close() override {
+        open = false;
+        read_handler = nullptr;
+        write_handler = nullptr;
+    }
+
+    void deliver(const std::string& bytes) {
+        assert(read_handler && bytes.size() <= read_buffer.size());
+        std::memcpy(read_buffer.data(), bytes.data(), bytes.size());
+        auto handler = std::move(read_handler);
+        read_handler = nullptr;
+        boost::asio::post(io, [handler, size = bytes.size()] { handler({}, size); });
+    }
+    void completeWrite() {
+        assert(write_handler);
+        auto handler = std::move(write_handler);
+        write_handler = nullptr;
+        boost::asio::post(io, [handler] { handler({}, 0); });
+    }
+};
+
+size_t count(const std::string& haystack, const std::string& needle) {
+    size_t found = 0;
+    for (size_t at = haystack.find(needle); at != std::string::npos; at = haystack.find(needle, at + 1)) ++found;
+    return found;
+}
+
+}
+
+void testSessionRunsOverTransport() {
+    std::cout << "Testing FIX session over a custom transport..." << std::endl;
+
+    boost::asio::io_context io;
+    auto owned = std::make_unique<ScriptedTransport>(io);
+    ScriptedTransport* transport = owned.get();
+    auto session = std::make_shared<FixSession>(std::move(owned), io);
+    session->setSessionIds("SERVER", "CLIENT");
+    session->start();
+    // The write policy goes to the transport, and a read is posted at once
+    assert(transport->no_delay && transport->read_handler);
+
+    // Inbound bytes are framed and dispatched from whatever the transport read
+    FixMessageParser client;
+    transport->deliver(client.generateHeartbeat("CLIENT", "SERVER", 1, "PING-1"));
+    io.poll();
+    assert(session->getStats().heartbeatsReceived == 1 && session->getStats().messagesReceived == 1);
+    assert(transport->read_handler);
+
+    // Outbound messages are one gathered write each while the transport keeps up
+    session->sendHeartbeat();
+    assert(transport->writes == 1 && count(transport->written, "35=0\x01") == 1);
+    transport->completeWrite();
+    io.poll();
+
+    // A logout is answered and closes the transport
+    transport->deliver(client.generateLogout("CLIENT", "SERVER", 2, "bye"));
+    io.poll();
+    assert(count(transport->written, "35=5\x01") == 1);
+    assert(!transport->isOpen() && session->getState() == FixSession::SessionState::Disconnected);
+    io.poll();
+
+    std::cout << "Custom transport session test passed!" << std::endl;
+}
+
+void testBacklogIsGatheredAndCorked() {
+    std::cout << "Testing gathered writes through the transport..." << std::endl;
+
+    boost::asio::io_context io;
+    auto owned = std::make_unique<ScriptedTransport>(io);
+    ScriptedTransport* transport = owned.get();
+    auto session = std::make_shared<FixSession>(std::move(owned), io);
+    FixSession::WriteOptions options;
+    options.tcp_no_delay = false;
+    options.tcp_cork = true;
+    session->setWriteOptions(options);
+    session->setSessionIds("SERVER", "CLIENT");
+    session->start();
+    assert(!transport->no_delay);
+
+    // Messages queued behind an in-flight write leave together, corked
+    session->sendHeartbeat();
+    for (int i = 0; i < 3; ++i) session->sendHeartbeat();
+    assert(transport->writes == 1 && transport->corks.empty());
+    transport->completeWrite();
+    io.poll();
+    assert(transport->writes == 2 && count(transport->written, "35=0\x01") == 4);
+    assert(transport->corks == std::vector<bool>{true});
+
+    // Uncorked once the burst drains
+    transport->completeWrite();
+    io.poll();
+    assert((transport->corks == std::vector<bool>{true, false}));
+
+    session->close();
+    assert(!transport->isOpen());
+    io.poll();
+
+    std::cout << "Gathered write test passed!" << std::endl;
+}
+
+void testAsioTcpTransportLoopback() {
+    std::cout << "Testing Asio TCP transport over loopback..." << std::endl;
+
+    boost::asio::io_context io;
+    tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    tcp::socket accepted(io);
+    acceptor.async_accept(accepted, [](const boost::system::error_code& ec) { assert(!ec); });
+
+    AsioTcpTransport client(io);
+    bool connected = false;
+    client.asyncConnect("127.0.0.1", acceptor.local_endpoint().port(),
+                        [&](const boost::system::error_code& ec) { connected = !ec; });
+    io.run();
+    io.restart();
+    assert(connected && client.isOpen());
+
+    boost::system::error_code ec;
+    client.setNoDelay(true, ec);
+    assert(!ec);
+    client.setCork(true);
+
+    // A gathered write arrives whole at the peer
+    std::string head = "8=FIX.4.4\x01";
+    std::string tail = "35=0\x01";
+    std::vector<boost::asio::const_buffer> buffers = {boost::asio::buffer(head), boost::asio::buffer(tail)};
+    size_t sent = 0;
+    client.asyncWrite(buffers, [&](const boost::system::error_code& error, size_t bytes) {
+        assert(!error);
+        sent = bytes;
+    });
+    io.run();
+    io.restart();
+    client.setCork(false);
+    assert(sent == head.size() + tail.size());
+    std::string received(sent, '\0');
+    boost::asio::read(accepted, boost::asio::buffer(received));
+    assert(received == head + tail);
+
+    // And reads come back through asyncReadSome
+    boost::asio::write(accepted, boost::asio::buffer(tail));
+    char buffer[64];
+    size_t got = 0;
+    client.asyncReadSome(boost::asio::buffer(buffer), [&](const boost::system::error_code& error, size_t bytes) {
+        assert(!error);
+        got = bytes;
+    });
+    io.run();
+    assert(std::string(buffer, got) == tail);
+
+    client.close();
+    assert(!client.isOpen());
+
+    // A failed resolve completes with an error rather than throwing
+    io.restart();
+    AsioTcpTransport unresolved(io);
+    boost::system::error_code connect_error;
+    unresolved.asyncConnect("no-such-host.invalid", 1, [&](const boost::system::error_code& error) {
+        connect_error = error;
+    });
+    io.run();
+    assert(connect_error);
+
+    std::cout << "Asio TCP transport test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running FIX transport tests..." << std::endl;
+
+    testSessionRunsOverTransport();
+    testBacklogIsGatheredAndCorked();
+    testAsioTcpTransportLoopback();
+
+    std::cout << "\nAll FIX transport tests passed successfully!" << std::endl;
+    return 0;
+}
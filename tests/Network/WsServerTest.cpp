@@ -0,0 +1,104 @@
+#include "orderbook/Network/WsServer.hpp"
+#include <iostream>
+#include <cassert>
+
+using namespace orderbook;
+
+namespace {
+
+WsFrameQueue::Frame frame(const std::string& text) {
+    return std::make_shared<std::string const>(text);
+}
+
+}
+
+void testFramesQueueInOrder() {
+    std::cout << "Testing frame queue order..." << std::endl;
+
+    WsFrameQueue queue(4);
+    auto snapshot = frame("SNAPSHOT");
+    assert(!queue.push(frame("DELTA 1"), snapshot));
+    assert(!queue.push(frame("DELTA 2"), snapshot));
+    assert(queue.size() == 2);
+
+    queue.startWrite();
+    assert(*queue.front() == "DELTA 1");
+    queue.finishWrite();
+    assert(*queue.front() == "DELTA 2");
+    assert(!queue.writing());
+
+    std::cout << "Frame queue order test passed!" << std::endl;
+}
+
+void testLaggingClientResyncsFromSnapshot() {
+    std::cout << "Testing conflation of dropped deltas into a snapshot..." << std::endl;
+
+    WsFrameQueue queue(2);
+    assert(!queue.push(frame("DELTA 1"), frame("SNAPSHOT 1")));
+    queue.startWrite();
+    assert(!queue.push(frame("DELTA 2"), frame("SNAPSHOT 2")));
+    assert(!queue.push(frame("DELTA 3"), frame("SNAPSHOT 3")));
+
+    // Two unsent frames are waiting: the third broadcast replaces them with its snapshot
+    assert(queue.push(frame("DELTA 4"), frame("SNAPSHOT 4")));
+    assert(queue.size() == 2);
+
+    // The in-flight frame is untouched, and no delta survives after the gap
+    assert(*queue.front() == "DELTA 1");
+    queue.finishWrite();
+    assert(*queue.front() == "SNAPSHOT 4");
+    queue.startWrite();
+    queue.finishWrite();
+    assert(queue.empty());
+
+    // Later deltas diff against the snapshot's state and queue normally
+    assert(!queue.push(frame("DELTA 5"), frame("SNAPSHOT 5")));
+    assert(*queue.front() == "DELTA 5");
+
+    std::cout << "Conflation test passed!" << std::endl;
+}
+
+void testSnapshotBroadcastConflatesToItself() {
+    std::cout << "Testing conflation of a full snapshot broadcast..." << std::endl;
+
+    WsFrameQueue queue(1);
+    auto first = frame("SNAPSHOT 1");
+    assert(!queue.push(first, first));
+    auto second = frame("SNAPSHOT 2");
+    assert(queue.push(second, second));
+    assert(queue.size() == 1);
+    assert(*queue.front() == "SNAPSHOT 2");
+
+    std::cout << "Snapshot conflation test passed!" << std::endl;
+}
+
+void testClearKeepsInFlightFrame() {
+    std::cout << "Testing clear with a write in flight..." << std::endl;
+
+    WsFrameQueue queue(4);
+    auto snapshot = frame("SNAPSHOT");
+    queue.push(frame("DELTA 1"), snapshot);
+    queue.push(frame("DELTA 2"), snapshot);
+    queue.startWrite();
+    queue.clear();
+
+    // The socket still owns the front buffer until its handler runs
+    assert(queue.size() == 1);
+    assert(*queue.front() == "DELTA 1");
+    queue.finishWrite();
+    assert(queue.empty());
+
+    std::cout << "Clear test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running WsServer tests..." << std::endl;
+
+    testFramesQueueInOrder();
+    testLaggingClientResyncsFromSnapshot();
+    testSnapshotBroadcastConflatesToItself();
+    testClearKeepsInFlightFrame();
+
+    std::cout << "\nAll WsServer tests passed successfully!" << std::endl;
+    return 0;
+}
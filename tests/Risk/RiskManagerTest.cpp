@@ -0,0 +1,116 @@
+#include "orderbook/Risk/RiskManager.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/OrderManager.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <thread>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+std::shared_ptr<RiskManager> positionLimited(int64_t max_position) {
+    RiskManager::RiskLimits limits;
+    limits.max_position = max_position;
+    limits.min_position = -max_position;
+    return std::make_shared<RiskManager>(limits);
+}
+
+std::unique_ptr<Order> buy(uint64_t id, Price price, Quantity quantity) {
+    return std::make_unique<Order>(id, Side::Buy, OrderType::Limit, TimeInForce::GTC, price, quantity,
+                                   "AAPL", "risk-account");
+}
+
+}
+
+void testSizeUpIsRiskChecked() {
+    std::cout << "Testing risk check on modify size-ups..." << std::endl;
+
+    auto risk = positionLimited(150);
+    OrderBook book(risk, nullptr, nullptr, callerConsumer());
+    OrderManager manager(book);
+
+    assert(manager.addOrder(buy(1, 10000, 100)).isSuccess());
+
+    // 100 resting + 60 more would pass the 150 limit
+    auto refused = manager.modifyOrder(OrderId(1), 0, 160);
+    assert(refused.isError());
+    assert(refused.errorCode() == ErrorCode::RiskRejected);
+    assert(manager.getOrder(OrderId(1))->quantity == 100);
+
+    // Within the limit the size-up is applied and its quantity stays reserved
+    assert(manager.modifyOrder(OrderId(1), 0, 140).isSuccess());
+    assert(manager.getOrder(OrderId(1))->quantity == 140);
+    assert(manager.addOrder(buy(2, 9900, 20)).isError());
+    assert(manager.addOrder(buy(3, 9900, 10)).isSuccess());
+
+    std::cout << "Size-up risk check test passed!" << std::endl;
+}
+
+void testConsumerDropsFailingSizeUp() {
+    std::cout << "Testing consumer-side check of an id-only modify..." << std::endl;
+
+    auto risk = positionLimited(150);
+    OrderBook book(risk, nullptr, nullptr, callerConsumer());
+    OrderManager manager(book);
+    assert(manager.addOrder(buy(1, 10000, 100)).isSuccess());
+
+    // Without the resting order the submitter cannot check; the consumer drops it
+    assert(book.modifyOrder(OrderId(1), 0, 200).isSuccess());
+    book.processPending();
+    assert(manager.getOrder(OrderId(1))->quantity == 100);
+
+    // A size-down releases exposure for new orders
+    assert(manager.modifyOrder(OrderId(1), 0, 50).isSuccess());
+    assert(manager.addOrder(buy(2, 9900, 100)).isSuccess());
+
+    std::cout << "Consumer size-up check test passed!" << std::endl;
+}
+
+void testSetLimitsPublishesNewVersion() {
+    std::cout << "Testing limit updates under concurrent checks..." << std::endl;
+
+    auto risk = positionLimited(1000000);
+    const RiskManager::RiskLimits& initial = risk->getLimits();
+    RiskManager::RiskLimits tight = initial;
+    tight.max_order_size = 100;
+
+    // Checks keep running while limits flip; each sees one whole version
+    std::atomic<bool> done{false};
+    std::thread checker([&] {
+        Order order(1, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10000, 50, "AAPL", "limits-account");
+        while (!done.load(std::memory_order_acquire)) {
+            RiskCheck check = risk->preTradeCheck(order);
+            assert(!check.isRejected());
+            risk->adjustExposure(order.account_id, order.symbol_id, order.side, -50);
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        risk->setLimits(i % 2 ? initial : tight);
+    }
+    done.store(true, std::memory_order_release);
+    checker.join();
+
+    risk->setLimits(tight);
+    assert(risk->getLimits().max_order_size == 100);
+    // References to earlier versions stay valid
+    assert(initial.max_order_size == RiskManager::RiskLimits{}.max_order_size);
+    Order large(2, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10000, 500, "AAPL", "limits-account");
+    assert(risk->preTradeCheck(large).isRejected());
+
+    std::cout << "Limit update test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running RiskManager tests..." << std::endl;
+
+    testSizeUpIsRiskChecked();
+    testConsumerDropsFailingSizeUp();
+    testSetLimitsPublishesNewVersion();
+
+    std::cout << "\nAll RiskManager tests passed successfully!" << std::endl;
+    return 0;
+}
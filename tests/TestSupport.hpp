@@ -0,0 +1,48 @@
+#pragma once
+#include "orderbook/Core/OrderBook.hpp"
+#include "orderbook/Core/CommandJournal.hpp"
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+namespace orderbook::testing {
+
+/**
+ * @brief Empty scratch directory under the system temp dir, unique to this process
+ */
+inline std::filesystem::path freshDirectory(const std::string& name) {
+    auto directory = std::filesystem::temp_directory_path() /
+                     ("orderbook-" + name + "-" + std::to_string(::getpid()));
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+/**
+ * @brief Book options for a test that drains the book itself with processPending()
+ */
+inline OrderBookOptions callerConsumer() {
+    OrderBookOptions options;
+    options.own_consumer_thread = false;
+    return options;
+}
+
+/**
+ * @brief Journal options for a directory, with segments small enough to roll over
+ */
+inline CommandJournalOptions journalIn(const std::filesystem::path& directory) {
+    CommandJournalOptions options;
+    options.directory = directory.string();
+    options.segment_bytes = size_t(1) << 20;
+    return options;
+}
+
+/**
+ * @brief GTC limit order
+ */
+inline Order limit(uint64_t id, Side side, Price price, Quantity quantity,
+                   const char* symbol = "TEST", const char* account = "test-account") {
+    return Order(id, side, OrderType::Limit, TimeInForce::GTC, price, quantity, symbol, account);
+}
+
+}
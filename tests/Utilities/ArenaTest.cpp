@@ -0,0 +1,126 @@
+#include "orderbook/Utilities/Arena.hpp"
+#include "orderbook/Core/OrderBook.hpp"
+#include "TestSupport.hpp"
+#include <iostream>
+#include <cassert>
+#include <set>
+#include <vector>
+
+using namespace orderbook;
+using namespace orderbook::testing;
+
+namespace {
+
+struct Tracked {
+    static int live;
+    uint64_t value;
+    Tracked() : value(0) { ++live; }
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+
+}
+
+void testArenaMapping() {
+    std::cout << "Testing arena mapping..." << std::endl;
+
+    Arena arena(10000);
+    assert(arena.data() && arena.size() >= 10000 && arena.size() % 4096 == 0);
+    auto* bytes = static_cast<unsigned char*>(arena.data());
+    for (size_t i = 0; i < arena.size(); i += 512) assert(bytes[i] == 0);
+
+    // Huge pages are best effort: without reserved pages the mapping still succeeds
+    ArenaOptions options;
+    options.huge_pages = true;
+    options.prefault = true;
+    Arena huge(3 << 20, options);
+    assert(huge.data() && huge.size() == (size_t(4) << 20));
+    static_cast<unsigned char*>(huge.data())[huge.size() - 1] = 1;
+
+    // Moving hands the mapping over whole
+    void* data = huge.data();
+    Arena moved(std::move(huge));
+    assert(moved.data() == data && !huge.data() && huge.size() == 0);
+
+    assert(numaNodeOfCpu(-1) == -1);
+    assert(numaNodeOfCpu(0) >= -1);
+
+    std::cout << "Arena mapping test passed!" << std::endl;
+}
+
+void testPoolSlots() {
+    std::cout << "Testing arena pool slots..." << std::endl;
+
+    {
+        ArenaPool<Tracked> pool(4);
+        assert(pool.capacity() == 4 && pool.available() == 4);
+        std::vector<Tracked*> objects;
+        for (int i = 0; i < 4; ++i) {
+            Tracked* object = pool.allocate();
+            assert(object && pool.owns(object) && object->value == 0);
+            object->value = 100 + i;
+            objects.push_back(object);
+        }
+        // Full: the caller falls back to the heap
+        assert(!pool.allocate());
+        assert(pool.inUse() == 4 && Tracked::live == 4);
+        Tracked outside;
+        assert(!pool.owns(&outside));
+
+        // Freed slots come back last-in, first-out and value-initialised
+        pool.release(objects[1]);
+        pool.release(objects[3]);
+        assert(pool.inUse() == 2 && Tracked::live == 3);
+        Tracked* again = pool.allocate();
+        assert(again == objects[3] && again->value == 0);
+        assert(pool.allocate() == objects[1]);
+        assert(!pool.allocate());
+
+        // Distinct, contiguous slots inside the one mapping
+        std::set<Tracked*> unique(objects.begin(), objects.end());
+        assert(unique.size() == 4);
+    }
+    // Whatever was still live is destroyed with the pool
+    assert(Tracked::live == 0);
+
+    std::cout << "Arena pool slot test passed!" << std::endl;
+}
+
+void testBookBeyondArenaCapacity() {
+    std::cout << "Testing order arena overflow..." << std::endl;
+
+    OrderBookOptions options = callerConsumer();
+    options.max_orders = 4;
+    OrderBook book(nullptr, nullptr, nullptr, options);
+    // The arena holds four; the rest come from the heap and behave the same
+    for (uint64_t id = 1; id <= 8; ++id) {
+        assert(book.addOrder(limit(id, Side::Buy, Price(10000 - id), 10)).isSuccess());
+    }
+    book.processPending();
+    assert(book.getOrderCount() == 8);
+    for (uint64_t id = 1; id <= 8; id += 2) {
+        assert(book.cancelOrder(OrderId(id)).isSuccess());
+    }
+    book.processPending();
+    assert(book.getOrderCount() == 4 && *book.bestBid() == 9998);
+
+    // Arena slots freed by the cancels are used again
+    for (uint64_t id = 11; id <= 14; ++id) {
+        assert(book.addOrder(limit(id, Side::Sell, Price(10100 + id), 5)).isSuccess());
+    }
+    book.processPending();
+    assert(book.getOrderCount() == 8 && *book.bestAsk() == 10111);
+
+    std::cout << "Order arena overflow test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running arena tests..." << std::endl;
+
+    testArenaMapping();
+    testPoolSlots();
+    testBookBeyondArenaCapacity();
+
+    std::cout << "\nAll arena tests passed successfully!" << std::endl;
+    return 0;
+}
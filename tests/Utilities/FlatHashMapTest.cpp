@@ -0,0 +1,149 @@
+#include "orderbook/Utilities/FlatHashMap.hpp"
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <unordered_map>
+
+using namespace orderbook;
+
+namespace {
+
+struct MixHash {
+    size_t operator()(uint64_t key) const {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<size_t>(key);
+    }
+};
+
+// Groups of eight keys share a home slot, so runs form and erase has to shift them
+struct ClusterHash {
+    size_t operator()(uint64_t key) const { return static_cast<size_t>(key / 8); }
+};
+
+// The same groups with their home slots spread over the table
+struct GroupHash {
+    size_t operator()(uint64_t key) const { return static_cast<size_t>((key / 8) * 0x9e3779b97f4a7c15ULL); }
+};
+
+template<typename Map>
+void assertMatches(const Map& map, const std::unordered_map<uint64_t, uint64_t>& reference) {
+    assert(map.size() == reference.size());
+    for (const auto& [key, value] : reference) {
+        auto it = map.find(key);
+        assert(it != map.end() && it->first == key && it->second == value);
+    }
+    size_t visited = 0;
+    for (const auto& entry : map) {
+        auto it = reference.find(entry.first);
+        assert(it != reference.end() && it->second == entry.second);
+        ++visited;
+    }
+    assert(visited == reference.size());
+}
+
+template<typename HashFn>
+void randomOperations(uint64_t key_space) {
+    FlatHashMap<uint64_t, uint64_t, HashFn> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(42);
+    for (int round = 0; round < 50000; ++round) {
+        uint64_t key = rng() % key_space;
+        switch (rng() % 3) {
+            case 0:
+                map[key] = round;
+                reference[key] = round;
+                break;
+            case 1:
+                assert(map.erase(key) == reference.erase(key));
+                break;
+            default: {
+                auto it = map.find(key);
+                auto ref = reference.find(key);
+                assert((it == map.end()) == (ref == reference.end()));
+                if (ref != reference.end()) assert(it->second == ref->second);
+            }
+        }
+    }
+    assertMatches(map, reference);
+}
+
+}
+
+void testMatchesReferenceMap() {
+    std::cout << "Testing random operations against std::unordered_map..." << std::endl;
+
+    randomOperations<MixHash>(4096);
+    randomOperations<GroupHash>(2048);
+
+    std::cout << "Reference map test passed!" << std::endl;
+}
+
+void testReserveAvoidsRehash() {
+    std::cout << "Testing presized inserts..." << std::endl;
+
+    FlatHashMap<uint64_t, uint64_t, MixHash> map(1000);
+    size_t capacity = map.capacity();
+    assert(capacity >= 1000);
+    for (uint64_t key = 0; key < 1000; ++key) {
+        map[key] = key * 2;
+    }
+    assert(map.capacity() == capacity);
+    assert(map.size() == 1000);
+
+    // Growing past the reservation keeps every entry
+    for (uint64_t key = 1000; key < 5000; ++key) {
+        map[key] = key * 2;
+    }
+    assert(map.capacity() > capacity);
+    for (uint64_t key = 0; key < 5000; ++key) {
+        auto it = map.find(key);
+        assert(it != map.end() && it->second == key * 2);
+    }
+
+    std::cout << "Presize test passed!" << std::endl;
+}
+
+void testEraseShiftsClusters() {
+    std::cout << "Testing erase inside a probe run..." << std::endl;
+
+    FlatHashMap<uint64_t, uint64_t, ClusterHash> map(64);
+    for (uint64_t key = 0; key < 24; ++key) {
+        map[key] = key;
+    }
+    // Remove from the start, middle and end of the merged runs
+    for (uint64_t key : {0, 9, 23, 12, 15}) {
+        assert(map.erase(key) == 1);
+        assert(map.find(key) == map.end());
+    }
+    assert(map.erase(9) == 0);
+    assert(map.size() == 19);
+    for (uint64_t key = 0; key < 24; ++key) {
+        bool erased = key == 0 || key == 9 || key == 23 || key == 12 || key == 15;
+        assert((map.find(key) == map.end()) == erased);
+    }
+
+    // Erase through an iterator, then clear
+    map.erase(map.find(5));
+    assert(map.find(5) == map.end() && map.size() == 18);
+    size_t capacity = map.capacity();
+    map.clear();
+    assert(map.empty() && map.capacity() == capacity);
+    assert(map.begin() == map.end());
+    map[7] = 70;
+    assert(map.find(7)->second == 70);
+
+    std::cout << "Cluster erase test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running FlatHashMap tests..." << std::endl;
+
+    testMatchesReferenceMap();
+    testReserveAvoidsRehash();
+    testEraseShiftsClusters();
+
+    std::cout << "\nAll FlatHashMap tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "orderbook/Utilities/MpscQueue.hpp"
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+struct Item {
+    uint32_t producer = 0;
+    uint32_t sequence = 0;
+};
+
+}
+
+void testFifoAndCapacity() {
+    std::cout << "Testing FIFO order and the full/empty edges..." << std::endl;
+
+    MpscQueue<int, 8> queue;
+    assert(queue.empty());
+    int value = 0;
+    assert(!queue.pop(value));
+
+    // Several laps around the ring
+    int next_in = 0;
+    int next_out = 0;
+    for (int lap = 0; lap < 5; ++lap) {
+        while (queue.push(next_in)) ++next_in;
+        assert(next_in - next_out == 8);
+        for (int i = 0; i < 5; ++i) {
+            assert(queue.pop(value) && value == next_out++);
+        }
+    }
+    while (queue.pop(value)) assert(value == next_out++);
+    assert(next_out == next_in);
+    assert(queue.empty());
+
+    std::cout << "FIFO test passed!" << std::endl;
+}
+
+void testBatchPushStopsAtFreeSpace() {
+    std::cout << "Testing batch pushes near a full queue..." << std::endl;
+
+    MpscQueue<int, 8> queue;
+    int batch[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    assert(queue.try_push_n(batch, 8) == 8);
+    assert(queue.try_push_n(batch, 8) == 0);
+
+    int out[8];
+    assert(queue.pop_n(out, 3) == 3);
+    assert(out[0] == 0 && out[2] == 2);
+    // Only what fits goes in, from the front of the batch
+    size_t pushed = 0;
+    while (size_t n = queue.try_push_n(batch + pushed, 8 - pushed)) pushed += n;
+    assert(pushed == 3);
+    assert(queue.pop_n(out, 8) == 8);
+    assert(out[4] == 7 && out[5] == 0 && out[7] == 2);
+    assert(queue.try_push_n(batch, 0) == 0);
+
+    std::cout << "Batch push test passed!" << std::endl;
+}
+
+void testProducersKeepTheirOrder() {
+    std::cout << "Testing concurrent producers..." << std::endl;
+
+    constexpr uint32_t Producers = 4;
+    constexpr uint32_t PerProducer = 20000;
+    constexpr uint32_t Batch = 4;
+    MpscQueue<Item, 256> queue;
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < Producers; ++p) {
+        producers.emplace_back([&queue, p] {
+            Item items[Batch];
+            for (uint32_t seq = 0; seq < PerProducer; seq += Batch) {
+                for (uint32_t i = 0; i < Batch; ++i) items[i] = Item{p, seq + i};
+                size_t sent = 0;
+                while (sent < Batch) {
+                    size_t n = queue.try_push_n(items + sent, Batch - sent);
+                    if (n == 0) std::this_thread::yield();
+                    sent += n;
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> expected(Producers, 0);
+    uint32_t received = 0;
+    Item item;
+    while (received < Producers * PerProducer) {
+        if (!queue.pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(item.producer < Producers);
+        assert(item.sequence == expected[item.producer]);
+        ++expected[item.producer];
+        ++received;
+    }
+    for (auto& producer : producers) producer.join();
+    assert(queue.empty());
+    for (uint32_t count : expected) assert(count == PerProducer);
+
+    std::cout << "Concurrent producer test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running MpscQueue tests..." << std::endl;
+
+    testFifoAndCapacity();
+    testBatchPushStopsAtFreeSpace();
+    testProducersKeepTheirOrder();
+
+    std::cout << "\nAll MpscQueue tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "orderbook/Utilities/ObjectPool.hpp"
+#include <iostream>
+#include <cassert>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+int live_widgets = 0;
+
+struct Widget {
+    uint64_t value = 0;
+    Widget() { ++live_widgets; }
+    ~Widget() { --live_widgets; }
+};
+
+struct Payload {
+    uint64_t a = 0;
+    uint64_t b = 0;
+};
+
+}
+
+void testAllocateReleaseAndReuse() {
+    std::cout << "Testing allocate, release and slot reuse..." << std::endl;
+
+    ObjectPool<Widget> pool(64);
+    Widget* first = pool.allocate();
+    assert(first && first->value == 0);
+    assert(live_widgets == 1);
+    assert(pool.owns(first));
+    first->value = 42;
+    pool.release(first);
+    assert(live_widgets == 0);
+
+    // The freed slot comes straight back, value-initialised again
+    Widget* again = pool.allocate();
+    assert(again == first && again->value == 0);
+    pool.release(again);
+
+    {
+        auto pooled = pool.acquire();
+        assert(pooled && pooled->value == 0);
+        auto moved = std::move(pooled);
+        assert(!pooled && moved);
+        assert(pool.getStats().in_use == 1);
+    }
+    assert(pool.getStats().in_use == 0);
+    assert(live_widgets == 0);
+
+    Widget outside;
+    assert(!pool.owns(&outside));
+    pool.release(nullptr);
+
+    std::cout << "Allocate and release test passed!" << std::endl;
+}
+
+void testGrowsAcrossSlabs() {
+    std::cout << "Testing growth past the first slab..." << std::endl;
+
+    ObjectPool<Payload> pool(ObjectPool<Payload>::MagazineSize);
+    std::vector<Payload*> objects;
+    std::set<Payload*> distinct;
+    for (int i = 0; i < 1000; ++i) {
+        Payload* p = pool.allocate();
+        assert(pool.owns(p));
+        p->a = static_cast<uint64_t>(i);
+        objects.push_back(p);
+        distinct.insert(p);
+    }
+    assert(distinct.size() == objects.size());
+    auto stats = pool.getStats();
+    assert(stats.slabs > 1);
+    assert(stats.in_use == 1000);
+    assert(stats.total_created >= 1000);
+    for (size_t i = 0; i < objects.size(); ++i) {
+        assert(objects[i]->a == i);
+        pool.release(objects[i]);
+    }
+    stats = pool.getStats();
+    assert(stats.in_use == 0);
+    assert(stats.available == stats.total_created);
+
+    // Released slots are reused before any new slab is carved
+    size_t slabs = stats.slabs;
+    for (auto& p : objects) p = pool.allocate();
+    assert(pool.getStats().slabs == slabs);
+    for (Payload* p : objects) pool.release(p);
+
+    std::cout << "Slab growth test passed!" << std::endl;
+}
+
+void testReleaseFromAnotherThread() {
+    std::cout << "Testing release on a different thread..." << std::endl;
+
+    ObjectPool<Payload> pool(256);
+    constexpr size_t Count = 5000;
+    std::vector<Payload*> objects(Count);
+    for (auto& p : objects) p = pool.allocate();
+
+    // Slots travel back to this thread through the depot
+    std::thread releaser([&] {
+        for (Payload* p : objects) pool.release(p);
+    });
+    releaser.join();
+    assert(pool.getStats().in_use == 0);
+    assert(pool.getStats().depot_magazines > 0);
+
+    size_t created = pool.getStats().total_created;
+    std::set<Payload*> distinct;
+    for (auto& p : objects) {
+        p = pool.allocate();
+        assert(distinct.insert(p).second);
+    }
+    // At most the releaser's two cached magazines are missing from the depot
+    assert(pool.getStats().total_created <= created + 2 * ObjectPool<Payload>::MagazineSize);
+    for (Payload* p : objects) pool.release(p);
+
+    std::cout << "Cross-thread release test passed!" << std::endl;
+}
+
+void testExitedThreadCacheIsAdopted() {
+    std::cout << "Testing thread cache adoption..." << std::endl;
+
+    ObjectPool<Payload> pool(64);
+    pool.release(pool.allocate());
+    assert(pool.getStats().thread_caches == 1);
+
+    for (int i = 0; i < 4; ++i) {
+        std::thread worker([&pool] {
+            std::vector<Payload*> held;
+            for (int j = 0; j < 100; ++j) held.push_back(pool.allocate());
+            for (Payload* p : held) pool.release(p);
+        });
+        worker.join();
+    }
+    // Each worker took over the cache its predecessor left behind
+    auto stats = pool.getStats();
+    assert(stats.thread_caches == 2);
+    assert(stats.in_use == 0);
+
+    std::cout << "Thread cache adoption test passed!" << std::endl;
+}
+
+void testNewPoolAfterDestroyedOne() {
+    std::cout << "Testing a pool created after another was destroyed..." << std::endl;
+
+    {
+        ObjectPool<Payload> pool(64);
+        pool.release(pool.allocate());
+    }
+    // This thread's cache entry for the old pool must not be reused
+    ObjectPool<Payload> pool(64);
+    Payload* p = pool.allocate();
+    assert(pool.owns(p));
+    pool.release(p);
+    assert(pool.getStats().in_use == 0);
+
+    std::cout << "Pool lifetime test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running ObjectPool tests..." << std::endl;
+
+    testAllocateReleaseAndReuse();
+    testGrowsAcrossSlabs();
+    testReleaseFromAnotherThread();
+    testExitedThreadCacheIsAdopted();
+    testNewPoolAfterDestroyedOne();
+
+    std::cout << "\nAll ObjectPool tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "orderbook/Utilities/PerformanceMeasurement.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace orderbook;
+
+namespace {
+
+using Perf = PerformanceMeasurement;
+using Histogram = PerformanceMeasurement::Histogram;
+
+bool within(Perf::Duration measured, uint64_t expected_ns, double tolerance) {
+    double delta = static_cast<double>(measured.count()) - static_cast<double>(expected_ns);
+    return delta <= expected_ns * tolerance && -delta <= expected_ns * tolerance;
+}
+
+}
+
+void testBucketLayout() {
+    std::cout << "Testing histogram bucket layout..." << std::endl;
+
+    // Exact below 2 * SubBuckets
+    for (uint64_t ns = 0; ns < 2 * Histogram::SubBuckets; ++ns) {
+        assert(Histogram::bucketFor(ns) == ns && Histogram::valueFor(ns) == ns);
+    }
+    // Monotonic, and each bucket's representative is within ~3% of what it holds
+    size_t previous = 0;
+    for (uint64_t ns = 64; ns < (uint64_t(1) << 30); ns += ns / 7 + 1) {
+        size_t bucket = Histogram::bucketFor(ns);
+        assert(bucket >= previous && bucket < Histogram::BucketCount);
+        previous = bucket;
+        double error = static_cast<double>(Histogram::valueFor(bucket)) - static_cast<double>(ns);
+        assert(error <= ns / 32.0 && -error <= ns / 32.0);
+    }
+    // Anything past the top magnitude lands in the last bucket
+    assert(Histogram::bucketFor(uint64_t(1) << 50) == Histogram::BucketCount - 1);
+
+    Histogram histogram;
+    histogram.record(100);
+    histogram.record(5000);
+    assert(histogram.sum() == 5100 && histogram.min() == 100 && histogram.max() == 5000);
+    assert(histogram.bucket(Histogram::bucketFor(5000)) == 1);
+    histogram.clear();
+    assert(histogram.sum() == 0 && histogram.max() == 0 && histogram.bucket(Histogram::bucketFor(5000)) == 0);
+
+    std::cout << "Bucket layout test passed!" << std::endl;
+}
+
+void testMetricIds() {
+    std::cout << "Testing metric registration..." << std::endl;
+
+    Perf& perf = Perf::getInstance();
+    Perf::MetricId first = perf.registerMetric("PerfTest::first");
+    Perf::MetricId second = perf.registerMetric("PerfTest::second");
+    assert(first != second && first < Perf::MaxMetrics && second < Perf::MaxMetrics);
+    assert(perf.registerMetric("PerfTest::first") == first);
+    // An unregistered name has no samples rather than creating a metric
+    assert(perf.getOperationStats("PerfTest::never").sample_count == 0);
+    // Out-of-range IDs are ignored
+    perf.recordLatency(Perf::InvalidMetric, Perf::Duration(10));
+
+    std::cout << "Metric registration test passed!" << std::endl;
+}
+
+void testPercentilesFromBuckets() {
+    std::cout << "Testing percentiles..." << std::endl;
+
+    Perf& perf = Perf::getInstance();
+    Perf::MetricId metric = perf.registerMetric("PerfTest::percentiles");
+    for (uint64_t ns = 1; ns <= 10000; ++ns) {
+        perf.recordLatency(metric, Perf::Duration(ns * 10));
+    }
+    Perf::OperationStats stats = perf.getOperationStats("PerfTest::percentiles");
+    assert(stats.sample_count == 10000);
+    assert(stats.min_latency.count() == 10 && stats.max_latency.count() == 100000);
+    assert(stats.avg_latency.count() == 50005);
+    assert(within(stats.p50_latency, 50000, 0.04));
+    assert(within(stats.p95_latency, 95000, 0.04));
+    assert(within(stats.p99_latency, 99000, 0.04));
+    assert(stats.throughput_ops_per_sec > 0.0);
+    assert(perf.getAllStats().count("PerfTest::percentiles") == 1);
+
+    std::cout << "Percentile test passed!" << std::endl;
+}
+
+void testThreadsMergeOnRead() {
+    std::cout << "Testing per-thread histograms..." << std::endl;
+
+    Perf& perf = Perf::getInstance();
+    Perf::MetricId metric = perf.registerMetric("PerfTest::threads");
+    std::vector<std::thread> threads;
+    for (uint64_t t = 1; t <= 4; ++t) {
+        threads.emplace_back([&perf, metric, t] {
+            for (int i = 0; i < 1000; ++i) perf.recordLatency(metric, Perf::Duration(t * 1000));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // Each thread filled its own store; the reader merges them
+    Perf::OperationStats stats = perf.getOperationStats("PerfTest::threads");
+    assert(stats.sample_count == 4000);
+    assert(stats.min_latency.count() == 1000 && stats.max_latency.count() == 4000);
+    assert(stats.total_time.count() == 10000000);
+    assert(within(stats.p50_latency, 3000, 0.04));
+
+    // ScopedTimer records into the same histograms
+    {
+        auto timer = perf.createTimer("PerfTest::scoped");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Perf::OperationStats scoped = perf.getOperationStats("PerfTest::scoped");
+    assert(scoped.sample_count == 1 && scoped.min_latency >= std::chrono::microseconds(500));
+
+    std::cout << "Per-thread histogram test passed!" << std::endl;
+}
+
+void testResetByGeneration() {
+    std::cout << "Testing reset..." << std::endl;
+
+    Perf& perf = Perf::getInstance();
+    Perf::MetricId metric = perf.registerMetric("PerfTest::reset");
+    std::thread([&perf, metric] {
+        for (int i = 0; i < 50; ++i) perf.recordLatency(metric, Perf::Duration(700));
+    }).join();
+    perf.recordLatency(metric, Perf::Duration(900));
+    assert(perf.getOperationStats("PerfTest::reset").sample_count == 51);
+
+    // Stores that have not caught up with the reset are skipped by readers
+    perf.reset();
+    assert(perf.getOperationStats("PerfTest::reset").sample_count == 0);
+    assert(perf.getAllStats().empty());
+
+    // The next sample on a thread clears its stale histograms first
+    perf.recordLatency(metric, Perf::Duration(300));
+    Perf::OperationStats stats = perf.getOperationStats("PerfTest::reset");
+    assert(stats.sample_count == 1 && stats.min_latency.count() == 300 && stats.max_latency.count() == 300);
+
+    std::cout << "Reset test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running performance measurement tests..." << std::endl;
+
+    testBucketLayout();
+    testMetricIds();
+    testPercentilesFromBuckets();
+    testThreadsMergeOnRead();
+    testResetByGeneration();
+
+    std::cout << "\nAll performance measurement tests passed successfully!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "orderbook/Utilities/TscClock.hpp"
+#include "orderbook/Core/Order.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+using namespace orderbook;
+
+void testCalibratedRate() {
+    std::cout << "Testing TSC calibration..." << std::endl;
+
+    TscClock::calibrate();
+    assert(TscClock::ticksPerNs() > 0.0);
+
+    // A slept interval measured in ticks agrees with steady_clock
+    auto steady_start = std::chrono::steady_clock::now();
+    TscClock::Ticks start = TscClock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TscClock::Ticks end = TscClock::now();
+    auto steady_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - steady_start).count();
+    auto tick_ns = TscClock::elapsed(start, end).count();
+    assert(end > start);
+    assert(tick_ns > steady_ns * 0.8 && tick_ns < steady_ns * 1.2);
+    assert(TscClock::toNanos(end - start) == static_cast<uint64_t>(tick_ns));
+
+    // A reversed interval is empty rather than wrapping
+    assert(TscClock::elapsed(end, start).count() == 0);
+
+    std::cout << "Calibration test passed!" << std::endl;
+}
+
+void testMonotonicStamps() {
+    std::cout << "Testing tick ordering..." << std::endl;
+
+    TscClock::Ticks previous = TscClock::now();
+    for (int i = 0; i < 100000; ++i) {
+        TscClock::Ticks next = TscClock::now();
+        assert(next >= previous);
+        previous = next;
+    }
+
+    // Orders and trades are stamped with ticks at construction
+    TscClock::Ticks before = TscClock::now();
+    Order order(1, Side::Buy, OrderType::Limit, TimeInForce::GTC, 10000, 10, "TEST", "acct");
+    Trade trade(1, OrderId(1), OrderId(2), 10000, 10, "TEST");
+    TscClock::Ticks after = TscClock::now();
+    assert(order.timestamp >= before && order.timestamp <= after);
+    assert(trade.timestamp >= before && trade.timestamp <= after);
+
+    std::cout << "Tick ordering test passed!" << std::endl;
+}
+
+void testWallClockConversion() {
+    std::cout << "Testing wall clock export..." << std::endl;
+
+    auto wall = std::chrono::system_clock::now();
+    TscClock::Ticks ticks = TscClock::now();
+    auto converted = TscClock::toWallClock(ticks);
+    auto skew = std::chrono::duration_cast<std::chrono::milliseconds>(converted - wall).count();
+    assert(skew > -50 && skew < 50);
+    int64_t wall_ns = TscClock::toWallNanos(ticks);
+    assert(wall_ns == std::chrono::duration_cast<std::chrono::nanoseconds>(converted.time_since_epoch()).count());
+
+    // Later ticks export to later wall times
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    assert(TscClock::toWallNanos(TscClock::now()) > wall_ns);
+
+    std::cout << "Wall clock export test passed!" << std::endl;
+}
+
+int main() {
+    std::cout << "Running TSC clock tests..." << std::endl;
+
+    testCalibratedRate();
+    testMonotonicStamps();
+    testWallClockConversion();
+
+    std::cout << "\nAll TSC clock tests passed successfully!" << std::endl;
+    return 0;
+}